@@ -350,6 +350,15 @@ GtUword gt_block_get_size(const GtBlock *block)
   return gt_array_size(block->elements);
 }
 
+void gt_block_sort_elements(GtBlock *block, GtStyle *sty)
+{
+  gt_assert(block && sty);
+  if (!block->sorted) {
+    gt_array_sort_with_data(block->elements, elemcmp, sty);
+    block->sorted = true;
+  }
+}
+
 int gt_block_sketch(GtBlock *block, GtCanvas *canvas, GtError *err)
 {
   int had_err = 0;
@@ -365,13 +374,8 @@ int gt_block_sketch(GtBlock *block, GtCanvas *canvas, GtError *err)
     else
       return had_err;
   } /* we have in any case returned if had_err was set */
-  if (!block->sorted)
-  {
-    GtStyle *sty = gt_canvas_get_style(canvas);
-    /* sort elements if they have changed since last sketch operation */
-    gt_array_sort_with_data(block->elements, elemcmp, sty);
-    block->sorted = true;
-  }
+  /* sort elements if they have changed since last sketch operation */
+  gt_block_sort_elements(block, gt_canvas_get_style(canvas));
   /* delegate sketch request to elements */
   for (i=0;i<gt_array_size(block->elements);i++) {
      GtElement *elem = *(GtElement**) gt_array_get(block->elements, i);
@@ -30,6 +30,10 @@ void        gt_block_set_type(GtBlock*, const char *type);
 int         gt_block_compare(const GtBlock *block1, const GtBlock *block2,
                              void *data);
 int         gt_block_sketch(GtBlock*, GtCanvas*, GtError*);
+/* Sorts the elements of <block> into drawing order, which <gt_block_sketch()>
+   does on demand. Blocks shared by concurrent sketches must be sorted
+   beforehand. */
+void        gt_block_sort_elements(GtBlock*, GtStyle*);
 int         gt_block_get_max_height(const GtBlock *block,
                                     double *result,
                                     const GtStyle *sty,
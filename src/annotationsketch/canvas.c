@@ -196,6 +196,16 @@ void* gt_canvas_try_cast(GT_UNUSED const GtCanvasClass *cc, GtCanvas *c)
   return NULL;
 }
 
+void gt_canvas_restrict_to_range(GtCanvas *canvas, GtRange range)
+{
+  gt_assert(canvas && range.start <= range.end);
+  canvas->pvt->restrictrange = range;
+  canvas->pvt->restricted = true;
+  canvas->pvt->margins = 0.0;
+  if (canvas->pvt->g)
+    gt_graphics_set_margins(canvas->pvt->g, 0.0, 0.0);
+}
+
 GtUword gt_canvas_get_height(GtCanvas *canvas)
 {
   gt_assert(canvas);
@@ -42,6 +42,10 @@ int             gt_canvas_draw_ruler(GtCanvas*, GtRange, GtError *err);
 void            gt_format_ruler_label(char *txt, GtWord pos,
                                       const char *unitstr, size_t buflen);
 GtStyle*        gt_canvas_get_style(GtCanvas *canvas);
+/* Restricts the drawing on <canvas> to the sequence range <range>, which is
+   drawn instead of the range of the rendered <GtLayout>. The margins are
+   removed, such that canvases of adjacent ranges form a seamless image. */
+void            gt_canvas_restrict_to_range(GtCanvas *canvas, GtRange range);
 
 /* Callback function for rendering. */
 int             gt_canvas_visit_layout_pre(GtCanvas*, GtLayout*, GtError*);
@@ -42,7 +42,10 @@ int gt_canvas_cairo_visit_layout_pre(GtCanvas *canvas,
 {
   double head_track_space = HEAD_TRACK_SPACE_DEFAULT;
   /* get displayed range for internal use */
-  canvas->pvt->viewrange = gt_layout_get_range(layout);
+  if (canvas->pvt->restricted)
+    canvas->pvt->viewrange = canvas->pvt->restrictrange;
+  else
+    canvas->pvt->viewrange = gt_layout_get_range(layout);
   if (gt_canvas_draw_ruler(canvas, canvas->pvt->viewrange, err)) {
     return -1;
   }
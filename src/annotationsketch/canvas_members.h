@@ -26,7 +26,9 @@
 #include "annotationsketch/track.h"
 
 struct GtCanvasMembers {
-  GtRange viewrange;
+  GtRange viewrange,
+          restrictrange;
+  bool restricted;
   double factor, y, margins;
   GtUword width, height;
   GtStyle *sty;
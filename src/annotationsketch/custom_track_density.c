@@ -0,0 +1,209 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include "annotationsketch/custom_track_density.h"
+#include "annotationsketch/custom_track_rep.h"
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/str_api.h"
+#include "core/unused_api.h"
+
+struct GtCustomTrackDensity {
+  const GtCustomTrack parent_instance;
+  char *type;
+  GtStr *title;
+  GtRange range;
+  GtUword nofbins,
+          height,
+          num_of_features,
+          max_coverage;
+  GtWord *coverage; /* differences of adjacent bins until finished */
+  bool finished;
+};
+
+#define gt_custom_track_density_cast(ct)\
+        gt_custom_track_cast(gt_custom_track_density_class(), ct)
+
+static GtUword density_bin(const GtCustomTrackDensity *ctd, GtUword pos)
+{
+  gt_assert(ctd->range.start <= pos && pos <= ctd->range.end);
+  return (pos - ctd->range.start) * ctd->nofbins
+         / gt_range_length(&ctd->range);
+}
+
+static int gt_custom_track_density_sketch(GtCustomTrack *ct,
+                                          GtGraphics *graphics,
+                                          unsigned int start_ypos,
+                                          GtRange viewrange, GtStyle *style,
+                                          GT_UNUSED GtError *err)
+{
+  GtCustomTrackDensity *ctd;
+  GtRange value_range;
+  GtColor color, grey;
+  GtUword i, n, pos, viewlen;
+  double width, *data;
+  gt_assert(ct && graphics && viewrange.start <= viewrange.end);
+  ctd = gt_custom_track_density_cast(ct);
+  gt_assert(ctd->finished);
+
+  (void) gt_style_get_color(style, ctd->type, "stroke", &color, NULL, NULL);
+  grey.red = grey.blue = grey.green = 0.8;
+  grey.alpha = 0.9;
+
+  /* sample the coverage once per pixel, the view range may differ from the
+     counted range (e.g. for tiles) */
+  width = gt_graphics_get_image_width(graphics)
+            - 2 * gt_graphics_get_xmargins(graphics);
+  n = MAX(2, (GtUword) width);
+  viewlen = gt_range_length(&viewrange);
+  data = gt_malloc(n * sizeof *data);
+  for (i = 0; i < n; i++) {
+    pos = viewrange.start + (GtUword) ((double) i * viewlen / n);
+    if (pos < ctd->range.start || pos > ctd->range.end)
+      data[i] = 0.0;
+    else
+      data[i] = (double) ctd->coverage[density_bin(ctd, pos)];
+  }
+  value_range.start = 0;
+  value_range.end = MAX(1, ctd->max_coverage);
+
+  gt_graphics_draw_horizontal_line(graphics,
+                                   gt_graphics_get_xmargins(graphics),
+                                   start_ypos + ctd->height,
+                                   grey,
+                                   width,
+                                   1.0);
+  gt_graphics_draw_curve_data(graphics,
+                              gt_graphics_get_xmargins(graphics),
+                              start_ypos,
+                              color,
+                              data,
+                              n,
+                              value_range,
+                              ctd->height);
+  gt_free(data);
+  return 0;
+}
+
+static GtUword gt_custom_track_density_get_height(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  ctd = gt_custom_track_density_cast(ct);
+  return ctd->height;
+}
+
+static const char* gt_custom_track_density_get_title(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  ctd = gt_custom_track_density_cast(ct);
+  gt_assert(ctd->finished);
+  return gt_str_get(ctd->title);
+}
+
+static void gt_custom_track_density_delete(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  if (!ct) return;
+  ctd = gt_custom_track_density_cast(ct);
+  gt_free(ctd->type);
+  gt_str_delete(ctd->title);
+  gt_free(ctd->coverage);
+}
+
+const GtCustomTrackClass* gt_custom_track_density_class(void)
+{
+  static const GtCustomTrackClass *ctc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!ctc)
+  {
+    ctc = gt_custom_track_class_new(sizeof (GtCustomTrackDensity),
+                                    gt_custom_track_density_sketch,
+                                    gt_custom_track_density_get_height,
+                                    gt_custom_track_density_get_title,
+                                    gt_custom_track_density_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return ctc;
+}
+
+GtCustomTrack* gt_custom_track_density_new(const char *type, GtRange range,
+                                           GtUword nofbins, GtUword height)
+{
+  GtCustomTrackDensity *ctd;
+  GtCustomTrack *ct;
+  gt_assert(type && range.start <= range.end && nofbins > 0);
+  ct = gt_custom_track_create(gt_custom_track_density_class());
+  ctd = gt_custom_track_density_cast(ct);
+  ctd->type = gt_cstr_dup(type);
+  ctd->range = range;
+  ctd->nofbins = nofbins;
+  ctd->height = height;
+  ctd->coverage = gt_calloc(nofbins + 1, sizeof *ctd->coverage);
+  return ct;
+}
+
+void gt_custom_track_density_add(GtCustomTrack *ct, GtRange feature_range)
+{
+  GtCustomTrackDensity *ctd;
+  ctd = gt_custom_track_density_cast(ct);
+  gt_assert(!ctd->finished);
+  if (!gt_range_overlap(&ctd->range, &feature_range))
+    return;
+  feature_range.start = MAX(feature_range.start, ctd->range.start);
+  feature_range.end = MIN(feature_range.end, ctd->range.end);
+  ctd->coverage[density_bin(ctd, feature_range.start)]++;
+  ctd->coverage[density_bin(ctd, feature_range.end) + 1]--;
+  ctd->num_of_features++;
+}
+
+void gt_custom_track_density_finish(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  GtUword i;
+  ctd = gt_custom_track_density_cast(ct);
+  gt_assert(!ctd->finished);
+  for (i = 1; i < ctd->nofbins; i++)
+    ctd->coverage[i] += ctd->coverage[i-1];
+  for (i = 0; i < ctd->nofbins; i++) {
+    gt_assert(ctd->coverage[i] >= 0);
+    ctd->max_coverage = MAX(ctd->max_coverage, (GtUword) ctd->coverage[i]);
+  }
+  ctd->title = gt_str_new_cstr(ctd->type);
+  gt_str_append_cstr(ctd->title, " density (");
+  gt_str_append_uword(ctd->title, ctd->num_of_features);
+  gt_str_append_cstr(ctd->title, " features, max. coverage ");
+  gt_str_append_uword(ctd->title, ctd->max_coverage);
+  gt_str_append_cstr(ctd->title, ")");
+  ctd->finished = true;
+}
+
+GtUword gt_custom_track_density_num_of_features(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  ctd = gt_custom_track_density_cast(ct);
+  return ctd->num_of_features;
+}
+
+GtUword gt_custom_track_density_get_coverage(GtCustomTrack *ct, GtUword bin)
+{
+  GtCustomTrackDensity *ctd;
+  ctd = gt_custom_track_density_cast(ct);
+  gt_assert(ctd->finished && bin < ctd->nofbins);
+  return (GtUword) ctd->coverage[bin];
+}
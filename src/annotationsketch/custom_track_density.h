@@ -0,0 +1,54 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef CUSTOM_TRACK_DENSITY_H
+#define CUSTOM_TRACK_DENSITY_H
+
+#include "annotationsketch/custom_track.h"
+#include "core/range_api.h"
+
+/* Implements the <GtCustomTrack> interface. This custom track summarizes the
+   features of a given type in a range by their coverage, that is, the number
+   of features overlapping each of a fixed number of equally sized bins. It is
+   used by <GtDiagram> instead of single blocks for types which are too dense
+   to be laid out in the displayed range. */
+typedef struct GtCustomTrackDensity GtCustomTrackDensity;
+
+const GtCustomTrackClass* gt_custom_track_density_class(void);
+
+/* Creates a new <GtCustomTrackDensity> for features of type <type> in <range>
+   with <nofbins> bins, drawn as a curve of height <height>. The color is taken
+   from the "fill" setting of <type>. */
+GtCustomTrack*            gt_custom_track_density_new(const char *type,
+                                                      GtRange range,
+                                                      GtUword nofbins,
+                                                      GtUword height);
+/* Adds a feature with <feature_range> to <ct>. */
+void                      gt_custom_track_density_add(GtCustomTrack *ct,
+                                                      GtRange feature_range);
+/* Computes the coverage after all features have been added, must be called
+   before <ct> is rendered. */
+void                      gt_custom_track_density_finish(GtCustomTrack *ct);
+/* Returns the number of features added to <ct>. */
+GtUword                   gt_custom_track_density_num_of_features(
+                                                             GtCustomTrack *ct);
+/* Returns the number of features overlapping bin <bin> of <ct>. */
+GtUword                   gt_custom_track_density_get_coverage(
+                                                             GtCustomTrack *ct,
+                                                             GtUword bin);
+
+#endif
@@ -17,8 +17,10 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "annotationsketch/canvas.h"
 #include "annotationsketch/canvas_cairo_file.h"
+#include "annotationsketch/custom_track_density.h"
 #include "annotationsketch/diagram.h"
 #include "extended/feature_index_memory_api.h"
 #include "annotationsketch/line_breaker_captions.h"
@@ -36,6 +38,8 @@
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/feature_type.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_defines.h"
 
@@ -44,6 +48,8 @@
 #define GT_UNDEF_REPR               (void*)~0
 /* used to separate a filename from the type in a track name */
 #define GT_FILENAME_TYPE_SEPARATOR  '|'
+/* height of the tracks summarizing dense types, in pixels */
+#define GT_DENSITY_TRACK_HEIGHT     40
 
 struct GtDiagram {
   /* GtBlock lists indexed by track keys */
@@ -54,7 +60,10 @@ struct GtDiagram {
   GtHashmap *collapsingtypes, *caption_display_status, *groupedtypes;
   GtStyle *style;
   GtArray *features,
-          *custom_tracks;
+          *custom_tracks,
+          *density_tracks; /* summaries of the types too dense to lay out */
+  GtUword width;           /* width in pixels the blocks were built for */
+  bool aggregating;        /* the blocks depend on <width> */
   GtRange range;
   void *ptr;
   GtTrackSelectorFunc select_func;
@@ -767,11 +776,99 @@ static void blocklist_delete(void *value)
   gt_array_delete(a);
 }
 
-static int gt_diagram_build(GtDiagram *diagram, GtError *err)
+static void density_tracks_reset(GtArray *density_tracks)
+{
+  GtUword i;
+  for (i = 0; i < gt_array_size(density_tracks); i++)
+    gt_custom_track_delete(*(GtCustomTrack**) gt_array_get(density_tracks, i));
+  gt_array_reset(density_tracks);
+}
+
+/* Returns the type a top-level feature is aggregated by. Pseudo nodes have no
+   type, the type of their parts is used instead. */
+static const char* root_type(GtFeatureNode *fn)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *child;
+  const char *type = NULL;
+  if (!gt_feature_node_is_pseudo(fn))
+    return gt_feature_node_get_type(fn);
+  fni = gt_feature_node_iterator_new_direct(fn);
+  if ((child = gt_feature_node_iterator_next(fni)))
+    type = gt_feature_node_get_type(child);
+  gt_feature_node_iterator_delete(fni);
+  return type;
+}
+
+/* If "max_features_per_pixel" is set in the format section of the style,
+   creates a density track in <density> for every type of top-level features
+   exceeding this number in <width> pixels. */
+static int find_dense_types(GtDiagram *d, GtUword width, GtHashmap **density,
+                            GtError *err)
+{
+  GtHashmap *counts;
+  GtStyleQueryStatus rval;
+  GtUword i, *count;
+  double max_features_per_pixel;
+  const char *type;
+  gt_assert(d && density);
+  *density = NULL;
+  rval = gt_style_get_num(d->style, "format", "max_features_per_pixel",
+                          &max_features_per_pixel, NULL, err);
+  if (rval == GT_STYLE_QUERY_ERROR)
+    return -1;
+  d->aggregating = (rval == GT_STYLE_QUERY_OK);
+  if (!d->aggregating || !width)
+    return 0;
+
+  counts = gt_hashmap_new(GT_HASH_STRING, NULL, gt_free_func);
+  for (i = 0; i < gt_array_size(d->features); i++) {
+    if (!(type = root_type(*(GtFeatureNode**) gt_array_get(d->features, i))))
+      continue;
+    if (!(count = gt_hashmap_get(counts, type))) {
+      count = gt_calloc(1, sizeof *count);
+      gt_hashmap_add(counts, (void*) type, count);
+    }
+    (*count)++;
+  }
+  for (i = 0; i < gt_array_size(d->features); i++) {
+    if (!(type = root_type(*(GtFeatureNode**) gt_array_get(d->features, i))))
+      continue;
+    count = gt_hashmap_get(counts, type);
+    gt_assert(count);
+    if (*count > max_features_per_pixel * width) {
+      if (!*density) {
+        *density = gt_hashmap_new(GT_HASH_STRING, NULL,
+                                  (GtFree) gt_custom_track_delete);
+      }
+      if (!gt_hashmap_get(*density, type)) {
+        gt_hashmap_add(*density, (void*) type,
+                       gt_custom_track_density_new(type, d->range, width,
+                                                   GT_DENSITY_TRACK_HEIGHT));
+      }
+    }
+  }
+  gt_hashmap_delete(counts);
+  return 0;
+}
+
+static int collect_density_tracks(GT_UNUSED void *key, void *value,
+                                  void *data, GT_UNUSED GtError *err)
+{
+  GtDiagram *diagram = (GtDiagram*) data;
+  GtCustomTrack *ct = (GtCustomTrack*) value;
+  gt_custom_track_density_finish(ct);
+  gt_array_add(diagram->density_tracks, ct);
+  (void) gt_custom_track_ref(ct);
+  return 0;
+}
+
+static int gt_diagram_build(GtDiagram *diagram, GtUword width, GtError *err)
 {
   GtUword i = 0;
   int had_err = 0;
   NodeTraverseInfo nti;
+  GtHashmap *density = NULL;
   gt_assert(diagram);
 
   nti.diagram = diagram;
@@ -781,17 +878,38 @@ static int gt_diagram_build(GtDiagram *diagram, GtError *err)
   gt_hashmap_reset(diagram->groupedtypes);
   gt_hashmap_reset(diagram->caption_display_status);
 
+  /* the level of detail depends on the width */
+  if (diagram->blocks && diagram->aggregating && width != diagram->width) {
+    gt_hashmap_delete(diagram->blocks);
+    diagram->blocks = NULL;
+  }
+
   if (!diagram->blocks)
   {
+    density_tracks_reset(diagram->density_tracks);
+    diagram->width = width;
+    if (find_dense_types(diagram, width, &density, err))
+      return -1;
     gt_hashmap_reset(diagram->nodeinfo);
-    /* do node traversal for each root feature */
+    /* do node traversal for each root feature, features of dense types are
+       only counted */
     for (i = 0; i < gt_array_size(diagram->features); i++)
     {
       GtFeatureNode *current_root;
+      GtCustomTrack *ct;
+      const char *type;
       current_root = *(GtFeatureNode**) gt_array_get(diagram->features,i);
+      if (density && (type = root_type(current_root)) &&
+          (ct = gt_hashmap_get(density, type))) {
+        gt_custom_track_density_add(ct,
+                     gt_genome_node_get_range((GtGenomeNode*) current_root));
+        continue;
+      }
       had_err = traverse_genome_nodes(current_root, &nti);
-      if (had_err)
+      if (had_err) {
+        gt_hashmap_delete(density);
         return -1;
+      }
     }
     diagram->blocks = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
                                      (GtFree) blocklist_delete);
@@ -802,6 +920,13 @@ static int gt_diagram_build(GtDiagram *diagram, GtError *err)
                                          (GtCompare) gt_genome_node_cmp,
                                          NULL);
     gt_assert(!had_err); /* collect_blocks() is sane */
+    if (density) {
+      had_err = gt_hashmap_foreach_in_key_order(density,
+                                                collect_density_tracks,
+                                                diagram, NULL);
+      gt_assert(!had_err); /* collect_density_tracks() is sane */
+      gt_hashmap_delete(density);
+    }
   }
 
   return had_err;
@@ -824,6 +949,7 @@ static GtDiagram* gt_diagram_new_generic(GtArray *features,
     diagram->features = features;
   diagram->select_func = default_track_selector;
   diagram->custom_tracks = gt_array_new(sizeof (GtCustomTrack*));
+  diagram->density_tracks = gt_array_new(sizeof (GtCustomTrack*));
   /* init caches */
   diagram->collapsingtypes = gt_hashmap_new(GT_HASH_STRING, NULL, gt_free_func);
   diagram->groupedtypes = gt_hashmap_new(GT_HASH_STRING, NULL, gt_free_func);
@@ -899,17 +1025,27 @@ void gt_diagram_reset_track_selector_func(GtDiagram *diagram)
   gt_rwlock_unlock(diagram->lock);
 }
 
-GtHashmap* gt_diagram_get_blocks(GtDiagram *diagram, GtError *err)
+GtHashmap* gt_diagram_get_blocks(GtDiagram *diagram, GtUword width,
+                                  GtArray *density_tracks, GtError *err)
 {
   GtHashmap *ret;
+  GtUword i;
   int had_err = 0;
   gt_assert(diagram);
   gt_rwlock_wrlock(diagram->lock);
-  had_err = gt_diagram_build((GtDiagram*) diagram, err);
+  had_err = gt_diagram_build((GtDiagram*) diagram, width, err);
   if (had_err)
     ret = NULL;
-  else
+  else {
     ret = diagram->blocks;
+    for (i = 0; density_tracks && i < gt_array_size(diagram->density_tracks);
+         i++) {
+      GtCustomTrack *ct = *(GtCustomTrack**)
+                            gt_array_get(diagram->density_tracks, i);
+      ct = gt_custom_track_ref(ct);
+      gt_array_add(density_tracks, ct);
+    }
+  }
   gt_rwlock_unlock(diagram->lock);
   return ret;
 }
@@ -969,6 +1105,93 @@ void* gt_diagram_unit_test_sketch_func(void *data)
   return NULL;
 }
 
+static int count_blocks(GT_UNUSED void *key, void *value, void *data,
+                        GT_UNUSED GtError *err)
+{
+  *(GtUword*) data += gt_array_size((GtArray*) value);
+  return 0;
+}
+
+static int diagram_aggregation_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtUword i, numofblocks;
+  GtRange range = {1, 1000};
+  GtRange genes[] = {{1, 10}, {5, 20}, {500, 600}, {550, 560}, {990, 1000}};
+  GtArray *features, *density_tracks;
+  GtHashmap *blocks;
+  GtDiagram *d;
+  GtStyle *sty;
+  GtStr *seqid;
+  GtCustomTrack *ct;
+  gt_error_check(err);
+
+  features = gt_array_new(sizeof (GtGenomeNode*));
+  seqid = gt_str_new_cstr("ctg123");
+  for (i = 0; i < sizeof (genes) / sizeof (genes[0]); i++) {
+    GtGenomeNode *gn = gt_feature_node_new(seqid, gt_ft_gene, genes[i].start,
+                                           genes[i].end, GT_STRAND_FORWARD);
+    gt_array_add(features, gn);
+  }
+  {
+    GtGenomeNode *gn = gt_feature_node_new(seqid, gt_ft_mRNA, 100, 200,
+                                           GT_STRAND_FORWARD);
+    gt_array_add(features, gn);
+  }
+  sty = gt_style_new(err);
+  gt_ensure(sty != NULL);
+  d = gt_diagram_new_from_array(features, &range, sty);
+  density_tracks = gt_array_new(sizeof (GtCustomTrack*));
+
+  /* without a threshold, every feature gets a block */
+  numofblocks = 0;
+  gt_ensure((blocks = gt_diagram_get_blocks(d, 100, density_tracks, err)));
+  (void) gt_hashmap_foreach(blocks, count_blocks, &numofblocks, NULL);
+  gt_ensure(numofblocks == 6);
+  gt_ensure(gt_array_size(density_tracks) == 0);
+
+  /* more than one gene per 100 pixels are summarized, the mRNA is not */
+  gt_style_set_num(sty, "format", "max_features_per_pixel", 0.01);
+  gt_diagram_reset_track_selector_func(d);
+  numofblocks = 0;
+  gt_ensure((blocks = gt_diagram_get_blocks(d, 100, density_tracks, err)));
+  (void) gt_hashmap_foreach(blocks, count_blocks, &numofblocks, NULL);
+  gt_ensure(numofblocks == 1);
+  gt_ensure(gt_array_size(density_tracks) == 1);
+  if (!had_err) {
+    ct = *(GtCustomTrack**) gt_array_get(density_tracks, 0);
+    gt_ensure(gt_custom_track_density_num_of_features(ct) == 5);
+    gt_ensure(gt_custom_track_density_get_coverage(ct, 0) == 2);
+    gt_ensure(gt_custom_track_density_get_coverage(ct, 1) == 1);
+    gt_ensure(gt_custom_track_density_get_coverage(ct, 2) == 0);
+    gt_ensure(gt_custom_track_density_get_coverage(ct, 49) == 1);
+    gt_ensure(gt_custom_track_density_get_coverage(ct, 54) == 2);
+    gt_ensure(gt_custom_track_density_get_coverage(ct, 60) == 0);
+    gt_ensure(gt_custom_track_density_get_coverage(ct, 99) == 1);
+    gt_ensure(strcmp(gt_custom_track_get_title(ct),
+                     "gene density (5 features, max. coverage 2)") == 0);
+  }
+
+  /* wider drawing areas show the genes again */
+  for (i = 0; i < gt_array_size(density_tracks); i++)
+    gt_custom_track_delete(*(GtCustomTrack**) gt_array_get(density_tracks, i));
+  gt_array_reset(density_tracks);
+  numofblocks = 0;
+  gt_ensure((blocks = gt_diagram_get_blocks(d, 1000, density_tracks, err)));
+  (void) gt_hashmap_foreach(blocks, count_blocks, &numofblocks, NULL);
+  gt_ensure(numofblocks == 6);
+  gt_ensure(gt_array_size(density_tracks) == 0);
+
+  gt_array_delete(density_tracks);
+  gt_diagram_delete(d);
+  gt_style_delete(sty);
+  for (i = 0; i < gt_array_size(features); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(features, i));
+  gt_array_delete(features);
+  gt_str_delete(seqid);
+  return had_err;
+}
+
 int gt_diagram_unit_test(GtError *err)
 {
   int had_err = 0;
@@ -994,6 +1217,10 @@ int gt_diagram_unit_test(GtError *err)
   gt_diagram_delete(sh.d);
   gt_feature_index_delete(sh.fi);
 
+  if (!had_err) {
+    had_err = diagram_aggregation_unit_test(err);
+  }
+
   return had_err;
 }
 
@@ -1009,6 +1236,8 @@ void gt_diagram_delete(GtDiagram *diagram)
   gt_hashmap_delete(diagram->groupedtypes);
   gt_hashmap_delete(diagram->caption_display_status);
   gt_array_delete(diagram->custom_tracks);
+  density_tracks_reset(diagram->density_tracks);
+  gt_array_delete(diagram->density_tracks);
   gt_rwlock_unlock(diagram->lock);
   gt_rwlock_delete(diagram->lock);
   gt_free(diagram);
@@ -24,7 +24,13 @@
 #include "core/error.h"
 #include "core/hashmap.h"
 
-GtHashmap* gt_diagram_get_blocks(GtDiagram *diagram, GtError *err);
+/* Returns the blocks of <diagram> laid out in a drawing area of <width>
+   pixels. If the style sets "max_features_per_pixel" in its format section,
+   top-level features of types which are denser in <width> pixels are not
+   placed in blocks, but summarized in density tracks instead. These are
+   referenced and appended to <density_tracks>, if given. */
+GtHashmap* gt_diagram_get_blocks(GtDiagram *diagram, GtUword width,
+                                 GtArray *density_tracks, GtError *err);
 GtArray*   gt_diagram_get_custom_tracks(const GtDiagram *diagram);
 void       gt_diagram_reset(GtDiagram *diagram);
 int        gt_diagram_unit_test(GtError*);
@@ -32,6 +32,7 @@
 #include "core/warning_api.h"
 #include "extended/add_introns_stream_api.h"
 #include "extended/bed_in_stream.h"
+#include "extended/feature_index_binary_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_in_stream.h"
@@ -104,6 +105,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
     "gff",
     "bed",
     "gtf",
+    "featureindex",
     NULL
   };
   gt_assert(arguments);
@@ -177,7 +179,10 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
 
   /* -input */
   option = gt_option_new_choice("input", "input data format\n"
-                                       "choose from gff|bed|gtf",
+                                       "choose from gff|bed|gtf|featureindex\n"
+                                       "featureindex reads a binary feature "
+                                       "index written by gt mkfeatureindex "
+                                       "-backend binary",
                              arguments->input, inputs[0], inputs);
   gt_option_parser_add_option(op, option);
 
@@ -289,7 +294,20 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
   }
 
   file = argv[parsed_args];
-  if (!had_err) {
+  if (!had_err && strcmp(gt_str_get(arguments->input), "featureindex") == 0) {
+    /* only the features in the query range are read from the mapped index */
+    if (argc - parsed_args != 2) {
+      gt_error_set(err, "option -input featureindex requires exactly one "
+                   "index file");
+      had_err = -1;
+    }
+    if (!had_err) {
+      features = gt_feature_index_binary_new(argv[parsed_args + 1], err);
+      if (!features)
+        had_err = -1;
+    }
+  }
+  else if (!had_err) {
     /* create feature index */
     features = gt_feature_index_memory_new();
     parsed_args++;
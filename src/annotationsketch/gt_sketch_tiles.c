@@ -0,0 +1,337 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "annotationsketch/style.h"
+#include "annotationsketch/tile_renderer.h"
+#include "core/cstr_api.h"
+#include "core/fileutils_api.h"
+#include "core/gtdatapath.h"
+#include "core/ma.h"
+#include "core/option_api.h"
+#include "core/timer_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "extended/feature_index_binary_api.h"
+#include "extended/feature_index_memory_api.h"
+#include "annotationsketch/gt_sketch_tiles.h"
+
+typedef struct {
+  GtStr *seqid,
+        *prefix,
+        *format,
+        *stylefile,
+        *input;
+  GtRange range;
+  GtUword tilewidth,
+          minzoom,
+          maxzoom;
+  bool benchmark,
+       verbose;
+} SketchTilesArguments;
+
+static void* gt_sketch_tiles_arguments_new(void)
+{
+  SketchTilesArguments *arguments = gt_calloc(1, sizeof *arguments);
+  arguments->seqid = gt_str_new();
+  arguments->prefix = gt_str_new();
+  arguments->format = gt_str_new();
+  arguments->stylefile = gt_str_new();
+  arguments->input = gt_str_new();
+  return arguments;
+}
+
+static void gt_sketch_tiles_arguments_delete(void *tool_arguments)
+{
+  SketchTilesArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->seqid);
+  gt_str_delete(arguments->prefix);
+  gt_str_delete(arguments->format);
+  gt_str_delete(arguments->stylefile);
+  gt_str_delete(arguments->input);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_sketch_tiles_option_parser_new(void *tool_arguments)
+{
+  SketchTilesArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  static const char *formats[] = { "png",
+#ifdef CAIRO_HAS_PDF_SURFACE
+    "pdf",
+#endif
+#ifdef CAIRO_HAS_SVG_SURFACE
+    "svg",
+#endif
+#ifdef CAIRO_HAS_PS_SURFACE
+    "ps",
+#endif
+    NULL
+  };
+  static const char *inputs[] = {
+    "gff",
+    "featureindex",
+    NULL
+  };
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...] annotation_file [...]",
+                            "Render a sequence region into image tiles of "
+                            "all zoom levels.");
+
+  option = gt_option_new_string("seqid", "sequence region to draw\n"
+                                         "default: first in file",
+                                arguments->seqid, NULL);
+  gt_option_parser_add_option(op, option);
+  gt_option_hide_default(option);
+
+  option = gt_option_new_range("range", "range to draw (e.g. 100 10000)\n"
+                                        "default: full range",
+                               &arguments->range, NULL);
+  gt_option_parser_add_option(op, option);
+  gt_option_hide_default(option);
+
+  option = gt_option_new_uword_min("tilewidth", "width of a tile in pixels",
+                                   &arguments->tilewidth, 256, 16);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("minzoom", "smallest zoom level to render, "
+                               "a tile of zoom level z shows 2^z bases per "
+                               "pixel",
+                               &arguments->minzoom, 0);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("maxzoom", "largest zoom level to render\n"
+                               "default: the level with a single tile",
+                               &arguments->maxzoom, GT_UNDEF_UWORD);
+  gt_option_parser_add_option(op, option);
+  gt_option_hide_default(option);
+
+  option = gt_option_new_string("prefix", "prefix of the tile files, tile t "
+                                "of zoom level z is written to "
+                                "prefix_z_t.format\n"
+                                "default: the sequence region",
+                                arguments->prefix, NULL);
+  gt_option_parser_add_option(op, option);
+  gt_option_hide_default(option);
+
+  option = gt_option_new_choice("format", "output graphics format\n"
+                                          "choose from png"
+#ifdef CAIRO_HAS_PDF_SURFACE
+                                          "|pdf"
+#endif
+#ifdef CAIRO_HAS_SVG_SURFACE
+                                          "|svg"
+#endif
+#ifdef CAIRO_HAS_PS_SURFACE
+                                          "|ps"
+#endif
+                                          "",
+                                arguments->format, formats[0], formats);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_string("style", "style file to use\n"
+                                "default: gtdata/sketch/default.style",
+                                arguments->stylefile, NULL);
+  gt_option_parser_add_option(op, option);
+  gt_option_hide_default(option);
+
+  option = gt_option_new_choice("input", "input data format\n"
+                                "choose from gff|featureindex\n"
+                                "featureindex reads a binary feature index "
+                                "written by gt mkfeatureindex -backend binary",
+                                arguments->input, inputs[0], inputs);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_bool("benchmark", "render the tiles without writing "
+                              "them and report the throughput",
+                              &arguments->benchmark, false);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_min_args(op, 1);
+  return op;
+}
+
+static GtGraphicsOutType gt_sketch_tiles_type(const char *format)
+{
+  if (strcmp(format, "pdf") == 0)
+    return GT_GRAPHICS_PDF;
+  if (strcmp(format, "ps") == 0)
+    return GT_GRAPHICS_PS;
+  if (strcmp(format, "svg") == 0)
+    return GT_GRAPHICS_SVG;
+  return GT_GRAPHICS_PNG;
+}
+
+static int gt_sketch_tiles_runner(int argc, const char **argv, int parsed_args,
+                                  void *tool_arguments, GtError *err)
+{
+  SketchTilesArguments *arguments = tool_arguments;
+  GtFeatureIndex *features = NULL;
+  GtTileRenderer *tr = NULL;
+  GtStyle *sty = NULL;
+  GtStr *prog, *stylefile = NULL;
+  GtTimer *timer;
+  GtGraphicsOutType type;
+  GtRange range;
+  GtUword numoftiles = 0, maxzoom;
+  double elapsed;
+  char *seqid = NULL;
+  bool has_seqid;
+  int i, had_err = 0;
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  /* read the features */
+  if (strcmp(gt_str_get(arguments->input), "featureindex") == 0) {
+    if (argc - parsed_args != 1) {
+      gt_error_set(err, "option -input featureindex requires exactly one "
+                   "index file");
+      had_err = -1;
+    }
+    if (!had_err &&
+        !(features = gt_feature_index_binary_new(argv[parsed_args], err))) {
+      had_err = -1;
+    }
+  }
+  else {
+    features = gt_feature_index_memory_new();
+    for (i = parsed_args; !had_err && i < argc; i++)
+      had_err = gt_feature_index_add_gff3file(features, argv[i], err);
+  }
+
+  /* determine the sequence region and range */
+  if (!had_err && gt_str_length(arguments->seqid) == 0) {
+    if (!(seqid = gt_feature_index_get_first_seqid(features, err))) {
+      if (!gt_error_is_set(err))
+        gt_error_set(err, "input must contain a sequence region!");
+      had_err = -1;
+    }
+  }
+  else if (!had_err) {
+    had_err = gt_feature_index_has_seqid(features, &has_seqid,
+                                         gt_str_get(arguments->seqid), err);
+    if (!had_err && !has_seqid) {
+      gt_error_set(err, "sequence region '%s' does not exist in input",
+                   gt_str_get(arguments->seqid));
+      had_err = -1;
+    }
+    if (!had_err)
+      seqid = gt_cstr_dup(gt_str_get(arguments->seqid));
+  }
+  if (!had_err)
+    had_err = gt_feature_index_get_range_for_seqid(features, &range, seqid,
+                                                   err);
+  if (!had_err) {
+    if (arguments->range.start != GT_UNDEF_UWORD)
+      range.start = arguments->range.start;
+    if (arguments->range.end != GT_UNDEF_UWORD)
+      range.end = arguments->range.end;
+    if (range.start > range.end) {
+      gt_error_set(err, "start of range ("GT_WU") must not be larger than its "
+                   "end ("GT_WU")", range.start, range.end);
+      had_err = -1;
+    }
+  }
+
+  /* load the style */
+  if (!had_err && gt_str_length(arguments->stylefile) == 0) {
+    prog = gt_str_new();
+    gt_str_append_cstr_nt(prog, argv[0],
+                          gt_cstr_length_up_to_char(argv[0], ' '));
+    if (!(stylefile = gt_get_gtdata_path(gt_str_get(prog), err)))
+      had_err = -1;
+    else
+      gt_str_append_cstr(stylefile, "/sketch/default.style");
+    gt_str_delete(prog);
+  }
+  else if (!had_err)
+    stylefile = gt_str_ref(arguments->stylefile);
+  if (!had_err && !(sty = gt_style_new(err)))
+    had_err = -1;
+  if (!had_err)
+    had_err = gt_style_load_file(sty, gt_str_get(stylefile), err);
+
+  if (!had_err && !(tr = gt_tile_renderer_new(features, seqid, &range, sty,
+                                              arguments->tilewidth, err))) {
+    had_err = -1;
+  }
+  if (!had_err) {
+    maxzoom = gt_tile_renderer_max_zoom(tr);
+    if (arguments->maxzoom != GT_UNDEF_UWORD) {
+      if (arguments->maxzoom > maxzoom) {
+        gt_error_set(err, "argument to option -maxzoom must not be larger "
+                     "than "GT_WU", which shows the whole range in one tile",
+                     maxzoom);
+        had_err = -1;
+      }
+      else
+        maxzoom = arguments->maxzoom;
+    }
+    if (!had_err && arguments->minzoom > maxzoom) {
+      gt_error_set(err, "argument to option -minzoom must not be larger than "
+                   "the maximal zoom level "GT_WU"", maxzoom);
+      had_err = -1;
+    }
+  }
+
+  /* render the tiles */
+  if (!had_err) {
+    if (gt_str_length(arguments->prefix) == 0)
+      gt_str_append_cstr(arguments->prefix, seqid);
+    type = gt_sketch_tiles_type(gt_str_get(arguments->format));
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+    had_err = gt_tile_renderer_render_all(tr, arguments->minzoom, maxzoom,
+                                          type,
+                                          arguments->benchmark
+                                          ? NULL
+                                          : gt_str_get(arguments->prefix),
+                                          &numoftiles, err);
+    gt_timer_stop(timer);
+    elapsed = (double) gt_timer_elapsed_usec(timer) / 1000000.0;
+    gt_timer_delete(timer);
+    if (!had_err && (arguments->benchmark || arguments->verbose)) {
+      printf("# rendered "GT_WU" tiles of zoom levels "GT_WU"-"GT_WU" in "
+             "%.2fs", numoftiles, arguments->minzoom, maxzoom, elapsed);
+      if (elapsed > 0.0)
+        printf(" (%.1f tiles/s)", (double) numoftiles / elapsed);
+      printf("\n");
+    }
+  }
+
+  gt_tile_renderer_delete(tr);
+  gt_style_delete(sty);
+  gt_str_delete(stylefile);
+  gt_free(seqid);
+  gt_feature_index_delete(features);
+  return had_err;
+}
+
+GtTool* gt_sketch_tiles(void)
+{
+  return gt_tool_new(gt_sketch_tiles_arguments_new,
+                     gt_sketch_tiles_arguments_delete,
+                     gt_sketch_tiles_option_parser_new,
+                     NULL,
+                     gt_sketch_tiles_runner);
+}
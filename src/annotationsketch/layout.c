@@ -61,7 +61,8 @@ struct GtLayout {
   GtTextWidthCalculator *twc;
   bool own_twc,
        layout_done;
-  GtArray *custom_tracks;
+  GtArray *custom_tracks,
+          *density_tracks;
   GtHashmap *tracks,
             *blocks;
   GtRange viewrange;
@@ -213,7 +214,8 @@ static int render_custom_tracks(GT_UNUSED void *key, void *value, void *data,
   return had_err;
 }
 
-static int check_width(unsigned int width, GtStyle *style, GtError *err)
+static int check_width(unsigned int width, GtStyle *style, double *result,
+                       GtError *err)
 {
   int had_err = 0;
   double margins = MARGINS_DEFAULT;
@@ -222,6 +224,8 @@ static int check_width(unsigned int width, GtStyle *style, GtError *err)
                        &margins, NULL, err) == GT_STYLE_QUERY_ERROR) {
     had_err = -1;
   }
+  if (result)
+    *result = margins;
   if (!had_err && gt_double_smaller_double(width - 2*margins, 0))
   {
     gt_error_set(err, "layout width must at least be twice the x-margin size "
@@ -242,7 +246,7 @@ GtLayout* gt_layout_new(GtDiagram *diagram,
   GtLayout *layout;
   GtTextWidthCalculator *twc;
   gt_assert(diagram && width > 0 && style && err);
-  if (check_width(width, style, err) < 0)
+  if (check_width(width, style, NULL, err) < 0)
     return NULL;
   twc = gt_text_width_calculator_cairo_new(NULL, style, err);
   if (!twc)
@@ -263,11 +267,12 @@ GtLayout* gt_layout_new_with_twc(GtDiagram *diagram,
 {
   GtLayout *layout;
   GtHashmap *blocks;
+  double margins;
   gt_assert(diagram);
   gt_assert(style);
   gt_assert(twc);
   gt_assert(err);
-  if (check_width(width, style, err) < 0)
+  if (check_width(width, style, &margins, err) < 0)
     return NULL;
   layout = gt_calloc(1, sizeof (GtLayout));
   layout->twc = twc;
@@ -284,12 +289,15 @@ GtLayout* gt_layout_new_with_twc(GtDiagram *diagram,
   layout->own_twc = false;
   layout->layout_done = false;
   layout->custom_tracks = gt_array_ref(gt_diagram_get_custom_tracks(diagram));
+  layout->density_tracks = gt_array_new(sizeof (GtCustomTrack*));
   /* XXX: use other container type here! */
   layout->tracks = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
                                   (GtFree) gt_track_delete);
-  blocks = gt_diagram_get_blocks(diagram, err);
+  blocks = gt_diagram_get_blocks(diagram, (GtUword) (width - 2 * margins),
+                                 layout->density_tracks, err);
   if (!blocks) {
     gt_array_delete(layout->custom_tracks);
+    gt_array_delete(layout->density_tracks);
     gt_hashmap_delete(layout->tracks);
     gt_free(layout);
     return NULL;
@@ -300,12 +308,18 @@ GtLayout* gt_layout_new_with_twc(GtDiagram *diagram,
 
 void gt_layout_delete(GtLayout *layout)
 {
+  GtUword i;
   if (!layout) return;
   gt_rwlock_wrlock(layout->lock);
   if (layout->twc && layout->own_twc)
     gt_text_width_calculator_delete(layout->twc);
   gt_hashmap_delete(layout->tracks);
   gt_array_delete(layout->custom_tracks);
+  for (i = 0; i < gt_array_size(layout->density_tracks); i++) {
+    gt_custom_track_delete(*(GtCustomTrack**)
+                             gt_array_get(layout->density_tracks, i));
+  }
+  gt_array_delete(layout->density_tracks);
   if (layout->blocks)
     gt_hashmap_delete(layout->blocks);
   gt_rwlock_unlock(layout->lock);
@@ -352,6 +366,11 @@ int gt_layout_sketch(GtLayout *layout, GtCanvas *target_canvas, GtError *err)
                                                           i);
       had_err = render_custom_tracks(NULL, ct, &rti, err);
     }
+    for (i = 0; !had_err && i < gt_array_size(layout->density_tracks); i++) {
+      GtCustomTrack *ct = *(GtCustomTrack**)
+                            gt_array_get(layout->density_tracks, i);
+      had_err = render_custom_tracks(NULL, ct, &rti, err);
+    }
   }
   return had_err ? -1 : 0;
 }
@@ -442,7 +461,8 @@ int gt_layout_get_height(GtLayout *layout, GtUword *result,
                            &captionspace, NULL, err) == GT_STYLE_QUERY_ERROR) {
         return -1;
       }
-      height += gt_array_size(layout->custom_tracks)
+      height += (gt_array_size(layout->custom_tracks)
+                   + gt_array_size(layout->density_tracks))
                     * (theight + captionspace);
     }
 
@@ -457,6 +477,17 @@ int gt_layout_get_height(GtLayout *layout, GtUword *result,
       }
       height += tmp;
     }
+    for (i = 0; i < gt_array_size(layout->density_tracks); i++)
+    {
+      GtCustomTrack *ct = *(GtCustomTrack**)
+                            gt_array_get(layout->density_tracks, i);
+      height += gt_custom_track_get_height(ct);
+      if (gt_style_get_num(layout->style, "format", "track_vspace", &tmp,
+                           NULL, err) == GT_STYLE_QUERY_ERROR) {
+        return -1;
+      }
+      height += tmp;
+    }
 
     /* add header space and footer */
     if (gt_style_get_num(layout->style, "format", "ruler_space",
@@ -26,6 +26,7 @@
 #include "core/assert_api.h"
 #include "core/cstr_api.h"
 #include "core/ensure.h"
+#include "core/hashmap.h"
 #include "core/log.h"
 #include "core/ma.h"
 #include "core/thread_api.h"
@@ -78,10 +79,239 @@ struct GtStyle
   lua_State *L;
   GtUword reference_count;
   GtRWLock *lock, *clone_lock;
-  bool unsafe;
+  bool unsafe,
+       use_snapshot;
+  GtHashmap *snapshot; /* section -> key -> StyleEntry */
   char *filename;
 };
 
+/* A compiled entry of the style table. For static values all the
+   representations the typed getters can return are resolved once, callbacks
+   are marked and left to the Lua interpreter. */
+typedef struct {
+  bool is_function,
+       has_color,
+       has_str,
+       has_num,
+       has_bool;
+  GtColor color;
+  char *str;
+  double num;
+  bool boolval;
+} StyleEntry;
+
+typedef enum {
+  STYLE_COLOR,
+  STYLE_STR,
+  STYLE_NUM,
+  STYLE_BOOL
+} StyleValueType;
+
+/* Compiles the value on top of the Lua stack, the stack is left unchanged. */
+static StyleEntry* style_entry_new(lua_State *L)
+{
+  StyleEntry *entry = gt_calloc(1, sizeof *entry);
+  switch (lua_type(L, -1)) {
+    case LUA_TFUNCTION:
+      entry->is_function = true;
+      break;
+    case LUA_TTABLE:
+      /* same semantics as the color lookup in the Lua state */
+      entry->has_color = true;
+      entry->color.red = entry->color.green = entry->color.blue =
+        entry->color.alpha = 0.5;
+      lua_getfield(L, -1, "red");
+      if (lua_isnumber(L, -1))
+        entry->color.red = lua_tonumber(L, -1);
+      lua_pop(L, 1);
+      lua_getfield(L, -1, "green");
+      if (lua_isnumber(L, -1))
+        entry->color.green = lua_tonumber(L, -1);
+      lua_pop(L, 1);
+      lua_getfield(L, -1, "blue");
+      if (lua_isnumber(L, -1))
+        entry->color.blue = lua_tonumber(L, -1);
+      lua_pop(L, 1);
+      lua_getfield(L, -1, "alpha");
+      if (lua_isnumber(L, -1))
+        entry->color.alpha = lua_tonumber(L, -1);
+      lua_pop(L, 1);
+      break;
+    case LUA_TBOOLEAN:
+      entry->has_bool = true;
+      entry->boolval = lua_toboolean(L, -1);
+      break;
+    case LUA_TNUMBER:
+    case LUA_TSTRING:
+      /* numbers are also strings and numeric strings are also numbers */
+      if (lua_isnumber(L, -1)) {
+        entry->has_num = true;
+        entry->num = lua_tonumber(L, -1);
+      }
+      /* lua_tostring() converts numbers in place, convert a copy */
+      lua_pushvalue(L, -1);
+      entry->has_str = true;
+      entry->str = gt_cstr_dup(lua_tostring(L, -1));
+      lua_pop(L, 1);
+      break;
+    default:
+      break;
+  }
+  return entry;
+}
+
+static void style_entry_delete(void *data)
+{
+  StyleEntry *entry = data;
+  if (!entry) return;
+  gt_free(entry->str);
+  gt_free(entry);
+}
+
+static GtHashmap* style_snapshot_section_new(void)
+{
+  return gt_hashmap_new(GT_HASH_STRING, gt_free_func, style_entry_delete);
+}
+
+/* Compiles the section table on top of the Lua stack. */
+static GtHashmap* style_compile_section(lua_State *L)
+{
+  GtHashmap *entries = style_snapshot_section_new();
+  lua_pushnil(L);
+  while (lua_next(L, -2)) {
+    if (lua_type(L, -2) == LUA_TSTRING) {
+      gt_hashmap_add(entries, gt_cstr_dup(lua_tostring(L, -2)),
+                     style_entry_new(L));
+    }
+    lua_pop(L, 1);
+  }
+  return entries;
+}
+
+/* Resolves all entries of the style table into the snapshot of <sty>, such
+   that the getters only have to enter the Lua interpreter for callbacks.
+   Tables with metatables cannot be compiled, in this case (and for shared Lua
+   states) no snapshot is kept and all lookups are done in Lua.
+   Must be called with the write lock held. */
+static void style_compile(GtStyle *sty)
+{
+  bool compilable = true;
+  gt_hashmap_delete(sty->snapshot);
+  sty->snapshot = NULL;
+  if (!sty->use_snapshot)
+    return;
+  lua_getglobal(sty->L, "style");
+  if (lua_isnil(sty->L, -1)) {
+    /* nothing is set */
+    sty->snapshot = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                                   (GtFree) gt_hashmap_delete);
+  }
+  else if (lua_istable(sty->L, -1) && !lua_getmetatable(sty->L, -1)) {
+    sty->snapshot = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                                   (GtFree) gt_hashmap_delete);
+    lua_pushnil(sty->L);
+    while (compilable && lua_next(sty->L, -2)) {
+      if (lua_type(sty->L, -2) == LUA_TSTRING && lua_istable(sty->L, -1)) {
+        if (lua_getmetatable(sty->L, -1)) {
+          lua_pop(sty->L, 2); /* metatable and value */
+          compilable = false;
+        }
+        else {
+          gt_hashmap_add(sty->snapshot, gt_cstr_dup(lua_tostring(sty->L, -2)),
+                         style_compile_section(sty->L));
+        }
+      }
+      lua_pop(sty->L, 1);
+    }
+    if (!compilable) {
+      gt_hashmap_delete(sty->snapshot);
+      sty->snapshot = NULL;
+    }
+  }
+  else if (lua_istable(sty->L, -1))
+    lua_pop(sty->L, 1); /* the metatable */
+  lua_pop(sty->L, 1);
+}
+
+/* Recompiles the entry <section>/<key> after it has been changed.
+   Must be called with the write lock held. */
+static void style_snapshot_update(GtStyle *sty, const char *section,
+                                  const char *key)
+{
+  GtHashmap *entries;
+  if (!sty->snapshot)
+    return;
+  if (!(entries = gt_hashmap_get(sty->snapshot, section))) {
+    entries = style_snapshot_section_new();
+    gt_hashmap_add(sty->snapshot, gt_cstr_dup(section), entries);
+  }
+  gt_hashmap_remove(entries, key);
+  lua_getglobal(sty->L, "style");
+  if (lua_istable(sty->L, -1)) {
+    lua_getfield(sty->L, -1, section);
+    if (lua_istable(sty->L, -1)) {
+      lua_getfield(sty->L, -1, key);
+      if (!lua_isnil(sty->L, -1))
+        gt_hashmap_add(entries, gt_cstr_dup(key), style_entry_new(sty->L));
+      lua_pop(sty->L, 1);
+    }
+    lua_pop(sty->L, 1);
+  }
+  lua_pop(sty->L, 1);
+}
+
+/* Looks up <section>/<key> in the snapshot of <sty> and stores its value of
+   the given <type> in <result> and the query status in <status>. Returns
+   false if the value has to be determined by the Lua interpreter, that is, if
+   there is no snapshot or the entry is a callback. */
+static bool style_snapshot_get(const GtStyle *sty, const char *section,
+                               const char *key, StyleValueType type,
+                               void *result, GtStyleQueryStatus *status)
+{
+  GtHashmap *entries;
+  StyleEntry *entry = NULL;
+  bool found = false;
+  gt_rwlock_rdlock(sty->lock);
+  if (sty->snapshot) {
+    if ((entries = gt_hashmap_get(sty->snapshot, section)))
+      entry = gt_hashmap_get(entries, key);
+    if (!entry || !entry->is_function) {
+      found = true;
+      *status = GT_STYLE_QUERY_NOT_SET;
+      if (entry) {
+        switch (type) {
+          case STYLE_COLOR:
+            if (entry->has_color) {
+              *(GtColor*) result = entry->color;
+              *status = GT_STYLE_QUERY_OK;
+            }
+            break;
+          case STYLE_STR:
+            if (entry->has_str) {
+              gt_str_set((GtStr*) result, entry->str);
+              *status = GT_STYLE_QUERY_OK;
+            }
+            break;
+          case STYLE_NUM:
+            if (entry->has_num) {
+              *(double*) result = entry->num;
+              *status = GT_STYLE_QUERY_OK;
+            }
+            break;
+          case STYLE_BOOL:
+            if (entry->has_bool) {
+              *(bool*) result = entry->boolval;
+              *status = GT_STYLE_QUERY_OK;
+            }
+            break;
+        }
+      }
+    }
+  }
+  gt_rwlock_unlock(sty->lock);
+  return found;
+}
+
 static void style_lua_new_table(lua_State *L, const char *key)
 {
   lua_pushstring(L, key);
@@ -140,6 +370,7 @@ GtStyle* gt_style_new(GtError *err)
     luaL_opencustomlibs(sty->L, luasecurelibs);
   sty->lock = gt_rwlock_new();
   sty->unsafe = false;
+  sty->use_snapshot = true;
   sty->clone_lock = gt_rwlock_new();
 
   default_formats = gt_str_new_cstr(gt_default_format_style);
@@ -252,6 +483,7 @@ int gt_style_load_file(GtStyle *sty, const char *filename, GtError *err)
     }
     lua_pop(sty->L, 1);
   }
+  style_compile(sty);
   gt_assert(lua_gettop(sty->L) == stack_size);
   gt_rwlock_unlock(sty->lock);
   return had_err;
@@ -323,14 +555,17 @@ GtStyleQueryStatus gt_style_get_color_with_track(const GtStyle *sty,
   int stack_size;
 #endif
   int i = 0;
+  GtStyleQueryStatus status;
   gt_assert(sty && section && key && color);
   gt_error_check(err);
+  /* set default colors */
+  color->red = 0.5; color->green = 0.5; color->blue = 0.5; color->alpha = 0.5;
+  if (style_snapshot_get(sty, section, key, STYLE_COLOR, color, &status))
+    return status;
   gt_rwlock_wrlock(sty->lock);
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
-  /* set default colors */
-  color->red = 0.5; color->green = 0.5; color->blue = 0.5; color->alpha = 0.5;
   /* get section */
   i = style_find_section_for_getting(sty, section);
   /* could not get section, return default */
@@ -436,6 +671,7 @@ void gt_style_set_color(GtStyle *sty, const char *section, const char *key,
   lua_pushnumber(sty->L, color->alpha);
   lua_settable(sty->L, -3);
   lua_pop(sty->L, i);
+  style_snapshot_update(sty, section, key);
   gt_assert(lua_gettop(sty->L) == stack_size);
   gt_rwlock_unlock(sty->lock);
 }
@@ -451,8 +687,11 @@ GtStyleQueryStatus gt_style_get_str_with_track(const GtStyle *sty,
   int stack_size;
 #endif
   int i = 0;
+  GtStyleQueryStatus status;
   gt_assert(sty && key && section);
   gt_error_check(err);
+  if (style_snapshot_get(sty, section, key, STYLE_STR, text, &status))
+    return status;
   gt_rwlock_wrlock(sty->lock);
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
@@ -530,6 +769,7 @@ void gt_style_set_str(GtStyle *sty, const char *section, const char *key,
   lua_pushstring(sty->L, gt_str_get(value));
   lua_settable(sty->L, -3);
   lua_pop(sty->L, i);
+  style_snapshot_update(sty, section, key);
   gt_assert(lua_gettop(sty->L) == stack_size);
   gt_rwlock_unlock(sty->lock);
 }
@@ -545,8 +785,11 @@ GtStyleQueryStatus gt_style_get_num_with_track(const GtStyle *sty,
   int stack_size;
 #endif
   int i = 0;
+  GtStyleQueryStatus status;
   gt_assert(sty && key && section && val);
   gt_error_check(err);
+  if (style_snapshot_get(sty, section, key, STYLE_NUM, val, &status))
+    return status;
   gt_rwlock_wrlock(sty->lock);
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
@@ -629,6 +872,7 @@ void gt_style_set_num(GtStyle *sty, const char *section, const char *key,
   lua_pushnumber(sty->L, number);
   lua_settable(sty->L, -3);
   lua_pop(sty->L, i);
+  style_snapshot_update(sty, section, key);
   gt_assert(lua_gettop(sty->L) == stack_size);
   gt_rwlock_unlock(sty->lock);
 }
@@ -644,8 +888,11 @@ GtStyleQueryStatus gt_style_get_bool_with_track(const GtStyle *sty,
   int stack_size;
 #endif
   int i = 0;
+  GtStyleQueryStatus status;
   gt_assert(sty && key && section);
   gt_error_check(err);
+  if (style_snapshot_get(sty, section, key, STYLE_BOOL, val, &status))
+    return status;
   gt_rwlock_wrlock(sty->lock);
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
@@ -723,6 +970,7 @@ void gt_style_set_bool(GtStyle *sty, const char *section, const char *key,
   lua_pushboolean(sty->L, val);
   lua_settable(sty->L, -3);
   lua_pop(sty->L, i);
+  style_snapshot_update(sty, section, key);
   gt_assert(lua_gettop(sty->L) == stack_size);
   gt_rwlock_unlock(sty->lock);
 }
@@ -750,6 +998,7 @@ void gt_style_unset(GtStyle *sty, const char *section, const char *key)
     lua_pop(sty->L, 1);
   }
   lua_pop(sty->L, 1);
+  style_snapshot_update(sty, section, key);
   gt_assert(lua_gettop(sty->L) == stack_size);
   gt_rwlock_unlock(sty->lock);
 }
@@ -801,6 +1050,7 @@ int gt_style_load_str(GtStyle *sty, GtStr *instr, GtError *err)
     had_err = -1;
     lua_pop(sty->L, 1);
   }
+  style_compile(sty);
   gt_assert(lua_gettop(sty->L) == stack_size);
   gt_rwlock_unlock(sty->lock);
   return had_err;
@@ -938,6 +1188,49 @@ int gt_style_unit_test(GtError *err)
                                    testerr) != GT_STYLE_QUERY_ERROR);
   gt_ensure((strcmp(gt_str_get(str),"")==0));
 
+  /* static values are compiled, callbacks are evaluated by Lua */
+  gt_str_set(sty_buffer, "style = { snap = { num = 3, numstr = \"4.5\", "
+                         "flag = false, cb = function() return 7 end } }");
+  gt_ensure(!gt_style_load_str(sty, sty_buffer, testerr));
+  gt_ensure(gt_style_get_num(sty, "snap", "num", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 3.0);
+  gt_str_reset(str);
+  gt_ensure(gt_style_get_str(sty, "snap", "num", str, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(strcmp(gt_str_get(str), "3") == 0);
+  gt_ensure(gt_style_get_num(sty, "snap", "numstr", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 4.5);
+  val = true;
+  gt_ensure(gt_style_get_bool(sty, "snap", "flag", &val, NULL,
+                              testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(!val);
+  gt_ensure(gt_style_get_num(sty, "snap", "flag", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_NOT_SET);
+  gt_ensure(gt_style_get_color(sty, "snap", "num", &tmpcol, NULL,
+                               testerr) == GT_STYLE_QUERY_NOT_SET);
+  gt_ensure(gt_color_equals(&tmpcol, &defcol));
+  gt_ensure(gt_style_get_num(sty, "snap", "cb", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 7.0);
+  gt_ensure(gt_style_get_num(sty, "format", "margins", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_NOT_SET);
+  gt_ensure(!gt_error_is_set(testerr));
+
+  /* changes are reflected by the compiled values */
+  gt_style_unset(sty, "snap", "num");
+  gt_ensure(gt_style_get_num(sty, "snap", "num", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_NOT_SET);
+  gt_style_set_num(sty, "snap", "cb", 1.0);
+  gt_ensure(gt_style_get_num(sty, "snap", "cb", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 1.0);
+  gt_style_set_color(sty, "new", "fill", &col1);
+  gt_ensure(gt_style_get_color(sty, "new", "fill", &tmpcol, NULL,
+                               testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(gt_color_equals(&tmpcol, &col1));
+
   /* mem cleanup */
   gt_error_delete(testerr);
   gt_str_delete(test1);
@@ -960,6 +1253,7 @@ void gt_style_delete_without_state(GtStyle *sty)
     return;
   }
   gt_free(sty->filename);
+  gt_hashmap_delete(sty->snapshot);
   gt_rwlock_unlock(sty->lock);
   gt_rwlock_delete(sty->lock);
   gt_rwlock_delete(sty->clone_lock);
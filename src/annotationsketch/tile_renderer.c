@@ -0,0 +1,375 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include "annotationsketch/block.h"
+#include "annotationsketch/canvas.h"
+#include "annotationsketch/canvas_cairo_file.h"
+#include "annotationsketch/default_formats.h"
+#include "annotationsketch/diagram.h"
+#include "annotationsketch/text_width_calculator_cairo.h"
+#include "annotationsketch/tile_renderer.h"
+#include "core/ensure.h"
+#include "core/hashmap.h"
+#include "core/ma.h"
+#include "core/multithread_api.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_node.h"
+
+#define GT_TILE_RENDERER_MAXZOOM  63
+
+struct GtTileRenderer {
+  GtDiagram *diagram;
+  GtStyle *style;
+  GtTextWidthCalculator *twc;
+  GtRange range;
+  GtUword tile_width;
+  double margins;
+  GtLayout *layouts[GT_TILE_RENDERER_MAXZOOM + 1]; /* created on demand */
+  GtUword heights[GT_TILE_RENDERER_MAXZOOM + 1];
+  GtMutex *mutex;                                  /* protects the layouts */
+};
+
+static int sort_block_elements(GT_UNUSED void *key, void *value, void *data,
+                               GT_UNUSED GtError *err)
+{
+  GtArray *blocks = value;
+  GtUword i;
+  for (i = 0; i < gt_array_size(blocks); i++)
+    gt_block_sort_elements(*(GtBlock**) gt_array_get(blocks, i), data);
+  return 0;
+}
+
+GtTileRenderer* gt_tile_renderer_new(GtFeatureIndex *feature_index,
+                                     const char *seqid, const GtRange *range,
+                                     GtStyle *style, GtUword tile_width,
+                                     GtError *err)
+{
+  GtTileRenderer *tr;
+  GtDiagram *diagram;
+  GtTextWidthCalculator *twc;
+  double margins = MARGINS_DEFAULT;
+  gt_error_check(err);
+  gt_assert(feature_index && seqid && range && style && tile_width > 0);
+
+  if (gt_style_get_num(style, "format", "margins", &margins, NULL,
+                       err) == GT_STYLE_QUERY_ERROR) {
+    return NULL;
+  }
+  if (!(diagram = gt_diagram_new(feature_index, seqid, range, style, err)))
+    return NULL;
+  if (!(twc = gt_text_width_calculator_cairo_new(NULL, style, err))) {
+    gt_diagram_delete(diagram);
+    return NULL;
+  }
+
+  tr = gt_calloc(1, sizeof *tr);
+  tr->diagram = diagram;
+  tr->style = style;
+  tr->twc = twc;
+  tr->range = *range;
+  tr->tile_width = tile_width;
+  tr->margins = margins;
+  tr->mutex = gt_mutex_new();
+  return tr;
+}
+
+unsigned int gt_tile_renderer_max_zoom(const GtTileRenderer *tr)
+{
+  unsigned int zoom = 0;
+  gt_assert(tr);
+  while (zoom < GT_TILE_RENDERER_MAXZOOM &&
+         ((gt_range_length(&tr->range) - 1) >> zoom) >= tr->tile_width) {
+    zoom++;
+  }
+  return zoom;
+}
+
+GtUword gt_tile_renderer_num_of_tiles(const GtTileRenderer *tr,
+                                      unsigned int zoom)
+{
+  GtUword span;
+  gt_assert(tr && zoom <= gt_tile_renderer_max_zoom(tr));
+  span = tr->tile_width << zoom;
+  return (gt_range_length(&tr->range) + span - 1) / span;
+}
+
+GtLayout* gt_tile_renderer_get_layout(GtTileRenderer *tr, unsigned int zoom,
+                                      GtError *err)
+{
+  GtLayout *layout;
+  GtHashmap *blocks;
+  GtUword width;
+  gt_error_check(err);
+  gt_assert(tr && zoom <= gt_tile_renderer_max_zoom(tr));
+
+  gt_mutex_lock(tr->mutex);
+  if (!(layout = tr->layouts[zoom])) {
+    /* the layout spans the whole range, with the scale of the tiles */
+    width = (gt_range_length(&tr->range) + ((GtUword) 1 << zoom) - 1) >> zoom;
+    /* sort the elements of the blocks for this level of detail once, the
+       tiles are drawn concurrently from them */
+    if ((blocks = gt_diagram_get_blocks(tr->diagram, width, NULL, err))) {
+      (void) gt_hashmap_foreach(blocks, sort_block_elements, tr->style, NULL);
+      layout = gt_layout_new_with_twc(tr->diagram,
+                                      (unsigned int) (width + 2 * tr->margins),
+                                      tr->style, tr->twc, err);
+    }
+    /* computing the height breaks the tracks into lines */
+    if (layout && gt_layout_get_height(layout, tr->heights + zoom, err)) {
+      gt_layout_delete(layout);
+      layout = NULL;
+    }
+    tr->layouts[zoom] = layout;
+  }
+  gt_mutex_unlock(tr->mutex);
+  return layout;
+}
+
+GtCanvas* gt_tile_renderer_render(GtTileRenderer *tr, unsigned int zoom,
+                                  GtUword tile, GtGraphicsOutType type,
+                                  GtError *err)
+{
+  GtLayout *layout;
+  GtCanvas *canvas;
+  GtRange range;
+  GtUword span;
+  gt_error_check(err);
+  gt_assert(tr && tile < gt_tile_renderer_num_of_tiles(tr, zoom));
+
+  if (!(layout = gt_tile_renderer_get_layout(tr, zoom, err)))
+    return NULL;
+  if (!(canvas = gt_canvas_cairo_file_new(tr->style, type, tr->tile_width,
+                                          tr->heights[zoom], NULL, err))) {
+    return NULL;
+  }
+  /* the last tile keeps the scale and is padded beyond the range */
+  span = tr->tile_width << zoom;
+  range.start = tr->range.start + tile * span;
+  range.end = range.start + span - 1;
+  gt_canvas_restrict_to_range(canvas, range);
+  if (gt_layout_sketch(layout, canvas, err)) {
+    gt_canvas_delete(canvas);
+    return NULL;
+  }
+  return canvas;
+}
+
+static const char* tile_renderer_suffix(GtGraphicsOutType type)
+{
+  switch (type) {
+    case GT_GRAPHICS_PDF: return "pdf";
+    case GT_GRAPHICS_PS:  return "ps";
+    case GT_GRAPHICS_SVG: return "svg";
+    default:              return "png";
+  }
+}
+
+typedef struct {
+  GtTileRenderer *tr;
+  GtGraphicsOutType type;
+  const char *outprefix;
+  unsigned int zoom,
+               maxzoom;
+  GtUword next,
+          numoftiles;
+  GtMutex *mutex;
+  GtError *err;
+  int had_err;
+} TileRendererThreadInfo;
+
+static void* tile_renderer_thread(void *data)
+{
+  TileRendererThreadInfo *info = data;
+  GtCanvas *canvas;
+  GtError *err;
+  GtStr *str;
+  unsigned int zoom;
+  GtUword tile;
+  int had_err = 0;
+  gt_assert(info);
+
+  err = gt_error_new();
+  str = gt_str_new();
+  while (!had_err) {
+    /* fetch the next tile, the zoom levels are rendered one after another */
+    gt_mutex_lock(info->mutex);
+    while (!info->had_err && info->zoom <= info->maxzoom &&
+           info->next == gt_tile_renderer_num_of_tiles(info->tr, info->zoom)) {
+      info->zoom++;
+      info->next = 0;
+    }
+    if (info->had_err || info->zoom > info->maxzoom) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    zoom = info->zoom;
+    tile = info->next++;
+    gt_mutex_unlock(info->mutex);
+
+    if (!(canvas = gt_tile_renderer_render(info->tr, zoom, tile, info->type,
+                                           err))) {
+      had_err = -1;
+    }
+    if (!had_err && info->outprefix) {
+      gt_str_reset(str);
+      gt_str_append_cstr(str, info->outprefix);
+      gt_str_append_char(str, '_');
+      gt_str_append_uint(str, zoom);
+      gt_str_append_char(str, '_');
+      gt_str_append_uword(str, tile);
+      gt_str_append_char(str, '.');
+      gt_str_append_cstr(str, tile_renderer_suffix(info->type));
+      had_err = gt_canvas_cairo_file_to_file((GtCanvasCairoFile*) canvas,
+                                             gt_str_get(str), err);
+    }
+    else if (!had_err) {
+      /* encode the tile nevertheless, it is part of the rendering costs */
+      gt_str_reset(str);
+      (void) gt_canvas_cairo_file_to_stream((GtCanvasCairoFile*) canvas, str);
+    }
+    gt_canvas_delete(canvas);
+
+    gt_mutex_lock(info->mutex);
+    if (had_err && !info->had_err) {
+      gt_error_set(info->err, "%s", gt_error_get(err));
+      info->had_err = had_err;
+    }
+    else if (!had_err)
+      info->numoftiles++;
+    gt_mutex_unlock(info->mutex);
+  }
+  gt_str_delete(str);
+  gt_error_delete(err);
+  return NULL;
+}
+
+int gt_tile_renderer_render_all(GtTileRenderer *tr, unsigned int minzoom,
+                                unsigned int maxzoom, GtGraphicsOutType type,
+                                const char *outprefix, GtUword *numoftiles,
+                                GtError *err)
+{
+  TileRendererThreadInfo info;
+  unsigned int zoom;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(tr && minzoom <= maxzoom && numoftiles);
+  gt_assert(maxzoom <= gt_tile_renderer_max_zoom(tr));
+
+  /* the layouts are created before the threads start, such that no thread
+     waits for the line breaking of another one */
+  for (zoom = minzoom; !had_err && zoom <= maxzoom; zoom++) {
+    if (!gt_tile_renderer_get_layout(tr, zoom, err))
+      had_err = -1;
+  }
+  if (!had_err) {
+    info.tr = tr;
+    info.type = type;
+    info.outprefix = outprefix;
+    info.zoom = minzoom;
+    info.maxzoom = maxzoom;
+    info.next = 0;
+    info.numoftiles = 0;
+    info.mutex = gt_mutex_new();
+    info.err = err;
+    info.had_err = 0;
+    had_err = gt_multithread(tile_renderer_thread, &info, err);
+    if (!had_err)
+      had_err = info.had_err;
+    *numoftiles = info.numoftiles;
+    gt_mutex_delete(info.mutex);
+  }
+  return had_err;
+}
+
+void gt_tile_renderer_delete(GtTileRenderer *tr)
+{
+  unsigned int zoom;
+  if (!tr) return;
+  for (zoom = 0; zoom <= GT_TILE_RENDERER_MAXZOOM; zoom++)
+    gt_layout_delete(tr->layouts[zoom]);
+  gt_text_width_calculator_delete(tr->twc);
+  gt_diagram_delete(tr->diagram);
+  gt_mutex_delete(tr->mutex);
+  gt_free(tr);
+}
+
+int gt_tile_renderer_unit_test(GtError *err)
+{
+  GtTileRenderer *tr;
+  GtFeatureIndex *fi;
+  GtGenomeNode *gn;
+  GtStyle *sty;
+  GtCanvas *canvas;
+  GtRange range = {1000, 9000};
+  GtUword numoftiles;
+  unsigned int maxzoom;
+  int had_err = 0;
+  gt_error_check(err);
+
+  fi = gt_feature_index_memory_new();
+  gn = gt_feature_node_new_standard_gene();
+  had_err = gt_feature_index_add_feature_node(fi, gt_feature_node_cast(gn),
+                                              err);
+  gt_genome_node_delete(gn);
+  if (!(sty = gt_style_new(err)))
+    had_err = -1;
+  tr = NULL;
+  if (!had_err &&
+      !(tr = gt_tile_renderer_new(fi, "ctg123", &range, sty, 256, err))) {
+    had_err = -1;
+  }
+
+  if (!had_err) {
+    /* 8001 bases need 32 tiles of 256 bases or one tile of 8192 bases */
+    maxzoom = gt_tile_renderer_max_zoom(tr);
+    gt_ensure(maxzoom == 5);
+    gt_ensure(gt_tile_renderer_num_of_tiles(tr, 0) == 32);
+    gt_ensure(gt_tile_renderer_num_of_tiles(tr, 1) == 16);
+    gt_ensure(gt_tile_renderer_num_of_tiles(tr, maxzoom) == 1);
+  }
+
+  /* the layout of a zoom level is cached */
+  if (!had_err) {
+    GtLayout *layout = gt_tile_renderer_get_layout(tr, 2, err);
+    gt_ensure(layout);
+    gt_ensure(layout == gt_tile_renderer_get_layout(tr, 2, err));
+    gt_ensure(layout != gt_tile_renderer_get_layout(tr, 3, err));
+  }
+
+  if (!had_err) {
+    if (!(canvas = gt_tile_renderer_render(tr, 0, 31, GT_GRAPHICS_PNG, err)))
+      had_err = -1;
+    else {
+      gt_ensure(gt_canvas_get_height(canvas) == tr->heights[0]);
+      gt_canvas_delete(canvas);
+    }
+  }
+
+  if (!had_err) {
+    had_err = gt_tile_renderer_render_all(tr, 0, maxzoom, GT_GRAPHICS_PNG,
+                                          NULL, &numoftiles, err);
+    gt_ensure(numoftiles == 32 + 16 + 8 + 4 + 2 + 1);
+  }
+
+  gt_tile_renderer_delete(tr);
+  gt_style_delete(sty);
+  gt_feature_index_delete(fi);
+  return had_err;
+}
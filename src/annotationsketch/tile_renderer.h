@@ -0,0 +1,76 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef TILE_RENDERER_H
+#define TILE_RENDERER_H
+
+#include "annotationsketch/canvas_api.h"
+#include "annotationsketch/graphics_api.h"
+#include "annotationsketch/layout_api.h"
+#include "annotationsketch/style_api.h"
+#include "extended/feature_index_api.h"
+
+/* The <GtTileRenderer> class renders a sequence region into image tiles of a
+   fixed width, as requested by genome browsers. A tile of zoom level <z>
+   covers <tile_width> * 2^<z> bases, i.e., every pixel shows 2^<z> bases.
+   The <GtDiagram> of the region is built once, the <GtLayout> of every zoom
+   level is created on first use and shared by all tiles of this level, such
+   that the line breaking is done once per zoom level and the tracks line up
+   across adjacent tiles. Tiles can be rendered concurrently. */
+typedef struct GtTileRenderer GtTileRenderer;
+
+/* Returns a new <GtTileRenderer> for the features of <feature_index> on the
+   sequence region <seqid> in the sequence range <range>, which are drawn with
+   <style> into tiles of <tile_width> pixels. Returns NULL and sets <err> if
+   the diagram could not be built. */
+GtTileRenderer* gt_tile_renderer_new(GtFeatureIndex *feature_index,
+                                     const char *seqid, const GtRange *range,
+                                     GtStyle *style, GtUword tile_width,
+                                     GtError *err);
+/* Returns the smallest zoom level whose single tile covers the whole range of
+   <tile_renderer>. */
+unsigned int    gt_tile_renderer_max_zoom(const GtTileRenderer *tile_renderer);
+/* Returns the number of tiles of zoom level <zoom>. */
+GtUword         gt_tile_renderer_num_of_tiles(const GtTileRenderer
+                                              *tile_renderer,
+                                              unsigned int zoom);
+/* Returns the cached <GtLayout> of zoom level <zoom>, which is created on the
+   first call. Returns NULL and sets <err> on error. */
+GtLayout*       gt_tile_renderer_get_layout(GtTileRenderer *tile_renderer,
+                                            unsigned int zoom, GtError *err);
+/* Renders the tile number <tile> of zoom level <zoom> into a new
+   <GtCanvasCairoFile> of graphics type <type>, which has to be deleted by the
+   caller. Returns NULL and sets <err> on error. */
+GtCanvas*       gt_tile_renderer_render(GtTileRenderer *tile_renderer,
+                                        unsigned int zoom, GtUword tile,
+                                        GtGraphicsOutType type, GtError *err);
+/* Renders all tiles of the zoom levels <minzoom> to <maxzoom> with <gt_jobs>
+   threads. Tile <t> of zoom level <z> is written to the file
+   <outprefix>_<z>_<t>.<suffix>, where <suffix> is the file suffix of <type>.
+   If <outprefix> is NULL, the encoded tiles are discarded. The number of
+   rendered tiles is stored in <numoftiles>. Returns 0 on success, -1
+   otherwise. */
+int             gt_tile_renderer_render_all(GtTileRenderer *tile_renderer,
+                                            unsigned int minzoom,
+                                            unsigned int maxzoom,
+                                            GtGraphicsOutType type,
+                                            const char *outprefix,
+                                            GtUword *numoftiles, GtError *err);
+void            gt_tile_renderer_delete(GtTileRenderer *tile_renderer);
+int             gt_tile_renderer_unit_test(GtError *err);
+
+#endif
@@ -0,0 +1,43 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+/* <gt_atomic_load(ptr)> returns the value of the variable <*ptr> (an <int> or
+   a word, but not a <bool>), which is shared between threads without a lock,
+   and <gt_atomic_store(ptr, value)> sets <*ptr> to <value>. A thread which
+   loads a stored value also sees all writes the storing thread made before the
+   store (acquire and release semantics).
+   Both macros are only defined if the compiler provides atomic operations,
+   which is indicated by <GT_ATOMIC_AVAILABLE>. */
+#if defined(__ATOMIC_ACQUIRE)
+/* gcc >= 4.7 and clang */
+#define GT_ATOMIC_AVAILABLE
+#define gt_atomic_load(PTR) \
+        __atomic_load_n(PTR, __ATOMIC_ACQUIRE)
+#define gt_atomic_store(PTR, VALUE) \
+        __atomic_store_n(PTR, VALUE, __ATOMIC_RELEASE)
+/* gcc >= 4.1 only offers full memory barriers */
+#elif defined(__GNUC__) && ((__GNUC__ * 100 + __GNUC_MINOR__) >= 401)
+#define GT_ATOMIC_AVAILABLE
+#define gt_atomic_load(PTR) \
+        __sync_fetch_and_add(PTR, 0)
+#define gt_atomic_store(PTR, VALUE) \
+        ((void) (__sync_synchronize(), *(PTR) = (VALUE), __sync_synchronize()))
+#endif
+
+#endif
@@ -20,7 +20,10 @@
 #else
 #include <windows.h>
 #endif
+#include <errno.h>
 #include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include "core/compat.h"
 #include "core/dynalloc.h"
@@ -240,6 +243,78 @@ void gt_fa_unlock(FILE *stream)
   gt_xflock_unlock(fileno(stream));
 }
 
+FILE* gt_fa_fopen_replacement_func(const char *path, GtStr *tmpfilename,
+                                   const char *src_file, int src_line,
+                                   GtError *err)
+{
+  FAFileInfo *fileinfo;
+  FILE *fp;
+  int fd;
+  gt_error_check(err);
+  gt_assert(path && tmpfilename);
+  gt_assert(fa);
+  gt_str_set(tmpfilename, path);
+  gt_str_append_cstr(tmpfilename, ".XXXXXX");
+  if ((fd = gt_mkstemp(gt_str_get(tmpfilename))) == -1) {
+    gt_error_set(err, "cannot create temporary file \"%s\": %s",
+                 gt_str_get(tmpfilename), strerror(errno));
+    return NULL;
+  }
+#ifndef _WIN32
+  {
+    /* mkstemp(3) makes the file private, give it the permissions fopen(3)
+       would have given to <path> */
+    mode_t mask = umask(0);
+    (void) umask(mask);
+    (void) fchmod(fd, (S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH |
+                       S_IWOTH) & ~mask);
+  }
+#endif
+  if (!(fp = fdopen(fd, "wb"))) {
+    gt_error_set(err, "cannot open temporary file \"%s\": %s",
+                 gt_str_get(tmpfilename), strerror(errno));
+    (void) close(fd);
+    (void) remove(gt_str_get(tmpfilename));
+    return NULL;
+  }
+  fileinfo = gt_malloc(sizeof (FAFileInfo));
+  fileinfo->src_file = src_file;
+  fileinfo->src_line = src_line;
+  gt_mutex_lock(fa->file_mutex);
+  gt_hashmap_add(fa->file_pointer, fp, fileinfo);
+  gt_mutex_unlock(fa->file_mutex);
+  return fp;
+}
+
+int gt_fa_fclose_replacement(FILE *stream, const char *path,
+                             GtStr *tmpfilename, bool discard, GtError *err)
+{
+  const char *tmppath;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(stream && path && tmpfilename);
+  tmppath = gt_str_get(tmpfilename);
+  if (!discard && (fflush(stream) || ferror(stream))) {
+    gt_error_set(err, "cannot write file \"%s\": %s", tmppath,
+                 strerror(errno));
+    had_err = -1;
+  }
+  gt_fa_fclose(stream);
+#ifdef _WIN32
+  /* rename(3) does not replace existing files on Windows */
+  if (!discard && !had_err)
+    (void) remove(path);
+#endif
+  if (!discard && !had_err && rename(tmppath, path)) {
+    gt_error_set(err, "cannot rename file \"%s\" to \"%s\": %s", tmppath,
+                 path, strerror(errno));
+    had_err = -1;
+  }
+  if (discard || had_err)
+    (void) remove(tmppath);
+  return had_err;
+}
+
 gzFile gt_fa_gzopen_func(const char *path, const char *mode,
                          const char *src_file, int src_line, GtError *err)
 {
@@ -50,6 +50,22 @@ void    gt_fa_xfclose(FILE *stream);
 void    gt_fa_lock_shared(FILE *stream);
 void    gt_fa_lock_exclusive(FILE *stream);
 void    gt_fa_unlock(FILE *stream);
+/* Opens a new temporary file for writing in the directory of <path> and stores
+   its name in <tmpfilename>. <gt_fa_fclose_replacement()> renames it to <path>
+   when it is complete, hence processes which have opened or mapped <path>
+   keep reading the old file. Returns NULL and sets <err> on error. */
+#define gt_fa_fopen_replacement(path, tmpfilename, err)\
+        gt_fa_fopen_replacement_func(path, tmpfilename, __FILE__, __LINE__, \
+                                     err)
+FILE*   gt_fa_fopen_replacement_func(const char *path, GtStr *tmpfilename,
+                                     const char *src_file, int src_line,
+                                     GtError *err);
+/* Closes <stream> returned by <gt_fa_fopen_replacement()> and renames the
+   temporary file <tmpfilename> to <path>. If <discard> is true or an error
+   occurs, the temporary file is removed and <path> remains unchanged. */
+int     gt_fa_fclose_replacement(FILE *stream, const char *path,
+                                 GtStr *tmpfilename, bool discard,
+                                 GtError *err);
 
 /* functions for gzip file pointer */
 #define gt_fa_gzopen(path, mode, err)\
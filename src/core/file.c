@@ -35,7 +35,11 @@ struct GtFile {
        *orig_mode,
        unget_char;
   bool is_stdin,
-       unget_used;
+       unget_used,
+       is_part;
+  GtUword part_offset, /* a part of the file is read from this offset */
+          part_length,
+          part_left;   /* number of bytes of the part not read yet */
 };
 
 GtFileMode gt_file_mode_determine(const char *path)
@@ -134,6 +138,21 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
   return file;
 }
 
+GtFile* gt_file_open_part(const char *path, GtUword offset, GtUword length,
+                          GtError *err)
+{
+  GtFile *file;
+  gt_error_check(err);
+  gt_assert(path);
+  if (!(file = gt_file_open(GT_FILE_MODE_UNCOMPRESSED, path, "r", err)))
+    return NULL;
+  gt_xfseek(file->fileptr.file, (GtWord) offset, SEEK_SET);
+  file->is_part = true;
+  file->part_offset = offset;
+  file->part_length = file->part_left = length;
+  return file;
+}
+
 GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
                                 const char *mode)
 {
@@ -198,6 +217,11 @@ int gt_file_xfgetc(GtFile *file)
     else {
       switch (file->mode) {
         case GT_FILE_MODE_UNCOMPRESSED:
+          if (file->is_part) {
+            if (!file->part_left)
+              break;
+            file->part_left--;
+          }
           c = gt_xfgetc(file->fileptr.file);
           break;
         case GT_FILE_MODE_GZIP:
@@ -356,7 +380,11 @@ int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
   if (file) {
     switch (file->mode) {
       case GT_FILE_MODE_UNCOMPRESSED:
+        if (file->is_part && nbytes > file->part_left)
+          nbytes = file->part_left;
         rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
+        if (file->is_part)
+          file->part_left -= rval;
         break;
       case GT_FILE_MODE_GZIP:
         rval = gt_xgzread(file->fileptr.gzfile, buf, nbytes);
@@ -397,7 +425,12 @@ void gt_file_xrewind(GtFile *file)
   gt_assert(file);
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
-      rewind(file->fileptr.file);
+      if (file->is_part) {
+        gt_xfseek(file->fileptr.file, (GtWord) file->part_offset, SEEK_SET);
+        file->part_left = file->part_length;
+      }
+      else
+        rewind(file->fileptr.file);
       break;
     case GT_FILE_MODE_GZIP:
       gt_xgzrewind(file->fileptr.gzfile);
@@ -20,6 +20,7 @@
 
 #include <stdlib.h>
 #include "core/file_api.h"
+#include "core/types_api.h"
 
 typedef enum {
   GT_FILE_MODE_UNCOMPRESSED,
@@ -45,6 +46,13 @@ size_t      gt_file_basename_length(const char *path);
 GtFile*     gt_file_open(GtFileMode, const char *path, const char *mode,
                          GtError*);
 
+/* Create a new GtFile object for reading the <length> bytes of the
+   uncompressed file <path> which start at byte <offset>, the end of this part
+   is treated as the end of the file. Returns NULL and sets <err> if the file
+   <path> could not be opened. */
+GtFile*     gt_file_open_part(const char *path, GtUword offset, GtUword length,
+                              GtError*);
+
 /* Create a new GtFile object and open the underlying file handle, abort if
    the file <path> does not exist. The <file_mode> has to be given
    explicitly. */
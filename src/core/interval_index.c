@@ -0,0 +1,412 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/interval_index.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/msort.h"
+#include "core/str_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+
+/* subtrees with at most this level are scanned linearly */
+#define GT_INTERVAL_INDEX_SCANLEVEL  3
+/* the stack holds at most two entries per level of the tree */
+#define GT_INTERVAL_INDEX_STACKSIZE  (2 * 64)
+
+typedef struct {
+  GtUword start,
+          end,
+          max;  /* the maximal end position in the subtree rooted here */
+  void *data;
+} GtIntervalIndexEntry;
+
+struct GtIntervalIndex {
+  GtIntervalIndexEntry *entries;
+  GtUword size,
+          allocated;
+  int maxlevel; /* the level of the root of the implicit tree */
+  bool sorted,
+       indexed,
+       mapped;  /* <entries> point into memory not owned by the index */
+  GtFree free_func;
+};
+
+typedef struct {
+  GtUword x;    /* the index of the node */
+  int k;        /* the level of the node */
+  bool left_done;
+} GtIntervalIndexStackElem;
+
+GtIntervalIndex* gt_interval_index_new(GtFree free_func)
+{
+  GtIntervalIndex *ii = gt_calloc(1, sizeof *ii);
+  ii->free_func = free_func;
+  ii->sorted = true;
+  ii->indexed = false;
+  return ii;
+}
+
+static int interval_index_entry_cmp(const void *a, const void *b)
+{
+  const GtIntervalIndexEntry *e1 = a, *e2 = b;
+  if (e1->start != e2->start)
+    return e1->start < e2->start ? -1 : 1;
+  if (e1->end != e2->end)
+    return e1->end < e2->end ? -1 : 1;
+  return 0;
+}
+
+void gt_interval_index_add(GtIntervalIndex *ii, void *data, GtUword start,
+                           GtUword end)
+{
+  GtIntervalIndexEntry *entry;
+  gt_assert(ii && !ii->mapped && start <= end);
+  if (ii->size == ii->allocated) {
+    ii->allocated = ii->allocated * 1.2 + 256;
+    ii->entries = gt_realloc(ii->entries,
+                             sizeof (*ii->entries) * ii->allocated);
+  }
+  entry = ii->entries + ii->size;
+  entry->start = start;
+  entry->end = end;
+  entry->data = data;
+  if (ii->sorted && ii->size > 0 &&
+      interval_index_entry_cmp(entry - 1, entry) > 0) {
+    ii->sorted = false;
+  }
+  ii->size++;
+  ii->indexed = false;
+}
+
+bool gt_interval_index_remove(GtIntervalIndex *ii, const void *data)
+{
+  GtUword i;
+  gt_assert(ii && !ii->mapped);
+  for (i = 0; i < ii->size; i++) {
+    if (ii->entries[i].data == data) {
+      if (ii->free_func)
+        ii->free_func(ii->entries[i].data);
+      /* keep the order of the remaining entries */
+      memmove(ii->entries + i, ii->entries + i + 1,
+              sizeof (*ii->entries) * (ii->size - i - 1));
+      ii->size--;
+      ii->indexed = false;
+      return true;
+    }
+  }
+  return false;
+}
+
+GtUword gt_interval_index_size(const GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  return ii->size;
+}
+
+/* Computes the maximal end positions bottom-up. Node <i> of the implicit tree
+   has level <k> if the <k> least significant bits of <i> are set and bit <k>
+   is not. Its children are <i> - 2^(k-1) and <i> + 2^(k-1). The rightmost
+   path may lead out of the array, <last> is the maximum of the subtree of the
+   last node on the current level which is inside the array. */
+static void interval_index_build(GtIntervalIndex *ii)
+{
+  GtIntervalIndexEntry *e = ii->entries;
+  GtUword i, last_i = 0, last = 0, n = ii->size;
+  int k;
+  gt_assert(n > 0);
+  if (!ii->sorted) {
+    gt_msort(ii->entries, ii->size, sizeof (*ii->entries),
+             interval_index_entry_cmp);
+    ii->sorted = true;
+  }
+  for (i = 0; i < n; i += 2) {
+    last_i = i;
+    last = e[i].max = e[i].end;
+  }
+  for (k = 1; ((GtUword) 1 << k) <= n; k++) {
+    GtUword x = (GtUword) 1 << (k - 1),
+            step = x << 2;
+    for (i = (x << 1) - 1; i < n; i += step) {
+      GtUword max = e[i].end,
+              leftmax = e[i - x].max,
+              rightmax = i + x < n ? e[i + x].max : last;
+      if (leftmax > max)
+        max = leftmax;
+      if (rightmax > max)
+        max = rightmax;
+      e[i].max = max;
+    }
+    /* move to the parent of <last_i> */
+    last_i = (last_i >> k) & 1 ? last_i - x : last_i + x;
+    if (last_i < n && e[last_i].max > last)
+      last = e[last_i].max;
+  }
+  ii->maxlevel = k - 1;
+  ii->indexed = true;
+}
+
+void gt_interval_index_find_all_overlapping(GtIntervalIndex *ii,
+                                            GtUword start, GtUword end,
+                                            GtArray *results)
+{
+  GtIntervalIndexStackElem stack[GT_INTERVAL_INDEX_STACKSIZE];
+  GtIntervalIndexEntry *e;
+  GtUword n;
+  int t = 0;
+  gt_assert(ii && start <= end && results);
+  if (!(n = ii->size))
+    return;
+  if (!ii->indexed)
+    interval_index_build(ii);
+  e = ii->entries;
+
+  /* traverse the tree top-down, left before right, such that the results are
+     reported in the order of the array */
+  stack[t].x = ((GtUword) 1 << ii->maxlevel) - 1;
+  stack[t].k = ii->maxlevel;
+  stack[t++].left_done = false;
+  while (t > 0) {
+    GtIntervalIndexStackElem z = stack[--t];
+    if (z.k <= GT_INTERVAL_INDEX_SCANLEVEL) {
+      /* scan the small subtree rooted at <z.x> */
+      GtUword i, i0 = z.x >> z.k << z.k,
+              i1 = i0 + ((GtUword) 1 << (z.k + 1)) - 1;
+      if (i1 > n)
+        i1 = n;
+      for (i = i0; i < i1 && e[i].start <= end; i++) {
+        if (start <= e[i].end)
+          gt_array_add(results, e[i].data);
+      }
+    }
+    else if (!z.left_done) {
+      GtUword y = z.x - ((GtUword) 1 << (z.k - 1));
+      stack[t].x = z.x;
+      stack[t].k = z.k;
+      stack[t++].left_done = true;
+      /* the left child may lie outside of the array, if not, its subtree is
+         only visited if it contains an end position right of <start> */
+      if (y >= n || e[y].max >= start) {
+        stack[t].x = y;
+        stack[t].k = z.k - 1;
+        stack[t++].left_done = false;
+      }
+    }
+    else if (z.x < n && e[z.x].start <= end) {
+      if (start <= e[z.x].end)
+        gt_array_add(results, e[z.x].data);
+      stack[t].x = z.x + ((GtUword) 1 << (z.k - 1));
+      stack[t].k = z.k - 1;
+      stack[t++].left_done = false;
+    }
+    gt_assert(t <= GT_INTERVAL_INDEX_STACKSIZE);
+  }
+}
+
+int gt_interval_index_traverse(GtIntervalIndex *ii,
+                               GtIntervalIndexIteratorFunc func, void *info)
+{
+  GtUword i;
+  int rval = 0;
+  gt_assert(ii && func);
+  if (ii->size > 0 && !ii->indexed)
+    interval_index_build(ii);
+  for (i = 0; !rval && i < ii->size; i++) {
+    rval = func(ii->entries[i].data, ii->entries[i].start, ii->entries[i].end,
+                info);
+  }
+  return rval;
+}
+
+/* the serialized index consists of the number of intervals, the level of the
+   root and the indexed entries */
+void gt_interval_index_write(GtIntervalIndex *ii, FILE *fp)
+{
+  GtUword header[2];
+  gt_assert(ii && fp);
+  if (ii->size > 0 && !ii->indexed)
+    interval_index_build(ii);
+  header[0] = ii->size;
+  header[1] = (GtUword) ii->maxlevel;
+  gt_xfwrite(header, sizeof (GtUword), 2, fp);
+  if (ii->size > 0)
+    gt_xfwrite(ii->entries, sizeof (*ii->entries), ii->size, fp);
+}
+
+GtIntervalIndex* gt_interval_index_new_mapped(const void *mem, size_t memlen,
+                                              size_t *len)
+{
+  const GtUword *header = mem;
+  GtIntervalIndex *ii;
+  gt_assert(mem && len);
+  if (memlen < 2 * sizeof (GtUword) ||
+      (memlen - 2 * sizeof (GtUword)) / sizeof (GtIntervalIndexEntry)
+        < header[0] ||
+      header[1] >= (GtUword) GT_INTERVAL_INDEX_STACKSIZE / 2) {
+    return NULL;
+  }
+  ii = gt_calloc(1, sizeof *ii);
+  ii->size = ii->allocated = header[0];
+  ii->maxlevel = (int) header[1];
+  ii->entries = (GtIntervalIndexEntry*) (header + 2);
+  ii->sorted = ii->indexed = ii->mapped = true;
+  *len = 2 * sizeof (GtUword) + ii->size * sizeof (GtIntervalIndexEntry);
+  return ii;
+}
+
+void gt_interval_index_delete(GtIntervalIndex *ii)
+{
+  GtUword i;
+  if (!ii) return;
+  if (ii->mapped) {
+    gt_free(ii);
+    return;
+  }
+  if (ii->free_func) {
+    for (i = 0; i < ii->size; i++)
+      ii->free_func(ii->entries[i].data);
+  }
+  gt_free(ii->entries);
+  gt_free(ii);
+}
+
+static int interval_index_count(GT_UNUSED void *data, GT_UNUSED GtUword start,
+                                GT_UNUSED GtUword end, void *info)
+{
+  (*(GtUword*) info)++;
+  return 0;
+}
+
+int gt_interval_index_unit_test(GtError *err)
+{
+  GtIntervalIndex *ii, *mapped;
+  GtArray *res, *mapped_res;
+  GtStr *tmpfilename;
+  FILE *tmpfp;
+  void *mem;
+  size_t memlen, len;
+  GtUword i, j, q, n, count, *starts, *ends,
+          sizes[] = { 0, 1, 2, 7, 8, 9, 100, 1000 },
+          expected[] = { 25, 31, 30, 37, 36, 35, 43, 42, 41, 40,
+                         49, 48, 47, 46, 45 };
+  const GtUword maxpos = 10000, maxlen = 300;
+  int had_err = 0;
+  gt_error_check(err);
+
+  res = gt_array_new(sizeof (void*));
+  mapped_res = gt_array_new(sizeof (void*));
+  for (j = 0; !had_err && j < sizeof (sizes) / sizeof (sizes[0]); j++) {
+    n = sizes[j];
+    starts = gt_malloc(sizeof (*starts) * (n + 1));
+    ends = gt_malloc(sizeof (*ends) * (n + 1));
+    ii = gt_interval_index_new(NULL);
+    /* the data pointers are the indexes of the intervals */
+    for (i = 0; i < n; i++) {
+      starts[i] = gt_rand_max(maxpos);
+      ends[i] = starts[i] + gt_rand_max(gt_rand_max(1) ? maxlen : 10 * maxlen);
+      gt_interval_index_add(ii, (void*) i, starts[i], ends[i]);
+    }
+    gt_ensure(gt_interval_index_size(ii) == n);
+    for (q = 0; !had_err && q < 200UL; q++) {
+      GtUword qstart = gt_rand_max(maxpos + maxlen),
+              qend = qstart + gt_rand_max(q % 2 ? maxlen : 10UL),
+              found = 0, prev = 0;
+      gt_array_reset(res);
+      gt_interval_index_find_all_overlapping(ii, qstart, qend, res);
+      /* compare with a linear scan, the results must be ordered */
+      for (i = 0; !had_err && i < gt_array_size(res); i++) {
+        GtUword k = (GtUword) *(void**) gt_array_get(res, i);
+        gt_ensure(k < n && starts[k] <= qend && qstart <= ends[k]);
+        gt_ensure(i == 0 || starts[prev] < starts[k] ||
+                  (starts[prev] == starts[k] && ends[prev] <= ends[k]));
+        prev = k;
+      }
+      for (i = 0; i < n; i++) {
+        if (starts[i] <= qend && qstart <= ends[i])
+          found++;
+      }
+      gt_ensure(found == gt_array_size(res));
+    }
+    /* the written index must give the same results in place */
+    tmpfilename = gt_str_new();
+    tmpfp = gt_xtmpfp(tmpfilename);
+    gt_interval_index_write(ii, tmpfp);
+    gt_fa_xfclose(tmpfp);
+    mem = gt_fa_mmap_read(gt_str_get(tmpfilename), &memlen, NULL);
+    gt_ensure(mem != NULL);
+    if (!had_err) {
+      gt_ensure(!gt_interval_index_new_mapped(mem, memlen - 1, &len));
+      mapped = gt_interval_index_new_mapped(mem, memlen, &len);
+      gt_ensure(mapped && len == memlen);
+      gt_ensure(gt_interval_index_size(mapped) == n);
+      for (q = 0; !had_err && q < 50UL; q++) {
+        GtUword qstart = gt_rand_max(maxpos + maxlen),
+                qend = qstart + gt_rand_max(maxlen);
+        gt_array_reset(res);
+        gt_array_reset(mapped_res);
+        gt_interval_index_find_all_overlapping(ii, qstart, qend, res);
+        gt_interval_index_find_all_overlapping(mapped, qstart, qend,
+                                               mapped_res);
+        gt_ensure(gt_array_size(res) == gt_array_size(mapped_res));
+        gt_ensure(!gt_array_size(res) ||
+                  !memcmp(gt_array_get_space(res),
+                          gt_array_get_space(mapped_res),
+                          sizeof (void*) * gt_array_size(res)));
+      }
+      gt_interval_index_delete(mapped);
+    }
+    gt_fa_xmunmap(mem);
+    gt_xremove(gt_str_get(tmpfilename));
+    gt_str_delete(tmpfilename);
+    /* remove every other interval */
+    for (i = 0; !had_err && i < n; i += 2)
+      gt_ensure(gt_interval_index_remove(ii, (void*) i));
+    gt_ensure(!gt_interval_index_remove(ii, (void*) (n + 1)));
+    gt_ensure(gt_interval_index_size(ii) == n / 2);
+    gt_array_reset(res);
+    gt_interval_index_find_all_overlapping(ii, 0, maxpos + 10 * maxlen, res);
+    gt_ensure(gt_array_size(res) == n / 2);
+    for (i = 0; !had_err && i < gt_array_size(res); i++)
+      gt_ensure((GtUword) *(void**) gt_array_get(res, i) % 2 == 1);
+    count = 0;
+    gt_ensure(!gt_interval_index_traverse(ii, interval_index_count, &count));
+    gt_ensure(count == n / 2);
+    gt_interval_index_delete(ii);
+    gt_free(starts);
+    gt_free(ends);
+  }
+
+  /* intervals added in sorted order, with equal start positions */
+  ii = gt_interval_index_new(gt_free_func);
+  for (i = 0; i < 50UL; i++) {
+    GtUword *data = gt_malloc(sizeof *data);
+    *data = i;
+    gt_interval_index_add(ii, data, i / 5, i / 5 + 10 - i % 5);
+  }
+  gt_array_reset(res);
+  gt_interval_index_find_all_overlapping(ii, 15, 15, res);
+  gt_ensure(gt_array_size(res) == sizeof (expected) / sizeof (expected[0]));
+  for (i = 0; !had_err && i < gt_array_size(res); i++)
+    gt_ensure(**(GtUword**) gt_array_get(res, i) == expected[i]);
+  gt_interval_index_delete(ii);
+  gt_array_delete(res);
+  gt_array_delete(mapped_res);
+  return had_err;
+}
@@ -0,0 +1,81 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef INTERVAL_INDEX_H
+#define INTERVAL_INDEX_H
+
+#include <stdio.h>
+#include "core/array_api.h"
+#include "core/error_api.h"
+#include "core/fptr_api.h"
+
+/* An implicit interval tree: the intervals are kept in an array sorted by
+   their start positions, which is interpreted as a complete binary search
+   tree augmented by the maximal end position of each subtree. In contrast to
+   the <GtIntervalTree>, no node is allocated individually and a query only
+   touches a few contiguous parts of the array. The index is (re)built on the
+   first query after the intervals were modified. Hence it is meant for
+   interval sets which are filled once and queried many times. */
+typedef struct GtIntervalIndex GtIntervalIndex;
+
+typedef int (*GtIntervalIndexIteratorFunc)(void *data, GtUword start,
+                                           GtUword end, void *info);
+
+/* Creates a new <GtIntervalIndex>. If <free_func> is given, it is applied to
+   the data pointers of the intervals removed from the index or left when the
+   index is deleted. */
+GtIntervalIndex* gt_interval_index_new(GtFree free_func);
+/* Adds the interval from <start> to <end> with the associated <data>. Adding
+   the intervals in the order of their start positions avoids sorting. */
+void             gt_interval_index_add(GtIntervalIndex *ii, void *data,
+                                       GtUword start, GtUword end);
+/* Removes the interval associated with <data>, frees <data> and returns
+   <true>. Returns <false> if no interval is associated with <data>. Takes
+   linear time. */
+bool             gt_interval_index_remove(GtIntervalIndex *ii,
+                                          const void *data);
+/* Returns the number of intervals in <ii>. */
+GtUword          gt_interval_index_size(const GtIntervalIndex *ii);
+/* Appends the data pointers of all intervals which overlap the range from
+   <start> to <end> to <results>, in the order of their start positions.
+   Intervals with the same start position are ordered by their end positions,
+   and by the order in which they were added. */
+void             gt_interval_index_find_all_overlapping(GtIntervalIndex *ii,
+                                                        GtUword start,
+                                                        GtUword end,
+                                                        GtArray *results);
+/* Applies <func> to all intervals of <ii> in the order of
+   <gt_interval_index_find_all_overlapping()>, passing <info> along. Stops and
+   returns the return value of <func> if it is not 0. */
+int              gt_interval_index_traverse(GtIntervalIndex *ii,
+                                            GtIntervalIndexIteratorFunc func,
+                                            void *info);
+/* Writes <ii> to <fp> in a form which can be queried in place with
+   <gt_interval_index_new_mapped()>. The data pointers are written as they
+   are, hence they should encode numbers rather than addresses. */
+void             gt_interval_index_write(GtIntervalIndex *ii, FILE *fp);
+/* Returns a read-only <GtIntervalIndex> on the index written by
+   <gt_interval_index_write()> to the <memlen> bytes at <mem>, which must be
+   word aligned and remain valid during the lifetime of the index. The number
+   of bytes occupied by the index is stored in <len>. Returns NULL if <mem>
+   does not contain a complete index. */
+GtIntervalIndex* gt_interval_index_new_mapped(const void *mem, size_t memlen,
+                                              size_t *len);
+void             gt_interval_index_delete(GtIntervalIndex *ii);
+
+int              gt_interval_index_unit_test(GtError *err);
+
+#endif
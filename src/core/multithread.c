@@ -24,23 +24,29 @@ int gt_multithread(GtThreadFunc function, void *data, GtError *err)
 {
   GtArray *threads;
   GtThread *thread;
+  GtError *thread_err;
   unsigned int i, j;
 
   gt_error_check(err);
   gt_assert(function);
 
   threads = gt_array_new(sizeof (GtThread*));
+  /* the threads which are already running may report their errors in <err> */
+  thread_err = gt_error_new();
 
   /* start all other threads and store them */
   for (i = 1; i < gt_jobs; i++) {
-    if (!(thread = gt_thread_new(function, data, err))) {
+    if (!(thread = gt_thread_new(function, data, thread_err))) {
       for (j = 0; j < gt_array_size(threads); j++)
         gt_thread_delete(*(GtThread**) gt_array_get(threads, j));
       gt_array_delete(threads);
+      gt_error_set(err, "%s", gt_error_get(thread_err));
+      gt_error_delete(thread_err);
       return -1;
     }
     gt_array_add(threads, thread);
   }
+  gt_error_delete(thread_err);
 
   function(data); /* execute function in main thread, too */
 
@@ -132,6 +132,25 @@ static int timeval_add(struct timeval *result,
 }
 #endif
 
+GtWord gt_timer_elapsed_usec(GT_UNUSED GtTimer *t)
+{
+#ifndef _WIN32
+  struct timeval start_tv, stop_tv, elapsed_tv;
+  gt_assert(t);
+  if (t->state == TIMER_RUNNING)
+    gettimeofday(&stop_tv, NULL);
+  else
+    stop_tv = t->stop_tv;
+  start_tv = t->gstart_tv; /* is normalized by timeval_subtract() */
+  timeval_subtract(&elapsed_tv, &stop_tv, &start_tv);
+  return (GtWord) elapsed_tv.tv_sec * 1000000 + (GtWord) elapsed_tv.tv_usec;
+#else
+  /* XXX */
+  fprintf(stderr, "gt_timer_elapsed_usec() not implemented\n");
+  exit(EXIT_FAILURE);
+#endif
+}
+
 void gt_timer_show_formatted(GT_UNUSED GtTimer *t, GT_UNUSED const char *fmt,
                              GT_UNUSED FILE *fp)
 {
@@ -36,6 +36,9 @@ GtTimer* gt_timer_new_with_progress_description(const char* description);
 void     gt_timer_start(GtTimer *timer);
 /* Stop the time measurement on <timer>. */
 void     gt_timer_stop(GtTimer *timer);
+/* Return the microseconds elapsed since the start of <timer>, until it was
+   stopped or (if it is still running) until now. */
+GtWord   gt_timer_elapsed_usec(GtTimer *timer);
 /* Output the current state of <timer> in the format
    ""GT_WD".%06lds real "GT_WD"s user "GT_WD"s system" to file
    pointer <fp> (see <gt_timer_show_formatted>).
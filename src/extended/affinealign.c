@@ -20,6 +20,7 @@
 #include "core/array2dim_api.h"
 #include "core/minmax.h"
 #include "extended/affinealign.h"
+#include "extended/striped_align.h"
 
 typedef enum {
   R,
@@ -179,3 +180,14 @@ GtAlignment* gt_affinealign(const char *u, GtUword ulen,
   gt_array2dim_delete(dptable);
   return a;
 }
+
+GtUword gt_affinealign_cost(const char *u, GtUword ulen,
+                            const char *v, GtUword vlen,
+                            int replacement_cost, int gap_opening_cost,
+                            int gap_extension_cost)
+{
+  gt_assert(u && ulen && v && vlen);
+  return gt_striped_align_global(u, ulen, v, vlen, replacement_cost,
+                                 gap_opening_cost, gap_extension_cost,
+                                 GT_STRIPED_ALIGN_KERNEL_AUTO);
+}
@@ -26,4 +26,11 @@ GtAlignment* gt_affinealign(const char *u, GtUword ulen,
                        const char *v, GtUword vlen, int replacement_cost,
                        int gap_opening_cost, int gap_extension_cost);
 
+/* return the cost of an optimal global alignment of u and v (affine gap
+   costs), without computing the alignment itself */
+GtUword      gt_affinealign_cost(const char *u, GtUword ulen,
+                                 const char *v, GtUword vlen,
+                                 int replacement_cost, int gap_opening_cost,
+                                 int gap_extension_cost);
+
 #endif
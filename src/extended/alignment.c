@@ -264,6 +264,61 @@ GtWord gt_alignment_eval_with_score(const GtAlignment *alignment,
   return sumscore;
 }
 
+GtWord gt_alignment_eval_with_affine_score(const GtAlignment *alignment,
+                                           GtWord matchscore,
+                                           GtWord mismatchscore,
+                                           GtWord gap_opening,
+                                           GtWord gap_extension)
+{
+  GtUword i, j, idx_u = 0, idx_v = 0, meoplen;
+  GtWord sumscore = 0;
+  GtMultieop meop;
+  AlignmentEoptype prevtype = Replacement;
+
+  gt_assert(alignment != NULL);
+#ifndef NDEBUG
+  gt_assert(gt_alignment_is_valid(alignment));
+#endif
+
+  meoplen = gt_multieoplist_get_num_entries(alignment->eops);
+
+  for (i = meoplen; i > 0; i--) {
+    meop = gt_multieoplist_get_entry(alignment->eops, i - 1);
+    switch (meop.type) {
+      case Mismatch:
+      case Match:
+      case Replacement:
+        for (j = 0; j < meop.steps; j++) {
+          if (alignment->u[idx_u] == alignment->v[idx_v] &&
+              ISNOTSPECIAL(alignment->u[idx_u])) {
+            sumscore += matchscore;
+          }
+          else {
+            sumscore += mismatchscore;
+          }
+          idx_u++;
+          idx_v++;
+        }
+        break;
+      /* a gap can be split over several consecutive entries */
+      case Deletion:
+        if (prevtype != Deletion)
+          sumscore += gap_opening;
+        sumscore += gap_extension * meop.steps;
+        idx_u += meop.steps;
+        break;
+      case Insertion:
+        if (prevtype != Insertion)
+          sumscore += gap_opening;
+        sumscore += gap_extension * meop.steps;
+        idx_v += meop.steps;
+        break;
+    }
+    prevtype = meop.type;
+  }
+  return sumscore;
+}
+
 static inline unsigned int gt_alignment_show_advance(unsigned int pos,
                                                      unsigned int width,
                                                      GtUchar *top,
@@ -481,8 +536,11 @@ void gt_alignment_delete(GtAlignment *alignment)
 int gt_alignment_unit_test(GtError *err)
 {
   static char u[] = "acgtagatatatagat",
-              v[] = "agaaagaggtaagaggga";
+              v[] = "agaaagaggtaagaggga",
+              w[] = "agggggggggggggggggggggggggggggggggggggggggggggggggggggg"
+                    "gggggggggggggggggggggggggggggggggggggggggggggggggggc";
   GtAlignment *alignment;
+  GtUword i;
   int had_err = 0;
   gt_error_check(err);
 
@@ -518,6 +576,21 @@ int gt_alignment_unit_test(GtError *err)
   gt_alignment_add_replacement(alignment);
 
   gt_ensure(gt_alignment_eval(alignment) == 10UL);
+  gt_ensure(gt_alignment_eval_with_affine_score(alignment, 0, -1, -2, -1) ==
+            -16L);
+
+  gt_alignment_delete(alignment);
+
+  /* a long gap is a single gap, even if it is split over several entries */
+  alignment = gt_alignment_new_with_seqs((const GtUchar *) u, 2UL,
+                                         (const GtUchar *) w,
+                                         (GtUword) strlen(w));
+  gt_alignment_add_replacement(alignment);
+  for (i = 0; i < (GtUword) strlen(w) - 2; i++)
+    gt_alignment_add_insertion(alignment);
+  gt_alignment_add_replacement(alignment);
+  gt_ensure(gt_alignment_eval_with_affine_score(alignment, 0, -1, -2, -1) ==
+            -(GtWord) strlen(w));
 
   gt_alignment_delete(alignment);
 
@@ -59,6 +59,13 @@ GtWord       gt_alignment_eval_with_score(const GtAlignment *alignment,
                                           GtWord matchscore,
                                           GtWord mismatchscore,
                                           GtWord gapscore);
+/* like <gt_alignment_eval_with_score()>, but a gap of length k scores
+   <gap_opening> + k * <gap_extension> */
+GtWord       gt_alignment_eval_with_affine_score(const GtAlignment *alignment,
+                                                 GtWord matchscore,
+                                                 GtWord mismatchscore,
+                                                 GtWord gap_opening,
+                                                 GtWord gap_extension);
 /* print alignment to <fp>. This will break the lines after width characters */
 void         gt_alignment_show(const GtAlignment *alignment, FILE *fp,
                                unsigned int width);
@@ -27,6 +27,7 @@
 #include "core/log_api.h"
 #include "core/ma.h"
 #include "core/range.h"
+#include "core/str_api.h"
 #include "core/strand_api.h"
 #include "core/thread_api.h"
 #include "core/undef_api.h"
@@ -61,6 +62,11 @@ typedef struct {
   GtAnnoDBGFFlike *annodb;
 } GFFlikeSetupVisitor;
 
+typedef struct {
+  const GtRDBVisitor parent_instance;
+  bool create;
+} GFFlikeIndexVisitor;
+
 typedef struct {
   const GtFeatureIndex parent_instance;
   GtHashmap *node_to_parent_array,
@@ -73,15 +79,23 @@ typedef struct {
             *changed;
   GtHashtable *cache_node2id,
               *cache_id2node;
-  GtRDBStmt *stmts[GT_PSTMT_NOF_STATEMENTS];
+  GtRDBStmt *stmts[GT_PSTMT_NOF_STATEMENTS],
+            *stmt_begin,
+            *stmt_commit;
   GtFeatureNodeObserver *obs;
   GtRDB *db;
   GtMutex *dblock;
-  bool transaction_lock;
+  GtUword batchsize,
+          nof_rows,
+          nof_committed_rows;
+  bool transaction_lock,
+       bulk_load,
+       use_rtree;
 } GtFeatureIndexGFFlike;
 
 const GtAnnoDBSchemaClass* gt_anno_db_gfflike_class(void);
 static const GtRDBVisitorClass* gfflike_setup_visitor_class(void);
+static const GtRDBVisitorClass* gfflike_index_visitor_class(void);
 static const GtFeatureIndexClass* feature_index_gfflike_class(void);
 
 #define anno_db_gfflike_cast(V)\
@@ -90,6 +104,9 @@ static const GtFeatureIndexClass* feature_index_gfflike_class(void);
 #define gfflike_setup_visitor_cast(V)\
         gt_rdb_visitor_cast(gfflike_setup_visitor_class(), V)
 
+#define gfflike_index_visitor_cast(V)\
+        gt_rdb_visitor_cast(gfflike_index_visitor_class(), V)
+
 #define feature_index_gfflike_cast(V)\
         gt_feature_index_cast(feature_index_gfflike_class(), V)
 
@@ -546,6 +563,184 @@ static int anno_db_gfflike_create_indexes_mysql(GtRDBMySQL *db, GtError *err)
   return 0;
 }
 
+/* the secondary indexes and the tables they belong to, they are dropped
+   before a bulk load and recreated afterwards */
+static const char *gfflike_indexes[][2] = {
+  { "feature_all",         "features" },
+  { "name_type",           "types" },
+  { "name_source",         "sources" },
+  { "feature_seqid",       "features" },
+  { "name_sequenceregion", "sequenceregions" },
+  { "attribs_value",       "attributes" },
+  { "attribs_key",         "attributes" },
+  { "attribs_feature",     "attributes" },
+  { "parent_id",           "parents" }
+};
+
+#define GFFLIKE_NOF_INDEXES \
+        (sizeof (gfflike_indexes) / sizeof (gfflike_indexes[0]))
+
+/* the R*Tree over (sequence region, start, end) of all features is kept up to
+   date by triggers, which are dropped during a bulk load as well */
+static const char *gfflike_rtree_drop[] = {
+  "DROP TRIGGER IF EXISTS feature_ranges_insert",
+  "DROP TRIGGER IF EXISTS feature_ranges_delete",
+  "DROP TRIGGER IF EXISTS feature_ranges_update",
+  "DROP TABLE IF EXISTS feature_ranges"
+};
+
+static const char *gfflike_rtree_fill[] = {
+  "INSERT INTO feature_ranges "
+    "SELECT id, seqid, seqid, start, end FROM features",
+  "CREATE TRIGGER feature_ranges_insert AFTER INSERT ON features "
+    "BEGIN INSERT INTO feature_ranges "
+      "VALUES (new.id, new.seqid, new.seqid, new.start, new.end); END",
+  "CREATE TRIGGER feature_ranges_delete AFTER DELETE ON features "
+    "BEGIN DELETE FROM feature_ranges WHERE id = old.id; END",
+  "CREATE TRIGGER feature_ranges_update "
+    "AFTER UPDATE OF seqid, start, end ON features "
+    "BEGIN UPDATE feature_ranges SET minseq = new.seqid, maxseq = new.seqid, "
+      "minpos = new.start, maxpos = new.end WHERE id = new.id; END"
+};
+
+static int anno_db_gfflike_exec(GtRDB *db, const char *query, GtError *err)
+{
+  GtRDBStmt *stmt;
+  int had_err = 0;
+  gt_assert(db && query);
+  if (!(stmt = gt_rdb_prepare(db, query, 0, err)))
+    return -1;
+  if (gt_rdb_stmt_exec(stmt, err) < 0)
+    had_err = -1;
+  gt_rdb_stmt_delete(stmt);
+  return had_err;
+}
+
+static int anno_db_gfflike_drop_indexes_sqlite(GtRDBSqlite *db, GtError *err)
+{
+  GtStr *query;
+  GtUword i;
+  int had_err = 0;
+  gt_assert(db);
+
+  for (i = 0; !had_err && i < sizeof (gfflike_rtree_drop) / sizeof (char*);
+       i++) {
+    had_err = anno_db_gfflike_exec((GtRDB*) db, gfflike_rtree_drop[i], err);
+  }
+  query = gt_str_new();
+  for (i = 0; !had_err && i < GFFLIKE_NOF_INDEXES; i++) {
+    gt_str_reset(query);
+    gt_str_append_cstr(query, "DROP INDEX IF EXISTS ");
+    gt_str_append_cstr(query, gfflike_indexes[i][0]);
+    had_err = anno_db_gfflike_exec((GtRDB*) db, gt_str_get(query), err);
+  }
+  gt_str_delete(query);
+  return had_err;
+}
+
+static int anno_db_gfflike_create_rtree_sqlite(GtRDBSqlite *db, GtError *err)
+{
+  GtError *rtree_err;
+  GtUword i;
+  int had_err = 0;
+  gt_assert(db);
+
+  /* the R*Tree module is optional, without it range queries are answered
+     with the feature_seqid index only */
+  rtree_err = gt_error_new();
+  if (anno_db_gfflike_exec((GtRDB*) db,
+                           "CREATE VIRTUAL TABLE feature_ranges USING "
+                           "rtree(id, minseq, maxseq, minpos, maxpos)",
+                           rtree_err)) {
+    gt_log_log("not using R*Tree for range queries: %s",
+               gt_error_get(rtree_err));
+    gt_error_delete(rtree_err);
+    return 0;
+  }
+  gt_error_delete(rtree_err);
+  for (i = 0; !had_err && i < sizeof (gfflike_rtree_fill) / sizeof (char*);
+       i++) {
+    had_err = anno_db_gfflike_exec((GtRDB*) db, gfflike_rtree_fill[i], err);
+  }
+  return had_err;
+}
+
+static int anno_db_gfflike_drop_indexes_mysql(GtRDBMySQL *db, GtError *err)
+{
+  GtCstrTable *cst;
+  GtStr *query;
+  GtUword i;
+  int had_err = 0;
+  gt_assert(db);
+
+  if (!(cst = gt_rdb_get_indexes((GtRDB*) db, err))) {
+    return -1;
+  }
+  query = gt_str_new();
+  for (i = 0; !had_err && i < GFFLIKE_NOF_INDEXES; i++) {
+    if (!gt_cstr_table_get(cst, gfflike_indexes[i][0]))
+      continue;
+    gt_str_reset(query);
+    gt_str_append_cstr(query, "DROP INDEX ");
+    gt_str_append_cstr(query, gfflike_indexes[i][0]);
+    gt_str_append_cstr(query, " ON ");
+    gt_str_append_cstr(query, gfflike_indexes[i][1]);
+    had_err = anno_db_gfflike_exec((GtRDB*) db, gt_str_get(query), err);
+  }
+  gt_str_delete(query);
+  gt_cstr_table_delete(cst);
+  return had_err;
+}
+
+static int gfflike_index_visitor_sqlite(GtRDBVisitor *rdbv, GtRDBSqlite *db,
+                                        GtError *err)
+{
+  GFFlikeIndexVisitor *iv = gfflike_index_visitor_cast(rdbv);
+  int had_err;
+  if (!iv->create)
+    return anno_db_gfflike_drop_indexes_sqlite(db, err);
+  had_err = anno_db_gfflike_create_indexes_sqlite(db, err);
+  if (!had_err)
+    had_err = anno_db_gfflike_create_rtree_sqlite(db, err);
+  return had_err;
+}
+
+static int gfflike_index_visitor_mysql(GtRDBVisitor *rdbv, GtRDBMySQL *db,
+                                       GtError *err)
+{
+  GFFlikeIndexVisitor *iv = gfflike_index_visitor_cast(rdbv);
+  if (!iv->create)
+    return anno_db_gfflike_drop_indexes_mysql(db, err);
+  return anno_db_gfflike_create_indexes_mysql(db, err);
+}
+
+static const GtRDBVisitorClass* gfflike_index_visitor_class(void)
+{
+  static const GtRDBVisitorClass *ivc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!ivc) {
+    ivc = gt_rdb_visitor_class_new(sizeof (GFFlikeIndexVisitor),
+                                   NULL,
+                                   gfflike_index_visitor_sqlite,
+                                   gfflike_index_visitor_mysql);
+  }
+  gt_class_alloc_lock_leave();
+  return ivc;
+}
+
+/* drops (<create> is false) or creates the secondary indexes of <db> */
+static int anno_db_gfflike_update_indexes(GtRDB *db, bool create,
+                                          GtError *err)
+{
+  GtRDBVisitor *v = gt_rdb_visitor_create(gfflike_index_visitor_class());
+  GFFlikeIndexVisitor *iv = gfflike_index_visitor_cast(v);
+  int had_err;
+  iv->create = create;
+  had_err = gt_rdb_accept(db, v, err);
+  gt_rdb_visitor_delete(v);
+  return had_err;
+}
+
 int anno_db_gfflike_init_sqlite(GT_UNUSED GtRDBVisitor *rdbv, GtRDBSqlite *db,
                                 GtError *err)
 {
@@ -641,6 +836,30 @@ DEFINE_HASHMAP(GtUword, ul, GtFeatureNode*, node, gt_ht_ul_elem_hash,
                gt_ht_ul_elem_cmp, NULL_DESTRUCTOR, NULL_DESTRUCTOR, static,
                inline)
 
+/* during a bulk load, the open transaction is committed and a new one is begun
+   as soon as it contains at least <batchsize> rows */
+static int feature_index_gfflike_batch_commit(GtFeatureIndexGFFlike *fi,
+                                              GtError *err)
+{
+  int had_err = 0;
+  gt_assert(fi);
+  if (!fi->bulk_load || fi->nof_rows - fi->nof_committed_rows < fi->batchsize)
+    return 0;
+  gt_mutex_lock(fi->dblock);
+  gt_rdb_stmt_reset(fi->stmt_commit, err);
+  if (gt_rdb_stmt_exec(fi->stmt_commit, err) < 0)
+    had_err = -1;
+  if (!had_err) {
+    gt_rdb_stmt_reset(fi->stmt_begin, err);
+    if (gt_rdb_stmt_exec(fi->stmt_begin, err) < 0)
+      had_err = -1;
+  }
+  if (!had_err)
+    fi->nof_committed_rows = fi->nof_rows;
+  gt_mutex_unlock(fi->dblock);
+  return had_err;
+}
+
 int gt_feature_index_gfflike_add_region_node(GtFeatureIndex *gfi,
                                              GtRegionNode *rn,
                                              GtError *err)
@@ -662,6 +881,10 @@ int gt_feature_index_gfflike_add_region_node(GtFeatureIndex *gfi,
                        2, (int) rng.end, err);
   had_err = (gt_rdb_stmt_exec(fi->stmts[GT_PSTMT_SEQUENCEREGION_INSERT], err)
                               >= 0 ? 0 : -1);
+  if (!had_err) {
+    fi->nof_rows++;
+    had_err = feature_index_gfflike_batch_commit(fi, err);
+  }
   return had_err;
 }
 
@@ -697,8 +920,10 @@ gt_feature_index_gfflike_insert_helper(GtFeatureIndexGFFlike *fis,
         rval = gt_rdb_stmt_exec(prepstmt_i, err);
         if (rval < 0)
           break;
-        if (rval == 1)
+        if (rval == 1) {
           *id = (int) gt_rdb_last_inserted_id(fis->db, tabname, err);
+          fis->nof_rows++;
+        }
         break;
       default:
         gt_error_set(err, "problem executing prepared statement: %d", rval);
@@ -763,6 +988,8 @@ static int set_parents(void *key, void *value, void *data,
       gt_rdb_stmt_bind_int(fi->stmts[GT_PSTMT_PARENT_INSERT], 1, *parent_id,
                            err);
       rval = gt_rdb_stmt_exec(fi->stmts[GT_PSTMT_PARENT_INSERT], err);
+      if (rval >= 0)
+        fi->nof_rows++;
     }
   }
   return had_err;
@@ -861,6 +1088,7 @@ static int insert_single_node(GtFeatureIndexGFFlike *fi,
                        gt_feature_node_is_marked(fn), err);
   rval = gt_rdb_stmt_exec(fi->stmts[GT_PSTMT_FEATURE_INSERT], err);
   if (rval < 0) gt_error_check(err);
+  else fi->nof_rows++;
 
   *id = gt_rdb_last_inserted_id(fi->db, "features", err);
   /* cache DB keys to avoid redundant saving of nodes with
@@ -882,6 +1110,8 @@ static int insert_single_node(GtFeatureIndexGFFlike *fi,
     rval = gt_rdb_stmt_exec(fi->stmts[GT_PSTMT_ATTRIBUTE_INSERT], err);
     if (rval < 0)
       had_err = -1;
+    else
+      fi->nof_rows++;
   }
   gt_str_array_delete(attribs);
   gt_mutex_unlock(fi->dblock);
@@ -1028,6 +1258,8 @@ int gt_feature_index_gfflike_add_feature_node(GtFeatureIndex *gfi,
                                 err);
   if (!had_err)
     gt_hashmap_add(fi->ref_nodes, gf, (void*) 1);
+  if (!had_err)
+    had_err = feature_index_gfflike_batch_commit(fi, err);
   return had_err;
 }
 
@@ -1478,6 +1710,10 @@ int gt_feature_index_gfflike_get_features_for_range(GtFeatureIndex *gfi,
   gt_rdb_stmt_bind_string(stmt, 0, seqid, err);
   gt_rdb_stmt_bind_ulong(stmt, 1, qry_range->end, err);
   gt_rdb_stmt_bind_ulong(stmt, 2, qry_range->start, err);
+  if (fi->use_rtree) {
+    gt_rdb_stmt_bind_ulong(stmt, 3, qry_range->end, err);
+    gt_rdb_stmt_bind_ulong(stmt, 4, qry_range->start, err);
+  }
   retval = get_nodes_for_stmt(fi, results, stmt, err);
   gt_mutex_unlock(fi->dblock);
   return retval;
@@ -1653,6 +1889,8 @@ void gt_feature_index_gfflike_delete(GtFeatureIndex *gfi)
   for (i=0;i<GT_PSTMT_NOF_STATEMENTS;i++) {
     gt_rdb_stmt_delete(fi->stmts[i]);
   }
+  gt_rdb_stmt_delete(fi->stmt_begin);
+  gt_rdb_stmt_delete(fi->stmt_commit);
   if (fi->db)
     gt_rdb_delete(fi->db);
   gt_hashmap_delete(fi->node_to_parent_array);
@@ -1691,6 +1929,58 @@ const GtFeatureIndexClass* feature_index_gfflike_class(void)
   return fic;
 }
 
+/* prepares the range query, which uses the R*Tree of the feature ranges if
+   the database contains one */
+static int prepstmt_range_select(GtFeatureIndexGFFlike *fis, GtError *err)
+{
+  GtCstrTable *tables;
+  gt_assert(fis);
+  if (!(tables = gt_rdb_get_tables(fis->db, err)))
+    return -1;
+  fis->use_rtree = (gt_cstr_table_get(tables, "feature_ranges") != NULL);
+  gt_cstr_table_delete(tables);
+  gt_rdb_stmt_delete(fis->stmts[GT_PSTMT_GET_RANGE_SELECT]);
+  if (fis->use_rtree) {
+    /* the CROSS JOINs make the R*Tree drive the query */
+    fis->stmts[GT_PSTMT_GET_RANGE_SELECT] = gt_rdb_prepare(fis->db,
+                        "SELECT f.id, s.sequenceregion_name, src.source_name, "
+                        "       t.type_name, f.start, f.end, f.score, "
+                        "       f.strand, f.phase, f.is_multi, "
+                        "       f.multi_representative "
+                        "FROM sequenceregions s "
+                        "     CROSS JOIN feature_ranges r "
+                        "     CROSS JOIN features f, sources src, types t "
+                        "WHERE s.sequenceregion_name = ?  "
+                        "AND r.minseq <= s.sequenceregion_id "
+                        "AND r.maxseq >= s.sequenceregion_id "
+                        "AND (r.minpos <= ? AND r.maxpos >= ?) "
+                        "AND f.id = r.id "
+                        "AND (f.start <= ? AND f.end >= ?) "
+                        "AND src.source_id = f.source "
+                        "AND t.type_id = f.type "
+                        "ORDER BY f.id ASC",
+                         5,
+                         err);
+  } else {
+    fis->stmts[GT_PSTMT_GET_RANGE_SELECT] = gt_rdb_prepare(fis->db,
+                        "SELECT f.id, s.sequenceregion_name, src.source_name, "
+                        "       t.type_name, f.start, f.end, f.score, "
+                        "       f.strand, f.phase, f.is_multi, "
+                        "       f.multi_representative "
+                        "FROM sequenceregions s, features f, "
+                        "     sources src, types t "
+                        "WHERE s.sequenceregion_name = ?  "
+                        "AND s.sequenceregion_id = f.seqid "
+                        "AND (f.start <= ? AND f.end >= ?) "
+                        "AND src.source_id = f.source "
+                        "AND t.type_id = f.type "
+                        "ORDER BY f.id ASC",
+                         3,
+                         err);
+  }
+  return fis->stmts[GT_PSTMT_GET_RANGE_SELECT] ? 0 : -1;
+}
+
 static int prepstmt_init(GtFeatureIndexGFFlike *fis, GtError *err)
 {
   GtRDBStmt *r;
@@ -1770,22 +2060,7 @@ static int prepstmt_init(GtFeatureIndexGFFlike *fis, GtError *err)
                          3,
                          err);
   if (!r) return -1;
-  r = fis->stmts[GT_PSTMT_GET_RANGE_SELECT] = gt_rdb_prepare(fis->db,
-                        "SELECT f.id, s.sequenceregion_name, src.source_name, "
-                        "       t.type_name, f.start, f.end, f.score, "
-                        "       f.strand, f.phase, f.is_multi, "
-                        "       f.multi_representative "
-                        "FROM sequenceregions s, features f, "
-                        "     sources src, types t "
-                        "WHERE s.sequenceregion_name = ?  "
-                        "AND s.sequenceregion_id = f.seqid "
-                        "AND (f.start <= ? AND f.end >= ?) "
-                        "AND src.source_id = f.source "
-                        "AND t.type_id = f.type "
-                        "ORDER BY f.id ASC",
-                         3,
-                         err);
-  if (!r) return -1;
+  if (prepstmt_range_select(fis, err)) return -1;
   r = fis->stmts[GT_PSTMT_GET_ALL] = gt_rdb_prepare(fis->db,
                         "SELECT f.id, s.sequenceregion_name, src.source_name, "
                         "       t.type_name, f.start, f.end, f.score, "
@@ -1923,6 +2198,77 @@ static int prepstmt_init(GtFeatureIndexGFFlike *fis, GtError *err)
   return 0;
 }
 
+int gt_feature_index_gfflike_bulk_load_begin(GtFeatureIndex *gfi,
+                                             GtUword batchsize,
+                                             GtError *err)
+{
+  GtFeatureIndexGFFlike *fi;
+  int had_err = 0;
+  gt_assert(gfi && batchsize > 0);
+  gt_error_check(err);
+  fi = feature_index_gfflike_cast(gfi);
+  gt_assert(!fi->bulk_load);
+
+  gt_mutex_lock(fi->dblock);
+  /* maintaining the indexes row by row is much more expensive than building
+     them once after loading */
+  had_err = anno_db_gfflike_update_indexes(fi->db, false, err);
+  if (!had_err)
+    had_err = prepstmt_range_select(fi, err);
+  if (!had_err && !fi->stmt_begin) {
+    if (!(fi->stmt_begin = gt_rdb_prepare(fi->db, "BEGIN", 0, err)))
+      had_err = -1;
+  }
+  if (!had_err && !fi->stmt_commit) {
+    if (!(fi->stmt_commit = gt_rdb_prepare(fi->db, "COMMIT", 0, err)))
+      had_err = -1;
+  }
+  if (!had_err) {
+    gt_rdb_stmt_reset(fi->stmt_begin, err);
+    if (gt_rdb_stmt_exec(fi->stmt_begin, err) < 0)
+      had_err = -1;
+  }
+  if (!had_err) {
+    fi->bulk_load = true;
+    fi->batchsize = batchsize;
+    fi->nof_committed_rows = fi->nof_rows;
+  }
+  gt_mutex_unlock(fi->dblock);
+  return had_err;
+}
+
+int gt_feature_index_gfflike_bulk_load_end(GtFeatureIndex *gfi, GtError *err)
+{
+  GtFeatureIndexGFFlike *fi;
+  int had_err = 0;
+  gt_assert(gfi);
+  gt_error_check(err);
+  fi = feature_index_gfflike_cast(gfi);
+  gt_assert(fi->bulk_load);
+
+  gt_mutex_lock(fi->dblock);
+  fi->bulk_load = false;
+  gt_rdb_stmt_reset(fi->stmt_commit, err);
+  if (gt_rdb_stmt_exec(fi->stmt_commit, err) < 0)
+    had_err = -1;
+  if (!had_err) {
+    fi->nof_committed_rows = fi->nof_rows;
+    had_err = anno_db_gfflike_update_indexes(fi->db, true, err);
+  }
+  if (!had_err)
+    had_err = prepstmt_range_select(fi, err);
+  gt_mutex_unlock(fi->dblock);
+  return had_err;
+}
+
+GtUword gt_feature_index_gfflike_num_of_rows(const GtFeatureIndex *gfi)
+{
+  GtFeatureIndexGFFlike *fi;
+  gt_assert(gfi);
+  fi = feature_index_gfflike_cast((GtFeatureIndex*) gfi);
+  return fi->nof_rows;
+}
+
 static void delete_ref_node(GtGenomeNode *node)
 {
   if (!node) return;
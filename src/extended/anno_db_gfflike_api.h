@@ -36,6 +36,24 @@ int             gt_feature_index_gfflike_get_all_features(GtFeatureIndex *gfi,
                                                           GtArray *results,
                                                           GtError *err);
 
+/* Puts <gfi> into bulk-load mode: the secondary indexes of the database are
+   dropped and all subsequently added nodes are inserted in transactions of at
+   least <batchsize> rows each. Returns 0 on success, a negative value
+   otherwise. The message in <err> is set accordingly. */
+int             gt_feature_index_gfflike_bulk_load_begin(GtFeatureIndex *gfi,
+                                                         GtUword batchsize,
+                                                         GtError *err);
+
+/* Commits the last transaction of the bulk load started for <gfi> and
+   recreates the secondary indexes, including an R*Tree of the feature ranges
+   if the SQLite backend supports it. Returns 0 on success, a negative value
+   otherwise. The message in <err> is set accordingly. */
+int             gt_feature_index_gfflike_bulk_load_end(GtFeatureIndex *gfi,
+                                                       GtError *err);
+
+/* Returns the number of rows inserted into the database of <gfi>. */
+GtUword         gt_feature_index_gfflike_num_of_rows(const GtFeatureIndex *gfi);
+
 int             gt_anno_db_gfflike_unit_test(GtError *err);
 
 #endif
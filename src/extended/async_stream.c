@@ -0,0 +1,215 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifdef GT_THREADS_ENABLED
+#include <sched.h>
+#include <time.h>
+#endif
+#include "core/atomic.h"
+#include "core/class_alloc_lock.h"
+#include "core/ma_api.h"
+#include "core/thread_api.h"
+#include "extended/async_stream.h"
+#include "extended/genome_node.h"
+#include "extended/node_stream_api.h"
+
+/* the producer thread needs atomic operations, without them the nodes of the
+   input stream are passed on directly */
+#if defined(GT_THREADS_ENABLED) && defined(GT_ATOMIC_AVAILABLE)
+#define GT_ASYNC_STREAM_THREADED
+#endif
+
+#ifdef GT_ASYNC_STREAM_THREADED
+/* the number of times a waiting thread yields before it starts to sleep */
+#define GT_ASYNC_STREAM_SPINS    64U
+/* the time a waiting thread sleeps, in nanoseconds */
+#define GT_ASYNC_STREAM_SLEEPNS  100000L
+
+/* the queue is only accessed by one producer and one consumer, which
+   synchronize through the queue positions with gt_atomic_load() and
+   gt_atomic_store(), without any locks */
+
+typedef enum {
+  GT_ASYNC_STREAM_RUNNING,
+  GT_ASYNC_STREAM_FINISHED,
+  GT_ASYNC_STREAM_FAILED
+} GtAsyncStreamStatus;
+#endif
+
+struct GtAsyncStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+  GtUword queue_size;
+#ifdef GT_ASYNC_STREAM_THREADED
+  GtGenomeNode **queue;
+  GtUword head,          /* number of nodes taken from the queue */
+          tail;          /* number of nodes put into the queue */
+  int status;            /* the <GtAsyncStreamStatus> of the producer */
+  int stop;              /* tells the producer to stop (if not 0) */
+  GtThread *producer;    /* NULL until the first node is requested */
+  GtError *producer_err;
+#endif
+};
+
+#define async_stream_cast(NS)\
+        gt_node_stream_cast(gt_async_stream_class(), NS)
+
+#ifdef GT_ASYNC_STREAM_THREADED
+static void async_stream_wait(unsigned int *rounds)
+{
+  if (*rounds < GT_ASYNC_STREAM_SPINS) {
+    (*rounds)++;
+    (void) sched_yield();
+  }
+  else {
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = GT_ASYNC_STREAM_SLEEPNS;
+    (void) nanosleep(&ts, NULL);
+  }
+}
+
+static void* async_stream_producer(void *data)
+{
+  GtAsyncStream *as = (GtAsyncStream*) data;
+  GtGenomeNode *gn;
+  unsigned int rounds;
+  gt_assert(as);
+
+  while (!gt_atomic_load(&as->stop)) {
+    if (gt_node_stream_next(as->in_stream, &gn, as->producer_err) != 0) {
+      gt_atomic_store(&as->status, GT_ASYNC_STREAM_FAILED);
+      break;
+    }
+    if (!gn) {
+      gt_atomic_store(&as->status, GT_ASYNC_STREAM_FINISHED);
+      break;
+    }
+    /* a node handed over to the consumer must not share a string with the
+       nodes kept by the producer (e.g., the sequence IDs cached by the GFF3
+       parser) */
+    gt_genome_node_unshare_strings(gn);
+    /* wait for a free slot, only the producer modifies <tail> */
+    rounds = 0;
+    while (as->tail - gt_atomic_load(&as->head) == as->queue_size) {
+      if (gt_atomic_load(&as->stop)) {
+        gt_genome_node_delete(gn);
+        return NULL;
+      }
+      async_stream_wait(&rounds);
+    }
+    as->queue[as->tail % as->queue_size] = gn;
+    gt_atomic_store(&as->tail, as->tail + 1);
+  }
+  return NULL;
+}
+
+static int async_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                             GtError *err)
+{
+  GtAsyncStream *as;
+  unsigned int rounds = 0;
+  gt_error_check(err);
+  as = async_stream_cast(ns);
+
+  if (!as->producer &&
+      !(as->producer = gt_thread_new(async_stream_producer, as, err))) {
+    return -1;
+  }
+  while (true) {
+    int status;
+    /* only the consumer modifies <head> */
+    if (as->head != gt_atomic_load(&as->tail)) {
+      *gn = as->queue[as->head % as->queue_size];
+      gt_atomic_store(&as->head, as->head + 1);
+      return 0;
+    }
+    status = gt_atomic_load(&as->status);
+    if (status != GT_ASYNC_STREAM_RUNNING) {
+      /* the producer may have added nodes before it finished */
+      if (as->head != gt_atomic_load(&as->tail))
+        continue;
+      *gn = NULL;
+      if (status == GT_ASYNC_STREAM_FAILED) {
+        gt_error_set(err, "%s", gt_error_get(as->producer_err));
+        return -1;
+      }
+      return 0;
+    }
+    async_stream_wait(&rounds);
+  }
+}
+#else
+static int async_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                             GtError *err)
+{
+  GtAsyncStream *as;
+  gt_error_check(err);
+  as = async_stream_cast(ns);
+  return gt_node_stream_next(as->in_stream, gn, err);
+}
+#endif
+
+static void async_stream_free(GtNodeStream *ns)
+{
+  GtAsyncStream *as = async_stream_cast(ns);
+#ifdef GT_ASYNC_STREAM_THREADED
+  if (as->producer) {
+    gt_atomic_store(&as->stop, 1);
+    gt_thread_join(as->producer);
+    gt_thread_delete(as->producer);
+  }
+  for (; as->head < as->tail; as->head++)
+    gt_genome_node_delete(as->queue[as->head % as->queue_size]);
+  gt_free(as->queue);
+  gt_error_delete(as->producer_err);
+#endif
+  gt_node_stream_delete(as->in_stream);
+}
+
+const GtNodeStreamClass* gt_async_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtAsyncStream),
+                                   async_stream_free,
+                                   async_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_async_stream_new(GtNodeStream *in_stream, GtUword queue_size)
+{
+  GtAsyncStream *as;
+  GtNodeStream *ns;
+  gt_assert(in_stream && queue_size > 0);
+  ns = gt_node_stream_create(gt_async_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  as = async_stream_cast(ns);
+  as->in_stream = gt_node_stream_ref(in_stream);
+  as->queue_size = queue_size;
+#ifdef GT_ASYNC_STREAM_THREADED
+  as->queue = gt_malloc(sizeof (*as->queue) * queue_size);
+  as->head = as->tail = 0;
+  as->status = GT_ASYNC_STREAM_RUNNING;
+  as->stop = 0;
+  as->producer = NULL;
+  as->producer_err = gt_error_new();
+#endif
+  return ns;
+}
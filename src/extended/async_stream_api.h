@@ -0,0 +1,39 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ASYNC_STREAM_API_H
+#define ASYNC_STREAM_API_H
+
+#include "extended/node_stream_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtAsyncStream> marks a stage
+   boundary in a stream pipeline: The part of the pipeline upstream of it is
+   run in a separate thread, which hands the retrieved <GtGenomeNode> objects
+   over through a bounded queue. Thus, for example, the parsing of the input,
+   its processing and the output can be run concurrently.
+   The upstream streams must not share any modifiable state with the streams
+   downstream (in particular, they must not call back into a scripting
+   language interpreter used downstream). If <GenomeTools> was compiled
+   without thread support, the nodes are passed through unchanged. */
+typedef struct GtAsyncStream GtAsyncStream;
+
+/* Create a <GtAsyncStream*> which retrieves the nodes from <in_stream> in a
+   separate thread and returns them in the same order. At most <queue_size>
+   nodes (which must be positive) are retrieved in advance. */
+GtNodeStream* gt_async_stream_new(GtNodeStream *in_stream,
+                                  GtUword queue_size);
+
+#endif
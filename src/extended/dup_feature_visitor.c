@@ -98,7 +98,7 @@ static int dup_feature_visitor_feature_node(GtNodeVisitor *nv,
 
 const GtNodeVisitorClass* gt_dup_feature_visitor_class()
 {
-  static const GtNodeVisitorClass *nvc = NULL;
+  static GtNodeVisitorClass *nvc = NULL;
   gt_class_alloc_lock_enter();
   if (!nvc) {
     nvc = gt_node_visitor_class_new(sizeof (GtDupFeatureVisitor),
@@ -108,6 +108,8 @@ const GtNodeVisitorClass* gt_dup_feature_visitor_class()
                                     NULL,
                                     NULL,
                                     NULL);
+    /* only the visited feature tree is modified */
+    gt_node_visitor_class_set_thread_safe(nvc);
   }
   gt_class_alloc_lock_leave();
   return nvc;
@@ -0,0 +1,1144 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/hashmap.h"
+#include "core/interval_index.h"
+#include "core/ma.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "extended/feature_index_binary.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_index_rep.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/genome_node.h"
+
+#define FEATURE_INDEX_BINARY_MAGIC    ((GtUword) 0x47464958UL) /* "GFIX" */
+#define FEATURE_INDEX_BINARY_VERSION  ((GtUword) 1)
+
+/* the index file consists of the header, the tables of sequence regions,
+   nodes, child links, and attributes, one serialized <GtIntervalIndex> of the
+   top-level nodes per sequence region, and the string pool. All parts are
+   written in the native byte order and word size. */
+typedef enum {
+  BINARY_HEADER_MAGIC,
+  BINARY_HEADER_VERSION,
+  BINARY_HEADER_WORDSIZE,
+  BINARY_HEADER_NUMOFSEQIDS,
+  BINARY_HEADER_FIRSTSEQID,
+  BINARY_HEADER_NUMOFNODES,
+  BINARY_HEADER_NUMOFLINKS,
+  BINARY_HEADER_NUMOFATTRIBUTES,
+  BINARY_HEADER_STRINGPOOLSIZE,
+  BINARY_HEADERSIZE
+} FeatureIndexBinaryHeader;
+
+typedef struct {
+  GtUword name,          /* offset in the string pool */
+          range_start,   /* the range of all features of the region */
+          range_end,
+          region_start,  /* GT_UNDEF_UWORD if there was no region node */
+          region_end;
+} FeatureIndexBinarySeqid;
+
+#define BINARY_NODE_STRANDMASK  7U
+#define BINARY_NODE_PHASESHIFT  3
+#define BINARY_NODE_PHASEMASK   3U
+#define BINARY_NODE_PSEUDO      (1U << 5)
+#define BINARY_NODE_MULTI       (1U << 6)
+#define BINARY_NODE_SCORE       (1U << 7)
+
+/* the nodes of a feature graph are stored consecutively, beginning with the
+   top-level node */
+typedef struct {
+  GtUword start,
+          end,
+          type,             /* offset in the string pool */
+          source,           /* offset in the string pool or GT_UNDEF_UWORD */
+          firstchild,       /* index in the table of child links */
+          numofchildren,
+          firstattribute,   /* index in the table of attributes */
+          numofattributes,
+          multirep,         /* node index of the multi-feature representative */
+          graphsize;        /* number of nodes, only set for top-level nodes */
+  float score;
+  unsigned int flags;
+} FeatureIndexBinaryNode;
+
+struct GtFeatureIndexBinary {
+  const GtFeatureIndex parent_instance;
+  GtUword *data,                          /* the mapped index file */
+          numofseqids,
+          firstseqid;
+  const FeatureIndexBinarySeqid *seqids;
+  const FeatureIndexBinaryNode *nodes;
+  const GtUword *links,
+                *attributes;              /* pairs of string offsets */
+  const char *strings;
+  GtIntervalIndex **trees;                /* top-level nodes per region */
+  GtStr **seqid_strs;                     /* created on demand */
+  GtHashmap *seqid_map,                   /* name -> region number + 1 */
+            *sources,                     /* string -> <GtStr> */
+            *graphs;                      /* top-level node -> feature node */
+  GtMutex *lock;                          /* protects the created nodes */
+};
+
+#define gt_feature_index_binary_cast(FI)\
+        gt_feature_index_cast(gt_feature_index_binary_class(), FI)
+
+static int feature_index_binary_read_only(GtError *err)
+{
+  gt_error_set(err, "binary feature index is read-only");
+  return -1;
+}
+
+static int feature_index_binary_add_region_node(GT_UNUSED GtFeatureIndex *gfi,
+                                                GT_UNUSED GtRegionNode *rn,
+                                                GtError *err)
+{
+  return feature_index_binary_read_only(err);
+}
+
+static int feature_index_binary_add_feature_node(GT_UNUSED GtFeatureIndex *gfi,
+                                                 GT_UNUSED GtFeatureNode *fn,
+                                                 GtError *err)
+{
+  return feature_index_binary_read_only(err);
+}
+
+static int feature_index_binary_remove_node(GT_UNUSED GtFeatureIndex *gfi,
+                                            GT_UNUSED GtFeatureNode *fn,
+                                            GtError *err)
+{
+  return feature_index_binary_read_only(err);
+}
+
+/* returns the number of the region <seqid> plus one, 0 if it does not exist */
+static GtUword feature_index_binary_seqid_num(const GtFeatureIndexBinary *fib,
+                                              const char *seqid)
+{
+  return (GtUword) gt_hashmap_get(fib->seqid_map, seqid);
+}
+
+static GtStr* feature_index_binary_source(GtFeatureIndexBinary *fib,
+                                          GtUword offset)
+{
+  GtStr *source;
+  const char *str = fib->strings + offset;
+  if (!(source = gt_hashmap_get(fib->sources, str))) {
+    source = gt_str_new_cstr(str);
+    gt_hashmap_add(fib->sources, (void*) str, source);
+  }
+  return source;
+}
+
+static GtFeatureNode* feature_index_binary_node_new(GtFeatureIndexBinary *fib,
+                                                    GtStr *seqid,
+                                                    const
+                                                    FeatureIndexBinaryNode *rec)
+{
+  GtGenomeNode *gn;
+  GtFeatureNode *fn;
+  GtStrand strand = (GtStrand) (rec->flags & BINARY_NODE_STRANDMASK);
+  GtUword i;
+
+  if (rec->flags & BINARY_NODE_PSEUDO)
+    gn = gt_feature_node_new_pseudo(seqid, rec->start, rec->end, strand);
+  else {
+    gn = gt_feature_node_new(seqid, fib->strings + rec->type, rec->start,
+                             rec->end, strand);
+  }
+  fn = gt_feature_node_cast(gn);
+  if (rec->source != GT_UNDEF_UWORD)
+    gt_feature_node_set_source(fn, feature_index_binary_source(fib,
+                                                               rec->source));
+  if (rec->flags & BINARY_NODE_SCORE)
+    gt_feature_node_set_score(fn, rec->score);
+  gt_feature_node_set_phase(fn, (GtPhase) ((rec->flags >>
+                                            BINARY_NODE_PHASESHIFT) &
+                                           BINARY_NODE_PHASEMASK));
+  for (i = 0; i < rec->numofattributes; i++) {
+    const GtUword *attr = fib->attributes + 2 * (rec->firstattribute + i);
+    gt_feature_node_set_attribute(fn, fib->strings + attr[0],
+                                  fib->strings + attr[1]);
+  }
+  return fn;
+}
+
+/* returns the feature graph with the top-level node <root> in the region with
+   number <seqnum>, the graph is created on the first call */
+static GtFeatureNode* feature_index_binary_graph(GtFeatureIndexBinary *fib,
+                                                 GtUword seqnum, GtUword root)
+{
+  const FeatureIndexBinaryNode *rec = fib->nodes + root;
+  GtFeatureNode *fn, **graph;
+  GtUword i, j, size;
+  bool *is_child;
+
+  if ((fn = gt_hashmap_get(fib->graphs, rec)))
+    return fn;
+  if (!fib->seqid_strs[seqnum]) {
+    fib->seqid_strs[seqnum] =
+      gt_str_new_cstr(fib->strings + fib->seqids[seqnum].name);
+  }
+  size = rec->graphsize;
+  graph = gt_malloc(sizeof (*graph) * size);
+  is_child = gt_calloc(size, sizeof (*is_child));
+  for (i = 0; i < size; i++) {
+    graph[i] = feature_index_binary_node_new(fib, fib->seqid_strs[seqnum],
+                                             rec + i);
+  }
+  /* the representatives have to be multi-features before they are assigned */
+  for (i = 0; i < size; i++) {
+    if ((rec[i].flags & BINARY_NODE_MULTI) && rec[i].multirep == root + i)
+      gt_feature_node_make_multi_representative(graph[i]);
+  }
+  for (i = 0; i < size; i++) {
+    if ((rec[i].flags & BINARY_NODE_MULTI) && rec[i].multirep != root + i) {
+      gt_assert(rec[i].multirep >= root && rec[i].multirep < root + size);
+      gt_feature_node_set_multi_representative(graph[i],
+                                               graph[rec[i].multirep - root]);
+    }
+  }
+  for (i = 0; i < size; i++) {
+    for (j = 0; j < rec[i].numofchildren; j++) {
+      GtUword child = fib->links[rec[i].firstchild + j] - root;
+      gt_assert(child > 0 && child < size);
+      /* a child with several parents is referenced by each of them */
+      if (is_child[child])
+        gt_genome_node_ref((GtGenomeNode*) graph[child]);
+      gt_feature_node_add_child(graph[i], graph[child]);
+      is_child[child] = true;
+    }
+  }
+  fn = graph[0];
+  gt_hashmap_add(fib->graphs, (void*) rec, fn);
+  gt_free(is_child);
+  gt_free(graph);
+  return fn;
+}
+
+static int collect_roots(void *data, GT_UNUSED GtUword start,
+                         GT_UNUSED GtUword end, void *info)
+{
+  gt_array_add((GtArray*) info, data);
+  return 0;
+}
+
+static void feature_index_binary_add_graphs(GtFeatureIndexBinary *fib,
+                                            GtArray *results, GtUword seqnum,
+                                            GtArray *roots)
+{
+  GtUword i;
+  GtFeatureNode *fn;
+  gt_mutex_lock(fib->lock);
+  for (i = 0; i < gt_array_size(roots); i++) {
+    fn = feature_index_binary_graph(fib, seqnum,
+                                    *(GtUword*) gt_array_get(roots, i));
+    gt_array_add(results, fn);
+  }
+  gt_mutex_unlock(fib->lock);
+}
+
+static GtArray* feature_index_binary_get_features_for_seqid(GtFeatureIndex
+                                                            *gfi,
+                                                            const char *seqid,
+                                                            GT_UNUSED GtError
+                                                            *err)
+{
+  GtFeatureIndexBinary *fib;
+  GtArray *a, *roots;
+  GtUword seqnum;
+  gt_assert(gfi && seqid);
+  fib = gt_feature_index_binary_cast(gfi);
+  a = gt_array_new(sizeof (GtFeatureNode*));
+  if ((seqnum = feature_index_binary_seqid_num(fib, seqid))) {
+    roots = gt_array_new(sizeof (GtUword));
+    (void) gt_interval_index_traverse(fib->trees[seqnum - 1], collect_roots,
+                                      roots);
+    feature_index_binary_add_graphs(fib, a, seqnum - 1, roots);
+    gt_array_delete(roots);
+  }
+  return a;
+}
+
+static int gt_genome_node_cmp_range_start(const void *v1, const void *v2)
+{
+  GtGenomeNode *n1, *n2;
+  n1 = *(GtGenomeNode**) v1;
+  n2 = *(GtGenomeNode**) v2;
+  return gt_genome_node_compare(&n1, &n2);
+}
+
+static int feature_index_binary_get_features_for_range(GtFeatureIndex *gfi,
+                                                       GtArray *results,
+                                                       const char *seqid,
+                                                       const GtRange *qry_range,
+                                                       GtError *err)
+{
+  GtFeatureIndexBinary *fib;
+  GtArray *roots;
+  GtUword seqnum;
+  gt_error_check(err);
+  gt_assert(gfi && results && seqid && qry_range);
+
+  fib = gt_feature_index_binary_cast(gfi);
+  if (!(seqnum = feature_index_binary_seqid_num(fib, seqid))) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  roots = gt_array_new(sizeof (GtUword));
+  gt_interval_index_find_all_overlapping(fib->trees[seqnum - 1],
+                                         qry_range->start, qry_range->end,
+                                         roots);
+  feature_index_binary_add_graphs(fib, results, seqnum - 1, roots);
+  gt_array_delete(roots);
+  gt_array_sort(results, gt_genome_node_cmp_range_start);
+  return 0;
+}
+
+static char* feature_index_binary_get_first_seqid(const GtFeatureIndex *gfi,
+                                                  GT_UNUSED GtError *err)
+{
+  GtFeatureIndexBinary *fib;
+  gt_assert(gfi);
+  fib = gt_feature_index_binary_cast((GtFeatureIndex*) gfi);
+  if (fib->firstseqid == GT_UNDEF_UWORD)
+    return NULL;
+  return gt_cstr_dup(fib->strings + fib->seqids[fib->firstseqid].name);
+}
+
+static GtStrArray* feature_index_binary_get_seqids(const GtFeatureIndex *gfi,
+                                                   GT_UNUSED GtError *err)
+{
+  GtFeatureIndexBinary *fib;
+  GtStrArray *seqids;
+  GtUword i;
+  gt_assert(gfi);
+  fib = gt_feature_index_binary_cast((GtFeatureIndex*) gfi);
+  seqids = gt_str_array_new();
+  for (i = 0; i < fib->numofseqids; i++)
+    gt_str_array_add_cstr(seqids, fib->strings + fib->seqids[i].name);
+  return seqids;
+}
+
+static int feature_index_binary_get_range_for_seqid(GtFeatureIndex *gfi,
+                                                    GtRange *range,
+                                                    const char *seqid,
+                                                    GtError *err)
+{
+  GtFeatureIndexBinary *fib;
+  GtUword seqnum;
+  gt_error_check(err);
+  gt_assert(gfi && range && seqid);
+  fib = gt_feature_index_binary_cast(gfi);
+  seqnum = feature_index_binary_seqid_num(fib, seqid);
+  if (!seqnum) {
+    gt_error_set(err, "sequence region '%s' does not exist", seqid);
+    return -1;
+  }
+  range->start = fib->seqids[seqnum - 1].range_start;
+  range->end = fib->seqids[seqnum - 1].range_end;
+  return 0;
+}
+
+static int feature_index_binary_get_orig_range_for_seqid(GtFeatureIndex *gfi,
+                                                         GtRange *range,
+                                                         const char *seqid,
+                                                         GtError *err)
+{
+  GtFeatureIndexBinary *fib;
+  GtUword seqnum;
+  gt_error_check(err);
+  gt_assert(gfi && range && seqid);
+  fib = gt_feature_index_binary_cast(gfi);
+  seqnum = feature_index_binary_seqid_num(fib, seqid);
+  if (!seqnum) {
+    gt_error_set(err, "sequence region '%s' does not exist", seqid);
+    return -1;
+  }
+  if (fib->seqids[seqnum - 1].region_start != GT_UNDEF_UWORD) {
+    range->start = fib->seqids[seqnum - 1].region_start;
+    range->end = fib->seqids[seqnum - 1].region_end;
+  }
+  return 0;
+}
+
+static int feature_index_binary_has_seqid(const GtFeatureIndex *gfi,
+                                          bool *has_seqid,
+                                          const char *seqid,
+                                          GT_UNUSED GtError *err)
+{
+  GtFeatureIndexBinary *fib;
+  gt_assert(gfi && has_seqid && seqid);
+  fib = gt_feature_index_binary_cast((GtFeatureIndex*) gfi);
+  *has_seqid = (feature_index_binary_seqid_num(fib, seqid) != 0);
+  return 0;
+}
+
+static void feature_index_binary_delete(GtFeatureIndex *gfi)
+{
+  GtFeatureIndexBinary *fib;
+  GtUword i;
+  if (!gfi) return;
+  fib = gt_feature_index_binary_cast(gfi);
+  gt_hashmap_delete(fib->graphs);
+  gt_hashmap_delete(fib->sources);
+  gt_hashmap_delete(fib->seqid_map);
+  for (i = 0; i < fib->numofseqids; i++) {
+    gt_interval_index_delete(fib->trees[i]);
+    gt_str_delete(fib->seqid_strs[i]);
+  }
+  gt_free(fib->trees);
+  gt_free(fib->seqid_strs);
+  gt_mutex_delete(fib->lock);
+  gt_fa_xmunmap(fib->data);
+}
+
+const GtFeatureIndexClass* gt_feature_index_binary_class(void)
+{
+  static const GtFeatureIndexClass *fic = NULL;
+  gt_class_alloc_lock_enter();
+  if (!fic) {
+    fic = gt_feature_index_class_new(sizeof (GtFeatureIndexBinary),
+                                 feature_index_binary_add_region_node,
+                                 feature_index_binary_add_feature_node,
+                                 feature_index_binary_remove_node,
+                                 feature_index_binary_get_features_for_seqid,
+                                 feature_index_binary_get_features_for_range,
+                                 feature_index_binary_get_first_seqid,
+                                 NULL,
+                                 feature_index_binary_get_seqids,
+                                 feature_index_binary_get_range_for_seqid,
+                                 feature_index_binary_get_orig_range_for_seqid,
+                                 feature_index_binary_has_seqid,
+                                 feature_index_binary_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return fic;
+}
+
+/* returns true if <offset> refers to a non-empty string in the string pool of
+   <stringpoolsize> bytes, which is known to end with '\0' */
+static bool feature_index_binary_string_valid(const char *strings,
+                                              GtUword stringpoolsize,
+                                              GtUword offset)
+{
+  return offset < stringpoolsize && strings[offset] != '\0';
+}
+
+/* returns true if the node records are consistent, that is, all offsets and
+   links lie within their tables, and the nodes of every feature graph form a
+   DAG in which all nodes are reachable from the top-level node */
+static bool feature_index_binary_nodes_valid(const FeatureIndexBinaryNode
+                                             *nodes,
+                                             GtUword numofnodes,
+                                             const GtUword *links,
+                                             GtUword numoflinks,
+                                             const GtUword *attributes,
+                                             GtUword numofattributes,
+                                             const char *strings,
+                                             GtUword stringpoolsize)
+{
+  GtUword root, i, j, size = 0, allocated = 0, stacksize, visited,
+          *indegree = NULL, *stack = NULL;
+  bool valid = true;
+
+  for (root = 0; valid && root < numofnodes; root += size) {
+    size = nodes[root].graphsize;
+    if (size == 0 || size > numofnodes - root) {
+      valid = false;
+      break;
+    }
+    if (size > allocated) {
+      allocated = size;
+      indegree = gt_realloc(indegree, sizeof (*indegree) * allocated);
+      stack = gt_realloc(stack, sizeof (*stack) * allocated);
+    }
+    memset(indegree, 0, sizeof (*indegree) * size);
+    for (i = root; valid && i < root + size; i++) {
+      const FeatureIndexBinaryNode *rec = nodes + i;
+      if (rec->start > rec->end ||
+          (rec->flags & BINARY_NODE_STRANDMASK) >=
+            (unsigned int) GT_NUM_OF_STRAND_TYPES ||
+          (!(rec->flags & BINARY_NODE_PSEUDO) &&
+           !feature_index_binary_string_valid(strings, stringpoolsize,
+                                              rec->type)) ||
+          (rec->source != GT_UNDEF_UWORD &&
+           !feature_index_binary_string_valid(strings, stringpoolsize,
+                                              rec->source)) ||
+          (i > root && rec->graphsize != 0) ||
+          rec->firstchild > numoflinks ||
+          rec->numofchildren > numoflinks - rec->firstchild ||
+          rec->firstattribute > numofattributes ||
+          rec->numofattributes > numofattributes - rec->firstattribute) {
+        valid = false;
+      }
+      /* the representative of a multi-feature represents itself */
+      if (valid && (rec->flags & BINARY_NODE_MULTI) &&
+          (rec->multirep < root || rec->multirep >= root + size ||
+           !(nodes[rec->multirep].flags & BINARY_NODE_MULTI) ||
+           nodes[rec->multirep].multirep != rec->multirep)) {
+        valid = false;
+      }
+      for (j = 0; valid && j < rec->numofattributes; j++) {
+        const GtUword *attr = attributes + 2 * (rec->firstattribute + j);
+        if (!feature_index_binary_string_valid(strings, stringpoolsize,
+                                               attr[0]) ||
+            !feature_index_binary_string_valid(strings, stringpoolsize,
+                                               attr[1])) {
+          valid = false;
+        }
+      }
+      for (j = 0; valid && j < rec->numofchildren; j++) {
+        GtUword child = links[rec->firstchild + j];
+        if (child <= root || child - root >= size)
+          valid = false;
+        else
+          indegree[child - root]++;
+      }
+    }
+    /* remove the nodes without parents one by one, beginning with the
+       top-level node, only a DAG is removed completely */
+    stack[0] = 0;
+    stacksize = 1;
+    visited = 0;
+    while (valid && stacksize > 0) {
+      const FeatureIndexBinaryNode *rec = nodes + root + stack[--stacksize];
+      visited++;
+      for (j = 0; j < rec->numofchildren; j++) {
+        GtUword child = links[rec->firstchild + j] - root;
+        if (--indegree[child] == 0)
+          stack[stacksize++] = child;
+      }
+    }
+    if (valid && visited != size)
+      valid = false;
+  }
+  gt_free(indegree);
+  gt_free(stack);
+  return valid;
+}
+
+typedef struct {
+  const FeatureIndexBinaryNode *nodes;
+  GtUword numofnodes;
+} FeatureIndexBinaryRootCheck;
+
+static int feature_index_binary_check_root(void *data,
+                                           GT_UNUSED GtUword start,
+                                           GT_UNUSED GtUword end, void *info)
+{
+  FeatureIndexBinaryRootCheck *rc = info;
+  GtUword root = (GtUword) data;
+  if (root >= rc->numofnodes || rc->nodes[root].graphsize == 0)
+    return -1;
+  return 0;
+}
+
+GtFeatureIndex* gt_feature_index_binary_new(const char *filename,
+                                            GtError *err)
+{
+  GtFeatureIndex *fi;
+  GtFeatureIndexBinary *fib;
+  GtIntervalIndex **trees;
+  GtUword *data, i, numofseqids, numofnodes, numoflinks, numofattributes,
+          stringpoolsize;
+  size_t len, offset, iilen;
+  bool valid = true;
+  gt_error_check(err);
+  gt_assert(filename);
+
+  if (!(data = gt_fa_mmap_read(filename, &len, err)))
+    return NULL;
+  if (len < sizeof (GtUword) * BINARY_HEADERSIZE ||
+      data[BINARY_HEADER_MAGIC] != FEATURE_INDEX_BINARY_MAGIC ||
+      data[BINARY_HEADER_VERSION] != FEATURE_INDEX_BINARY_VERSION ||
+      data[BINARY_HEADER_WORDSIZE] != (GtUword) sizeof (GtUword)) {
+    gt_error_set(err, "file \"%s\" is not a binary feature index (of this "
+                 "version and platform)", filename);
+    gt_fa_xmunmap(data);
+    return NULL;
+  }
+  numofseqids = data[BINARY_HEADER_NUMOFSEQIDS];
+  numofnodes = data[BINARY_HEADER_NUMOFNODES];
+  numoflinks = data[BINARY_HEADER_NUMOFLINKS];
+  numofattributes = data[BINARY_HEADER_NUMOFATTRIBUTES];
+  stringpoolsize = data[BINARY_HEADER_STRINGPOOLSIZE];
+
+  /* check that the tables fit into the file before they are used */
+  offset = sizeof (GtUword) * BINARY_HEADERSIZE;
+  if ((len - offset) / sizeof (FeatureIndexBinarySeqid) < numofseqids)
+    valid = false;
+  else {
+    offset += sizeof (FeatureIndexBinarySeqid) * numofseqids;
+    if ((len - offset) / sizeof (FeatureIndexBinaryNode) < numofnodes)
+      valid = false;
+    else {
+      offset += sizeof (FeatureIndexBinaryNode) * numofnodes;
+      if (numofattributes > GT_UWORD_MAX / 2 ||
+          (len - offset) / sizeof (GtUword) < numoflinks ||
+          (len - offset) / sizeof (GtUword) - numoflinks <
+            2 * numofattributes) {
+        valid = false;
+      }
+      else
+        offset += sizeof (GtUword) * (numoflinks + 2 * numofattributes);
+    }
+  }
+  trees = gt_calloc(numofseqids ? numofseqids : 1, sizeof (*trees));
+  for (i = 0; valid && i < numofseqids; i++) {
+    if (!(trees[i] = gt_interval_index_new_mapped((char*) data + offset,
+                                                  len - offset, &iilen))) {
+      valid = false;
+    }
+    else
+      offset += iilen;
+  }
+  if (valid && (len - offset != stringpoolsize ||
+                (stringpoolsize > 0 &&
+                 ((char*) data)[len - 1] != '\0'))) {
+    valid = false;
+  }
+
+  /* check the contents of the tables, which are referenced without further
+     checks by the queries */
+  if (valid) {
+    const FeatureIndexBinarySeqid *seqids =
+      (const FeatureIndexBinarySeqid*) (data + BINARY_HEADERSIZE);
+    FeatureIndexBinaryRootCheck rc;
+    const GtUword *links;
+    const char *strings = (const char*) data + len - stringpoolsize;
+    rc.nodes = (const FeatureIndexBinaryNode*) (seqids + numofseqids);
+    rc.numofnodes = numofnodes;
+    links = (const GtUword*) (rc.nodes + numofnodes);
+    if (data[BINARY_HEADER_FIRSTSEQID] != GT_UNDEF_UWORD &&
+        data[BINARY_HEADER_FIRSTSEQID] >= numofseqids) {
+      valid = false;
+    }
+    for (i = 0; valid && i < numofseqids; i++) {
+      if (!feature_index_binary_string_valid(strings, stringpoolsize,
+                                             seqids[i].name) ||
+          gt_interval_index_traverse(trees[i], feature_index_binary_check_root,
+                                     &rc)) {
+        valid = false;
+      }
+    }
+    if (valid &&
+        !feature_index_binary_nodes_valid(rc.nodes, numofnodes, links,
+                                          numoflinks, links + numoflinks,
+                                          numofattributes, strings,
+                                          stringpoolsize)) {
+      valid = false;
+    }
+  }
+  if (!valid) {
+    gt_error_set(err, "file \"%s\" is not a valid binary feature index",
+                 filename);
+    for (i = 0; i < numofseqids; i++)
+      gt_interval_index_delete(trees[i]);
+    gt_free(trees);
+    gt_fa_xmunmap(data);
+    return NULL;
+  }
+
+  fi = gt_feature_index_create(gt_feature_index_binary_class());
+  fib = gt_feature_index_binary_cast(fi);
+  fib->data = data;
+  fib->numofseqids = numofseqids;
+  fib->firstseqid = data[BINARY_HEADER_FIRSTSEQID];
+  fib->seqids = (const FeatureIndexBinarySeqid*) (data + BINARY_HEADERSIZE);
+  fib->nodes = (const FeatureIndexBinaryNode*) (fib->seqids + numofseqids);
+  fib->links = (const GtUword*) (fib->nodes + numofnodes);
+  fib->attributes = fib->links + numoflinks;
+  fib->strings = (const char*) data + len - stringpoolsize;
+  fib->trees = trees;
+  fib->seqid_strs = gt_calloc(numofseqids ? numofseqids : 1,
+                              sizeof (*fib->seqid_strs));
+  fib->seqid_map = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
+  for (i = 0; i < numofseqids; i++) {
+    gt_hashmap_add(fib->seqid_map,
+                   (void*) (fib->strings + fib->seqids[i].name),
+                   (void*) (i + 1));
+  }
+  fib->sources = gt_hashmap_new(GT_HASH_DIRECT, NULL,
+                                (GtFree) gt_str_delete);
+  fib->graphs = gt_hashmap_new(GT_HASH_DIRECT, NULL,
+                               (GtFree) gt_genome_node_delete);
+  fib->lock = gt_mutex_new();
+  return fi;
+}
+
+typedef struct {
+  GtHashmap *string_offsets,  /* string -> offset in <strings> + 1 */
+            *node_nums;       /* node of the current graph -> number + 1 */
+  GtStr *strings;
+  GtArray *seqids,
+          *nodes,
+          *links,
+          *attributes,
+          *graph;             /* nodes of the current graph by number */
+} FeatureIndexBinaryWriter;
+
+static GtUword binary_writer_string(FeatureIndexBinaryWriter *w,
+                                    const char *str)
+{
+  GtUword offset;
+  if (!(offset = (GtUword) gt_hashmap_get(w->string_offsets, str))) {
+    offset = gt_str_length(w->strings) + 1;
+    gt_str_append_cstr(w->strings, str);
+    gt_str_append_char(w->strings, '\0');
+    gt_hashmap_add(w->string_offsets, gt_cstr_dup(str), (void*) offset);
+  }
+  return offset - 1;
+}
+
+static void binary_writer_number_node(FeatureIndexBinaryWriter *w,
+                                      GtFeatureNode *fn)
+{
+  if (!gt_hashmap_get(w->node_nums, fn)) {
+    gt_array_add(w->graph, fn);
+    gt_hashmap_add(w->node_nums, fn, (void*) gt_array_size(w->graph));
+  }
+}
+
+static void binary_writer_add_attribute(const char *attr_name,
+                                        const char *attr_value, void *data)
+{
+  FeatureIndexBinaryWriter *w = data;
+  GtUword offset = binary_writer_string(w, attr_name);
+  gt_array_add(w->attributes, offset);
+  offset = binary_writer_string(w, attr_value);
+  gt_array_add(w->attributes, offset);
+}
+
+/* appends the nodes of the feature graph with top-level node <root>, which
+   gets the first node number */
+static void binary_writer_add_graph(FeatureIndexBinaryWriter *w,
+                                    GtFeatureNode *root)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *fn, *child, *rep;
+  GtUword i, num, base = gt_array_size(w->nodes);
+
+  gt_hashmap_reset(w->node_nums);
+  gt_array_reset(w->graph);
+  binary_writer_number_node(w, root);
+  fni = gt_feature_node_iterator_new(root);
+  while ((fn = gt_feature_node_iterator_next(fni)))
+    binary_writer_number_node(w, fn);
+  gt_feature_node_iterator_delete(fni);
+
+  for (i = 0; i < gt_array_size(w->graph); i++) {
+    FeatureIndexBinaryNode rec;
+    GtRange range;
+    memset(&rec, 0, sizeof (rec));
+    fn = *(GtFeatureNode**) gt_array_get(w->graph, i);
+    range = gt_genome_node_get_range((GtGenomeNode*) fn);
+    rec.start = range.start;
+    rec.end = range.end;
+    rec.flags = (unsigned int) gt_feature_node_get_strand(fn) |
+                ((unsigned int) gt_feature_node_get_phase(fn)
+                 << BINARY_NODE_PHASESHIFT);
+    if (gt_feature_node_is_pseudo(fn))
+      rec.flags |= BINARY_NODE_PSEUDO;
+    else
+      rec.type = binary_writer_string(w, gt_feature_node_get_type(fn));
+    rec.source = gt_feature_node_has_source(fn)
+                 ? binary_writer_string(w, gt_feature_node_get_source(fn))
+                 : GT_UNDEF_UWORD;
+    if (gt_feature_node_score_is_defined(fn)) {
+      rec.flags |= BINARY_NODE_SCORE;
+      rec.score = gt_feature_node_get_score(fn);
+    }
+    if (gt_feature_node_is_multi(fn)) {
+      rep = gt_feature_node_get_multi_representative(fn);
+      if ((num = (GtUword) gt_hashmap_get(w->node_nums, rep))) {
+        rec.flags |= BINARY_NODE_MULTI;
+        rec.multirep = base + num - 1;
+      }
+    }
+    rec.firstchild = gt_array_size(w->links);
+    fni = gt_feature_node_iterator_new_direct(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      num = base + (GtUword) gt_hashmap_get(w->node_nums, child) - 1;
+      gt_array_add(w->links, num);
+    }
+    gt_feature_node_iterator_delete(fni);
+    rec.numofchildren = gt_array_size(w->links) - rec.firstchild;
+    rec.firstattribute = gt_array_size(w->attributes) / 2;
+    gt_feature_node_foreach_attribute(fn, binary_writer_add_attribute, w);
+    rec.numofattributes = gt_array_size(w->attributes) / 2 -
+                          rec.firstattribute;
+    rec.graphsize = i == 0 ? gt_array_size(w->graph) : 0;
+    gt_array_add(w->nodes, rec);
+  }
+}
+
+static int binary_writer_cmp_range(const void *v1, const void *v2)
+{
+  GtRange r1 = gt_genome_node_get_range(*(GtGenomeNode**) v1),
+          r2 = gt_genome_node_get_range(*(GtGenomeNode**) v2);
+  return gt_range_compare(&r1, &r2);
+}
+
+int gt_feature_index_binary_write(GtFeatureIndex *feature_index,
+                                  const char *filename, GtError *err)
+{
+  FeatureIndexBinaryWriter w;
+  GtUword header[BINARY_HEADERSIZE], i, j;
+  GtStrArray *seqids;
+  GtArray *features, *trees;
+  char *firstseqid;
+  GtStr *tmpfilename;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(feature_index && filename);
+
+  if (!(seqids = gt_feature_index_get_seqids(feature_index, err)))
+    return -1;
+  w.string_offsets = gt_hashmap_new(GT_HASH_STRING, gt_free_func, NULL);
+  w.node_nums = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  w.strings = gt_str_new();
+  w.seqids = gt_array_new(sizeof (FeatureIndexBinarySeqid));
+  w.nodes = gt_array_new(sizeof (FeatureIndexBinaryNode));
+  w.links = gt_array_new(sizeof (GtUword));
+  w.attributes = gt_array_new(sizeof (GtUword));
+  w.graph = gt_array_new(sizeof (GtFeatureNode*));
+  trees = gt_array_new(sizeof (GtIntervalIndex*));
+  tmpfilename = gt_str_new();
+
+  firstseqid = gt_feature_index_get_first_seqid(feature_index, err);
+  header[BINARY_HEADER_FIRSTSEQID] = GT_UNDEF_UWORD;
+  for (i = 0; !had_err && i < gt_str_array_size(seqids); i++) {
+    FeatureIndexBinarySeqid rec;
+    GtIntervalIndex *ii;
+    const char *seqid = gt_str_array_get(seqids, i);
+    GtRange range;
+    if (firstseqid && strcmp(seqid, firstseqid) == 0)
+      header[BINARY_HEADER_FIRSTSEQID] = i;
+    rec.name = binary_writer_string(&w, seqid);
+    had_err = gt_feature_index_get_range_for_seqid(feature_index, &range,
+                                                   seqid, err);
+    if (!had_err) {
+      rec.range_start = range.start;
+      rec.range_end = range.end;
+      range.start = range.end = GT_UNDEF_UWORD;
+      had_err = gt_feature_index_get_orig_range_for_seqid(feature_index,
+                                                          &range, seqid, err);
+      rec.region_start = range.start;
+      rec.region_end = range.end;
+    }
+    if (!had_err &&
+        !(features = gt_feature_index_get_features_for_seqid(feature_index,
+                                                             seqid, err))) {
+      had_err = -1;
+    }
+    if (!had_err) {
+      gt_array_add(w.seqids, rec);
+      gt_array_sort_stable(features, binary_writer_cmp_range);
+      ii = gt_interval_index_new(NULL);
+      for (j = 0; j < gt_array_size(features); j++) {
+        GtFeatureNode *fn = *(GtFeatureNode**) gt_array_get(features, j);
+        GtRange frange = gt_genome_node_get_range((GtGenomeNode*) fn);
+        gt_interval_index_add(ii, (void*) gt_array_size(w.nodes),
+                              frange.start, frange.end);
+        binary_writer_add_graph(&w, fn);
+      }
+      gt_array_add(trees, ii);
+      gt_array_delete(features);
+    }
+  }
+  gt_free(firstseqid);
+
+  /* the string pool is padded to keep the file size a multiple of words */
+  while (gt_str_length(w.strings) % sizeof (GtUword))
+    gt_str_append_char(w.strings, '\0');
+  /* an existing index may be mapped by other processes, hence it is replaced
+     by a new file rather than overwritten */
+  if (!had_err && !(fp = gt_fa_fopen_replacement(filename, tmpfilename, err)))
+    had_err = -1;
+  if (!had_err) {
+    header[BINARY_HEADER_MAGIC] = FEATURE_INDEX_BINARY_MAGIC;
+    header[BINARY_HEADER_VERSION] = FEATURE_INDEX_BINARY_VERSION;
+    header[BINARY_HEADER_WORDSIZE] = (GtUword) sizeof (GtUword);
+    header[BINARY_HEADER_NUMOFSEQIDS] = gt_array_size(w.seqids);
+    header[BINARY_HEADER_NUMOFNODES] = gt_array_size(w.nodes);
+    header[BINARY_HEADER_NUMOFLINKS] = gt_array_size(w.links);
+    header[BINARY_HEADER_NUMOFATTRIBUTES] = gt_array_size(w.attributes) / 2;
+    header[BINARY_HEADER_STRINGPOOLSIZE] = gt_str_length(w.strings);
+    gt_xfwrite(header, sizeof (GtUword), BINARY_HEADERSIZE, fp);
+    gt_xfwrite(gt_array_get_space(w.seqids), sizeof (FeatureIndexBinarySeqid),
+               gt_array_size(w.seqids), fp);
+    gt_xfwrite(gt_array_get_space(w.nodes), sizeof (FeatureIndexBinaryNode),
+               gt_array_size(w.nodes), fp);
+    gt_xfwrite(gt_array_get_space(w.links), sizeof (GtUword),
+               gt_array_size(w.links), fp);
+    gt_xfwrite(gt_array_get_space(w.attributes), sizeof (GtUword),
+               gt_array_size(w.attributes), fp);
+    for (i = 0; i < gt_array_size(trees); i++)
+      gt_interval_index_write(*(GtIntervalIndex**) gt_array_get(trees, i), fp);
+    gt_xfwrite(gt_str_get_mem(w.strings), 1, gt_str_length(w.strings), fp);
+    had_err = gt_fa_fclose_replacement(fp, filename, tmpfilename, false, err);
+  }
+
+  for (i = 0; i < gt_array_size(trees); i++)
+    gt_interval_index_delete(*(GtIntervalIndex**) gt_array_get(trees, i));
+  gt_array_delete(trees);
+  gt_str_delete(tmpfilename);
+  gt_hashmap_delete(w.string_offsets);
+  gt_hashmap_delete(w.node_nums);
+  gt_str_delete(w.strings);
+  gt_array_delete(w.seqids);
+  gt_array_delete(w.nodes);
+  gt_array_delete(w.links);
+  gt_array_delete(w.attributes);
+  gt_array_delete(w.graph);
+  gt_str_array_delete(seqids);
+  return had_err;
+}
+
+static GtUword feature_index_binary_graph_size(GtFeatureNode *fn)
+{
+  GtFeatureNodeIterator *fni;
+  GtUword size = 0;
+  fni = gt_feature_node_iterator_new(fn);
+  while (gt_feature_node_iterator_next(fni))
+    size++;
+  gt_feature_node_iterator_delete(fni);
+  return size;
+}
+
+int gt_feature_index_binary_unit_test(GtError *err)
+{
+  GtFeatureIndex *fi, *fib;
+  GtGenomeNode *gn, *gene, *mrna1, *mrna2, *exon;
+  GtArray *a, *b;
+  GtStr *seqid, *tmpfilename;
+  GtStrArray *seqids;
+  GtRange range;
+  FILE *tmpfp;
+  GtUword i, j, start;
+  bool has_seqid;
+  char *firstseqid;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* build an in-memory index with feature graphs, one of them a DAG */
+  fi = gt_feature_index_memory_new();
+  seqid = gt_str_new_cstr("ctg1");
+  gn = gt_region_node_new(seqid, 1, 100000);
+  had_err = gt_feature_index_add_region_node(fi, (GtRegionNode*) gn, err);
+  gt_genome_node_delete(gn);
+  for (i = 0; !had_err && i < 200; i++) {
+    start = 1 + (GtUword) random() % 99000;
+    gene = gt_feature_node_new(seqid, "gene", start, start + 999,
+                               GT_STRAND_FORWARD);
+    gt_feature_node_set_source((GtFeatureNode*) gene, seqid);
+    gt_feature_node_set_score((GtFeatureNode*) gene, (float) i);
+    gt_feature_node_set_attribute((GtFeatureNode*) gene, "ID", "gene");
+    mrna1 = gt_feature_node_new(seqid, "mRNA", start, start + 999,
+                                GT_STRAND_FORWARD);
+    mrna2 = gt_feature_node_new(seqid, "mRNA", start + 100, start + 999,
+                                GT_STRAND_FORWARD);
+    exon = gt_feature_node_new(seqid, "exon", start + 100, start + 200,
+                               GT_STRAND_FORWARD);
+    gt_feature_node_set_phase((GtFeatureNode*) exon, GT_PHASE_TWO);
+    gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) mrna1);
+    gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) mrna2);
+    gt_feature_node_add_child((GtFeatureNode*) mrna1, (GtFeatureNode*) exon);
+    gt_genome_node_ref(exon);
+    gt_feature_node_add_child((GtFeatureNode*) mrna2, (GtFeatureNode*) exon);
+    had_err = gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gene,
+                                                err);
+    gt_genome_node_delete(gene);
+  }
+  gt_str_delete(seqid);
+
+  tmpfilename = gt_str_new();
+  tmpfp = gt_xtmpfp(tmpfilename);
+  gt_fa_xfclose(tmpfp);
+  if (!had_err)
+    had_err = gt_feature_index_binary_write(fi, gt_str_get(tmpfilename), err);
+  fib = NULL;
+  if (!had_err && !(fib = gt_feature_index_binary_new(gt_str_get(tmpfilename),
+                                                      err))) {
+    had_err = -1;
+  }
+
+  if (!had_err) {
+    seqids = gt_feature_index_get_seqids(fib, err);
+    gt_ensure(gt_str_array_size(seqids) == 1);
+    gt_ensure(strcmp(gt_str_array_get(seqids, 0), "ctg1") == 0);
+    gt_str_array_delete(seqids);
+    firstseqid = gt_feature_index_get_first_seqid(fib, err);
+    gt_ensure(firstseqid && strcmp(firstseqid, "ctg1") == 0);
+    gt_free(firstseqid);
+    gt_ensure(gt_feature_index_has_seqid(fib, &has_seqid, "ctg2", err) == 0);
+    gt_ensure(!has_seqid);
+    gt_ensure(gt_feature_index_get_orig_range_for_seqid(fib, &range, "ctg1",
+                                                        err) == 0);
+    gt_ensure(range.start == 1 && range.end == 100000);
+  }
+
+  /* the range queries have to return the same feature graphs */
+  for (i = 0; !had_err && i < 50; i++) {
+    range.start = 1 + (GtUword) random() % 99000;
+    range.end = range.start + (GtUword) random() % 5000;
+    a = gt_array_new(sizeof (GtFeatureNode*));
+    b = gt_array_new(sizeof (GtFeatureNode*));
+    had_err = gt_feature_index_get_features_for_range(fi, a, "ctg1", &range,
+                                                      err);
+    if (!had_err)
+      had_err = gt_feature_index_get_features_for_range(fib, b, "ctg1",
+                                                        &range, err);
+    gt_ensure(gt_array_size(a) == gt_array_size(b));
+    for (j = 0; !had_err && j < gt_array_size(a); j++) {
+      GtFeatureNode *fa = *(GtFeatureNode**) gt_array_get(a, j),
+                    *fb = *(GtFeatureNode**) gt_array_get(b, j);
+      GtRange ra = gt_genome_node_get_range((GtGenomeNode*) fa),
+              rb = gt_genome_node_get_range((GtGenomeNode*) fb);
+      gt_ensure(gt_range_compare(&ra, &rb) == 0);
+      gt_ensure(gt_feature_node_get_score(fa) == gt_feature_node_get_score(fb));
+      gt_ensure(strcmp(gt_feature_node_get_source(fb), "ctg1") == 0);
+      gt_ensure(strcmp(gt_feature_node_get_attribute(fb, "ID"), "gene") == 0);
+      gt_ensure(feature_index_binary_graph_size(fa) ==
+                feature_index_binary_graph_size(fb));
+    }
+    gt_array_delete(a);
+    gt_array_delete(b);
+  }
+
+  /* repeated queries return the same nodes */
+  if (!had_err) {
+    range.start = 1;
+    range.end = 100000;
+    a = gt_array_new(sizeof (GtFeatureNode*));
+    b = gt_array_new(sizeof (GtFeatureNode*));
+    had_err = gt_feature_index_get_features_for_range(fib, a, "ctg1", &range,
+                                                      err);
+    if (!had_err)
+      had_err = gt_feature_index_get_features_for_range(fib, b, "ctg1",
+                                                        &range, err);
+    gt_ensure(gt_array_size(a) == 200 && gt_array_size(b) == 200);
+    for (j = 0; !had_err && j < gt_array_size(a); j++) {
+      gt_ensure(*(GtFeatureNode**) gt_array_get(a, j) ==
+                *(GtFeatureNode**) gt_array_get(b, j));
+    }
+    gt_array_delete(a);
+    gt_array_delete(b);
+  }
+
+  /* the index is read-only and queries of unknown sequences fail */
+  if (!had_err) {
+    GtError *tmperr = gt_error_new();
+    seqid = gt_str_new_cstr("ctg1");
+    gn = gt_feature_node_new(seqid, "gene", 1, 2, GT_STRAND_FORWARD);
+    gt_ensure(gt_feature_index_add_feature_node(fib, (GtFeatureNode*) gn,
+                                                tmperr) == -1);
+    gt_ensure(gt_error_is_set(tmperr));
+    gt_error_unset(tmperr);
+    a = gt_array_new(sizeof (GtFeatureNode*));
+    range.start = 1;
+    range.end = 2;
+    gt_ensure(gt_feature_index_get_features_for_range(fib, a, "ctg2", &range,
+                                                      tmperr) == -1);
+    gt_ensure(gt_error_is_set(tmperr));
+    gt_error_unset(tmperr);
+    gt_ensure(gt_feature_index_get_range_for_seqid(fib, &range, "ctg2",
+                                                   tmperr) == -1);
+    gt_ensure(gt_error_is_set(tmperr));
+    gt_error_unset(tmperr);
+    gt_ensure(gt_feature_index_get_orig_range_for_seqid(fib, &range, "ctg2",
+                                                        tmperr) == -1);
+    gt_ensure(gt_error_is_set(tmperr));
+    gt_array_delete(a);
+    gt_genome_node_delete(gn);
+    gt_str_delete(seqid);
+    gt_error_delete(tmperr);
+  }
+  gt_feature_index_delete(fib);
+  gt_feature_index_delete(fi);
+
+  /* corrupted node records are rejected */
+  if (!had_err) {
+    GtError *tmperr = gt_error_new();
+    GtUword *data, numofnodes;
+    FeatureIndexBinaryNode *nodes, saved;
+    GtUword *links;
+    size_t len;
+    if (!(data = gt_fa_heap_read(gt_str_get(tmpfilename), &len, err)))
+      had_err = -1;
+    for (i = 0; !had_err && i < 4UL; i++) {
+      numofnodes = data[BINARY_HEADER_NUMOFNODES];
+      nodes = (FeatureIndexBinaryNode*) ((FeatureIndexBinarySeqid*)
+                                         (data + BINARY_HEADERSIZE) +
+                                         data[BINARY_HEADER_NUMOFSEQIDS]);
+      links = (GtUword*) (nodes + numofnodes);
+      saved = nodes[4];
+      switch (i) {
+        case 0: nodes[4].graphsize = numofnodes; break;
+        case 1: nodes[4].firstattribute = GT_UWORD_MAX; break;
+        case 2: nodes[4].type = data[BINARY_HEADER_STRINGPOOLSIZE]; break;
+        default: nodes[4].numofchildren = 0; /* unreachable children */
+      }
+      tmpfp = gt_fa_xfopen(gt_str_get(tmpfilename), "wb");
+      gt_xfwrite(data, 1, len, tmpfp);
+      gt_fa_xfclose(tmpfp);
+      gt_ensure(!gt_feature_index_binary_new(gt_str_get(tmpfilename), tmperr));
+      gt_ensure(gt_error_is_set(tmperr));
+      gt_error_unset(tmperr);
+      nodes[4] = saved;
+    }
+    /* the exon of the second gene becomes its own child */
+    if (!had_err) {
+      gt_ensure(links[nodes[7].firstchild] == 6);
+      nodes[6].firstchild = nodes[7].firstchild;
+      nodes[6].numofchildren = 1;
+      tmpfp = gt_fa_xfopen(gt_str_get(tmpfilename), "wb");
+      gt_xfwrite(data, 1, len, tmpfp);
+      gt_fa_xfclose(tmpfp);
+      gt_ensure(!gt_feature_index_binary_new(gt_str_get(tmpfilename), tmperr));
+      gt_ensure(gt_error_is_set(tmperr));
+    }
+    gt_free(data);
+    gt_error_delete(tmperr);
+  }
+
+  /* files of a different format are rejected */
+  if (!had_err) {
+    GtError *tmperr = gt_error_new();
+    tmpfp = gt_fa_xfopen(gt_str_get(tmpfilename), "w");
+    gt_xfputs("##gff-version 3\n", tmpfp);
+    gt_fa_xfclose(tmpfp);
+    gt_ensure(!gt_feature_index_binary_new(gt_str_get(tmpfilename), tmperr));
+    gt_ensure(gt_error_is_set(tmperr));
+    gt_error_delete(tmperr);
+  }
+  gt_xremove(gt_str_get(tmpfilename));
+  gt_str_delete(tmpfilename);
+  return had_err;
+}
@@ -0,0 +1,42 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef FEATURE_INDEX_BINARY_API_H
+#define FEATURE_INDEX_BINARY_API_H
+
+#include "extended/feature_index_api.h"
+
+/* The <GtFeatureIndexBinary> class implements a read-only <GtFeatureIndex> on
+   a binary index file, which is memory mapped. Opening the index only reads
+   the table of sequence regions, the feature nodes are created from the
+   mapped file when they are returned by a query for the first time. */
+typedef struct GtFeatureIndexBinary GtFeatureIndexBinary;
+
+/* Creates a new <GtFeatureIndexBinary> object on the index file <filename>
+   written by <gt_feature_index_binary_write()>. Returns NULL and sets <err> if
+   the file could not be mapped or is not a valid index for this platform. */
+GtFeatureIndex* gt_feature_index_binary_new(const char *filename,
+                                            GtError *err);
+
+/* Writes the sequence regions and feature nodes of <feature_index> to the
+   binary index file <filename>. Returns 0 on success, a negative value
+   otherwise. The message in <err> is set accordingly. */
+int             gt_feature_index_binary_write(GtFeatureIndex *feature_index,
+                                              const char *filename,
+                                              GtError *err);
+
+#endif
@@ -24,6 +24,7 @@
 #include "core/cstr_api.h"
 #include "core/ensure.h"
 #include "core/hashmap.h"
+#include "core/interval_index.h"
 #include "core/interval_tree.h"
 #include "core/ma.h"
 #include "core/minmax.h"
@@ -45,6 +46,7 @@ struct GtFeatureIndexMemory {
   GtUword nof_region_nodes,
                 reference_count,
                 nof_nodes;
+  bool implicit;  /* use a <GtIntervalIndex> instead of a <GtIntervalTree> */
 };
 
 #define gt_feature_index_memory_cast(FI)\
@@ -52,13 +54,32 @@ struct GtFeatureIndexMemory {
 
 typedef struct {
   GtIntervalTree *features;
+  GtIntervalIndex *feature_index; /* used instead of <features> if the index
+                                     is implicit */
   GtRegionNode *region;
   GtRange dyn_range;
 } RegionInfo;
 
+static RegionInfo* region_info_new(GtFeatureIndexMemory *fi,
+                                   GtRegionNode *region)
+{
+  RegionInfo *info = gt_calloc(1, sizeof (RegionInfo));
+  info->region = region;
+  if (fi->implicit) {
+    info->feature_index = gt_interval_index_new((GtFree)
+                                                gt_genome_node_delete);
+  }
+  else
+    info->features = gt_interval_tree_new((GtFree) gt_genome_node_delete);
+  info->dyn_range.start = ~0UL;
+  info->dyn_range.end   = 0;
+  return info;
+}
+
 static void region_info_delete(RegionInfo *info)
 {
   gt_interval_tree_delete(info->features);
+  gt_interval_index_delete(info->feature_index);
   if (info->region)
     gt_genome_node_delete((GtGenomeNode*)info->region);
   gt_free(info);
@@ -75,12 +96,8 @@ int gt_feature_index_memory_add_region_node(GtFeatureIndex *gfi,
   gt_assert(fi && rn);
   seqid = gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) rn));
   if (!gt_hashmap_get(fi->regions, seqid)) {
-    info = gt_calloc(1, sizeof (RegionInfo));
-    info->region = (GtRegionNode*) gt_genome_node_ref((GtGenomeNode*) rn);
-    info->features = gt_interval_tree_new((GtFree)
-                                          gt_genome_node_delete);
-    info->dyn_range.start = ~0UL;
-    info->dyn_range.end   = 0;
+    info = region_info_new(fi, (GtRegionNode*)
+                               gt_genome_node_ref((GtGenomeNode*) rn));
     gt_hashmap_add(fi->regions, seqid, info);
     if (fi->nof_region_nodes++ == 0)
       fi->firstseqid = seqid;
@@ -114,20 +131,22 @@ int gt_feature_index_memory_add_feature_node(GtFeatureIndex *gfi,
      index entry and maintain our own GtRange. */
   if (!info)
   {
-    info = gt_calloc(1, sizeof (RegionInfo));
-    info->region = NULL;
-    info->features = gt_interval_tree_new((GtFree)
-                                          gt_genome_node_delete);
-    info->dyn_range.start = ~0UL;
-    info->dyn_range.end   = 0;
+    info = region_info_new(fi, NULL);
     gt_hashmap_add(fi->regions, seqid, info);
     if (fi->nof_region_nodes++ == 0)
       fi->firstseqid = seqid;
   }
 
   /* add node to the appropriate array in the hashtable */
-  new_node = gt_interval_tree_node_new(gn, node_range.start, node_range.end);
-  gt_interval_tree_insert(info->features, new_node);
+  if (fi->implicit) {
+    gt_interval_index_add(info->feature_index, gn, node_range.start,
+                          node_range.end);
+  }
+  else {
+    new_node = gt_interval_tree_node_new(gn, node_range.start,
+                                         node_range.end);
+    gt_interval_tree_insert(info->features, new_node);
+  }
   /* update dynamic range */
   info->dyn_range.start = MIN(info->dyn_range.start, node_range.start);
   info->dyn_range.end = MAX(info->dyn_range.end, node_range.end);
@@ -169,6 +188,10 @@ int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
   rinfo = (RegionInfo*) gt_hashmap_get(fi->regions, seqid);
   if (!rinfo)
     return 0;
+  if (fi->implicit) {
+    (void) gt_interval_index_remove(rinfo->feature_index, gn);
+    return 0;
+  }
   info.genome_node = (GtGenomeNode*) gn;
   info.node = NULL;
 
@@ -191,6 +214,14 @@ static int collect_features_from_itree(GtIntervalTreeNode *node, void *data)
   return 0;
 }
 
+static int collect_features_from_iindex(void *gn, GT_UNUSED GtUword start,
+                                        GT_UNUSED GtUword end, void *data)
+{
+  GtArray *a = (GtArray*) data;
+  gt_array_add(a, gn);
+  return 0;
+}
+
 GtArray* gt_feature_index_memory_get_features_for_seqid(GtFeatureIndex *gfi,
                                                         const char *seqid,
                                                         GT_UNUSED GtError *err)
@@ -203,7 +234,11 @@ GtArray* gt_feature_index_memory_get_features_for_seqid(GtFeatureIndex *gfi,
   fi = gt_feature_index_memory_cast(gfi);
   a = gt_array_new(sizeof (GtFeatureNode*));
   ri = (RegionInfo*) gt_hashmap_get(fi->regions, seqid);
-  if (ri) {
+  if (ri && fi->implicit) {
+    had_err = gt_interval_index_traverse(ri->feature_index,
+                                         collect_features_from_iindex, a);
+  }
+  else if (ri) {
     had_err = gt_interval_tree_traverse(ri->features,
                                         collect_features_from_itree,
                                         a);
@@ -237,8 +272,14 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
     gt_error_set(err, "feature index does not contain the given sequence id");
     return -1;
   }
-  gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
-                                        qry_range->end, results);
+  if (fi->implicit) {
+    gt_interval_index_find_all_overlapping(ri->feature_index, qry_range->start,
+                                           qry_range->end, results);
+  }
+  else {
+    gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
+                                          qry_range->end, results);
+  }
   gt_array_sort(results, gt_genome_node_cmp_range_start);
   return 0;
 }
@@ -393,6 +434,17 @@ GtFeatureIndex* gt_feature_index_memory_new(void)
   fim->regions = gt_hashmap_new(GT_HASH_STRING, NULL,
                                 (GtFree) region_info_delete);
   fim->nodes_in_index = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  fim->implicit = false;
+  return fi;
+}
+
+GtFeatureIndex* gt_feature_index_memory_new_implicit(void)
+{
+  GtFeatureIndexMemory *fim;
+  GtFeatureIndex *fi;
+  fi = gt_feature_index_memory_new();
+  fim = gt_feature_index_memory_cast(fi);
+  fim->implicit = true;
   return fi;
 }
 
@@ -433,6 +485,14 @@ int gt_feature_index_memory_unit_test(GtError *err)
   gt_genome_node_delete((GtGenomeNode*) fn);
   gt_feature_index_delete(fi);
 
+  /* run generic feature index tests on the implicit interval index */
+  if (!had_err) {
+    fi = gt_feature_index_memory_new_implicit();
+    gt_ensure(fi);
+    had_err = gt_feature_index_unit_test(fi, err);
+    gt_feature_index_delete(fi);
+  }
+
   gt_error_delete(testerr);
   return had_err;
 }
@@ -29,6 +29,14 @@ typedef struct GtFeatureIndexMemory GtFeatureIndexMemory;
 /* Creates a new <GtFeatureIndexMemory> object. */
 GtFeatureIndex* gt_feature_index_memory_new(void);
 
+/* Creates a new <GtFeatureIndexMemory> object which keeps the feature nodes of
+   each region in a sorted array, interpreted as an implicit interval tree.
+   The array is sorted and indexed on the first query after features were
+   added or removed, subsequent range queries are faster and return the
+   features already ordered by position. Use it if the index is filled once
+   and queried many times. */
+GtFeatureIndex* gt_feature_index_memory_new_implicit(void);
+
 /* Returns <ptr> if it is a valid node indexed in <GtFeatureIndexMemory>.
    Otherwise NULL is returned and <err> is set accordingly. */
 GtFeatureNode*  gt_feature_index_memory_get_node_by_ptr(GtFeatureIndexMemory*,
@@ -16,6 +16,7 @@
 */
 
 #include <stdarg.h>
+#include <string.h>
 #include "core/assert_api.h"
 #include "core/class_alloc.h"
 #include "core/cstr_api.h"
@@ -27,6 +28,8 @@
 #include "core/queue_api.h"
 #include "core/unused_api.h"
 #include "extended/eof_node_api.h"
+#include "extended/feature_node_api.h"
+#include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node_rep.h"
 #include "extended/gff3_defines.h"
 #include "extended/gff3_visitor_api.h"
@@ -418,6 +421,62 @@ void gt_genome_node_release_user_data(GtGenomeNode *gn, const char *key)
   }
 }
 
+static void genome_node_unshare_node(GtGenomeNode *gn, GtStr **seqid,
+                                     GtStr **source, GtStr **filename)
+{
+  GtFeatureNode *fn;
+  GtStr *str;
+  if ((str = gt_genome_node_get_seqid(gn)) && str != *seqid) {
+    if (!*seqid || gt_str_cmp(str, *seqid) != 0) {
+      gt_str_delete(*seqid);
+      *seqid = gt_str_clone(str);
+    }
+    gt_genome_node_change_seqid(gn, *seqid);
+  }
+  if ((fn = gt_feature_node_try_cast(gn)) && gt_feature_node_has_source(fn)) {
+    str = gt_str_new_cstr(gt_feature_node_get_source(fn));
+    if (!*source || gt_str_cmp(str, *source) != 0) {
+      gt_str_delete(*source);
+      *source = str;
+    }
+    else
+      gt_str_delete(str);
+    gt_feature_node_set_source(fn, *source);
+  }
+  /* only nodes read from a file have a line number */
+  if (gt_genome_node_get_line_number(gn) > 0) {
+    if (!*filename ||
+        strcmp(gt_str_get(*filename), gt_genome_node_get_filename(gn)) != 0) {
+      gt_str_delete(*filename);
+      *filename = gt_str_new_cstr(gt_genome_node_get_filename(gn));
+    }
+    gt_genome_node_set_origin(gn, *filename,
+                              gt_genome_node_get_line_number(gn));
+  }
+}
+
+void gt_genome_node_unshare_strings(GtGenomeNode *gn)
+{
+  GtStr *seqid = NULL, *source = NULL, *filename = NULL;
+  GtFeatureNode *fn;
+  gt_assert(gn);
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    GtFeatureNodeIterator *fni;
+    GtFeatureNode *node;
+    fni = gt_feature_node_iterator_new(fn);
+    while ((node = gt_feature_node_iterator_next(fni))) {
+      genome_node_unshare_node((GtGenomeNode*) node, &seqid, &source,
+                               &filename);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  else
+    genome_node_unshare_node(gn, &seqid, &source, &filename);
+  gt_str_delete(seqid);
+  gt_str_delete(source);
+  gt_str_delete(filename);
+}
+
 int gt_genome_node_unit_test(GtError *err)
 {
   int had_err = 0;
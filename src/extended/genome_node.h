@@ -42,6 +42,12 @@ void          gt_genome_nodes_show(GtArray *nodes, GtFile *outfp);
 bool          gt_genome_nodes_are_equal_region_nodes(GtGenomeNode*,
                                                      GtGenomeNode*);
 bool          gt_genome_nodes_are_sorted(const GtArray*);
+/* The reference counts of strings are not thread-safe. Replaces the sequence
+   ID, source, and filename strings of the feature tree rooted at <gn> (or of
+   <gn> alone, if it is not a feature node) by copies private to the tree, such
+   that it can be processed by another thread than the trees it shared these
+   strings with (e.g., the sequence IDs cached by the GFF3 parser). */
+void          gt_genome_node_unshare_strings(GtGenomeNode *gn);
 
 int           gt_genome_node_unit_test(GtError*);
 
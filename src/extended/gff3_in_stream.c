@@ -173,6 +173,24 @@ GtNodeStream* gt_gff3_in_stream_new_unsorted(int num_of_files,
   return ns;
 }
 
+GtNodeStream* gt_gff3_in_stream_new_line_ranges(const char *filename,
+                                                const GtArray *line_ranges)
+{
+  GtNodeStream *ns = gt_node_stream_create(gt_gff3_in_stream_class(), false);
+  GtGFF3InStream *is = gff3_in_stream_cast(ns);
+  is->fix_region_stream = NULL;
+  is->last_stream = is->gff3_in_stream_plain =
+         gt_gff3_in_stream_plain_new_line_ranges(filename, line_ranges);
+  gt_gff3_in_stream_plain_check_region_boundaries(
+                               (GtGFF3InStreamPlain*) is->gff3_in_stream_plain);
+  is->last_stream = is->add_ids_stream = gt_add_ids_stream_new(is->last_stream);
+  is->last_stream = is->multi_sanitize_stream =
+       gt_visitor_stream_new(is->last_stream, gt_multi_sanitizer_visitor_new());
+  is->last_stream = is->cds_check_stream =
+                                       gt_cds_check_stream_new(is->last_stream);
+  return ns;
+}
+
 GtNodeStream* gt_gff3_in_stream_new_sorted(const char *filename)
 {
   GtNodeStream *ns = gt_node_stream_create(gt_gff3_in_stream_class(), true);
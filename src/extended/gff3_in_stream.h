@@ -20,10 +20,17 @@
 
 #include <stdio.h>
 #include "extended/gff3_in_stream_api.h"
+#include "extended/gff3_in_stream_plain.h"
 #include "extended/node_stream_api.h"
 #include "extended/xrf_checker_api.h"
 
 const GtNodeStreamClass* gt_gff3_in_stream_class(void);
+/* Create a <GtGFF3InStream*> which parses the <line_ranges> (an array of
+   <GtGFF3LineRange>s in ascending order) of the uncompressed file
+   <filename>. */
+GtNodeStream*            gt_gff3_in_stream_new_line_ranges(const char *filename,
+                                                           const GtArray
+                                                           *line_ranges);
 void                     gt_gff3_in_stream_set_xrf_checker(GtNodeStream *ns,
                                                            GtXRFChecker
                                                              *xrf_checker);
@@ -16,6 +16,7 @@
 */
 
 #include <string.h>
+#include "core/array_api.h"
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
 #include "core/cstr_table.h"
@@ -30,8 +31,10 @@
 
 struct GtGFF3InStreamPlain {
   const GtNodeStream parent_instance;
-  GtUword next_file;
+  GtUword next_file,
+          next_line_range;
   GtStrArray *files;
+  GtArray *line_ranges; /* the parts of the only file which are parsed */
   GtStr *stdinstr;
   bool ensure_sorting,
        stdin_argument,
@@ -90,6 +93,22 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
   gt_assert(gt_queue_size(is->genome_node_buffer) <= 1);
 
   for (;;) {
+    /* open next line range if necessary */
+    if (!is->file_is_open && is->line_ranges) {
+      GtGFF3LineRange *line_range;
+      if (is->next_line_range == gt_array_size(is->line_ranges))
+        break;
+      line_range = gt_array_get(is->line_ranges, is->next_line_range++);
+      if (!(is->fpin = gt_file_open_part(gt_str_array_get(is->files, 0),
+                                         line_range->offset,
+                                         line_range->length, err))) {
+        had_err = -1;
+        break;
+      }
+      is->file_is_open = true;
+      is->line_number = line_range->line_number - 1;
+    }
+
     /* open file if necessary */
     if (!is->file_is_open) {
       if (gt_str_array_size(is->files) &&
@@ -135,9 +154,13 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
 
     gt_assert(is->file_is_open);
 
-    filenamestr = gt_str_array_size(is->files)
-                  ? gt_str_array_get_str(is->files, is->next_file-1)
-                  : is->stdinstr;
+    if (is->line_ranges)
+      filenamestr = gt_str_array_get_str(is->files, 0);
+    else {
+      filenamestr = gt_str_array_size(is->files)
+                    ? gt_str_array_get_str(is->files, is->next_file-1)
+                    : is->stdinstr;
+    }
     /* read two nodes */
     had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
                                                 is->genome_node_buffer,
@@ -162,7 +185,9 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
       gt_file_delete(is->fpin);
       is->fpin = NULL;
       is->file_is_open = false;
-      gt_gff3_parser_reset(is->gff3_parser);
+      /* the line ranges are parsed like a single file */
+      if (!is->line_ranges)
+        gt_gff3_parser_reset(is->gff3_parser);
       if (!gt_str_array_size(is->files)) {
         is->stdin_processed = true;
         break;
@@ -195,6 +220,7 @@ static void gff3_in_stream_plain_free(GtNodeStream *ns)
 {
   GtGFF3InStreamPlain *gff3_in_stream_plain = gff3_in_stream_plain_cast(ns);
   gt_str_array_delete(gff3_in_stream_plain->files);
+  gt_array_delete(gff3_in_stream_plain->line_ranges);
   gt_str_delete(gff3_in_stream_plain->stdinstr);
   while (gt_queue_size(gff3_in_stream_plain->genome_node_buffer)) {
     gt_genome_node_delete(gt_queue_get(gff3_in_stream_plain
@@ -322,6 +348,21 @@ GtNodeStream* gt_gff3_in_stream_plain_new_unsorted(int num_of_files,
   return gff3_in_stream_plain_new(files, false);
 }
 
+GtNodeStream* gt_gff3_in_stream_plain_new_line_ranges(const char *filename,
+                                                      const GtArray
+                                                      *line_ranges)
+{
+  GtNodeStream *ns;
+  GtGFF3InStreamPlain *is;
+  GtStrArray *files = gt_str_array_new();
+  gt_assert(filename && line_ranges);
+  gt_str_array_add_cstr(files, filename);
+  ns = gff3_in_stream_plain_new(files, false);
+  is = gff3_in_stream_plain_cast(ns);
+  is->line_ranges = gt_array_clone(line_ranges);
+  return ns;
+}
+
 GtNodeStream* gt_gff3_in_stream_plain_new_sorted(const char *filename)
 {
   GtStrArray *files = gt_str_array_new();
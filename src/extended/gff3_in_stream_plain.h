@@ -19,6 +19,7 @@
 #define GFF3_IN_STREAM_PLAIN_H
 
 #include <stdio.h>
+#include "core/array_api.h"
 #include "extended/gff3_in_stream_plain.h"
 #include "extended/node_stream_api.h"
 #include "extended/type_checker_api.h"
@@ -27,11 +28,24 @@
 /* Implements the <GtNodeStream> interface. */
 typedef struct GtGFF3InStreamPlain GtGFF3InStreamPlain;
 
+/* A range of complete lines of a GFF3 file. */
+typedef struct {
+  GtUword offset,      /* the byte offset of the first line */
+          length,      /* the number of bytes */
+          line_number; /* the number of the first line */
+} GtGFF3LineRange;
+
 const GtNodeStreamClass* gt_gff3_in_stream_plain_class(void);
 
 GtNodeStream* gt_gff3_in_stream_plain_new_unsorted(int num_of_files,
                                                    const char **filenames);
 GtNodeStream* gt_gff3_in_stream_plain_new_sorted(const char *filename);
+/* Returns a stream which parses the <line_ranges> (an array of
+   <GtGFF3LineRange>s in ascending order) of the uncompressed file <filename>
+   with the same parser, as if they were the only lines of the file. */
+GtNodeStream* gt_gff3_in_stream_plain_new_line_ranges(const char *filename,
+                                                      const GtArray
+                                                      *line_ranges);
 void          gt_gff3_in_stream_plain_check_id_attributes(GtGFF3InStreamPlain*);
 void          gt_gff3_in_stream_plain_check_region_boundaries(
                                                           GtGFF3InStreamPlain*);
@@ -0,0 +1,637 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "core/array_api.h"
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/fa.h"
+#include "core/file.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/str_api.h"
+#include "core/multithread_api.h"
+#include "core/str_array_api.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "extended/eof_node_api.h"
+#include "extended/gff3_defines.h"
+#include "extended/gff3_in_stream.h"
+#include "extended/gff3_partition_stream.h"
+#include "extended/region_node_api.h"
+
+#define GFF3_PARTITION_SEQUENCE_REGION  "##sequence-region"
+#define GFF3_PARTITION_FASTA_DIRECTIVE  "##FASTA"
+#define GFF3_PARTITION_GVF_VERSION      "##gvf-version"
+
+typedef struct {
+  GtUword file;         /* index in <files>, undefined for the standard input */
+  GtArray *line_ranges; /* NULL if the whole file is parsed */
+  unsigned int header_lines; /* the region nodes of these lines are dropped */
+  bool keep_eof;        /* the last partition of a file keeps its EOF node */
+  GtArray *nodes;       /* the processed nodes */
+} GFF3Partition;
+
+typedef struct {
+  GtUword offset,
+          line_number,
+          header_region; /* index + 1 of the ``##sequence-region'' line in
+                            the header, 0 if there is none */
+} GFF3RegionStart;
+
+struct GtGFF3PartitionStream {
+  const GtNodeStream parent_instance;
+  GtStrArray *files;
+  bool use_stdin,
+       scanned;
+  GtGFF3PartitionStreamChainFunc chain_func;
+  void *data;
+  GtArray *partitions;
+  GtNodeStream **chains; /* the chains of the current batch */
+  GtUword batchsize,
+          batchstart,    /* the first partition of the current batch */
+          batchend,      /* the first partition of the next batch */
+          current,       /* the partition delivered next */
+          nextnode,      /* the node of <current> delivered next */
+          errpartition;  /* the partition which failed */
+  GtError *partition_err;
+};
+
+typedef struct {
+  GtGFF3PartitionStream *ps;
+  GtUword nextpartition,
+          errpartition; /* the first partition for which an error occurred */
+  GtMutex *mutex;
+  GtError *err;
+} GtGFF3PartitionInfo;
+
+#define gff3_partition_stream_cast(NS)\
+        gt_node_stream_cast(gt_gff3_partition_stream_class(), NS)
+
+static void gff3_partition_stream_add_whole_file(GtGFF3PartitionStream *ps,
+                                                 GtUword file)
+{
+  GFF3Partition partition;
+  partition.file = file;
+  partition.line_ranges = NULL;
+  partition.header_lines = 0;
+  partition.keep_eof = true;
+  partition.nodes = NULL;
+  gt_array_add(ps->partitions, partition);
+}
+
+static void gff3_partition_stream_add_line_ranges(GtGFF3PartitionStream *ps,
+                                                  GtUword file,
+                                                  GtArray *line_ranges,
+                                                  unsigned int header_lines)
+{
+  GFF3Partition partition;
+  partition.file = file;
+  partition.line_ranges = line_ranges;
+  partition.header_lines = header_lines;
+  partition.keep_eof = false;
+  partition.nodes = NULL;
+  gt_array_add(ps->partitions, partition);
+}
+
+static void gff3_partition_stream_add_line_range(GtArray *line_ranges,
+                                                 GtUword offset,
+                                                 GtUword length,
+                                                 GtUword line_number)
+{
+  GtGFF3LineRange line_range;
+  line_range.offset = offset;
+  line_range.length = length;
+  line_range.line_number = line_number;
+  gt_array_add(line_ranges, line_range);
+}
+
+/* Returns false if a feature in <region> uses an ID of another sequence region
+   in the given <attributes> (of length <length>). The ID attributes defined
+   since the last terminator are stored in <ids>, the parents which have not
+   been defined yet in <parents>, both map the IDs to their region. */
+static bool gff3_partition_stream_check_ids(GtHashmap *ids, GtHashmap *parents,
+                                            GtStr *key, const char *attributes,
+                                            size_t length, GtUword region)
+{
+  const char *attribute = attributes, *end = attributes + length, *value,
+             *value_end;
+  GtUword id_region, parent_region;
+  while (attribute < end) {
+    const char *attribute_end = memchr(attribute, ';', end - attribute);
+    bool is_parent = false;
+    if (!attribute_end)
+      attribute_end = end;
+    while (attribute < attribute_end && *attribute == ' ')
+      attribute++;
+    if ((size_t) (attribute_end - attribute) > strlen(GT_GFF_ID) &&
+        !strncmp(attribute, GT_GFF_ID"=", strlen(GT_GFF_ID) + 1)) {
+      value = attribute + strlen(GT_GFF_ID) + 1;
+    }
+    else if ((size_t) (attribute_end - attribute) > strlen(GT_GFF_PARENT) &&
+             !strncmp(attribute, GT_GFF_PARENT"=",
+                      strlen(GT_GFF_PARENT) + 1)) {
+      value = attribute + strlen(GT_GFF_PARENT) + 1;
+      is_parent = true;
+    }
+    else
+      value = NULL;
+    while (value && value < attribute_end) {
+      value_end = is_parent ? memchr(value, ',', attribute_end - value) : NULL;
+      if (!value_end)
+        value_end = attribute_end;
+      gt_str_reset(key);
+      gt_str_append_cstr_nt(key, value, value_end - value);
+      if ((id_region = (GtUword) gt_hashmap_get(ids, gt_str_get(key)))) {
+        /* a multi-feature or a child of a feature of another region */
+        if (id_region != region)
+          return false;
+      }
+      else {
+        /* a parent which is defined after its child in another region */
+        parent_region = (GtUword) gt_hashmap_get(parents, gt_str_get(key));
+        if (parent_region && parent_region != region)
+          return false;
+        if (!is_parent) {
+          gt_hashmap_add(ids, gt_cstr_dup(gt_str_get(key)), (void*) region);
+        }
+        else if (!parent_region) {
+          gt_hashmap_add(parents, gt_cstr_dup(gt_str_get(key)),
+                         (void*) region);
+        }
+      }
+      value = value_end + 1;
+    }
+    attribute = attribute_end + 1;
+  }
+  return true;
+}
+
+/* Splits the mapped file <buf> of length <len> into its header, the blocks of
+   lines of its sequence regions, and its FASTA section. Returns false if the
+   file cannot be split, because the lines of a sequence region are not
+   contiguous, because a feature uses an ID of another sequence region (the
+   parser reports this for the whole file), or because there are less than
+   two sequence regions. */
+static bool gff3_partition_stream_split(GtGFF3PartitionStream *ps,
+                                        GtUword file, const char *buf,
+                                        GtUword len)
+{
+  GtArray *header_regions, *starts;
+  GtHashmap *header_seqids, *seqids, *ids, *parents;
+  GtStr *key;
+  GtUword pos = 0, line_number = 0, header_end = GT_UNDEF_UWORD,
+          content_end = len, fasta_line = 0, i;
+  const char *current = NULL;
+  size_t current_length = 0;
+  bool split = true;
+
+  header_regions = gt_array_new(sizeof (GtGFF3LineRange));
+  starts = gt_array_new(sizeof (GFF3RegionStart));
+  header_seqids = gt_hashmap_new(GT_HASH_STRING, gt_free_func, NULL);
+  seqids = gt_hashmap_new(GT_HASH_STRING, gt_free_func, NULL);
+  ids = gt_hashmap_new(GT_HASH_STRING, gt_free_func, NULL);
+  parents = gt_hashmap_new(GT_HASH_STRING, gt_free_func, NULL);
+  key = gt_str_new();
+
+  while (split && pos < len) {
+    const char *line = buf + pos, *eol, *seqid = NULL;
+    GtUword next;
+    size_t line_length, seqid_length = 0;
+    bool is_region = false;
+
+    eol = memchr(line, '\n', len - pos);
+    line_length = eol ? (size_t) (eol - line) : (size_t) (len - pos);
+    next = eol ? pos + line_length + 1 : len;
+    line_number++;
+    if (line_length && line[line_length-1] == '\r')
+      line_length--;
+    /* a carriage return within a line would end it for the parser */
+    if (memchr(line, '\r', line_length)) {
+      split = false;
+      break;
+    }
+
+    if (!line_length) {
+      pos = next;
+      continue;
+    }
+    if (line[0] == '>' ||
+        (line_length == strlen(GFF3_PARTITION_FASTA_DIRECTIVE) &&
+         !strncmp(line, GFF3_PARTITION_FASTA_DIRECTIVE, line_length))) {
+      /* the rest of the file is parsed as a single partition */
+      content_end = pos;
+      fasta_line = line_number;
+      break;
+    }
+    if (line[0] == '#') {
+      if (line_number == 1 &&
+          !strncmp(line, GFF3_PARTITION_GVF_VERSION,
+                   strlen(GFF3_PARTITION_GVF_VERSION))) {
+        split = false;
+        break;
+      }
+      if (line_length > strlen(GFF3_PARTITION_SEQUENCE_REGION) &&
+          !strncmp(line, GFF3_PARTITION_SEQUENCE_REGION,
+                   strlen(GFF3_PARTITION_SEQUENCE_REGION))) {
+        /* the seqid is the first token after the directive, as in the
+           parser */
+        size_t j = strlen(GFF3_PARTITION_SEQUENCE_REGION);
+        while (j < line_length && (line[j] == ' ' || line[j] == '\t'))
+          j++;
+        seqid = line + j;
+        while (j < line_length && line[j] != ' ' && line[j] != '\t')
+          j++;
+        seqid_length = (size_t) (line + j - seqid);
+        is_region = seqid_length > 0;
+      }
+      else if (!strncmp(line, GT_GFF_TERMINATOR,
+                        strlen(GT_GFF_TERMINATOR))) {
+        /* the parser forgets the IDs at a terminator */
+        gt_hashmap_reset(ids);
+        gt_hashmap_reset(parents);
+      }
+      if (!is_region) {
+        pos = next;
+        continue;
+      }
+    }
+    else {
+      seqid = line;
+      while (seqid_length < line_length && seqid[seqid_length] != '\t')
+        seqid_length++;
+    }
+
+    if (is_region && header_end == GT_UNDEF_UWORD) {
+      /* a ``##sequence-region'' line before the first feature */
+      char *key = gt_cstr_dup_nt(seqid, seqid_length);
+      if (gt_hashmap_get(header_seqids, key)) {
+        gt_free(key);
+        split = false;
+        break;
+      }
+      gff3_partition_stream_add_line_range(header_regions, pos, next - pos,
+                                           line_number);
+      gt_hashmap_add(header_seqids, key,
+                     (void*) gt_array_size(header_regions));
+    }
+    else if (!current || seqid_length != current_length ||
+             strncmp(seqid, current, seqid_length)) {
+      /* a new sequence region starts, with its first feature or with its
+         ``##sequence-region'' line */
+      char *key = gt_cstr_dup_nt(seqid, seqid_length);
+      GFF3RegionStart start;
+      if (gt_hashmap_get(seqids, key) ||
+          (is_region && gt_hashmap_get(header_seqids, key))) {
+        gt_free(key);
+        split = false;
+        break;
+      }
+      if (header_end == GT_UNDEF_UWORD)
+        header_end = pos;
+      start.offset = pos;
+      start.line_number = line_number;
+      start.header_region = (GtUword) gt_hashmap_get(header_seqids, key);
+      gt_array_add(starts, start);
+      gt_hashmap_add(seqids, key, (void*) gt_array_size(starts));
+      current = seqid;
+      current_length = seqid_length;
+    }
+    if (!is_region) {
+      /* the attributes are in the ninth column */
+      const char *attributes = line;
+      unsigned int column;
+      for (column = 1; attributes && column < 9; column++) {
+        attributes = memchr(attributes, '\t', line + line_length - attributes);
+        if (attributes)
+          attributes++;
+      }
+      if (attributes &&
+          !gff3_partition_stream_check_ids(ids, parents, key, attributes,
+                                           line + line_length - attributes,
+                                           gt_array_size(starts))) {
+        split = false;
+        break;
+      }
+    }
+    pos = next;
+  }
+
+  if (split && gt_array_size(starts) > 1) {
+    GFF3RegionStart *start;
+    GtArray *line_ranges;
+    unsigned int header_lines = 0;
+    if (header_end) {
+      line_ranges = gt_array_new(sizeof (GtGFF3LineRange));
+      gff3_partition_stream_add_line_range(line_ranges, 0, header_end, 1);
+      header_lines =
+        ((GFF3RegionStart*) gt_array_get_first(starts))->line_number - 1;
+      gff3_partition_stream_add_line_ranges(ps, file, line_ranges, 0);
+    }
+    for (i = 0; i < gt_array_size(starts); i++) {
+      GtUword end;
+      start = gt_array_get(starts, i);
+      end = i + 1 < gt_array_size(starts)
+            ? ((GFF3RegionStart*) gt_array_get(starts, i + 1))->offset
+            : content_end;
+      line_ranges = gt_array_new(sizeof (GtGFF3LineRange));
+      /* the parser checks the features against the header line of their
+         sequence region, whose region node is delivered with the header */
+      if (start->header_region) {
+        gt_array_add(line_ranges,
+                     *(GtGFF3LineRange*)
+                     gt_array_get(header_regions, start->header_region - 1));
+      }
+      gff3_partition_stream_add_line_range(line_ranges, start->offset,
+                                           end - start->offset,
+                                           start->line_number);
+      gff3_partition_stream_add_line_ranges(ps, file, line_ranges,
+                                            header_lines);
+    }
+    if (content_end < len) {
+      line_ranges = gt_array_new(sizeof (GtGFF3LineRange));
+      gff3_partition_stream_add_line_range(line_ranges, content_end,
+                                           len - content_end, fasta_line);
+      gff3_partition_stream_add_line_ranges(ps, file, line_ranges, 0);
+    }
+    ((GFF3Partition*) gt_array_get_last(ps->partitions))->keep_eof = true;
+  }
+  else
+    split = false;
+
+  gt_str_delete(key);
+  gt_hashmap_delete(parents);
+  gt_hashmap_delete(ids);
+  gt_hashmap_delete(seqids);
+  gt_hashmap_delete(header_seqids);
+  gt_array_delete(starts);
+  gt_array_delete(header_regions);
+  return split;
+}
+
+static void gff3_partition_stream_scan(GtGFF3PartitionStream *ps)
+{
+  GtUword i;
+  gt_assert(ps && !ps->scanned);
+  if (ps->use_stdin)
+    gff3_partition_stream_add_whole_file(ps, GT_UNDEF_UWORD);
+  for (i = 0; i < gt_str_array_size(ps->files); i++) {
+    const char *filename = gt_str_array_get(ps->files, i);
+    char *buf = NULL;
+    size_t len = 0;
+    if (strcmp(filename, "-") &&
+        gt_file_mode_determine(filename) == GT_FILE_MODE_UNCOMPRESSED) {
+      buf = gt_fa_mmap_read(filename, &len, NULL);
+    }
+    /* errors are reported by the parser of the whole file */
+    if (!buf || !gff3_partition_stream_split(ps, i, buf, len))
+      gff3_partition_stream_add_whole_file(ps, i);
+    gt_fa_xmunmap(buf);
+  }
+  ps->scanned = true;
+}
+
+static bool gff3_partition_stream_keep_node(const GFF3Partition *partition,
+                                            GtGenomeNode *gn)
+{
+  unsigned int line_number;
+  if (gt_eof_node_try_cast(gn))
+    return partition->keep_eof;
+  if (partition->header_lines && gt_region_node_try_cast(gn)) {
+    line_number = gt_genome_node_get_line_number(gn);
+    return !line_number || line_number > partition->header_lines;
+  }
+  return true;
+}
+
+static int gff3_partition_stream_process(GtGFF3PartitionStream *ps,
+                                         GtUword p, GtError *err)
+{
+  GFF3Partition *partition = gt_array_get(ps->partitions, p);
+  GtNodeStream *chain = ps->chains[p - ps->batchstart];
+  GtGenomeNode *gn;
+  int had_err;
+  gt_error_check(err);
+  while (!(had_err = gt_node_stream_next(chain, &gn, err)) && gn) {
+    if (gff3_partition_stream_keep_node(partition, gn))
+      gt_array_add(partition->nodes, gn);
+    else
+      gt_genome_node_delete(gn);
+  }
+  return had_err;
+}
+
+static void* gff3_partition_stream_thread(void *data)
+{
+  GtGFF3PartitionInfo *info = (GtGFF3PartitionInfo*) data;
+  GtError *err;
+  gt_assert(info);
+  err = gt_error_new();
+
+  while (true) {
+    GtUword p;
+    gt_mutex_lock(info->mutex);
+    if (info->nextpartition == info->ps->batchend ||
+        info->nextpartition > info->errpartition) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    p = info->nextpartition++;
+    gt_mutex_unlock(info->mutex);
+    if (gff3_partition_stream_process(info->ps, p, err)) {
+      /* report the error of the first partition, as a sequential run
+         would */
+      gt_mutex_lock(info->mutex);
+      if (p < info->errpartition) {
+        info->errpartition = p;
+        gt_error_set(info->err, "%s", gt_error_get(err));
+      }
+      gt_mutex_unlock(info->mutex);
+      gt_error_unset(err);
+    }
+  }
+  gt_error_delete(err);
+  return NULL;
+}
+
+static void gff3_partition_stream_delete_nodes(GFF3Partition *partition,
+                                               GtUword from)
+{
+  GtUword i;
+  if (!partition->nodes) return;
+  for (i = from; i < gt_array_size(partition->nodes); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(partition->nodes, i));
+  gt_array_delete(partition->nodes);
+  partition->nodes = NULL;
+}
+
+static int gff3_partition_stream_process_batch(GtGFF3PartitionStream *ps,
+                                               GtError *err)
+{
+  GtGFF3PartitionInfo info;
+  GtUword p;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(ps->current == ps->batchend);
+
+  ps->batchstart = ps->batchend;
+  ps->batchend = ps->batchstart + ps->batchsize;
+  if (ps->batchend > gt_array_size(ps->partitions))
+    ps->batchend = gt_array_size(ps->partitions);
+
+  /* the chains are created in this thread, because not every class they
+     consist of is safe to create concurrently */
+  for (p = ps->batchstart; !had_err && p < ps->batchend; p++) {
+    GFF3Partition *partition = gt_array_get(ps->partitions, p);
+    GtNodeStream *in_stream;
+    const char *filename;
+    if (partition->line_ranges) {
+      in_stream = gt_gff3_in_stream_new_line_ranges(
+                                     gt_str_array_get(ps->files,
+                                                      partition->file),
+                                     partition->line_ranges);
+    }
+    else if (partition->file == GT_UNDEF_UWORD)
+      in_stream = gt_gff3_in_stream_new_unsorted(0, NULL);
+    else {
+      filename = gt_str_array_get(ps->files, partition->file);
+      in_stream = gt_gff3_in_stream_new_unsorted(1, &filename);
+    }
+    partition->nodes = gt_array_new(sizeof (GtGenomeNode*));
+    if (!(ps->chains[p - ps->batchstart] = ps->chain_func(in_stream, ps->data,
+                                                          err))) {
+      had_err = -1;
+    }
+    gt_node_stream_delete(in_stream);
+  }
+
+  if (!had_err) {
+    info.ps = ps;
+    info.nextpartition = ps->batchstart;
+    info.errpartition = GT_UNDEF_UWORD;
+    info.mutex = gt_mutex_new();
+    info.err = ps->partition_err;
+    if (gt_multithread(gff3_partition_stream_thread, &info, err) != 0)
+      had_err = -1;
+    /* the nodes of the failed partition are delivered before its error */
+    ps->errpartition = info.errpartition;
+    gt_mutex_delete(info.mutex);
+  }
+
+  for (p = ps->batchstart; p < ps->batchend; p++) {
+    gt_node_stream_delete(ps->chains[p - ps->batchstart]);
+    ps->chains[p - ps->batchstart] = NULL;
+  }
+  ps->current = ps->batchstart;
+  ps->nextnode = 0;
+  return had_err;
+}
+
+static int gff3_partition_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                      GtError *err)
+{
+  GtGFF3PartitionStream *ps;
+  int had_err = 0;
+  gt_error_check(err);
+  ps = gff3_partition_stream_cast(ns);
+
+  if (!ps->scanned)
+    gff3_partition_stream_scan(ps);
+
+  *gn = NULL;
+  while (!had_err && !*gn) {
+    GFF3Partition *partition;
+    if (ps->current == ps->batchend) {
+      if (ps->batchend == gt_array_size(ps->partitions))
+        break;
+      if ((had_err = gff3_partition_stream_process_batch(ps, err)))
+        break;
+    }
+    partition = gt_array_get(ps->partitions, ps->current);
+    if (ps->nextnode < gt_array_size(partition->nodes)) {
+      *gn = *(GtGenomeNode**) gt_array_get(partition->nodes, ps->nextnode++);
+    }
+    else if (ps->current == ps->errpartition) {
+      gt_error_set(err, "%s", gt_error_get(ps->partition_err));
+      had_err = -1;
+    }
+    else {
+      gff3_partition_stream_delete_nodes(partition, ps->nextnode);
+      ps->current++;
+      ps->nextnode = 0;
+    }
+  }
+  return had_err;
+}
+
+static void gff3_partition_stream_free(GtNodeStream *ns)
+{
+  GtGFF3PartitionStream *ps = gff3_partition_stream_cast(ns);
+  GtUword i;
+  for (i = 0; i < gt_array_size(ps->partitions); i++) {
+    GFF3Partition *partition = gt_array_get(ps->partitions, i);
+    gff3_partition_stream_delete_nodes(partition,
+                                       i == ps->current ? ps->nextnode : 0);
+    gt_array_delete(partition->line_ranges);
+  }
+  gt_array_delete(ps->partitions);
+  gt_free(ps->chains);
+  gt_error_delete(ps->partition_err);
+  gt_str_array_delete(ps->files);
+}
+
+const GtNodeStreamClass* gt_gff3_partition_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtGFF3PartitionStream),
+                                   gff3_partition_stream_free,
+                                   gff3_partition_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_gff3_partition_stream_new(int num_of_files,
+                                           const char **filenames,
+                                           GtGFF3PartitionStreamChainFunc
+                                           chain_func,
+                                           void *data)
+{
+  GtGFF3PartitionStream *ps;
+  GtNodeStream *ns;
+  int i;
+  gt_assert(chain_func);
+  ns = gt_node_stream_create(gt_gff3_partition_stream_class(), false);
+  ps = gff3_partition_stream_cast(ns);
+  ps->files = gt_str_array_new();
+  for (i = 0; i < num_of_files; i++)
+    gt_str_array_add_cstr(ps->files, filenames[i]);
+  ps->use_stdin = num_of_files == 0;
+  ps->scanned = false;
+  ps->chain_func = chain_func;
+  ps->data = data;
+  ps->partitions = gt_array_new(sizeof (GFF3Partition));
+  ps->batchsize = (GtUword) gt_jobs *
+                  GT_GFF3_PARTITION_STREAM_PARTITIONSPERWORKER;
+  ps->chains = gt_calloc(ps->batchsize, sizeof (*ps->chains));
+  ps->batchstart = ps->batchend = ps->current = ps->nextnode = 0;
+  ps->errpartition = GT_UNDEF_UWORD;
+  ps->partition_err = gt_error_new();
+  return ns;
+}
@@ -0,0 +1,61 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef GFF3_PARTITION_STREAM_API_H
+#define GFF3_PARTITION_STREAM_API_H
+
+#include "extended/node_stream_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtGFF3PartitionStream> parses
+   GFF3 files and processes their sequence regions concurrently. An
+   uncompressed file in which the lines of every sequence region form a single
+   block is split into partitions: the lines before the first feature, one
+   partition per sequence region, and the FASTA section. Every partition is
+   parsed by a <GtGFF3InStream> of its own, which also reads the
+   ``##sequence-region'' lines of its region, and processed by a chain of
+   streams. The nodes of the partitions are delivered in the order of the
+   files. Other files (and the standard input) form a single partition, as do
+   files in which a feature refers to the ID of a feature of another sequence
+   region. */
+typedef struct GtGFF3PartitionStream GtGFF3PartitionStream;
+
+/* Is called with the <GtGFF3InStream*> <gff3_in_stream> which parses a
+   partition and the <data> given to <gt_gff3_partition_stream_new()>.
+   Returns a new reference to the last stream of the chain which processes the
+   nodes of the partition (which can be <gff3_in_stream> itself), or NULL and
+   sets <err> on error. The function is always called from the thread which
+   pulls the <GtGFF3PartitionStream>, but the chains are run in other threads
+   and must not share any state which is modified while the nodes are
+   processed. */
+typedef GtNodeStream* (*GtGFF3PartitionStreamChainFunc)(GtNodeStream
+                                                        *gff3_in_stream,
+                                                        void *data,
+                                                        GtError *err);
+
+/* Create a <GtGFF3PartitionStream*> which parses the <num_of_files> GFF3
+   files <filenames> (the standard input if <num_of_files> is 0). The
+   partitions are processed in batches, up to <gt_jobs> partitions of a batch
+   at the same time, by the chains returned by <chain_func>. The region nodes
+   of the ``##sequence-region'' lines before the first feature of a file are
+   delivered with the first partition. */
+GtNodeStream* gt_gff3_partition_stream_new(int num_of_files,
+                                           const char **filenames,
+                                           GtGFF3PartitionStreamChainFunc
+                                           chain_func,
+                                           void *data);
+
+#endif
@@ -15,39 +15,20 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
-#include "core/ma.h"
 #include "core/minmax.h"
 #include "extended/linearedist.h"
-
-static void fillDPtable(GtUword *dptable,
-                        const char *u, GtUword n,
-                        const char *v, GtUword m)
-{
-  GtUword i, j , nw, we;
-  for (i = 0; i <= n; i++)
-    dptable[i] = i;
-  for (j = 1; j <= m; j++) {
-    nw = dptable[0];
-    dptable[0] = j;
-    for (i = 1; i <= n; i++) {
-      we = dptable[i];
-      dptable[i] = nw + (u[i-1] == v[j-1] ? 0 : 1); /* replacement */
-      if (dptable[i-1] + 1 < dptable[i]) /* deletion */
-        dptable[i] = dptable[i-1] + 1;
-      if (we + 1 < dptable[i]) /* insertion */
-        dptable[i] = we + 1;
-      nw = we;
-    }
-  }
-}
+#include "extended/striped_align.h"
 
 GtUword gt_calc_linearedist(const char *u, GtUword n,
                                   const char *v, GtUword m)
 {
-  GtUword *dptable, edist;
-  dptable = gt_malloc(sizeof (GtUword) * (MIN(n,m) + 1));
-  fillDPtable(dptable, n <= m ? u : v, MIN(n,m), n <= m ? v : u, MAX(n,m));
-  edist = dptable[MIN(n,m)];
-  gt_free(dptable);
-  return edist;
+  if (!n || !m)
+    return MAX(n, m);
+  /* the edit distance is the cost of an optimal global alignment with unit
+     costs, the columns of the DP matrix range over the shorter sequence */
+  return n <= m
+         ? gt_striped_align_global(u, n, v, m, 1, 0, 1,
+                                   GT_STRIPED_ALIGN_KERNEL_AUTO)
+         : gt_striped_align_global(v, m, u, n, 1, 0, 1,
+                                   GT_STRIPED_ALIGN_KERNEL_AUTO);
 }
@@ -19,6 +19,7 @@
 #define LINEAREDIST_H
 
 #include "core/error.h"
+#include "core/types_api.h"
 
 /* Compute the edit distance of sequences u and v in O(max{|u|,|v|}) space */
 GtUword gt_calc_linearedist(const char *u, GtUword n,
@@ -89,7 +89,7 @@ static int merge_stream_next_in_order(GtNodeStream *ns, GtGenomeNode **gn,
   }
 
   /* stream the queue contents */
-  if (!gt_priority_queue_is_empty(ms->pq)) {
+  if (!had_err && !gt_priority_queue_is_empty(ms->pq)) {
     GtMergeStreamItem *min_item = gt_priority_queue_extract_min(ms->pq);
     GtGenomeNode *nextnode = NULL;
     gt_assert(min_item && min_item->gn);
@@ -177,6 +177,13 @@ static void merge_stream_free(GtNodeStream *ns)
 {
   GtMergeStream *ms = gt_merge_stream_cast(ns);
   GtUword i;
+  /* nodes are left if the merging was aborted */
+  while (!gt_priority_queue_is_empty(ms->pq)) {
+    GtMergeStreamItem *item = gt_priority_queue_extract_min(ms->pq);
+    gt_genome_node_delete(item->gn);
+  }
+  gt_genome_node_delete(ms->first_node);
+  gt_genome_node_delete(ms->second_node);
   for (i = 0; i < gt_array_size(ms->node_streams); i++)
     gt_node_stream_delete(*(GtNodeStream**) gt_array_get(ms->node_streams, i));
   gt_array_delete(ms->node_streams);
@@ -31,12 +31,15 @@
 #include "core/log_api.h"
 #include "core/logger_api.h"
 #include "core/ma.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
 #include "core/qsort_r_api.h"
 #include "core/range.h"
 #include "core/readmode_api.h"
 #include "core/safearith.h"
 #include "core/str_array.h"
 #include "core/str_array_api.h"
+#include "core/thread_api.h"
 #include "core/types_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -326,6 +329,55 @@ GtUword gt_n_r_encseq_get_unique_length(GtNREncseq *n_r_encseq) {
   return gt_encseq_total_length(n_r_encseq->unique_es);
 }
 
+const GtAlphabet *gt_n_r_encseq_get_alphabet(const GtNREncseq *n_r_encseq)
+{
+  return n_r_encseq->alphabet;
+}
+
+const GtEncseq *gt_n_r_encseq_get_unique_encseq(const GtNREncseq *n_r_encseq)
+{
+  return n_r_encseq->unique_es;
+}
+
+GtUword gt_n_r_encseq_get_orig_num_of_seqs(const GtNREncseq *n_r_encseq)
+{
+  return n_r_encseq->orig_num_seq;
+}
+
+GtUword gt_n_r_encseq_get_orig_seqlength(const GtNREncseq *n_r_encseq,
+                                         GtUword seqnum)
+{
+  gt_assert(seqnum < n_r_encseq->orig_num_seq);
+  return gt_n_r_encseq_ssp_seqlength(n_r_encseq, seqnum);
+}
+
+const char *gt_n_r_encseq_get_orig_id(const GtNREncseq *n_r_encseq,
+                                      GtUword *idlen,
+                                      GtUword seqnum)
+{
+  return gt_n_r_encseq_sdstab_get_id(n_r_encseq, idlen, seqnum);
+}
+
+void gt_n_r_encseq_unique_orig_seqnums(const GtNREncseq *n_r_encseq,
+                                       GtArrayGtUword *seqnums,
+                                       GtUword uentry_id)
+{
+  const GtNREncseqUnique *unique;
+  GtUword idx;
+  gt_assert(uentry_id < n_r_encseq->udb_nelems);
+  unique = n_r_encseq->uniques + uentry_id;
+  GT_STOREINARRAY(seqnums, GtUword, 128,
+                  gt_n_r_encseq_ssp_pos2seqnum(n_r_encseq,
+                                               unique->orig_startpos));
+  for (idx = 0; idx < (GtUword) unique->links.nextfreeuint32_t; idx++) {
+    const GtNREncseqLink *link =
+      n_r_encseq->links + unique->links.spaceuint32_t[idx];
+    GT_STOREINARRAY(seqnums, GtUword, 128,
+                    gt_n_r_encseq_ssp_pos2seqnum(n_r_encseq,
+                                                 link->orig_startpos));
+  }
+}
+
 GtUword gt_n_r_encseq_array_size_increase(GtUword allocated)
 {
   if (allocated != 0) {
@@ -593,8 +645,9 @@ GtNREncseq *gt_n_r_encseq_new_from_file(const char *basename_nre,
 /* returns index of the link element with the biggest orig_startpos smaller than
    <position>
    if smallest is larger, return that. */
-static GtUword gt_n_r_encseq_links_position_binsearch(GtNREncseq *nre,
-                                                      GtUword position)
+static GtUword
+gt_n_r_encseq_links_position_binsearch(const GtNREncseq *nre,
+                                       GtUword position)
 {
   GtWord idx, low, high;
   gt_assert(nre && nre->ldb_nelems > 0);
@@ -618,8 +671,9 @@ static GtUword gt_n_r_encseq_links_position_binsearch(GtNREncseq *nre,
 /* returns index of the unique element with the biggest orig_startpos smaller
    than <position>.
    if smallest is larger: return first. */
-static GtUword gt_n_r_encseq_uniques_position_binsearch(GtNREncseq *nre,
-                                                        GtUword position)
+static GtUword
+gt_n_r_encseq_uniques_position_binsearch(const GtNREncseq *nre,
+                                         GtUword position)
 {
   GtWord idx, low, high;
   gt_assert(nre && nre->udb_nelems > 0);
@@ -668,6 +722,15 @@ typedef struct GtNREncseqDiagonals {
   GtUword *diagonals;
 } GtNREncseqDiagonals;
 
+/* midpoints of a pair of seeds on the same diagonal, <seed_i> in the current
+   sequence, <seed_j> in the unique db */
+typedef struct GtNRECSeedpair {
+  GtUword seed_i,
+          seed_j;
+} GtNRECSeedpair;
+
+GT_DECLAREARRAYSTRUCT(GtNRECSeedpair);
+
 struct GtNREncseqCompressor {
   GtEncseq                       *input_es;
   GtHashmap                      *kmer_hash;
@@ -677,8 +740,10 @@ struct GtNREncseqCompressor {
   GtNREncseq                     *nre;
   GtNREncseqDiagonals            *diagonals;
   gt_n_r_e_compressor_extend_fkt  extend;
+  GtArrayGtNRECSeedpair           seedpairs;
   GtNRECXdrop                     xdrop;
   GtNRECWindow                    window;
+  GtXdropArbitraryscores          scores;
   GtUword                         current_orig_start,
                                   current_seq_len,
                                   current_seq_pos,
@@ -716,6 +781,18 @@ gt_n_r_encseq_compressor_xdrop_init(GtXdropArbitraryscores *scores,
   xdrop->xdropscore = xdropscore;
 }
 
+static void gt_n_r_encseq_compressor_xdrop_delete(GtNRECXdrop *xdrop)
+{
+  gt_xdrop_resources_delete(xdrop->left_xdrop_res);
+  gt_xdrop_resources_delete(xdrop->right_xdrop_res);
+  gt_xdrop_resources_delete(xdrop->best_left_res);
+  gt_xdrop_resources_delete(xdrop->best_right_res);
+  gt_seqabstract_delete(xdrop->unique_seq_fwd);
+  gt_seqabstract_delete(xdrop->unique_seq_bwd);
+  gt_seqabstract_delete(xdrop->current_seq_fwd);
+  gt_seqabstract_delete(xdrop->current_seq_bwd);
+}
+
 static void
 gt_n_r_encseq_compressor_xdrop(GtNREncseqCompressor *nrec,
                                GtUword seed_pos,
@@ -1020,38 +1097,19 @@ gt_n_r_e_compressor_extend_seeds_old(GtNREncseqCompressor *nrec)
   return best_link;
 }
 
-static GtNREncseqLink
-gt_n_r_e_compressor_extend_diagonal_seeds(GtNREncseqCompressor *nrec)
+/* updates the diagonals for the kmer positions <match_positions> of the kmer
+   at <nrec->main_pos> and appends the midpoints of seed pairs on the same
+   diagonal to <seedpairs>. If <undo> is not <NULL>, the overwritten diagonal
+   entries are appended to it, each as diagonal followed by the old value. */
+static void
+gt_n_r_e_compressor_diagonal_seedpairs(GtNREncseqCompressor *nrec,
+                                       const GtArrayGtUword *match_positions,
+                                       GtArrayGtNRECSeedpair *seedpairs,
+                                       GtArrayGtUword *undo)
 {
-  GtNREncseqLink best_link = {NULL, 0, 0, 0, 0};
-  GtRange current_bounds;
-  GtXdropbest best_left_xdrop = {0,0,0,0,0},
-              best_right_xdrop = {0,0,0,0,0};
-  GtArrayGtUword *match_positions;
-  GtNRECWindow *win = &nrec->window;
-  GtNRECXdrop *xdrop = &nrec->xdrop;
   GtNREncseqDiagonals *diags = nrec->diagonals;
-  GtUword best_match = GT_UNDEF_UWORD,
-          j_idx, i;
-  const bool forward = true;
-
-  match_positions = win->pos_arrs[GT_NREC_LAST_WIN(win)];
-  if (match_positions == NULL)
-    return best_link;
-
-  i = nrec->main_pos;
-
-  /* get bounds for current */
-  current_bounds.start = nrec->current_orig_start;
-  current_bounds.end = gt_n_r_encseq_ssp_seqstartpos(nrec->nre,
-                                                     nrec->main_seqnum) +
-                       nrec->current_seq_len;
-  gt_log_log("current: " GT_WU ":" GT_WU, current_bounds.start,
-             current_bounds.end);
-  gt_assert(current_bounds.start <= nrec->main_pos);
-  gt_assert(nrec->main_pos + nrec->kmersize <= current_bounds.end);
-
-  gt_assert(match_positions != NULL);
+  GtUword j_idx,
+          i = nrec->main_pos;
 
   for (j_idx = 0;
        j_idx < match_positions->nextfreeGtUword;
@@ -1062,6 +1120,10 @@ gt_n_r_e_compressor_extend_diagonal_seeds(GtNREncseqCompressor *nrec)
     gt_assert(j <= i);
     d = i - j;
 
+    if (undo != NULL) {
+      GT_STOREINARRAY(undo, GtUword, 256, d);
+      GT_STOREINARRAY(undo, GtUword, 256, diags->diagonals[d]);
+    }
     /* check if we have already processed windowsize kmers of this sequence and
        for previous hit on diagonal. */
     if (nrec->main_pos - nrec->current_orig_start >=
@@ -1075,50 +1137,18 @@ gt_n_r_e_compressor_extend_diagonal_seeds(GtNREncseqCompressor *nrec)
 
       if (distance > (GtUword) nrec->kmersize &&
           distance <= (GtUword) nrec->windowsize) {
-        GtUword i_prime,
-                midpoint_seed_i,
-                midpoint_seed_j,
-                midpoint_offset = GT_DIV2(distance + nrec->kmersize),
+        GtUword midpoint_offset = GT_DIV2(distance + nrec->kmersize),
                 j_unique = gt_n_r_encseq_uniques_position_binsearch(nrec->nre,
                                                                     j);
 
-        /* as j >= j' and d = i - j = i' - j', i' = d + j' can not overflow */
-        i_prime = d + j_prime;
-
-        midpoint_seed_j = j_prime + midpoint_offset;
-        midpoint_seed_i = i_prime + midpoint_offset;
-        /* j and j_prime have to be from the same unique sequences AND
-           midpoint_seed_j position has to be outside of the current
-           best alignment. (only checks for '>' because the previous j was
-           smaller, also note that i and j are reversed in xdrop) */
-        if (j_prime >= nrec->nre->uniques[j_unique].orig_startpos &&
-            (best_match == GT_UNDEF_UWORD ||
-             midpoint_seed_j > best_match + best_right_xdrop.ivalue)) {
-          gt_assert(midpoint_seed_i >= current_bounds.start);
-          gt_assert(midpoint_seed_i <= current_bounds.end);
-          gt_log_log("seed: " GT_WU " match: " GT_WU, midpoint_seed_i,
-                     midpoint_seed_j);
-          if (current_bounds.start < midpoint_seed_i) {
-            gt_seqabstract_reinit_encseq(xdrop->current_seq_bwd,
-                                         nrec->input_es,
-                                         midpoint_seed_i -
-                                         current_bounds.start,
-                                         current_bounds.start);
-          }
-          if (midpoint_seed_i < current_bounds.end) {
-            gt_seqabstract_reinit_encseq(xdrop->current_seq_fwd,
-                                         nrec->input_es,
-                                         current_bounds.end - midpoint_seed_i,
-                                         midpoint_seed_i);
-          }
-          gt_n_r_encseq_compressor_xdrop(nrec,
-                                         midpoint_seed_i,
-                                         midpoint_seed_j,
-                                         current_bounds,
-                                         &best_left_xdrop,
-                                         &best_right_xdrop,
-                                         &best_link,
-                                         &best_match);
+        /* j and j_prime have to be from the same unique sequences */
+        if (j_prime >= nrec->nre->uniques[j_unique].orig_startpos) {
+          GtNRECSeedpair *seedpair;
+          GT_GETNEXTFREEINARRAY(seedpair, seedpairs, GtNRECSeedpair, 32);
+          /* as j >= j' and d = i - j = i' - j', i' = d + j' can not
+             overflow */
+          seedpair->seed_i = d + j_prime + midpoint_offset;
+          seedpair->seed_j = j_prime + midpoint_offset;
         }
       }
       if (distance > (GtUword) nrec->kmersize)
@@ -1127,6 +1157,70 @@ gt_n_r_e_compressor_extend_diagonal_seeds(GtNREncseqCompressor *nrec)
     else
       diags->diagonals[d] = j;
   }
+}
+
+/* extends the seed pairs found by <gt_n_r_e_compressor_diagonal_seedpairs>,
+   does not change the diagonals and can therefore run concurrently for
+   different positions, each with its own <nrec->xdrop>. */
+static GtNREncseqLink
+gt_n_r_e_compressor_extend_seedpairs(GtNREncseqCompressor *nrec,
+                                     const GtNRECSeedpair *seedpairs,
+                                     GtUword numofseedpairs)
+{
+  GtNREncseqLink best_link = {NULL, 0, 0, 0, 0};
+  GtRange current_bounds;
+  GtXdropbest best_left_xdrop = {0,0,0,0,0},
+              best_right_xdrop = {0,0,0,0,0};
+  GtNRECXdrop *xdrop = &nrec->xdrop;
+  GtUword best_match = GT_UNDEF_UWORD,
+          idx;
+  const bool forward = true;
+
+  /* get bounds for current */
+  current_bounds.start = nrec->current_orig_start;
+  current_bounds.end = gt_n_r_encseq_ssp_seqstartpos(nrec->nre,
+                                                     nrec->main_seqnum) +
+                       nrec->current_seq_len;
+  gt_log_log("current: " GT_WU ":" GT_WU, current_bounds.start,
+             current_bounds.end);
+  gt_assert(current_bounds.start <= nrec->main_pos);
+  gt_assert(nrec->main_pos + nrec->kmersize <= current_bounds.end);
+
+  for (idx = 0; idx < numofseedpairs; idx++) {
+    GtUword midpoint_seed_i = seedpairs[idx].seed_i,
+            midpoint_seed_j = seedpairs[idx].seed_j;
+    /* midpoint_seed_j position has to be outside of the current best
+       alignment. (only checks for '>' because the previous j was smaller, also
+       note that i and j are reversed in xdrop) */
+    if (best_match == GT_UNDEF_UWORD ||
+        midpoint_seed_j > best_match + best_right_xdrop.ivalue) {
+      gt_assert(midpoint_seed_i >= current_bounds.start);
+      gt_assert(midpoint_seed_i <= current_bounds.end);
+      gt_log_log("seed: " GT_WU " match: " GT_WU, midpoint_seed_i,
+                 midpoint_seed_j);
+      if (current_bounds.start < midpoint_seed_i) {
+        gt_seqabstract_reinit_encseq(xdrop->current_seq_bwd,
+                                     nrec->input_es,
+                                     midpoint_seed_i -
+                                     current_bounds.start,
+                                     current_bounds.start);
+      }
+      if (midpoint_seed_i < current_bounds.end) {
+        gt_seqabstract_reinit_encseq(xdrop->current_seq_fwd,
+                                     nrec->input_es,
+                                     current_bounds.end - midpoint_seed_i,
+                                     midpoint_seed_i);
+      }
+      gt_n_r_encseq_compressor_xdrop(nrec,
+                                     midpoint_seed_i,
+                                     midpoint_seed_j,
+                                     current_bounds,
+                                     &best_left_xdrop,
+                                     &best_right_xdrop,
+                                     &best_link,
+                                     &best_match);
+    }
+  }
 
   if (best_link.len > nrec->minalignlen) {
     GtMultieoplist *meops;
@@ -1157,6 +1251,26 @@ gt_n_r_e_compressor_extend_diagonal_seeds(GtNREncseqCompressor *nrec)
   return best_link;
 }
 
+static GtNREncseqLink
+gt_n_r_e_compressor_extend_diagonal_seeds(GtNREncseqCompressor *nrec)
+{
+  GtNREncseqLink no_link = {NULL, 0, 0, 0, 0};
+  GtArrayGtUword *match_positions;
+  GtNRECWindow *win = &nrec->window;
+
+  match_positions = win->pos_arrs[GT_NREC_LAST_WIN(win)];
+  if (match_positions == NULL)
+    return no_link;
+
+  nrec->seedpairs.nextfreeGtNRECSeedpair = 0;
+  gt_n_r_e_compressor_diagonal_seedpairs(nrec, match_positions,
+                                         &nrec->seedpairs, NULL);
+  return gt_n_r_e_compressor_extend_seedpairs(
+                                       nrec,
+                                       nrec->seedpairs.spaceGtNRECSeedpair,
+                                       nrec->seedpairs.nextfreeGtNRECSeedpair);
+}
+
 GtNREncseqCompressor *gt_n_r_encseq_compressor_new(
                                                 GtUword initsize,
                                                 GtUword minalignlength,
@@ -1187,8 +1301,10 @@ GtNREncseqCompressor *gt_n_r_encseq_compressor_new(
   n_r_e_compressor->nre = NULL;
   n_r_e_compressor->windowsize = windowsize;
   n_r_e_compressor->diagonals = NULL;
-  gt_n_r_encseq_compressor_xdrop_init(scores, xdropscore,
+  n_r_e_compressor->scores = *scores;
+  gt_n_r_encseq_compressor_xdrop_init(&n_r_e_compressor->scores, xdropscore,
                                       &n_r_e_compressor->xdrop);
+  GT_INITARRAY(&n_r_e_compressor->seedpairs, GtNRECSeedpair);
   n_r_e_compressor->window.next = 0;
   n_r_e_compressor->window.count = 0;
   n_r_e_compressor->window.pos_arrs =
@@ -1225,14 +1341,8 @@ void gt_n_r_encseq_compressor_delete(GtNREncseqCompressor *n_r_e_compressor)
 {
   if (n_r_e_compressor != NULL) {
     gt_hashmap_delete(n_r_e_compressor->kmer_hash);
-    gt_xdrop_resources_delete(n_r_e_compressor->xdrop.left_xdrop_res);
-    gt_xdrop_resources_delete(n_r_e_compressor->xdrop.right_xdrop_res);
-    gt_xdrop_resources_delete(n_r_e_compressor->xdrop.best_left_res);
-    gt_xdrop_resources_delete(n_r_e_compressor->xdrop.best_right_res);
-    gt_seqabstract_delete(n_r_e_compressor->xdrop.unique_seq_fwd);
-    gt_seqabstract_delete(n_r_e_compressor->xdrop.unique_seq_bwd);
-    gt_seqabstract_delete(n_r_e_compressor->xdrop.current_seq_fwd);
-    gt_seqabstract_delete(n_r_e_compressor->xdrop.current_seq_bwd);
+    gt_n_r_encseq_compressor_xdrop_delete(&n_r_e_compressor->xdrop);
+    GT_FREEARRAY(&n_r_e_compressor->seedpairs, GtNRECSeedpair);
     gt_free(n_r_e_compressor->window.pos_arrs);
     gt_free(n_r_e_compressor->window.idxs);
     gt_free(n_r_e_compressor);
@@ -1390,11 +1500,12 @@ static void gt_n_r_e_compressor_add_current_unique_kmers(
   gt_n_r_e_compressor_add_kmers(nrec, addpos, nrec->main_pos);
 }
 
+/* adds <link> found at the current position to the db, if it is long enough */
   static GtNRECState
-gt_n_r_e_compressor_extend_seed_kmer(GtNREncseqCompressor *nrec)
+gt_n_r_e_compressor_add_link(GtNREncseqCompressor *nrec,
+                             GtNREncseqLink link)
 {
   GtNRECState state = GT_NREC_CONT;
-  GtNREncseqLink link = nrec->extend(nrec);
 
   if (link.len >= nrec->minalignlen) {
     GtUword remaining,
@@ -1435,6 +1546,12 @@ gt_n_r_e_compressor_extend_seed_kmer(GtNREncseqCompressor *nrec)
   return state;
 }
 
+  static GtNRECState
+gt_n_r_e_compressor_extend_seed_kmer(GtNREncseqCompressor *nrec)
+{
+  return gt_n_r_e_compressor_add_link(nrec, nrec->extend(nrec));
+}
+
 static void  gt_n_r_encseq_compressor_advance_win(GtNREncseqCompressor *nrec,
                                                   GtArrayGtUword *positions)
 {
@@ -1471,6 +1588,268 @@ gt_n_r_e_compressor_process_kmer(GtNREncseqCompressor *nrec,
   return state;
 }
 
+/* With more than one thread the seeds of the following kmers of the current
+   sequence are extended speculatively: all kmers of a batch are extended
+   concurrently as if no link was found before them. The results are then
+   used in order up to the first link, the remaining kmers are processed again
+   in the next batch. This results in the same db as the serial processing. */
+#define GT_NREC_BATCHSIZE_PER_THREAD 64
+
+typedef enum {
+  GT_NREC_ENTRY_EXTEND,
+  GT_NREC_ENTRY_SKIP,
+  GT_NREC_ENTRY_SEQEND
+} GtNRECEntrytype;
+
+typedef struct GtNRECBatchentry {
+  GtKmercode      kmercode;
+  GtNREncseqLink  link;
+  GtArrayGtUword *positions;
+  GtUword         pairsend,
+                  pairsstart,
+                  undostart,
+                  winend;
+  GtNRECEntrytype type;
+} GtNRECBatchentry;
+
+typedef struct GtNRECBatch {
+  GtNREncseqCompressor  *nrec;
+  GtNRECBatchentry      *entries;
+  /* window before the batch, followed by the positions of the batch kmers */
+  GtArrayGtUword       **window;
+  GtArrayGtNRECSeedpair  seedpairs;
+  GtArrayGtUword         undo;
+  GtNRECXdrop           *xdrops;
+  GtUword              **idxs;
+  GtMutex               *mutex;
+  GtUword                firstlink,
+                         main_pos,
+                         maxentries,
+                         nextentry,
+                         numofentries,
+                         numofpending,
+                         seq_pos;
+  unsigned int           nextthread;
+} GtNRECBatch;
+
+static GtNRECBatch *gt_n_r_e_compressor_batch_new(GtNREncseqCompressor *nrec)
+{
+  GtNRECBatch *batch = gt_malloc(sizeof (*batch));
+  unsigned int idx;
+
+  batch->nrec = nrec;
+  batch->maxentries = (GtUword) GT_NREC_BATCHSIZE_PER_THREAD * gt_jobs;
+  batch->entries = gt_malloc(sizeof (*batch->entries) * batch->maxentries);
+  batch->window = gt_malloc(sizeof (*batch->window) *
+                            (batch->maxentries + nrec->windowsize));
+  GT_INITARRAY(&batch->seedpairs, GtNRECSeedpair);
+  GT_INITARRAY(&batch->undo, GtUword);
+  batch->xdrops = gt_malloc(sizeof (*batch->xdrops) * gt_jobs);
+  batch->idxs = gt_malloc(sizeof (*batch->idxs) * gt_jobs);
+  for (idx = 0; idx < gt_jobs; idx++) {
+    gt_n_r_encseq_compressor_xdrop_init(&nrec->scores,
+                                        nrec->xdrop.xdropscore,
+                                        batch->xdrops + idx);
+    batch->idxs[idx] = gt_calloc((size_t) nrec->windowsize,
+                                 sizeof (*batch->idxs[idx]));
+  }
+  batch->mutex = gt_mutex_new();
+  batch->numofentries = 0;
+  batch->numofpending = 0;
+  return batch;
+}
+
+static void gt_n_r_e_compressor_batch_delete(GtNRECBatch *batch)
+{
+  unsigned int idx;
+  if (batch != NULL) {
+    for (idx = 0; idx < gt_jobs; idx++) {
+      gt_n_r_encseq_compressor_xdrop_delete(batch->xdrops + idx);
+      gt_free(batch->idxs[idx]);
+    }
+    gt_free(batch->xdrops);
+    gt_free(batch->idxs);
+    GT_FREEARRAY(&batch->seedpairs, GtNRECSeedpair);
+    GT_FREEARRAY(&batch->undo, GtUword);
+    gt_free(batch->window);
+    gt_free(batch->entries);
+    gt_mutex_delete(batch->mutex);
+    gt_free(batch);
+  }
+}
+
+static void *gt_n_r_e_compressor_batch_thread(void *data)
+{
+  GtNRECBatch *batch = data;
+  GtNREncseqCompressor nrec = *batch->nrec;
+  GtNRECBatchentry *entry;
+  GtUword entrynum;
+  unsigned int thread;
+
+  gt_mutex_lock(batch->mutex);
+  thread = batch->nextthread++;
+  gt_mutex_unlock(batch->mutex);
+  nrec.xdrop = batch->xdrops[thread];
+  nrec.window.idxs = batch->idxs[thread];
+  nrec.window.next = 0;
+
+  while (true) {
+    gt_mutex_lock(batch->mutex);
+    if (batch->nextentry >= batch->numofentries ||
+        batch->nextentry > batch->firstlink) {
+      gt_mutex_unlock(batch->mutex);
+      break;
+    }
+    entrynum = batch->nextentry++;
+    gt_mutex_unlock(batch->mutex);
+
+    entry = batch->entries + entrynum;
+    if (entry->type != GT_NREC_ENTRY_EXTEND)
+      continue;
+    nrec.main_pos = batch->main_pos + entrynum + 1;
+    nrec.current_seq_pos = batch->seq_pos + entrynum + 1;
+    nrec.window.count = (unsigned int) MIN(entry->winend,
+                                           (GtUword) nrec.windowsize);
+    nrec.window.pos_arrs = batch->window + entry->winend - nrec.window.count;
+    if (nrec.use_diagonals)
+      entry->link =
+        gt_n_r_e_compressor_extend_seedpairs(&nrec,
+                                             batch->seedpairs.
+                                               spaceGtNRECSeedpair +
+                                             entry->pairsstart,
+                                             entry->pairsend -
+                                             entry->pairsstart);
+    else
+      entry->link = nrec.extend(&nrec);
+    if (entry->link.len >= nrec.minalignlen) {
+      gt_mutex_lock(batch->mutex);
+      if (entrynum < batch->firstlink)
+        batch->firstlink = entrynum;
+      gt_mutex_unlock(batch->mutex);
+    }
+  }
+  /* xdrop swaps its resources */
+  batch->xdrops[thread] = nrec.xdrop;
+  return NULL;
+}
+
+/* reads the kmers of the next batch, the diagonals are updated as in the
+   serial processing, recording the old values */
+static void gt_n_r_e_compressor_batch_fill(GtNREncseqCompressor *nrec,
+                                           GtNRECBatch *batch)
+{
+  GtNRECWindow *win = &nrec->window;
+  GtNRECBatchentry *entry;
+  const GtKmercode *kmercode;
+  GtUword winlen = 0;
+  unsigned int idx;
+
+  for (idx = 0; idx < win->count; idx++)
+    batch->window[winlen++] = win->pos_arrs[GT_NREC_WINDOWIDX(win, idx)];
+  batch->main_pos = nrec->main_pos;
+  batch->seq_pos = nrec->current_seq_pos;
+  batch->seedpairs.nextfreeGtNRECSeedpair = 0;
+  batch->undo.nextfreeGtUword = 0;
+  batch->numofentries = 0;
+  while (batch->numofentries < batch->maxentries) {
+    entry = batch->entries + batch->numofentries;
+    if (batch->numofentries >= batch->numofpending) {
+      if ((kmercode =
+           gt_kmercodeiterator_encseq_next(nrec->main_kmer_iter)) == NULL)
+        break;
+      entry->kmercode = *kmercode;
+    }
+    batch->numofentries++;
+    entry->link.editscript = NULL;
+    entry->link.len = 0;
+    entry->positions = NULL;
+    entry->undostart = batch->undo.nextfreeGtUword;
+    entry->pairsstart =
+      entry->pairsend = batch->seedpairs.nextfreeGtNRECSeedpair;
+    if (!entry->kmercode.definedspecialposition) {
+      entry->type = GT_NREC_ENTRY_EXTEND;
+      entry->positions = gt_hashmap_get(nrec->kmer_hash,
+                                        (void *) entry->kmercode.code);
+      batch->window[winlen++] = entry->positions;
+      entry->winend = winlen;
+      if (nrec->use_diagonals && entry->positions != NULL) {
+        nrec->main_pos = batch->main_pos + batch->numofentries;
+        gt_n_r_e_compressor_diagonal_seedpairs(nrec, entry->positions,
+                                               &batch->seedpairs,
+                                               &batch->undo);
+        entry->pairsend = batch->seedpairs.nextfreeGtNRECSeedpair;
+      }
+    }
+    else if (batch->seq_pos + batch->numofentries + nrec->kmersize >=
+             nrec->current_seq_len) {
+      entry->type = GT_NREC_ENTRY_SEQEND;
+      break;
+    }
+    else
+      entry->type = GT_NREC_ENTRY_SKIP;
+  }
+  nrec->main_pos = batch->main_pos;
+  batch->numofpending = 0;
+}
+
+/* processes the next batch of kmers, sets <numofentries> of <batch> to 0 if
+   there are no more kmers */
+static int gt_n_r_e_compressor_process_batch(GtNREncseqCompressor *nrec,
+                                             GtNRECBatch *batch,
+                                             GtNRECState *state,
+                                             GtError *err)
+{
+  GtNRECBatchentry *entry;
+  GtUword idx, undoidx, first = 0;
+  int had_err = 0;
+
+  gt_n_r_e_compressor_batch_fill(nrec, batch);
+  if (batch->numofentries == 0)
+    return 0;
+  batch->nextentry = 0;
+  batch->firstlink = GT_UWORD_MAX;
+  batch->nextthread = 0;
+  had_err = gt_multithread(gt_n_r_e_compressor_batch_thread, batch, err);
+
+  while (!had_err && *state == GT_NREC_CONT && first < batch->numofentries) {
+    entry = batch->entries + first++;
+    nrec->main_pos++;
+    nrec->current_seq_pos++;
+    if (entry->type == GT_NREC_ENTRY_EXTEND) {
+      bool found_link = entry->link.len >= nrec->minalignlen;
+      gt_n_r_encseq_compressor_advance_win(nrec, entry->positions);
+      *state = gt_n_r_e_compressor_add_link(nrec, entry->link);
+      entry->link.editscript = NULL;
+      if (found_link)
+        break;
+    }
+    else if (entry->type == GT_NREC_ENTRY_SEQEND)
+      *state = gt_n_r_e_compressor_process_kmer(nrec, &entry->kmercode);
+  }
+
+  /* discard the results of kmers following the first link */
+  if (first < batch->numofentries) {
+    if (nrec->use_diagonals) {
+      for (undoidx = batch->undo.nextfreeGtUword;
+           undoidx > batch->entries[first].undostart;
+           undoidx -= 2) {
+        nrec->diagonals->diagonals[batch->undo.spaceGtUword[undoidx - 2]] =
+          batch->undo.spaceGtUword[undoidx - 1];
+      }
+    }
+    for (idx = first; idx < batch->numofentries; idx++) {
+      if (batch->entries[idx].link.editscript != NULL)
+        gt_editscript_delete(batch->entries[idx].link.editscript);
+    }
+    if (!had_err && *state == GT_NREC_CONT) {
+      for (idx = first; idx < batch->numofentries; idx++)
+        batch->entries[idx - first].kmercode = batch->entries[idx].kmercode;
+      batch->numofpending = batch->numofentries - first;
+    }
+  }
+  return had_err;
+}
+
   static GtNRECState
 gt_n_r_e_compressor_process_init_kmer_position(GtNREncseqCompressor *nrec,
                                                const GtKmercode *kcode)
@@ -1584,6 +1963,7 @@ static int gt_n_r_e_compressor_analyse(GtNREncseqCompressor *n_r_e_compressor,
                                        GtError *err)
 {
   const GtKmercode *main_kmercode = NULL;
+  GtNRECBatch *batch = NULL;
   GtNRECState state = GT_NREC_RESET;
   int had_err = 0;
 
@@ -1604,13 +1984,28 @@ static int gt_n_r_e_compressor_analyse(GtNREncseqCompressor *n_r_e_compressor,
            state == GT_NREC_RESET) {
       state = gt_n_r_e_compressor_process_kmer(n_r_e_compressor, main_kmercode);
     }
-    while (state == GT_NREC_CONT &&
-           (main_kmercode =
-            gt_kmercodeiterator_encseq_next(n_r_e_compressor->main_kmer_iter)
-           ) != NULL) {
-      n_r_e_compressor->main_pos++;
-      n_r_e_compressor->current_seq_pos++;
-      state = gt_n_r_e_compressor_process_kmer(n_r_e_compressor, main_kmercode);
+    if (gt_jobs > 1U) {
+      gt_logger_log(n_r_e_compressor->logger, "extend seeds speculatively "
+                    "with %u threads", gt_jobs);
+      batch = gt_n_r_e_compressor_batch_new(n_r_e_compressor);
+    }
+    while (!had_err && state == GT_NREC_CONT) {
+      if (batch != NULL) {
+        had_err = gt_n_r_e_compressor_process_batch(n_r_e_compressor, batch,
+                                                    &state, err);
+        if (batch->numofentries == 0)
+          break;
+      }
+      else {
+        if ((main_kmercode =
+             gt_kmercodeiterator_encseq_next(n_r_e_compressor->main_kmer_iter)
+            ) == NULL)
+          break;
+        n_r_e_compressor->main_pos++;
+        n_r_e_compressor->current_seq_pos++;
+        state = gt_n_r_e_compressor_process_kmer(n_r_e_compressor,
+                                                 main_kmercode);
+      }
       /* handle first kmer after reset of position, state will either be CONT or
          EOD afterwards. */
       while (state == GT_NREC_RESET &&
@@ -1621,7 +2016,8 @@ static int gt_n_r_e_compressor_analyse(GtNREncseqCompressor *n_r_e_compressor,
                                                  main_kmercode);
       }
     }
-    if (state != GT_NREC_EOD) {
+    gt_n_r_e_compressor_batch_delete(batch);
+    if (!had_err && state != GT_NREC_EOD) {
       had_err = -1;
       gt_error_set(err, "Processing of kmers stopped, "
                    "but end of data not reached");
@@ -2243,6 +2639,58 @@ int gt_n_r_encseq_decompressor_start_unique_extraction(
   return had_err;
 }
 
+/* fragments never span sequence separators, so the original sequence is
+   the concatenation of the uniques and links starting within its range */
+void gt_n_r_encseq_extract_orig_seq_encoded(const GtNREncseq *n_r_encseq,
+                                            GtArrayGtUchar *seq,
+                                            GtUword seqnum)
+{
+  GtUword uidx, lidx, pos, startpos, endpos;
+  gt_assert(seqnum < n_r_encseq->orig_num_seq);
+  startpos = gt_n_r_encseq_ssp_seqstartpos(n_r_encseq, seqnum);
+  endpos = startpos + gt_n_r_encseq_ssp_seqlength(n_r_encseq, seqnum);
+  seq->nextfreeGtUchar = 0;
+  GT_CHECKARRAYSPACEMULTI(seq, GtUchar, endpos - startpos);
+  uidx = gt_n_r_encseq_uniques_position_binsearch(n_r_encseq, startpos);
+  if (n_r_encseq->uniques[uidx].orig_startpos < startpos)
+    uidx++;
+  lidx = n_r_encseq->ldb_nelems == 0 ? 0 :
+    gt_n_r_encseq_links_position_binsearch(n_r_encseq, startpos);
+  if (lidx < n_r_encseq->ldb_nelems &&
+      n_r_encseq->links[lidx].orig_startpos < startpos)
+    lidx++;
+  pos = startpos;
+  while (pos < endpos) {
+    GtUchar *dest = seq->spaceGtUchar + pos - startpos;
+    if (uidx < n_r_encseq->udb_nelems &&
+        n_r_encseq->uniques[uidx].orig_startpos == pos) {
+      const GtUword ustart = gt_encseq_seqstartpos(n_r_encseq->unique_es,
+                                                   uidx);
+      gt_assert(pos + n_r_encseq->uniques[uidx].len <= endpos);
+      gt_encseq_extract_encoded(n_r_encseq->unique_es, dest, ustart,
+                                ustart + n_r_encseq->uniques[uidx].len - 1);
+      pos += n_r_encseq->uniques[uidx++].len;
+    } else {
+      const GtNREncseqLink *link = n_r_encseq->links + lidx;
+      GT_UNUSED GtUword len;
+      gt_assert(lidx < n_r_encseq->ldb_nelems && link->orig_startpos == pos &&
+                pos + link->len <= endpos);
+      len = gt_editscript_get_sequence(link->editscript,
+                                       n_r_encseq->unique_es,
+                                       gt_encseq_seqstartpos(
+                                                         n_r_encseq->unique_es,
+                                                         link->unique_id) +
+                                         link->unique_offset,
+                                       GT_READMODE_FORWARD,
+                                       dest);
+      gt_assert(len == link->len);
+      pos += link->len;
+      lidx++;
+    }
+  }
+  seq->nextfreeGtUchar = endpos - startpos;
+}
+
 int gt_n_r_encseq_unit_test(GT_UNUSED GtError *err)
 {
   int had_err = 0;
@@ -19,6 +19,7 @@
 #ifndef N_R_ENCSEQ_H
 #define N_R_ENCSEQ_H
 
+#include "core/arraydef.h"
 #include "core/encseq_api.h"
 #include "core/error_api.h"
 #include "core/logger_api.h"
@@ -59,6 +60,45 @@ GtUword     gt_n_r_encseq_get_orig_length(GtNREncseq *n_r_encseq);
    redundand sequences. */
 GtUword     gt_n_r_encseq_get_unique_length(GtNREncseq *n_r_encseq);
 
+/* Return the alphabet of the sequences stored in <n_r_encseq>. */
+const GtAlphabet *gt_n_r_encseq_get_alphabet(const GtNREncseq *n_r_encseq);
+
+/* Return the unique db of <n_r_encseq> as <GtEncseq>, sequence number i of it
+   corresponds to unique entry i. */
+const GtEncseq   *gt_n_r_encseq_get_unique_encseq(const GtNREncseq *n_r_encseq);
+
+/* Return the number of sequences in the original sequence collection. */
+GtUword           gt_n_r_encseq_get_orig_num_of_seqs(
+                                                const GtNREncseq *n_r_encseq);
+
+/* Return the length of original sequence number <seqnum>. */
+GtUword           gt_n_r_encseq_get_orig_seqlength(
+                                                const GtNREncseq *n_r_encseq,
+                                                GtUword seqnum);
+
+/* Return the id of original sequence number <seqnum>, which is not '\0'
+   terminated, its length is stored in <idlen>. */
+const char       *gt_n_r_encseq_get_orig_id(const GtNREncseq *n_r_encseq,
+                                            GtUword *idlen,
+                                            GtUword seqnum);
+
+/* Append the numbers of the original sequences containing unique entry
+   <uentry_id> or a link to it to <seqnums>. The numbers are neither sorted nor
+   free of duplicates. */
+void              gt_n_r_encseq_unique_orig_seqnums(
+                                                const GtNREncseq *n_r_encseq,
+                                                GtArrayGtUword *seqnums,
+                                                GtUword uentry_id);
+
+/* Decompress original sequence number <seqnum> into <seq>, which is
+   overwritten. The sequence is stored encoded, like
+   <gt_encseq_extract_encoded()> would do. Only reads from <n_r_encseq>, so
+   this can be called from several threads at once. */
+void              gt_n_r_encseq_extract_orig_seq_encoded(
+                                                const GtNREncseq *n_r_encseq,
+                                                GtArrayGtUchar *seq,
+                                                GtUword seqnum);
+
 /* Free space for <n_r_encseq> */
 void        gt_n_r_encseq_delete(GtNREncseq *n_r_encseq);
 
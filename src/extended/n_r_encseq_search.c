@@ -0,0 +1,935 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/alphabet_api.h"
+#include "core/array2dim_api.h"
+#include "core/arraydef.h"
+#include "core/assert_api.h"
+#include "core/divmodmul.h"
+#include "core/encseq_api.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
+#include "core/seq_iterator_sequence_buffer_api.h"
+#include "core/str_array_api.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "extended/multieoplist.h"
+#include "extended/n_r_encseq_search.h"
+#include "match/seqabstract.h"
+
+/* weight 11 seed of PatternHunter */
+#define GT_NRE_SEARCH_DNASEED  "111010010100110111"
+#define GT_NRE_SEARCH_PROTSEED "11011"
+#define GT_NRE_SEARCH_MAXNUMOFKEYS ((GtUword) 1 << 24)
+/* score of a wildcard against any residue, as for X in BLOSUM62 */
+#define GT_NRE_SEARCH_PROTWILDCARDSCORE -1
+
+/* BLOSUM62 of Henikoff and Henikoff (1992), used for protein */
+#define GT_NRE_SEARCH_BLOSUM62_AMINOACIDS "ARNDCQEGHILKMFPSTWYV"
+static const int gt_nre_search_blosum62[20][20] = {
+  /* A */ { 4,-1,-2,-2, 0,-1,-1, 0,-2,-1,-1,-1,-1,-2,-1, 1, 0,-3,-2, 0},
+  /* R */ {-1, 5, 0,-2,-3, 1, 0,-2, 0,-3,-2, 2,-1,-3,-2,-1,-1,-3,-2,-3},
+  /* N */ {-2, 0, 6, 1,-3, 0, 0, 0, 1,-3,-3, 0,-2,-3,-2, 1, 0,-4,-2,-3},
+  /* D */ {-2,-2, 1, 6,-3, 0, 2,-1,-1,-3,-4,-1,-3,-3,-1, 0,-1,-4,-3,-3},
+  /* C */ { 0,-3,-3,-3, 9,-3,-4,-3,-3,-1,-1,-3,-1,-2,-3,-1,-1,-2,-2,-1},
+  /* Q */ {-1, 1, 0, 0,-3, 5, 2,-2, 0,-3,-2, 1, 0,-3,-1, 0,-1,-2,-1,-2},
+  /* E */ {-1, 0, 0, 2,-4, 2, 5,-2, 0,-3,-3, 1,-2,-3,-1, 0,-1,-3,-2,-2},
+  /* G */ { 0,-2, 0,-1,-3,-2,-2, 6,-2,-4,-4,-2,-3,-3,-2, 0,-2,-2,-3,-3},
+  /* H */ {-2, 0, 1,-1,-3, 0, 0,-2, 8,-3,-3,-1,-2,-1,-2,-1,-2,-2, 2,-3},
+  /* I */ {-1,-3,-3,-3,-1,-3,-3,-4,-3, 4, 2,-3, 1, 0,-3,-2,-1,-3,-1, 3},
+  /* L */ {-1,-2,-3,-4,-1,-2,-3,-4,-3, 2, 4,-2, 2, 0,-3,-2,-1,-2,-1, 1},
+  /* K */ {-1, 2, 0,-1,-3, 1, 1,-2,-1,-3,-2, 5,-1,-3,-1, 0,-1,-3,-2,-2},
+  /* M */ {-1,-1,-2,-3,-1, 0,-2,-3,-2, 1, 2,-1, 5, 0,-2,-1,-1,-1,-1, 1},
+  /* F */ {-2,-3,-3,-3,-2,-3,-3,-3,-1, 0, 0,-3, 0, 6,-4,-2,-2, 1, 3,-1},
+  /* P */ {-1,-2,-2,-1,-3,-1,-1,-2,-2,-3,-3,-1,-2,-4, 7,-1,-1,-4,-3,-2},
+  /* S */ { 1,-1, 1, 0,-1, 0, 0, 0,-1,-2,-2, 0,-1,-2,-1, 4, 1,-3,-2,-2},
+  /* T */ { 0,-1, 0,-1,-1,-1,-1,-2,-2,-1,-1,-1,-1,-2,-1, 1, 5,-2,-2, 0},
+  /* W */ {-3,-3,-4,-4,-2,-2,-3,-2,-2,-3,-2,-3,-1, 1,-4,-3,-2,11, 2,-3},
+  /* Y */ {-2,-2,-2,-3,-2,-1,-2,-3, 2,-1,-1,-2,-1, 3,-3,-2,-2, 2, 7,-1},
+  /* V */ { 0,-3,-3,-3,-1,-2,-2,-3,-3, 3, 1,-2, 1,-1,-2,-2, 0,-3,-1, 4}
+};
+
+struct GtNREncseqSearch {
+  const GtNREncseq       *nre;
+  const GtEncseq         *unique_es;
+  GtLogger               *logger;
+  GtUchar                *uniqueseq;
+  GtUword                *bucketstart,
+                         *positions,
+                          numofkeys,
+                          uniquelength;
+  unsigned int           *seedoffsets,
+                          numofchars,
+                          seedspan,
+                          seedweight;
+  int                   **substscores;
+  GtXdropArbitraryscores  scores;
+  GtXdropscore            xdropbelow;
+  double                  lambda;
+  bool                    ungapped;
+};
+
+typedef struct {
+  const GtUchar *seq;
+  GtUword        checked,
+                 len,
+                 pos,
+                 validfrom;
+} GtNRESeedIterator;
+
+static void gt_nre_search_seediter_init(GtNRESeedIterator *si,
+                                        const GtUchar *seq,
+                                        GtUword len)
+{
+  si->seq = seq;
+  si->len = len;
+  si->checked = si->pos = si->validfrom = 0;
+}
+
+/* delivers the code of the next seed window of <si> not containing wildcards
+   or separators in <key> and its start position in <pos>, returns false if
+   there are no more windows. */
+static bool gt_nre_search_seediter_next(const GtNREncseqSearch *nres,
+                                        GtNRESeedIterator *si,
+                                        GtUword *key,
+                                        GtUword *pos)
+{
+  while (si->pos + nres->seedspan <= si->len) {
+    const GtUword endpos = si->pos + nres->seedspan;
+    while (si->checked < endpos) {
+      if (si->seq[si->checked] >= (GtUchar) nres->numofchars)
+        si->validfrom = si->checked + 1;
+      si->checked++;
+    }
+    if (si->validfrom <= si->pos) {
+      GtUword code = 0;
+      unsigned int idx;
+      for (idx = 0; idx < nres->seedweight; idx++)
+        code = code * nres->numofchars +
+               si->seq[si->pos + nres->seedoffsets[idx]];
+      *key = code;
+      *pos = si->pos++;
+      return true;
+    }
+    si->pos = si->validfrom;
+  }
+  return false;
+}
+
+static int gt_nre_search_seedpattern_parse(GtNREncseqSearch *nres,
+                                           const char *seedpattern,
+                                           GtError *err)
+{
+  int had_err = 0;
+  GtUword idx, numofkeys = 1;
+  const size_t span = strlen(seedpattern);
+
+  if (span == 0 || seedpattern[0] != '1' || seedpattern[span - 1] != '1' ||
+      strspn(seedpattern, "01") != span) {
+    gt_error_set(err, "illegal seed pattern \"%s\": must consist of 0 and 1 "
+                 "and start and end with 1", seedpattern);
+    had_err = -1;
+  }
+  if (!had_err) {
+    nres->seedspan = (unsigned int) span;
+    nres->seedoffsets = gt_malloc(sizeof (*nres->seedoffsets) * span);
+    nres->seedweight = 0;
+    for (idx = 0; !had_err && idx < (GtUword) span; idx++) {
+      if (seedpattern[idx] == '1') {
+        nres->seedoffsets[nres->seedweight++] = (unsigned int) idx;
+        numofkeys *= nres->numofchars;
+        if (numofkeys > GT_NRE_SEARCH_MAXNUMOFKEYS) {
+          gt_error_set(err, "weight of seed pattern \"%s\" too large for "
+                       "alphabet of size %u", seedpattern, nres->numofchars);
+          had_err = -1;
+        }
+      }
+    }
+    nres->numofkeys = numofkeys;
+  }
+  return had_err;
+}
+
+/* fills the substitution scores of the characters of <alphabet>: BLOSUM62
+   for protein, the match and mismatch scores of <scores> for DNA. Protein
+   characters not in BLOSUM62 are scored like wildcards. */
+static void gt_nre_search_substscores_new(GtNREncseqSearch *nres,
+                                          const GtAlphabet *alphabet,
+                                          const GtXdropArbitraryscores *scores)
+{
+  const char *blosumchars = GT_NRE_SEARCH_BLOSUM62_AMINOACIDS;
+  const char *blosumpos[UCHAR_MAX + 1];
+  unsigned int a, b;
+
+  gt_array2dim_malloc(nres->substscores, nres->numofchars, nres->numofchars);
+  for (a = 0; nres->ungapped && a < nres->numofchars; a++)
+    blosumpos[a] = strchr(blosumchars, (int) gt_alphabet_decode(alphabet,
+                                                               (GtUchar) a));
+  for (a = 0; a < nres->numofchars; a++) {
+    for (b = 0; b < nres->numofchars; b++) {
+      if (!nres->ungapped)
+        nres->substscores[a][b] = a == b ? (int) scores->mat
+                                         : (int) scores->mis;
+      else if (blosumpos[a] == NULL || blosumpos[b] == NULL)
+        nres->substscores[a][b] = GT_NRE_SEARCH_PROTWILDCARDSCORE;
+      else
+        nres->substscores[a][b]
+          = gt_nre_search_blosum62[blosumpos[a] - blosumchars]
+                                  [blosumpos[b] - blosumchars];
+    }
+  }
+}
+
+/* returns the score of characters <a> and <b> in an ungapped extension */
+static GtXdropscore gt_nre_search_substscore(const GtNREncseqSearch *nres,
+                                             GtUchar a, GtUchar b)
+{
+  if (a >= (GtUchar) nres->numofchars || b >= (GtUchar) nres->numofchars)
+    return (GtXdropscore) GT_NRE_SEARCH_PROTWILDCARDSCORE;
+  return (GtXdropscore) nres->substscores[a][b];
+}
+
+/* solves sum_{a,b} p_a p_b e^{lambda s(a,b)} = 1 for uniformly distributed
+   characters, see Karlin and Altschul (1990). */
+static double gt_nre_search_lambda_func(const GtNREncseqSearch *nres,
+                                        double lambda)
+{
+  double sum = 0.0;
+  unsigned int a, b;
+
+  for (a = 0; a < nres->numofchars; a++) {
+    for (b = 0; b < nres->numofchars; b++)
+      sum += exp(lambda * nres->substscores[a][b]);
+  }
+  return sum / ((double) nres->numofchars * (double) nres->numofchars) - 1.0;
+}
+
+static double gt_nre_search_lambda(const GtNREncseqSearch *nres)
+{
+  double low = 0.0, high = 1.0;
+  int iteration;
+
+  while (gt_nre_search_lambda_func(nres, high) <= 0.0)
+    high *= 2.0;
+  for (iteration = 0; iteration < 64; iteration++) {
+    const double mid = (low + high) / 2.0;
+    if (gt_nre_search_lambda_func(nres, mid) > 0.0)
+      high = mid;
+    else
+      low = mid;
+  }
+  return (low + high) / 2.0;
+}
+
+static void gt_nre_search_index_new(GtNREncseqSearch *nres)
+{
+  GtNRESeedIterator si;
+  GtUword key, pos, idx, numofseeds = 0;
+
+  nres->uniquelength = gt_encseq_total_length(nres->unique_es);
+  nres->uniqueseq = gt_malloc(sizeof (*nres->uniqueseq) * nres->uniquelength);
+  gt_encseq_extract_encoded(nres->unique_es, nres->uniqueseq, 0,
+                            nres->uniquelength - 1);
+  nres->bucketstart = gt_calloc((size_t) nres->numofkeys + 1,
+                                sizeof (*nres->bucketstart));
+  gt_nre_search_seediter_init(&si, nres->uniqueseq, nres->uniquelength);
+  while (gt_nre_search_seediter_next(nres, &si, &key, &pos)) {
+    nres->bucketstart[key]++;
+    numofseeds++;
+  }
+  for (idx = (GtUword) 1; idx <= nres->numofkeys; idx++)
+    nres->bucketstart[idx] += nres->bucketstart[idx - 1];
+  nres->positions = gt_malloc(sizeof (*nres->positions) * numofseeds);
+  gt_nre_search_seediter_init(&si, nres->uniqueseq, nres->uniquelength);
+  while (gt_nre_search_seediter_next(nres, &si, &key, &pos))
+    nres->positions[--nres->bucketstart[key]] = pos;
+  gt_logger_log(nres->logger, "seed index: " GT_WU " seeds in " GT_WU
+                " buckets", numofseeds, nres->numofkeys);
+}
+
+GtNREncseqSearch *gt_n_r_encseq_search_new(const GtNREncseq *nre,
+                                           const char *seedpattern,
+                                           const GtXdropArbitraryscores
+                                                                       *scores,
+                                           GtXdropscore xdropbelow,
+                                           GtLogger *logger,
+                                           GtError *err)
+{
+  int had_err = 0;
+  const GtAlphabet *alphabet = gt_n_r_encseq_get_alphabet(nre);
+  GtNREncseqSearch *nres = gt_calloc((size_t) 1, sizeof (*nres));
+  double expectedscore;
+  unsigned int a, b;
+  int maxscore = 0;
+
+  nres->nre = nre;
+  nres->unique_es = gt_n_r_encseq_get_unique_encseq(nre);
+  nres->logger = logger;
+  nres->scores = *scores;
+  nres->xdropbelow = xdropbelow;
+  nres->numofchars = gt_alphabet_num_of_chars(alphabet);
+  nres->ungapped = !gt_alphabet_is_dna(alphabet);
+  if (seedpattern == NULL)
+    seedpattern = nres->ungapped ? GT_NRE_SEARCH_PROTSEED
+                                 : GT_NRE_SEARCH_DNASEED;
+  gt_nre_search_substscores_new(nres, alphabet, scores);
+  expectedscore = 0.0;
+  for (a = 0; a < nres->numofchars; a++) {
+    for (b = 0; b < nres->numofchars; b++) {
+      expectedscore += nres->substscores[a][b];
+      if (nres->substscores[a][b] > maxscore)
+        maxscore = nres->substscores[a][b];
+    }
+  }
+  if (maxscore <= 0 || expectedscore >= 0.0) {
+    gt_error_set(err, "match score must be positive and the expected score "
+                 "of random alignments negative");
+    had_err = -1;
+  }
+  if (!had_err)
+    had_err = gt_nre_search_seedpattern_parse(nres, seedpattern, err);
+  if (!had_err) {
+    nres->lambda = gt_nre_search_lambda(nres);
+    gt_logger_log(logger, "seed pattern %s, lambda %.4f", seedpattern,
+                  nres->lambda);
+    gt_nre_search_index_new(nres);
+  }
+  if (had_err) {
+    gt_n_r_encseq_search_delete(nres);
+    return NULL;
+  }
+  return nres;
+}
+
+void gt_n_r_encseq_search_delete(GtNREncseqSearch *nres)
+{
+  if (nres != NULL) {
+    gt_free(nres->uniqueseq);
+    gt_free(nres->bucketstart);
+    gt_free(nres->positions);
+    gt_free(nres->seedoffsets);
+    if (nres->substscores != NULL)
+      gt_array2dim_delete(nres->substscores);
+    gt_free(nres);
+  }
+}
+
+typedef struct {
+  GtArrayGtUchar  seqs;
+  GtArrayGtUword  seqstart;
+  GtStrArray     *ids;
+} GtNRESearchQueries;
+
+static int gt_nre_search_queries_read(GtNRESearchQueries *queries,
+                                      const GtAlphabet *alphabet,
+                                      const char *querypath,
+                                      GtError *err)
+{
+  int had_err = 0, rval;
+  GtStrArray *files = gt_str_array_new();
+  GtSeqIterator *seqit;
+
+  gt_str_array_add_cstr(files, querypath);
+  seqit = gt_seq_iterator_sequence_buffer_new(files, err);
+  if (seqit == NULL)
+    had_err = -1;
+  if (!had_err) {
+    const GtUchar *seq;
+    GtUword len;
+    char *desc;
+
+    gt_seq_iterator_set_symbolmap(seqit, gt_alphabet_symbolmap(alphabet));
+    while ((rval = gt_seq_iterator_next(seqit, &seq, &len, &desc, err)) == 1) {
+      gt_str_array_add_cstr_nt(queries->ids, desc, strcspn(desc, " \t"));
+      GT_STOREINARRAY(&queries->seqstart, GtUword, 128,
+                      queries->seqs.nextfreeGtUchar);
+      GT_CHECKARRAYSPACEMULTI(&queries->seqs, GtUchar, len);
+      memcpy(queries->seqs.spaceGtUchar + queries->seqs.nextfreeGtUchar, seq,
+             (size_t) len);
+      queries->seqs.nextfreeGtUchar += len;
+    }
+    if (rval < 0)
+      had_err = -1;
+    GT_STOREINARRAY(&queries->seqstart, GtUword, 128,
+                    queries->seqs.nextfreeGtUchar);
+  }
+  gt_seq_iterator_delete(seqit);
+  gt_str_array_delete(files);
+  return had_err;
+}
+
+typedef struct {
+  GtUword diagonal,
+          qpos,
+          spos;
+} GtNRESeedhit;
+
+GT_DECLAREARRAYSTRUCT(GtNRESeedhit);
+
+typedef struct {
+  GtUword key,
+          qpos;
+} GtNREQueryseed;
+
+GT_DECLAREARRAYSTRUCT(GtNREQueryseed);
+
+typedef struct {
+  GtUword      alignlength,
+               qend,
+               qstart,
+               send,
+               sstart,
+               subject;
+  GtXdropscore score;
+  double       similarity;
+} GtNREHsp;
+
+GT_DECLAREARRAYSTRUCT(GtNREHsp);
+
+typedef struct {
+  GtXdropresources      *left_res,
+                        *right_res;
+  GtSeqabstract         *qleft,
+                        *qright,
+                        *sleft,
+                        *sright;
+  GtArrayGtNRESeedhit    seedhits;
+  GtArrayGtNREQueryseed  queryseeds;
+  GtArrayGtNREHsp        hsps;
+  GtArrayGtUword         subjects;
+  GtArrayGtUchar         target;
+} GtNRESearchWorkspace;
+
+static GtNRESearchWorkspace *gt_nre_search_workspace_new(
+                                                const GtNREncseqSearch *nres)
+{
+  GtNRESearchWorkspace *ws = gt_malloc(sizeof (*ws));
+  ws->left_res = gt_xdrop_resources_new(&nres->scores);
+  ws->right_res = gt_xdrop_resources_new(&nres->scores);
+  ws->qleft = gt_seqabstract_new_empty();
+  ws->qright = gt_seqabstract_new_empty();
+  ws->sleft = gt_seqabstract_new_empty();
+  ws->sright = gt_seqabstract_new_empty();
+  GT_INITARRAY(&ws->seedhits, GtNRESeedhit);
+  GT_INITARRAY(&ws->queryseeds, GtNREQueryseed);
+  GT_INITARRAY(&ws->hsps, GtNREHsp);
+  GT_INITARRAY(&ws->subjects, GtUword);
+  GT_INITARRAY(&ws->target, GtUchar);
+  return ws;
+}
+
+static void gt_nre_search_workspace_delete(GtNRESearchWorkspace *ws)
+{
+  gt_xdrop_resources_delete(ws->left_res);
+  gt_xdrop_resources_delete(ws->right_res);
+  gt_seqabstract_delete(ws->qleft);
+  gt_seqabstract_delete(ws->qright);
+  gt_seqabstract_delete(ws->sleft);
+  gt_seqabstract_delete(ws->sright);
+  GT_FREEARRAY(&ws->seedhits, GtNRESeedhit);
+  GT_FREEARRAY(&ws->queryseeds, GtNREQueryseed);
+  GT_FREEARRAY(&ws->hsps, GtNREHsp);
+  GT_FREEARRAY(&ws->subjects, GtUword);
+  GT_FREEARRAY(&ws->target, GtUchar);
+  gt_free(ws);
+}
+
+static void gt_nre_search_count_eops(GtMultieoplist *meops,
+                                     GtUword *matches,
+                                     GtUword *alignlength)
+{
+  GtUword idx, numofentries = gt_multieoplist_get_num_entries(meops);
+
+  for (idx = 0; idx < numofentries; idx++) {
+    GtMultieop eop = gt_multieoplist_get_entry(meops, idx);
+    if (eop.type == Match || eop.type == Replacement)
+      *matches += eop.steps;
+    *alignlength += eop.steps;
+  }
+  gt_multieoplist_delete(meops);
+}
+
+/* extends <hit> without gaps to both sides within
+   <subject>[<segstart>,<segend>), scoring residue pairs with the substitution
+   scores. Extensions stop when the score drops more than <xdropbelow> below
+   the best score. Used for protein, as the greedy xdrop alignment only
+   supports uniform match and mismatch scores. */
+static void gt_nre_search_extend_ungapped(const GtNREncseqSearch *nres,
+                                          const GtUchar *query,
+                                          GtUword querylength,
+                                          const GtUchar *subject,
+                                          GtUword segstart,
+                                          GtUword segend,
+                                          const GtNRESeedhit *hit,
+                                          bool withsimilarity,
+                                          GtNREHsp *hsp)
+{
+  GtXdropscore score = 0, rightbest = 0, leftbest = 0;
+  GtUword idx, maxlength, rightlength = 0, leftlength = 0;
+
+  maxlength = MIN(querylength - hit->qpos, segend - hit->spos);
+  for (idx = 0; idx < maxlength; idx++) {
+    score += gt_nre_search_substscore(nres, query[hit->qpos + idx],
+                                      subject[hit->spos + idx]);
+    if (score > rightbest) {
+      rightbest = score;
+      rightlength = idx + 1;
+    }
+    else if (rightbest - score > nres->xdropbelow)
+      break;
+  }
+  score = 0;
+  maxlength = MIN(hit->qpos, hit->spos - segstart);
+  for (idx = (GtUword) 1; idx <= maxlength; idx++) {
+    score += gt_nre_search_substscore(nres, query[hit->qpos - idx],
+                                      subject[hit->spos - idx]);
+    if (score > leftbest) {
+      leftbest = score;
+      leftlength = idx;
+    }
+    else if (leftbest - score > nres->xdropbelow)
+      break;
+  }
+  /* the first position of the seed matches, so the extension is not empty */
+  gt_assert(rightlength > 0);
+  hsp->qstart = hit->qpos - leftlength;
+  hsp->qend = hit->qpos + rightlength - 1;
+  hsp->sstart = hit->spos - leftlength;
+  hsp->send = hit->spos + rightlength - 1;
+  hsp->score = leftbest + rightbest;
+  if (withsimilarity) {
+    GtUword matches = 0;
+    hsp->alignlength = leftlength + rightlength;
+    for (idx = 0; idx < hsp->alignlength; idx++) {
+      const GtUchar a = query[hsp->qstart + idx];
+      if (a < (GtUchar) nres->numofchars && a == subject[hsp->sstart + idx])
+        matches++;
+    }
+    hsp->similarity = 100.0 * (double) matches / (double) hsp->alignlength;
+  }
+}
+
+/* extends <hit> to both sides within <subject>[<segstart>,<segend>) and stores
+   the resulting alignment in <hsp>. Returns false if its score is below
+   <minscore>, the similarity is only calculated if <withsimilarity>. */
+static bool gt_nre_search_extend(const GtNREncseqSearch *nres,
+                                 GtNRESearchWorkspace *ws,
+                                 const GtUchar *query,
+                                 GtUword querylength,
+                                 const GtUchar *subject,
+                                 GtUword segstart,
+                                 GtUword segend,
+                                 const GtNRESeedhit *hit,
+                                 GtXdropscore minscore,
+                                 bool withsimilarity,
+                                 GtNREHsp *hsp)
+{
+  GtXdropbest left = {0,0,0,0,0}, right = {0,0,0,0,0};
+  bool keep;
+
+  if (nres->ungapped) {
+    gt_nre_search_extend_ungapped(nres, query, querylength, subject, segstart,
+                                  segend, hit, false, hsp);
+    keep = hsp->score >= minscore;
+    if (keep && withsimilarity) {
+      gt_nre_search_extend_ungapped(nres, query, querylength, subject,
+                                    segstart, segend, hit, true, hsp);
+    }
+    return keep;
+  }
+  if (hit->qpos > 0 && hit->spos > segstart) {
+    gt_seqabstract_reinit_gtuchar(ws->qleft, query, hit->qpos, 0);
+    gt_seqabstract_reinit_gtuchar(ws->sleft, subject, hit->spos - segstart,
+                                  segstart);
+    gt_evalxdroparbitscoresextend(false, &left, ws->left_res, ws->qleft,
+                                  ws->sleft, nres->xdropbelow);
+  }
+  gt_seqabstract_reinit_gtuchar(ws->qright, query, querylength - hit->qpos,
+                                hit->qpos);
+  gt_seqabstract_reinit_gtuchar(ws->sright, subject, segend - hit->spos,
+                                hit->spos);
+  gt_evalxdroparbitscoresextend(true, &right, ws->right_res, ws->qright,
+                                ws->sright, nres->xdropbelow);
+  /* the first position of the seed matches, so the extension is not empty */
+  gt_assert(right.ivalue > 0 && right.jvalue > 0);
+  hsp->qstart = hit->qpos - left.ivalue;
+  hsp->qend = hit->qpos + right.ivalue - 1;
+  hsp->sstart = hit->spos - left.jvalue;
+  hsp->send = hit->spos + right.jvalue - 1;
+  hsp->score = left.score + right.score;
+  keep = hsp->score >= minscore;
+  if (keep && withsimilarity) {
+    GtUword matches = 0, alignlength = 0;
+    if (left.ivalue > 0 && left.jvalue > 0)
+      gt_nre_search_count_eops(gt_xdrop_backtrack(ws->left_res, &left),
+                               &matches, &alignlength);
+    gt_nre_search_count_eops(gt_xdrop_backtrack(ws->right_res, &right),
+                             &matches, &alignlength);
+    hsp->alignlength = alignlength;
+    hsp->similarity = 100.0 * (double) matches / (double) alignlength;
+  }
+  gt_xdrop_resources_reset(ws->left_res);
+  gt_xdrop_resources_reset(ws->right_res);
+  return keep;
+}
+
+static int gt_nre_search_seedhit_cmp(const void *a, const void *b)
+{
+  const GtNRESeedhit *hita = a, *hitb = b;
+  if (hita->diagonal != hitb->diagonal)
+    return hita->diagonal < hitb->diagonal ? -1 : 1;
+  if (hita->qpos != hitb->qpos)
+    return hita->qpos < hitb->qpos ? -1 : 1;
+  return 0;
+}
+
+/* extends the seed hits in order of diagonals, skipping those already covered
+   by an extension of an earlier seed hit on the same diagonal. If <subject> is
+   the unique db, extensions are restricted to the unique entry containing the
+   seed, which is stored as subject of the hsp, otherwise <subjectnum> is. */
+static void gt_nre_search_seedhits_extend(const GtNREncseqSearch *nres,
+                                          GtNRESearchWorkspace *ws,
+                                          const GtUchar *query,
+                                          GtUword querylength,
+                                          const GtUchar *subject,
+                                          GtUword subjectlength,
+                                          GtUword subjectnum,
+                                          GtXdropscore minscore,
+                                          bool withsimilarity)
+{
+  GtUword idx, lastdiagonal = GT_UNDEF_UWORD, coveredend = 0;
+
+  ws->hsps.nextfreeGtNREHsp = 0;
+  qsort(ws->seedhits.spaceGtNRESeedhit,
+        (size_t) ws->seedhits.nextfreeGtNRESeedhit,
+        sizeof (*ws->seedhits.spaceGtNRESeedhit), gt_nre_search_seedhit_cmp);
+  for (idx = 0; idx < ws->seedhits.nextfreeGtNRESeedhit; idx++) {
+    const GtNRESeedhit *hit = ws->seedhits.spaceGtNRESeedhit + idx;
+    GtUword segstart = 0, segend = subjectlength;
+    GtNREHsp *hsp;
+
+    if (hit->diagonal == lastdiagonal && hit->qpos < coveredend)
+      continue;
+    if (subject == nres->uniqueseq) {
+      subjectnum = gt_encseq_seqnum(nres->unique_es, hit->spos);
+      segstart = gt_encseq_seqstartpos(nres->unique_es, subjectnum);
+      segend = segstart + gt_encseq_seqlength(nres->unique_es, subjectnum);
+    }
+    GT_GETNEXTFREEINARRAY(hsp, &ws->hsps, GtNREHsp, 128);
+    hsp->subject = subjectnum;
+    if (!gt_nre_search_extend(nres, ws, query, querylength, subject, segstart,
+                              segend, hit, minscore, withsimilarity, hsp))
+      ws->hsps.nextfreeGtNREHsp--;
+    lastdiagonal = hit->diagonal;
+    coveredend = hsp->qend + 1;
+  }
+}
+
+static int gt_nre_search_queryseed_cmp(const void *a, const void *b)
+{
+  const GtNREQueryseed *seeda = a, *seedb = b;
+  if (seeda->key != seedb->key)
+    return seeda->key < seedb->key ? -1 : 1;
+  if (seeda->qpos != seedb->qpos)
+    return seeda->qpos < seedb->qpos ? -1 : 1;
+  return 0;
+}
+
+static int gt_nre_search_hsp_cmp(const void *a, const void *b)
+{
+  const GtNREHsp *hspa = a, *hspb = b;
+  if (hspa->score != hspb->score)
+    return hspa->score > hspb->score ? -1 : 1;
+  if (hspa->qstart != hspb->qstart)
+    return hspa->qstart < hspb->qstart ? -1 : 1;
+  if (hspa->sstart != hspb->sstart)
+    return hspa->sstart < hspb->sstart ? -1 : 1;
+  return 0;
+}
+
+/* appends the hsps of the workspace to <results>, omitting those contained in
+   an hsp of higher score, as these result from seeds on neighboured
+   diagonals of the same local alignment */
+static void gt_nre_search_hsps_append(GtNRESearchWorkspace *ws,
+                                      GtArrayGtNREHsp *results)
+{
+  GtUword idx, kept, firstkept = results->nextfreeGtNREHsp;
+
+  qsort(ws->hsps.spaceGtNREHsp, (size_t) ws->hsps.nextfreeGtNREHsp,
+        sizeof (*ws->hsps.spaceGtNREHsp), gt_nre_search_hsp_cmp);
+  for (idx = 0; idx < ws->hsps.nextfreeGtNREHsp; idx++) {
+    const GtNREHsp *hsp = ws->hsps.spaceGtNREHsp + idx;
+    bool contained = false;
+    for (kept = firstkept; !contained && kept < results->nextfreeGtNREHsp;
+         kept++) {
+      const GtNREHsp *other = results->spaceGtNREHsp + kept;
+      contained = other->qstart <= hsp->qstart && hsp->qend <= other->qend &&
+                  other->sstart <= hsp->sstart && hsp->send <= other->send;
+    }
+    if (!contained)
+      GT_STOREINARRAY(results, GtNREHsp, 32, *hsp);
+  }
+}
+
+static int gt_nre_search_uword_cmp(const void *a, const void *b)
+{
+  const GtUword *ua = a, *ub = b;
+  if (*ua != *ub)
+    return *ua < *ub ? -1 : 1;
+  return 0;
+}
+
+/* smallest raw score of an alignment of a query of length <querylength>
+   against a db of length <dblength> with an e-value of at most <evalue> */
+static GtXdropscore gt_nre_search_minscore(const GtNREncseqSearch *nres,
+                                           GtUword querylength,
+                                           GtUword dblength,
+                                           double evalue)
+{
+  double minscore = (log((double) querylength * (double) dblength) -
+                     log(evalue)) / nres->lambda;
+  return minscore < 1.0 ? (GtXdropscore) 1 : (GtXdropscore) ceil(minscore);
+}
+
+typedef struct {
+  const GtNREncseqSearch   *nres;
+  const GtNRESearchQueries *queries;
+  GtArrayGtNREHsp          *results;
+  GtUword                  *finedblength,
+                            bitscore,
+                            nextquery,
+                            numofqueries;
+  GtMutex                  *mutex;
+  double                    avgquerylength,
+                            ceval,
+                            feval;
+} GtNRESearchThreadinfo;
+
+static void gt_nre_search_query(const GtNRESearchThreadinfo *info,
+                                GtNRESearchWorkspace *ws,
+                                GtUword querynum)
+{
+  const GtNREncseqSearch *nres = info->nres;
+  const GtUchar *query = info->queries->seqs.spaceGtUchar +
+                         info->queries->seqstart.spaceGtUword[querynum];
+  const GtUword querylength = info->queries->seqstart.spaceGtUword[querynum+1]
+                              - info->queries->seqstart.spaceGtUword[querynum];
+  GtNRESeedIterator si;
+  GtUword key, pos, idx, numofsubjects = 0, dblength = 0;
+  GtXdropscore minscore;
+  double feval;
+
+  /* coarse search: seed hits in the unique db */
+  ws->seedhits.nextfreeGtNRESeedhit = 0;
+  ws->queryseeds.nextfreeGtNREQueryseed = 0;
+  gt_nre_search_seediter_init(&si, query, querylength);
+  while (gt_nre_search_seediter_next(nres, &si, &key, &pos)) {
+    GtNREQueryseed *queryseed;
+    for (idx = nres->bucketstart[key]; idx < nres->bucketstart[key+1]; idx++) {
+      GtNRESeedhit *hit;
+      GT_GETNEXTFREEINARRAY(hit, &ws->seedhits, GtNRESeedhit, 256);
+      hit->qpos = pos;
+      hit->spos = nres->positions[idx];
+      hit->diagonal = hit->spos + querylength - pos;
+    }
+    GT_GETNEXTFREEINARRAY(queryseed, &ws->queryseeds, GtNREQueryseed, 256);
+    queryseed->key = key;
+    queryseed->qpos = pos;
+  }
+  minscore = gt_nre_search_minscore(nres, querylength, nres->uniquelength,
+                                    info->ceval);
+  gt_nre_search_seedhits_extend(nres, ws, query, querylength, nres->uniqueseq,
+                                nres->uniquelength, 0, minscore, false);
+
+  /* the original sequences derived from the matching uniques form the db of
+     the fine search */
+  ws->subjects.nextfreeGtUword = 0;
+  for (idx = 0; idx < ws->hsps.nextfreeGtNREHsp; idx++)
+    gt_n_r_encseq_unique_orig_seqnums(nres->nre, &ws->subjects,
+                                      ws->hsps.spaceGtNREHsp[idx].subject);
+  qsort(ws->subjects.spaceGtUword, (size_t) ws->subjects.nextfreeGtUword,
+        sizeof (*ws->subjects.spaceGtUword), gt_nre_search_uword_cmp);
+  for (idx = 0; idx < ws->subjects.nextfreeGtUword; idx++) {
+    if (numofsubjects == 0 ||
+        ws->subjects.spaceGtUword[idx] !=
+        ws->subjects.spaceGtUword[numofsubjects - 1]) {
+      ws->subjects.spaceGtUword[numofsubjects++] =
+        ws->subjects.spaceGtUword[idx];
+      dblength += gt_n_r_encseq_get_orig_seqlength(nres->nre,
+                                                   ws->subjects.spaceGtUword
+                                                                        [idx]);
+    }
+  }
+  ws->subjects.nextfreeGtUword = numofsubjects;
+  info->finedblength[querynum] = dblength;
+  if (numofsubjects == 0)
+    return;
+
+  /* fine search: seeds of the query are looked up for each seed window of the
+     decompressed original sequences */
+  if (info->feval == GT_UNDEF_DOUBLE)
+    feval = pow(2.0, -(double) info->bitscore) * info->avgquerylength *
+            (double) dblength;
+  else
+    feval = info->feval;
+  minscore = gt_nre_search_minscore(nres, querylength, dblength, feval);
+  qsort(ws->queryseeds.spaceGtNREQueryseed,
+        (size_t) ws->queryseeds.nextfreeGtNREQueryseed,
+        sizeof (*ws->queryseeds.spaceGtNREQueryseed),
+        gt_nre_search_queryseed_cmp);
+  for (idx = 0; idx < numofsubjects; idx++) {
+    const GtUword subjectnum = ws->subjects.spaceGtUword[idx];
+    const GtNREQueryseed *queryseeds = ws->queryseeds.spaceGtNREQueryseed;
+    const GtUword numofqueryseeds = ws->queryseeds.nextfreeGtNREQueryseed;
+
+    gt_n_r_encseq_extract_orig_seq_encoded(nres->nre, &ws->target, subjectnum);
+    ws->seedhits.nextfreeGtNRESeedhit = 0;
+    gt_nre_search_seediter_init(&si, ws->target.spaceGtUchar,
+                                ws->target.nextfreeGtUchar);
+    while (gt_nre_search_seediter_next(nres, &si, &key, &pos)) {
+      GtUword left = 0, right = numofqueryseeds;
+      while (left < right) {
+        const GtUword mid = left + GT_DIV2(right - left);
+        if (queryseeds[mid].key < key)
+          left = mid + 1;
+        else
+          right = mid;
+      }
+      for (/* Nothing */; left < numofqueryseeds && queryseeds[left].key == key;
+           left++) {
+        GtNRESeedhit *hit;
+        GT_GETNEXTFREEINARRAY(hit, &ws->seedhits, GtNRESeedhit, 256);
+        hit->qpos = queryseeds[left].qpos;
+        hit->spos = pos;
+        hit->diagonal = pos + querylength - hit->qpos;
+      }
+    }
+    gt_nre_search_seedhits_extend(nres, ws, query, querylength,
+                                  ws->target.spaceGtUchar,
+                                  ws->target.nextfreeGtUchar, subjectnum,
+                                  minscore, true);
+    gt_nre_search_hsps_append(ws, info->results + querynum);
+  }
+}
+
+static void *gt_nre_search_threadfunc(void *data)
+{
+  GtNRESearchThreadinfo *info = (GtNRESearchThreadinfo *) data;
+  GtNRESearchWorkspace *ws = gt_nre_search_workspace_new(info->nres);
+
+  while (true) {
+    GtUword querynum;
+
+    gt_mutex_lock(info->mutex);
+    if (info->nextquery >= info->numofqueries) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    querynum = info->nextquery++;
+    gt_mutex_unlock(info->mutex);
+    gt_nre_search_query(info, ws, querynum);
+  }
+  gt_nre_search_workspace_delete(ws);
+  return NULL;
+}
+
+int gt_n_r_encseq_search_run(GtNREncseqSearch *nres,
+                             const char *querypath,
+                             double ceval,
+                             double feval,
+                             GtUword bitscore,
+                             GtFile *outfp,
+                             GtUword *numofhits,
+                             GtError *err)
+{
+  int had_err = 0;
+  GtNRESearchQueries queries;
+  GtNRESearchThreadinfo info;
+  GtUword querynum, idx;
+
+  gt_error_check(err);
+  GT_INITARRAY(&queries.seqs, GtUchar);
+  GT_INITARRAY(&queries.seqstart, GtUword);
+  queries.ids = gt_str_array_new();
+  *numofhits = 0;
+  had_err = gt_nre_search_queries_read(&queries,
+                                       gt_n_r_encseq_get_alphabet(nres->nre),
+                                       querypath, err);
+  if (!had_err) {
+    info.nres = nres;
+    info.queries = &queries;
+    info.numofqueries = gt_str_array_size(queries.ids);
+    info.nextquery = 0;
+    info.bitscore = bitscore;
+    info.ceval = ceval;
+    info.feval = feval;
+    info.avgquerylength = info.numofqueries == 0 ? 0.0 :
+      (double) queries.seqs.nextfreeGtUchar / (double) info.numofqueries;
+    info.results = gt_malloc(sizeof (*info.results) * info.numofqueries);
+    for (querynum = 0; querynum < info.numofqueries; querynum++)
+      GT_INITARRAY(info.results + querynum, GtNREHsp);
+    info.finedblength = gt_calloc((size_t) info.numofqueries,
+                                  sizeof (*info.finedblength));
+    info.mutex = gt_mutex_new();
+    gt_logger_log(nres->logger, GT_WU " queries, avg query size: %.0f",
+                  info.numofqueries, info.avgquerylength);
+    had_err = gt_multithread(gt_nre_search_threadfunc, &info, err);
+    for (querynum = 0; !had_err && querynum < info.numofqueries; querynum++) {
+      const GtArrayGtNREHsp *results = info.results + querynum;
+      const GtUword querylength =
+        queries.seqstart.spaceGtUword[querynum + 1] -
+        queries.seqstart.spaceGtUword[querynum];
+      for (idx = 0; idx < results->nextfreeGtNREHsp; idx++) {
+        const GtNREHsp *hsp = results->spaceGtNREHsp + idx;
+        GtUword idlen;
+        const char *id = gt_n_r_encseq_get_orig_id(nres->nre, &idlen,
+                                                   hsp->subject);
+        const double lambdascore = nres->lambda * (double) hsp->score;
+        gt_file_xprintf(outfp,
+                        "%s\t%.*s\t%.2f\t" GT_WU "\t" GT_WU "\t" GT_WU "\t"
+                        GT_WU "\t" GT_WU "\t%g\t%.3f\n",
+                        gt_str_array_get(queries.ids, querynum),
+                        (int) idlen, id,
+                        hsp->similarity,
+                        hsp->alignlength,
+                        hsp->qstart + 1,
+                        hsp->qend + 1,
+                        hsp->sstart + 1,
+                        hsp->send + 1,
+                        (double) querylength *
+                          (double) info.finedblength[querynum] *
+                          exp(-lambdascore),
+                        lambdascore / log(2.0));
+      }
+      *numofhits += results->nextfreeGtNREHsp;
+    }
+    for (querynum = 0; querynum < info.numofqueries; querynum++)
+      GT_FREEARRAY(info.results + querynum, GtNREHsp);
+    gt_free(info.results);
+    gt_free(info.finedblength);
+    gt_mutex_delete(info.mutex);
+  }
+  GT_FREEARRAY(&queries.seqs, GtUchar);
+  GT_FREEARRAY(&queries.seqstart, GtUword);
+  gt_str_array_delete(queries.ids);
+  return had_err;
+}
@@ -0,0 +1,69 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef N_R_ENCSEQ_SEARCH_H
+#define N_R_ENCSEQ_SEARCH_H
+
+#include "core/error_api.h"
+#include "core/file_api.h"
+#include "core/logger_api.h"
+#include "extended/n_r_encseq.h"
+#include "match/xdrop.h"
+
+/* The <GtNREncseqSearch> class implements a seed and extend similarity search
+   of query sequences against a <GtNREncseq>, working like the BLAST based
+   two step search of the condenser: a coarse search against the unique db
+   selects the original sequences to search in the fine step. Seeds are spaced
+   seeds, which are extended in both directions. */
+typedef struct GtNREncseqSearch GtNREncseqSearch;
+
+/* Return a new <GtNREncseqSearch> object for <nre>, building the seed index
+   of the unique db. <seedpattern> is a string over '0' and '1' of which the
+   '1'-positions have to match in a seed, if <NULL> a default for the alphabet
+   of <nre> is used. For DNA seeds are extended by gapped xdrop alignments
+   with <scores>. For protein <scores> are ignored: seeds are extended without
+   gaps using BLOSUM62, as the xdrop alignment only supports uniform match and
+   mismatch scores. Extensions stop <xdropbelow> below the best score.
+   Returns <NULL> and sets <err> if the seed pattern or the scores are not
+   usable. */
+GtNREncseqSearch *gt_n_r_encseq_search_new(const GtNREncseq *nre,
+                                           const char *seedpattern,
+                                           const GtXdropArbitraryscores
+                                                                       *scores,
+                                           GtXdropscore xdropbelow,
+                                           GtLogger *logger,
+                                           GtError *err);
+
+/* Search all sequences of fasta file <querypath> and write the hits of the
+   fine search to <outfp>, one line per hit in the tabular format of the BLAST
+   based search, ordered by query. Hits of the coarse search are kept if
+   their e-value is at most <ceval>, hits of the fine search if their e-value
+   is at most <feval>. If <feval> is <GT_UNDEF_DOUBLE> the fine threshold is
+   calculated from <bitscore> and the length of the searched sequences, like
+   in the BLAST based search. Queries are processed by <gt_jobs> threads.
+   Stores the number of hits in <numofhits>, returns != 0 on error. */
+int               gt_n_r_encseq_search_run(GtNREncseqSearch *nres,
+                                           const char *querypath,
+                                           double ceval,
+                                           double feval,
+                                           GtUword bitscore,
+                                           GtFile *outfp,
+                                           GtUword *numofhits,
+                                           GtError *err);
+
+void              gt_n_r_encseq_search_delete(GtNREncseqSearch *nres);
+
+#endif
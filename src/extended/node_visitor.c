@@ -32,6 +32,7 @@ struct GtNodeVisitorClass {
   GtNodeVisitorRegionNodeFunc region_node;
   GtNodeVisitorSequenceNodeFunc sequence_node;
   GtNodeVisitorEOFNodeFunc eof_node;
+  bool thread_safe;
 };
 
 GtNodeVisitorClass*
@@ -53,6 +54,7 @@ gt_node_visitor_class_new(size_t size,
   c_class->region_node = region_node;
   c_class->sequence_node = sequence_node;
   c_class->eof_node = eof_node;
+  c_class->thread_safe = false;
   return c_class;
 }
 
@@ -64,6 +66,12 @@ void gt_node_visitor_class_set_meta_node_func(GtNodeVisitorClass *nvc,
   nvc->meta_node = meta_node;
 }
 
+void gt_node_visitor_class_set_thread_safe(GtNodeVisitorClass *nvc)
+{
+  gt_assert(nvc);
+  nvc->thread_safe = true;
+}
+
 GtNodeVisitor* gt_node_visitor_create(const GtNodeVisitorClass *nvc)
 {
   GtNodeVisitor *nv;
@@ -80,6 +88,12 @@ void* gt_node_visitor_cast(GT_UNUSED const GtNodeVisitorClass *nvc,
   return nv;
 }
 
+bool gt_node_visitor_is_thread_safe(const GtNodeVisitor *nv)
+{
+  gt_assert(nv && nv->c_class);
+  return nv->c_class->thread_safe;
+}
+
 int gt_node_visitor_visit_comment_node(GtNodeVisitor *nv, GtCommentNode *cn,
                                        GtError *err)
 {
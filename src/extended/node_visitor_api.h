@@ -48,6 +48,9 @@ int   gt_node_visitor_visit_region_node(GtNodeVisitor *node_visitor,
 int   gt_node_visitor_visit_sequence_node(GtNodeVisitor *node_visitor,
                                           GtSequenceNode *sequence_node,
                                           GtError *err);
+/* Returns <true> if <node_visitor> can visit different feature trees
+   concurrently. */
+bool  gt_node_visitor_is_thread_safe(const GtNodeVisitor *node_visitor);
 /* Delete <node_visitor>. */
 void  gt_node_visitor_delete(GtNodeVisitor *node_visitor);
 
@@ -81,6 +84,10 @@ GtNodeVisitorClass* gt_node_visitor_class_new(size_t size,
                                               GtNodeVisitorEOFNodeFunc);
 void gt_node_visitor_class_set_meta_node_func(GtNodeVisitorClass*,
                                               GtNodeVisitorMetaNodeFunc);
+/* Declares that the visitors of class <nvc> can visit different feature trees
+   concurrently, that is, their visitor functions modify neither the visitor
+   nor any other state shared between trees. */
+void gt_node_visitor_class_set_thread_safe(GtNodeVisitorClass *nvc);
 GtNodeVisitor*      gt_node_visitor_create(const GtNodeVisitorClass*);
 void*               gt_node_visitor_cast(const GtNodeVisitorClass*,
                                          GtNodeVisitor*);
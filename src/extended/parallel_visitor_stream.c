@@ -0,0 +1,407 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/array_api.h"
+#include "core/class_alloc_lock.h"
+#include "core/ensure.h"
+#include "core/ma_api.h"
+#include "core/multithread_api.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "extended/array_in_stream_api.h"
+#include "extended/feature_node_api.h"
+#include "extended/genome_node.h"
+#include "extended/parallel_visitor_stream.h"
+
+struct GtParallelVisitorStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+  GtArray **visitors,   /* the visitors of each worker */
+          *owned;       /* every visitor, shared ones only once */
+  unsigned int numofworkers;
+  GtGenomeNode **batch;
+  GtUword batchsize,
+          nofnodes,     /* number of nodes in <batch> */
+          nextnode;     /* the next node of <batch> to be delivered */
+  bool eof;
+};
+
+typedef struct {
+  GtParallelVisitorStream *ps;
+  GtUword nextnode,
+          errnode;      /* the first node for which an error occurred */
+  unsigned int nextworker;
+  GtMutex *mutex;
+  GtError *err;
+} GtParallelVisitorInfo;
+
+#define parallel_visitor_stream_cast(NS)\
+        gt_node_stream_cast(gt_parallel_visitor_stream_class(), NS)
+
+static void* parallel_visitor_stream_thread(void *data)
+{
+  GtParallelVisitorInfo *info = (GtParallelVisitorInfo*) data;
+  GtArray *visitors;
+  GtError *err;
+  unsigned int worker;
+  gt_assert(info);
+
+  gt_mutex_lock(info->mutex);
+  worker = info->nextworker++;
+  gt_mutex_unlock(info->mutex);
+  gt_assert(worker < info->ps->numofworkers);
+  visitors = info->ps->visitors[worker];
+  err = gt_error_new();
+
+  while (true) {
+    GtUword node, i;
+    int had_err = 0;
+    gt_mutex_lock(info->mutex);
+    if (info->nextnode == info->ps->nofnodes || info->nextnode > info->errnode)
+    {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    node = info->nextnode++;
+    gt_mutex_unlock(info->mutex);
+    for (i = 0; !had_err && i < gt_array_size(visitors); i++) {
+      had_err = gt_genome_node_accept(info->ps->batch[node],
+                                      *(GtNodeVisitor**)
+                                      gt_array_get(visitors, i), err);
+    }
+    if (had_err) {
+      /* report the error of the first node, as a sequential run would */
+      gt_mutex_lock(info->mutex);
+      if (node < info->errnode) {
+        info->errnode = node;
+        gt_error_set(info->err, "%s", gt_error_get(err));
+      }
+      gt_mutex_unlock(info->mutex);
+      gt_error_unset(err);
+    }
+  }
+  gt_error_delete(err);
+  return NULL;
+}
+
+static int parallel_visitor_stream_fill_batch(GtParallelVisitorStream *ps,
+                                              GtError *err)
+{
+  GtParallelVisitorInfo info;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(ps->nextnode == ps->nofnodes);
+
+  ps->nofnodes = ps->nextnode = 0;
+  while (!had_err && ps->nofnodes < ps->batchsize) {
+    GtGenomeNode *gn;
+    had_err = gt_node_stream_next(ps->in_stream, &gn, err);
+    if (!had_err) {
+      if (!gn) {
+        ps->eof = true;
+        break;
+      }
+      /* the feature trees of a batch must not share a string, which is
+         referenced by every feature created by a visitor */
+      if (ps->numofworkers > 1U)
+        gt_genome_node_unshare_strings(gn);
+      ps->batch[ps->nofnodes++] = gn;
+    }
+  }
+
+  if (!had_err && ps->nofnodes > 0) {
+    info.ps = ps;
+    info.nextnode = 0;
+    info.errnode = GT_UNDEF_UWORD;
+    info.nextworker = 0;
+    info.mutex = gt_mutex_new();
+    info.err = err;
+    if (gt_multithread(parallel_visitor_stream_thread, &info, err) != 0 ||
+        info.errnode != GT_UNDEF_UWORD) {
+      had_err = -1;
+    }
+    gt_mutex_delete(info.mutex);
+  }
+  return had_err;
+}
+
+static int parallel_visitor_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                        GtError *err)
+{
+  GtParallelVisitorStream *ps;
+  int had_err = 0;
+  gt_error_check(err);
+  ps = parallel_visitor_stream_cast(ns);
+
+  if (ps->nextnode == ps->nofnodes && !ps->eof)
+    had_err = parallel_visitor_stream_fill_batch(ps, err);
+  if (!had_err && ps->nextnode < ps->nofnodes)
+    *gn = ps->batch[ps->nextnode++];
+  else
+    *gn = NULL;
+  return had_err;
+}
+
+static void parallel_visitor_stream_free(GtNodeStream *ns)
+{
+  GtParallelVisitorStream *ps = parallel_visitor_stream_cast(ns);
+  GtUword i;
+  for (i = ps->nextnode; i < ps->nofnodes; i++)
+    gt_genome_node_delete(ps->batch[i]);
+  gt_free(ps->batch);
+  for (i = 0; i < ps->numofworkers; i++)
+    gt_array_delete(ps->visitors[i]);
+  gt_free(ps->visitors);
+  for (i = 0; i < gt_array_size(ps->owned); i++)
+    gt_node_visitor_delete(*(GtNodeVisitor**) gt_array_get(ps->owned, i));
+  gt_array_delete(ps->owned);
+  gt_node_stream_delete(ps->in_stream);
+}
+
+const GtNodeStreamClass* gt_parallel_visitor_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtParallelVisitorStream),
+                                   parallel_visitor_stream_free,
+                                   parallel_visitor_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_parallel_visitor_stream_new(GtNodeStream *in_stream)
+{
+  GtParallelVisitorStream *ps;
+  GtNodeStream *ns;
+  unsigned int i;
+  gt_assert(in_stream);
+  ns = gt_node_stream_create(gt_parallel_visitor_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  ps = parallel_visitor_stream_cast(ns);
+  ps->in_stream = gt_node_stream_ref(in_stream);
+  ps->numofworkers = gt_jobs;
+  ps->visitors = gt_malloc(sizeof (*ps->visitors) * ps->numofworkers);
+  for (i = 0; i < ps->numofworkers; i++)
+    ps->visitors[i] = gt_array_new(sizeof (GtNodeVisitor*));
+  ps->owned = gt_array_new(sizeof (GtNodeVisitor*));
+  ps->batchsize = (GtUword) ps->numofworkers *
+                  GT_PARALLEL_VISITOR_STREAM_NODESPERWORKER;
+  ps->batch = gt_malloc(sizeof (*ps->batch) * ps->batchsize);
+  ps->nofnodes = ps->nextnode = 0;
+  ps->eof = false;
+  return ns;
+}
+
+void gt_parallel_visitor_stream_add_visitor(GtParallelVisitorStream *ps,
+                                            unsigned int worker,
+                                            GtNodeVisitor *nv)
+{
+  gt_assert(ps && nv && worker < ps->numofworkers);
+  gt_assert(!ps->eof && !ps->nofnodes);
+  gt_array_add(ps->visitors[worker], nv);
+  gt_array_add(ps->owned, nv);
+}
+
+void gt_parallel_visitor_stream_add_shared_visitor(GtParallelVisitorStream *ps,
+                                                   GtNodeVisitor *nv)
+{
+  unsigned int i;
+  gt_assert(ps && nv && gt_node_visitor_is_thread_safe(nv));
+  gt_assert(!ps->eof && !ps->nofnodes);
+  for (i = 0; i < ps->numofworkers; i++)
+    gt_array_add(ps->visitors[i], nv);
+  gt_array_add(ps->owned, nv);
+}
+
+/* a visitor for the unit test, which adds an exon to every gene and fails for
+   the genes starting at <failstart> and <failstart> + 50 */
+typedef struct {
+  const GtNodeVisitor parent_instance;
+  GtUword failstart;
+} ParallelVisitorTestVisitor;
+
+static const GtNodeVisitorClass* parallel_visitor_test_visitor_class(void);
+
+#define parallel_visitor_test_visitor_cast(NV)\
+        gt_node_visitor_cast(parallel_visitor_test_visitor_class(), NV)
+
+static int parallel_visitor_test_visitor_feature_node(GtNodeVisitor *nv,
+                                                      GtFeatureNode *fn,
+                                                      GtError *err)
+{
+  ParallelVisitorTestVisitor *v = parallel_visitor_test_visitor_cast(nv);
+  GtGenomeNode *gn = (GtGenomeNode*) fn, *exon;
+  GtUword start = gt_genome_node_get_start(gn);
+  gt_error_check(err);
+  if (start == v->failstart || start == v->failstart + 50) {
+    gt_error_set(err, "gene at " GT_WU " failed", start);
+    return -1;
+  }
+  exon = gt_feature_node_new(gt_genome_node_get_seqid(gn), "exon", start,
+                             start + 4, GT_STRAND_FORWARD);
+  gt_feature_node_add_child(fn, (GtFeatureNode*) exon);
+  gt_feature_node_set_score(fn, (float) start / 2.0f);
+  return 0;
+}
+
+static const GtNodeVisitorClass* parallel_visitor_test_visitor_class(void)
+{
+  static GtNodeVisitorClass *nvc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nvc) {
+    nvc = gt_node_visitor_class_new(sizeof (ParallelVisitorTestVisitor),
+                                    NULL,
+                                    NULL,
+                                    parallel_visitor_test_visitor_feature_node,
+                                    NULL,
+                                    NULL,
+                                    NULL);
+    gt_node_visitor_class_set_thread_safe(nvc);
+  }
+  gt_class_alloc_lock_leave();
+  return nvc;
+}
+
+static GtNodeVisitor* parallel_visitor_test_visitor_new(GtUword failstart)
+{
+  ParallelVisitorTestVisitor *v;
+  GtNodeVisitor *nv;
+  nv = gt_node_visitor_create(parallel_visitor_test_visitor_class());
+  v = parallel_visitor_test_visitor_cast(nv);
+  v->failstart = failstart;
+  return nv;
+}
+
+#define PARALLEL_VISITOR_TEST_NUMOFGENES 300UL
+
+/* Streams the genes 1-10, 11-20, ... sharing one seqid through a
+   <GtParallelVisitorStream> with <jobs> workers and appends the delivered
+   nodes to <out>. The workers share one visitor if <shared> is true. */
+static int parallel_visitor_stream_test_run(unsigned int jobs, bool shared,
+                                            GtUword failstart, GtStr *out,
+                                            GtError *err)
+{
+  GtArray *nodes = gt_array_new(sizeof (GtGenomeNode*));
+  GtStr *seqid = gt_str_new_cstr("seq");
+  GtNodeStream *in_stream, *ps;
+  GtNodeVisitor *nv;
+  GtGenomeNode *gn;
+  GtUword i, numofread = 0;
+  unsigned int savedjobs = gt_jobs;
+  int had_err;
+
+  for (i = 0; i < PARALLEL_VISITOR_TEST_NUMOFGENES; i++) {
+    gn = gt_feature_node_new(seqid, "gene", i * 10 + 1, i * 10 + 10,
+                             GT_STRAND_FORWARD);
+    gt_array_add(nodes, gn);
+  }
+  gt_str_delete(seqid);
+  /* the number of workers is taken from <gt_jobs> */
+  gt_jobs = jobs;
+  in_stream = gt_array_in_stream_new(nodes, &numofread, err);
+  ps = gt_parallel_visitor_stream_new(in_stream);
+  nv = parallel_visitor_test_visitor_new(failstart);
+  if (shared) {
+    gt_parallel_visitor_stream_add_shared_visitor((GtParallelVisitorStream*)
+                                                  ps, nv);
+  }
+  else {
+    gt_parallel_visitor_stream_add_visitor((GtParallelVisitorStream*) ps, 0,
+                                           nv);
+    for (i = 1; i < (GtUword) jobs; i++) {
+      nv = parallel_visitor_test_visitor_new(failstart);
+      gt_parallel_visitor_stream_add_visitor((GtParallelVisitorStream*) ps,
+                                             (unsigned int) i, nv);
+    }
+  }
+  while (!(had_err = gt_node_stream_next(ps, &gn, err)) && gn) {
+    GtFeatureNode *fn = (GtFeatureNode*) gn;
+    gt_str_append_uword(out, gt_genome_node_get_start(gn));
+    gt_str_append_char(out, ':');
+    gt_str_append_double(out, (double) gt_feature_node_get_score(fn), 1);
+    gt_str_append_char(out, ':');
+    gt_str_append_uword(out, gt_feature_node_number_of_children(fn));
+    gt_str_append_char(out, ';');
+    gt_genome_node_delete(gn);
+  }
+  gt_node_stream_delete(ps);
+  gt_node_stream_delete(in_stream);
+  gt_jobs = savedjobs;
+  /* the nodes not read by the stream are still owned by <nodes> */
+  for (i = numofread; i < gt_array_size(nodes); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(nodes, i));
+  gt_array_delete(nodes);
+  return had_err;
+}
+
+int gt_parallel_visitor_stream_unit_test(GtError *err)
+{
+  GtStr *serial = gt_str_new(), *parallel = gt_str_new();
+  GtError *testerr = gt_error_new();
+  int had_err = 0, rval;
+  gt_error_check(err);
+
+  /* the output of several workers equals the one of a single worker */
+  rval = parallel_visitor_stream_test_run(1U, false, GT_UNDEF_UWORD, serial,
+                                          testerr);
+  gt_ensure(rval == 0);
+  gt_ensure(gt_str_length(serial) > 0);
+  gt_ensure(strncmp(gt_str_get(serial), "1:0.5:1;11:5.5:1;", 17) == 0);
+  if (!had_err) {
+    rval = parallel_visitor_stream_test_run(4U, false, GT_UNDEF_UWORD,
+                                            parallel, testerr);
+    gt_ensure(rval == 0);
+    gt_ensure(gt_str_cmp(serial, parallel) == 0);
+  }
+  if (!had_err) {
+    gt_str_reset(parallel);
+    rval = parallel_visitor_stream_test_run(3U, true, GT_UNDEF_UWORD,
+                                            parallel, testerr);
+    gt_ensure(rval == 0);
+    gt_ensure(gt_str_cmp(serial, parallel) == 0);
+  }
+
+  /* the error of the first failing node is reported, all nodes delivered
+     before it are processed */
+  if (!had_err) {
+    gt_str_reset(serial);
+    rval = parallel_visitor_stream_test_run(1U, false, 901, serial, testerr);
+    gt_ensure(rval == -1);
+    gt_ensure(strcmp(gt_error_get(testerr), "gene at 901 failed") == 0);
+    gt_error_unset(testerr);
+  }
+  if (!had_err) {
+    unsigned int jobs;
+    for (jobs = 2U; !had_err && jobs <= 8U; jobs *= 2) {
+      gt_str_reset(parallel);
+      rval = parallel_visitor_stream_test_run(jobs, false, 901, parallel,
+                                              testerr);
+      gt_ensure(rval == -1);
+      gt_ensure(strcmp(gt_error_get(testerr), "gene at 901 failed") == 0);
+      gt_ensure(strncmp(gt_str_get(serial), gt_str_get(parallel),
+                        gt_str_length(parallel)) == 0);
+      gt_error_unset(testerr);
+    }
+  }
+
+  gt_error_delete(testerr);
+  gt_str_delete(parallel);
+  gt_str_delete(serial);
+  return had_err;
+}
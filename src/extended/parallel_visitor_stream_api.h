@@ -0,0 +1,54 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef PARALLEL_VISITOR_STREAM_API_H
+#define PARALLEL_VISITOR_STREAM_API_H
+
+#include "extended/node_stream_api.h"
+#include "extended/node_visitor_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtParallelVisitorStream>
+   applies a chain of visitors to the nodes of its input stream, like a
+   sequence of <GtVisitorStream>s, but processes independent feature trees
+   concurrently. */
+typedef struct GtParallelVisitorStream GtParallelVisitorStream;
+
+/* Create a new <GtParallelVisitorStream*> which reads the nodes of
+   <in_stream> in batches. The feature trees of a batch are processed
+   concurrently by <gt_jobs> workers and delivered in the order of
+   <in_stream>. Each worker applies its chain of visitors to a node in the
+   order in which the visitors were added, the visitors have to be added with
+   <gt_parallel_visitor_stream_add_visitor()> or
+   <gt_parallel_visitor_stream_add_shared_visitor()> before the first node is
+   requested. */
+GtNodeStream* gt_parallel_visitor_stream_new(GtNodeStream *in_stream);
+/* Appends <node_visitor> to the visitors of worker <worker>, which must be
+   smaller than <gt_jobs>. All workers must be given equivalent visitors,
+   which must not share any state modified during a visit (e.g. a
+   <GtRegionMapping>). Takes ownership of <node_visitor>. */
+void          gt_parallel_visitor_stream_add_visitor(
+                                            GtParallelVisitorStream *pvs,
+                                            unsigned int worker,
+                                            GtNodeVisitor *node_visitor);
+/* Appends <node_visitor> to the visitors of all workers, which share it.
+   <node_visitor> must be thread-safe (see
+   <gt_node_visitor_class_set_thread_safe()>). Takes ownership of
+   <node_visitor>. */
+void          gt_parallel_visitor_stream_add_shared_visitor(
+                                            GtParallelVisitorStream *pvs,
+                                            GtNodeVisitor *node_visitor);
+
+#endif
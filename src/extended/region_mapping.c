@@ -27,6 +27,7 @@
 #include "core/md5_seqid.h"
 #include "core/seq_col.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "extended/mapping.h"
 #include "extended/region_mapping_api.h"
@@ -49,6 +50,7 @@ struct GtRegionMapping {
   const char *rawseq;
   GtUword rawlength,
                 rawoffset;
+  GtMutex *mutex; /* serializes the sequence accesses, if not <NULL> */
   unsigned int reference_count;
 };
 
@@ -125,6 +127,13 @@ void gt_region_mapping_enable_match_desc_start(GtRegionMapping *rm)
   rm->matchdescstart = true;
 }
 
+void gt_region_mapping_enable_locking(GtRegionMapping *rm)
+{
+  gt_assert(rm);
+  if (!rm->mutex)
+    rm->mutex = gt_mutex_new();
+}
+
 GtRegionMapping* gt_region_mapping_ref(GtRegionMapping *rm)
 {
   gt_assert(rm);
@@ -210,9 +219,9 @@ static int update_seq_col_if_necessary(GtRegionMapping *rm, GtStr *seqid,
   return had_err;
 }
 
-int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
-                                   GtStr *seqid, GtUword start,
-                                   GtUword end, GtError *err)
+static int region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
+                                       GtStr *seqid, GtUword start,
+                                       GtUword end, GtError *err)
 {
   int had_err = 0;
   GtUword offset = 1;
@@ -347,9 +356,9 @@ int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
   return had_err;
 }
 
-int gt_region_mapping_get_sequence_length(GtRegionMapping *rm,
-                                          GtUword *length, GtStr *seqid,
-                                          GtError *err)
+static int region_mapping_get_sequence_length(GtRegionMapping *rm,
+                                              GtUword *length, GtStr *seqid,
+                                              GtError *err)
 {
   GtUword filenum, seqnum;
   int had_err;
@@ -409,8 +418,8 @@ int gt_region_mapping_get_sequence_length(GtRegionMapping *rm,
   return had_err;
 }
 
-int gt_region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
-                                      GtStr *seqid, GtError *err)
+static int region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
+                                          GtStr *seqid, GtError *err)
 {
   int had_err = 0;
   gt_error_check(err);
@@ -493,11 +502,11 @@ int gt_region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
   return had_err;
 }
 
-const char* gt_region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
-                                                  GtStr *seqid,
-                                                  const GtRange *range,
-                                                  GtUword *offset,
-                                                  GtError *err)
+static const char* region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
+                                                      GtStr *seqid,
+                                                      const GtRange *range,
+                                                      GtUword *offset,
+                                                      GtError *err)
 {
   const char *md5 = NULL;
   int had_err;
@@ -574,6 +583,63 @@ const char* gt_region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
   return md5;
 }
 
+int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
+                                   GtStr *seqid, GtUword start,
+                                   GtUword end, GtError *err)
+{
+  int had_err;
+  gt_assert(rm);
+  if (rm->mutex)
+    gt_mutex_lock(rm->mutex);
+  had_err = region_mapping_get_sequence(rm, seq, seqid, start, end, err);
+  if (rm->mutex)
+    gt_mutex_unlock(rm->mutex);
+  return had_err;
+}
+
+int gt_region_mapping_get_sequence_length(GtRegionMapping *rm,
+                                          GtUword *length, GtStr *seqid,
+                                          GtError *err)
+{
+  int had_err;
+  gt_assert(rm);
+  if (rm->mutex)
+    gt_mutex_lock(rm->mutex);
+  had_err = region_mapping_get_sequence_length(rm, length, seqid, err);
+  if (rm->mutex)
+    gt_mutex_unlock(rm->mutex);
+  return had_err;
+}
+
+int gt_region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
+                                      GtStr *seqid, GtError *err)
+{
+  int had_err;
+  gt_assert(rm);
+  if (rm->mutex)
+    gt_mutex_lock(rm->mutex);
+  had_err = region_mapping_get_description(rm, desc, seqid, err);
+  if (rm->mutex)
+    gt_mutex_unlock(rm->mutex);
+  return had_err;
+}
+
+const char* gt_region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
+                                                  GtStr *seqid,
+                                                  const GtRange *range,
+                                                  GtUword *offset,
+                                                  GtError *err)
+{
+  const char *md5;
+  gt_assert(rm);
+  if (rm->mutex)
+    gt_mutex_lock(rm->mutex);
+  md5 = region_mapping_get_md5_fingerprint(rm, seqid, range, offset, err);
+  if (rm->mutex)
+    gt_mutex_unlock(rm->mutex);
+  return md5;
+}
+
 void gt_region_mapping_delete(GtRegionMapping *rm)
 {
   if (!rm) return;
@@ -589,5 +655,7 @@ void gt_region_mapping_delete(GtRegionMapping *rm)
   gt_encseq_delete(rm->encseq);
   gt_seq_col_delete(rm->seq_col);
   gt_seqid2seqnum_mapping_delete(rm->seqid2seqnum_mapping);
+  if (rm->mutex)
+    gt_mutex_delete(rm->mutex);
   gt_free(rm);
 }
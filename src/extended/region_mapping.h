@@ -27,5 +27,9 @@ GtRegionMapping* gt_region_mapping_new_encseq_seqno(GtEncseq *encseq);
 /* Enables matching only at the beginning of sequence descriptions up to the
    first whitespace */
 void             gt_region_mapping_enable_match_desc_start(GtRegionMapping *rm);
+/* Serializes the sequence accesses of <rm>, such that one region mapping can
+   be shared by visitors running in different threads (its sequence files are
+   then indexed and loaded only once). */
+void             gt_region_mapping_enable_locking(GtRegionMapping *rm);
 
 #endif
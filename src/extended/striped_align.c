@@ -0,0 +1,601 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/chardef.h"
+#include "core/ensure.h"
+#include "core/ma_api.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "extended/striped_align.h"
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#include <emmintrin.h>
+#define GT_STRIPED_ALIGN_SSE2
+/* allows to compile the SSE2 kernels even if the compiler does not generate
+   SSE2 instructions by default, they are only called if the CPU supports
+   them */
+#define STRIPED_ALIGN_SSE2_TARGET __attribute__ ((target ("sse2")))
+#define STRIPED_ALIGN_LANES       8
+#endif
+
+/* smaller than all scores occurring in the scalar kernels */
+#define STRIPED_ALIGN_NEG_INF     (GT_WORD_MIN / 4)
+
+#define STRIPED_ALIGN_CODE(C, ALPHASIZE)\
+        ((C) == (GtUchar) WILDCARD ? (int) (ALPHASIZE) - 1 : (int) (C))
+
+static GtWord striped_align_local_scalar(GtUword *uend, GtUword *vend,
+                                         const GtUchar *u, GtUword ulen,
+                                         unsigned int u_alpha_size,
+                                         const GtUchar *v, GtUword vlen,
+                                         unsigned int v_alpha_size,
+                                         const int **scores,
+                                         int gap_opening_score,
+                                         int deletion_score,
+                                         int insertion_score)
+{
+  GtWord *hcol, *ecol, diag, f, h, maxscore = GT_WORD_MIN;
+  GtUword i, j;
+  int vval;
+
+  /* column <j> of the DP matrix is computed from column <j>-1 in place,
+     <ecol> stores the scores of the alignments ending with an insertion */
+  hcol = gt_malloc(sizeof (*hcol) * 2 * (ulen + 1));
+  ecol = hcol + ulen + 1;
+  for (i = 0; i <= ulen; i++) {
+    hcol[i] = 0;
+    ecol[i] = STRIPED_ALIGN_NEG_INF;
+  }
+  *uend = *vend = 0;
+  for (j = 1; j <= vlen; j++) {
+    vval = STRIPED_ALIGN_CODE(v[j-1], v_alpha_size);
+    diag = 0;
+    f = STRIPED_ALIGN_NEG_INF;
+    for (i = 1; i <= ulen; i++) {
+      ecol[i] = MAX(hcol[i] + gap_opening_score + insertion_score,
+                    ecol[i] + insertion_score);
+      f = MAX(hcol[i-1] + gap_opening_score + deletion_score,
+              f + deletion_score);
+      h = diag + scores[STRIPED_ALIGN_CODE(u[i-1], u_alpha_size)][vval];
+      h = MAX(MAX(h, ecol[i]), MAX(f, 0));
+      diag = hcol[i];
+      hcol[i] = h;
+      if (h > maxscore) {
+        maxscore = h;
+        *uend = i;
+        *vend = j;
+      }
+    }
+  }
+  gt_free(hcol);
+  return maxscore;
+}
+
+static GtUword striped_align_global_scalar(const char *u, GtUword ulen,
+                                           const char *v, GtUword vlen,
+                                           int replacement_cost,
+                                           int gap_opening_cost,
+                                           int gap_extension_cost)
+{
+  GtWord *hcol, *ecol, diag, f, h, cost;
+  GtUword i, j;
+
+  /* the costs are negated, such that the recurrences are the same as for
+     local alignments (without the lower bound 0) */
+  hcol = gt_malloc(sizeof (*hcol) * 2 * (ulen + 1));
+  ecol = hcol + ulen + 1;
+  hcol[0] = 0;
+  for (i = 1; i <= ulen; i++) {
+    hcol[i] = -(gap_opening_cost + (GtWord) i * gap_extension_cost);
+    ecol[i] = STRIPED_ALIGN_NEG_INF;
+  }
+  for (j = 1; j <= vlen; j++) {
+    diag = hcol[0];
+    hcol[0] = -(gap_opening_cost + (GtWord) j * gap_extension_cost);
+    f = STRIPED_ALIGN_NEG_INF;
+    for (i = 1; i <= ulen; i++) {
+      ecol[i] = MAX(hcol[i] - gap_opening_cost - gap_extension_cost,
+                    ecol[i] - gap_extension_cost);
+      f = MAX(hcol[i-1] - gap_opening_cost - gap_extension_cost,
+              f - gap_extension_cost);
+      h = diag - (u[i-1] == v[j-1] ? 0 : replacement_cost);
+      h = MAX(h, MAX(ecol[i], f));
+      diag = hcol[i];
+      hcol[i] = h;
+    }
+  }
+  cost = -hcol[ulen];
+  gt_free(hcol);
+  gt_assert(cost >= 0);
+  return (GtUword) cost;
+}
+
+#ifdef GT_STRIPED_ALIGN_SSE2
+
+/* Returns <numofvectors> vectors aligned to 16 bytes, <*mem> has to be freed
+   with gt_free(). */
+static __m128i* striped_align_vectors_new(void **mem, GtUword numofvectors)
+{
+  *mem = gt_malloc(sizeof (__m128i) * (numofvectors + 1));
+  return (__m128i*) (((uintptr_t) *mem + 15) & ~(uintptr_t) 15);
+}
+
+STRIPED_ALIGN_SSE2_TARGET
+static int16_t striped_align_sse2_hmax(__m128i v)
+{
+  v = _mm_max_epi16(v, _mm_srli_si128(v, 8));
+  v = _mm_max_epi16(v, _mm_srli_si128(v, 4));
+  v = _mm_max_epi16(v, _mm_srli_si128(v, 2));
+  return (int16_t) _mm_extract_epi16(v, 0);
+}
+
+/* Returns the value of the striped column <col> in row <i>. */
+static int16_t striped_align_get(const __m128i *col, GtUword seglen,
+                                 GtUword i)
+{
+  return ((const int16_t*) col)[(i % seglen) * STRIPED_ALIGN_LANES +
+                                i / seglen];
+}
+
+/* The SSE2 kernels store the rows <i> = <lane> * <seglen> + <s> of a column of
+   the DP matrix in lane <lane> of vector <s>. The values from the vertical
+   gaps (F) are first only propagated within the lanes, the following lazy F
+   loop propagates them across the lanes as long as they can improve any
+   score. */
+STRIPED_ALIGN_SSE2_TARGET
+static GtWord striped_align_local_sse2(GtUword *uend, GtUword *vend,
+                                       const GtUchar *u, GtUword ulen,
+                                       unsigned int u_alpha_size,
+                                       const GtUchar *v, GtUword vlen,
+                                       unsigned int v_alpha_size,
+                                       const int **scores,
+                                       int gap_opening_score,
+                                       int deletion_score,
+                                       int insertion_score)
+{
+  const GtUword seglen = (ulen + STRIPED_ALIGN_LANES - 1) /
+                         STRIPED_ALIGN_LANES;
+  const __m128i vzero = _mm_setzero_si128(),
+                vgapo_del = _mm_set1_epi16((short) -(gap_opening_score +
+                                                     deletion_score)),
+                vgape_del = _mm_set1_epi16((short) -deletion_score),
+                vgapo_ins = _mm_set1_epi16((short) -(gap_opening_score +
+                                                     insertion_score)),
+                vgape_ins = _mm_set1_epi16((short) -insertion_score);
+  __m128i *profile, *hstore, *hload, *evec, *hbest, *swap, vh, ve, vf, vmax,
+          vbest;
+  const __m128i *vp;
+  int16_t *p;
+  GtWord best = -1;
+  GtUword i, j, s, bestcol = 0;
+  unsigned int c, lane;
+  void *mem;
+
+  profile = striped_align_vectors_new(&mem, (v_alpha_size + 4) * seglen);
+  hstore = profile + v_alpha_size * seglen;
+  hload = hstore + seglen;
+  evec = hload + seglen;
+  hbest = evec + seglen;
+
+  /* the profile contains for every character <c> of <v> the scores of
+     replacing the characters of <u> by <c> in striped order */
+  p = (int16_t*) profile;
+  for (c = 0; c < v_alpha_size; c++) {
+    for (s = 0; s < seglen; s++) {
+      for (lane = 0; lane < STRIPED_ALIGN_LANES; lane++) {
+        i = lane * seglen + s;
+        *p++ = i < ulen
+               ? (int16_t) scores[STRIPED_ALIGN_CODE(u[i], u_alpha_size)][c]
+               : INT16_MIN;
+      }
+    }
+  }
+  for (s = 0; s < seglen; s++)
+    hstore[s] = evec[s] = vzero;
+  vbest = _mm_set1_epi16((short) best);
+
+  for (j = 0; j < vlen; j++) {
+    vp = profile + STRIPED_ALIGN_CODE(v[j], v_alpha_size) * seglen;
+    vf = vmax = vzero;
+    vh = _mm_slli_si128(hstore[seglen-1], 2);
+    swap = hload;
+    hload = hstore;
+    hstore = swap;
+    for (s = 0; s < seglen; s++) {
+      vh = _mm_adds_epi16(vh, vp[s]);
+      ve = evec[s];
+      vh = _mm_max_epi16(vh, ve);
+      vh = _mm_max_epi16(vh, vf);
+      vh = _mm_max_epi16(vh, vzero);
+      vmax = _mm_max_epi16(vmax, vh);
+      hstore[s] = vh;
+      evec[s] = _mm_max_epi16(_mm_subs_epi16(ve, vgape_ins),
+                              _mm_subs_epi16(vh, vgapo_ins));
+      vf = _mm_max_epi16(_mm_subs_epi16(vf, vgape_del),
+                         _mm_subs_epi16(vh, vgapo_del));
+      vh = hload[s];
+    }
+    vf = _mm_insert_epi16(_mm_slli_si128(vf, 2), INT16_MIN, 0);
+    s = 0;
+    while (_mm_movemask_epi8(_mm_cmpgt_epi16(vf,
+                                             _mm_subs_epi16(hstore[s],
+                                                            vgapo_del)))) {
+      vh = _mm_max_epi16(hstore[s], vf);
+      vmax = _mm_max_epi16(vmax, vh);
+      hstore[s] = vh;
+      evec[s] = _mm_max_epi16(evec[s], _mm_subs_epi16(vh, vgapo_ins));
+      vf = _mm_subs_epi16(vf, vgape_del);
+      if (++s == seglen) {
+        vf = _mm_insert_epi16(_mm_slli_si128(vf, 2), INT16_MIN, 0);
+        s = 0;
+      }
+    }
+    /* the padding rows cannot exceed the maximum of the previous rows, hence
+       the first column containing the maximum is determined correctly */
+    if (_mm_movemask_epi8(_mm_cmpgt_epi16(vmax, vbest))) {
+      best = striped_align_sse2_hmax(vmax);
+      vbest = _mm_set1_epi16((short) best);
+      bestcol = j;
+      memcpy(hbest, hstore, sizeof (*hbest) * seglen);
+    }
+  }
+
+  for (i = 0; i < ulen && striped_align_get(hbest, seglen, i) != best; i++)
+    /* Nothing */;
+  gt_assert(i < ulen);
+  *uend = i + 1;
+  *vend = bestcol + 1;
+  gt_free(mem);
+  return best;
+}
+
+STRIPED_ALIGN_SSE2_TARGET
+static GtUword striped_align_global_sse2(const char *u, GtUword ulen,
+                                         const char *v, GtUword vlen,
+                                         int replacement_cost,
+                                         int gap_opening_cost,
+                                         int gap_extension_cost)
+{
+  const GtUword seglen = (ulen + STRIPED_ALIGN_LANES - 1) /
+                         STRIPED_ALIGN_LANES;
+  const __m128i vneginf = _mm_set1_epi16(INT16_MIN),
+                vgapo = _mm_set1_epi16((short) (gap_opening_cost +
+                                                gap_extension_cost)),
+                vgape = _mm_set1_epi16((short) gap_extension_cost);
+  __m128i *profile, *hstore, *hload, *evec, *swap, vh, ve, vf;
+  const __m128i *vp;
+  int code[UCHAR_MAX+1];
+  unsigned char codechar[UCHAR_MAX+1];
+  int16_t *p;
+  GtUword i, j, s, numofcodes = 0;
+  GtWord cost;
+  unsigned int c, lane;
+  void *mem;
+
+  /* only the characters occurring in <v> get a profile */
+  for (c = 0; c <= UCHAR_MAX; c++)
+    code[c] = -1;
+  for (j = 0; j < vlen; j++) {
+    if (code[(unsigned char) v[j]] == -1) {
+      codechar[numofcodes] = (unsigned char) v[j];
+      code[(unsigned char) v[j]] = (int) numofcodes++;
+    }
+  }
+
+  profile = striped_align_vectors_new(&mem, (numofcodes + 3) * seglen);
+  hstore = profile + numofcodes * seglen;
+  hload = hstore + seglen;
+  evec = hload + seglen;
+
+  p = (int16_t*) profile;
+  for (c = 0; c < numofcodes; c++) {
+    for (s = 0; s < seglen; s++) {
+      for (lane = 0; lane < STRIPED_ALIGN_LANES; lane++) {
+        i = lane * seglen + s;
+        *p++ = (i < ulen && (unsigned char) u[i] == codechar[c])
+               ? 0 : (int16_t) -replacement_cost;
+      }
+    }
+  }
+  p = (int16_t*) hstore;
+  for (s = 0; s < seglen; s++) {
+    for (lane = 0; lane < STRIPED_ALIGN_LANES; lane++) {
+      i = lane * seglen + s;
+      *p++ = i < ulen
+             ? (int16_t) -(gap_opening_cost +
+                           (GtWord) (i + 1) * gap_extension_cost)
+             : INT16_MIN;
+    }
+    evec[s] = vneginf;
+  }
+
+  for (j = 0; j < vlen; j++) {
+    /* the first row of column <j>+1 and the diagonal predecessor of the
+       second row are given by the initialization */
+    vp = profile + code[(unsigned char) v[j]] * seglen;
+    vh = _mm_insert_epi16(_mm_slli_si128(hstore[seglen-1], 2),
+                          j == 0 ? 0 : -(gap_opening_cost +
+                                         (int) j * gap_extension_cost), 0);
+    vf = _mm_insert_epi16(vneginf,
+                          -(2 * gap_opening_cost +
+                            (int) (j + 2) * gap_extension_cost), 0);
+    swap = hload;
+    hload = hstore;
+    hstore = swap;
+    for (s = 0; s < seglen; s++) {
+      vh = _mm_adds_epi16(vh, vp[s]);
+      ve = evec[s];
+      vh = _mm_max_epi16(vh, ve);
+      vh = _mm_max_epi16(vh, vf);
+      hstore[s] = vh;
+      evec[s] = _mm_max_epi16(_mm_subs_epi16(ve, vgape),
+                              _mm_subs_epi16(vh, vgapo));
+      vf = _mm_max_epi16(_mm_subs_epi16(vf, vgape),
+                         _mm_subs_epi16(vh, vgapo));
+      vh = hload[s];
+    }
+    vf = _mm_insert_epi16(_mm_slli_si128(vf, 2), INT16_MIN, 0);
+    s = 0;
+    while (_mm_movemask_epi8(_mm_cmpgt_epi16(vf,
+                                             _mm_subs_epi16(hstore[s],
+                                                            vgapo)))) {
+      vh = _mm_max_epi16(hstore[s], vf);
+      hstore[s] = vh;
+      evec[s] = _mm_max_epi16(evec[s], _mm_subs_epi16(vh, vgapo));
+      vf = _mm_subs_epi16(vf, vgape);
+      if (++s == seglen) {
+        vf = _mm_insert_epi16(_mm_slli_si128(vf, 2), INT16_MIN, 0);
+        s = 0;
+      }
+    }
+  }
+
+  cost = -(GtWord) striped_align_get(hstore, seglen, ulen - 1);
+  gt_free(mem);
+  gt_assert(cost >= 0);
+  return (GtUword) cost;
+}
+
+#endif
+
+bool gt_striped_align_kernel_available(GtStripedAlignKernel kernel)
+{
+  switch (kernel) {
+    case GT_STRIPED_ALIGN_KERNEL_SSE2:
+#ifdef GT_STRIPED_ALIGN_SSE2
+      return __builtin_cpu_supports("sse2") ? true : false;
+#else
+      return false;
+#endif
+    default:
+      return true;
+  }
+}
+
+static GtStripedAlignKernel striped_align_select(GtStripedAlignKernel kernel)
+{
+  if (kernel == GT_STRIPED_ALIGN_KERNEL_AUTO)
+    kernel = GT_STRIPED_ALIGN_KERNEL_SSE2;
+  if (!gt_striped_align_kernel_available(kernel))
+    kernel = GT_STRIPED_ALIGN_KERNEL_SCALAR;
+  return kernel;
+}
+
+const char* gt_striped_align_kernel_name(GtStripedAlignKernel kernel)
+{
+  switch (kernel) {
+    case GT_STRIPED_ALIGN_KERNEL_AUTO:
+      return "auto";
+    case GT_STRIPED_ALIGN_KERNEL_SSE2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
+
+GtStripedAlignKernel gt_striped_align_local_kernel(GtUword ulen,
+                                                   unsigned int u_alpha_size,
+                                                   GtUword vlen,
+                                                   unsigned int v_alpha_size,
+                                                   const int **scores,
+                                                   int gap_opening_score,
+                                                   int deletion_score,
+                                                   int insertion_score,
+                                                   GtStripedAlignKernel kernel)
+{
+  gt_assert(scores);
+  kernel = striped_align_select(kernel);
+  if (kernel == GT_STRIPED_ALIGN_KERNEL_SSE2) {
+    /* the lanes have to hold every score without saturation, which is
+       guaranteed if the maximal local score fits */
+    int maxrepscore = 0;
+    bool fits = gap_opening_score <= 0 && deletion_score <= 0 &&
+                insertion_score <= 0 &&
+                gap_opening_score + deletion_score >= -INT16_MAX &&
+                gap_opening_score + insertion_score >= -INT16_MAX;
+    unsigned int a, b;
+    for (a = 0; fits && a < u_alpha_size; a++) {
+      for (b = 0; fits && b < v_alpha_size; b++) {
+        if (scores[a][b] < -INT16_MAX || scores[a][b] > INT16_MAX)
+          fits = false;
+        else if (scores[a][b] > maxrepscore)
+          maxrepscore = scores[a][b];
+      }
+    }
+    if (!fits || (GtUword) maxrepscore * MIN(ulen, vlen) > INT16_MAX)
+      kernel = GT_STRIPED_ALIGN_KERNEL_SCALAR;
+  }
+  return kernel;
+}
+
+GtStripedAlignKernel gt_striped_align_global_kernel(GtUword ulen, GtUword vlen,
+                                                    int replacement_cost,
+                                                    int gap_opening_cost,
+                                                    int gap_extension_cost,
+                                                    GtStripedAlignKernel kernel)
+{
+  gt_assert(replacement_cost >= 0 && gap_opening_cost >= 0 &&
+            gap_extension_cost >= 0);
+  kernel = striped_align_select(kernel);
+  /* every (negated) cost occurring in the DP is bounded by the cost of
+     aligning the prefixes with two gaps plus the cost of an additional gap
+     and replacement */
+  if (kernel == GT_STRIPED_ALIGN_KERNEL_SSE2 &&
+      (GtUword) 3 * gap_opening_cost + (GtUword) replacement_cost +
+      (ulen + vlen + 1) * (GtUword) gap_extension_cost > INT16_MAX) {
+    kernel = GT_STRIPED_ALIGN_KERNEL_SCALAR;
+  }
+  return kernel;
+}
+
+GtWord gt_striped_align_local(GtUword *uend, GtUword *vend,
+                              const GtUchar *u, GtUword ulen,
+                              unsigned int u_alpha_size,
+                              const GtUchar *v, GtUword vlen,
+                              unsigned int v_alpha_size,
+                              const int **scores, int gap_opening_score,
+                              int deletion_score, int insertion_score,
+                              GtStripedAlignKernel kernel)
+{
+  gt_assert(uend && vend && u && ulen && v && vlen && scores && u_alpha_size
+            && v_alpha_size);
+  kernel = gt_striped_align_local_kernel(ulen, u_alpha_size, vlen,
+                                         v_alpha_size, scores,
+                                         gap_opening_score, deletion_score,
+                                         insertion_score, kernel);
+#ifdef GT_STRIPED_ALIGN_SSE2
+  if (kernel == GT_STRIPED_ALIGN_KERNEL_SSE2) {
+    return striped_align_local_sse2(uend, vend, u, ulen, u_alpha_size, v,
+                                    vlen, v_alpha_size, scores,
+                                    gap_opening_score, deletion_score,
+                                    insertion_score);
+  }
+#endif
+  return striped_align_local_scalar(uend, vend, u, ulen, u_alpha_size, v, vlen,
+                                    v_alpha_size, scores, gap_opening_score,
+                                    deletion_score, insertion_score);
+}
+
+GtUword gt_striped_align_global(const char *u, GtUword ulen,
+                                const char *v, GtUword vlen,
+                                int replacement_cost, int gap_opening_cost,
+                                int gap_extension_cost,
+                                GtStripedAlignKernel kernel)
+{
+  gt_assert(u && ulen && v && vlen);
+  kernel = gt_striped_align_global_kernel(ulen, vlen, replacement_cost,
+                                          gap_opening_cost, gap_extension_cost,
+                                          kernel);
+#ifdef GT_STRIPED_ALIGN_SSE2
+  if (kernel == GT_STRIPED_ALIGN_KERNEL_SSE2) {
+    return striped_align_global_sse2(u, ulen, v, vlen, replacement_cost,
+                                     gap_opening_cost, gap_extension_cost);
+  }
+#endif
+  return striped_align_global_scalar(u, ulen, v, vlen, replacement_cost,
+                                     gap_opening_cost, gap_extension_cost);
+}
+
+int gt_striped_align_unit_test(GtError *err)
+{
+  static const char *dna = "acgt";
+  const int scorerow[5][5] = {{ 2, -1, -1, -1, -1},
+                              {-1,  2, -1, -1, -1},
+                              {-1, -1,  2, -1, -1},
+                              {-1, -1, -1,  2, -1},
+                              {-1, -1, -1, -1, -1}};
+  const int *scores[5];
+  const int gapscores[][3] = {{0, -2, -3}, {-3, -1, -1}, {-2, -1, -2}},
+            gapcosts[][3] = {{1, 0, 1}, {3, 2, 1}, {1, 4, 2}};
+  GtUchar uenc[100], venc[100];
+  char u[100], v[100];
+  GtUword i, ulen, vlen, trial, uend, vend, uend_sse2, vend_sse2;
+  GtWord score, score_sse2;
+  unsigned int k;
+  int had_err = 0;
+  gt_error_check(err);
+
+  for (k = 0; k < 5U; k++)
+    scores[k] = scorerow[k];
+
+  /* u = acgt, v = cg */
+  uenc[0] = 0; uenc[1] = 1; uenc[2] = 2; uenc[3] = 3;
+  venc[0] = 1; venc[1] = 2;
+  score = gt_striped_align_local(&uend, &vend, uenc, 4UL, 5U, venc, 2UL, 5U,
+                                 scores, 0, -2, -2,
+                                 GT_STRIPED_ALIGN_KERNEL_AUTO);
+  gt_ensure(score == 4 && uend == 3UL && vend == 2UL);
+  gt_ensure(gt_striped_align_global("acgt", 4UL, "agt", 3UL, 1, 0, 1,
+                                    GT_STRIPED_ALIGN_KERNEL_AUTO) == 1UL);
+  gt_ensure(gt_striped_align_global("acgt", 4UL, "agt", 3UL, 1, 3, 1,
+                                    GT_STRIPED_ALIGN_KERNEL_AUTO) == 4UL);
+
+  /* the scalar kernel is used if the scores might saturate the lanes */
+  gt_ensure(gt_striped_align_local_kernel(40000UL, 5U, 40000UL, 5U, scores, 0,
+                                          -2, -2,
+                                          GT_STRIPED_ALIGN_KERNEL_SSE2) ==
+            GT_STRIPED_ALIGN_KERNEL_SCALAR);
+  gt_ensure(gt_striped_align_global_kernel(40000UL, 40000UL, 1, 3, 1,
+                                           GT_STRIPED_ALIGN_KERNEL_SSE2) ==
+            GT_STRIPED_ALIGN_KERNEL_SCALAR);
+  if (gt_striped_align_kernel_available(GT_STRIPED_ALIGN_KERNEL_SSE2)) {
+    gt_ensure(gt_striped_align_local_kernel(100UL, 5U, 100UL, 5U, scores, 0,
+                                            -2, -2,
+                                            GT_STRIPED_ALIGN_KERNEL_AUTO) ==
+              GT_STRIPED_ALIGN_KERNEL_SSE2);
+    gt_ensure(gt_striped_align_global_kernel(100UL, 100UL, 1, 3, 1,
+                                             GT_STRIPED_ALIGN_KERNEL_AUTO) ==
+              GT_STRIPED_ALIGN_KERNEL_SSE2);
+  }
+
+  /* the SIMD kernels must compute the same as the scalar ones */
+  for (trial = 0; !had_err && trial < 200UL; trial++) {
+    ulen = 1 + gt_rand_max(99UL);
+    vlen = 1 + gt_rand_max(99UL);
+    for (i = 0; i < ulen; i++) {
+      uenc[i] = gt_rand_max(20UL) ? (GtUchar) gt_rand_max(3UL) : WILDCARD;
+      u[i] = dna[gt_rand_max(3UL)];
+    }
+    for (i = 0; i < vlen; i++) {
+      venc[i] = gt_rand_max(20UL) ? (GtUchar) gt_rand_max(3UL) : WILDCARD;
+      v[i] = dna[gt_rand_max(3UL)];
+    }
+    for (k = 0; !had_err && k < 3U; k++) {
+      score = gt_striped_align_local(&uend, &vend, uenc, ulen, 5U, venc, vlen,
+                                     5U, scores, gapscores[k][0],
+                                     gapscores[k][1], gapscores[k][2],
+                                     GT_STRIPED_ALIGN_KERNEL_SCALAR);
+      score_sse2 = gt_striped_align_local(&uend_sse2, &vend_sse2, uenc, ulen,
+                                          5U, venc, vlen, 5U, scores,
+                                          gapscores[k][0], gapscores[k][1],
+                                          gapscores[k][2],
+                                          GT_STRIPED_ALIGN_KERNEL_SSE2);
+      gt_ensure(score == score_sse2);
+      gt_ensure(uend == uend_sse2 && vend == vend_sse2);
+      gt_ensure(gt_striped_align_global(u, ulen, v, vlen, gapcosts[k][0],
+                                        gapcosts[k][1], gapcosts[k][2],
+                                        GT_STRIPED_ALIGN_KERNEL_SCALAR) ==
+                gt_striped_align_global(u, ulen, v, vlen, gapcosts[k][0],
+                                        gapcosts[k][1], gapcosts[k][2],
+                                        GT_STRIPED_ALIGN_KERNEL_SSE2));
+    }
+  }
+  return had_err;
+}
@@ -0,0 +1,99 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef STRIPED_ALIGN_H
+#define STRIPED_ALIGN_H
+
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* The striped alignment module computes the scores of optimal local and
+   global alignments with affine gap costs in the striped layout of
+   Farrar (Bioinformatics 23(2):156-161, 2007): The positions of the first
+   sequence are distributed over the 16 bit lanes of SIMD registers, such that
+   a whole column of the dynamic programming matrix is computed with
+   (length of first sequence / number of lanes) vector operations.
+   Only the score is computed, an optimal alignment can be obtained by
+   tracing back in the (usually small) part of the matrix determined by the
+   end coordinates of a local alignment. */
+
+typedef enum {
+  GT_STRIPED_ALIGN_KERNEL_AUTO,  /* select the fastest kernel at runtime */
+  GT_STRIPED_ALIGN_KERNEL_SCALAR,
+  GT_STRIPED_ALIGN_KERNEL_SSE2
+} GtStripedAlignKernel;
+
+/* Returns true if <kernel> can be used on the CPU of this machine. */
+bool         gt_striped_align_kernel_available(GtStripedAlignKernel kernel);
+/* Returns the name of <kernel>. */
+const char*  gt_striped_align_kernel_name(GtStripedAlignKernel kernel);
+
+/* Returns the maximal score of a local alignment of <u> and <v>, which are
+   encoded over alphabets of size <u_alpha_size> and <v_alpha_size>
+   (<WILDCARD> is mapped to the last character of the alphabet), using the
+   replacement scores <scores>. A gap of length k in <v> scores
+   <gap_opening_score> + k * <deletion_score>, a gap of length k in <u> scores
+   <gap_opening_score> + k * <insertion_score>. The end of the first optimal
+   alignment in column-major order (that is, with the smallest end in <v> and
+   then the smallest end in <u>) is stored in <uend> and <vend>, counting from
+   1. <kernel> is only a hint, the scalar kernel is used if the SIMD kernel is
+   not available or the scores might exceed the range of its lanes. */
+/* Returns the kernel <gt_striped_align_local()> uses if it is called with the
+   given arguments. This is never <GT_STRIPED_ALIGN_KERNEL_AUTO>. */
+GtStripedAlignKernel gt_striped_align_local_kernel(GtUword ulen,
+                                                   unsigned int u_alpha_size,
+                                                   GtUword vlen,
+                                                   unsigned int v_alpha_size,
+                                                   const int **scores,
+                                                   int gap_opening_score,
+                                                   int deletion_score,
+                                                   int insertion_score,
+                                                   GtStripedAlignKernel
+                                                   kernel);
+
+GtWord       gt_striped_align_local(GtUword *uend, GtUword *vend,
+                                    const GtUchar *u, GtUword ulen,
+                                    unsigned int u_alpha_size,
+                                    const GtUchar *v, GtUword vlen,
+                                    unsigned int v_alpha_size,
+                                    const int **scores, int gap_opening_score,
+                                    int deletion_score, int insertion_score,
+                                    GtStripedAlignKernel kernel);
+
+/* Returns the minimal cost of a global alignment of <u> and <v>, where a
+   mismatch costs <replacement_cost> and a gap of length k costs
+   <gap_opening_cost> + k * <gap_extension_cost>. <kernel> is only a hint (see
+   above). */
+/* Returns the kernel <gt_striped_align_global()> uses if it is called with
+   the given arguments. This is never <GT_STRIPED_ALIGN_KERNEL_AUTO>. */
+GtStripedAlignKernel gt_striped_align_global_kernel(GtUword ulen,
+                                                    GtUword vlen,
+                                                    int replacement_cost,
+                                                    int gap_opening_cost,
+                                                    int gap_extension_cost,
+                                                    GtStripedAlignKernel
+                                                    kernel);
+
+GtUword      gt_striped_align_global(const char *u, GtUword ulen,
+                                     const char *v, GtUword vlen,
+                                     int replacement_cost,
+                                     int gap_opening_cost,
+                                     int gap_extension_cost,
+                                     GtStripedAlignKernel kernel);
+
+int          gt_striped_align_unit_test(GtError *err);
+
+#endif
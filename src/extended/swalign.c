@@ -21,6 +21,7 @@
 #include "core/chardef.h"
 #include "core/minmax.h"
 #include "core/undef_api.h"
+#include "extended/striped_align.h"
 #include "extended/swalign.h"
 
 typedef struct {
@@ -113,18 +114,28 @@ static GtAlignment* smith_waterman_align(const char *u_orig,
   gt_assert(u_orig && v_orig && u_enc && v_enc && u_len && v_len && scores
             && u_alpha && v_alpha);
   Coordinate alignment_start,
-             alignment_end = { GT_UNDEF_UWORD, GT_UNDEF_UWORD };
+             alignment_end = { GT_UNDEF_UWORD, GT_UNDEF_UWORD },
+             table_end = { GT_UNDEF_UWORD, GT_UNDEF_UWORD };
   GtRange urange, vrange;
   DPentry **dptable;
   GtAlignment *a = NULL;
-  gt_array2dim_calloc(dptable, u_len+1, v_len+1);
-  swalign_fill_table(dptable, u_enc, u_len, v_enc, v_len, scores,
-                     deletion_score, insertion_score, &alignment_end,
-                     gt_alphabet_size(u_alpha), gt_alphabet_size(v_alpha));
-  gt_assert(alignment_end.x != GT_UNDEF_UWORD);
-  gt_assert(alignment_end.y != GT_UNDEF_UWORD);
-  if (dptable[alignment_end.x][alignment_end.y].score) {
-    /* construct only an alignment if a (positive) score was computed */
+  /* determine the score and the end of the alignment with the (vectorized)
+     score-only kernel first */
+  if (gt_striped_align_local(&alignment_end.x, &alignment_end.y, u_enc, u_len,
+                             gt_alphabet_size(u_alpha), v_enc, v_len,
+                             gt_alphabet_size(v_alpha), scores, 0,
+                             deletion_score, insertion_score,
+                             GT_STRIPED_ALIGN_KERNEL_AUTO) > 0) {
+    /* construct only an alignment if a (positive) score was computed. The
+       cells up to the end of the alignment do not depend on the remaining
+       ones, hence only this part of the table is needed for the traceback */
+    gt_array2dim_calloc(dptable, alignment_end.x+1, alignment_end.y+1);
+    swalign_fill_table(dptable, u_enc, alignment_end.x, v_enc,
+                       alignment_end.y, scores, deletion_score,
+                       insertion_score, &table_end, gt_alphabet_size(u_alpha),
+                       gt_alphabet_size(v_alpha));
+    gt_assert(table_end.x == alignment_end.x);
+    gt_assert(table_end.y == alignment_end.y);
     a = gt_alignment_new();
     alignment_start = traceback(a, dptable, alignment_end.x, alignment_end.y);
     /* transform the positions in the DP matrix to sequence positions */
@@ -140,8 +151,8 @@ static GtAlignment* smith_waterman_align(const char *u_orig,
                           alignment_end.y - alignment_start.y + 1);
     gt_alignment_set_urange(a, urange);
     gt_alignment_set_vrange(a, vrange);
+    gt_array2dim_delete(dptable);
   }
-  gt_array2dim_delete(dptable);
   return a;
 }
 
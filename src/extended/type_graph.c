@@ -21,6 +21,7 @@
 #include "core/hashmap_api.h"
 #include "core/ma_api.h"
 #include "core/symbol_api.h"
+#include "core/thread_api.h"
 #include "extended/type_graph.h"
 #include "extended/type_node.h"
 
@@ -36,6 +37,8 @@ struct GtTypeGraph {
   GtBoolMatrix *part_of_out_edges,
                *part_of_in_edges;
   bool ready;
+  GtMutex *mutex; /* the graph is built and its nodes cache the results of
+                     queries on demand */
 };
 
 GtTypeGraph* gt_type_graph_new(void)
@@ -48,6 +51,7 @@ GtTypeGraph* gt_type_graph_new(void)
   type_graph->part_of_out_edges = gt_bool_matrix_new();
   type_graph->part_of_in_edges = gt_bool_matrix_new();
   type_graph->ready = false;
+  type_graph->mutex = gt_mutex_new();
   return type_graph;
 }
 
@@ -63,6 +67,7 @@ void gt_type_graph_delete(GtTypeGraph *type_graph)
   gt_hashmap_delete(type_graph->nodemap);
   gt_hashmap_delete(type_graph->id2name);
   gt_hashmap_delete(type_graph->name2id);
+  gt_mutex_delete(type_graph->mutex);
   gt_free(type_graph);
 }
 
@@ -161,7 +166,9 @@ bool gt_type_graph_is_partof(GtTypeGraph *type_graph, const char *parent_type,
 {
   const char *parent_id, *child_id;
   GtTypeNode *parent_node, *child_node;
+  bool is_partof;
   gt_assert(type_graph && parent_type && child_type);
+  gt_mutex_lock(type_graph->mutex);
   /* make sure graph is built */
   if (!type_graph->ready) {
     create_vertices(type_graph);
@@ -180,10 +187,13 @@ bool gt_type_graph_is_partof(GtTypeGraph *type_graph, const char *parent_type,
   child_node = gt_hashmap_get(type_graph->nodemap, child_id);
   gt_assert(child_node);
   /* check for parent */
-  return gt_type_node_has_parent(child_node, parent_node,
-                                 type_graph->part_of_out_edges,
-                                 type_graph->part_of_in_edges,
-                                 type_graph->nodes, type_graph->id2name, 0);
+  is_partof = gt_type_node_has_parent(child_node, parent_node,
+                                      type_graph->part_of_out_edges,
+                                      type_graph->part_of_in_edges,
+                                      type_graph->nodes, type_graph->id2name,
+                                      0);
+  gt_mutex_unlock(type_graph->mutex);
+  return is_partof;
 }
 
 bool gt_type_graph_is_a(GtTypeGraph *type_graph, const char *parent_type,
@@ -191,7 +201,9 @@ bool gt_type_graph_is_a(GtTypeGraph *type_graph, const char *parent_type,
 {
   const char *parent_id, *child_id;
   GtTypeNode *child_node;
+  bool is_a;
   gt_assert(type_graph && parent_type && child_type);
+  gt_mutex_lock(type_graph->mutex);
   /* make sure graph is built */
   if (!type_graph->ready) {
     create_vertices(type_graph);
@@ -207,5 +219,7 @@ bool gt_type_graph_is_a(GtTypeGraph *type_graph, const char *parent_type,
   child_node = gt_hashmap_get(type_graph->nodemap, child_id);
   gt_assert(child_node);
   /* check for parent */
-  return gt_type_node_is_a(child_node, parent_id);
+  is_a = gt_type_node_is_a(child_node, parent_id);
+  gt_mutex_unlock(type_graph->mutex);
+  return is_a;
 }
@@ -97,6 +97,7 @@ extern "C" {
 #include "extended/add_introns_stream_api.h"
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/anno_db_schema_api.h"
+#include "extended/async_stream_api.h"
 #include "extended/array_in_stream_api.h"
 #include "extended/array_out_stream_api.h"
 #include "extended/bed_in_stream_api.h"
@@ -106,6 +107,7 @@ extern "C" {
 #include "extended/eof_node_api.h"
 #include "extended/extract_feature_stream_api.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_binary_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_in_stream_api.h"
 #include "extended/feature_node_api.h"
@@ -116,6 +118,7 @@ extern "C" {
 #include "extended/gff3_in_stream_api.h"
 #include "extended/gff3_out_stream_api.h"
 #include "extended/gff3_parser_api.h"
+#include "extended/gff3_partition_stream_api.h"
 #include "extended/gff3_visitor_api.h"
 #include "extended/gtf_in_stream_api.h"
 #include "extended/id_to_md5_stream_api.h"
@@ -133,6 +136,7 @@ extern "C" {
 #include "extended/node_stream_api.h"
 #include "extended/node_visitor_api.h"
 #include "extended/orf_iterator_api.h"
+#include "extended/parallel_visitor_stream_api.h"
 #include "extended/rdb_api.h"
 #include "extended/rdb_sqlite_api.h"
 #ifdef HAVE_MYSQL
@@ -16,8 +16,12 @@
 */
 
 #include <math.h>
+#include <string.h>
 #include "core/divmodmul.h"
+#include "core/ensure.h"
+#include "core/minmax.h"
 #include "core/safearith.h"
+#include "core/timer_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "gth/align_dna_imp.h"
@@ -46,16 +50,137 @@ static const char* dna_showretracenames(DnaRetrace retrace)
   return dna_retracenames[retrace];
 }
 
-/* the following function allocates space for the DP tables for cDNAs/ESTs */
+/* If the backtrace table would exceed the maximal matrix size, the genomic
+   rows are divided into segments of <segmentlength> rows and only the rows of
+   one segment are stored in <pathsegment>. In the first evaluation of the DP
+   tables the last score row of every segment is saved as a checkpoint. During
+   the backtracing the segment a row belongs to is recomputed from the
+   checkpoint of the preceding segment. This reduces the space requirement from
+   O(n*m) to O(sqrt(n)*m) at the expense of evaluating the DP tables about
+   twice. */
+struct GthDPCheckpoints {
+  GtUword segmentlength,   /* number of rows of a segment, always even */
+          segmentstart,    /* first row of the segment in <pathsegment> */
+          numofcheckpoints;
+  GthPath *pathsegment;
+  GthFlt *escore,          /* checkpoint k contains the row */
+         *iscore;          /* (k+1) * segmentlength - 1 */
+  GtUword *exonstart,
+          *intronstart;
+  /* the parameters of the DP, necessary for the recomputation */
+  const unsigned char *gen_seq_tran,
+                      *ref_seq_tran;
+  GtAlphabet *gen_alphabet;
+  GthDPParam *dp_param;
+  GthDPOptionsEST *dp_options_est;
+  GthDPOptionsCore *dp_options_core;
+};
+
+#define DNA_CHECKPOINTSIZE  (2 * sizeof (GthFlt) + 2 * sizeof (GtUword))
+
+/* the following function lets the rows of the backtrace table which belong to
+   the segment starting at <segmentstart> point into the segment buffer */
+static void dna_checkpoints_set_segment(GthDPMatrix *dpm,
+                                        GtUword segmentstart)
+{
+  GthDPCheckpoints *cp = dpm->checkpoints;
+  GtUword p, firstpair, lastpair;
+
+  gt_assert(cp && !GT_MOD2(segmentstart));
+  if (cp->segmentstart != GT_UNDEF_UWORD) {
+    firstpair = GT_DIV2(cp->segmentstart);
+    lastpair = MIN(firstpair + GT_DIV2(cp->segmentlength) - 1,
+                   GT_DIV2(dpm->gen_dp_length));
+    for (p = firstpair; p <= lastpair; p++)
+      dpm->path[p] = NULL;
+  }
+  firstpair = GT_DIV2(segmentstart);
+  lastpair = MIN(firstpair + GT_DIV2(cp->segmentlength) - 1,
+                 GT_DIV2(dpm->gen_dp_length));
+  for (p = firstpair; p <= lastpair; p++) {
+    dpm->path[p] = cp->pathsegment + (p - firstpair) *
+                   (dpm->ref_dp_length + 1);
+  }
+  cp->segmentstart = segmentstart;
+}
+
+static GthDPCheckpoints* dna_checkpoints_new(GthDPMatrix *dpm,
+                                             GtUword segmentlength,
+                                             GtUword numofcheckpoints)
+{
+  GthDPCheckpoints *cp;
+  GtUword rowsize = dpm->ref_dp_length + 1;
+
+  cp = gt_calloc(1, sizeof *cp);
+  cp->segmentlength = segmentlength;
+  cp->segmentstart = GT_UNDEF_UWORD;
+  cp->numofcheckpoints = numofcheckpoints;
+  cp->pathsegment = gt_malloc(sizeof (GthPath) * GT_DIV2(segmentlength) *
+                              rowsize);
+  cp->escore = gt_malloc(sizeof (GthFlt) * numofcheckpoints * rowsize);
+  cp->iscore = gt_malloc(sizeof (GthFlt) * numofcheckpoints * rowsize);
+  cp->exonstart = gt_malloc(sizeof (GtUword) * numofcheckpoints * rowsize);
+  cp->intronstart = gt_malloc(sizeof (GtUword) * numofcheckpoints * rowsize);
+  return cp;
+}
+
+static void dna_checkpoints_delete(GthDPCheckpoints *cp)
+{
+  if (!cp) return;
+  gt_free(cp->intronstart);
+  gt_free(cp->exonstart);
+  gt_free(cp->iscore);
+  gt_free(cp->escore);
+  gt_free(cp->pathsegment);
+  gt_free(cp);
+}
+
+/* the following function initializes the first row of the DP tables */
+static void dp_matrix_init_first_row(GthDPMatrix *dpm)
+{
+  GtUword n, m;
+
+  dpm->path[0][0]  = DNA_E_NM;
+  dpm->path[0][0] |= I_STATE_E_N;
+  for (m = 1; m <= dpm->ref_dp_length; m++) {
+    dpm->path[0][m]  = DNA_E_M;
+    dpm->path[0][m] |= I_STATE_I_N;
+  }
+
+  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+    dpm->score[DNA_E_STATE][n][0] = 0.0;
+    dpm->score[DNA_I_STATE][n][0] = 0.0;
+
+    for (m = 1; m <= dpm->ref_dp_length; m++) {
+      dpm->score[DNA_E_STATE][n][m] = (GthFlt) 0.0;
+      /* disallow intron status for 5' non-matching cDNA letters: */
+      dpm->score[DNA_I_STATE][n][m] = (GthFlt) GTH_MINUSINFINITY;
+    }
+
+    memset(dpm->intronstart[n], 0,
+           sizeof *dpm->intronstart[n] * (dpm->ref_dp_length + 1));
+    memset(dpm->exonstart[n], 0,
+           sizeof *dpm->exonstart[n] * (dpm->ref_dp_length + 1));
+  }
+}
+
+/* the following function allocates space for the DP tables for cDNAs/ESTs.
+   If <maxmatrixsize> is > 0 and the backtrace table would be larger than
+   <maxmatrixsize> megabytes, it is computed with checkpoints. */
 static int dp_matrix_init(GthDPMatrix *dpm,
                           GtUword gen_dp_length,
                           GtUword ref_dp_length,
                           GtUword autoicmaxmatrixsize,
+                          GtUword maxmatrixsize,
                           bool introncutout,
                           GthJumpTable *jump_table,
                           GthStat *stat)
 {
-  GtUword t, n, m, matrixsize, sizeofpathtype =  sizeof (GthPath);
+  GtUword t, n, matrixsize, allocatedsize, segmentlength = 0,
+          numofcheckpoints = 0, sizeofpathtype =  sizeof (GthPath);
+  /* the memory bounds in bytes, they can exceed a 32-bit word */
+  GtUint64 maxbytes = (GtUint64) maxmatrixsize << 20,
+           autoicmaxbytes = (GtUint64) autoicmaxmatrixsize << 20;
 
   /* XXX: adjust this check for QUARTER_MATRIX case */
   if (DNA_NUMOFSTATES * sizeofpathtype * (gen_dp_length + 1) >=
@@ -68,19 +193,55 @@ static int dp_matrix_init(GthDPMatrix *dpm,
   matrixsize = gt_safe_mult_ulong((GT_DIV2(gen_dp_length + 1) +
                                    GT_MOD2(gen_dp_length + 1)),
                                    ref_dp_length + 1);
+  allocatedsize = sizeofpathtype * matrixsize;
+
+  if (maxmatrixsize > 0 && !jump_table &&
+      (GtUint64) allocatedsize > maxbytes) {
+    /* the segment length which minimizes the size of the segment buffer plus
+       the size of the checkpoints */
+    segmentlength = (GtUword) sqrt(2.0 * (gen_dp_length + 1) *
+                                   DNA_CHECKPOINTSIZE / sizeofpathtype);
+    segmentlength += GT_MOD2(segmentlength);
+    if (segmentlength < 2)
+      segmentlength = 2;
+    numofcheckpoints = gen_dp_length / segmentlength;
+    if (numofcheckpoints) {
+      allocatedsize = (sizeofpathtype * GT_DIV2(segmentlength) +
+                       DNA_CHECKPOINTSIZE * numofcheckpoints) *
+                      (ref_dp_length + 1);
+    }
+    /* without a checkpoint (the optimal segment covers all rows) the genomic
+       sequence is so short that a checkpoint row would take more space than
+       the backtrace rows it saves, i.e., checkpoints cannot help */
+    if (!numofcheckpoints || (GtUint64) allocatedsize > maxbytes) {
+      /* the matrix does not fit into the memory bound even with
+         checkpoints */
+      return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
+    }
+  }
 
   if (!introncutout && autoicmaxmatrixsize > 0) {
     /* in this case the automatic intron cutout technique is enabled
        check if allocated matrix would be larger as specified maximal
        matrix size. If so, return matrix allocation error */
-    if (sizeofpathtype * matrixsize * DNA_NUMOFSTATES >
-        autoicmaxmatrixsize << 20) {
+    if ((GtUint64) allocatedsize * DNA_NUMOFSTATES > autoicmaxbytes)
       return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
-    }
   }
 
+  dpm->gen_dp_length = gen_dp_length;
+  dpm->ref_dp_length = ref_dp_length;
+  dpm->checkpoints = NULL;
+
   /* allocate space for dpm->path */
-  if (jump_table) {
+  if (numofcheckpoints) {
+    /* only the rows of one segment are stored at a time */
+    dpm->path = gt_calloc(GT_DIV2(gen_dp_length + 1) +
+                          GT_MOD2(gen_dp_length + 1), sizeof *dpm->path);
+    dpm->checkpoints = dna_checkpoints_new(dpm, segmentlength,
+                                           numofcheckpoints);
+    dna_checkpoints_set_segment(dpm, 0);
+  }
+  else if (jump_table) {
     gth_array2dim_plain_calloc(dpm->path,
                                GT_DIV2(gen_dp_length + 1) +
                                GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
@@ -103,36 +264,21 @@ static int dp_matrix_init(GthDPMatrix *dpm,
 
   /* allocating space for intronstart and exonstart */
   for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-    dpm->intronstart[n] = gt_calloc(ref_dp_length + 1,
-                                    sizeof *dpm->intronstart);
-    dpm->exonstart[n] = gt_calloc(ref_dp_length + 1, sizeof *dpm->exonstart);
+    dpm->intronstart[n] = gt_malloc(sizeof *dpm->intronstart[n] *
+                                    (ref_dp_length + 1));
+    dpm->exonstart[n] = gt_malloc(sizeof *dpm->exonstart[n] *
+                                  (ref_dp_length + 1));
   }
 
   /* initialize the DP matrices */
-  dpm->path[0][0]  = DNA_E_NM;
-  dpm->path[0][0] |= I_STATE_E_N;
-  for (m = 1; m <= ref_dp_length; m++) {
-    dpm->path[0][m]  = DNA_E_M;
-    dpm->path[0][m] |= I_STATE_I_N;
-  }
-
-  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-    dpm->score[DNA_E_STATE][n][0] = 0.0;
-    dpm->score[DNA_I_STATE][n][0] = 0.0;
-
-    for (m = 1; m <= ref_dp_length; m++) {
-      dpm->score[DNA_E_STATE][n][m] = (GthFlt) 0.0;
-      /* disallow intron status for 5' non-matching cDNA letters: */
-      dpm->score[DNA_I_STATE][n][m] = (GthFlt) GTH_MINUSINFINITY;
-    }
-  }
-  dpm->gen_dp_length = gen_dp_length;
-  dpm->ref_dp_length = ref_dp_length;
+  dp_matrix_init_first_row(dpm);
 
   /* statistics */
   gth_stat_increment_numofbacktracematrixallocations(stat);
+  if (dpm->checkpoints)
+    gth_stat_increment_numofcheckpointedbacktracematrices(stat);
   gth_stat_increase_totalsizeofbacktracematricesinMB(stat,
-                                           (sizeofpathtype * matrixsize) >> 20);
+                                                     allocatedsize >> 20);
 
   return 0;
 }
@@ -275,28 +421,37 @@ static void I_1m(GthDPMatrix *dpm, GtUword m, GthDbl log_1minusprobies)
   }
 }
 
-/* the following function evaluate the dynamic programming tables */
-static void dna_complete_path_matrix(GthDPMatrix *dpm,
-                                     const unsigned char *gen_seq_tran,
-                                     const unsigned char *ref_seq_tran,
-                                     GtUword genomic_offset,
-                                     GtAlphabet *gen_alphabet,
-                                     GthDPParam *dp_param,
-                                     GthDPOptionsEST *dp_options_est,
-                                     GthDPOptionsCore *dp_options_core)
+/* the following function evaluates the dynamic programming tables for the
+   genomic rows after <genomic_offset> up to row <genomic_end> */
+static void dna_complete_path_rows(GthDPMatrix *dpm,
+                                   const unsigned char *gen_seq_tran,
+                                   const unsigned char *ref_seq_tran,
+                                   GtUword genomic_offset,
+                                   GtUword genomic_end,
+                                   GtAlphabet *gen_alphabet,
+                                   GthDPParam *dp_param,
+                                   GthDPOptionsEST *dp_options_est,
+                                   GthDPOptionsCore *dp_options_core)
 {
   GthFlt value, maxvalue;
-  GthPath retrace;
-  GtUword n, m, modn, modnminus1;
-  GthDbl rval, outputweight, **outputweights,
+  GthPath retrace, *path;
+  GtUword n, m, modn, modnminus1, *exonstart, *intronstart;
+  const GtUword ref_dp_length = dpm->ref_dp_length,
+                gen_dp_length = dpm->gen_dp_length,
+                *exonstart_prev, *intronstart_prev;
+  GthDbl rval, **outputweights, *matchweights[UCHAR_MAX+1] = { NULL },
+         *deletionweights, *halfweights, dashweight, nodonor, acceptor,
          log_probies,          /* initial exon state probability */
          log_1minusprobies;    /* initial intron state probability */
+  const GthDbl *genweights;
   GthFlt log_probdelgen,       /* deletion in genomic sequence */
-         log_1minusprobdelgen;
+         log_1minusprobdelgen, donor, noacceptor, endacceptor, *escore,
+         *iscore;
+  const GthFlt *escore_prev, *iscore_prev;
   unsigned char genomicchar, referencechar;
   unsigned int gen_alphabet_mapsize = gt_alphabet_size(gen_alphabet);
 
-  gt_assert(dpm->gen_dp_length > 1);
+  gt_assert(dpm->gen_dp_length > 1 && genomic_end <= dpm->gen_dp_length);
 
   log_probies = (GthDbl) log((double) dp_options_est->probies);
   log_1minusprobies = (GthDbl) log(1.0 - dp_options_est->probies);
@@ -312,6 +467,18 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
     }
   }
 
+  /* precompute the weights along the cDNA/EST sequence: deletions in the
+     genomic sequence and the decreased identities in the border windows.
+     The weights of the genomic characters are computed on demand and kept in
+     <matchweights>. */
+  deletionweights = gt_malloc(sizeof (GthDbl) * (ref_dp_length + 1));
+  halfweights = gt_malloc(sizeof (GthDbl) * (ref_dp_length + 1));
+  for (m = 1; m <= ref_dp_length; m++) {
+    referencechar = ref_seq_tran[m-1];
+    deletionweights[m] = outputweights[DASH][referencechar];
+    halfweights[m] = (0.0 + outputweights[referencechar][referencechar]) / 2.0;
+  }
+
   if (!genomic_offset) {
     /* handle case for n equals 1 */
     dpm->path[0][0] |= UPPER_E_N;
@@ -332,7 +499,7 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
   else
     n = 2;
 
-  for (; n <= dpm->gen_dp_length; n++) {
+  for (; n <= genomic_end; n++) {
     modn = GT_MOD2(n);
     modnminus1 = GT_MOD2(n-1);
     genomicchar = gen_seq_tran[n-1];
@@ -346,108 +513,125 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
       dpm->path[GT_DIV2(n)][0] |= I_STATE_I_N;
     }
 
-    /* stepping along the cDNA/EST sequence */
-    for (m = 1; m <= dpm->ref_dp_length; m++) {
-      referencechar = ref_seq_tran[m-1];
+    if (!matchweights[genomicchar]) {
+      matchweights[genomicchar] = gt_malloc(sizeof (GthDbl) *
+                                            (ref_dp_length + 1));
+      for (m = 1; m <= ref_dp_length; m++) {
+        matchweights[genomicchar][m] =
+          outputweights[genomicchar][ref_seq_tran[m-1]];
+      }
+    }
 
+    /* the rows of the tables and the values which are constant in a row are
+       fetched once, the stores into the tables would otherwise force the
+       compiler to reload them for every cell */
+    genweights = matchweights[genomicchar];
+    dashweight = outputweights[genomicchar][DASH];
+    escore = dpm->score[DNA_E_STATE][modn];
+    iscore = dpm->score[DNA_I_STATE][modn];
+    escore_prev = dpm->score[DNA_E_STATE][modnminus1];
+    iscore_prev = dpm->score[DNA_I_STATE][modnminus1];
+    exonstart = dpm->exonstart[modn];
+    intronstart = dpm->intronstart[modn];
+    exonstart_prev = dpm->exonstart[modnminus1];
+    intronstart_prev = dpm->intronstart[modnminus1];
+    path = dpm->path[GT_DIV2(n)];
+    nodonor = (GthDbl) (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
+    acceptor = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
+    donor = log_1minusprobdelgen + dp_param->log_Pdonor[n-1];
+    noacceptor = dp_param->log_1minusPacceptor[n-2];
+    endacceptor = dp_param->log_Pacceptor[n-1] + log_probdelgen;
+
+    /* stepping along the cDNA/EST sequence */
+    for (m = 1; m <= ref_dp_length; m++) {
       /* evaluate E_nm */
 
       /* 0. */
-      outputweight = 0.0;
-      rval = (GthDbl) (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
-      rval += outputweights[genomicchar][referencechar];
+      rval = nodonor;
+      rval += genweights[m];
       if ((m < dp_options_est->wdecreasedoutput ||
-           m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
-           genomicchar == referencechar) {
-        outputweight += outputweights[genomicchar][referencechar];
-        rval -= (outputweight / 2.0);
+           m > ref_dp_length - dp_options_est->wdecreasedoutput) &&
+           genomicchar == ref_seq_tran[m-1]) {
+        rval -= halfweights[m];
       }
-      maxvalue = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m-1] + rval);
+      maxvalue = (GthFlt) (escore_prev[m-1] + rval);
       retrace  = DNA_E_NM;
 
       /* 1. */
-      outputweight = 0.0;
-      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
-      rval += outputweights[genomicchar][referencechar];
+      rval = acceptor;
+      rval += genweights[m];
       if ((m < dp_options_est->wdecreasedoutput ||
-           m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
-           genomicchar == referencechar) {
-        outputweight += outputweights[genomicchar][referencechar];
-        rval -= (outputweight / 2.0);
+           m > ref_dp_length - dp_options_est->wdecreasedoutput) &&
+           genomicchar == ref_seq_tran[m-1]) {
+        rval -= halfweights[m];
       }
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m-1] + rval);
+      value = (GthFlt) (iscore_prev[m-1] + rval);
       /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
-      if (n - dpm->intronstart[modnminus1][m - 1] <
-          dp_options_core->dpminintronlength) {
+      if (n - intronstart_prev[m - 1] < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_NM);
 
       /* 2. */
       rval = 0.0;
-      if (m < dpm->ref_dp_length || n < dp_options_est->wzerotransition)
-        rval += (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
-      if (m < dpm->ref_dp_length)
-        rval += outputweights[genomicchar][DASH];
-      value = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m] + rval);
+      if (m < ref_dp_length || n < dp_options_est->wzerotransition)
+        rval += nodonor;
+      if (m < ref_dp_length)
+        rval += dashweight;
+      value = (GthFlt) (escore_prev[m] + rval);
       UPDATEMAX(DNA_E_N);
 
       /* 3. */
-      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
-      if (m < dpm->ref_dp_length)
-        rval += outputweights[genomicchar][DASH];
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m] + rval);
+      rval = acceptor;
+      if (m < ref_dp_length)
+        rval += dashweight;
+      value = (GthFlt) (iscore_prev[m] + rval);
       /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
-      if (n - dpm->intronstart[modnminus1][m] <
-          dp_options_core->dpminintronlength) {
+      if (n - intronstart_prev[m] < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_N);
 
       /* 4. */
       rval = 0.0;
-      if (n < dpm->gen_dp_length || m < dp_options_est->wzerotransition)
+      if (n < gen_dp_length || m < dp_options_est->wzerotransition)
         rval = (GthDbl) log_probdelgen;
-      if (n < dpm->gen_dp_length)
-        rval += outputweights[DASH][referencechar];
-      value = (GthFlt) (dpm->score[DNA_E_STATE][modn][m-1] + rval);
+      if (n < gen_dp_length)
+        rval += deletionweights[m];
+      value = (GthFlt) (escore[m-1] + rval);
       UPDATEMAX(DNA_E_M);
 
       /* 5. */
       rval = 0.0;
-      if (n < dpm->gen_dp_length)
-       rval += (dp_param->log_Pacceptor[n-1] + log_probdelgen);
-      if (n < dpm->gen_dp_length)
-        rval += outputweights[DASH][referencechar];
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modn][m-1] + rval);
+      if (n < gen_dp_length) {
+        rval += endacceptor;
+        rval += deletionweights[m];
+      }
+      value = (GthFlt) (iscore[m-1] + rval);
       /* intron from intronstart to n => n - intronstart + 1 */
-      if (n - dpm->intronstart[modn][m - 1] + 1 <
-          dp_options_core->dpminintronlength) {
+      if (n - intronstart[m - 1] + 1 < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_M);
 
       /* save maximum values */
-      dpm->score[DNA_E_STATE][modn][m] = maxvalue;
+      escore[m] = maxvalue;
       if (modn)
-        dpm->path[GT_DIV2(n)][m] |= (retrace << 4);
+        path[m] |= (retrace << 4);
       else
-        dpm->path[GT_DIV2(n)][m]  = retrace;
+        path[m]  = retrace;
 
       switch (retrace) {
         case DNA_I_NM:
         case DNA_I_N:
         case DNA_I_M:
-          dpm->exonstart[modn][m] = n;
+          exonstart[m] = n;
           break;
         case DNA_E_NM:
-          dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m - 1];
+          exonstart[m] = exonstart_prev[m - 1];
           break;
         case DNA_E_N:
-          dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m];
+          exonstart[m] = exonstart_prev[m];
           break;
         case DNA_E_M:
-          dpm->exonstart[modn][m] = dpm->exonstart[modn][m - 1];
+          exonstart[m] = exonstart[m - 1];
           break;
         default: gt_assert(0);
       }
@@ -455,35 +639,32 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
       /* evaluate I_nm */
 
       /* 0. */
-      maxvalue = dpm->score[DNA_E_STATE][modnminus1][m] +
-                 (log_1minusprobdelgen + dp_param->log_Pdonor[n-1]);
-      if (n - dpm->exonstart[modnminus1][m]
-          < dp_options_core->dpminexonlength) {
+      maxvalue = escore_prev[m] + donor;
+      if (n - exonstart_prev[m] < dp_options_core->dpminexonlength)
          maxvalue -= dp_options_core->shortexonpenalty;
-      }
       retrace  = I_STATE_E_N;
 
       /* 1. */
-      value = dpm->score[DNA_I_STATE][modnminus1][m];
-      if (!dp_options_core->freeintrontrans && m < dpm->ref_dp_length)
-        value += dp_param->log_1minusPacceptor[n-2];
+      value = iscore_prev[m];
+      if (!dp_options_core->freeintrontrans && m < ref_dp_length)
+        value += noacceptor;
       UPDATEMAX(I_STATE_I_N);
 
       /* save maximum values */
-      dpm->score[DNA_I_STATE][modn][m] = maxvalue;
+      iscore[m] = maxvalue;
       if (modn)
-        dpm->path[GT_DIV2(n)][m] |= (retrace << 4);
+        path[m] |= (retrace << 4);
       else
-        dpm->path[GT_DIV2(n)][m] |= retrace;
+        path[m] |= retrace;
 
       switch (retrace) {
        case I_STATE_E_N:
           /* begin of a new intron */
-          dpm->intronstart[modn][m] = n;
+          intronstart[m] = n;
           break;
         case I_STATE_I_N:
           /* continue existing intron */
-          dpm->intronstart[modn][m] = dpm->intronstart[modnminus1][m];
+          intronstart[m] = intronstart_prev[m];
           break;
         default: gt_assert(0);
       }
@@ -491,9 +672,101 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
   }
 
   /* free space  */
+  for (n = 0; n <= UCHAR_MAX; n++)
+    gt_free(matchweights[n]);
+  gt_free(halfweights);
+  gt_free(deletionweights);
   gt_array2dim_delete(outputweights);
 }
 
+/* the following function evaluates the rows of the segment which starts at
+   row <segmentstart>. The score tables have to contain the row before the
+   segment, or the first row if <segmentstart> equals 0. */
+static void dna_checkpoints_compute_segment(GthDPMatrix *dpm,
+                                            GtUword segmentstart)
+{
+  GthDPCheckpoints *cp = dpm->checkpoints;
+  dna_checkpoints_set_segment(dpm, segmentstart);
+  dna_complete_path_rows(dpm, cp->gen_seq_tran, cp->ref_seq_tran,
+                         segmentstart ? segmentstart - 1 : 0,
+                         MIN(segmentstart + cp->segmentlength - 1,
+                             dpm->gen_dp_length),
+                         cp->gen_alphabet, cp->dp_param, cp->dp_options_est,
+                         cp->dp_options_core);
+}
+
+/* the following function recomputes the segment which contains row <genptr>
+   from the checkpoint of the preceding segment */
+static void dna_checkpoints_recompute_segment(GthDPMatrix *dpm,
+                                              GtUword genptr)
+{
+  GthDPCheckpoints *cp = dpm->checkpoints;
+  GtUword k, rowsize = dpm->ref_dp_length + 1;
+
+  k = genptr / cp->segmentlength;
+  if (k) {
+    /* the row before the segment is odd */
+    memcpy(dpm->score[DNA_E_STATE][1], cp->escore + (k - 1) * rowsize,
+           sizeof (GthFlt) * rowsize);
+    memcpy(dpm->score[DNA_I_STATE][1], cp->iscore + (k - 1) * rowsize,
+           sizeof (GthFlt) * rowsize);
+    memcpy(dpm->exonstart[1], cp->exonstart + (k - 1) * rowsize,
+           sizeof (GtUword) * rowsize);
+    memcpy(dpm->intronstart[1], cp->intronstart + (k - 1) * rowsize,
+           sizeof (GtUword) * rowsize);
+    dna_checkpoints_compute_segment(dpm, k * cp->segmentlength);
+  }
+  else {
+    dna_checkpoints_set_segment(dpm, 0);
+    dp_matrix_init_first_row(dpm);
+    dna_checkpoints_compute_segment(dpm, 0);
+  }
+}
+
+/* the following function evaluate the dynamic programming tables */
+static void dna_complete_path_matrix(GthDPMatrix *dpm,
+                                     const unsigned char *gen_seq_tran,
+                                     const unsigned char *ref_seq_tran,
+                                     GtUword genomic_offset,
+                                     GtAlphabet *gen_alphabet,
+                                     GthDPParam *dp_param,
+                                     GthDPOptionsEST *dp_options_est,
+                                     GthDPOptionsCore *dp_options_core)
+{
+  GthDPCheckpoints *cp = dpm->checkpoints;
+  GtUword k, rowsize = dpm->ref_dp_length + 1;
+
+  if (!cp) {
+    dna_complete_path_rows(dpm, gen_seq_tran, ref_seq_tran, genomic_offset,
+                           dpm->gen_dp_length, gen_alphabet, dp_param,
+                           dp_options_est, dp_options_core);
+    return;
+  }
+
+  gt_assert(!genomic_offset);
+  cp->gen_seq_tran = gen_seq_tran;
+  cp->ref_seq_tran = ref_seq_tran;
+  cp->gen_alphabet = gen_alphabet;
+  cp->dp_param = dp_param;
+  cp->dp_options_est = dp_options_est;
+  cp->dp_options_core = dp_options_core;
+
+  for (k = 0; k <= cp->numofcheckpoints; k++) {
+    if (k) {
+      /* save the last row of the previous segment, which is odd */
+      memcpy(cp->escore + (k - 1) * rowsize, dpm->score[DNA_E_STATE][1],
+             sizeof (GthFlt) * rowsize);
+      memcpy(cp->iscore + (k - 1) * rowsize, dpm->score[DNA_I_STATE][1],
+             sizeof (GthFlt) * rowsize);
+      memcpy(cp->exonstart + (k - 1) * rowsize, dpm->exonstart[1],
+             sizeof (GtUword) * rowsize);
+      memcpy(cp->intronstart + (k - 1) * rowsize, dpm->intronstart[1],
+             sizeof (GtUword) * rowsize);
+    }
+    dna_checkpoints_compute_segment(dpm, k * cp->segmentlength);
+  }
+}
+
 static void dna_include_exon(GthBacktracePath *backtrace_path,
                              GtUword exonlength)
 {
@@ -539,6 +812,8 @@ static int dna_evaltracepath(GthBacktracePath *backtrace_path, GthDPMatrix *dpm,
   gt_assert(!gth_backtrace_path_length(backtrace_path));
 
   while ((genptr > 0) || (refptr > 0)) {
+    if (dpm->checkpoints && genptr < dpm->checkpoints->segmentstart)
+      dna_checkpoints_recompute_segment(dpm, genptr);
     /* here we map the quarter matrix bitvector stuff back on the simple Retrace
        types.  Thereby, no further changes on the backtracing procedure are
        necessary. */
@@ -761,7 +1036,13 @@ static void dp_matrix_free(GthDPMatrix *dpm)
   }
 
   /* freeing space for dpm->path */
-  gth_array2dim_plain_delete(dpm->path);
+  if (dpm->checkpoints) {
+    dna_checkpoints_delete(dpm->checkpoints);
+    gt_free(dpm->path);
+  }
+  else {
+    gth_array2dim_plain_delete(dpm->path);
+  }
   if (dpm->path_jt)
     gt_array2dim_delete(dpm->path_jt);
 }
@@ -997,7 +1278,8 @@ static void detect_small_terminal_exons(GthSA *sa,
   }
 
   if (dp_matrix_init(&dpm_terminal, gen_dp_length_terminal,
-                     ref_dp_length_terminal, 0, false, NULL, stat)) {
+                     ref_dp_length_terminal, 0,
+                     dp_options_core->dpmaxmatrixsize, false, NULL, stat)) {
     /* out of memory */
     return;
   }
@@ -1135,7 +1417,8 @@ static void detect_small_initial_exons(GthSA *sa,
             gen_seq_bounds->end);
 
   if (dp_matrix_init(&dpm_initial, gen_dp_length_initial,
-                     ref_dp_length_initial, 0, false, NULL, stat)) {
+                     ref_dp_length_initial, 0,
+                     dp_options_core->dpmaxmatrixsize, false, NULL, stat)) {
     /* out of memory */
     return;
   }
@@ -1269,11 +1552,16 @@ int gth_align_dna(GthSA *sa,
     spliced_seq = gth_spliced_seq_new_with_comments(gen_seq_tran, gen_ranges,
                                                     comments, outfp);
   }
+  /* the debugging output of the backtrace table requires the complete
+     table */
   if ((rval = dp_matrix_init(&dpm,
                              introncutout ? spliced_seq->splicedseqlen
                                           : gen_dp_length,
-                             ref_dp_length, autoicmaxmatrixsize, introncutout,
-                             jump_table, stat))) {
+                             ref_dp_length, autoicmaxmatrixsize,
+                             dp_options_core->btmatrixgenrange.start
+                             == GT_UNDEF_UWORD
+                             ? dp_options_core->dpmaxmatrixsize : 0,
+                             introncutout, jump_table, stat))) {
     gth_dp_param_delete(dp_param);
     gth_spliced_seq_delete(spliced_seq);
     return rval;
@@ -1454,3 +1742,303 @@ GthSA* gth_align_dna_simple(GthInput *input,
   gth_dp_options_core_delete(dp_options_core);
   return sa;
 }
+
+/* the following functions hash the DP tables of the unit test independent of
+   the byte order and the size of a <GtUword> */
+static void align_dna_test_hash(GtUint64 *hash, GtWord value)
+{
+  unsigned int i;
+  for (i = 0; i < 4; i++) {
+    *hash ^= ((GtUint64) value >> (8 * i)) & 0xff;
+    *hash *= 1099511628211ULL;
+  }
+}
+
+static GtUint64 align_dna_test_tables_hash(const GthDPMatrix *dpm)
+{
+  GtUint64 hash = 14695981039346656037ULL;
+  GtUword n, m;
+  unsigned int t;
+  for (n = 0; n < GT_DIV2(dpm->gen_dp_length + 1) +
+                  GT_MOD2(dpm->gen_dp_length + 1); n++) {
+    for (m = 0; m <= dpm->ref_dp_length; m++)
+      align_dna_test_hash(&hash, dpm->path[n][m]);
+  }
+  for (t = 0; t < DNA_NUMOFSTATES; t++) {
+    for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+      for (m = 0; m <= dpm->ref_dp_length; m++) {
+        /* the scores are rounded to ignore differences in the last bits of
+           the transcendental functions of the C library */
+        align_dna_test_hash(&hash, (GtWord) floor(dpm->score[t][n][m] * 1000));
+      }
+    }
+  }
+  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+    for (m = 0; m <= dpm->ref_dp_length; m++) {
+      align_dna_test_hash(&hash, dpm->intronstart[n][m]);
+      align_dna_test_hash(&hash, dpm->exonstart[n][m]);
+    }
+  }
+  return hash;
+}
+
+static unsigned int align_dna_test_random(GtUint64 *state)
+{
+  *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (unsigned int) (*state >> 33);
+}
+
+/* the following function creates a random genomic sequence of length
+   <gen_dp_length> with splice site probabilities and a cDNA of length
+   <ref_dp_length> consisting of two exons of it, with mutations. The exons
+   are separated by an intron of length <intron_length> */
+static void align_dna_test_input(unsigned char **gen_seq_tran,
+                                 unsigned char **ref_seq_tran,
+                                 GthDPParam *dp_param, GtUword gen_dp_length,
+                                 GtUword ref_dp_length, GtUword intron_length,
+                                 unsigned char wildcard, GtUint64 *state)
+{
+  GtUword n, m;
+  *gen_seq_tran = gt_malloc(sizeof **gen_seq_tran * gen_dp_length);
+  *ref_seq_tran = gt_malloc(sizeof **ref_seq_tran * ref_dp_length);
+  dp_param->log_Pdonor = gt_malloc(sizeof (GthFlt) * gen_dp_length);
+  dp_param->log_1minusPdonor = gt_malloc(sizeof (GthFlt) * gen_dp_length);
+  dp_param->log_Pacceptor = gt_malloc(sizeof (GthFlt) * gen_dp_length);
+  dp_param->log_1minusPacceptor = gt_malloc(sizeof (GthFlt) * gen_dp_length);
+  for (n = 0; n < gen_dp_length; n++) {
+    double donor, acceptor;
+    (*gen_seq_tran)[n] = align_dna_test_random(state) % 50
+                         ? align_dna_test_random(state) % 4
+                         : wildcard;
+    donor = (align_dna_test_random(state) % 100) / 1000.0 + 0.0001;
+    acceptor = (align_dna_test_random(state) % 100) / 1000.0 + 0.0001;
+    dp_param->log_Pdonor[n] = (GthFlt) log(donor);
+    dp_param->log_1minusPdonor[n] = (GthFlt) log(1.0 - donor);
+    dp_param->log_Pacceptor[n] = (GthFlt) log(acceptor);
+    dp_param->log_1minusPacceptor[n] = (GthFlt) log(1.0 - acceptor);
+  }
+  for (m = 0; m < ref_dp_length; m++) {
+    n = m < ref_dp_length / 2 ? m : m + intron_length;
+    (*ref_seq_tran)[m] = n < gen_dp_length && align_dna_test_random(state) % 10
+                         ? (*gen_seq_tran)[n] % 4
+                         : align_dna_test_random(state) % 4;
+  }
+}
+
+static void align_dna_test_input_delete(unsigned char *gen_seq_tran,
+                                        unsigned char *ref_seq_tran,
+                                        GthDPParam *dp_param)
+{
+  gt_free(dp_param->log_1minusPacceptor);
+  gt_free(dp_param->log_Pacceptor);
+  gt_free(dp_param->log_1minusPdonor);
+  gt_free(dp_param->log_Pdonor);
+  gt_free(ref_seq_tran);
+  gt_free(gen_seq_tran);
+}
+
+/* The following unit test computes the DP tables of random cDNAs which were
+   derived from random genomic sequences with an intron and compares their
+   hashes with those of the original (unoptimized) implementation, to make sure
+   that optimizations of the DP do not change any score or path decision.
+   Afterwards it checks that the backtrace of a DP computed with checkpoints,
+   which discards the backtrace rows of every segment and resumes the DP from
+   the checkpoints during the backtrace, equals the backtrace of the complete
+   DP. */
+int gth_align_dna_unit_test(GtError *err)
+{
+  static const struct {
+    GtUword gen_dp_length,
+            ref_dp_length,
+            intron_length;
+    GtUint64 hash;
+  } testcases[] = {
+    { 2, 3, 0, 6108485359359320006ULL },
+    { 97, 131, 0, 9634280076385178619ULL },
+    { 400, 250, 120, 126868085820926494ULL },
+    { 1000, 700, 250, 14143520156815201892ULL }
+  },
+  checkpointcases[] = {
+    { 3000, 1200, 1700, 0 },
+    { 3001, 1200, 1000, 0 },
+    { 4500, 800, 3600, 0 }
+  };
+  GthDPOptionsCore *dp_options_core;
+  GthDPOptionsEST *dp_options_est;
+  GtAlphabet *gen_alphabet;
+  GthStat *stat;
+  GtUint64 state = 42;
+  GtUword i;
+  unsigned char wildcard;
+  int had_err = 0;
+  gt_error_check(err);
+
+  dp_options_core = gth_dp_options_core_new();
+  dp_options_est = gth_dp_options_est_new();
+  gen_alphabet = gt_alphabet_new_dna();
+  wildcard = gt_alphabet_size(gen_alphabet) - 1;
+  stat = gth_stat_new();
+  for (i = 0; !had_err && i < sizeof testcases / sizeof testcases[0]; i++) {
+    unsigned char *gen_seq_tran, *ref_seq_tran;
+    GthDPParam dp_param;
+    GthDPMatrix dpm;
+    GtUint64 hash;
+    align_dna_test_input(&gen_seq_tran, &ref_seq_tran, &dp_param,
+                         testcases[i].gen_dp_length,
+                         testcases[i].ref_dp_length,
+                         testcases[i].intron_length, wildcard, &state);
+    had_err = dp_matrix_init(&dpm, testcases[i].gen_dp_length,
+                             testcases[i].ref_dp_length, 0, 0, false, NULL,
+                             stat);
+    gt_ensure(!had_err);
+    if (!had_err) {
+      dna_complete_path_matrix(&dpm, gen_seq_tran, ref_seq_tran, 0,
+                               gen_alphabet, &dp_param, dp_options_est,
+                               dp_options_core);
+      hash = align_dna_test_tables_hash(&dpm);
+      if (hash != testcases[i].hash) {
+        gt_error_set(err, "DP tables of test case " GT_WU " have hash "
+                     GT_LLU " instead of " GT_LLU, i, hash,
+                     testcases[i].hash);
+        had_err = -1;
+      }
+      dp_matrix_free(&dpm);
+    }
+    align_dna_test_input_delete(gen_seq_tran, ref_seq_tran, &dp_param);
+  }
+  for (i = 0;
+       !had_err && i < sizeof checkpointcases / sizeof checkpointcases[0];
+       i++) {
+    GtUword gen_dp_length = checkpointcases[i].gen_dp_length,
+            ref_dp_length = checkpointcases[i].ref_dp_length;
+    unsigned char *gen_seq_tran, *ref_seq_tran;
+    GthBacktracePath *complete_path, *checkpointed_path;
+    GthDPParam dp_param;
+    GthDPMatrix dpm;
+    align_dna_test_input(&gen_seq_tran, &ref_seq_tran, &dp_param,
+                         gen_dp_length, ref_dp_length,
+                         checkpointcases[i].intron_length, wildcard, &state);
+    complete_path = gth_backtrace_path_new(0, gen_dp_length, 0, ref_dp_length);
+    gth_backtrace_path_set_alphatype(complete_path, DNA_ALPHA);
+    checkpointed_path = gth_backtrace_path_new(0, gen_dp_length, 0,
+                                               ref_dp_length);
+    gth_backtrace_path_set_alphatype(checkpointed_path, DNA_ALPHA);
+
+    /* the complete DP */
+    had_err = dp_matrix_init(&dpm, gen_dp_length, ref_dp_length, 0, 0, false,
+                             NULL, stat);
+    gt_ensure(!had_err && !dpm.checkpoints);
+    if (!had_err) {
+      dna_complete_path_matrix(&dpm, gen_seq_tran, ref_seq_tran, 0,
+                               gen_alphabet, &dp_param, dp_options_est,
+                               dp_options_core);
+      had_err = dna_find_optimal_path(complete_path, &dpm, ref_seq_tran,
+                                      gen_seq_tran, false, NULL, false, false,
+                                      false, NULL, NULL);
+      gt_ensure(!had_err);
+      dp_matrix_free(&dpm);
+    }
+
+    /* the DP with checkpoints, the backtrace table has more than 1 MB */
+    if (!had_err) {
+      had_err = dp_matrix_init(&dpm, gen_dp_length, ref_dp_length, 0, 1,
+                               false, NULL, stat);
+      gt_ensure(!had_err && dpm.checkpoints);
+      if (!had_err) {
+        dna_complete_path_matrix(&dpm, gen_seq_tran, ref_seq_tran, 0,
+                                 gen_alphabet, &dp_param, dp_options_est,
+                                 dp_options_core);
+        had_err = dna_find_optimal_path(checkpointed_path, &dpm, ref_seq_tran,
+                                        gen_seq_tran, false, NULL, false,
+                                        false, false, NULL, NULL);
+        gt_ensure(!had_err);
+        dp_matrix_free(&dpm);
+      }
+    }
+
+    gt_ensure(gth_backtrace_path_length(complete_path) ==
+              gth_backtrace_path_length(checkpointed_path));
+    gt_ensure(!memcmp(gth_backtrace_path_get(complete_path),
+                      gth_backtrace_path_get(checkpointed_path),
+                      sizeof (Editoperation) *
+                      gth_backtrace_path_length(complete_path)));
+    gth_backtrace_path_delete(checkpointed_path);
+    gth_backtrace_path_delete(complete_path);
+    align_dna_test_input_delete(gen_seq_tran, ref_seq_tran, &dp_param);
+  }
+  if (!had_err) {
+    /* a short genomic sequence and a long reference sequence, the backtrace
+       table exceeds 1 MB but checkpoints would need even more space */
+    GthDPMatrix dpm;
+    gt_ensure(dp_matrix_init(&dpm, 40, 60000, 0, 1, false, NULL, stat) ==
+              GTH_ERROR_MATRIX_ALLOCATION_FAILED);
+    had_err = dp_matrix_init(&dpm, 40, 60000, 0, 2, false, NULL, stat);
+    gt_ensure(!had_err && !dpm.checkpoints);
+    if (!had_err)
+      dp_matrix_free(&dpm);
+  }
+  gth_stat_delete(stat);
+  gt_alphabet_delete(gen_alphabet);
+  gth_dp_options_est_delete(dp_options_est);
+  gth_dp_options_core_delete(dp_options_core);
+  return had_err;
+}
+
+int gth_align_dna_benchmark(GtUword gen_dp_length, GtUword ref_dp_length,
+                            GtUword runs, double *cells_per_second,
+                            GtError *err)
+{
+  GthDPOptionsCore *dp_options_core;
+  GthDPOptionsEST *dp_options_est;
+  GtAlphabet *gen_alphabet;
+  unsigned char *gen_seq_tran, *ref_seq_tran;
+  GthDPParam dp_param;
+  GthDPMatrix dpm;
+  GthStat *stat;
+  GtTimer *timer;
+  GtUint64 state = 42;
+  GtWord usec = 0;
+  GtUword r;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gen_dp_length && ref_dp_length && runs && cells_per_second);
+
+  dp_options_core = gth_dp_options_core_new();
+  dp_options_est = gth_dp_options_est_new();
+  gen_alphabet = gt_alphabet_new_dna();
+  stat = gth_stat_new();
+  timer = gt_timer_new();
+  align_dna_test_input(&gen_seq_tran, &ref_seq_tran, &dp_param, gen_dp_length,
+                       ref_dp_length,
+                       gen_dp_length > ref_dp_length
+                       ? gen_dp_length - ref_dp_length : 0,
+                       gt_alphabet_size(gen_alphabet) - 1, &state);
+  for (r = 0; !had_err && r < runs; r++) {
+    if (dp_matrix_init(&dpm, gen_dp_length, ref_dp_length, 0, 0, false, NULL,
+                       stat)) {
+      gt_error_set(err, "could not allocate the DP matrix of " GT_WU " x "
+                   GT_WU " cells", gen_dp_length + 1, ref_dp_length + 1);
+      had_err = -1;
+      break;
+    }
+    /* only the DP is measured, not the allocation of the tables */
+    gt_timer_start(timer);
+    dna_complete_path_matrix(&dpm, gen_seq_tran, ref_seq_tran, 0, gen_alphabet,
+                             &dp_param, dp_options_est, dp_options_core);
+    gt_timer_stop(timer);
+    usec += gt_timer_elapsed_usec(timer);
+    dp_matrix_free(&dpm);
+  }
+  if (!had_err) {
+    *cells_per_second = usec > 0 ? (double) gen_dp_length * ref_dp_length *
+                                   runs / usec * 1000000.0
+                                 : 0.0;
+  }
+  align_dna_test_input_delete(gen_seq_tran, ref_seq_tran, &dp_param);
+  gt_timer_delete(timer);
+  gth_stat_delete(stat);
+  gt_alphabet_delete(gen_alphabet);
+  gth_dp_options_est_delete(dp_options_est);
+  gth_dp_options_core_delete(dp_options_core);
+  return had_err;
+}
@@ -141,6 +141,14 @@ GthSA* gth_align_dna_simple(GthInput *input,
                             GtUword ref_seq_num,
                             GthSpliceSiteModel *splice_site_model);
 
+int  gth_align_dna_unit_test(GtError*);
+/* Computes the DP tables of a random cDNA of length <ref_dp_length> against a
+   random genomic sequence of length <gen_dp_length> <runs> times and stores
+   the number of DP cells computed per second in <cells_per_second>. */
+int  gth_align_dna_benchmark(GtUword gen_dp_length, GtUword ref_dp_length,
+                             GtUword runs, double *cells_per_second,
+                             GtError *err);
+
 void gth_show_backtrace_matrix(GthPath **path,
                                GtUword gen_dp_length,
                                GtUword ref_dp_length,
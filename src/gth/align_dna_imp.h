@@ -70,6 +70,8 @@ typedef enum {
   DNA_NUMOFRETRACE
 } DnaRetrace;
 
+typedef struct GthDPCheckpoints GthDPCheckpoints;
+
 /* the following structure bundles all tables involved in the dynamic
    programming for cDNAs/ESTs */
 struct GthDPMatrix {
@@ -82,6 +84,10 @@ struct GthDPMatrix {
                 *exonstart[DNA_NUMOFSCORETABLES],
                 gen_dp_length,
                 ref_dp_length;
+  GthDPCheckpoints *checkpoints;    /* if not NULL, only the rows of one
+                                       segment of the backtrace table are
+                                       stored, the other segments are
+                                       recomputed from checkpoints */
 };
 
 #endif
@@ -15,9 +15,12 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <math.h>
 #include "core/codon_api.h"
 #include "core/divmodmul.h"
+#include "core/ensure.h"
 #include "core/safearith.h"
+#include "core/timer_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "gth/array2dim_plain.h"
@@ -328,11 +331,24 @@ static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
                                  GthDPOptionsCore *dp_options_core,
                                  GthDPScoresProtein *dp_scores_protein)
 {
-  GtUword n, m, modn, modnminus1, modnminus2, modnminus3;
-  unsigned char origreferencechar;
-  GthFlt value, maxvalue;
+  GtUword n, m, modn, modnminus1, modnminus2, modnminus3,
+          *exonstart = NULL, *intronstart_A, *intronstart_B, *intronstart_C;
+  const GtUword *exonstart_1 = NULL, *exonstart_2 = NULL, *exonstart_3 = NULL,
+                *intronstart_A1, *intronstart_A3, *intronstart_B1,
+                *intronstart_B2, *intronstart_C1;
+  unsigned char origreferencechar, *splitcodon_B, *splitcodon_C1,
+                *splitcodon_C2;
+  const unsigned char *splitcodon_B1, *splitcodon_B2, *splitcodon_C1_1,
+                      *splitcodon_C2_1;
+  GthFlt value, maxvalue, *escore, *iascore, *ibscore, *icscore,
+         nodonor_1, nodonor_2, nodonor_3, nodonor_0, acceptor, acceptor_3,
+         acceptor_2, noacceptor, donor, deletion_1, deletion_2, deletion_3;
+  const GthFlt *escore_1, *escore_2, *escore_3, *iascore_1, *iascore_3,
+               *ibscore_1, *ibscore_2, *icscore_1, *codonscores, *dashscores;
   GthPath retrace;
 
+  dashscores = dp_scores_protein->score[DASH];
+
   /* stepping along the genomic sequence */
   for (n = GENOMICDPSTART; n <= gen_dp_length; n++) {
     modn       = GT_MOD4(n),
@@ -345,110 +361,136 @@ static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
     path_ib_state_write(dpm, n, 0, IB_N1);
     path_ic_state_write(dpm, n, 0, IC_N1);
 
+    /* the rows of the tables and the scores which are constant in a row are
+       fetched once, the stores into the tables would otherwise force the
+       compiler to reload them for every cell */
+    escore    = dpm->core.score[E_STATE][modn];
+    escore_1  = dpm->core.score[E_STATE][modnminus1];
+    escore_2  = dpm->core.score[E_STATE][modnminus2];
+    escore_3  = dpm->core.score[E_STATE][modnminus3];
+    iascore   = dpm->core.score[IA_STATE][modn];
+    iascore_1 = dpm->core.score[IA_STATE][modnminus1];
+    iascore_3 = dpm->core.score[IA_STATE][modnminus3];
+    ibscore   = dpm->core.score[IB_STATE][modn];
+    ibscore_1 = dpm->core.score[IB_STATE][modnminus1];
+    ibscore_2 = dpm->core.score[IB_STATE][modnminus2];
+    icscore   = dpm->core.score[IC_STATE][modn];
+    icscore_1 = dpm->core.score[IC_STATE][modnminus1];
+    if (proteinexonpenal) {
+      exonstart   = dpm->exonstart[modn];
+      exonstart_1 = dpm->exonstart[modnminus1];
+      exonstart_2 = dpm->exonstart[modnminus2];
+      exonstart_3 = dpm->exonstart[modnminus3];
+    }
+    intronstart_A   = dpm->intronstart_A[modn];
+    intronstart_A1  = dpm->intronstart_A[modnminus1];
+    intronstart_A3  = dpm->intronstart_A[modnminus3];
+    intronstart_B   = dpm->intronstart_B[modn];
+    intronstart_B1  = dpm->intronstart_B[modnminus1];
+    intronstart_B2  = dpm->intronstart_B[modnminus2];
+    intronstart_C   = dpm->intronstart_C[modn];
+    intronstart_C1  = dpm->intronstart_C[modnminus1];
+    splitcodon_B    = dpm->splitcodon_B[modn];
+    splitcodon_B1   = dpm->splitcodon_B[modnminus1];
+    splitcodon_B2   = dpm->splitcodon_B[modnminus2];
+    splitcodon_C1   = dpm->splitcodon_C1[modn];
+    splitcodon_C1_1 = dpm->splitcodon_C1[modnminus1];
+    splitcodon_C2   = dpm->splitcodon_C2[modn];
+    splitcodon_C2_1 = dpm->splitcodon_C2[modnminus1];
+
+    codonscores = GTHGETSCOREROW(dp_scores_protein, gen_seq_tran[n-3],
+                                 gen_seq_tran[n-2], gen_seq_tran[n-1]);
+    nodonor_3 = dp_param->log_1minusPdonor[n-3];
+    nodonor_2 = dp_param->log_1minusPdonor[n-2];
+    nodonor_1 = dp_param->log_1minusPdonor[n-1];
+    if (n == gen_dp_length) {
+      /* in this case the value used in the 'else' branch below is not
+         defined. */
+      nodonor_0 = dp_param->log_1minusPdonor[n-1];
+    }
+    else {
+      nodonor_0 = dp_param->log_1minusPdonor[n];
+                                 /* XXX: ^^^  why n? */
+    }
+    /* the value below is only defined if n > GENOMICDPSTART */
+    acceptor = n > GENOMICDPSTART ? dp_param->log_Pacceptor[n-4] : 0.0;
+    acceptor_3 = dp_param->log_Pacceptor[n-3];
+    acceptor_2 = dp_param->log_Pacceptor[n-2];
+    noacceptor = dp_param->log_1minusPacceptor[n-2];
+    donor = dp_param->log_Pdonor[n-1];
+    deletion_3 = nodonor_3 + codonscores[DASH];
+    deletion_2 = nodonor_2 + dashscores[DASH];
+    deletion_1 = nodonor_1 + dashscores[DASH];
+
     /* stepping along the protein sequence */
     for (m = REFERENCEDPSTART; m <= ref_dp_length; m++) {
       origreferencechar = input->ref_seq_orig[m-1];
 
       /* evaluate E_nm */
       /* 0. */
-      maxvalue = SCORE(E_STATE, modnminus3, m-1) +
+      maxvalue = escore_3[m-1] +
                  /* XXX: why is here no extra condition? */
-                 (dp_param->log_1minusPdonor[n-3] +
-                  GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-3],
-                              gen_seq_tran[n-2], gen_seq_tran[n-1],
-                              origreferencechar));
+                 (nodonor_3 + codonscores[origreferencechar]);
       retrace  = (GthPath) E_N3M;
 
       /* 1. */
-      value = SCORE(E_STATE, modnminus2, m-1);
-      if (n < gen_dp_length || m < WSIZE_PROTEIN) {
-        value += dp_param->log_1minusPdonor[n-2] +
-                 GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-2],
-                             gen_seq_tran[n-1], DASH, origreferencechar);
-      }
+      value = escore_2[m-1];
+      if (n < gen_dp_length || m < WSIZE_PROTEIN)
+        value += nodonor_2 + dashscores[origreferencechar];
       UPDATEMAX(E_N2M);
 
       /* 2. */
-      value = SCORE(E_STATE, modnminus1, m-1);
-      if (n < gen_dp_length || m < WSIZE_PROTEIN) {
-        value += dp_param->log_1minusPdonor[n-1] +
-                 GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-1], DASH, DASH,
-                             origreferencechar);
-      }
+      value = escore_1[m-1];
+      if (n < gen_dp_length || m < WSIZE_PROTEIN)
+        value += nodonor_1 + dashscores[origreferencechar];
       UPDATEMAX(E_N1M);
 
       /* 3. */
-      value = SCORE(E_STATE, modn, m-1);
+      value = escore[m-1];
       if (n < gen_dp_length || m < WSIZE_PROTEIN) {
-        if (n == gen_dp_length) {
-          /* in this case the value used in the 'else' branch below is not
-             defined. */
-          value += dp_param->log_1minusPdonor[n-1];
-        }
-        else {
-          value += dp_param->log_1minusPdonor[n];
-                                     /* XXX: ^^^  why n? */
-        }
-        value += GTHGETSCORE(dp_scores_protein, DASH, DASH, DASH,
-                             origreferencechar);
+        value += nodonor_0;
+        value += dashscores[origreferencechar];
       }
       UPDATEMAX(E_M);
 
       /* 4. */
-      value = SCORE(E_STATE, modnminus3, m);
-      if (m < ref_dp_length || n < WSIZE_DNA) {
-        value += dp_param->log_1minusPdonor[n-3] +
-                 GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-3],
-                             gen_seq_tran[n-2], gen_seq_tran[n-1], DASH);
-      }
+      value = escore_3[m];
+      if (m < ref_dp_length || n < WSIZE_DNA)
+        value += deletion_3;
       UPDATEMAX(E_N3);
 
       /* 5. */
-      value = SCORE(E_STATE, modnminus2, m);
-      if (m < ref_dp_length || n < WSIZE_DNA) {
-        value += dp_param->log_1minusPdonor[n-2] +
-                 GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-2],
-                             gen_seq_tran[n-1], DASH, DASH);
-      }
+      value = escore_2[m];
+      if (m < ref_dp_length || n < WSIZE_DNA)
+        value += deletion_2;
       UPDATEMAX(E_N2);
 
       /* 6. */
-      value = SCORE(E_STATE, modnminus1, m);
-      if (m < ref_dp_length || n < WSIZE_DNA) {
-        value += dp_param->log_1minusPdonor[n-1] +
-                 GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-1], DASH, DASH,
-                             DASH);
-      }
+      value = escore_1[m];
+      if (m < ref_dp_length || n < WSIZE_DNA)
+        value += deletion_1;
       UPDATEMAX(E_N1);
 
       /* 7. */
-      value = SCORE(IA_STATE, modnminus3, m-1);
+      value = iascore_3[m-1];
       if (n > GENOMICDPSTART) /* the value below is only defined in this case */
-        value += dp_param->log_Pacceptor[n-4];
-      value += GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-3],
-                           gen_seq_tran[n-2], gen_seq_tran[n-1],
-                           origreferencechar);
-      if (n - 2 - dpm->intronstart_A[modnminus3][m-1] <
-          dp_options_core->dpminintronlength) {
+        value += acceptor;
+      value += codonscores[origreferencechar];
+      if (n - 2 - intronstart_A3[m-1] < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(IA_N3M);
 
       /* 8.
          this recurrence is only used if an intron has already been introduced.
          (in this case "dpm->splitcodon_B[modnminus1][m-1]" is different from
          "UNSET". */
-      if (dpm->splitcodon_B[modnminus1][m-1] != (unsigned char) UNSET) {
-        value = SCORE(IB_STATE, modnminus2, m-1) +
-                dp_param->log_Pacceptor[n-3] +
-                GTHGETSCORE(dp_scores_protein,
-                            dpm->splitcodon_B[modnminus2][m-1],
+      if (splitcodon_B1[m-1] != (unsigned char) UNSET) {
+        value = ibscore_2[m-1] + acceptor_3 +
+                GTHGETSCORE(dp_scores_protein, splitcodon_B2[m-1],
                             gen_seq_tran[n-2], gen_seq_tran[n-1],
                             origreferencechar);
-        if (n - 1 - dpm->intronstart_B[modnminus2][m-1] <
-            dp_options_core->dpminintronlength) {
+        if (n - 1 - intronstart_B2[m-1] < dp_options_core->dpminintronlength)
           value -= dp_options_core->shortintronpenalty;
-        }
         UPDATEMAX(IB_N2M);
       }
 
@@ -457,148 +499,138 @@ static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
          "dpm->splitcodon_C2[modnminus1][m-1]" needs not to be checked,
          because it is always set in conjunction with
          "dpm->splitcodon_C1[modnminus1][m-1]". */
-      if (dpm->splitcodon_C1[modnminus1][m-1] != (unsigned char) UNSET) {
-        value = SCORE(IC_STATE, modnminus1, m-1) +
-                dp_param->log_Pacceptor[n-2] +
-                GTHGETSCORE(dp_scores_protein,
-                            dpm->splitcodon_C1[modnminus1][m-1],
-                            dpm->splitcodon_C2[modnminus1][m-1],
-                            gen_seq_tran[n-1], origreferencechar);
-        if (n - dpm->intronstart_C[modnminus1][m-1] <
-            dp_options_core->dpminintronlength) {
+      if (splitcodon_C1_1[m-1] != (unsigned char) UNSET) {
+        value = icscore_1[m-1] + acceptor_2 +
+                GTHGETSCORE(dp_scores_protein, splitcodon_C1_1[m-1],
+                            splitcodon_C2_1[m-1], gen_seq_tran[n-1],
+                            origreferencechar);
+        if (n - intronstart_C1[m-1] < dp_options_core->dpminintronlength)
           value -= dp_options_core->shortintronpenalty;
-        }
         UPDATEMAX(IC_N1M);
       }
 
       /* save maximum values */
-      SCORE(E_STATE, modn, m) = maxvalue;
+      escore[m] = maxvalue;
       path_e_state_write(dpm, n, m, retrace);
 
       if (proteinexonpenal) {
         switch (retrace) {
           case E_N3M:
-            dpm->exonstart[modn][m] = dpm->exonstart[modnminus3][m-1];
+            exonstart[m] = exonstart_3[m-1];
             break;
           case E_N2M:
-            dpm->exonstart[modn][m] = dpm->exonstart[modnminus2][m-1];
+            exonstart[m] = exonstart_2[m-1];
             break;
           case E_N1M:
-            dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m-1];
+            exonstart[m] = exonstart_1[m-1];
             break;
           case E_M:
-            dpm->exonstart[modn][m] = dpm->exonstart[modn][m-1];
+            exonstart[m] = exonstart[m-1];
             break;
           case E_N3:
-            dpm->exonstart[modn][m] = dpm->exonstart[modnminus3][m];
+            exonstart[m] = exonstart_3[m];
             break;
           case E_N2:
-            dpm->exonstart[modn][m] = dpm->exonstart[modnminus2][m];
+            exonstart[m] = exonstart_2[m];
             break;
           case E_N1:
-            dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m];
+            exonstart[m] = exonstart_1[m];
             break;
           case IA_N3M:
           case IB_N2M:
           case IC_N1M:
-            dpm->exonstart[modn][m] = n;
+            exonstart[m] = n;
             break;
           case IC_N1:
-            dpm->exonstart[modn][m] = n;
+            exonstart[m] = n;
             break;
           default: gt_assert(0);
         }
       }
 
       /* evaluate IA_nm */
-      maxvalue = SCORE(IA_STATE, modnminus1, m);
+      maxvalue = iascore_1[m];
       if (!dp_options_core->freeintrontrans)
-        maxvalue += dp_param->log_1minusPacceptor[n-2];
+        maxvalue += noacceptor;
       retrace  = (GthPath) IA_N1;
 
-      value = SCORE(E_STATE, modnminus1, m) + dp_param->log_Pdonor[n-1];
+      value = escore_1[m] + donor;
       if (proteinexonpenal) {
-        if (n - dpm->exonstart[modnminus1][m] <
-            dp_options_core->dpminexonlength) {
+        if (n - exonstart_1[m] < dp_options_core->dpminexonlength)
           value -= dp_options_core->shortexonpenalty;
-        }
       }
       UPDATEMAX(E_N1);
 
       /* save maximum values */
-      SCORE(IA_STATE, modn, m) = maxvalue;
+      iascore[m] = maxvalue;
       path_ia_state_write(dpm, n, m, retrace);
 
       switch (retrace) {
         case IA_N1:
-          dpm->intronstart_A[modn][m] = dpm->intronstart_A[modnminus1][m];
+          intronstart_A[m] = intronstart_A1[m];
           break;
         case E_N1:
-          dpm->intronstart_A[modn][m] = n;
+          intronstart_A[m] = n;
           break;
         default: gt_assert(0);
       }
 
       /* evaluate IB_nm */
-      maxvalue = SCORE(IB_STATE, modnminus1, m);
+      maxvalue = ibscore_1[m];
       if (!dp_options_core->freeintrontrans)
-        maxvalue += dp_param->log_1minusPacceptor[n-2];
+        maxvalue += noacceptor;
       retrace  = (GthPath) IB_N1;
 
-      value = SCORE(E_STATE, modnminus2, m) + dp_param->log_Pdonor[n-1];
+      value = escore_2[m] + donor;
       if (proteinexonpenal) {
-        if (n - 1 - dpm->exonstart[modnminus2][m] <
-            dp_options_core->dpminexonlength) {
+        if (n - 1 - exonstart_2[m] < dp_options_core->dpminexonlength)
           value -= dp_options_core->shortexonpenalty;
-        }
       }
       UPDATEMAX(E_N2);
 
       /* save maximum values */
-      SCORE(IB_STATE, modn, m) = maxvalue;
+      ibscore[m] = maxvalue;
       path_ib_state_write(dpm, n, m, retrace);
 
       switch (retrace) {
         case(IB_N1):
-          dpm->intronstart_B[modn][m] = dpm->intronstart_B[modnminus1][m];
-          dpm->splitcodon_B[modn][m]  = dpm->splitcodon_B[modnminus1][m];
+          intronstart_B[m] = intronstart_B1[m];
+          splitcodon_B[m]  = splitcodon_B1[m];
           break;
         case(E_N2):
-          dpm->intronstart_B[modn][m] = n;
-          dpm->splitcodon_B[modn][m]  = gen_seq_tran[n-2];
+          intronstart_B[m] = n;
+          splitcodon_B[m]  = gen_seq_tran[n-2];
           break;
         default: gt_assert(0);
       }
 
       /* evaluate IC_nm */
-      maxvalue = SCORE(IC_STATE, modnminus1, m);
+      maxvalue = icscore_1[m];
       if (!dp_options_core->freeintrontrans)
-        maxvalue += dp_param->log_1minusPacceptor[n-2];
+        maxvalue += noacceptor;
       retrace = (GthPath) IC_N1;
 
-      value = SCORE(E_STATE, modnminus3, m) + dp_param->log_Pdonor[n-1];
+      value = escore_3[m] + donor;
       if (proteinexonpenal) {
-        if (n - 2 - dpm->exonstart[modnminus3][m] <
-            dp_options_core->dpminexonlength) {
+        if (n - 2 - exonstart_3[m] < dp_options_core->dpminexonlength)
           value -= dp_options_core->shortexonpenalty;
-        }
       }
       UPDATEMAX(E_N3);
 
       /* save maximum values */
-      SCORE(IC_STATE, modn, m) = maxvalue;
+      icscore[m] = maxvalue;
       path_ic_state_write(dpm, n, m, retrace);
 
       switch (retrace) {
         case(IC_N1):
-          dpm->intronstart_C[modn][m] = dpm->intronstart_C[modnminus1][m];
-          dpm->splitcodon_C1[modn][m] = dpm->splitcodon_C1[modnminus1][m];
-          dpm->splitcodon_C2[modn][m] = dpm->splitcodon_C2[modnminus1][m];
+          intronstart_C[m] = intronstart_C1[m];
+          splitcodon_C1[m] = splitcodon_C1_1[m];
+          splitcodon_C2[m] = splitcodon_C2_1[m];
           break;
         case(E_N3):
-          dpm->intronstart_C[modn][m] = n;
-          dpm->splitcodon_C1[modn][m] = gen_seq_tran[n-3];
-          dpm->splitcodon_C2[modn][m] = gen_seq_tran[n-2];
+          intronstart_C[m] = n;
+          splitcodon_C1[m] = gen_seq_tran[n-3];
+          splitcodon_C2[m] = gen_seq_tran[n-2];
           break;
         default: gt_assert(0);
       }
@@ -1192,3 +1224,277 @@ int gth_align_protein(GthSA *sa,
 
   return 0;
 }
+
+/* the following functions hash the DP tables of the unit test independent of
+   the byte order and the size of a <GtUword> */
+static void align_protein_test_hash(GtUint64 *hash, GtWord value)
+{
+  unsigned int i;
+  for (i = 0; i < 4; i++) {
+    *hash ^= ((GtUint64) value >> (8 * i)) & 0xff;
+    *hash *= 1099511628211ULL;
+  }
+}
+
+static GtUint64 align_protein_test_tables_hash(const GthDPtables *dpm,
+                                               bool proteinexonpenal,
+                                               GtUword gen_dp_length,
+                                               GtUword ref_dp_length)
+{
+  GtUint64 hash = 14695981039346656037ULL;
+  GtUword n, m;
+  unsigned int t;
+  for (n = 0; n <= gen_dp_length; n++) {
+    for (m = 0; m <= ref_dp_length; m++)
+      align_protein_test_hash(&hash, dpm->core.path[n][m]);
+  }
+  for (t = 0; t < PROTEIN_NUMOFSTATES; t++) {
+    for (n = 0; n < PROTEIN_NUMOFSCORETABLES; n++) {
+      for (m = 0; m <= ref_dp_length; m++) {
+        /* the scores are rounded to ignore differences in the last bits of
+           the transcendental functions of the C library */
+        align_protein_test_hash(&hash,
+                                (GtWord) floor(dpm->core.score[t][n][m] *
+                                               1000));
+      }
+    }
+  }
+  for (n = 0; n < PROTEIN_NUMOFSCORETABLES; n++) {
+    for (m = 0; m <= ref_dp_length; m++) {
+      align_protein_test_hash(&hash, dpm->intronstart_A[n][m]);
+      align_protein_test_hash(&hash, dpm->intronstart_B[n][m]);
+      align_protein_test_hash(&hash, dpm->intronstart_C[n][m]);
+      if (proteinexonpenal)
+        align_protein_test_hash(&hash, dpm->exonstart[n][m]);
+      align_protein_test_hash(&hash, dpm->splitcodon_B[n][m]);
+      align_protein_test_hash(&hash, dpm->splitcodon_C1[n][m]);
+    }
+  }
+  return hash;
+}
+
+static unsigned int align_protein_test_random(GtUint64 *state)
+{
+  *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (unsigned int) (*state >> 33);
+}
+
+/* the following function returns a protein score matrix which rewards
+   identities and penalizes most substitutions */
+static GtScoreMatrix* align_protein_test_score_matrix(GtAlphabet *alphabet)
+{
+  GtScoreMatrix *score_matrix = gt_score_matrix_new(alphabet);
+  unsigned int x, y;
+  for (x = 0; x < gt_score_matrix_get_dimension(score_matrix); x++) {
+    for (y = 0; y < gt_score_matrix_get_dimension(score_matrix); y++) {
+      gt_score_matrix_set_score(score_matrix, x, y,
+                                x == y ? 4 + x % 5 : (int) ((x + y) % 5) - 3);
+    }
+  }
+  return score_matrix;
+}
+
+/* the following function creates a random genomic sequence of length
+   <gen_dp_length> with splice site probabilities and a protein of length
+   <ref_dp_length>, which is the translation of two exons of it, with
+   mutations. The exons are separated by an intron of length
+   <intron_length> */
+static void align_protein_test_input(unsigned char **gen_seq_tran,
+                                     unsigned char **ref_seq_orig,
+                                     GthDPParam *dp_param,
+                                     GtUword gen_dp_length,
+                                     GtUword ref_dp_length,
+                                     GtUword intron_length,
+                                     const GthDPScoresProtein
+                                     *dp_scores_protein,
+                                     GtUint64 *state)
+{
+  static const char *aminos = "ACDEFGHIKLMNPQRSTVWYX*";
+  GtUword n, m;
+  *gen_seq_tran = gt_malloc(sizeof **gen_seq_tran * gen_dp_length);
+  *ref_seq_orig = gt_malloc(sizeof **ref_seq_orig * ref_dp_length);
+  dp_param->log_Pdonor = gt_malloc(sizeof (GthFlt) * gen_dp_length);
+  dp_param->log_1minusPdonor = gt_malloc(sizeof (GthFlt) * gen_dp_length);
+  dp_param->log_Pacceptor = gt_malloc(sizeof (GthFlt) * gen_dp_length);
+  dp_param->log_1minusPacceptor = gt_malloc(sizeof (GthFlt) * gen_dp_length);
+  for (n = 0; n < gen_dp_length; n++) {
+    double donor, acceptor;
+    (*gen_seq_tran)[n] = align_protein_test_random(state) % 4;
+    donor = (align_protein_test_random(state) % 100) / 1000.0 + 0.0001;
+    acceptor = (align_protein_test_random(state) % 100) / 1000.0 + 0.0001;
+    dp_param->log_Pdonor[n] = (GthFlt) log(donor);
+    dp_param->log_1minusPdonor[n] = (GthFlt) log(1.0 - donor);
+    dp_param->log_Pacceptor[n] = (GthFlt) log(acceptor);
+    dp_param->log_1minusPacceptor[n] = (GthFlt) log(1.0 - acceptor);
+  }
+  for (m = 0; m < ref_dp_length; m++) {
+    n = GT_MULT2(m) + m;
+    if (m >= ref_dp_length / 2)
+      n += intron_length;
+    (*ref_seq_orig)[m] = n + 2 < gen_dp_length &&
+                         align_protein_test_random(state) % 10
+                         ? dp_scores_protein->codon2amino[(*gen_seq_tran)[n]]
+                                                     [(*gen_seq_tran)[n+1]]
+                                                     [(*gen_seq_tran)[n+2]]
+                         : aminos[align_protein_test_random(state) % 22];
+  }
+}
+
+static void align_protein_test_input_delete(unsigned char *gen_seq_tran,
+                                            unsigned char *ref_seq_orig,
+                                            GthDPParam *dp_param)
+{
+  gt_free(dp_param->log_1minusPacceptor);
+  gt_free(dp_param->log_Pacceptor);
+  gt_free(dp_param->log_1minusPdonor);
+  gt_free(dp_param->log_Pdonor);
+  gt_free(ref_seq_orig);
+  gt_free(gen_seq_tran);
+}
+
+/* The following unit test computes the DP tables of random proteins which
+   were derived from random genomic sequences with an intron and compares their
+   hashes with those of the original (unoptimized) implementation, to make sure
+   that optimizations of the DP do not change any score or path decision. */
+int gth_align_protein_unit_test(GtError *err)
+{
+  static const struct {
+    GtUword gen_dp_length,
+            ref_dp_length,
+            intron_length;
+    bool proteinexonpenal;
+    GtUint64 hash;
+  } testcases[] = {
+    { 6, 2, 0, false, 12672635767543005288ULL },
+    { 150, 50, 0, true, 6898090062949106687ULL },
+    { 600, 150, 130, false, 4244819019999645339ULL },
+    { 1500, 400, 200, true, 17158636292580171784ULL }
+  };
+  GthDPOptionsCore *dp_options_core;
+  GthDPScoresProtein *dp_scores_protein;
+  GtScoreMatrix *score_matrix;
+  GtAlphabet *score_matrix_alpha;
+  GthStat *stat;
+  GtUint64 state = 42;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  dp_options_core = gth_dp_options_core_new();
+  score_matrix_alpha = gt_alphabet_new_protein();
+  score_matrix = align_protein_test_score_matrix(score_matrix_alpha);
+  dp_scores_protein = gth_dp_scores_protein_new(1, score_matrix,
+                                                score_matrix_alpha);
+  stat = gth_stat_new();
+  for (i = 0; !had_err && i < sizeof testcases / sizeof testcases[0]; i++) {
+    GtUword gen_dp_length = testcases[i].gen_dp_length,
+            ref_dp_length = testcases[i].ref_dp_length;
+    bool proteinexonpenal = testcases[i].proteinexonpenal;
+    unsigned char *gen_seq_tran, *ref_seq_orig;
+    GthAlignInputProtein input;
+    GthDPParam dp_param;
+    GthDPtables dpm;
+    GtUint64 hash;
+    align_protein_test_input(&gen_seq_tran, &ref_seq_orig, &dp_param,
+                             gen_dp_length, ref_dp_length,
+                             testcases[i].intron_length, dp_scores_protein,
+                             &state);
+    input.ref_seq_orig = ref_seq_orig;
+    input.score_matrix = score_matrix;
+    input.score_matrix_alpha = score_matrix_alpha;
+    had_err = dp_tables_alloc(&dpm, gen_dp_length, proteinexonpenal,
+                              ref_dp_length, 0, false, NULL, stat);
+    gt_ensure(!had_err);
+    if (!had_err) {
+      dp_tables_init(&dpm, proteinexonpenal, ref_dp_length);
+      complete_path_matrix(&dpm, &input, proteinexonpenal, gen_seq_tran,
+                           gen_dp_length, ref_dp_length, &dp_param,
+                           dp_options_core, dp_scores_protein);
+      hash = align_protein_test_tables_hash(&dpm, proteinexonpenal,
+                                            gen_dp_length, ref_dp_length);
+      if (hash != testcases[i].hash) {
+        gt_error_set(err, "DP tables of test case " GT_WU " have hash "
+                     GT_LLU " instead of " GT_LLU, i, hash,
+                     testcases[i].hash);
+        had_err = -1;
+      }
+      dp_tables_free(&dpm);
+    }
+    align_protein_test_input_delete(gen_seq_tran, ref_seq_orig, &dp_param);
+  }
+  gth_stat_delete(stat);
+  gth_dp_scores_protein_delete(dp_scores_protein);
+  gt_score_matrix_delete(score_matrix);
+  gt_alphabet_delete(score_matrix_alpha);
+  gth_dp_options_core_delete(dp_options_core);
+  return had_err;
+}
+
+int gth_align_protein_benchmark(GtUword gen_dp_length, GtUword ref_dp_length,
+                                GtUword runs, double *cells_per_second,
+                                GtError *err)
+{
+  GthDPOptionsCore *dp_options_core;
+  GthDPScoresProtein *dp_scores_protein;
+  GtScoreMatrix *score_matrix;
+  GtAlphabet *score_matrix_alpha;
+  unsigned char *gen_seq_tran, *ref_seq_orig;
+  GthAlignInputProtein input;
+  GthDPParam dp_param;
+  GthDPtables dpm;
+  GthStat *stat;
+  GtTimer *timer;
+  GtUint64 state = 42;
+  GtWord usec = 0;
+  GtUword r, intron_length = 0;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gen_dp_length && ref_dp_length && runs && cells_per_second);
+
+  dp_options_core = gth_dp_options_core_new();
+  score_matrix_alpha = gt_alphabet_new_protein();
+  score_matrix = align_protein_test_score_matrix(score_matrix_alpha);
+  dp_scores_protein = gth_dp_scores_protein_new(1, score_matrix,
+                                                score_matrix_alpha);
+  stat = gth_stat_new();
+  timer = gt_timer_new();
+  if (gen_dp_length > GT_MULT2(ref_dp_length) + ref_dp_length)
+    intron_length = gen_dp_length - GT_MULT2(ref_dp_length) - ref_dp_length;
+  align_protein_test_input(&gen_seq_tran, &ref_seq_orig, &dp_param,
+                           gen_dp_length, ref_dp_length, intron_length,
+                           dp_scores_protein, &state);
+  input.ref_seq_orig = ref_seq_orig;
+  input.score_matrix = score_matrix;
+  input.score_matrix_alpha = score_matrix_alpha;
+  for (r = 0; !had_err && r < runs; r++) {
+    if (dp_tables_alloc(&dpm, gen_dp_length, false, ref_dp_length, 0, false,
+                        NULL, stat)) {
+      gt_error_set(err, "could not allocate the DP tables of " GT_WU " x "
+                   GT_WU " cells", gen_dp_length + 1, ref_dp_length + 1);
+      had_err = -1;
+      break;
+    }
+    dp_tables_init(&dpm, false, ref_dp_length);
+    /* only the DP is measured, not the allocation of the tables */
+    gt_timer_start(timer);
+    complete_path_matrix(&dpm, &input, false, gen_seq_tran, gen_dp_length,
+                         ref_dp_length, &dp_param, dp_options_core,
+                         dp_scores_protein);
+    gt_timer_stop(timer);
+    usec += gt_timer_elapsed_usec(timer);
+    dp_tables_free(&dpm);
+  }
+  if (!had_err) {
+    *cells_per_second = usec > 0 ? (double) gen_dp_length * ref_dp_length *
+                                   runs / usec * 1000000.0
+                                 : 0.0;
+  }
+  align_protein_test_input_delete(gen_seq_tran, ref_seq_orig, &dp_param);
+  gt_timer_delete(timer);
+  gth_stat_delete(stat);
+  gth_dp_scores_protein_delete(dp_scores_protein);
+  gt_score_matrix_delete(score_matrix);
+  gt_alphabet_delete(score_matrix_alpha);
+  gth_dp_options_core_delete(dp_options_core);
+  return had_err;
+}
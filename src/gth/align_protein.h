@@ -87,4 +87,12 @@ int gth_align_protein(GthSA*,
                       GthStat*,
                       GtFile*);
 
+int  gth_align_protein_unit_test(GtError*);
+/* Computes the DP tables of a random protein of length <ref_dp_length> against
+   a random genomic sequence of length <gen_dp_length> <runs> times and stores
+   the number of DP cells computed per second in <cells_per_second>. */
+int  gth_align_protein_benchmark(GtUword gen_dp_length, GtUword ref_dp_length,
+                                 GtUword runs, double *cells_per_second,
+                                 GtError *err);
+
 #endif
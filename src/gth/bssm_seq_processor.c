@@ -25,7 +25,9 @@
 #include "core/ma_api.h"
 #include "core/mathsupport.h"
 #include "core/minmax.h"
+#include "core/multithread_api.h"
 #include "core/str_api.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/xposix.h"
 #include "extended/reverse_api.h"
@@ -715,6 +717,124 @@ void gth_bssm_seq_processor_squash(GthBSSMSeqProcessor *bsp)
   bssm_seqs_squash(bsp->intron_all);
 }
 
+/* the number of exons or introns which are processed by a thread at once */
+#define BSSM_SEQS_BLOCKSIZE  256
+
+/* the windows of all potential splice sites of an exon or intron are
+   contained in the exon or intron extended by this many bases on both ends */
+#define BSSM_FLANK_LENGTH    51
+
+/* the sites found in a block of exons or introns, per phase */
+typedef struct {
+  GtArray *don_gt[3],
+          *don_gc[3],
+          *acc[3];
+} BSSMSites;
+
+static void bssm_sites_init(BSSMSites *sites, unsigned int num_of_phases,
+                            bool gcdonor)
+{
+  unsigned int phase;
+  gt_assert(sites && num_of_phases <= 3);
+  for (phase = 0; phase < num_of_phases; phase++) {
+    sites->don_gt[phase] = gt_array_new(sizeof (BSSMSeq*));
+    if (gcdonor)
+      sites->don_gc[phase] = gt_array_new(sizeof (BSSMSeq*));
+    sites->acc[phase] = gt_array_new(sizeof (BSSMSeq*));
+  }
+}
+
+static void bssm_sites_free(BSSMSites *sites)
+{
+  unsigned int phase;
+  gt_assert(sites);
+  for (phase = 0; phase < 3; phase++) {
+    if (sites->don_gt[phase])
+      bssm_seqs_delete(sites->don_gt[phase]);
+    if (sites->don_gc[phase])
+      bssm_seqs_delete(sites->don_gc[phase]);
+    if (sites->acc[phase])
+      bssm_seqs_delete(sites->acc[phase]);
+  }
+}
+
+/* moves the sites from <src> to the end of <dest> and frees <src> */
+static void bssm_sites_move(BSSMSites *dest, BSSMSites *src)
+{
+  unsigned int phase;
+  gt_assert(dest && src);
+  for (phase = 0; phase < 3; phase++) {
+    if (src->don_gt[phase]) {
+      gt_array_add_array(dest->don_gt[phase], src->don_gt[phase]);
+      gt_array_delete(src->don_gt[phase]);
+    }
+    if (src->don_gc[phase]) {
+      gt_array_add_array(dest->don_gc[phase], src->don_gc[phase]);
+      gt_array_delete(src->don_gc[phase]);
+    }
+    if (src->acc[phase]) {
+      gt_array_add_array(dest->acc[phase], src->acc[phase]);
+      gt_array_delete(src->acc[phase]);
+    }
+  }
+}
+
+typedef struct {
+  GtArray *seqs;
+  GtRegionMapping *region_mapping;
+  BSSMSites *block_sites;
+  GtUword num_of_blocks,
+          next_block;
+  bool true_sites,
+       proc_exons,
+       gcdonor,
+       had_err;
+  GtMutex *mutex; /* protects <next_block>, <had_err>, <err>, and the region
+                     mapping, which is not thread-safe */
+  GtError *err;
+} BSSMSiteFinder;
+
+/* the flanking sequence of an exon or intron, which is fetched once and
+   contains the windows of all its potential splice sites */
+typedef struct {
+  char *seq;
+  GtUword start, /* the (1-based) position of <seq> */
+          sequence_length;
+} BSSMFlank;
+
+static int bssm_flank_fetch(BSSMFlank *flank, const BSSMSeq *s,
+                            BSSMSiteFinder *finder, GtError *err)
+{
+  GtUword end;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(flank && s && finder);
+  gt_assert(!flank->seq);
+  gt_mutex_lock(finder->mutex);
+  had_err = gt_region_mapping_get_sequence_length(finder->region_mapping,
+                                                  &flank->sequence_length,
+                                                  s->seqid, err);
+  if (!had_err) {
+    flank->start = s->range.start > BSSM_FLANK_LENGTH
+                   ? s->range.start - BSSM_FLANK_LENGTH : 1;
+    end = MIN(s->range.end + BSSM_FLANK_LENGTH, flank->sequence_length);
+    had_err = gt_region_mapping_get_sequence(finder->region_mapping,
+                                             &flank->seq, s->seqid,
+                                             flank->start, end, err);
+  }
+  gt_mutex_unlock(finder->mutex);
+  return had_err;
+}
+
+static const char* bssm_flank_window(const BSSMFlank *flank,
+                                     const GtRange *window)
+{
+  gt_assert(flank && flank->seq && window);
+  gt_assert(window->start >= flank->start);
+  gt_assert(window->end <= flank->sequence_length);
+  return flank->seq + window->start - flank->start;
+}
+
 static int get_true_seq(GtArray *true_sites, BSSMSeq *intron,
                         const char *sequence,
                         GT_UNUSED GtUword sequence_length,
@@ -738,10 +858,8 @@ static int get_true_seq(GtArray *true_sites, BSSMSeq *intron,
   return had_err;
 }
 
-static int find_true_sites(GtArray *true_don_gt, GtArray *true_don_gc,
-                           GtArray *true_acc, GtArray *introns,
-                           GtRegionMapping *region_mapping, bool gcdonor,
-                           GtError *err)
+static int find_true_sites(BSSMSites *sites, GtUword from, GtUword to,
+                           BSSMSiteFinder *finder, GtError *err)
 {
   GtUword i, len;
   bool don_underflow, acc_underflow;
@@ -751,31 +869,30 @@ static int find_true_sites(GtArray *true_don_gt, GtArray *true_don_gc,
   GtStr *seq;
   int had_err = 0;
   gt_error_check(err);
-  gt_assert(true_don_gt && true_acc && introns && region_mapping);
+  gt_assert(sites && finder);
   seq = gt_str_new();
-  for (i = 0; !had_err && i < gt_array_size(introns); i++) {
-    intron = *(BSSMSeq**) gt_array_get(introns, i);
+  for (i = from; !had_err && i < to; i++) {
+    intron = *(BSSMSeq**) gt_array_get(finder->seqs, i);
     len = gt_str_length(intron->seq);
     if (len >= 4) {
       cseq = gt_str_get(intron->seq);
       if (  (cseq[0]     == 'G' || cseq[0]     == 'g') &&
            ((cseq[1]     == 'T' || cseq[1]     == 't') ||
-            (gcdonor &&
+            (finder->gcdonor &&
             (cseq[1]     == 'C' || cseq[1]     == 'c'))) &&
             (cseq[len-2] == 'A' || cseq[len-2] == 'a') &&
             (cseq[len-1] == 'G' || cseq[len-1] == 'g')) {
-        GtUword sequence_length;
-        char *sequence = NULL;
+        BSSMFlank flank = { NULL, 0, 0 };
         /* correct splice site found -> get flanking sequences */
         if (!intron->reverse) {
-          if (intron->range.start >= 50) {
+          if (intron->range.start > 50) {
             don_range.start = intron->range.start - 50;
             don_underflow = false;
           }
           else
             don_underflow = true;
           don_range.end   = intron->range.start + 51;
-          if (intron->range.end >= 51) {
+          if (intron->range.end > 51) {
             acc_range.start = intron->range.end - 51;
             acc_underflow = false;
           }
@@ -784,14 +901,14 @@ static int find_true_sites(GtArray *true_don_gt, GtArray *true_don_gc,
           acc_range.end = intron->range.end + 50;
         }
         else {
-          if (intron->range.end >= 51) {
+          if (intron->range.end > 51) {
             don_range.start = intron->range.end - 51;
             don_underflow = false;
           }
           else
             don_underflow = true;
           don_range.end = intron->range.end + 50;
-          if (intron->range.start >= 50) {
+          if (intron->range.start > 50) {
             acc_range.start = intron->range.start - 50;
             acc_underflow = false;
           }
@@ -799,47 +916,32 @@ static int find_true_sites(GtArray *true_don_gt, GtArray *true_don_gc,
             acc_underflow = true;
           acc_range.end = intron->range.start + 51;
         }
+        if (!don_underflow || !acc_underflow)
+          had_err = bssm_flank_fetch(&flank, intron, finder, err);
         /* donor sequence */
-        if (!had_err && !don_underflow) {
-          had_err = gt_region_mapping_get_sequence_length(region_mapping,
-                                                          &sequence_length,
-                                                          intron->seqid, err);
-          if (!had_err && don_range.end <= sequence_length) {
-            had_err = gt_region_mapping_get_sequence(region_mapping, &sequence,
-                                                     intron->seqid,
-                                                     don_range.start,
-                                                     don_range.end, err);
-            if (!had_err) {
-              if (cseq[1] == 'T' || cseq[1] == 't') {
-                had_err = get_true_seq(true_don_gt, intron, sequence,
-                                       sequence_length, seq, &don_range, err);
-              }
-              else {
-                gt_assert(gcdonor && (cseq[1] == 'C' || cseq[1] == 'c'));
-                had_err = get_true_seq(true_don_gc, intron, sequence,
-                                       sequence_length, seq, &don_range, err);
-              }
-              gt_free(sequence);
-            }
+        if (!had_err && !don_underflow &&
+            don_range.end <= flank.sequence_length) {
+          const char *sequence = bssm_flank_window(&flank, &don_range);
+          if (cseq[1] == 'T' || cseq[1] == 't') {
+            had_err = get_true_seq(sites->don_gt[0], intron, sequence,
+                                   flank.sequence_length, seq, &don_range,
+                                   err);
+          }
+          else {
+            gt_assert(finder->gcdonor && (cseq[1] == 'C' || cseq[1] == 'c'));
+            had_err = get_true_seq(sites->don_gc[0], intron, sequence,
+                                   flank.sequence_length, seq, &don_range,
+                                   err);
           }
         }
         /* acceptor sequence */
-        if (!had_err && !acc_underflow) {
-          had_err = gt_region_mapping_get_sequence_length(region_mapping,
-                                                          &sequence_length,
-                                                          intron->seqid, err);
-          if (!had_err && acc_range.end <= sequence_length) {
-            had_err = gt_region_mapping_get_sequence(region_mapping, &sequence,
-                                                     intron->seqid,
-                                                     acc_range.start,
-                                                     acc_range.end, err);
-            if (!had_err) {
-              had_err = get_true_seq(true_acc, intron, sequence,
-                                     sequence_length, seq, &acc_range, err);
-              gt_free(sequence);
-            }
-          }
+        if (!had_err && !acc_underflow &&
+            acc_range.end <= flank.sequence_length) {
+          had_err = get_true_seq(sites->acc[0], intron,
+                                 bssm_flank_window(&flank, &acc_range),
+                                 flank.sequence_length, seq, &acc_range, err);
         }
+        gt_free(flank.seq);
       }
     }
   }
@@ -847,58 +949,8 @@ static int find_true_sites(GtArray *true_don_gt, GtArray *true_don_gc,
   return had_err;
 }
 
-int gth_bssm_seq_processor_find_true_sites(GthBSSMSeqProcessor *bsp,
-                                           GtRegionMapping *region_mapping,
-                                           GtError *err)
-{
-  int had_err;
-
-  gt_error_check(err);
-  gt_assert(bsp && region_mapping);
-  gt_assert(!bsp->i0_true_don_gt);
-  gt_assert(!bsp->i0_true_don_gc);
-  gt_assert(!bsp->i0_true_acc);
-  gt_assert(!bsp->i1_true_don_gt);
-  gt_assert(!bsp->i1_true_don_gc);
-  gt_assert(!bsp->i1_true_acc);
-  gt_assert(!bsp->i2_true_don_gt);
-  gt_assert(!bsp->i2_true_don_gc);
-  gt_assert(!bsp->i2_true_acc);
-
-  bsp->i0_true_don_gt = gt_array_new(sizeof (BSSMSeq*));
-  bsp->i0_true_acc = gt_array_new(sizeof (BSSMSeq*));
-  bsp->i1_true_don_gt = gt_array_new(sizeof (BSSMSeq*));
-  bsp->i1_true_acc = gt_array_new(sizeof (BSSMSeq*));
-  bsp->i2_true_don_gt = gt_array_new(sizeof (BSSMSeq*));
-  bsp->i2_true_acc = gt_array_new(sizeof (BSSMSeq*));
-
-  if (bsp->gcdonor) {
-    bsp->i0_true_don_gc = gt_array_new(sizeof (BSSMSeq*));
-    bsp->i1_true_don_gc = gt_array_new(sizeof (BSSMSeq*));
-    bsp->i2_true_don_gc = gt_array_new(sizeof (BSSMSeq*));
-  }
-
-  had_err = find_true_sites(bsp->i0_true_don_gt, bsp->i0_true_don_gc,
-                            bsp->i0_true_acc, bsp->intron_0, region_mapping,
-                            bsp->gcdonor, err);
-  if (!had_err) {
-    had_err = find_true_sites(bsp->i1_true_don_gt, bsp->i1_true_don_gc,
-                              bsp->i1_true_acc, bsp->intron_1, region_mapping,
-                              bsp->gcdonor, err);
-  }
-  if (!had_err) {
-    had_err = find_true_sites(bsp->i2_true_don_gt, bsp->i2_true_don_gc,
-                              bsp->i2_true_acc, bsp->intron_2, region_mapping,
-                              bsp->gcdonor, err);
-  }
-
-  return had_err;
-}
-
-static int get_false_don_seq(GtArray *false_don_0_gt, GtArray *false_don_0_gc,
-                             GtArray *false_don_1_gt, GtArray *false_don_1_gc,
-                             GtArray *false_don_2_gt, GtArray *false_don_2_gc,
-                             BSSMSeq *intron, const char *sequence,
+static int get_false_don_seq(BSSMSites *sites, BSSMSeq *intron,
+                             const char *sequence,
                              GT_UNUSED GtUword sequence_length,
                              GtStr *seq, const GtRange *don_range,
                              bool proc_exons, GT_UNUSED bool gcdonor,
@@ -926,29 +978,17 @@ static int get_false_don_seq(GtArray *false_don_0_gt, GtArray *false_don_0_gc,
                              intron->phase, seq);
     if (proc_exons)
       phase = (intron->phase + j) % 3;
-    if (iseq[51] == 'T' || iseq[51] == 't') {
-      switch (phase) {
-        case 0: gt_array_add(false_don_0_gt, false_seq); break;
-        case 1: gt_array_add(false_don_1_gt, false_seq); break;
-        case 2: gt_array_add(false_don_2_gt, false_seq); break;
-        default: gt_assert(0);
-      }
-    }
+    if (iseq[51] == 'T' || iseq[51] == 't')
+      gt_array_add(sites->don_gt[phase], false_seq);
     else {
       gt_assert(gcdonor && (iseq[51] == 'C' || iseq[51] == 'c'));
-      switch (phase) {
-        case 0: gt_array_add(false_don_0_gc, false_seq); break;
-        case 1: gt_array_add(false_don_1_gc, false_seq); break;
-        case 2: gt_array_add(false_don_2_gc, false_seq); break;
-        default: gt_assert(0);
-      }
+      gt_array_add(sites->don_gc[phase], false_seq);
     }
   }
   return had_err;
 }
 
-static int get_false_acc_seq(GtArray *false_acc_0, GtArray *false_acc_1,
-                             GtArray *false_acc_2, BSSMSeq *intron,
+static int get_false_acc_seq(BSSMSites *sites, BSSMSeq *intron,
                              const char *sequence,
                              GT_UNUSED GtUword sequence_length,
                              GtStr *seq, const GtRange *acc_range,
@@ -977,51 +1017,39 @@ static int get_false_acc_seq(GtArray *false_acc_0, GtArray *false_acc_1,
                              intron->phase, seq);
     if (proc_exons)
       phase = (intron->phase + j) % 3;
-    switch (phase) {
-      case 0: gt_array_add(false_acc_0, false_seq); break;
-      case 1: gt_array_add(false_acc_1, false_seq); break;
-      case 2: gt_array_add(false_acc_2, false_seq); break;
-      default: gt_assert(0);
-    }
+    gt_array_add(sites->acc[phase], false_seq);
   }
   return had_err;
 }
 
-static int find_false_sites(GtArray *false_don_0_gt, GtArray *false_don_0_gc,
-                            GtArray *false_acc_0,
-                            GtArray *false_don_1_gt, GtArray *false_don_1_gc,
-                            GtArray *false_acc_1,
-                            GtArray *false_don_2_gt, GtArray *false_don_2_gc,
-                            GtArray *false_acc_2,
-                            GtArray *seqs, bool proc_exons,
-                            GtRegionMapping *region_mapping, bool gcdonor,
-                            GtError *err)
+static int find_false_sites(BSSMSites *sites, GtUword from, GtUword to,
+                            BSSMSiteFinder *finder, GtError *err)
 {
   GtUword i, j, len;
-  bool don_underflow, acc_underflow;
+  bool don_underflow, acc_underflow, proc_exons = finder->proc_exons,
+       gcdonor = finder->gcdonor;
   const char *cseq;
   GtRange don_range = {0}, acc_range = {0};
   BSSMSeq *intron;
   GtStr *seq;
   int had_err = 0;
   gt_error_check(err);
-  gt_assert(false_don_0_gt && false_acc_0 && seqs && region_mapping && err);
+  gt_assert(sites && finder && err);
   seq = gt_str_new();
-  for (i = 0; !had_err && i < gt_array_size(seqs); i++) {
-    intron = *(BSSMSeq**) gt_array_get(seqs, i);
+  for (i = from; !had_err && i < to; i++) {
+    intron = *(BSSMSeq**) gt_array_get(finder->seqs, i);
     len = gt_str_length(intron->seq);
     if (len >= 2) {
+      BSSMFlank flank = { NULL, 0, 0 };
       cseq = gt_str_get(intron->seq);
       for (j = 0; !had_err && j < len - 1; j++) {
-        GtUword sequence_length;
-        char *sequence = NULL;
         if ((proc_exons || j) && /* skip true donor site */
              (cseq[j]   == 'G' || cseq[j]   == 'g') &&
             ((cseq[j+1] == 'T' || cseq[j+1] == 't') ||
              (gcdonor &&
              (cseq[j+1] == 'C' || cseq[j+1] == 'c')))) {
           if (!intron->reverse) {
-            if (intron->range.start + j >= 50) {
+            if (intron->range.start + j > 50) {
               don_range.start = intron->range.start + j - 50;
               don_underflow = false;
             }
@@ -1030,7 +1058,7 @@ static int find_false_sites(GtArray *false_don_0_gt, GtArray *false_don_0_gc,
             don_range.end = intron->range.start + j + 51;
           }
           else {
-            if (intron->range.end >= j + 51) {
+            if (intron->range.end > j + 51) {
               don_range.start = intron->range.end - j - 51;
               don_underflow = false;
             }
@@ -1039,31 +1067,21 @@ static int find_false_sites(GtArray *false_don_0_gt, GtArray *false_don_0_gc,
             don_range.end = intron->range.end - j + 50;
           }
           /* donor sequence */
-          if (!had_err && !don_underflow) {
-            had_err = gt_region_mapping_get_sequence_length(region_mapping,
-                                                            &sequence_length,
-                                                            intron->seqid, err);
-            if (!had_err && don_range.end < sequence_length) {
-              had_err = gt_region_mapping_get_sequence(region_mapping,
-                                                       &sequence, intron->seqid,
-                                                       don_range.start,
-                                                       don_range.end, err);
-              if (!had_err) {
-               had_err = get_false_don_seq(false_don_0_gt, false_don_0_gc,
-                                           false_don_1_gt, false_don_1_gc,
-                                           false_don_2_gt, false_don_2_gc,
-                                           intron, sequence, sequence_length,
-                                           seq, &don_range, proc_exons, gcdonor,
-                                           j, err);
-              }
-            }
+          if (!don_underflow && !flank.seq)
+            had_err = bssm_flank_fetch(&flank, intron, finder, err);
+          if (!had_err && !don_underflow &&
+              don_range.end < flank.sequence_length) {
+            had_err = get_false_don_seq(sites, intron,
+                                        bssm_flank_window(&flank, &don_range),
+                                        flank.sequence_length, seq, &don_range,
+                                        proc_exons, gcdonor, j, err);
           }
         }
         else  if ((proc_exons || j < len - 2) && /* skip true acceptor sites */
                   (cseq[j]   == 'A' || cseq[j]   == 'a') &&
                   (cseq[j+1] == 'G' || cseq[j+1] == 'g')) {
           if (!intron->reverse) {
-            if (intron->range.start + j >= 50) {
+            if (intron->range.start + j > 50) {
               acc_range.start = intron->range.start + j - 50;
               acc_underflow = false;
             }
@@ -1072,7 +1090,7 @@ static int find_false_sites(GtArray *false_don_0_gt, GtArray *false_don_0_gc,
             acc_range.end = intron->range.start + j + 51;
           }
           else {
-            if (intron->range.end >= j + 51) {
+            if (intron->range.end > j + 51) {
               acc_range.start = intron->range.end - j - 51;
               acc_underflow = false;
             }
@@ -1081,36 +1099,173 @@ static int find_false_sites(GtArray *false_don_0_gt, GtArray *false_don_0_gc,
             acc_range.end = intron->range.end - j + 50;
           }
           /* acceptor sequence */
-          if (!had_err && !acc_underflow) {
-            had_err = gt_region_mapping_get_sequence_length(region_mapping,
-                                                            &sequence_length,
-                                                            intron->seqid, err);
-            if (!had_err && acc_range.end < sequence_length) {
-              had_err = gt_region_mapping_get_sequence(region_mapping,
-                                                       &sequence, intron->seqid,
-                                                       acc_range.start,
-                                                       acc_range.end, err);
-              if (!had_err) {
-                had_err = get_false_acc_seq(false_acc_0, false_acc_1,
-                                            false_acc_2, intron, sequence,
-                                            sequence_length, seq, &acc_range,
-                                            proc_exons, j, err);
-              }
-            }
+          if (!acc_underflow && !flank.seq)
+            had_err = bssm_flank_fetch(&flank, intron, finder, err);
+          if (!had_err && !acc_underflow &&
+              acc_range.end < flank.sequence_length) {
+            had_err = get_false_acc_seq(sites, intron,
+                                        bssm_flank_window(&flank, &acc_range),
+                                        flank.sequence_length, seq, &acc_range,
+                                        proc_exons, j, err);
           }
         }
-        gt_free(sequence);
       }
+      gt_free(flank.seq);
     }
   }
   gt_str_delete(seq);
   return had_err;
 }
 
+static void* find_sites_thread(void *data)
+{
+  BSSMSiteFinder *finder = data;
+  GtUword block, from, to;
+  GtError *err;
+  int had_err = 0;
+  gt_assert(finder);
+
+  err = gt_error_new();
+  while (!had_err) {
+    gt_mutex_lock(finder->mutex);
+    if (finder->had_err || finder->next_block == finder->num_of_blocks) {
+      gt_mutex_unlock(finder->mutex);
+      break;
+    }
+    block = finder->next_block++;
+    gt_mutex_unlock(finder->mutex);
+
+    from = block * BSSM_SEQS_BLOCKSIZE;
+    to = MIN(from + BSSM_SEQS_BLOCKSIZE, gt_array_size(finder->seqs));
+    bssm_sites_init(finder->block_sites + block,
+                    finder->proc_exons ? 3 : 1, finder->gcdonor);
+    if (finder->true_sites) {
+      had_err = find_true_sites(finder->block_sites + block, from, to, finder,
+                                err);
+    }
+    else {
+      had_err = find_false_sites(finder->block_sites + block, from, to,
+                                 finder, err);
+    }
+    if (had_err) {
+      gt_mutex_lock(finder->mutex);
+      if (!finder->had_err) {
+        finder->had_err = true;
+        gt_error_set(finder->err, "%s", gt_error_get(err));
+      }
+      gt_mutex_unlock(finder->mutex);
+    }
+  }
+  gt_error_delete(err);
+  return NULL;
+}
+
+/* The following function finds the true (if <true_sites> is set) or the false
+   splice sites of the exons or introns <seqs> and appends them to <sites>.
+   The exons or introns are processed in blocks by <gt_jobs> threads, each of
+   which collects the sites of a block separately. Afterwards, the sites are
+   appended in the order of the blocks, i.e., in the same order as if <seqs>
+   had been processed sequentially. */
+static int find_sites(BSSMSites *sites, GtArray *seqs, bool true_sites,
+                      bool proc_exons, GtRegionMapping *region_mapping,
+                      bool gcdonor, GtError *err)
+{
+  BSSMSiteFinder finder;
+  GtUword i;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(sites && seqs && region_mapping);
+
+  finder.seqs = seqs;
+  finder.region_mapping = region_mapping;
+  finder.num_of_blocks = (gt_array_size(seqs) + BSSM_SEQS_BLOCKSIZE - 1) /
+                         BSSM_SEQS_BLOCKSIZE;
+  finder.block_sites = gt_calloc(finder.num_of_blocks,
+                                 sizeof *finder.block_sites);
+  finder.next_block = 0;
+  finder.true_sites = true_sites;
+  finder.proc_exons = proc_exons;
+  finder.gcdonor = gcdonor;
+  finder.had_err = false;
+  finder.mutex = gt_mutex_new();
+  finder.err = err;
+
+  had_err = gt_multithread(find_sites_thread, &finder, err);
+  if (!had_err && finder.had_err)
+    had_err = -1;
+
+  for (i = 0; i < finder.num_of_blocks; i++) {
+    if (!had_err)
+      bssm_sites_move(sites, finder.block_sites + i);
+    else
+      bssm_sites_free(finder.block_sites + i);
+  }
+
+  gt_mutex_delete(finder.mutex);
+  gt_free(finder.block_sites);
+  return had_err;
+}
+
+int gth_bssm_seq_processor_find_true_sites(GthBSSMSeqProcessor *bsp,
+                                           GtRegionMapping *region_mapping,
+                                           GtError *err)
+{
+  BSSMSites sites = { { NULL } };
+  int had_err;
+
+  gt_error_check(err);
+  gt_assert(bsp && region_mapping);
+  gt_assert(!bsp->i0_true_don_gt);
+  gt_assert(!bsp->i0_true_don_gc);
+  gt_assert(!bsp->i0_true_acc);
+  gt_assert(!bsp->i1_true_don_gt);
+  gt_assert(!bsp->i1_true_don_gc);
+  gt_assert(!bsp->i1_true_acc);
+  gt_assert(!bsp->i2_true_don_gt);
+  gt_assert(!bsp->i2_true_don_gc);
+  gt_assert(!bsp->i2_true_acc);
+
+  bsp->i0_true_don_gt = gt_array_new(sizeof (BSSMSeq*));
+  bsp->i0_true_acc = gt_array_new(sizeof (BSSMSeq*));
+  bsp->i1_true_don_gt = gt_array_new(sizeof (BSSMSeq*));
+  bsp->i1_true_acc = gt_array_new(sizeof (BSSMSeq*));
+  bsp->i2_true_don_gt = gt_array_new(sizeof (BSSMSeq*));
+  bsp->i2_true_acc = gt_array_new(sizeof (BSSMSeq*));
+
+  if (bsp->gcdonor) {
+    bsp->i0_true_don_gc = gt_array_new(sizeof (BSSMSeq*));
+    bsp->i1_true_don_gc = gt_array_new(sizeof (BSSMSeq*));
+    bsp->i2_true_don_gc = gt_array_new(sizeof (BSSMSeq*));
+  }
+
+  sites.don_gt[0] = bsp->i0_true_don_gt;
+  sites.don_gc[0] = bsp->i0_true_don_gc;
+  sites.acc[0] = bsp->i0_true_acc;
+  had_err = find_sites(&sites, bsp->intron_0, true, false, region_mapping,
+                       bsp->gcdonor, err);
+  if (!had_err) {
+    sites.don_gt[0] = bsp->i1_true_don_gt;
+    sites.don_gc[0] = bsp->i1_true_don_gc;
+    sites.acc[0] = bsp->i1_true_acc;
+    had_err = find_sites(&sites, bsp->intron_1, true, false, region_mapping,
+                         bsp->gcdonor, err);
+  }
+  if (!had_err) {
+    sites.don_gt[0] = bsp->i2_true_don_gt;
+    sites.don_gc[0] = bsp->i2_true_don_gc;
+    sites.acc[0] = bsp->i2_true_acc;
+    had_err = find_sites(&sites, bsp->intron_2, true, false, region_mapping,
+                         bsp->gcdonor, err);
+  }
+
+  return had_err;
+}
+
 int gth_bssm_seq_processor_find_false_sites(GthBSSMSeqProcessor *bsp,
                                             GtRegionMapping *region_mapping,
                                             GtError *err)
 {
+  BSSMSites sites = { { NULL } };
   int had_err = 0;
 
   gt_error_check(err);
@@ -1144,39 +1299,35 @@ int gth_bssm_seq_processor_find_false_sites(GthBSSMSeqProcessor *bsp,
     bsp->i_false_don_gc = gt_array_new(sizeof (BSSMSeq*));
   }
 
-  had_err = find_false_sites(bsp->i_false_don_gt, bsp->i_false_don_gc,
-                             bsp->i_false_acc, NULL, NULL, NULL, NULL, NULL,
-                             NULL, bsp->intron_all, false, region_mapping,
-                             bsp->gcdonor, err);
+  sites.don_gt[0] = bsp->i_false_don_gt;
+  sites.don_gc[0] = bsp->i_false_don_gc;
+  sites.acc[0] = bsp->i_false_acc;
+  had_err = find_sites(&sites, bsp->intron_all, false, false, region_mapping,
+                       bsp->gcdonor, err);
+
+  sites.don_gt[0] = bsp->e0_false_don_gt;
+  sites.don_gc[0] = bsp->e0_false_don_gc;
+  sites.acc[0] = bsp->e0_false_acc;
+  sites.don_gt[1] = bsp->e1_false_don_gt;
+  sites.don_gc[1] = bsp->e1_false_don_gc;
+  sites.acc[1] = bsp->e1_false_acc;
+  sites.don_gt[2] = bsp->e2_false_don_gt;
+  sites.don_gc[2] = bsp->e2_false_don_gc;
+  sites.acc[2] = bsp->e2_false_acc;
 
   if (!had_err) {
-    had_err = find_false_sites(bsp->e0_false_don_gt, bsp->e0_false_don_gc,
-                               bsp->e0_false_acc,
-                               bsp->e1_false_don_gt, bsp->e1_false_don_gc,
-                               bsp->e1_false_acc,
-                               bsp->e2_false_don_gt, bsp->e2_false_don_gc,
-                               bsp->e2_false_acc, bsp->exon_0, true,
-                               region_mapping, bsp->gcdonor, err);
+    had_err = find_sites(&sites, bsp->exon_0, false, true, region_mapping,
+                         bsp->gcdonor, err);
   }
 
   if (!had_err) {
-    had_err = find_false_sites(bsp->e0_false_don_gt, bsp->e0_false_don_gc,
-                               bsp->e0_false_acc,
-                               bsp->e1_false_don_gt, bsp->e1_false_don_gc,
-                               bsp->e1_false_acc,
-                               bsp->e2_false_don_gt, bsp->e2_false_don_gc,
-                               bsp->e2_false_acc, bsp->exon_1, true,
-                               region_mapping, bsp->gcdonor, err);
+    had_err = find_sites(&sites, bsp->exon_1, false, true, region_mapping,
+                         bsp->gcdonor, err);
   }
 
   if (!had_err) {
-    had_err = find_false_sites(bsp->e0_false_don_gt, bsp->e0_false_don_gc,
-                               bsp->e0_false_acc,
-                               bsp->e1_false_don_gt, bsp->e1_false_don_gc,
-                               bsp->e1_false_acc,
-                               bsp->e2_false_don_gt, bsp->e2_false_don_gc,
-                               bsp->e2_false_acc, bsp->exon_2, true,
-                               region_mapping, bsp->gcdonor, err);
+    had_err = find_sites(&sites, bsp->exon_2, false, true, region_mapping,
+                         bsp->gcdonor, err);
   }
 
   return had_err;
@@ -17,6 +17,7 @@
 
 #include "core/unused_api.h"
 #include "gth/chaining.h"
+#include "gth/seed_matcher.h"
 
 #define POLYATAILFILTERALPHASIZE                4
 #define SHOW_CHAIN_CALCULATION_STATUS_BUF_SIZE  160
@@ -614,28 +615,48 @@ int gth_match_processor(GthMatchProcessorInfo *info, GthSeqCon *gen_seq_con,
   return 0;
 }
 
-void gth_chaining(GthChainCollection *chain_collection,
-                  GtUword gen_file_num,
-                  GtUword ref_file_num,
-                  GthCallInfo *call_info,
-                  GthInput *input,
-                  GthStat *stat,
-                  bool directmatches,
-                  const GthPlugins *plugins)
+int gth_chaining(GthChainCollection *chain_collection,
+                 GtUword gen_file_num,
+                 GtUword ref_file_num,
+                 GthCallInfo *call_info,
+                 GthInput *input,
+                 GthStat *stat,
+                 bool directmatches,
+                 const GthPlugins *plugins,
+                 GtError *err)
 {
   GtUword i, numofsequences = 0;
   GtArray *matches;
   GthChainingInfo chaining_info;
   void *matcher_arguments;
+  GthMatcherArgumentsNew matcher_arguments_new;
+  GthMatcherArgumentsDelete matcher_arguments_delete;
+  GthMatcherRunner matcher_runner;
   GtFile *outfp = call_info->out->outfp;
   GthMatchProcessorInfo match_processor_info;
   bool refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
+  int had_err;
 
-  /* make sure matcher is defined */
+  gt_error_check(err);
   gt_assert(plugins);
-  gt_assert(plugins->matcher_arguments_new);
-  gt_assert(plugins->matcher_arguments_delete);
-  gt_assert(plugins->matcher_runner);
+
+  /* select matcher: the built-in seed index matcher can only be used for
+     cDNA/EST files */
+  if (refseqisdna &&
+      (call_info->simfilterparam.seedindex || !plugins->matcher_runner)) {
+    matcher_arguments_new = gth_seed_matcher_arguments_new;
+    matcher_arguments_delete = gth_seed_matcher_arguments_delete;
+    matcher_runner = gth_seed_matcher_run;
+  }
+  else {
+    /* make sure matcher is defined */
+    gt_assert(plugins->matcher_arguments_new);
+    gt_assert(plugins->matcher_arguments_delete);
+    gt_assert(plugins->matcher_runner);
+    matcher_arguments_new = plugins->matcher_arguments_new;
+    matcher_arguments_delete = plugins->matcher_arguments_delete;
+    matcher_runner = plugins->matcher_runner;
+  }
 
   /* init */
   matches = gt_array_new(sizeof (GthMatch));
@@ -644,7 +665,7 @@ void gth_chaining(GthChainCollection *chain_collection,
                      input, stat, gen_file_num, ref_file_num);
 
   matcher_arguments =
-    plugins->matcher_arguments_new(true,
+    matcher_arguments_new(true,
                           input,
                           call_info->simfilterparam.inverse || !refseqisdna
                           ? gth_input_get_genomic_filename(input, gen_file_num)
@@ -704,22 +725,26 @@ void gth_chaining(GthChainCollection *chain_collection,
   gth_input_delete_current(input);
 
   /* call matcher */
-  if (call_info->out->showverbose)
-    call_info->out->showverbose("call vmatch to compute matches");
+  if (call_info->out->showverbose) {
+    call_info->out->showverbose(matcher_runner == gth_seed_matcher_run
+                                ? "call seed matcher to compute matches"
+                                : "call vmatch to compute matches");
+  }
 
-  plugins->matcher_runner(matcher_arguments, call_info->out->showverbose,
-                          call_info->out->showverboseVM, &match_processor_info);
+  had_err = matcher_runner(matcher_arguments, call_info->out->showverbose,
+                           call_info->out->showverboseVM,
+                           &match_processor_info, err);
 
   /* free matcher stuff here, because otherwise the reference file is mapped
      twice below */
-  plugins->matcher_arguments_delete(matcher_arguments);
+  matcher_arguments_delete(matcher_arguments);
 
   /* free sequence collections (if they have been filled by the matcher) */
   gth_seq_con_delete(match_processor_info.gen_seq_con);
   gth_seq_con_delete(match_processor_info.ref_seq_con);
 
   /* save match numbers of match number distribution, if necessary */
-  if (gth_stat_get_matchnumdistri(stat)) {
+  if (!had_err && gth_stat_get_matchnumdistri(stat)) {
     for (i = 0; i < numofsequences; i++) {
       if (match_processor_info.matchnumcounter[i] > 0) {
         gth_stat_add_to_matchnumdistri(stat,
@@ -731,12 +756,17 @@ void gth_chaining(GthChainCollection *chain_collection,
   /* free match number counter */
   gt_free(match_processor_info.matchnumcounter);
 
+  if (had_err) {
+    gt_array_delete(matches);
+    return -1;
+  }
+
   /* return if no match has been found */
   if (!gt_array_size(matches)) {
     if (call_info->out->comments)
       gt_file_xprintf(outfp, "%c no match has been found\n", COMMENTCHAR);
     gt_array_delete(matches);
-    return;
+    return 0;
   }
 
   /* load genomic file back into memory */
@@ -765,4 +795,6 @@ void gth_chaining(GthChainCollection *chain_collection,
 
   /* free */
   gt_array_delete(matches);
+
+  return 0;
 }
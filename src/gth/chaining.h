@@ -26,14 +26,15 @@
 #include "gth/matcher.h"
 #include "gth/plugins.h"
 
-void gth_chaining(GthChainCollection *chain_collection,
+int  gth_chaining(GthChainCollection *chain_collection,
                   GtUword gen_file_num,
                   GtUword ref_file_num,
                   GthCallInfo*,
                   GthInput*,
                   GthStat*,
                   bool directmatches,
-                  const GthPlugins *plugins);
+                  const GthPlugins *plugins,
+                  GtError *err);
 
 typedef struct {
   bool directmatches,
@@ -18,7 +18,9 @@
 #ifndef DEFAULT_H
 #define DEFAULT_H
 
+#include <limits.h>
 #include "core/trans_table_api.h"
+#include "core/types_api.h"
 
 /*
   This file contains all default values of GenomeThreader.
@@ -48,6 +50,7 @@
 #define GTH_DEFAULT_INVERSE            false
 #define GTH_DEFAULT_EXACT              false
 #define GTH_DEFAULT_EDIST              false
+#define GTH_DEFAULT_SEEDINDEX          false
 #define GTH_DEFAULT_NOAUTOINDEX        false
 #define GTH_DEFAULT_CREATEINDICESONLY  false
 #define GTH_DEFAULT_SKIPINDEXCHECK     false
@@ -102,6 +105,11 @@
 #define GTH_DEFAULT_DPMININTRONLENGTH    50
 #define GTH_DEFAULT_SHORTEXONPENALTY     100.0
 #define GTH_DEFAULT_SHORTINTRONPENALTY   100.0
+#define GTH_DEFAULT_DPMAXMATRIXSIZE      0
+/* the largest maximal matrix size (in megabytes) which is addressable */
+#define GTH_MAX_DPMAXMATRIXSIZE \
+        ((GT_UWORD_MAX >> 20) < UINT_MAX \
+         ? (unsigned int) (GT_UWORD_MAX >> 20) : UINT_MAX)
 
 #define GTH_DEFAULT_JTOVERLAP            5
 #define GTH_DEFAULT_JTDEBUG              false
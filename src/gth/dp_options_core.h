@@ -30,6 +30,9 @@ typedef struct {
                dpminintronlength; /* minimum intron length */
   double shortexonpenalty,        /* penalty for short exons */
          shortintronpenalty;      /* penalty for short introns */
+  unsigned int dpmaxmatrixsize;   /* maximal size of a backtrace matrix in
+                                     megabytes, larger matrices are computed
+                                     with checkpoints (0 = no limit) */
   GtRange btmatrixgenrange,
           btmatrixrefrange;
   GtUword jtoverlap;
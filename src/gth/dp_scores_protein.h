@@ -37,6 +37,19 @@ static inline GthFlt GTHGETSCORE(GthDPScoresProtein *scores,
   return scores->score[scores->codon2amino[n1][n2][n3]][aa];
 }
 
+/* Returns the row of <scores> for the codon <n1>, <n2>, <n3>, that is,
+   GTHGETSCOREROW(scores, n1, n2, n3)[aa] equals
+   GTHGETSCORE(scores, n1, n2, n3, aa). */
+static inline const GthFlt* GTHGETSCOREROW(GthDPScoresProtein *scores,
+                                           GtUchar n1, GtUchar n2, GtUchar n3)
+{
+  if (n1 == DASH || n2 == DASH || n3 == DASH)
+    return scores->score[DASH];
+  else if (n1 > 3 || n2 > 3 || n3 > 3)
+    return scores->score[WILDCARD];
+  return scores->score[scores->codon2amino[n1][n2][n3]];
+}
+
 GthDPScoresProtein* gth_dp_scores_protein_new(GtUword translationtable,
                                               GtScoreMatrix *score_matrix,
                                               GtAlphabet
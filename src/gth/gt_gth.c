@@ -15,6 +15,9 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
+#include "core/version_api.h"
+#include "core/versionfunc.h"
 #include "gth/gthxml.h"
 #include "gth/call_info.h"
 #include "gth/gt_gth.h"
@@ -23,6 +26,7 @@
 #include "gth/parse_options.h"
 #include "gth/similarity_filter.h"
 #include "gth/run_header.h"
+#include "gth/seq_con_encseq.h"
 
 int gt_gth(int argc, const char **argv, const GthPlugins *plugins, GtError *err)
 {
@@ -113,3 +117,14 @@ int gt_gth(int argc, const char **argv, const GthPlugins *plugins, GtError *err)
 
   return had_err;
 }
+
+int gt_gth_encseq(int argc, const char **argv, GtError *err)
+{
+  GthPlugins plugins;
+  memset(&plugins, 0, sizeof plugins);
+  plugins.file_preprocessor = gth_seq_con_encseq_preprocess;
+  plugins.seq_con_new = gth_seq_con_encseq_new;
+  plugins.gth_version = gt_version();
+  plugins.gth_version_func = gt_versionfunc;
+  return gt_gth(argc, argv, &plugins, err);
+}
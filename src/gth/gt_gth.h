@@ -24,4 +24,8 @@
 /* the GenomeThreader similarity-based gene structure prediction tool */
 int gt_gth(int argc, const char **argv, const GthPlugins *plugins, GtError*);
 
+/* <gt_gth()> with the plugins for sequence collections based on encoded
+   sequences and the built-in seed matcher (cDNA/EST files only) */
+int gt_gth_encseq(int argc, const char **argv, GtError*);
+
 #endif
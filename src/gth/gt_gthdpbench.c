@@ -0,0 +1,138 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/ma_api.h"
+#include "core/option_api.h"
+#include "core/str_api.h"
+#include "core/unused_api.h"
+#include "gth/align_dna.h"
+#include "gth/align_protein.h"
+#include "gth/gt_gthdpbench.h"
+
+typedef struct {
+  GtStr *model;
+  GtUword genlen,
+          cdnalen,
+          proteinlen,
+          runs;
+} GthDPBenchArguments;
+
+static void* gt_gthdpbench_arguments_new(void)
+{
+  GthDPBenchArguments *arguments = gt_calloc(1, sizeof *arguments);
+  arguments->model = gt_str_new();
+  return arguments;
+}
+
+static void gt_gthdpbench_arguments_delete(void *tool_arguments)
+{
+  GthDPBenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->model);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_gthdpbench_option_parser_new(void *tool_arguments)
+{
+  GthDPBenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  static const char *models[] = { "both", "dna", "protein", NULL };
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...]",
+                            "Show the cell update rates of the DP of the DNA "
+                            "and the protein model of gth on random "
+                            "sequences.");
+
+  option = gt_option_new_choice("model", "benchmark the DP of the DNA model, "
+                                "the protein model or both\n"
+                                "choose from both|dna|protein",
+                                arguments->model, models[0], models);
+  gt_option_parser_add_option(op, option);
+
+  /* the DP of the protein model needs at least one codon */
+  option = gt_option_new_uword_min("genlen", "length of the genomic sequence",
+                                   &arguments->genlen, 3000UL, 3UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("cdnalen", "length of the cDNA",
+                                   &arguments->cdnalen, 1000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("proteinlen", "length of the protein",
+                                   &arguments->proteinlen, 300UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("runs", "number of DPs computed with every "
+                                   "model", &arguments->runs, 5UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 0);
+  return op;
+}
+
+static void gt_gthdpbench_show(const char *model, GtUword genlen,
+                               GtUword reflen, GtUword runs,
+                               double cells_per_second)
+{
+  printf("%-8s "GT_WU" x "GT_WU" cells, "GT_WU" runs, %.1f MCUPS\n", model,
+         genlen, reflen, runs, cells_per_second / 1000000.0);
+}
+
+static int gt_gthdpbench_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
+                                GT_UNUSED int parsed_args,
+                                void *tool_arguments, GtError *err)
+{
+  GthDPBenchArguments *arguments = tool_arguments;
+  const char *model;
+  double cells_per_second;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  model = gt_str_get(arguments->model);
+  if (strcmp(model, "protein")) {
+    had_err = gth_align_dna_benchmark(arguments->genlen, arguments->cdnalen,
+                                      arguments->runs, &cells_per_second,
+                                      err);
+    if (!had_err) {
+      gt_gthdpbench_show("DNA", arguments->genlen, arguments->cdnalen,
+                         arguments->runs, cells_per_second);
+    }
+  }
+  if (!had_err && strcmp(model, "dna")) {
+    had_err = gth_align_protein_benchmark(arguments->genlen,
+                                          arguments->proteinlen,
+                                          arguments->runs, &cells_per_second,
+                                          err);
+    if (!had_err) {
+      gt_gthdpbench_show("protein", arguments->genlen, arguments->proteinlen,
+                         arguments->runs, cells_per_second);
+    }
+  }
+  return had_err;
+}
+
+GtTool* gt_gthdpbench(void)
+{
+  return gt_tool_new(gt_gthdpbench_arguments_new,
+                     gt_gthdpbench_arguments_delete,
+                     gt_gthdpbench_option_parser_new,
+                     NULL,
+                     gt_gthdpbench_runner);
+}
@@ -21,6 +21,7 @@
 /* file suffixes for different indices */
 #define DNASUFFIX               "dna"
 #define POLYASUFFIX             "polya"
+#define SEEDINDEXSUFFIX         "sdx"
 #define MAXSUFFIXLEN            14
 
 /* the name of the environment variable containing the path for gth data */
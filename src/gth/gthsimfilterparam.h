@@ -39,6 +39,8 @@ typedef struct {
        inverse,                  /* invert query and index */
        exact,                    /* compute exact matches */
        edist,                    /* use edist instead of exdrop */
+       seedindex,                /* use the built-in seed index instead of
+                                    vmatch for cDNA/EST files */
        noautoindex,              /* do not create indices automatically */
        createindicesonly,        /* stop the program flow after the indices have
                                     been created */
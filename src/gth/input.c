@@ -95,27 +95,33 @@ GthInput *gth_input_new(GthInputFilePreprocessor file_preprocessor,
   return input;
 }
 
-static void create_md5_cache_files(GthInput *input)
+static int create_md5_cache_files(GthInput *input, GtError *err)
 {
   GthMD5Cache *md5_cache;
   const char *filename;
   GthSeqCon *seq_con;
   GtStr *indexname;
   GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
   gt_assert(input);
   indexname = gt_str_new();
-  for (i = 0; i < gt_str_array_size(input->genomicfiles); i++) {
+  for (i = 0; !had_err && i < gt_str_array_size(input->genomicfiles); i++) {
     filename = gth_input_get_genomic_filename(input, i);
     gt_str_set(indexname, filename);
     gt_str_append_char(indexname, '.');
     gt_str_append_cstr(indexname, DNASUFFIX);
     seq_con = input->seq_con_constructor(gt_str_get(indexname),
-                                         false, true,false);
+                                         false, true, false, err);
+    if (!seq_con) {
+      had_err = -1;
+      break;
+    }
     md5_cache = gth_md5_cache_new(filename, seq_con);
     gth_md5_cache_delete(md5_cache);
     gth_seq_con_delete(seq_con);
   }
-  for (i = 0; i < gt_str_array_size(input->referencefiles); i++) {
+  for (i = 0; !had_err && i < gt_str_array_size(input->referencefiles); i++) {
     GthAlphatype alphatype = gth_input_get_alphatype(input, i);
     filename = gth_input_get_reference_filename(input, i);
     gt_str_set(indexname, filename);
@@ -124,12 +130,17 @@ static void create_md5_cache_files(GthInput *input)
                                   ? DNASUFFIX
                                   : gt_str_get(input->proteinsmap));
     seq_con = input->seq_con_constructor(gt_str_get(indexname),
-                                         false, true, false);
+                                         false, true, false, err);
+    if (!seq_con) {
+      had_err = -1;
+      break;
+    }
     md5_cache = gth_md5_cache_new(filename, seq_con);
     gth_md5_cache_delete(md5_cache);
     gth_seq_con_delete(seq_con);
   }
   gt_str_delete(indexname);
+  return had_err;
 }
 
 int gth_input_preprocess(GthInput *input,
@@ -166,7 +177,7 @@ int gth_input_preprocess(GthInput *input,
     /* for performance reasons (mapping of all index files), this is only done
        if <createindicesonly> is <true>. otherwise, this is done automatically,
        if the corresponding cache is accessed. */
-    create_md5_cache_files(input);
+    had_err = create_md5_cache_files(input, err);
   }
   return had_err;
 }
@@ -513,6 +524,7 @@ void gth_input_load_genomic_file_func(GthInput *input, GtUword gen_file_num,
   if (input->gen_file_num != gen_file_num) {
     const char *genomic_filename;
     GtStr *indexname;
+    GtError *err;
 
     /* free old genomic file */
     if (input->gen_file_num != GT_UNDEF_UWORD) {
@@ -528,10 +540,14 @@ void gth_input_load_genomic_file_func(GthInput *input, GtUword gen_file_num,
     indexname = gt_str_new_cstr(genomic_filename);
     gt_str_append_char(indexname, '.');
     gt_str_append_cstr(indexname, DNASUFFIX);
+    err = gt_error_new();
     input->gen_seq_con =
       input->seq_con_constructor(gt_str_get(indexname),
                                  input->searchmode & GTHREVERSE,
-                                 !translate, translate);
+                                 !translate, translate, err);
+    /* the index has been checked by the file preprocessor */
+    gt_assert(input->gen_seq_con);
+    gt_error_delete(err);
     gt_str_delete(indexname);
     input->genomic_translate = translate;
 
@@ -572,6 +588,7 @@ void gth_input_load_reference_file_func(GthInput *input, GtUword ref_file_num,
     const char *reference_filename;
     GthAlphatype alphatype;
     GtStr *indexname;
+    GtError *err;
 
     /* free old reference file */
     if (input->ref_file_num != GT_UNDEF_UWORD) {
@@ -595,15 +612,19 @@ void gth_input_load_reference_file_func(GthInput *input, GtUword ref_file_num,
     gt_str_append_cstr(indexname, alphatype == DNA_ALPHA
                                   ? DNASUFFIX
                                   : gt_str_get(input->proteinsmap));
+    err = gt_error_new();
     if (alphatype == DNA_ALPHA) {
       input->ref_seq_con = input->seq_con_constructor(gt_str_get(indexname),
                                                       true, !translate,
-                                                      translate);
+                                                      translate, err);
     }
     else {
       input->ref_seq_con = input->seq_con_constructor(gt_str_get(indexname),
-                                                      false, true, true);
+                                                      false, true, true, err);
     }
+    /* the index has been checked by the file preprocessor */
+    gt_assert(input->ref_seq_con);
+    gt_error_delete(err);
     gt_str_delete(indexname);
     input->reference_translate = translate;
 
@@ -43,7 +43,8 @@ typedef void* (*GthMatcherArgumentsNew)(bool checksubstrspec,
                                         bool usepolyasuffix,
                                         bool dbmaskmatch);
 typedef void  (*GthMatcherArgumentsDelete)(void *matcher_arguments);
-typedef void  (*GthMatcherRunner)(void *matcher_arguments, GthShowVerbose,
-                                  GthShowVerboseVM, void *match_processor_data);
+typedef int   (*GthMatcherRunner)(void *matcher_arguments, GthShowVerbose,
+                                  GthShowVerboseVM, void *match_processor_data,
+                                  GtError *err);
 
 #endif
@@ -157,6 +157,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optinverse = NULL,              /* sim. filter, vmatch */
          *optexact = NULL,                /* sim. filter, vmatch */
          *optedist = NULL,                /* sim. filter, vmatch */
+         *optseedindex = NULL,            /* sim. filter */
          *optmaxnumofmatches = NULL,      /* sim. filter, vmatch */
          *optfragweightfactor = NULL,     /* sim. filter, before gl. chaining */
          *optgcmaxgapwidth = NULL,        /* sim. filter, global chaining */
@@ -186,6 +187,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optdpminintronlength = NULL,    /* short exon/intron parameters */
          *optshortexonpenalty = NULL,     /* short exon/intron parameters */
          *optshortintronpenalty = NULL,   /* short exon/intron parameters */
+         *optdpmaxmatrixsize = NULL,      /* memory bound of the DP */
          *optbtmatrixgenrange = NULL,
          *optbtmatrixrefrange = NULL,
          *optjtoverlap = NULL,
@@ -655,6 +657,18 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_parser_add_option(op, optedist);
   }
 
+  /* -seedindex */
+  if (!gthconsensus_parsing) {
+    optseedindex = gt_option_new_bool("seedindex", "use the built-in seed "
+                                      "index of the genomic file instead of "
+                                      "vmatch to compute the exact matches "
+                                      "of cDNA/EST files",
+                                      &call_info->simfilterparam.seedindex,
+                                      GTH_DEFAULT_SEEDINDEX);
+    gt_option_is_extended_option(optseedindex);
+    gt_option_parser_add_option(op, optseedindex);
+  }
+
   /* -maxnumofmatches */
   if (!gthconsensus_parsing) {
     optmaxnumofmatches = gt_option_new_uword("maxnumofmatches", "set the "
@@ -992,6 +1006,21 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_parser_add_option(op, optshortintronpenalty);
   }
 
+  /* -dpmaxmatrixsize */
+  if (!gthconsensus_parsing) {
+    optdpmaxmatrixsize =
+      gt_option_new_uint_max("dpmaxmatrixsize", "set the maximal size of a "
+                             "backtrace matrix of the cDNA/EST DP in "
+                             "megabytes, larger matrices are computed with "
+                             "checkpoints in less memory at about twice the "
+                             "running time (0 = no limit)",
+                             &call_info->dp_options_core->dpmaxmatrixsize,
+                             GTH_DEFAULT_DPMAXMATRIXSIZE,
+                             GTH_MAX_DPMAXMATRIXSIZE);
+    gt_option_is_extended_option(optdpmaxmatrixsize);
+    gt_option_parser_add_option(op, optdpmaxmatrixsize);
+  }
+
   /* -btmatrixgenrage */
   if (!gthconsensus_parsing) {
     optbtmatrixgenrange = gt_option_new_range("btmatrixgenrange", "set the "
@@ -1296,6 +1325,12 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_exclude(optxmlout, optshowseqnums);
   if (optexact && optedist)
     gt_option_exclude(optexact, optedist);
+  if (optseedindex && optseedlength)
+    gt_option_exclude(optseedindex, optseedlength);
+  if (optseedindex && optexdrop)
+    gt_option_exclude(optseedindex, optexdrop);
+  if (optseedindex && optedist)
+    gt_option_exclude(optseedindex, optedist);
   if (optmaskpolyatails && optnoautoindex)
     gt_option_exclude(optmaskpolyatails, optnoautoindex);
   if (optproteinsmap && optnoautoindex)
@@ -156,6 +156,41 @@ GthSA* gth_sa_new_and_set(bool gen_strand_forward,
   return sa;
 }
 
+static GtStr* sa_clone_str(const GtStr *str)
+{
+  return str ? gt_str_clone(str) : NULL;
+}
+
+GthSA* gth_sa_new_like(const GthSA *sa, bool gen_strand_forward,
+                       bool ref_strand_forward)
+{
+  GthSA *new_sa;
+  gt_assert(sa);
+  new_sa = gth_sa_new();
+  new_sa->gen_strand_forward = gen_strand_forward;
+  new_sa->ref_strand_forward = ref_strand_forward;
+  /* the strings are copied rather than referenced, because the reference
+     counts of strings from the caches must only be changed by the thread
+     which accesses the input */
+  gt_str_set(new_sa->gen_id, gt_str_get(sa->gen_id));
+  gt_str_set(new_sa->ref_id, gt_str_get(sa->ref_id));
+  new_sa->gen_md5 = sa_clone_str(sa->gen_md5);
+  new_sa->ref_md5 = sa_clone_str(sa->ref_md5);
+  new_sa->gen_desc = sa_clone_str(sa->gen_desc);
+  new_sa->ref_desc = sa_clone_str(sa->ref_desc);
+  new_sa->call_number = sa->call_number;
+  new_sa->gen_total_length = sa->gen_total_length;
+  new_sa->gen_offset = sa->gen_offset;
+  new_sa->ref_total_length = sa->ref_total_length;
+  gth_backtrace_path_set_ref_dp_length(new_sa->backtrace_path,
+                                       sa->ref_total_length);
+  new_sa->gen_file_num = sa->gen_file_num;
+  new_sa->gen_seq_num = sa->gen_seq_num;
+  new_sa->ref_file_num = sa->ref_file_num;
+  new_sa->ref_seq_num = sa->ref_seq_num;
+  return new_sa;
+}
+
 void gth_sa_set(GthSA *sa, GthAlphatype ref_alphatype,
                 GtUword gen_dp_start, GtUword gen_dp_length)
 {
@@ -986,6 +1021,12 @@ GtUword gth_sa_call_number(const GthSA *sa)
   return sa->call_number;
 }
 
+void gth_sa_set_call_number(GthSA *sa, GtUword call_number)
+{
+  gt_assert(sa);
+  sa->call_number = call_number;
+}
+
 static void set_gff3_target_attribute(GthSA *sa, bool md5ids)
 {
   gt_assert(sa && !sa->gff3_target_attribute);
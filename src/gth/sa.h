@@ -80,6 +80,10 @@ GthSA*         gth_sa_new_and_set(bool gen_strand_forward,
                                   GtUword gen_total_length,
                                   GtUword gen_offset,
                                   GtUword ref_total_length);
+/* create a new sa for the sequences of <sa> with the given strand directions,
+   unlike gth_sa_new_and_set() the input is not accessed */
+GthSA*         gth_sa_new_like(const GthSA *sa, bool gen_strand_forward,
+                               bool ref_strand_forward);
 void            gth_sa_set(GthSA*, GthAlphatype ref_alphatype,
                            GtUword gen_dp_start,
                            GtUword gen_dp_length);
@@ -222,6 +226,7 @@ void            gth_sa_set_highest_cov(GthSA*, bool genomic);
 GtUword   gth_sa_cumlen_scored_exons(const GthSA*);
 void            gth_sa_set_cumlen_scored_exons(GthSA*, GtUword);
 GtUword   gth_sa_call_number(const GthSA*);
+void            gth_sa_set_call_number(GthSA*, GtUword call_number);
 const char*     gth_sa_gff3_target_attribute(GthSA*, bool md5ids);
 void            gth_sa_determine_cutoffs(GthSA*, GthCutoffmode leadcutoffsmode,
                                          GthCutoffmode termcutoffsmode,
@@ -0,0 +1,516 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/intbits.h"
+#include "core/ma_api.h"
+#include "core/md5_encoder_api.h"
+#include "core/minmax.h"
+#include "core/str_api.h"
+#include "core/undef_api.h"
+#include "core/xansi_api.h"
+#include "gth/gthdef.h"
+#include "gth/seed_index.h"
+#include "gth/seq_con_encseq.h"
+
+#define SEED_INDEX_MAGIC       ((GtUword) 0x47534458UL) /* "GSDX" */
+#define SEED_INDEX_VERSION     ((GtUword) 2)
+
+/* the MD5 sum of the sequences is stored in 32 bit pieces, one per word */
+#define SEED_INDEX_MD5WORDS    4
+
+/* buckets with more than <SEED_INDEX_MAXBUCKETFACTOR> times the average number
+   of positions (but at least <SEED_INDEX_MINMAXBUCKETSIZE>) belong to
+   repetitive words. They are left empty, otherwise every seed of such a word
+   would be extended at all of its occurrences. */
+#define SEED_INDEX_MAXBUCKETFACTOR   64
+#define SEED_INDEX_MINMAXBUCKETSIZE  1024
+
+/* the cache file and the computed index consist of GtUwords: the header,
+   followed by the <numofbuckets> + 1 bucket boundaries and the positions */
+typedef enum {
+  SEED_INDEX_HEADER_MAGIC,
+  SEED_INDEX_HEADER_VERSION,
+  SEED_INDEX_HEADER_PREFIXLENGTH,
+  SEED_INDEX_HEADER_TOTALLENGTH,
+  SEED_INDEX_HEADER_NUMOFSEQS,
+  SEED_INDEX_HEADER_MD5,
+  SEED_INDEX_HEADER_MAXBUCKETSIZE = SEED_INDEX_HEADER_MD5 + SEED_INDEX_MD5WORDS,
+  SEED_INDEX_HEADER_NUMOFPOSITIONS,
+  SEED_INDEX_HEADERSIZE
+} SeedIndexHeader;
+
+struct GthSeedIndex {
+  unsigned int prefixlength;
+  GtUword numofbuckets,
+          numofpositions,
+          *data,           /* header, bucket boundaries, and positions */
+          *bucketstart,
+          *positions;
+  bool mapped;             /* <data> is the memory mapped cache file */
+};
+
+static void seed_index_set_tables(GthSeedIndex *seed_index)
+{
+  seed_index->numofpositions =
+    seed_index->data[SEED_INDEX_HEADER_NUMOFPOSITIONS];
+  seed_index->bucketstart = seed_index->data + SEED_INDEX_HEADERSIZE;
+  seed_index->positions = seed_index->bucketstart +
+                          seed_index->numofbuckets + 1;
+}
+
+/* stores the MD5 sum of the transformed genomic sequences (including the
+   separators) in <md5> */
+static void seed_index_md5(GthSeqCon *gen_seq_con, GtUword totallength,
+                           GtUword *md5)
+{
+  const char *seq = (const char*) gth_seq_con_get_tran_seq(gen_seq_con, 0);
+  unsigned char output[16];
+  GtMD5Encoder *enc;
+  GtUword i;
+  enc = gt_md5_encoder_new();
+  for (i = 0; i + 64 <= totallength; i += 64)
+    gt_md5_encoder_add_block(enc, seq + i, 64);
+  gt_md5_encoder_add_block(enc, seq + i, totallength - i);
+  gt_md5_encoder_finish(enc, output, NULL);
+  gt_md5_encoder_delete(enc);
+  for (i = 0; i < SEED_INDEX_MD5WORDS; i++) {
+    md5[i] = ((GtUword) output[4*i] << 24) | ((GtUword) output[4*i+1] << 16) |
+             ((GtUword) output[4*i+2] << 8) | (GtUword) output[4*i+3];
+  }
+}
+
+static bool seed_index_read(GthSeedIndex *seed_index, const char *filename,
+                            GtUword totallength, GtUword numofseqs,
+                            const GtUword *md5)
+{
+  GtUword *data;
+  size_t len;
+  gt_assert(seed_index && filename && md5);
+  data = gt_fa_mmap_read(filename, &len, NULL);
+  if (!data ||
+      len < sizeof (GtUword) * (SEED_INDEX_HEADERSIZE +
+                                seed_index->numofbuckets + 1) ||
+      data[SEED_INDEX_HEADER_MAGIC] != SEED_INDEX_MAGIC ||
+      data[SEED_INDEX_HEADER_VERSION] != SEED_INDEX_VERSION ||
+      data[SEED_INDEX_HEADER_PREFIXLENGTH] != seed_index->prefixlength ||
+      data[SEED_INDEX_HEADER_TOTALLENGTH] != totallength ||
+      data[SEED_INDEX_HEADER_NUMOFSEQS] != numofseqs ||
+      memcmp(data + SEED_INDEX_HEADER_MD5, md5,
+             sizeof (GtUword) * SEED_INDEX_MD5WORDS) ||
+      len != sizeof (GtUword) * (SEED_INDEX_HEADERSIZE +
+                                 seed_index->numofbuckets + 1 +
+                                 data[SEED_INDEX_HEADER_NUMOFPOSITIONS])) {
+    /* the cache file is outdated or invalid */
+    gt_fa_xmunmap(data);
+    return false;
+  }
+  seed_index->data = data;
+  seed_index->mapped = true;
+  seed_index_set_tables(seed_index);
+  return true;
+}
+
+/* the following function computes the index in two scans over the genomic
+   sequences. The first counts the occurrences of every word, the second
+   stores the positions from right to left, such that every bucket is sorted
+   in ascending order. The positions of repetitive words are skipped. */
+static void seed_index_compute(GthSeedIndex *seed_index,
+                               GthSeqCon *gen_seq_con, GtUword totallength,
+                               const GtUword *md5)
+{
+  GtUword i, j, s, code, valid, sum, seqlength, numofseqs, *bucketstart,
+          maxbucketsize, mask = seed_index->numofbuckets - 1,
+          shift = 2 * (seed_index->prefixlength - 1);
+  const unsigned int prefixlength = seed_index->prefixlength;
+  const GtUchar *seq;
+  GtBitsequence *skipped;
+  GtRange range;
+
+  numofseqs = gth_seq_con_num_of_seqs(gen_seq_con);
+  bucketstart = gt_calloc(seed_index->numofbuckets + 1, sizeof *bucketstart);
+
+  /* count the words which do not contain wildcards */
+  for (s = 0; s < numofseqs; s++) {
+    seq = gth_seq_con_get_tran_seq(gen_seq_con, s);
+    seqlength = gth_seq_con_get_length(gen_seq_con, s);
+    for (j = 0, code = 0, valid = 0; j < seqlength; j++) {
+      if (seq[j] >= 4) {
+        valid = 0;
+        continue;
+      }
+      code = ((code << 2) | seq[j]) & mask;
+      if (++valid >= prefixlength)
+        bucketstart[code]++;
+    }
+  }
+
+  /* compute the end of every bucket, the repetitive words get no positions */
+  for (i = 0, sum = 0; i < seed_index->numofbuckets; i++)
+    sum += bucketstart[i];
+  maxbucketsize = MAX(SEED_INDEX_MINMAXBUCKETSIZE,
+                      SEED_INDEX_MAXBUCKETFACTOR *
+                      ((sum + seed_index->numofbuckets - 1) /
+                       seed_index->numofbuckets));
+  GT_INITBITTAB(skipped, seed_index->numofbuckets);
+  for (i = 0, sum = 0; i < seed_index->numofbuckets; i++) {
+    if (bucketstart[i] <= maxbucketsize)
+      sum += bucketstart[i];
+    else
+      GT_SETIBIT(skipped, i);
+    bucketstart[i] = sum;
+  }
+  bucketstart[seed_index->numofbuckets] = sum;
+
+  seed_index->data = gt_malloc(sizeof (GtUword) *
+                               (SEED_INDEX_HEADERSIZE +
+                                seed_index->numofbuckets + 1 + sum));
+  seed_index->data[SEED_INDEX_HEADER_MAGIC] = SEED_INDEX_MAGIC;
+  seed_index->data[SEED_INDEX_HEADER_VERSION] = SEED_INDEX_VERSION;
+  seed_index->data[SEED_INDEX_HEADER_PREFIXLENGTH] = prefixlength;
+  seed_index->data[SEED_INDEX_HEADER_TOTALLENGTH] = totallength;
+  seed_index->data[SEED_INDEX_HEADER_NUMOFSEQS] = numofseqs;
+  memcpy(seed_index->data + SEED_INDEX_HEADER_MD5, md5,
+         sizeof (GtUword) * SEED_INDEX_MD5WORDS);
+  seed_index->data[SEED_INDEX_HEADER_MAXBUCKETSIZE] = maxbucketsize;
+  seed_index->data[SEED_INDEX_HEADER_NUMOFPOSITIONS] = sum;
+  seed_index_set_tables(seed_index);
+
+  /* store the positions, the code of the word starting at position <j> is
+     computed from the code of the word starting at position <j>+1 */
+  for (s = numofseqs; s > 0; s--) {
+    seq = gth_seq_con_get_tran_seq(gen_seq_con, s - 1);
+    seqlength = gth_seq_con_get_length(gen_seq_con, s - 1);
+    range = gth_seq_con_get_range(gen_seq_con, s - 1);
+    for (j = seqlength, code = 0, valid = 0; j > 0; j--) {
+      if (seq[j-1] >= 4) {
+        valid = 0;
+        continue;
+      }
+      code = (code >> 2) | ((GtUword) seq[j-1] << shift);
+      if (++valid >= prefixlength && !GT_ISIBITSET(skipped, code))
+        seed_index->positions[--bucketstart[code]] = range.start + j - 1;
+    }
+  }
+  gt_assert(!bucketstart[0]);
+
+  memcpy(seed_index->bucketstart, bucketstart,
+         sizeof (GtUword) * (seed_index->numofbuckets + 1));
+  gt_free(skipped);
+  gt_free(bucketstart);
+}
+
+/* the index is written to a temporary file which replaces <filename> when it
+   is complete, therefore concurrent runs never map a partially written index
+   and no file locking is necessary */
+static void seed_index_write(const GthSeedIndex *seed_index,
+                             const char *filename)
+{
+  GtStr *tmpfilename;
+  GtError *err;
+  size_t numofwords;
+  FILE *fp;
+  gt_assert(seed_index && filename);
+  /* the index is only a cache, if it cannot be written it is recomputed the
+     next time */
+  tmpfilename = gt_str_new();
+  err = gt_error_new();
+  if ((fp = gt_fa_fopen_replacement(filename, tmpfilename, err))) {
+    numofwords = SEED_INDEX_HEADERSIZE + seed_index->numofbuckets + 1 +
+                 seed_index->numofpositions;
+    (void) gt_fa_fclose_replacement(fp, filename, tmpfilename,
+                                    fwrite(seed_index->data, sizeof (GtUword),
+                                           numofwords, fp) != numofwords,
+                                    err);
+  }
+  gt_error_delete(err);
+  gt_str_delete(tmpfilename);
+}
+
+GthSeedIndex* gth_seed_index_new(const char *genomicfile,
+                                 GthSeqCon *gen_seq_con,
+                                 unsigned int prefixlength,
+                                 bool use_cache_file)
+{
+  GthSeedIndex *seed_index;
+  GtUword totallength, numofseqs, md5[SEED_INDEX_MD5WORDS];
+  bool reading_succeeded = false;
+  GtStr *filename;
+  gt_assert(genomicfile && gen_seq_con);
+  gt_assert(prefixlength > 0 && prefixlength <= GTH_SEED_INDEX_MAXPREFIXLENGTH);
+  gt_assert(gt_alphabet_num_of_chars(gth_seq_con_get_alphabet(gen_seq_con))
+            == 4);
+
+  seed_index = gt_calloc(1, sizeof *seed_index);
+  seed_index->prefixlength = prefixlength;
+  seed_index->numofbuckets = (GtUword) 1 << (2 * prefixlength);
+  totallength = gth_seq_con_total_length(gen_seq_con);
+  numofseqs = gth_seq_con_num_of_seqs(gen_seq_con);
+  seed_index_md5(gen_seq_con, totallength, md5);
+
+  filename = gt_str_new_cstr(genomicfile);
+  gt_str_append_char(filename, '.');
+  gt_str_append_cstr(filename, DNASUFFIX);
+  gt_str_append_char(filename, '.');
+  gt_str_append_cstr(filename, SEEDINDEXSUFFIX);
+  if (use_cache_file && gt_file_exists(gt_str_get(filename)) &&
+      !gt_file_is_newer(genomicfile, gt_str_get(filename))) {
+    /* only try to read the cache file if the genomic file was not modified in
+       the meantime */
+    reading_succeeded = seed_index_read(seed_index, gt_str_get(filename),
+                                        totallength, numofseqs, md5);
+  }
+  if (!reading_succeeded) {
+    seed_index_compute(seed_index, gen_seq_con, totallength, md5);
+    if (use_cache_file)
+      seed_index_write(seed_index, gt_str_get(filename));
+  }
+  gt_str_delete(filename);
+  return seed_index;
+}
+
+void gth_seed_index_delete(GthSeedIndex *seed_index)
+{
+  if (!seed_index) return;
+  if (seed_index->mapped)
+    gt_fa_xmunmap(seed_index->data);
+  else
+    gt_free(seed_index->data);
+  gt_free(seed_index);
+}
+
+unsigned int gth_seed_index_prefixlength(const GthSeedIndex *seed_index)
+{
+  gt_assert(seed_index);
+  return seed_index->prefixlength;
+}
+
+GtUword gth_seed_index_get_positions(const GthSeedIndex *seed_index,
+                                     GtUword code, const GtUword **positions)
+{
+  gt_assert(seed_index && code < seed_index->numofbuckets && positions);
+  *positions = seed_index->positions + seed_index->bucketstart[code];
+  return seed_index->bucketstart[code+1] - seed_index->bucketstart[code];
+}
+
+/* writes random DNA sequences of the given lengths with some wildcards and a
+   poly-A sequence, whose words are repetitive for all prefix lengths > 1, to a
+   temporary file, whose name is stored in <filename> */
+static void seed_index_write_random_seqs(GtStr *filename,
+                                         const GtUword *seqlengths,
+                                         GtUword numofseqs)
+{
+  GtUword i, j;
+  FILE *fp;
+  fp = gt_xtmpfp(filename);
+  for (i = 0; i < numofseqs; i++) {
+    fprintf(fp, ">seq" GT_WU "\n", i);
+    for (j = 0; j < seqlengths[i]; j++) {
+      fputc(random() % 50 ? "acgt"[random() % 4] : 'n', fp);
+      if (j % 60 == 59 || j == seqlengths[i] - 1)
+        fputc('\n', fp);
+    }
+  }
+  fprintf(fp, ">polyA\n");
+  for (j = 0; j < SEED_INDEX_MINMAXBUCKETSIZE + 100; j++)
+    fputc('a', fp);
+  fputc('\n', fp);
+  gt_fa_xfclose(fp);
+}
+
+static void seed_index_remove_files(const char *filename)
+{
+  static const char *suffixes[] = { "", ".dna.esq", ".dna.des", ".dna.sds",
+                                    ".dna.ssp", ".dna.md5",
+                                    ".dna." SEEDINDEXSUFFIX };
+  GtStr *path = gt_str_new();
+  size_t i;
+  for (i = 0; i < sizeof suffixes / sizeof suffixes[0]; i++) {
+    gt_str_set(path, filename);
+    gt_str_append_cstr(path, suffixes[i]);
+    if (gt_file_exists(gt_str_get(path)))
+      gt_xremove(gt_str_get(path));
+  }
+  gt_str_delete(path);
+}
+
+/* returns the code of the word of length <prefixlength> at <seq>, or
+   <GT_UNDEF_UWORD> if it contains a wildcard or separator */
+static GtUword seed_index_word_code(const GtUchar *seq,
+                                    unsigned int prefixlength)
+{
+  GtUword i, code;
+  for (i = 0, code = 0; i < prefixlength && seq[i] < 4; i++)
+    code = (code << 2) | seq[i];
+  return i < prefixlength ? GT_UNDEF_UWORD : code;
+}
+
+static int seed_index_check(const GthSeedIndex *seed_index,
+                            GthSeqCon *gen_seq_con, GtError *err)
+{
+  const unsigned int prefixlength = seed_index->prefixlength;
+  const GtUchar *seq = gth_seq_con_get_tran_seq(gen_seq_con, 0);
+  const GtUword *positions;
+  GtUword j, p, code, numofpositions, numofwords = 0, *counts,
+          maxbucketsize = seed_index->data[SEED_INDEX_HEADER_MAXBUCKETSIZE],
+          totallength = gth_seq_con_total_length(gen_seq_con);
+  int had_err = 0;
+  gt_error_check(err);
+
+  counts = gt_calloc(seed_index->numofbuckets, sizeof *counts);
+  for (p = 0; p + prefixlength <= totallength; p++) {
+    if ((code = seed_index_word_code(seq + p, prefixlength)) != GT_UNDEF_UWORD)
+      counts[code]++;
+  }
+  gt_ensure(maxbucketsize >= SEED_INDEX_MINMAXBUCKETSIZE);
+
+  /* every word without wildcards and separators is stored in its bucket,
+     unless it is repetitive. The buckets are sorted */
+  for (p = 0; !had_err && p + prefixlength <= totallength; p++) {
+    if ((code = seed_index_word_code(seq + p, prefixlength)) == GT_UNDEF_UWORD)
+      continue;
+    numofpositions = gth_seed_index_get_positions(seed_index, code,
+                                                  &positions);
+    if (counts[code] > maxbucketsize) {
+      gt_ensure(!numofpositions);
+      continue;
+    }
+    numofwords++;
+    gt_ensure(numofpositions == counts[code]);
+    for (j = 0; j < numofpositions && positions[j] != p; j++)
+      /* nothing */;
+    gt_ensure(j < numofpositions);
+    for (j = 1; !had_err && j < numofpositions; j++)
+      gt_ensure(positions[j-1] < positions[j]);
+  }
+  gt_ensure(seed_index->numofpositions == numofwords);
+  gt_ensure(seed_index->bucketstart[seed_index->numofbuckets] == numofwords);
+  /* the poly-A words are repetitive */
+  if (!had_err && prefixlength > 1)
+    gt_ensure(counts[0] > maxbucketsize);
+  gt_free(counts);
+  return had_err;
+}
+
+int gth_seed_index_unit_test(GtError *err)
+{
+  static const GtUword seqlengths[] = { 500, 1, 8, 1200 };
+  GthSeedIndex *computed, *cached;
+  GthSeqCon *gen_seq_con, *other_seq_con = NULL;
+  GtStr *filename, *indexname, *otherfilename;
+  unsigned int prefixlength;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  filename = gt_str_new();
+  seed_index_write_random_seqs(filename, seqlengths,
+                               sizeof seqlengths / sizeof seqlengths[0]);
+  /* other sequences of the same lengths */
+  otherfilename = gt_str_new();
+  seed_index_write_random_seqs(otherfilename, seqlengths,
+                               sizeof seqlengths / sizeof seqlengths[0]);
+  indexname = gt_str_clone(otherfilename);
+  gt_str_append_char(indexname, '.');
+  gt_str_append_cstr(indexname, DNASUFFIX);
+  had_err = gth_seq_con_encseq_encode_dna(gt_str_get(otherfilename),
+                                          gt_str_get(indexname), err);
+  if (!had_err) {
+    other_seq_con = gth_seq_con_encseq_new(gt_str_get(indexname), false, false,
+                                           true, err);
+    if (!other_seq_con)
+      had_err = -1;
+  }
+  gt_str_set(indexname, gt_str_get(filename));
+  gt_str_append_char(indexname, '.');
+  gt_str_append_cstr(indexname, DNASUFFIX);
+  if (!had_err) {
+    had_err = gth_seq_con_encseq_encode_dna(gt_str_get(filename),
+                                            gt_str_get(indexname), err);
+  }
+  if (!had_err) {
+    gen_seq_con = gth_seq_con_encseq_new(gt_str_get(indexname), false, false,
+                                         true, err);
+    if (!gen_seq_con)
+      had_err = -1;
+  }
+  if (!had_err) {
+    for (prefixlength = 1; !had_err && prefixlength <= 9; prefixlength += 4) {
+      /* the computed index */
+      computed = gth_seed_index_new(gt_str_get(filename), gen_seq_con,
+                                    prefixlength, false);
+      gt_ensure(!computed->mapped);
+      if (!had_err)
+        had_err = seed_index_check(computed, gen_seq_con, err);
+
+      /* the index is written to the cache file and read from it */
+      cached = gth_seed_index_new(gt_str_get(filename), gen_seq_con,
+                                  prefixlength, true);
+      gth_seed_index_delete(cached);
+      cached = gth_seed_index_new(gt_str_get(filename), gen_seq_con,
+                                  prefixlength, true);
+      gt_ensure(cached->mapped);
+      gt_ensure(cached->numofpositions == computed->numofpositions);
+      gt_ensure(!memcmp(cached->data, computed->data,
+                        sizeof (GtUword) * (SEED_INDEX_HEADERSIZE +
+                                            computed->numofbuckets + 1 +
+                                            computed->numofpositions)));
+      gth_seed_index_delete(cached);
+
+      /* an invalid cache file is replaced */
+      gt_str_append_cstr(indexname, "." SEEDINDEXSUFFIX);
+      fp = gt_fa_xfopen(gt_str_get(indexname), "w");
+      gt_xfputs("invalid", fp);
+      gt_fa_xfclose(fp);
+      gt_str_set_length(indexname, gt_str_length(indexname) -
+                                   strlen("." SEEDINDEXSUFFIX));
+      cached = gth_seed_index_new(gt_str_get(filename), gen_seq_con,
+                                  prefixlength, true);
+      gt_ensure(!cached->mapped);
+      if (!had_err)
+        had_err = seed_index_check(cached, gen_seq_con, err);
+      gth_seed_index_delete(cached);
+      cached = gth_seed_index_new(gt_str_get(filename), gen_seq_con,
+                                  prefixlength, true);
+      gt_ensure(cached->mapped);
+      gth_seed_index_delete(cached);
+
+      /* the cache file of other sequences with the same lengths is replaced,
+         although it is newer than the genomic file */
+      cached = gth_seed_index_new(gt_str_get(filename), other_seq_con,
+                                  prefixlength, true);
+      gt_ensure(!cached->mapped);
+      if (!had_err)
+        had_err = seed_index_check(cached, other_seq_con, err);
+      gth_seed_index_delete(cached);
+
+      gth_seed_index_delete(computed);
+    }
+    gth_seq_con_delete(gen_seq_con);
+  }
+  gth_seq_con_delete(other_seq_con);
+
+  seed_index_remove_files(gt_str_get(filename));
+  seed_index_remove_files(gt_str_get(otherfilename));
+  gt_str_delete(indexname);
+  gt_str_delete(otherfilename);
+  gt_str_delete(filename);
+  return had_err;
+}
@@ -0,0 +1,53 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SEED_INDEX_H
+#define SEED_INDEX_H
+
+#include "core/error_api.h"
+#include "gth/seq_con.h"
+
+/* the maximal length of the indexed seeds, the index contains a bucket for
+   every DNA word of this length */
+#define GTH_SEED_INDEX_MAXPREFIXLENGTH  11
+
+/* The seed index stores for every DNA word of length <prefixlength> the
+   positions of its occurrences in the (transformed) genomic sequences. The
+   bucket of a word which occurs much more often than the average word is left
+   empty. */
+typedef struct GthSeedIndex GthSeedIndex;
+
+/* Returns the seed index of the genomic sequences in <gen_seq_con>, which have
+   been read from <genomicfile>. If <use_cache_file> is true, the index is read
+   from the file <genomicfile>.dna.sdx if it is newer than <genomicfile> and
+   has been computed from sequences with the same MD5 sum, otherwise it is
+   computed and stored in this file. The file is replaced as a whole, so it
+   can be shared by concurrent runs. */
+GthSeedIndex* gth_seed_index_new(const char *genomicfile,
+                                 GthSeqCon *gen_seq_con,
+                                 unsigned int prefixlength,
+                                 bool use_cache_file);
+void          gth_seed_index_delete(GthSeedIndex *seed_index);
+unsigned int  gth_seed_index_prefixlength(const GthSeedIndex *seed_index);
+/* Returns the number of occurrences of the word with integer code <code> and
+   stores their ascending positions in <positions>. Returns 0 for a repetitive
+   word. */
+GtUword       gth_seed_index_get_positions(const GthSeedIndex *seed_index,
+                                           GtUword code,
+                                           const GtUword **positions);
+int           gth_seed_index_unit_test(GtError *err);
+
+#endif
@@ -0,0 +1,594 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include "core/complement.h"
+#include "core/divmodmul.h"
+#include "core/ensure.h"
+#include "core/error_api.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
+#include "core/readmode.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "gth/chaining.h"
+#include "gth/gthdef.h"
+#include "gth/seed_index.h"
+#include "gth/seed_matcher.h"
+#include "gth/seq_con_encseq.h"
+
+/* the number of reference sequences which are matched before their matches
+   are passed to the match processor */
+#define SEED_MATCHER_BATCHSIZE  1024
+
+typedef struct {
+  GthInput *input;
+  GtUword gen_file_num,
+          ref_file_num,
+          minmatchlength;
+  bool directmatches,
+       use_cache_file;
+} GthSeedMatcherArguments;
+
+typedef struct {
+  const GthSeedIndex *seed_index;
+  GthSeqCon *ref_seq_con;
+  const GtUchar *gen_seq_tran; /* indexed by the positions of the index */
+  const GtRange *gen_ranges;
+  GtUword numofgenseqs,
+          minmatchlength,
+          batchstart,
+          batchend,
+          next;
+  bool directmatches;
+  GtArray **matches;           /* the matches of the references of the
+                                  current batch */
+  GtMutex *mutex;
+} SeedMatcherThreadInfo;
+
+void* gth_seed_matcher_arguments_new(GT_UNUSED bool checksubstrspec,
+                                     GthInput *input,
+                                     const char *queryfilename,
+                                     const char *indexfilename,
+                                     bool directmatches,
+                                     GT_UNUSED bool refseqisdna,
+                                     GT_UNUSED const char *progname,
+                                     GT_UNUSED char *proteinsmap,
+                                     GT_UNUSED bool exact,
+                                     GT_UNUSED bool edist,
+                                     GT_UNUSED bool hamming,
+                                     GT_UNUSED GtUword hammingdistance,
+                                     GtUword minmatchlength,
+                                     GT_UNUSED GtUword seedlength,
+                                     GT_UNUSED GtUword exdrop,
+                                     GT_UNUSED GtUword prminmatchlen,
+                                     GT_UNUSED GtUword prseedlength,
+                                     GT_UNUSED GtUword prhdist,
+                                     GT_UNUSED GtUword translationtable,
+                                     GT_UNUSED bool online,
+                                     bool noautoindex,
+                                     GT_UNUSED bool usepolyasuffix,
+                                     GT_UNUSED bool dbmaskmatch)
+{
+  GthSeedMatcherArguments *args;
+  GtWord gen_file_index, ref_file_index;
+  gt_assert(input && queryfilename && indexfilename && refseqisdna);
+  gt_assert(minmatchlength > 0);
+
+  /* the genomic file is the index, unless query and index are inverted */
+  if ((gen_file_index = gth_input_determine_genomic_file_index(input,
+                                                           indexfilename)) < 0
+      || (ref_file_index = gth_input_determine_reference_file_index(input,
+                                                      queryfilename)) < 0) {
+    gen_file_index = gth_input_determine_genomic_file_index(input,
+                                                            queryfilename);
+    ref_file_index = gth_input_determine_reference_file_index(input,
+                                                              indexfilename);
+  }
+  gt_assert(gen_file_index >= 0 && ref_file_index >= 0);
+
+  args = gt_malloc(sizeof *args);
+  args->input = input;
+  args->gen_file_num = gen_file_index;
+  args->ref_file_num = ref_file_index;
+  args->minmatchlength = minmatchlength;
+  args->directmatches = directmatches;
+  args->use_cache_file = !noautoindex;
+  return args;
+}
+
+void gth_seed_matcher_arguments_delete(void *matcher_arguments)
+{
+  if (!matcher_arguments) return;
+  gt_free(matcher_arguments);
+}
+
+/* returns the number of the genomic sequence which contains <pos> */
+static GtUword seed_matcher_gen_seq_num(const SeedMatcherThreadInfo *info,
+                                        GtUword pos)
+{
+  GtUword left = 0, right = info->numofgenseqs - 1, mid;
+  while (left < right) {
+    mid = left + GT_DIV2(right - left + 1);
+    if (info->gen_ranges[mid].start <= pos)
+      left = mid;
+    else
+      right = mid - 1;
+  }
+  gt_assert(info->gen_ranges[left].start <= pos &&
+            pos <= info->gen_ranges[left].end);
+  return left;
+}
+
+/* the following function computes the maximal exact matches of reference
+   sequence <ref_seq_num>. Every match is found from all of its seeds which are
+   not repetitive, it is only reported from the first one. Matches consisting
+   of repetitive seeds only are not found. */
+static void seed_matcher_match_reference(const SeedMatcherThreadInfo *info,
+                                         GtUword ref_seq_num,
+                                         GtUchar **buffer,
+                                         GtUword *buffersize,
+                                         GtArray *matches)
+{
+  const unsigned int prefixlength =
+    gth_seed_index_prefixlength(info->seed_index);
+  const GtUchar *query, *gen = info->gen_seq_tran;
+  const GtUword *positions, mask = ((GtUword) 1 << (2 * prefixlength)) - 1;
+  GtUword i, j, e, l, p, qstart, code, valid, gen_seq_num, numofpositions,
+          reflength, lastseed = GT_UNDEF_UWORD;
+  GtRange ref_range;
+  GthMatch match;
+
+  ref_range = gth_seq_con_get_range(info->ref_seq_con, ref_seq_num);
+  reflength = gt_range_length(&ref_range);
+  if (info->directmatches)
+    query = gth_seq_con_get_tran_seq(info->ref_seq_con, ref_seq_num);
+  else {
+    /* palindromic matches are the direct matches of the reverse complement */
+    const GtUchar *ref = gth_seq_con_get_tran_seq(info->ref_seq_con,
+                                                  ref_seq_num);
+    if (*buffersize < reflength) {
+      *buffer = gt_realloc(*buffer, sizeof (GtUchar) * reflength);
+      *buffersize = reflength;
+    }
+    for (i = 0; i < reflength; i++) {
+      (*buffer)[reflength - 1 - i] = ref[i] < 4 ? GT_COMPLEMENTBASE(ref[i])
+                                                : ref[i];
+    }
+    query = *buffer;
+  }
+
+  for (i = 0, code = 0, valid = 0; i < reflength; i++) {
+    if (query[i] >= 4) {
+      valid = 0;
+      continue;
+    }
+    code = ((code << 2) | query[i]) & mask;
+    if (++valid < prefixlength)
+      continue;
+    qstart = i + 1 - prefixlength;
+    numofpositions = gth_seed_index_get_positions(info->seed_index, code,
+                                                  &positions);
+    for (j = 0; j < numofpositions; j++) {
+      p = positions[j];
+      gen_seq_num = seed_matcher_gen_seq_num(info, p);
+      /* extend to the left, at most up to the previous seed with positions
+         (usually the one at <qstart> - 1) */
+      for (e = 0;
+           (lastseed == GT_UNDEF_UWORD || qstart - e > lastseed) &&
+           qstart - e > 0 && p - e > info->gen_ranges[gen_seq_num].start &&
+           query[qstart-e-1] < 4 && query[qstart-e-1] == gen[p-e-1];
+           e++) /* nothing */;
+      if (lastseed != GT_UNDEF_UWORD && qstart - e == lastseed) {
+        /* reported from the previous seed */
+        continue;
+      }
+      for (l = prefixlength;
+           qstart + l < reflength && p + l <= info->gen_ranges[gen_seq_num].end
+           && query[qstart+l] < 4 && query[qstart+l] == gen[p+l];
+           l++) /* nothing */;
+      l += e;
+      if (l < info->minmatchlength)
+        continue;
+      /* exact matches are weighted by their length */
+      match.Storescore = (GtWord) l;
+      match.Storepositionreference = ref_range.start +
+                                     (info->directmatches
+                                      ? qstart - e
+                                      : reflength - (qstart - e) - l);
+      match.Storelengthreference = l;
+      match.Storepositiongenomic = p - e;
+      match.Storelengthgenomic = l;
+      match.Storeseqnumreference = ref_seq_num;
+      match.Storeseqnumgenomic = gen_seq_num;
+      gt_array_add(matches, match);
+    }
+    if (numofpositions > 0)
+      lastseed = qstart;
+  }
+}
+
+static void* seed_matcher_thread(void *data)
+{
+  SeedMatcherThreadInfo *info = data;
+  GtUchar *buffer = NULL;
+  GtUword ref_seq_num, buffersize = 0;
+  gt_assert(info);
+
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    if (info->next == info->batchend) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    ref_seq_num = info->next++;
+    gt_mutex_unlock(info->mutex);
+    seed_matcher_match_reference(info, ref_seq_num, &buffer, &buffersize,
+                                 info->matches[ref_seq_num - info->batchstart]);
+  }
+
+  gt_free(buffer);
+  return NULL;
+}
+
+int gth_seed_matcher_run(void *matcher_arguments, GthShowVerbose showverbose,
+                         GT_UNUSED GthShowVerboseVM showverboseVM,
+                         void *match_processor_data, GtError *err)
+{
+  GthSeedMatcherArguments *args = matcher_arguments;
+  SeedMatcherThreadInfo info;
+  GthSeqCon *gen_seq_con, *ref_seq_con;
+  GthSeedIndex *seed_index;
+  GtRange *gen_ranges;
+  GtUword i, r, numofrefseqs;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(args && match_processor_data);
+
+  /* load the (transformed) sequences, they are kept for the chaining */
+  gth_input_load_genomic_file(args->input, args->gen_file_num, true);
+  gth_input_load_reference_file(args->input, args->ref_file_num, true);
+  gen_seq_con = gth_input_current_gen_seq_con(args->input);
+  ref_seq_con = gth_input_current_ref_seq_con(args->input);
+
+  if (showverbose)
+    showverbose("load or compute seed index of genomic file");
+  seed_index = gth_seed_index_new(gth_input_get_genomic_filename(args->input,
+                                                           args->gen_file_num),
+                                  gen_seq_con,
+                                  MIN(args->minmatchlength,
+                                      GTH_SEED_INDEX_MAXPREFIXLENGTH),
+                                  args->use_cache_file);
+
+  info.numofgenseqs = gth_seq_con_num_of_seqs(gen_seq_con);
+  gen_ranges = gt_malloc(sizeof *gen_ranges * info.numofgenseqs);
+  for (i = 0; i < info.numofgenseqs; i++)
+    gen_ranges[i] = gth_seq_con_get_range(gen_seq_con, i);
+  gt_assert(!gen_ranges[0].start);
+
+  info.seed_index = seed_index;
+  info.ref_seq_con = ref_seq_con;
+  info.gen_seq_tran = gth_seq_con_get_tran_seq(gen_seq_con, 0);
+  info.gen_ranges = gen_ranges;
+  info.minmatchlength = args->minmatchlength;
+  info.directmatches = args->directmatches;
+  info.matches = gt_malloc(sizeof (GtArray*) * SEED_MATCHER_BATCHSIZE);
+  for (i = 0; i < SEED_MATCHER_BATCHSIZE; i++)
+    info.matches[i] = gt_array_new(sizeof (GthMatch));
+  info.mutex = gt_mutex_new();
+
+  if (showverbose)
+    showverbose("compute matches with seed index");
+  numofrefseqs = gth_seq_con_num_of_seqs(ref_seq_con);
+  for (info.batchstart = 0; !had_err && info.batchstart < numofrefseqs;
+       info.batchstart = info.batchend) {
+    info.batchend = MIN(info.batchstart + SEED_MATCHER_BATCHSIZE,
+                        numofrefseqs);
+    info.next = info.batchstart;
+    if ((had_err = gt_multithread(seed_matcher_thread, &info, err)))
+      break;
+    /* pass the matches to the match processor in the order of the reference
+       sequences */
+    for (r = info.batchstart; r < info.batchend; r++) {
+      GtArray *matches = info.matches[r - info.batchstart];
+      for (i = 0; i < gt_array_size(matches); i++) {
+        gth_match_processor(match_processor_data, gen_seq_con, ref_seq_con,
+                            gt_array_get(matches, i));
+      }
+      gt_array_reset(matches);
+    }
+  }
+
+  gt_mutex_delete(info.mutex);
+  for (i = 0; i < SEED_MATCHER_BATCHSIZE; i++)
+    gt_array_delete(info.matches[i]);
+  gt_free(info.matches);
+  gt_free(gen_ranges);
+  gth_seed_index_delete(seed_index);
+  return had_err;
+}
+
+static int seed_matcher_match_cmp(const void *a, const void *b)
+{
+  const GthMatch *m1 = a, *m2 = b;
+  if (m1->Storepositionreference != m2->Storepositionreference)
+    return m1->Storepositionreference < m2->Storepositionreference ? -1 : 1;
+  if (m1->Storepositiongenomic != m2->Storepositiongenomic)
+    return m1->Storepositiongenomic < m2->Storepositiongenomic ? -1 : 1;
+  if (m1->Storelengthreference != m2->Storelengthreference)
+    return m1->Storelengthreference < m2->Storelengthreference ? -1 : 1;
+  return 0;
+}
+
+/* returns true if the match of length <l> at <query> contains a seed which
+   is not repetitive */
+static bool seed_matcher_has_seed(const SeedMatcherThreadInfo *info,
+                                  const GtUchar *query, GtUword l)
+{
+  const unsigned int prefixlength =
+    gth_seed_index_prefixlength(info->seed_index);
+  const GtUword *positions;
+  GtUword i, j, code;
+  for (i = 0; i + prefixlength <= l; i++) {
+    for (j = 0, code = 0; j < prefixlength; j++)
+      code = (code << 2) | query[i+j];
+    if (gth_seed_index_get_positions(info->seed_index, code, &positions))
+      return true;
+  }
+  return false;
+}
+
+/* computes the maximal exact matches of reference sequence <ref_seq_num>
+   which contain a seed by comparing all pairs of start positions */
+static void seed_matcher_brute_force(const SeedMatcherThreadInfo *info,
+                                     GtUword ref_seq_num, GtArray *matches)
+{
+  const GtUchar *ref, *gen = info->gen_seq_tran;
+  GtUchar *query;
+  GtUword i, q, g, p, l, reflength;
+  GtRange ref_range;
+  GthMatch match;
+
+  ref_range = gth_seq_con_get_range(info->ref_seq_con, ref_seq_num);
+  reflength = gt_range_length(&ref_range);
+  ref = gth_seq_con_get_tran_seq(info->ref_seq_con, ref_seq_num);
+  query = gt_malloc(sizeof *query * reflength);
+  for (i = 0; i < reflength; i++) {
+    if (info->directmatches)
+      query[i] = ref[i];
+    else {
+      query[reflength - 1 - i] = ref[i] < 4 ? GT_COMPLEMENTBASE(ref[i])
+                                            : ref[i];
+    }
+  }
+  for (q = 0; q < reflength; q++) {
+    for (g = 0; g < info->numofgenseqs; g++) {
+      for (p = info->gen_ranges[g].start; p <= info->gen_ranges[g].end; p++) {
+        if (q > 0 && p > info->gen_ranges[g].start && query[q-1] < 4 &&
+            query[q-1] == gen[p-1]) {
+          continue;
+        }
+        for (l = 0; q + l < reflength && p + l <= info->gen_ranges[g].end &&
+                    query[q+l] < 4 && query[q+l] == gen[p+l]; l++)
+          /* nothing */;
+        if (l < info->minmatchlength || !seed_matcher_has_seed(info, query + q,
+                                                               l)) {
+          continue;
+        }
+        match.Storescore = (GtWord) l;
+        match.Storepositionreference = ref_range.start +
+                                       (info->directmatches
+                                        ? q : reflength - q - l);
+        match.Storelengthreference = l;
+        match.Storepositiongenomic = p;
+        match.Storelengthgenomic = l;
+        match.Storeseqnumreference = ref_seq_num;
+        match.Storeseqnumgenomic = g;
+        gt_array_add(matches, match);
+      }
+    }
+  }
+  gt_free(query);
+}
+
+static void seed_matcher_random_seq(GtStr *seq, GtUword length)
+{
+  GtUword i;
+  gt_str_reset(seq);
+  for (i = 0; i < length; i++)
+    gt_str_append_char(seq, random() % 100 ? "acgt"[random() % 4] : 'n');
+}
+
+/* writes a reference sequence derived from a random substring of <seq> with
+   some substitutions, reverse complemented with probability 1/2 */
+static void seed_matcher_write_ref(FILE *fp, GtUword ref_seq_num,
+                                   const GtStr *seq)
+{
+  GtUword i, start, length;
+  char cc, *ref;
+  length = MIN(30 + (GtUword) random() % 150, gt_str_length(seq) - 1);
+  start = (GtUword) random() % (gt_str_length(seq) - length);
+  ref = gt_malloc(sizeof *ref * length);
+  for (i = 0; i < length; i++) {
+    ref[i] = random() % 25 ? gt_str_get(seq)[start + i]
+                           : "acgt"[random() % 4];
+  }
+  if (random() % 2) {
+    for (i = 0; i < length / 2 + length % 2; i++) {
+      gt_complement(&cc, ref[i], NULL);
+      gt_complement(&ref[i], ref[length - 1 - i], NULL);
+      ref[length - 1 - i] = cc;
+    }
+  }
+  fprintf(fp, ">ref" GT_WU "\n%.*s\n", ref_seq_num, (int) length, ref);
+  gt_free(ref);
+}
+
+static void seed_matcher_remove_files(const char *filename)
+{
+  static const char *suffixes[] = { "", ".dna.esq", ".dna.des", ".dna.sds",
+                                    ".dna.ssp", ".dna.md5" };
+  GtStr *path = gt_str_new();
+  size_t i;
+  for (i = 0; i < sizeof suffixes / sizeof suffixes[0]; i++) {
+    gt_str_set(path, filename);
+    gt_str_append_cstr(path, suffixes[i]);
+    if (gt_file_exists(gt_str_get(path)))
+      gt_xremove(gt_str_get(path));
+  }
+  gt_str_delete(path);
+}
+
+int gth_seed_matcher_unit_test(GtError *err)
+{
+  static const GtUword genlengths[] = { 900, 40, 1100 },
+                       minmatchlengths[] = { 6, 14 };
+  const GtUword numofgenseqs = sizeof genlengths / sizeof genlengths[0],
+                numofrefseqs = 25;
+  SeedMatcherThreadInfo info;
+  GthSeqCon *gen_seq_con = NULL, *ref_seq_con = NULL;
+  GthSeedIndex *seed_index;
+  GtStr *genfile, *reffile, *indexname, *seq;
+  GtArray *matches, *expected;
+  GtRange *gen_ranges;
+  GtUchar *buffer = NULL;
+  GtUword i, m, r, buffersize = 0;
+  FILE *genfp, *reffp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* write the genomic sequences and the references derived from them */
+  genfile = gt_str_new();
+  reffile = gt_str_new();
+  seq = gt_str_new();
+  genfp = gt_xtmpfp(genfile);
+  reffp = gt_xtmpfp(reffile);
+  for (i = 0, r = 0; i < numofgenseqs; i++) {
+    seed_matcher_random_seq(seq, genlengths[i]);
+    fprintf(genfp, ">gen" GT_WU "\n%s\n", i, gt_str_get(seq));
+    for (; r < (i + 1) * numofrefseqs / numofgenseqs; r++)
+      seed_matcher_write_ref(reffp, r, seq);
+  }
+  seed_matcher_random_seq(seq, 100);
+  fprintf(reffp, ">unrelated\n%s\n", gt_str_get(seq));
+  /* a genomic sequence starting with a repeat, the poly-A words are repetitive
+     for both minimum match lengths. The reference matches it from within the
+     repeat on. */
+  seed_matcher_random_seq(seq, 200);
+  fprintf(genfp, ">genrepeat\n");
+  for (i = 0; i < 1200; i++)
+    fputc('a', genfp);
+  fprintf(genfp, "c%s\n", gt_str_get(seq));
+  fprintf(reffp, ">repeat\naaaaaaaaaaaaaaaaaaaac%.60s\n", gt_str_get(seq));
+  gt_fa_xfclose(genfp);
+  gt_fa_xfclose(reffp);
+
+  indexname = gt_str_new();
+  gt_str_append_str(indexname, genfile);
+  gt_str_append_cstr(indexname, "." DNASUFFIX);
+  had_err = gth_seq_con_encseq_encode_dna(gt_str_get(genfile),
+                                          gt_str_get(indexname), err);
+  if (!had_err) {
+    gen_seq_con = gth_seq_con_encseq_new(gt_str_get(indexname), false, false,
+                                         true, err);
+    if (!gen_seq_con)
+      had_err = -1;
+  }
+  if (!had_err) {
+    gt_str_set(indexname, gt_str_get(reffile));
+    gt_str_append_cstr(indexname, "." DNASUFFIX);
+    had_err = gth_seq_con_encseq_encode_dna(gt_str_get(reffile),
+                                            gt_str_get(indexname), err);
+  }
+  if (!had_err) {
+    ref_seq_con = gth_seq_con_encseq_new(gt_str_get(indexname), false, false,
+                                         true, err);
+    if (!ref_seq_con)
+      had_err = -1;
+  }
+  if (!had_err) {
+    gt_ensure(gth_seq_con_num_of_seqs(ref_seq_con) == numofrefseqs + 2);
+  }
+
+  if (!had_err) {
+    info.numofgenseqs = gth_seq_con_num_of_seqs(gen_seq_con);
+    gen_ranges = gt_malloc(sizeof *gen_ranges * info.numofgenseqs);
+    for (i = 0; i < info.numofgenseqs; i++)
+      gen_ranges[i] = gth_seq_con_get_range(gen_seq_con, i);
+    info.ref_seq_con = ref_seq_con;
+    info.gen_seq_tran = gth_seq_con_get_tran_seq(gen_seq_con, 0);
+    info.gen_ranges = gen_ranges;
+    matches = gt_array_new(sizeof (GthMatch));
+    expected = gt_array_new(sizeof (GthMatch));
+    for (m = 0; !had_err && m < 2 * sizeof minmatchlengths /
+                                    sizeof minmatchlengths[0]; m++) {
+      info.minmatchlength = minmatchlengths[m / 2];
+      info.directmatches = m % 2;
+      seed_index = gth_seed_index_new(gt_str_get(genfile), gen_seq_con,
+                                      MIN(info.minmatchlength,
+                                          GTH_SEED_INDEX_MAXPREFIXLENGTH),
+                                      false);
+      info.seed_index = seed_index;
+      for (r = 0; !had_err && r <= numofrefseqs + 1; r++) {
+        gt_array_reset(matches);
+        gt_array_reset(expected);
+        seed_matcher_match_reference(&info, r, &buffer, &buffersize, matches);
+        seed_matcher_brute_force(&info, r, expected);
+        gt_array_sort(matches, seed_matcher_match_cmp);
+        gt_array_sort(expected, seed_matcher_match_cmp);
+        gt_ensure(gt_array_size(matches) == gt_array_size(expected));
+        for (i = 0; !had_err && i < gt_array_size(matches); i++) {
+          gt_ensure(gth_matches_are_equal(gt_array_get(matches, i),
+                                          gt_array_get(expected, i)));
+        }
+        /* the derived references have matches */
+        if (r < numofrefseqs && info.minmatchlength == minmatchlengths[0])
+          gt_ensure(gt_array_size(expected) > 0);
+        /* the match which starts with repetitive seeds is found */
+        if (r == numofrefseqs + 1 && info.directmatches) {
+          GtRange ref_range = gth_seq_con_get_range(ref_seq_con, r);
+          for (i = 0; i < gt_array_size(matches); i++) {
+            GthMatch *match = gt_array_get(matches, i);
+            if (match->Storepositionreference == ref_range.start &&
+                match->Storelengthreference > 20)
+              break;
+          }
+          gt_ensure(i < gt_array_size(matches));
+        }
+      }
+      gth_seed_index_delete(seed_index);
+    }
+    gt_array_delete(expected);
+    gt_array_delete(matches);
+    gt_free(gen_ranges);
+  }
+
+  gt_free(buffer);
+  gth_seq_con_delete(ref_seq_con);
+  gth_seq_con_delete(gen_seq_con);
+  seed_matcher_remove_files(gt_str_get(genfile));
+  seed_matcher_remove_files(gt_str_get(reffile));
+  gt_str_delete(seq);
+  gt_str_delete(indexname);
+  gt_str_delete(reffile);
+  gt_str_delete(genfile);
+  return had_err;
+}
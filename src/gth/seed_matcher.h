@@ -0,0 +1,60 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SEED_MATCHER_H
+#define SEED_MATCHER_H
+
+#include "gth/matcher.h"
+
+/* The built-in matcher of gth, which implements the matcher interface of the
+   plugins for cDNA/EST reference files. It computes the maximal exact matches
+   of length at least <minmatchlength> between the reference sequences and the
+   genomic sequences (direct or palindromic, depending on <directmatches>)
+   with a <GthSeedIndex> of the genomic file. Unless <noautoindex> is set, the
+   seed index is kept as a cache file next to the genomic file and reused in
+   later runs. The reference sequences are matched by <gt_jobs> threads, the
+   matches are passed to the match processor in the order of the reference
+   sequences. */
+void* gth_seed_matcher_arguments_new(bool checksubstrspec,
+                                     GthInput *input,
+                                     const char *queryfilename,
+                                     const char *indexfilename,
+                                     bool directmatches,
+                                     bool refseqisdna,
+                                     const char *progname,
+                                     char *proteinsmap,
+                                     bool exact,
+                                     bool edist,
+                                     bool hamming,
+                                     GtUword hammingdistance,
+                                     GtUword minmatchlength,
+                                     GtUword seedlength,
+                                     GtUword exdrop,
+                                     GtUword prminmatchlen,
+                                     GtUword prseedlength,
+                                     GtUword prhdist,
+                                     GtUword translationtable,
+                                     bool online,
+                                     bool noautoindex,
+                                     bool usepolyasuffix,
+                                     bool dbmaskmatch);
+void  gth_seed_matcher_arguments_delete(void *matcher_arguments);
+int   gth_seed_matcher_run(void *matcher_arguments, GthShowVerbose,
+                           GthShowVerboseVM, void *match_processor_data,
+                           GtError *err);
+int   gth_seed_matcher_unit_test(GtError *err);
+
+#endif
@@ -18,6 +18,7 @@
 #define SEQ_CON_H
 
 #include "core/alphabet.h"
+#include "core/error_api.h"
 #include "core/file.h"
 #include "core/range.h"
 #include "core/str_api.h"
@@ -29,7 +30,7 @@ typedef struct GthSeqCon GthSeqCon;
 
 typedef GthSeqCon* (*GthSeqConConstructor)(const char *indexname,
                                            bool assign_rc, bool orig_seq,
-                                           bool tran_seq);
+                                           bool tran_seq, GtError *err);
 
 void          gth_seq_con_delete(GthSeqCon*);
 void          gth_seq_con_demand_orig_seq(GthSeqCon *seq_con);
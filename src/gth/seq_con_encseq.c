@@ -0,0 +1,365 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/chardef.h"
+#include "core/class_alloc_lock.h"
+#include "core/complement.h"
+#include "core/encseq_api.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/unused_api.h"
+#include "gth/gthdef.h"
+#include "gth/seq_con_encseq.h"
+#include "gth/seq_con_rep.h"
+
+typedef struct {
+  GthSeqCon parent_instance;
+  GtEncseq *encseq;
+  GtUchar *orig_seq,
+          *tran_seq,
+          *orig_seq_rc,
+          *tran_seq_rc;
+} GthSeqConEncseq;
+
+static const GthSeqConClass* gth_seq_con_encseq_class(void);
+
+#define gth_seq_con_encseq_cast(SC)\
+        gth_seq_con_cast(gth_seq_con_encseq_class(), SC)
+
+static GtUchar* extract_orig_seq(const GtEncseq *encseq)
+{
+  GtUword totallength = gt_encseq_total_length(encseq);
+  GtUchar *orig_seq = gt_malloc(sizeof *orig_seq * totallength);
+  gt_encseq_extract_decoded(encseq, (char*) orig_seq, 0, totallength - 1);
+  return orig_seq;
+}
+
+static GtUchar* extract_tran_seq(const GtEncseq *encseq)
+{
+  GtUword totallength = gt_encseq_total_length(encseq);
+  GtUchar *tran_seq = gt_malloc(sizeof *tran_seq * totallength);
+  gt_encseq_extract_encoded(encseq, tran_seq, 0, totallength - 1);
+  return tran_seq;
+}
+
+/* reverse complement every sequence in place, that is, the reverse complement
+   of sequence <i> starts at the same position as sequence <i> itself */
+static GtUchar* reverse_complement_orig_seq(const GtEncseq *encseq,
+                                            const GtUchar *orig_seq)
+{
+  GtUword seqnum, numofseqs, totallength, i, start, len;
+  GtUchar *rc;
+  char cc;
+  totallength = gt_encseq_total_length(encseq);
+  numofseqs = gt_encseq_num_of_sequences(encseq);
+  rc = gt_malloc(sizeof *rc * totallength);
+  memcpy(rc, orig_seq, sizeof *rc * totallength);
+  for (seqnum = 0; seqnum < numofseqs; seqnum++) {
+    start = gt_encseq_seqstartpos(encseq, seqnum);
+    len = gt_encseq_seqlength(encseq, seqnum);
+    for (i = 0; i < len; i++) {
+      if (gt_complement(&cc, (char) orig_seq[start + len - 1 - i], NULL))
+        cc = (char) orig_seq[start + len - 1 - i];
+      rc[start + i] = (GtUchar) cc;
+    }
+  }
+  return rc;
+}
+
+static GtUchar* reverse_complement_tran_seq(const GtEncseq *encseq,
+                                            const GtUchar *tran_seq)
+{
+  GtUword seqnum, numofseqs, totallength, i, start, len;
+  GtUchar *rc, cc;
+  totallength = gt_encseq_total_length(encseq);
+  numofseqs = gt_encseq_num_of_sequences(encseq);
+  rc = gt_malloc(sizeof *rc * totallength);
+  memcpy(rc, tran_seq, sizeof *rc * totallength);
+  for (seqnum = 0; seqnum < numofseqs; seqnum++) {
+    start = gt_encseq_seqstartpos(encseq, seqnum);
+    len = gt_encseq_seqlength(encseq, seqnum);
+    for (i = 0; i < len; i++) {
+      cc = tran_seq[start + len - 1 - i];
+      rc[start + i] = ISSPECIAL(cc) ? cc : (GtUchar) 3 - cc;
+    }
+  }
+  return rc;
+}
+
+static GtEncseq* load_encseq(const char *indexname, GtError *err)
+{
+  GtEncseqLoader *el;
+  GtEncseq *encseq;
+  gt_error_check(err);
+  el = gt_encseq_loader_new();
+  gt_encseq_loader_require_description_support(el);
+  gt_encseq_loader_require_multiseq_support(el);
+  encseq = gt_encseq_loader_load(el, indexname, err);
+  gt_encseq_loader_delete(el);
+  return encseq;
+}
+
+GthSeqCon* gth_seq_con_encseq_new(const char *indexname, bool assign_rc,
+                                  GT_UNUSED bool orig_seq,
+                                  GT_UNUSED bool tran_seq, GtError *err)
+{
+  GthSeqCon *sc;
+  GthSeqConEncseq *sce;
+  GtEncseq *encseq;
+  gt_error_check(err);
+  gt_assert(indexname);
+  if (!(encseq = load_encseq(indexname, err)))
+    return NULL;
+  sc = gth_seq_con_create(gth_seq_con_encseq_class());
+  sce = gth_seq_con_encseq_cast(sc);
+  sce->encseq = encseq;
+  /* the sequences are accessed by the worker threads of the similarity
+     filter, therefore they are all decoded here and not on demand */
+  sce->orig_seq = extract_orig_seq(sce->encseq);
+  sce->tran_seq = extract_tran_seq(sce->encseq);
+  if (assign_rc) {
+    sce->orig_seq_rc = reverse_complement_orig_seq(sce->encseq,
+                                                   sce->orig_seq);
+    sce->tran_seq_rc = reverse_complement_tran_seq(sce->encseq,
+                                                   sce->tran_seq);
+  }
+  return sc;
+}
+
+static void seq_con_encseq_demand_orig_seq(GT_UNUSED GthSeqCon *sc)
+{
+  /* the original sequences are always decoded */
+}
+
+static GtUchar* seq_con_encseq_get_orig_seq(GthSeqCon *sc, GtUword seq_num)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  return sce->orig_seq + gt_encseq_seqstartpos(sce->encseq, seq_num);
+}
+
+static GtUchar* seq_con_encseq_get_tran_seq(GthSeqCon *sc, GtUword seq_num)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  return sce->tran_seq + gt_encseq_seqstartpos(sce->encseq, seq_num);
+}
+
+static GtUchar* seq_con_encseq_get_orig_seq_rc(GthSeqCon *sc, GtUword seq_num)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  gt_assert(sce->orig_seq_rc);
+  return sce->orig_seq_rc + gt_encseq_seqstartpos(sce->encseq, seq_num);
+}
+
+static GtUchar* seq_con_encseq_get_tran_seq_rc(GthSeqCon *sc, GtUword seq_num)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  gt_assert(sce->tran_seq_rc);
+  return sce->tran_seq_rc + gt_encseq_seqstartpos(sce->encseq, seq_num);
+}
+
+static void seq_con_encseq_get_description(GthSeqCon *sc, GtUword seq_num,
+                                           GtStr *desc)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  const char *description;
+  GtUword desclen;
+  gt_assert(desc);
+  description = gt_encseq_description(sce->encseq, &desclen, seq_num);
+  gt_str_append_cstr_nt(desc, description, desclen);
+}
+
+static void seq_con_encseq_echo_description(GthSeqCon *sc, GtUword seq_num,
+                                            GtFile *outfp)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  const char *description;
+  GtUword desclen;
+  description = gt_encseq_description(sce->encseq, &desclen, seq_num);
+  gt_file_xwrite(outfp, (void*) description, desclen);
+}
+
+static GtUword seq_con_encseq_num_of_seqs(GthSeqCon *sc)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  return gt_encseq_num_of_sequences(sce->encseq);
+}
+
+static GtUword seq_con_encseq_total_length(GthSeqCon *sc)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  return gt_encseq_total_length(sce->encseq);
+}
+
+static GtRange seq_con_encseq_get_range(GthSeqCon *sc, GtUword seq_num)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  GtRange range;
+  range.start = gt_encseq_seqstartpos(sce->encseq, seq_num);
+  range.end = range.start + gt_encseq_seqlength(sce->encseq, seq_num) - 1;
+  return range;
+}
+
+static GtAlphabet* seq_con_encseq_get_alphabet(GthSeqCon *sc)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  return gt_encseq_alphabet(sce->encseq);
+}
+
+static void seq_con_encseq_free(GthSeqCon *sc)
+{
+  GthSeqConEncseq *sce = gth_seq_con_encseq_cast(sc);
+  gt_free(sce->orig_seq);
+  gt_free(sce->tran_seq);
+  gt_free(sce->orig_seq_rc);
+  gt_free(sce->tran_seq_rc);
+  gt_encseq_delete(sce->encseq);
+}
+
+static const GthSeqConClass* gth_seq_con_encseq_class(void)
+{
+  static const GthSeqConClass *scc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!scc) {
+    scc = gth_seq_con_class_new(sizeof (GthSeqConEncseq),
+                                seq_con_encseq_demand_orig_seq,
+                                seq_con_encseq_get_orig_seq,
+                                seq_con_encseq_get_tran_seq,
+                                seq_con_encseq_get_orig_seq_rc,
+                                seq_con_encseq_get_tran_seq_rc,
+                                seq_con_encseq_get_description,
+                                seq_con_encseq_echo_description,
+                                seq_con_encseq_num_of_seqs,
+                                seq_con_encseq_total_length,
+                                seq_con_encseq_get_range,
+                                seq_con_encseq_get_alphabet,
+                                seq_con_encseq_free);
+  }
+  gt_class_alloc_lock_leave();
+  return scc;
+}
+
+int gth_seq_con_encseq_encode_dna(const char *filename, const char *indexname,
+                                  GtError *err)
+{
+  GtEncseqEncoder *ee;
+  GtStrArray *seqfiles;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(filename && indexname);
+  ee = gt_encseq_encoder_new();
+  seqfiles = gt_str_array_new();
+  gt_str_array_add_cstr(seqfiles, filename);
+  gt_encseq_encoder_set_input_dna(ee);
+  gt_encseq_encoder_enable_description_support(ee);
+  gt_encseq_encoder_enable_multiseq_support(ee);
+  had_err = gt_encseq_encoder_encode(ee, seqfiles, indexname, err);
+  gt_str_array_delete(seqfiles);
+  gt_encseq_encoder_delete(ee);
+  return had_err;
+}
+
+static int encode_dna_file(const char *filename, const char *indexname,
+                           bool noautoindex, bool skipindexcheck,
+                           GtError *err)
+{
+  GtStr *esqfile;
+  bool index_exists, index_is_current = true;
+  gt_error_check(err);
+  gt_assert(filename && indexname);
+
+  esqfile = gt_str_new_cstr(indexname);
+  gt_str_append_cstr(esqfile, GT_ENCSEQFILESUFFIX);
+  index_exists = gt_file_exists(gt_str_get(esqfile));
+  if (index_exists && !skipindexcheck)
+    index_is_current = !gt_file_is_newer(filename, gt_str_get(esqfile));
+  gt_str_delete(esqfile);
+  if (index_exists && index_is_current)
+    return 0;
+  if (noautoindex) {
+    gt_error_set(err, "index '%s' of file \"%s\" %s and -noautoindex is set",
+                 indexname, filename,
+                 index_exists ? "is older than the file" : "does not exist");
+    return -1;
+  }
+  return gth_seq_con_encseq_encode_dna(filename, indexname, err);
+}
+
+/* the input files are loaded by functions which cannot fail, therefore the
+   indices are loaded once here to report unusable ones early */
+static int check_index(const char *indexname, GtError *err)
+{
+  GtEncseq *encseq;
+  gt_error_check(err);
+  if (!(encseq = load_encseq(indexname, err)))
+    return -1;
+  gt_encseq_delete(encseq);
+  return 0;
+}
+
+int gth_seq_con_encseq_preprocess(GthInput *input,
+                                  GT_UNUSED bool gthconsensus,
+                                  bool noautoindex, bool skipindexcheck,
+                                  bool maskpolyAtails,
+                                  GT_UNUSED bool online,
+                                  GT_UNUSED bool inverse,
+                                  GT_UNUSED const char *progname,
+                                  GT_UNUSED unsigned int translationtable,
+                                  GT_UNUSED GthOutput *out, GtError *err)
+{
+  GtUword i;
+  GtStr *indexname;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(input);
+
+  if (maskpolyAtails) {
+    gt_error_set(err, "option -maskpolyAtails is not supported for encoded "
+                      "sequence indices");
+    return -1;
+  }
+
+  indexname = gt_str_new();
+  for (i = 0; !had_err && i < gth_input_num_of_gen_files(input); i++) {
+    const char *filename = gth_input_get_genomic_filename(input, i);
+    gt_str_set(indexname, filename);
+    gt_str_append_char(indexname, '.');
+    gt_str_append_cstr(indexname, DNASUFFIX);
+    had_err = encode_dna_file(filename, gt_str_get(indexname), noautoindex,
+                              skipindexcheck, err);
+    if (!had_err)
+      had_err = check_index(gt_str_get(indexname), err);
+  }
+  for (i = 0; !had_err && i < gth_input_num_of_ref_files(input); i++) {
+    const char *filename = gth_input_get_reference_filename(input, i);
+    if (!gth_input_ref_file_is_dna(input, i)) {
+      gt_error_set(err, "protein file \"%s\": protein reference files are "
+                        "not supported for encoded sequence indices",
+                   filename);
+      had_err = -1;
+      break;
+    }
+    gt_str_set(indexname, filename);
+    gt_str_append_char(indexname, '.');
+    gt_str_append_cstr(indexname, DNASUFFIX);
+    had_err = encode_dna_file(filename, gt_str_get(indexname), noautoindex,
+                              skipindexcheck, err);
+    if (!had_err)
+      had_err = check_index(gt_str_get(indexname), err);
+  }
+  gt_str_delete(indexname);
+  return had_err;
+}
@@ -0,0 +1,47 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SEQ_CON_ENCSEQ_H
+#define SEQ_CON_ENCSEQ_H
+
+#include "gth/input.h"
+#include "gth/seq_con.h"
+
+/* A sequence collection based on the <GtEncseq> index <indexname>. The
+   original and the transformed sequences (and their reverse complements, if
+   <assign_rc> is <true>) are decoded into memory when the collection is
+   created, regardless of <orig_seq> and <tran_seq>. Returns <NULL> and sets
+   <err> if the index cannot be loaded. */
+GthSeqCon* gth_seq_con_encseq_new(const char *indexname, bool assign_rc,
+                                  bool orig_seq, bool tran_seq, GtError *err);
+
+/* Creates the <GtEncseq> index <indexname> of the DNA file <filename>, which
+   can be loaded with <gth_seq_con_encseq_new()>. */
+int        gth_seq_con_encseq_encode_dna(const char *filename,
+                                         const char *indexname, GtError *err);
+
+/* The <GthInputFilePreprocessor> belonging to <gth_seq_con_encseq_new()>.
+   Creates the <GtEncseq> indices of the DNA input files, if they do not exist
+   or are older than the input files, and checks that all indices can be
+   loaded. Protein reference files and <maskpolyAtails> are not supported. */
+int        gth_seq_con_encseq_preprocess(GthInput *input, bool gthconsensus,
+                                         bool noautoindex, bool skipindexcheck,
+                                         bool maskpolyAtails, bool online,
+                                         bool inverse, const char *progname,
+                                         unsigned int translationtable,
+                                         GthOutput *out, GtError *err);
+
+#endif
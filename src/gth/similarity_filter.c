@@ -15,6 +15,9 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/ma_api.h"
+#include "core/multithread_api.h"
+#include "core/thread_api.h"
 #include "core/trans_table.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -355,23 +358,45 @@ static bool isunsuccessfulalignment(GthSA *sa,
   return false;
 }
 
+/* the result of the spliced alignment computation for a single chain */
+typedef enum {
+  GTH_SA_SAVE,               /* save the computed alignment */
+  GTH_SA_DISCARD,            /* no alignment, decrease the call number */
+  GTH_SA_DISCARD_SIGNIFICANT /* no alignment, but a significant match (for
+                                compatibility with GS2) */
+} GthSAOutcome;
+
+/* a chain together with everything needed to compute its spliced alignment
+   independently of the other chains. The computation only reads the input,
+   the alignment is saved afterwards in the order of the chains. */
+typedef struct {
+  GthChain *chain;
+  GthSA *saA,                /* alignment to the first strand */
+        *saB,                /* alignment to the other strand, if necessary */
+        *sa;                 /* the alignment to save */
+  const unsigned char *ref_seq_tran,
+                      *ref_seq_orig,
+                      *ref_seq_tran_rc,
+                      *ref_seq_orig_rc;
+  GtRange gen_seq_bounds,
+          gen_seq_bounds_rc;
+  GtUword chainctr,
+          gen_offset,
+          gen_total_length,
+          ref_offset,
+          ref_total_length;
+  GthSAOutcome outcome;
+  bool computed;
+} GthChainSA;
+
+/* the alignments of <csa> are only freed by discard_chain_sa(), because the
+   DP runs in threads which must not change the reference counts of the
+   strings shared by the alignments */
 static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
-                       GthInput *input, GthStat *stat,
-                       GthSACollection *sa_collection, GthSA *saA,
+                       GthInput *input, GthStat *stat, GthChainSA *csa,
                        GtUword gen_file_num,
                        GtUword ref_file_num,
-                       GtUword gen_total_length,
-                       GtUword gen_offset,
-                       const GtRange *gen_seq_bounds,
-                       const GtRange *gen_seq_bounds_rc,
-                       GtUword ref_total_length, GtUword ref_offset,
-                       GtUword chainctr,
-                       GtUword num_of_chains, GthMatchInfo *match_info,
-                       const unsigned char *ref_seq_tran,
-                       const unsigned char *ref_seq_orig,
-                       const unsigned char *ref_seq_tran_rc,
-                       const unsigned char *ref_seq_orig_rc,
-                       GthChain *chain,
+                       GtUword num_of_chains,
                        GthDNACompletePathMatrixJT dna_complete_path_matrix_jt,
                        GthProteinCompletePathMatrixJT
                        protein_complete_path_matrix_jt)
@@ -379,18 +404,19 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
   int rval;
   bool bothstrandsanalyzed, firstdp = true,
        GT_UNUSED gs2outdirectmatches = directmatches;
-  GthSA *saB = NULL;
+  GthSA *saA = csa->saA, *saB;
   GtFile *outfp = call_info->out->outfp;
 
   if (directmatches ? gth_input_forward(input)
                     : gth_input_reverse(input)) {
     /* calculate alignment */
     rval = callsahmt(true, saA, directmatches, gen_file_num, ref_file_num,
-                     chain, gen_total_length, gen_offset, gen_seq_bounds,
-                     gen_seq_bounds_rc,
-                     ref_seq_tran, ref_seq_orig, ref_total_length, ref_offset,
+                     csa->chain, csa->gen_total_length, csa->gen_offset,
+                     &csa->gen_seq_bounds, &csa->gen_seq_bounds_rc,
+                     csa->ref_seq_tran, csa->ref_seq_orig,
+                     csa->ref_total_length, csa->ref_offset,
                      input, &call_info->simfilterparam.introncutoutinfo, stat,
-                     chainctr, num_of_chains, call_info->translationtable,
+                     csa->chainctr, num_of_chains, call_info->translationtable,
                      directmatches, call_info->proteinexonpenal,
                      call_info->splice_site_model, call_info->dp_options_core,
                      call_info->dp_options_est, call_info->dp_options_postpro,
@@ -406,18 +432,19 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
 
     if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
         isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
-      match_info->call_number--;
-      /* if the spliced alignment was unsuccessful, it is deleted and the
+      /* if the spliced alignment was unsuccessful, it is discarded and the
          next hit is considered. */
-      gth_sa_delete(saA);
+      csa->outcome = GTH_SA_DISCARD;
       return 0; /* continue */
     }
 
     /* if not both strands are analyzed, we can save this alignment now.
        Otherwise we have to calculate the alignment to the other strand
        first and then save the better one. */
-    if (!bothstrandsanalyzed)
-      save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+    if (!bothstrandsanalyzed) {
+      csa->sa = saA;
+      csa->outcome = GTH_SA_SAVE;
+    }
   }
 
   if (directmatches ? gth_input_reverse(input)
@@ -429,14 +456,11 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
            change the direction of the genomic and the reference strand */
         gth_sa_set_gen_strand(saA, !directmatches);
         gth_sa_set_ref_strand(saA, false);
+        saB = NULL;
       }
       else {
         /* allocating space for second alignment */
-        saB = gth_sa_new_and_set(!directmatches, false, input,
-                                 chain->gen_file_num, chain->gen_seq_num,
-                                 chain->ref_file_num, chain->ref_seq_num,
-                                 match_info->call_number, gen_total_length,
-                                 gen_offset, ref_total_length);
+        saB = csa->saB = gth_sa_new_like(saA, !directmatches, false);
       }
 
       /* setting gs2outdirectmatches (for compatibility) */
@@ -444,12 +468,14 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
 
       /* calculate alignment */
       rval = callsahmt(true, firstdp ? saA : saB, !directmatches,
-                       gen_file_num, ref_file_num, chain, gen_total_length,
-                       gen_offset, gen_seq_bounds, gen_seq_bounds_rc,
-                       ref_seq_tran_rc, ref_seq_orig_rc, ref_total_length,
-                       ref_offset, input,
+                       gen_file_num, ref_file_num, csa->chain,
+                       csa->gen_total_length, csa->gen_offset,
+                       &csa->gen_seq_bounds, &csa->gen_seq_bounds_rc,
+                       csa->ref_seq_tran_rc, csa->ref_seq_orig_rc,
+                       csa->ref_total_length, csa->ref_offset, input,
                        &call_info->simfilterparam.introncutoutinfo, stat,
-                       chainctr, num_of_chains, call_info->translationtable,
+                       csa->chainctr, num_of_chains,
+                       call_info->translationtable,
                        directmatches, call_info->proteinexonpenal,
                        call_info->splice_site_model, call_info->dp_options_core,
                        call_info->dp_options_est, call_info->dp_options_postpro,
@@ -465,36 +491,35 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
             isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
           /* for compatibility with GS2 */
           /* XXX: makes no sense. Possibly only if -gs2out is used. */
-          match_info->significant_match_found= true;
+          csa->outcome = GTH_SA_DISCARD_SIGNIFICANT;
 
-          /* if the spliced alignment was unsuccessful, it is deleted and
+          /* if the spliced alignment was unsuccessful, it is discarded and
              the next hit is considered. */
-          gth_sa_delete(saA);
           return 0; /* continue */
         }
 
-        save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+        csa->sa = saA;
+        csa->outcome = GTH_SA_SAVE;
       }
       else /* !firstdp */
       {
         if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
             isunsuccessfulalignment(saB, call_info->out->comments, outfp) ||
             !gth_sa_B_is_better_than_A(saA, saB)) {
-          /* insert first SA */
-          save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
-          /* discard second SA */
-          gth_sa_delete(saB);
+          /* insert first SA, the second one is discarded */
+          csa->sa = saA;
         }
         else {
-          /* insert second SA */
-          save_sa(sa_collection, saB, call_info->sa_filter, match_info, stat);
-          /* free first SA */
-          gth_sa_delete(saA);
+          /* insert second SA, the first one is discarded */
+          csa->sa = saB;
         }
+        csa->outcome = GTH_SA_SAVE;
       }
     }
-    else
-      save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+    else {
+      csa->sa = saA;
+      csa->outcome = GTH_SA_SAVE;
+    }
   }
 
   return 0;
@@ -504,22 +529,10 @@ static int call_protein_DP(bool directmatches,
                            GthCallInfo *call_info,
                            GthInput *input,
                            GthStat *stat,
-                           GthSACollection *sa_collection,
-                           GthSA *saA,
+                           GthChainSA *csa,
                            GtUword gen_file_num,
                            GtUword ref_file_num,
-                           GtUword gen_total_length,
-                           GtUword gen_offset,
-                           const GtRange *gen_seq_bounds,
-                           const GtRange *gen_seq_bounds_rc,
-                           GtUword ref_total_length,
-                           GtUword ref_offset,
-                           GtUword chainctr,
                            GtUword num_of_chains,
-                           GthMatchInfo *match_info,
-                           const unsigned char *ref_seq_tran,
-                           const unsigned char *ref_seq_orig,
-                           GthChain *chain,
                            GthDNACompletePathMatrixJT
                            dna_complete_path_matrix_jt,
                            GthProteinCompletePathMatrixJT
@@ -537,15 +550,17 @@ static int call_protein_DP(bool directmatches,
 #endif
 
   /* calculate alignment */
-  rval = callsahmt(false, saA, directmatches, gen_file_num, ref_file_num,
-                   chain, gen_total_length, gen_offset, gen_seq_bounds,
-                   gen_seq_bounds_rc, ref_seq_tran, ref_seq_orig,
-                   ref_total_length, ref_offset, input,
-                   &call_info->simfilterparam.introncutoutinfo, stat, chainctr,
-                   num_of_chains, call_info->translationtable, directmatches,
-                   call_info->proteinexonpenal, call_info->splice_site_model,
-                   call_info->dp_options_core, call_info->dp_options_est,
-                   call_info->dp_options_postpro, dna_complete_path_matrix_jt,
+  rval = callsahmt(false, csa->saA, directmatches, gen_file_num, ref_file_num,
+                   csa->chain, csa->gen_total_length, csa->gen_offset,
+                   &csa->gen_seq_bounds, &csa->gen_seq_bounds_rc,
+                   csa->ref_seq_tran, csa->ref_seq_orig,
+                   csa->ref_total_length, csa->ref_offset, input,
+                   &call_info->simfilterparam.introncutoutinfo, stat,
+                   csa->chainctr, num_of_chains, call_info->translationtable,
+                   directmatches, call_info->proteinexonpenal,
+                   call_info->splice_site_model, call_info->dp_options_core,
+                   call_info->dp_options_est, call_info->dp_options_postpro,
+                   dna_complete_path_matrix_jt,
                    protein_complete_path_matrix_jt, call_info->out);
   if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                    /* ^ this error is treated below */
@@ -553,17 +568,17 @@ static int call_protein_DP(bool directmatches,
   }
 
   if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-      isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
-    match_info->call_number--;
-    /* if the spliced alignment was unsuccessful, it is deleted and the
+      isunsuccessfulalignment(csa->saA, call_info->out->comments, outfp)) {
+    /* if the spliced alignment was unsuccessful, it is discarded and the
        next hit is considered. */
-    gth_sa_delete(saA);
+    csa->outcome = GTH_SA_DISCARD;
     /* continue */
     return 0;
   }
 
   /* we can save the alignment now */
-  save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+  csa->sa = csa->saA;
+  csa->outcome = GTH_SA_SAVE;
 
   return 0;
 }
@@ -584,46 +599,425 @@ static void show_no_match_line(GthAlphatype overallalphatype, GtFile *outfp)
   gt_file_xprintf(outfp, " matches were found.\n");
 }
 
-static GthChainCollection* match_and_chain(GthCallInfo *call_info,
-                                           GthInput *input,
-                                           GthStat *stat,
-                                           GtUword gen_file_num,
-                                           GtUword ref_file_num,
-                                           bool directmatches,
-                                           GthMatchInfo *match_info,
-                                           const GthPlugins *plugins)
+/* the following function computes the chains and stores them in
+   <chain_collection>, which is set to NULL if there is nothing to align */
+static int match_and_chain(GthChainCollection **chain_collection,
+                           GthCallInfo *call_info,
+                           GthInput *input,
+                           GthStat *stat,
+                           GtUword gen_file_num,
+                           GtUword ref_file_num,
+                           bool directmatches,
+                           GthMatchInfo *match_info,
+                           const GthPlugins *plugins,
+                           GtError *err)
 {
   GtFile *outfp = call_info->out->outfp;
-  GthChainCollection *chain_collection = gth_chain_collection_new();
+  gt_error_check(err);
+  *chain_collection = gth_chain_collection_new();
 
   /* compute the chains */
-  gth_chaining(chain_collection, gen_file_num, ref_file_num, call_info, input,
-               stat, directmatches, plugins);
+  if (gth_chaining(*chain_collection, gen_file_num, ref_file_num, call_info,
+                   input, stat, directmatches, plugins, err)) {
+    gth_chain_collection_delete(*chain_collection);
+    *chain_collection = NULL;
+    return -1;
+  }
 
   /* update statistics */
   gth_stat_increase_numofchains(stat,
-                                gth_chain_collection_size(chain_collection));
+                                gth_chain_collection_size(*chain_collection));
 
   /* stop after chaining phase */
   if (call_info->simfilterparam.stopafterchaining) {
-    gth_chain_collection_delete(chain_collection);
-    return NULL;
+    gth_chain_collection_delete(*chain_collection);
+    *chain_collection = NULL;
+    return 0;
   }
 
   if (call_info->out->showverbose)
     call_info->out->showverbose("calculate spliced alignment for every chain");
 
-  if (!gth_chain_collection_size(chain_collection)) {
+  if (!gth_chain_collection_size(*chain_collection)) {
     /* no matches found -> return */
     if (!call_info->out->xmlout && !call_info->out->gff3out && !directmatches &&
         !match_info->significant_match_found) {
       show_no_match_line(gth_input_get_alphatype(input, ref_file_num), outfp);
     }
-    gth_chain_collection_delete(chain_collection);
-    return NULL;
+    gth_chain_collection_delete(*chain_collection);
+    *chain_collection = NULL;
+    return 0;
+  }
+
+  return 0;
+}
+
+/* the following function increments the call number and returns true if the
+   maximal number of matches to show is exceeded by it */
+static bool max_call_number_reached(GthCallInfo *call_info,
+                                    GthMatchInfo *match_info,
+                                    bool refseqisdna)
+{
+  GtFile *outfp = call_info->out->outfp;
+
+  if (++match_info->call_number > call_info->firstalshown &&
+      call_info->firstalshown > 0) {
+    if (!(call_info->out->xmlout || call_info->out->gff3out))
+      gt_file_xfputc('\n', outfp);
+    else if (call_info->out->xmlout)
+      gt_file_xprintf(outfp, "<!--\n");
+
+    if (!call_info->out->gff3out) {
+      gt_file_xprintf(outfp, "Maximal matching %s count (%u) reached.\n",
+                      refseqisdna ? "EST" : "protein",
+                      call_info->firstalshown);
+      gt_file_xprintf(outfp, "Only the first %u matches will be "
+                         "displayed.\n", call_info->firstalshown);
+    }
+
+    if (!(call_info->out->xmlout || call_info->out->gff3out))
+      gt_file_xfputc('\n', outfp);
+    else if (call_info->out->xmlout)
+      gt_file_xprintf(outfp, "-->\n");
+
+    match_info->max_call_number_reached = true;
+    return true;
+  }
+  return false;
+}
+
+static void prepare_chain_sa(GthChainSA *csa, GthChain *chain,
+                             GtUword chainctr, GthInput *input,
+                             bool directmatches, bool refseqisdna)
+{
+  GtRange range;
+
+  csa->chain = chain;
+  csa->chainctr = chainctr;
+  csa->gen_offset = GT_UNDEF_UWORD;
+  csa->ref_seq_tran_rc = NULL;
+  csa->ref_seq_orig_rc = NULL;
+  csa->saB = NULL;
+  csa->sa = NULL;
+  csa->outcome = GTH_SA_DISCARD;
+  csa->computed = false;
+
+  /* compute considered genomic regions if not set by -frompos */
+  if (!gth_input_use_substring_spec(input)) {
+    csa->gen_seq_bounds = gth_input_get_genomic_range(input,
+                                                      chain->gen_file_num,
+                                                      chain->gen_seq_num);
+    csa->gen_total_length  = gt_range_length(&csa->gen_seq_bounds);
+    csa->gen_offset        = csa->gen_seq_bounds.start;
+    csa->gen_seq_bounds_rc = csa->gen_seq_bounds;
+  }
+  else {
+    /* genomic multiseq contains exactly one sequence */
+    gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
+    csa->gen_total_length =
+      gth_input_genomic_file_total_length(input, chain->gen_file_num);
+    csa->gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
+    csa->gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
+    csa->gen_offset              = 0;
+    csa->gen_seq_bounds_rc.start = csa->gen_total_length - 1 -
+                                   csa->gen_seq_bounds.end;
+    csa->gen_seq_bounds_rc.end   = csa->gen_total_length - 1 -
+                                   csa->gen_seq_bounds.start;
+  }
+
+  /* "retrieving" the reference sequence */
+  range = gth_input_get_reference_range(input, chain->ref_file_num,
+                                        chain->ref_seq_num);
+  csa->ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
+  csa->ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
+  if (refseqisdna) {
+    csa->ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input) +
+                           range.start;
+    csa->ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input) +
+                           range.start;
+  }
+  csa->ref_total_length = range.end - range.start + 1;
+  csa->ref_offset = range.start;
+
+  /* allocating space for alignment, the call number is set when it is
+     saved */
+  csa->saA = gth_sa_new_and_set(directmatches, true, input, chain->gen_file_num,
+                                chain->gen_seq_num, chain->ref_file_num,
+                                chain->ref_seq_num, 0, csa->gen_total_length,
+                                csa->gen_offset, csa->ref_total_length);
+
+  /* extend the DP borders to the left and to the right */
+  gth_chain_extend_borders(chain, &csa->gen_seq_bounds, &csa->gen_seq_bounds_rc,
+                           csa->gen_total_length, csa->gen_offset);
+
+  /* From here on the dp positions always refer to the forward strand of the
+     genomic DNA. */
+}
+
+/* check if protein sequences have a stop amino acid */
+static void check_stop_amino_acid(const GthChainSA *csa, GthInput *input,
+                                  GthMatchInfo *match_info, bool refseqisdna)
+{
+  if (!refseqisdna && !match_info->stop_amino_acid_warning &&
+     csa->ref_seq_orig[csa->ref_total_length - 1] != GT_STOP_AMINO) {
+    GtStr *ref_id = gt_str_new();
+    gth_input_save_ref_id(input, ref_id, csa->chain->ref_file_num,
+                          csa->chain->ref_seq_num);
+    gt_warning("protein sequence '%s' (#" GT_WU " in file %s) does not end "
+               "with a stop amino acid ('%c'). If it is not a protein "
+               "fragment you should add a stop amino acid to improve the "
+               "prediction. For example with `gt seqtransform "
+               "-addstopaminos` (see http://genometools.org for details).",
+               gt_str_get(ref_id), csa->chain->ref_seq_num,
+               gth_input_get_reference_filename(input,
+                                                csa->chain->ref_file_num),
+               GT_STOP_AMINO);
+    match_info->stop_amino_acid_warning = true;
+    gt_str_delete(ref_id);
+  }
+}
+
+/* computes the spliced alignment of <csa>, only reads <input> */
+static int compute_chain_sa(GthChainSA *csa,
+                            GthCallInfo *call_info,
+                            GthInput *input,
+                            GthStat *stat,
+                            GtUword gen_file_num,
+                            GtUword ref_file_num,
+                            bool directmatches,
+                            bool refseqisdna,
+                            GtUword num_of_chains,
+                            GthDNACompletePathMatrixJT
+                            dna_complete_path_matrix_jt,
+                            GthProteinCompletePathMatrixJT
+                            protein_complete_path_matrix_jt)
+{
+  int rval;
+
+  /* call the Dynamic Programming */
+  if (refseqisdna) {
+    rval = call_dna_DP(directmatches, call_info, input, stat, csa,
+                       gen_file_num, ref_file_num, num_of_chains,
+                       dna_complete_path_matrix_jt,
+                       protein_complete_path_matrix_jt);
+  }
+  else {
+    rval = call_protein_DP(directmatches, call_info, input, stat, csa,
+                           gen_file_num, ref_file_num, num_of_chains,
+                           dna_complete_path_matrix_jt,
+                           protein_complete_path_matrix_jt);
+  }
+  /* check return value */
+  if (rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
+    /* statistics bookkeeping */
+    gth_stat_increment_numoffailedDPparameterallocations(stat);
+    gth_stat_increment_numofundeterminedSAs(stat);
+    csa->sa = NULL;
+    csa->outcome = GTH_SA_DISCARD;
+    return 0; /* continue with the next DP range */
+  }
+  return rval;
+}
+
+/* frees the alignments of <csa> which have not been saved */
+static void discard_chain_sa(GthChainSA *csa)
+{
+  gth_sa_delete(csa->saA);
+  gth_sa_delete(csa->saB);
+  csa->saA = csa->saB = csa->sa = NULL;
+}
+
+/* saves the alignment of <csa> in <sa_collection>, in the order of the
+   chains, and frees the other alignments */
+static void save_chain_sa(GthSACollection *sa_collection, GthChainSA *csa,
+                          GthCallInfo *call_info, GthStat *stat,
+                          GthMatchInfo *match_info)
+{
+  gt_assert(csa->computed);
+  switch (csa->outcome) {
+    case GTH_SA_SAVE:
+      gt_assert(csa->sa == csa->saA || csa->sa == csa->saB);
+      if (csa->sa == csa->saA)
+        csa->saA = NULL;
+      else
+        csa->saB = NULL;
+      gth_sa_set_call_number(csa->sa, match_info->call_number);
+      save_sa(sa_collection, csa->sa, call_info->sa_filter, match_info, stat);
+      break;
+    case GTH_SA_DISCARD:
+      match_info->call_number--;
+      break;
+    case GTH_SA_DISCARD_SIGNIFICANT:
+      match_info->significant_match_found = true;
+      break;
+    default: gt_assert(0);
+  }
+  discard_chain_sa(csa);
+}
+
+typedef struct {
+  GthChainSA *csas;
+  GthSACollection *sa_collection;
+  GthCallInfo *call_info;
+  GthInput *input;
+  GthStat *stat,
+          **stats;
+  GthMatchInfo *match_info;
+  GthDNACompletePathMatrixJT dna_complete_path_matrix_jt;
+  GthProteinCompletePathMatrixJT protein_complete_path_matrix_jt;
+  GtMutex *mutex;
+  GtUword gen_file_num,
+          ref_file_num,
+          num_of_chains,
+          next_chain,
+          num_of_saved;
+  unsigned int next_thread;
+  bool directmatches,
+       refseqisdna,
+       next_counted,  /* the chain <num_of_saved> counts for the -first limit */
+       stop,
+       had_err;
+} GthChainSAInfo;
+
+/* saves the computed chains following the saved ones, in the order of the
+   chains. Whether the -first limit is reached before a chain only depends on
+   the chains before it, hence no more chains are scheduled as soon as it is.
+   Must be called with <info->mutex> locked, the alignments of the threads are
+   only saved and freed here. */
+static void save_computed_chain_sas(GthChainSAInfo *info)
+{
+  while (!info->stop && info->num_of_saved < info->num_of_chains) {
+    if (!info->next_counted) {
+      if (max_call_number_reached(info->call_info, info->match_info,
+                                  info->refseqisdna)) {
+        info->stop = true;
+        info->next_chain = info->num_of_chains;
+        break;
+      }
+      info->next_counted = true;
+    }
+    if (!info->csas[info->num_of_saved].computed)
+      break;
+    save_chain_sa(info->sa_collection, info->csas + info->num_of_saved,
+                  info->call_info, info->stat, info->match_info);
+    info->num_of_saved++;
+    info->next_counted = false;
   }
+}
+
+static void* compute_chain_sas_thread(void *data)
+{
+  GthChainSAInfo *info = data;
+  GthStat *stat;
+  GtUword chainctr;
+  int rval;
 
-  return chain_collection;
+  gt_mutex_lock(info->mutex);
+  stat = info->stats[info->next_thread++];
+  gt_mutex_unlock(info->mutex);
+
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    if (info->had_err || info->next_chain == info->num_of_chains) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    chainctr = info->next_chain++;
+    gt_mutex_unlock(info->mutex);
+
+    rval = compute_chain_sa(info->csas + chainctr, info->call_info,
+                            info->input, stat, info->gen_file_num,
+                            info->ref_file_num, info->directmatches,
+                            info->refseqisdna, info->num_of_chains,
+                            info->dna_complete_path_matrix_jt,
+                            info->protein_complete_path_matrix_jt);
+    gt_mutex_lock(info->mutex);
+    if (rval)
+      info->had_err = true;
+    else {
+      info->csas[chainctr].computed = true;
+      save_computed_chain_sas(info);
+    }
+    gt_mutex_unlock(info->mutex);
+  }
+  return NULL;
+}
+
+/* computes the spliced alignments of the chains in <gt_jobs> threads, each
+   with its own DP matrices and statistics. The alignments are saved in the
+   order of the chains, therefore the result is the same as for the
+   sequential computation. */
+static int calc_spliced_alignments_threaded(GthSACollection *sa_collection,
+                                            GthChainCollection
+                                            *chain_collection,
+                                            GthCallInfo *call_info,
+                                            GthInput *input,
+                                            GthStat *stat,
+                                            GtUword gen_file_num,
+                                            GtUword ref_file_num,
+                                            bool directmatches,
+                                            bool refseqisdna,
+                                            GthMatchInfo *match_info,
+                                            GthDNACompletePathMatrixJT
+                                            dna_complete_path_matrix_jt,
+                                            GthProteinCompletePathMatrixJT
+                                            protein_complete_path_matrix_jt,
+                                            GtError *err)
+{
+  GthChainSAInfo info;
+  GtUword chainctr;
+  unsigned int t;
+  int had_err;
+
+  info.num_of_chains = gth_chain_collection_size(chain_collection);
+  info.csas = gt_malloc(sizeof (*info.csas) * info.num_of_chains);
+  for (chainctr = 0; chainctr < info.num_of_chains; chainctr++) {
+    prepare_chain_sa(info.csas + chainctr,
+                     gth_chain_collection_get(chain_collection, chainctr),
+                     chainctr, input, directmatches, refseqisdna);
+  }
+  info.sa_collection = sa_collection;
+  info.call_info = call_info;
+  info.input = input;
+  info.stat = stat;
+  info.stats = gt_malloc(sizeof (*info.stats) * gt_jobs);
+  for (t = 0; t < gt_jobs; t++)
+    info.stats[t] = gth_stat_new();
+  info.match_info = match_info;
+  info.dna_complete_path_matrix_jt = dna_complete_path_matrix_jt;
+  info.protein_complete_path_matrix_jt = protein_complete_path_matrix_jt;
+  info.mutex = gt_mutex_new();
+  info.gen_file_num = gen_file_num;
+  info.ref_file_num = ref_file_num;
+  info.next_chain = 0;
+  info.num_of_saved = 0;
+  info.next_thread = 0;
+  info.directmatches = directmatches;
+  info.refseqisdna = refseqisdna;
+  info.next_counted = false;
+  info.stop = false;
+  info.had_err = false;
+
+  /* the limit might be reached before the first chain */
+  save_computed_chain_sas(&info);
+  had_err = gt_multithread(compute_chain_sas_thread, &info, err);
+  if (!had_err && info.had_err)
+    had_err = -1;
+
+  /* the warning accesses the input, which is not done by the threads */
+  for (chainctr = 0; chainctr < info.num_of_saved; chainctr++)
+    check_stop_amino_acid(info.csas + chainctr, input, match_info, refseqisdna);
+  for (chainctr = info.num_of_saved; chainctr < info.num_of_chains; chainctr++)
+    discard_chain_sa(info.csas + chainctr);
+
+  for (t = 0; t < gt_jobs; t++) {
+    gth_stat_add_counters(stat, info.stats[t]);
+    gth_stat_delete(info.stats[t]);
+  }
+  gt_free(info.stats);
+  gt_mutex_delete(info.mutex);
+  gt_free(info.csas);
+  return had_err;
 }
 
 static int calc_spliced_alignments(GthSACollection *sa_collection,
@@ -638,150 +1032,54 @@ static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthDNACompletePathMatrixJT
                                    dna_complete_path_matrix_jt,
                                    GthProteinCompletePathMatrixJT
-                                   protein_complete_path_matrix_jt)
+                                   protein_complete_path_matrix_jt,
+                                   GtError *err)
 {
-  const unsigned char *ref_seq_tran, *ref_seq_orig, *ref_seq_tran_rc = NULL,
-                      *ref_seq_orig_rc = NULL;
-  GtUword chainctr, gen_offset = GT_UNDEF_UWORD, gen_total_length,
-                ref_total_length;
+  GtUword chainctr;
   GtFile *outfp = call_info->out->outfp;
-  GtRange gen_seq_bounds, gen_seq_bounds_rc;
   bool refseqisdna;
-  GthChain *chain;
-  GtRange range;
-  GthSA *saA;
-  int rval;
+  GthChainSA csa;
 
   gt_assert(sa_collection && chain_collection);
 
   refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
 
-  for (chainctr = 0;
-       chainctr < gth_chain_collection_size(chain_collection);
-       chainctr++) {
-       chain = gth_chain_collection_get(chain_collection, chainctr);
-    if (++match_info->call_number > call_info->firstalshown &&
-        call_info->firstalshown > 0) {
-      if (!(call_info->out->xmlout || call_info->out->gff3out))
-        gt_file_xfputc('\n', outfp);
-      else if (call_info->out->xmlout)
-        gt_file_xprintf(outfp, "<!--\n");
-
-      if (!call_info->out->gff3out) {
-        gt_file_xprintf(outfp, "Maximal matching %s count (%u) reached.\n",
-                        refseqisdna ? "EST" : "protein",
-                        call_info->firstalshown);
-        gt_file_xprintf(outfp, "Only the first %u matches will be "
-                           "displayed.\n", call_info->firstalshown);
-      }
-
-      if (!(call_info->out->xmlout || call_info->out->gff3out))
-        gt_file_xfputc('\n', outfp);
-      else if (call_info->out->xmlout)
-        gt_file_xprintf(outfp, "-->\n");
-
-      match_info->max_call_number_reached = true;
-      break; /* break out of loop */
-    }
-
-    /* compute considered genomic regions if not set by -frompos */
-    if (!gth_input_use_substring_spec(input)) {
-      gen_seq_bounds = gth_input_get_genomic_range(input, chain->gen_file_num,
-                                                   chain->gen_seq_num);
-      gen_total_length      = gt_range_length(&gen_seq_bounds);
-      gen_offset            = gen_seq_bounds.start;
-      gen_seq_bounds_rc     = gen_seq_bounds;
-    }
-    else {
-      /* genomic multiseq contains exactly one sequence */
-      gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
-      gen_total_length = gth_input_genomic_file_total_length(input,
-                                                             chain
-                                                             ->gen_file_num);
-      gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
-      gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
-      gen_offset              = 0;
-      gen_seq_bounds_rc.start = gen_total_length - 1 - gen_seq_bounds.end;
-      gen_seq_bounds_rc.end   = gen_total_length - 1 - gen_seq_bounds.start;
-    }
-
-    /* "retrieving" the reference sequence */
-    range = gth_input_get_reference_range(input, chain->ref_file_num,
-                                          chain->ref_seq_num);
-    ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
-    ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
-    if (refseqisdna) {
-      ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input) + range.start;
-      ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input) + range.start;
-    }
-    ref_total_length = range.end - range.start + 1;
-
-    /* check if protein sequences have a stop amino acid */
-    if (!refseqisdna && !match_info->stop_amino_acid_warning &&
-       ref_seq_orig[ref_total_length - 1] != GT_STOP_AMINO) {
-      GtStr *ref_id = gt_str_new();
-      gth_input_save_ref_id(input, ref_id, chain->ref_file_num,
-                            chain->ref_seq_num);
-      gt_warning("protein sequence '%s' (#" GT_WU " in file %s) does not end "
-                 "with a stop amino acid ('%c'). If it is not a protein "
-                 "fragment you should add a stop amino acid to improve the "
-                 "prediction. For example with `gt seqtransform "
-                 "-addstopaminos` (see http://genometools.org for details).",
-                 gt_str_get(ref_id), chain->ref_seq_num,
-                 gth_input_get_reference_filename(input, chain->ref_file_num),
-                 GT_STOP_AMINO);
-      match_info->stop_amino_acid_warning = true;
-      gt_str_delete(ref_id);
-    }
-
-    /* allocating space for alignment */
-    saA = gth_sa_new_and_set(directmatches, true, input, chain->gen_file_num,
-                             chain->gen_seq_num, chain->ref_file_num,
-                             chain->ref_seq_num, match_info->call_number,
-                             gen_total_length, gen_offset, ref_total_length);
-
-    /* extend the DP borders to the left and to the right */
-    gth_chain_extend_borders(chain, &gen_seq_bounds, &gen_seq_bounds_rc,
-                             gen_total_length, gen_offset);
-
-    /* From here on the dp positions always refer to the forward strand of the
-       genomic DNA. */
-
-    /* call the Dynamic Programming */
-    if (refseqisdna) {
-      rval = call_dna_DP(directmatches, call_info, input, stat,
-                         sa_collection, saA, gen_file_num, ref_file_num,
-                         gen_total_length, gen_offset, &gen_seq_bounds,
-                         &gen_seq_bounds_rc, ref_total_length, range.start,
-                         chainctr, gth_chain_collection_size(chain_collection),
-                         match_info, ref_seq_tran, ref_seq_orig,
-                         ref_seq_tran_rc, ref_seq_orig_rc, chain,
-                         dna_complete_path_matrix_jt,
-                         protein_complete_path_matrix_jt);
-    }
-    else {
-      rval = call_protein_DP(directmatches, call_info, input,
-                             stat, sa_collection, saA, gen_file_num,
-                             ref_file_num, gen_total_length, gen_offset,
-                             &gen_seq_bounds, &gen_seq_bounds_rc,
-                             ref_total_length, range.start, chainctr,
-                             gth_chain_collection_size(chain_collection),
-                             match_info, ref_seq_tran, ref_seq_orig, chain,
-                             dna_complete_path_matrix_jt,
-                             protein_complete_path_matrix_jt);
+  /* the comments written during the computation require the sequential
+     order */
+  if (gt_jobs > 1 && gth_chain_collection_size(chain_collection) > 1 &&
+      !call_info->out->comments && !call_info->out->showeops &&
+      !call_info->out->showverbose) {
+    if (calc_spliced_alignments_threaded(sa_collection, chain_collection,
+                                         call_info, input, stat, gen_file_num,
+                                         ref_file_num, directmatches,
+                                         refseqisdna, match_info,
+                                         dna_complete_path_matrix_jt,
+                                         protein_complete_path_matrix_jt,
+                                         err)) {
+      return -1;
     }
-    /* check return value */
-    if (rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
-      /* statistics bookkeeping */
-      gth_stat_increment_numoffailedDPparameterallocations(stat);
-      gth_stat_increment_numofundeterminedSAs(stat);
-      /* free space */
-      gth_sa_delete(saA);
-      match_info->call_number--;
-      continue; /* continue with the next DP range */
+  }
+  else {
+    for (chainctr = 0;
+         chainctr < gth_chain_collection_size(chain_collection);
+         chainctr++) {
+      if (max_call_number_reached(call_info, match_info, refseqisdna))
+        break; /* break out of loop */
+      prepare_chain_sa(&csa,
+                       gth_chain_collection_get(chain_collection, chainctr),
+                       chainctr, input, directmatches, refseqisdna);
+      check_stop_amino_acid(&csa, input, match_info, refseqisdna);
+      if (compute_chain_sa(&csa, call_info, input, stat, gen_file_num,
+                           ref_file_num, directmatches, refseqisdna,
+                           gth_chain_collection_size(chain_collection),
+                           dna_complete_path_matrix_jt,
+                           protein_complete_path_matrix_jt)) {
+        discard_chain_sa(&csa);
+        return -1;
+      }
+      csa.computed = true;
+      save_chain_sa(sa_collection, &csa, call_info, stat, match_info);
     }
-    else if (rval)
-      return -1;
   }
 
   if (!call_info->out->xmlout && !call_info->out->gff3out && !directmatches &&
@@ -833,7 +1131,8 @@ static int compute_sa_collection(GthSACollection *sa_collection,
                                  GthCallInfo *call_info,
                                  GthInput *input,
                                  GthStat *stat,
-                                 const GthPlugins *plugins)
+                                 const GthPlugins *plugins,
+                                 GtError *err)
 {
   GthChainCollection *chain_collection;
   GthMatchInfo match_info;
@@ -845,7 +1144,7 @@ static int compute_sa_collection(GthSACollection *sa_collection,
   match_info.max_call_number_reached = false;
   match_info.stop_amino_acid_warning = false;
 
-  for (g = 0; g < gth_input_num_of_gen_files(input); g++) {
+  for (g = 0; !rval && g < gth_input_num_of_gen_files(input); g++) {
     for (r = 0; r < gth_input_num_of_ref_files(input); r++) {
       if (gth_input_get_alphatype(input, r) == DNA_ALPHA ||
           gth_input_forward(input)) {
@@ -855,15 +1154,18 @@ static int compute_sa_collection(GthSACollection *sa_collection,
                                       gth_input_num_of_ref_files(input));
         }
         /* compute direct matches */
-        chain_collection = match_and_chain(call_info, input, stat, g, r, true,
-                                           &match_info, plugins);
+        rval = match_and_chain(&chain_collection, call_info, input, stat, g,
+                               r, true, &match_info, plugins, err);
+        if (rval)
+          break;
         if (chain_collection) {
           rval = calc_spliced_alignments(sa_collection, chain_collection,
                                          call_info, input, stat, g, r, true,
                                          &match_info,
                                          plugins->dna_complete_path_matrix_jt,
                                          plugins
-                                         ->protein_complete_path_matrix_jt);
+                                         ->protein_complete_path_matrix_jt,
+                                         err);
           gth_chain_collection_delete(chain_collection);
           if (rval)
             break;
@@ -880,15 +1182,18 @@ static int compute_sa_collection(GthSACollection *sa_collection,
                                       gth_input_num_of_ref_files(input));
         }
         /* compute reverse complemented (palindromic) matches */
-        chain_collection = match_and_chain(call_info, input, stat, g, r, false,
-                                           &match_info, plugins);
+        rval = match_and_chain(&chain_collection, call_info, input, stat, g,
+                               r, false, &match_info, plugins, err);
+        if (rval)
+          break;
         if (chain_collection) {
           rval = calc_spliced_alignments(sa_collection, chain_collection,
                                          call_info, input, stat, g, r, false,
                                          &match_info,
                                          plugins->dna_complete_path_matrix_jt,
                                          plugins
-                                         ->protein_complete_path_matrix_jt);
+                                         ->protein_complete_path_matrix_jt,
+                                         err);
           gth_chain_collection_delete(chain_collection);
           if (rval)
             break;
@@ -904,7 +1209,7 @@ static int compute_sa_collection(GthSACollection *sa_collection,
 
 int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
                           GthStat *stat, unsigned int indentlevel,
-                          const GthPlugins *plugins, GT_UNUSED GtError *err)
+                          const GthPlugins *plugins, GtError *err)
 {
   GthSACollection *sa_collection; /* stores the calculated spliced alignments */
 
@@ -914,7 +1219,8 @@ int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
   sa_collection = gth_sa_collection_new(call_info->duplicate_check);
 
   /* compute the spliced alignments */
-  if (compute_sa_collection(sa_collection, call_info, input, stat, plugins)) {
+  if (compute_sa_collection(sa_collection, call_info, input, stat, plugins,
+                            err)) {
     gth_sa_collection_delete(sa_collection);
     return -1;
   }
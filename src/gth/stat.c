@@ -60,7 +60,8 @@ struct GthStat {
        numofSAs,                         /* number of computed SAs */
        numofPGLs_stored,                 /* number of stored PGLs */
        totalsizeofbacktracematricesinMB,
-       numofbacktracematrixallocations;
+       numofbacktracematrixallocations,
+       numofcheckpointedbacktracematrices;
 
   /* distributions */
   GtDiscDistri *exondistribution,
@@ -98,6 +99,7 @@ GthStat *gth_stat_new(void)
   stat->numofPGLs_stored                  = 0;
   stat->totalsizeofbacktracematricesinMB  = 0;
   stat->numofbacktracematrixallocations   = 0;
+  stat->numofcheckpointedbacktracematrices = 0;
 
   /* init distributions */
   stat->exondistribution = gt_disc_distri_new();
@@ -182,6 +184,12 @@ void gth_stat_increment_numofbacktracematrixallocations(GthStat *stat)
   stat->numofbacktracematrixallocations++;
 }
 
+void gth_stat_increment_numofcheckpointedbacktracematrices(GthStat *stat)
+{
+  gt_assert(stat);
+  stat->numofcheckpointedbacktracematrices++;
+}
+
 void gth_stat_increment_numofremovedzerobaseexons(GthStat *stat)
 {
   gt_assert(stat);
@@ -214,6 +222,30 @@ void gth_stat_increase_numofPGLs_stored(GthStat *stat, GtUword addend)
   stat->numofPGLs_stored += addend;
 }
 
+void gth_stat_add_counters(GthStat *dest, const GthStat *src)
+{
+  gt_assert(dest && src);
+  dest->numofchains += src->numofchains;
+  dest->numofremovedzerobaseexons += src->numofremovedzerobaseexons;
+  dest->numofautointroncutoutcalls += src->numofautointroncutoutcalls;
+  dest->numofunsuccessfulintroncutoutDPs +=
+    src->numofunsuccessfulintroncutoutDPs;
+  dest->numoffailedDPparameterallocations +=
+    src->numoffailedDPparameterallocations;
+  dest->numoffailedmatrixallocations += src->numoffailedmatrixallocations;
+  dest->numofundeterminedSAs += src->numofundeterminedSAs;
+  dest->numoffilteredpolyAtailmatches += src->numoffilteredpolyAtailmatches;
+  dest->numofSAs += src->numofSAs;
+  dest->numofPGLs_stored += src->numofPGLs_stored;
+  gt_safe_add(dest->totalsizeofbacktracematricesinMB,
+              dest->totalsizeofbacktracematricesinMB,
+              src->totalsizeofbacktracematricesinMB);
+  dest->numofbacktracematrixallocations +=
+    src->numofbacktracematrixallocations;
+  dest->numofcheckpointedbacktracematrices +=
+    src->numofcheckpointedbacktracematrices;
+}
+
 GtUword gth_stat_get_numofSAs(GthStat *stat)
 {
   gt_assert(stat);
@@ -345,6 +377,11 @@ static void outputmemorystatistics(GthStat *stat, bool show_full_stats,
                         "allocated\n", COMMENTCHAR,
                         stat->numofbacktracematrixallocations);
     }
+    if (stat->numofcheckpointedbacktracematrices > 0) {
+      gt_file_xprintf(outfp, "%c "GT_WU" of them have been computed with "
+                      "checkpoints\n", COMMENTCHAR,
+                      stat->numofcheckpointedbacktracematrices);
+    }
   }
 }
 
@@ -38,12 +38,15 @@ void          gth_stat_increment_numofautointroncutoutcalls(GthStat*);
 void          gth_stat_increment_numoffailedmatrixallocations(GthStat*);
 void          gth_stat_increment_numoffailedDPparameterallocations(GthStat*);
 void          gth_stat_increment_numofbacktracematrixallocations(GthStat*);
+void          gth_stat_increment_numofcheckpointedbacktracematrices(GthStat*);
 void          gth_stat_increment_numofremovedzerobaseexons(GthStat*);
 void          gth_stat_increment_numofSAs(GthStat*);
 void          gth_stat_increase_numofchains(GthStat*, GtUword);
 void          gth_stat_increase_totalsizeofbacktracematricesinMB(GthStat*,
                                                                  GtUword);
 void          gth_stat_increase_numofPGLs_stored(GthStat*, GtUword);
+/* add the counters of <src> to <dest>, the distributions are not added */
+void          gth_stat_add_counters(GthStat *dest, const GthStat *src);
 GtUword gth_stat_get_numofSAs(GthStat*);
 bool          gth_stat_get_exondistri(GthStat*);
 bool          gth_stat_get_introndistri(GthStat*);
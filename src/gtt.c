@@ -42,6 +42,7 @@
 #include "core/grep_api.h"
 #include "core/hashmap.h"
 #include "core/hashtable.h"
+#include "core/interval_index.h"
 #include "core/interval_tree.h"
 #include "core/mathsupport.h"
 #include "core/md5_seqid.h"
@@ -62,6 +63,7 @@
 #include "extended/evaluator.h"
 #include "extended/feature_in_stream.h"
 #include "extended/feature_index.h"
+#include "extended/feature_index_binary.h"
 #include "extended/feature_index_memory.h"
 #include "extended/feature_node.h"
 #include "extended/feature_node_iterator_api.h"
@@ -73,6 +75,7 @@
 #include "extended/intset.h"
 #include "extended/luaserialize.h"
 #include "extended/n_r_encseq.h"
+#include "extended/parallel_visitor_stream.h"
 #include "extended/popcount_tab.h"
 #include "extended/priority_queue.h"
 #include "extended/ranked_list.h"
@@ -80,8 +83,13 @@
 #include "extended/rmq.h"
 #include "extended/splicedseq.h"
 #include "extended/string_matching.h"
+#include "extended/striped_align.h"
 #include "extended/tag_value_map.h"
 #include "extended/uint64hashtable.h"
+#include "gth/align_dna.h"
+#include "gth/align_protein.h"
+#include "gth/seed_index.h"
+#include "gth/seed_matcher.h"
 #include "ltr/gt_ltrclustering.h"
 #include "ltr/gt_ltrdigest.h"
 #include "ltr/gt_ltrharvest.h"
@@ -169,9 +177,11 @@
 #include "annotationsketch/diagram.h"
 #include "annotationsketch/gt_sketch.h"
 #include "annotationsketch/gt_sketch_page.h"
+#include "annotationsketch/gt_sketch_tiles.h"
 #include "annotationsketch/image_info.h"
 #include "annotationsketch/rec_map.h"
 #include "annotationsketch/style.h"
+#include "annotationsketch/tile_renderer.h"
 #include "annotationsketch/track.h"
 #endif
 
@@ -261,6 +271,7 @@ GtToolbox* gtt_tools(void)
 #ifndef WITHOUT_CAIRO
   gt_toolbox_add_tool(tools, "sketch", gt_sketch());
   gt_toolbox_add_tool(tools, "sketch_page", gt_sketch_page());
+  gt_toolbox_add_tool(tools, "sketch_tiles", gt_sketch_tiles());
 #endif
 #if defined (HAVE_MYSQL) || defined (HAVE_SQLITE)
   gt_toolbox_add_tool(tools, "featureindex", gt_featureindex());
@@ -285,6 +296,8 @@ GtHashmap* gtt_unit_tests(void)
                                                    gt_array2dim_sparse_example);
   gt_hashmap_add(unit_tests, "array3dim example", gt_array3dim_example);
   gt_hashmap_add(unit_tests, "basename module", gt_basename_unit_test);
+  gt_hashmap_add(unit_tests, "binary feature index class",
+                                             gt_feature_index_binary_unit_test);
   gt_hashmap_add(unit_tests, "bit pack array class", gt_bitpackarray_unit_test);
   gt_hashmap_add(unit_tests, "bit pack string module",
                                                     gt_bitPackString_unit_test);
@@ -326,11 +339,19 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "gff3 escaping module",
                                                     gt_gff3_escaping_unit_test);
   gt_hashmap_add(unit_tests, "grep module", gt_grep_unit_test);
+  gt_hashmap_add(unit_tests, "gth DNA DP module", gth_align_dna_unit_test);
+  gt_hashmap_add(unit_tests, "gth protein DP module",
+                 gth_align_protein_unit_test);
+  gt_hashmap_add(unit_tests, "gth seed index class", gth_seed_index_unit_test);
+  gt_hashmap_add(unit_tests, "gth seed matcher module",
+                                                    gth_seed_matcher_unit_test);
   gt_hashmap_add(unit_tests, "golomb class", gt_golomb_unit_test);
   gt_hashmap_add(unit_tests, "hashmap class", gt_hashmap_unit_test);
   gt_hashmap_add(unit_tests, "hashtable class", gt_hashtable_unit_test);
   gt_hashmap_add(unit_tests, "hmm class", gt_hmm_unit_test);
   gt_hashmap_add(unit_tests, "huffman coding class", gt_huffman_unit_test);
+  gt_hashmap_add(unit_tests, "interval index class",
+                 gt_interval_index_unit_test);
   gt_hashmap_add(unit_tests, "interval tree class", gt_interval_tree_unit_test);
   gt_hashmap_add(unit_tests, "intset classes", gt_intset_unit_test);
   gt_hashmap_add(unit_tests, "Lua serializer module",
@@ -343,6 +364,8 @@ GtHashmap* gtt_unit_tests(void)
                                                           gt_spmlist_unit_test);
   gt_hashmap_add(unit_tests, "PBS finder module",
                                             gt_ltrdigest_pbs_visitor_unit_test);
+  gt_hashmap_add(unit_tests, "parallel visitor stream class",
+                 gt_parallel_visitor_stream_unit_test);
   gt_hashmap_add(unit_tests, "popcount sorted tab", gt_popcount_tab_unit_test);
   gt_hashmap_add(unit_tests, "quality module", gt_quality_unit_test);
   gt_hashmap_add(unit_tests, "queue class", gt_queue_unit_test);
@@ -362,6 +385,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "string class", gt_str_unit_test);
   gt_hashmap_add(unit_tests, "string matching module",
                                                   gt_string_matching_unit_test);
+  gt_hashmap_add(unit_tests, "striped align module",
+                                                   gt_striped_align_unit_test);
   gt_hashmap_add(unit_tests, "symbol module", gt_symbol_unit_test);
   gt_hashmap_add(unit_tests, "tag value map class", gt_tag_value_map_unit_test);
   gt_hashmap_add(unit_tests, "tag value map example", gt_tag_value_map_example);
@@ -379,6 +404,7 @@ GtHashmap* gtt_unit_tests(void)
                                              gt_feature_index_memory_unit_test);
   gt_hashmap_add(unit_tests, "imageinfo class", gt_image_info_unit_test);
   gt_hashmap_add(unit_tests, "line class", gt_line_unit_test);
+  gt_hashmap_add(unit_tests, "tile renderer class", gt_tile_renderer_unit_test);
   gt_hashmap_add(unit_tests, "track class", gt_track_unit_test);
 #endif
 #if defined (HAVE_MYSQL) || defined (HAVE_SQLITE)
@@ -15,6 +15,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/encseq.h"
 #include "core/ma.h"
 #include "core/output_file_api.h"
@@ -29,7 +30,9 @@
 typedef struct {
   GtFile *outfp;
   GtOutputFileInfo *ofi;
-  GtStr  *file_prefix;
+  GtStr  *file_prefix,
+         *matcher,
+         *simcache;
   GtUword psmall,
                 plarge;
   double xdrop,
@@ -43,6 +46,8 @@ static void* gt_ltrclustering_arguments_new(void)
                                                   sizeof (*arguments));
   arguments->ofi = gt_output_file_info_new();
   arguments->file_prefix = gt_str_new();
+  arguments->matcher = gt_str_new();
+  arguments->simcache = gt_str_new();
   return arguments;
 }
 
@@ -51,6 +56,8 @@ static void gt_ltrclustering_arguments_delete(void *tool_arguments)
   GtLTRClusteringArguments *arguments = tool_arguments;
   if (!arguments) return;
   gt_str_delete(arguments->file_prefix);
+  gt_str_delete(arguments->matcher);
+  gt_str_delete(arguments->simcache);
   gt_file_delete(arguments->outfp);
   gt_output_file_info_delete(arguments->ofi);
   gt_free(arguments);
@@ -60,7 +67,12 @@ static GtOptionParser* gt_ltrclustering_option_parser_new(void *tool_arguments)
 {
   GtLTRClusteringArguments *arguments = tool_arguments;
   GtOptionParser *op;
-  GtOption *option;
+  GtOption *option, *matcher_option;
+  static const char *matchers[] = {
+    "last",
+    "native",
+    NULL
+  };
   gt_assert(arguments);
 
   /* init */
@@ -88,6 +100,26 @@ static GtOptionParser* gt_ltrclustering_option_parser_new(void *tool_arguments)
 
   gt_option_is_mandatory(option);
 
+  /* -matcher */
+  matcher_option = gt_option_new_choice("matcher", "choose the program which "
+                                        "computes the pairwise matches between"
+                                        " the features:\n"
+                                        "last   - external LAST binaries\n"
+                                        "native - built-in multithreaded "
+                                        "local alignment of all pairs "
+                                        "sharing a k-mer",
+                                        arguments->matcher, matchers[0],
+                                        matchers);
+  gt_option_parser_add_option(op, matcher_option);
+
+  /* -simcache */
+  option = gt_option_new_string("simcache", "file in which the native matcher "
+                                "caches the pairwise similarities of the "
+                                "features, such that clustering them again "
+                                "does not recompute any alignment",
+                                arguments->simcache, NULL);
+  gt_option_parser_add_option(op, option);
+
   gt_output_file_info_register_options(arguments->ofi, op, &arguments->outfp);
 
   gt_option_parser_set_min_args(op, 1U);
@@ -95,6 +127,20 @@ static GtOptionParser* gt_ltrclustering_option_parser_new(void *tool_arguments)
   return op;
 }
 
+static int gt_ltrclustering_arguments_check(GT_UNUSED int rest_argc,
+                                            void *tool_arguments, GtError *err)
+{
+  GtLTRClusteringArguments *arguments = tool_arguments;
+  gt_error_check(err);
+  gt_assert(arguments);
+  if (gt_str_length(arguments->simcache) > 0 &&
+      strcmp(gt_str_get(arguments->matcher), "native") != 0) {
+    gt_error_set(err, "option -simcache requires option -matcher native");
+    return -1;
+  }
+  return 0;
+}
+
 static int gt_ltrclustering_runner(int argc, const char **argv,
                                        int parsed_args, void *tool_arguments,
                                        GtError *err)
@@ -138,6 +184,16 @@ static int gt_ltrclustering_runner(int argc, const char **argv,
                                                          arguments->psmall,
                                                          NULL,
                                                          err);
+    if (strcmp(gt_str_get(arguments->matcher), "native") == 0) {
+      const char *simcache = NULL;
+      if (gt_str_length(arguments->simcache) > 0)
+        simcache = gt_str_get(arguments->simcache);
+      had_err = gt_ltr_cluster_stream_use_native_matcher((GtLTRClusterStream*)
+                                                         ltr_cluster_stream,
+                                                         simcache, err);
+    }
+  }
+  if (!had_err) {
     last_stream = ltr_classify_stream = gt_ltr_classify_stream_new(last_stream,
                                                                    NULL,
                                                                    NULL,
@@ -169,6 +225,6 @@ GtTool* gt_ltrclustering(void)
   return gt_tool_new(gt_ltrclustering_arguments_new,
                   gt_ltrclustering_arguments_delete,
                   gt_ltrclustering_option_parser_new,
-                  NULL,
+                  gt_ltrclustering_arguments_check,
                   gt_ltrclustering_runner);
 }
@@ -18,6 +18,7 @@
 #include <ctype.h>
 #include <string.h>
 
+#include "core/array_api.h"
 #include "core/bioseq.h"
 #include "core/encseq.h"
 #include "core/fileutils_api.h"
@@ -28,10 +29,12 @@
 #include "core/output_file_api.h"
 #include "core/range.h"
 #include "core/safearith.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/warning_api.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gff3_out_stream_api.h"
+#include "extended/parallel_visitor_stream_api.h"
 #include "extended/region_mapping.h"
 #include "extended/seqid2file.h"
 #include "extended/visitor_stream.h"
@@ -40,6 +43,7 @@
 #include "ltr/ltrdigest_def.h"
 #include "ltr/ltrdigest_file_out_stream.h"
 #include "ltr/ltrdigest_pbs_visitor.h"
+#include "ltr/ltrdigest_pdom_stream.h"
 #include "ltr/ltrdigest_pdom_visitor.h"
 #include "ltr/ltrdigest_ppt_visitor.h"
 #include "ltr/ltrdigest_strand_assign_visitor.h"
@@ -59,7 +63,8 @@ typedef struct GtLTRdigestOptions {
   GtSeqid2FileInfo *s2fi;
   GtPdomCutoff cutoff;
   double evalue_cutoff;
-  GtUword nthreads;
+  GtUword nthreads,
+          pdom_batchsize;
   unsigned int chain_max_gap_length,
                seqnamelen;
   GtRange ppt_len, ubox_len;
@@ -340,6 +345,15 @@ static GtOptionParser* gt_ltrdigest_option_parser_new(void *tool_arguments)
   gt_option_is_extended_option(o);
   gt_option_imply(o, oh);
 
+  o = gt_option_new_uword_min("pdombatchsize",
+                              "number of candidates whose protein domains are "
+                              "searched in a single HMMER run",
+                              &arguments->pdom_batchsize,
+                              GT_LTRDIGEST_PDOM_BATCHSIZE, 1UL);
+  gt_option_parser_add_option(op, o);
+  gt_option_is_extended_option(o);
+  gt_option_imply(o, oh);
+
   o = gt_option_new_uword("threads",
                           "DEPRECATED, only included for compatibility reasons!"
                           " Use the -j parameter of the 'gt' call instead.",
@@ -438,16 +452,17 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
                *check_stream    = NULL,
                *gff3_out_stream = NULL,
                *pdom_stream     = NULL,
-               *ppt_stream      = NULL,
-               *pbs_stream      = NULL,
+               *parallel_stream = NULL,
                *tab_out_stream  = NULL,
-               *sa_stream       = NULL,
                *last_stream     = NULL;
   int had_err      = 0,
       tests_to_run = 0,
       arg = parsed_args;
   GtRegionMapping *rmap = NULL;
+  GtArray *worker_rmaps;
+  GtEncseq *encseq = NULL;
   GtPdomModelSet *ms = NULL;
+  GtUword i;
   gt_error_check(err);
   gt_assert(arguments);
 
@@ -459,7 +474,6 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
       had_err = -1;
   } else {
     GtEncseqLoader *el;
-    GtEncseq *encseq;
     /* no new-style sequence source option given, fall back to legacy syntax */
     if (argc < 3) {
       gt_error_set(err, "missing mandatory argument(s)");
@@ -478,13 +492,12 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
       gt_encseq_loader_delete(el);
       if (!encseq)
         had_err = -1;
-      else {
+      else
         rmap = gt_region_mapping_new_encseq_seqno(encseq);
-        gt_encseq_delete(encseq);
-      }
     }
   }
   gt_assert(had_err || rmap);
+  worker_rmaps = gt_array_new(sizeof (GtRegionMapping*));
 
   /* Always search for PPT. */
   tests_to_run |= GT_LTRDIGEST_RUN_PPT;
@@ -543,53 +556,74 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
         if (arguments->output_all_chains)
           gt_ltrdigest_pdom_visitor_output_all_chains((GtLTRdigestPdomVisitor*)
                                                                         pdom_v);
-        last_stream = pdom_stream = gt_visitor_stream_new(last_stream, pdom_v);
+        last_stream = pdom_stream = gt_ltrdigest_pdom_stream_new(last_stream,
+                                                     pdom_v,
+                                                     arguments->pdom_batchsize);
       }
     } else had_err = -1;
   }
 
-  if (!had_err && arguments->trna_lib_bs) {
-    GtNodeVisitor *pbs_v;
-    pbs_v = gt_ltrdigest_pbs_visitor_new(rmap, arguments->pbs_radius,
-                                         arguments->max_edist,
-                                         arguments->alilen,
-                                         arguments->offsetlen,
-                                         arguments->trnaoffsetlen,
-                                         arguments->ali_score_match,
-                                         arguments->ali_score_mismatch,
-                                         arguments->ali_score_insertion,
-                                         arguments->ali_score_deletion,
-                                         arguments->trna_lib_bs, err);
-    if (pbs_v != NULL)
-      last_stream = pbs_stream = gt_visitor_stream_new(last_stream, pbs_v);
-    else
-      had_err = -1;
-  }
-
+  /* the PBS, PPT and strand assignment visitors are applied to the candidates
+     by <gt_jobs> workers, each with its own visitors. With a preloaded
+     encoded sequence each worker gets its own region mapping, otherwise the
+     workers share the locked region mapping, such that the sequence files
+     are indexed and loaded only once */
   if (!had_err) {
-    GtNodeVisitor *ppt_v;
-    ppt_v = gt_ltrdigest_ppt_visitor_new(rmap, arguments->ppt_len,
-                                         arguments->ubox_len,
-                                         arguments->ppt_pyrimidine_prob,
-                                         arguments->ppt_purine_prob,
-                                         arguments->bkg_a_prob,
-                                         arguments->bkg_g_prob,
-                                         arguments->bkg_t_prob,
-                                         arguments->bkg_c_prob,
-                                         arguments->ubox_u_prob,
-                                         arguments->ppt_radius,
-                                         arguments->max_ubox_dist, err);
-    if (ppt_v != NULL)
-      last_stream = ppt_stream = gt_visitor_stream_new(last_stream, ppt_v);
-    else
-      had_err = -1;
+    last_stream = parallel_stream = gt_parallel_visitor_stream_new(last_stream);
+    if (encseq == NULL && gt_jobs > 1U)
+      gt_region_mapping_enable_locking(rmap);
   }
+  for (i = 0; !had_err && i < (GtUword) gt_jobs; i++) {
+    GtRegionMapping *worker_rmap = rmap;
+    GtNodeVisitor *pbs_v, *ppt_v, *sa_v;
+    if (i > 0 && encseq != NULL) {
+      worker_rmap = gt_region_mapping_new_encseq_seqno(encseq);
+      gt_array_add(worker_rmaps, worker_rmap);
+    }
 
-  if (!had_err) {
-    GtNodeVisitor *sa_v;
-    sa_v = gt_ltrdigest_strand_assign_visitor_new();
-    gt_assert(sa_v);
-    last_stream = sa_stream = gt_visitor_stream_new(last_stream, sa_v);
+    if (!had_err && arguments->trna_lib_bs) {
+      pbs_v = gt_ltrdigest_pbs_visitor_new(worker_rmap, arguments->pbs_radius,
+                                           arguments->max_edist,
+                                           arguments->alilen,
+                                           arguments->offsetlen,
+                                           arguments->trnaoffsetlen,
+                                           arguments->ali_score_match,
+                                           arguments->ali_score_mismatch,
+                                           arguments->ali_score_insertion,
+                                           arguments->ali_score_deletion,
+                                           arguments->trna_lib_bs, err);
+      if (pbs_v != NULL) {
+        gt_parallel_visitor_stream_add_visitor((GtParallelVisitorStream*)
+                                               parallel_stream, i, pbs_v);
+      } else
+        had_err = -1;
+    }
+
+    if (!had_err) {
+      ppt_v = gt_ltrdigest_ppt_visitor_new(worker_rmap, arguments->ppt_len,
+                                           arguments->ubox_len,
+                                           arguments->ppt_pyrimidine_prob,
+                                           arguments->ppt_purine_prob,
+                                           arguments->bkg_a_prob,
+                                           arguments->bkg_g_prob,
+                                           arguments->bkg_t_prob,
+                                           arguments->bkg_c_prob,
+                                           arguments->ubox_u_prob,
+                                           arguments->ppt_radius,
+                                           arguments->max_ubox_dist, err);
+      if (ppt_v != NULL) {
+        gt_parallel_visitor_stream_add_visitor((GtParallelVisitorStream*)
+                                               parallel_stream, i, ppt_v);
+      } else
+        had_err = -1;
+    }
+
+    if (!had_err) {
+      sa_v = gt_ltrdigest_strand_assign_visitor_new();
+      gt_assert(sa_v);
+      gt_parallel_visitor_stream_add_visitor((GtParallelVisitorStream*)
+                                             parallel_stream, i, sa_v);
+    }
   }
 
   if (!had_err)
@@ -647,15 +681,19 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
 
   gt_pdom_model_set_delete(ms);
   gt_node_stream_delete(gff3_out_stream);
-  gt_node_stream_delete(ppt_stream);
-  gt_node_stream_delete(pbs_stream);
-  gt_node_stream_delete(sa_stream);
+  gt_node_stream_delete(parallel_stream);
   gt_node_stream_delete(pdom_stream);
   gt_node_stream_delete(tab_out_stream);
   gt_node_stream_delete(check_stream);
   gt_node_stream_delete(gff3_in_stream);
   gt_bioseq_delete(arguments->trna_lib_bs);
+  for (i = 0; i < gt_array_size(worker_rmaps); i++) {
+    gt_region_mapping_delete(*(GtRegionMapping**)
+                             gt_array_get(worker_rmaps, i));
+  }
+  gt_array_delete(worker_rmaps);
   gt_region_mapping_delete(rmap);
+  gt_encseq_delete(encseq);
 
   return had_err;
 }
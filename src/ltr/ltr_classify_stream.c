@@ -287,6 +287,9 @@ static void add_fnmap_to_candidates(GtArray *candidates)
         fnt = gt_feature_node_get_attribute(curnode, "name");
       if (!fnt)
         continue;
+      /* the last feature of a type is kept, without leaking the key */
+      if (gt_hashmap_get(fnmap, fnt) != NULL)
+        gt_hashmap_remove(fnmap, fnt);
       gt_hashmap_add(fnmap, (void*) gt_cstr_dup(fnt), (void*) curnode);
     }
     gt_genome_node_add_user_data(gn, "fnmap", (void*) fnmap, delete_hash);
@@ -0,0 +1,362 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/chardef.h"
+#include "core/cstr_api.h"
+#include "core/ma_api.h"
+#include "core/md5_fingerprint_api.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
+#include "core/unused_api.h"
+#include "core/thread_api.h"
+#include "extended/match_open_api.h"
+#include "extended/striped_align.h"
+#include "ltr/ltr_cluster_matcher.h"
+
+/* the size of the alphabet of the aligned sequences, wildcards are mapped to
+   the last character */
+#define GT_LTR_CLUSTER_MATCHER_ALPHASIZE  5U
+
+typedef struct {
+  GtUchar *seq,      /* the encoded sequence with <WILDCARD> for non-bases */
+          *rcseq;    /* its reverse complement */
+  GtUword length,
+          *kmers,    /* the sorted codes of the canonical k-mers */
+          numofkmers;
+  char *md5;
+} GtLTRClusterMatcherSeq;
+
+typedef struct {
+  GtUword seqnum1,
+          seqnum2;
+  GtLTRClusterSim sim;
+  bool cached;
+} GtLTRClusterMatcherPair;
+
+typedef struct {
+  const GtLTRClusterMatcherSeq *seqs;
+  GtUword numofseqs,
+          nextseq;    /* the next sequence to be compared to its successors */
+  const int **scores;
+  int gap_score;
+  const GtLTRClusterSimCache *cache;
+  GtArray **pairs;    /* the pairs compared by each worker */
+  unsigned int nextworker;
+  GtMutex *mutex;
+} GtLTRClusterMatcherInfo;
+
+static int ltr_cluster_matcher_cmp_kmers(const void *a, const void *b)
+{
+  GtUword kmer_a = *(const GtUword*) a, kmer_b = *(const GtUword*) b;
+  if (kmer_a < kmer_b)
+    return -1;
+  return kmer_a > kmer_b ? 1 : 0;
+}
+
+static void ltr_cluster_matcher_seq_init(GtLTRClusterMatcherSeq *seq,
+                                         const GtEncseq *encseq,
+                                         GtUword seqnum)
+{
+  const GtUword mask = ((GtUword) 1 << (2 * GT_LTR_CLUSTER_MATCHER_KMERSIZE))
+                       - 1,
+                shift = 2 * (GT_LTR_CLUSTER_MATCHER_KMERSIZE - 1);
+  GtUword startpos, i, code, rccode, valid;
+  char *decoded;
+
+  startpos = gt_encseq_seqstartpos(encseq, seqnum);
+  seq->length = gt_encseq_seqlength(encseq, seqnum);
+  seq->seq = gt_malloc(sizeof (GtUchar) * 2 * (seq->length + 1));
+  seq->rcseq = seq->seq + seq->length + 1;
+  decoded = gt_malloc(sizeof (char) * (seq->length + 1));
+  if (seq->length > 0) {
+    gt_encseq_extract_encoded(encseq, seq->seq, startpos,
+                              startpos + seq->length - 1);
+  }
+  for (i = 0; i < seq->length; i++) {
+    if (seq->seq[i] >= (GtUchar) 4) {
+      seq->seq[i] = (GtUchar) WILDCARD;
+      seq->rcseq[seq->length - 1 - i] = (GtUchar) WILDCARD;
+      decoded[i] = 'N';
+    }
+    else {
+      seq->rcseq[seq->length - 1 - i] = (GtUchar) 3 - seq->seq[i];
+      decoded[i] = "ACGT"[seq->seq[i]];
+    }
+  }
+  decoded[seq->length] = '\0';
+  seq->md5 = gt_md5_fingerprint(decoded, seq->length);
+  gt_free(decoded);
+
+  /* the canonical code of a k-mer is the minimum of the codes of the k-mer
+     and its reverse complement, such that k-mers are shared on both strands */
+  seq->kmers = gt_malloc(sizeof (GtUword) * (seq->length + 1));
+  seq->numofkmers = 0;
+  for (i = 0, code = 0, rccode = 0, valid = 0; i < seq->length; i++) {
+    if (seq->seq[i] == (GtUchar) WILDCARD) {
+      valid = 0;
+      continue;
+    }
+    code = ((code << 2) | seq->seq[i]) & mask;
+    rccode = (rccode >> 2) | ((GtUword) (3 - seq->seq[i]) << shift);
+    if (++valid >= GT_LTR_CLUSTER_MATCHER_KMERSIZE)
+      seq->kmers[seq->numofkmers++] = MIN(code, rccode);
+  }
+  qsort(seq->kmers, (size_t) seq->numofkmers, sizeof (GtUword),
+        ltr_cluster_matcher_cmp_kmers);
+  for (i = 0, valid = 0; i < seq->numofkmers; i++) {
+    if (valid == 0 || seq->kmers[valid - 1] != seq->kmers[i])
+      seq->kmers[valid++] = seq->kmers[i];
+  }
+  seq->numofkmers = valid;
+}
+
+static bool ltr_cluster_matcher_share_kmer(const GtLTRClusterMatcherSeq *seq1,
+                                           const GtLTRClusterMatcherSeq *seq2)
+{
+  GtUword i = 0, j = 0;
+  while (i < seq1->numofkmers && j < seq2->numofkmers) {
+    if (seq1->kmers[i] < seq2->kmers[j])
+      i++;
+    else if (seq1->kmers[i] > seq2->kmers[j])
+      j++;
+    else
+      return true;
+  }
+  return false;
+}
+
+/* computes the score and the end of an optimal local alignment of <u> and
+   <v>, its start is the end of an optimal local alignment of the reversed
+   prefixes of <u> and <v> ending there (as in the SSW library) */
+static void ltr_cluster_matcher_align(GtLTRClusterSim *sim, const GtUchar *u,
+                                      GtUword ulen, const GtUchar *v,
+                                      GtUword vlen, const int **scores,
+                                      int gap_score)
+{
+  GtUword uend, vend, ustart, vstart, i;
+  GtUchar *urev, *vrev;
+  GT_UNUSED GtWord score;
+
+  sim->score = gt_striped_align_local(&uend, &vend, u, ulen,
+                                      GT_LTR_CLUSTER_MATCHER_ALPHASIZE, v,
+                                      vlen, GT_LTR_CLUSTER_MATCHER_ALPHASIZE,
+                                      scores, 0, gap_score, gap_score,
+                                      GT_STRIPED_ALIGN_KERNEL_AUTO);
+  if (sim->score <= 0) {
+    sim->score = 0;
+    sim->rng_seq1.start = sim->rng_seq1.end = 0;
+    sim->rng_seq2.start = sim->rng_seq2.end = 0;
+    return;
+  }
+  urev = gt_malloc(sizeof (GtUchar) * (uend + vend));
+  vrev = urev + uend;
+  for (i = 0; i < uend; i++)
+    urev[i] = u[uend - 1 - i];
+  for (i = 0; i < vend; i++)
+    vrev[i] = v[vend - 1 - i];
+  score = gt_striped_align_local(&ustart, &vstart, urev, uend,
+                                 GT_LTR_CLUSTER_MATCHER_ALPHASIZE, vrev, vend,
+                                 GT_LTR_CLUSTER_MATCHER_ALPHASIZE, scores, 0,
+                                 gap_score, gap_score,
+                                 GT_STRIPED_ALIGN_KERNEL_AUTO);
+  gt_assert(score == sim->score);
+  gt_free(urev);
+  sim->rng_seq1.start = uend - ustart;
+  sim->rng_seq1.end = uend - 1;
+  sim->rng_seq2.start = vend - vstart;
+  sim->rng_seq2.end = vend - 1;
+}
+
+static void ltr_cluster_matcher_compare(GtLTRClusterSim *sim,
+                                        const GtLTRClusterMatcherSeq *seq1,
+                                        const GtLTRClusterMatcherSeq *seq2,
+                                        const int **scores, int gap_score)
+{
+  GtLTRClusterSim rcsim;
+  ltr_cluster_matcher_align(sim, seq1->seq, seq1->length, seq2->seq,
+                            seq2->length, scores, gap_score);
+  sim->dir = GT_MATCH_DIRECT;
+  ltr_cluster_matcher_align(&rcsim, seq1->seq, seq1->length, seq2->rcseq,
+                            seq2->length, scores, gap_score);
+  if (rcsim.score > sim->score) {
+    sim->score = rcsim.score;
+    sim->dir = GT_MATCH_REVERSE;
+    sim->rng_seq1 = rcsim.rng_seq1;
+    /* transform the range on the reverse complement to the forward strand */
+    sim->rng_seq2.start = seq2->length - 1 - rcsim.rng_seq2.end;
+    sim->rng_seq2.end = seq2->length - 1 - rcsim.rng_seq2.start;
+  }
+}
+
+static void* ltr_cluster_matcher_thread(void *data)
+{
+  GtLTRClusterMatcherInfo *info = (GtLTRClusterMatcherInfo*) data;
+  GtLTRClusterMatcherPair pair;
+  GtArray *pairs;
+  unsigned int worker;
+  gt_assert(info);
+
+  gt_mutex_lock(info->mutex);
+  worker = info->nextworker++;
+  gt_mutex_unlock(info->mutex);
+  gt_assert(worker < gt_jobs);
+  pairs = info->pairs[worker];
+
+  while (true) {
+    const GtLTRClusterMatcherSeq *seq1, *seq2;
+    GtUword i, j;
+    gt_mutex_lock(info->mutex);
+    i = info->nextseq++;
+    gt_mutex_unlock(info->mutex);
+    if (i >= info->numofseqs)
+      break;
+    for (j = i + 1; j < info->numofseqs; j++) {
+      if (!ltr_cluster_matcher_share_kmer(info->seqs + i, info->seqs + j))
+        continue;
+      pair.seqnum1 = i;
+      pair.seqnum2 = j;
+      pair.cached = info->cache != NULL &&
+                    gt_ltr_cluster_sim_cache_get(info->cache,
+                                                 info->seqs[i].md5,
+                                                 info->seqs[j].md5,
+                                                 &pair.sim);
+      if (!pair.cached) {
+        /* compare in the order of the fingerprints, such that the result does
+           not depend on the order of the sequences */
+        bool swapped = strcmp(info->seqs[i].md5, info->seqs[j].md5) > 0;
+        seq1 = info->seqs + (swapped ? j : i);
+        seq2 = info->seqs + (swapped ? i : j);
+        ltr_cluster_matcher_compare(&pair.sim, seq1, seq2, info->scores,
+                                    info->gap_score);
+        if (swapped) {
+          GtRange tmp = pair.sim.rng_seq1;
+          pair.sim.rng_seq1 = pair.sim.rng_seq2;
+          pair.sim.rng_seq2 = tmp;
+        }
+      }
+      gt_array_add(pairs, pair);
+    }
+  }
+  return NULL;
+}
+
+static int ltr_cluster_matcher_cmp_pairs(const void *a, const void *b)
+{
+  const GtLTRClusterMatcherPair *pair_a = a, *pair_b = b;
+  if (pair_a->seqnum1 != pair_b->seqnum1)
+    return pair_a->seqnum1 < pair_b->seqnum1 ? -1 : 1;
+  if (pair_a->seqnum2 != pair_b->seqnum2)
+    return pair_a->seqnum2 < pair_b->seqnum2 ? -1 : 1;
+  return 0;
+}
+
+int gt_ltr_cluster_matcher_run(GtArray *matches, const GtEncseq *encseq,
+                               int match_score, int mismatch_cost,
+                               int gap_cost, GtLTRClusterSimCache *cache,
+                               GtError *err)
+{
+  GtLTRClusterMatcherInfo info;
+  GtLTRClusterMatcherSeq *seqs;
+  GtArray *pairs;
+  int score_rows[GT_LTR_CLUSTER_MATCHER_ALPHASIZE]
+                [GT_LTR_CLUSTER_MATCHER_ALPHASIZE];
+  const int *scores[GT_LTR_CLUSTER_MATCHER_ALPHASIZE];
+  GtUword i, j, numofseqs;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(matches && encseq && match_score > 0 && mismatch_cost >= 0 &&
+            gap_cost > 0);
+
+  /* wildcards do not match any character */
+  for (i = 0; i < GT_LTR_CLUSTER_MATCHER_ALPHASIZE; i++) {
+    for (j = 0; j < GT_LTR_CLUSTER_MATCHER_ALPHASIZE; j++) {
+      score_rows[i][j] = i == j && i < GT_LTR_CLUSTER_MATCHER_ALPHASIZE - 1
+                         ? match_score : -mismatch_cost;
+    }
+    scores[i] = score_rows[i];
+  }
+
+  numofseqs = gt_encseq_num_of_sequences(encseq);
+  seqs = gt_malloc(sizeof (*seqs) * numofseqs);
+  for (i = 0; i < numofseqs; i++)
+    ltr_cluster_matcher_seq_init(seqs + i, encseq, i);
+
+  info.seqs = seqs;
+  info.numofseqs = numofseqs;
+  info.nextseq = 0;
+  info.scores = scores;
+  info.gap_score = -gap_cost;
+  info.cache = cache;
+  info.pairs = gt_malloc(sizeof (*info.pairs) * gt_jobs);
+  for (i = 0; i < gt_jobs; i++)
+    info.pairs[i] = gt_array_new(sizeof (GtLTRClusterMatcherPair));
+  info.nextworker = 0;
+  info.mutex = gt_mutex_new();
+  had_err = gt_multithread(ltr_cluster_matcher_thread, &info, err);
+  gt_mutex_delete(info.mutex);
+
+  /* collect the pairs in a deterministic order, independent of the number of
+     threads */
+  pairs = info.pairs[0];
+  for (i = 1; i < gt_jobs; i++) {
+    gt_array_add_array(pairs, info.pairs[i]);
+    gt_array_delete(info.pairs[i]);
+  }
+  gt_free(info.pairs);
+  gt_array_sort_stable(pairs, ltr_cluster_matcher_cmp_pairs);
+
+  for (i = 0; !had_err && i < gt_array_size(pairs); i++) {
+    GtLTRClusterMatcherPair *pair = gt_array_get(pairs, i);
+    if (cache != NULL && !pair->cached) {
+      gt_ltr_cluster_sim_cache_add(cache, seqs[pair->seqnum1].md5,
+                                   seqs[pair->seqnum2].md5, &pair->sim);
+    }
+    if (pair->sim.score > 0) {
+      GtMatch *match;
+      const char *desc;
+      GtUword desclen;
+      match = gt_match_open_new(NULL, NULL, pair->sim.rng_seq1.start,
+                                pair->sim.rng_seq1.end,
+                                pair->sim.rng_seq2.start,
+                                pair->sim.rng_seq2.end, pair->sim.score,
+                                pair->sim.dir);
+      desc = gt_encseq_description(encseq, &desclen, pair->seqnum1);
+      gt_match_set_seqid1_nt(match, desc, desclen);
+      desc = gt_encseq_description(encseq, &desclen, pair->seqnum2);
+      gt_match_set_seqid2_nt(match, desc, desclen);
+      gt_array_add(matches, match);
+    }
+  }
+  gt_array_delete(pairs);
+
+  for (i = 0; i < numofseqs; i++) {
+    gt_free(seqs[i].seq);
+    gt_free(seqs[i].kmers);
+    gt_free(seqs[i].md5);
+  }
+  gt_free(seqs);
+  return had_err;
+}
+
+char* gt_ltr_cluster_matcher_params(int match_score, int mismatch_cost,
+                                    int gap_cost)
+{
+  char buf[BUFSIZ];
+  (void) snprintf(buf, BUFSIZ, "match %d, mismatch %d, gap %d", match_score,
+                  mismatch_cost, gap_cost);
+  return gt_cstr_dup(buf);
+}
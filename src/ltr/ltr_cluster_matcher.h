@@ -0,0 +1,51 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef LTR_CLUSTER_MATCHER_H
+#define LTR_CLUSTER_MATCHER_H
+
+#include "core/array_api.h"
+#include "core/encseq_api.h"
+#include "core/error_api.h"
+#include "ltr/ltr_cluster_sim_cache.h"
+
+/* default scores of the native matcher */
+#define GT_LTR_CLUSTER_MATCHER_MATCHSCORE     2
+#define GT_LTR_CLUSTER_MATCHER_MISMATCHCOST   3
+#define GT_LTR_CLUSTER_MATCHER_GAPCOST        5
+/* length of the k-mers two sequences must share to be aligned */
+#define GT_LTR_CLUSTER_MATCHER_KMERSIZE       12U
+
+/* Compares all pairs of DNA sequences in <encseq> natively, i.e., without an
+   external program: Every pair of sequences sharing at least one k-mer (on
+   either strand) is aligned locally with the given scores (a gap of length k
+   costs k * <gap_cost>), on both strands. For every pair with a positive score
+   a <GtMatch> with the descriptions of the sequences as sequence IDs is added
+   to <matches>, in the order of the sequence numbers. The pairs are compared
+   by <gt_jobs> threads. If <cache> is not NULL, results are looked up in it
+   first and computed results are added to it.
+   Returns 0 on success and -1 on error. */
+int gt_ltr_cluster_matcher_run(GtArray *matches, const GtEncseq *encseq,
+                               int match_score, int mismatch_cost,
+                               int gap_cost, GtLTRClusterSimCache *cache,
+                               GtError *err);
+/* Returns the parameter string identifying the results of the native matcher
+   with the given scores in a <GtLTRClusterSimCache>. The caller is responsible
+   for freeing it. */
+char* gt_ltr_cluster_matcher_params(int match_score, int mismatch_cost,
+                                    int gap_cost);
+
+#endif
@@ -0,0 +1,217 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/cstr_api.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/hashmap.h"
+#include "core/ma.h"
+#include "core/str.h"
+#include "core/unused_api.h"
+#include "ltr/ltr_cluster_sim_cache.h"
+
+#define GT_LTR_CLUSTER_SIM_CACHE_HEADER  "# gt ltrclustering similarity cache: "
+#define GT_LTR_CLUSTER_SIM_CACHE_MD5LEN  32
+
+struct GtLTRClusterSimCache {
+  GtHashmap *sims;   /* maps the concatenated fingerprints to the results */
+  GtStr *filename,
+        *params;
+  bool modified;
+};
+
+/* the key of a pair of sequences is the concatenation of their fingerprints
+   in lexicographic order, returns true if the sequences were swapped */
+static bool ltr_cluster_sim_cache_key(char *key, const char *md5_seq1,
+                                      const char *md5_seq2)
+{
+  bool swapped = strcmp(md5_seq1, md5_seq2) > 0;
+  gt_assert(strlen(md5_seq1) == GT_LTR_CLUSTER_SIM_CACHE_MD5LEN &&
+            strlen(md5_seq2) == GT_LTR_CLUSTER_SIM_CACHE_MD5LEN);
+  memcpy(key, swapped ? md5_seq2 : md5_seq1, GT_LTR_CLUSTER_SIM_CACHE_MD5LEN);
+  memcpy(key + GT_LTR_CLUSTER_SIM_CACHE_MD5LEN, swapped ? md5_seq1 : md5_seq2,
+         GT_LTR_CLUSTER_SIM_CACHE_MD5LEN + 1);
+  return swapped;
+}
+
+static void ltr_cluster_sim_cache_swap(GtLTRClusterSim *sim)
+{
+  GtRange tmp = sim->rng_seq1;
+  sim->rng_seq1 = sim->rng_seq2;
+  sim->rng_seq2 = tmp;
+}
+
+static int ltr_cluster_sim_cache_read(GtLTRClusterSimCache *cache, FILE *fp,
+                                      GtError *err)
+{
+  GtStr *line;
+  GtUword linenum = 1;
+  int had_err = 0;
+  gt_error_check(err);
+
+  line = gt_str_new();
+  if (gt_str_read_next_line(line, fp) == EOF ||
+      strncmp(gt_str_get(line), GT_LTR_CLUSTER_SIM_CACHE_HEADER,
+              strlen(GT_LTR_CLUSTER_SIM_CACHE_HEADER)) != 0) {
+    gt_error_set(err, "file \"%s\" is not a similarity cache file",
+                 gt_str_get(cache->filename));
+    had_err = -1;
+  }
+  /* results computed with other scores are useless, they are overwritten */
+  if (!had_err &&
+      strcmp(gt_str_get(line) + strlen(GT_LTR_CLUSTER_SIM_CACHE_HEADER),
+             gt_str_get(cache->params)) != 0) {
+    gt_str_delete(line);
+    return 0;
+  }
+  gt_str_reset(line);
+  while (!had_err && gt_str_read_next_line(line, fp) != EOF) {
+    char md5_seq1[GT_LTR_CLUSTER_SIM_CACHE_MD5LEN + 1],
+         md5_seq2[GT_LTR_CLUSTER_SIM_CACHE_MD5LEN + 1],
+         strand;
+    GtLTRClusterSim sim;
+    linenum++;
+    if (sscanf(gt_str_get(line), "%32s %32s "GT_WD" %c "GT_WU" "GT_WU" "GT_WU
+               " "GT_WU, md5_seq1, md5_seq2, &sim.score, &strand,
+               &sim.rng_seq1.start, &sim.rng_seq1.end, &sim.rng_seq2.start,
+               &sim.rng_seq2.end) != 8 ||
+        strlen(md5_seq1) != GT_LTR_CLUSTER_SIM_CACHE_MD5LEN ||
+        strlen(md5_seq2) != GT_LTR_CLUSTER_SIM_CACHE_MD5LEN ||
+        (strand != '+' && strand != '-')) {
+      gt_error_set(err, "could not parse line "GT_WU" of similarity cache "
+                   "file \"%s\"", linenum, gt_str_get(cache->filename));
+      had_err = -1;
+    }
+    if (!had_err) {
+      sim.dir = strand == '+' ? GT_MATCH_DIRECT : GT_MATCH_REVERSE;
+      gt_ltr_cluster_sim_cache_add(cache, md5_seq1, md5_seq2, &sim);
+    }
+    gt_str_reset(line);
+  }
+  gt_str_delete(line);
+  cache->modified = false;
+  return had_err;
+}
+
+GtLTRClusterSimCache* gt_ltr_cluster_sim_cache_new(const char *filename,
+                                                   const char *params,
+                                                   GtError *err)
+{
+  GtLTRClusterSimCache *cache;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(filename && params);
+
+  cache = gt_malloc(sizeof *cache);
+  cache->sims = gt_hashmap_new(GT_HASH_STRING, gt_free_func, gt_free_func);
+  cache->filename = gt_str_new_cstr(filename);
+  cache->params = gt_str_new_cstr(params);
+  cache->modified = false;
+  if (gt_file_exists(filename)) {
+    FILE *fp;
+    if (!(fp = gt_fa_fopen(filename, "r", err)))
+      had_err = -1;
+    else {
+      had_err = ltr_cluster_sim_cache_read(cache, fp, err);
+      gt_fa_xfclose(fp);
+    }
+  }
+  if (had_err) {
+    gt_ltr_cluster_sim_cache_delete(cache);
+    return NULL;
+  }
+  return cache;
+}
+
+bool gt_ltr_cluster_sim_cache_get(const GtLTRClusterSimCache *cache,
+                                  const char *md5_seq1, const char *md5_seq2,
+                                  GtLTRClusterSim *sim)
+{
+  char key[2 * GT_LTR_CLUSTER_SIM_CACHE_MD5LEN + 1];
+  GtLTRClusterSim *cached;
+  bool swapped;
+  gt_assert(cache && md5_seq1 && md5_seq2 && sim);
+  swapped = ltr_cluster_sim_cache_key(key, md5_seq1, md5_seq2);
+  if (!(cached = gt_hashmap_get(cache->sims, key)))
+    return false;
+  *sim = *cached;
+  if (swapped)
+    ltr_cluster_sim_cache_swap(sim);
+  return true;
+}
+
+void gt_ltr_cluster_sim_cache_add(GtLTRClusterSimCache *cache,
+                                  const char *md5_seq1, const char *md5_seq2,
+                                  const GtLTRClusterSim *sim)
+{
+  char key[2 * GT_LTR_CLUSTER_SIM_CACHE_MD5LEN + 1];
+  GtLTRClusterSim *cached;
+  gt_assert(cache && md5_seq1 && md5_seq2 && sim);
+  cached = gt_malloc(sizeof *cached);
+  *cached = *sim;
+  if (ltr_cluster_sim_cache_key(key, md5_seq1, md5_seq2))
+    ltr_cluster_sim_cache_swap(cached);
+  gt_hashmap_add(cache->sims, gt_cstr_dup(key), cached);
+  cache->modified = true;
+}
+
+static int ltr_cluster_sim_cache_write_sim(void *key, void *value, void *data,
+                                           GT_UNUSED GtError *err)
+{
+  const char *md5s = key;
+  const GtLTRClusterSim *sim = value;
+  FILE *fp = data;
+  gt_error_check(err);
+  fprintf(fp, "%.*s %s "GT_WD" %c "GT_WU" "GT_WU" "GT_WU" "GT_WU"\n",
+          GT_LTR_CLUSTER_SIM_CACHE_MD5LEN, md5s,
+          md5s + GT_LTR_CLUSTER_SIM_CACHE_MD5LEN, sim->score,
+          sim->dir == GT_MATCH_DIRECT ? '+' : '-', sim->rng_seq1.start,
+          sim->rng_seq1.end, sim->rng_seq2.start, sim->rng_seq2.end);
+  return 0;
+}
+
+int gt_ltr_cluster_sim_cache_write(GtLTRClusterSimCache *cache, GtError *err)
+{
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(cache);
+  if (!cache->modified)
+    return 0;
+  if (!(fp = gt_fa_fopen(gt_str_get(cache->filename), "w", err)))
+    return -1;
+  fprintf(fp, "%s%s\n", GT_LTR_CLUSTER_SIM_CACHE_HEADER,
+          gt_str_get(cache->params));
+  /* the key order makes the cache file independent of the order in which the
+     results were computed */
+  had_err = gt_hashmap_foreach_in_key_order(cache->sims,
+                                            ltr_cluster_sim_cache_write_sim,
+                                            fp, err);
+  gt_fa_xfclose(fp);
+  if (!had_err)
+    cache->modified = false;
+  return had_err;
+}
+
+void gt_ltr_cluster_sim_cache_delete(GtLTRClusterSimCache *cache)
+{
+  if (!cache) return;
+  gt_hashmap_delete(cache->sims);
+  gt_str_delete(cache->filename);
+  gt_str_delete(cache->params);
+  gt_free(cache);
+}
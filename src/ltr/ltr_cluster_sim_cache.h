@@ -0,0 +1,69 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef LTR_CLUSTER_SIM_CACHE_H
+#define LTR_CLUSTER_SIM_CACHE_H
+
+#include "core/error_api.h"
+#include "core/range_api.h"
+#include "extended/match_api.h"
+
+/* The <GtLTRClusterSimCache> stores the results of the pairwise comparisons of
+   the native LTR cluster matcher in a text file. The results are keyed by the
+   MD5 fingerprints of the compared sequences, such that clustering the same
+   features again (e.g., with other coverage thresholds) does not need to
+   recompute any alignment. */
+typedef struct GtLTRClusterSimCache GtLTRClusterSimCache;
+
+/* The result of comparing two sequences. */
+typedef struct {
+  GtWord score;          /* 0 if the sequences have no local alignment */
+  GtMatchDirection dir;
+  GtRange rng_seq1,      /* forward strand coordinates of the alignment */
+          rng_seq2;
+} GtLTRClusterSim;
+
+/* Returns a new cache for comparisons scored as described by <params>. If the
+   file <filename> exists and was written with the same <params>, the cached
+   results are read from it, otherwise the cache is empty. Returns NULL and
+   sets <err> if <filename> is not a valid cache file. */
+GtLTRClusterSimCache* gt_ltr_cluster_sim_cache_new(const char *filename,
+                                                   const char *params,
+                                                   GtError *err);
+/* Stores the cached result of comparing the sequences with the MD5
+   fingerprints <md5_seq1> and <md5_seq2> in <sim>. Returns false if the
+   result is not cached. The cache is not modified, thus concurrent lookups
+   are safe. */
+bool                  gt_ltr_cluster_sim_cache_get(
+                                            const GtLTRClusterSimCache *cache,
+                                            const char *md5_seq1,
+                                            const char *md5_seq2,
+                                            GtLTRClusterSim *sim);
+/* Adds the result <sim> of comparing the sequences with the MD5 fingerprints
+   <md5_seq1> and <md5_seq2> to <cache>. */
+void                  gt_ltr_cluster_sim_cache_add(GtLTRClusterSimCache *cache,
+                                                   const char *md5_seq1,
+                                                   const char *md5_seq2,
+                                                   const GtLTRClusterSim *sim);
+/* Writes <cache> to its file if results have been added since it was read.
+   Returns 0 on success and -1 on error. */
+int                   gt_ltr_cluster_sim_cache_write(
+                                                  GtLTRClusterSimCache *cache,
+                                                  GtError *err);
+void                  gt_ltr_cluster_sim_cache_delete(
+                                                  GtLTRClusterSimCache *cache);
+
+#endif
@@ -36,6 +36,7 @@
 #include "extended/match_iterator_api.h"
 #include "extended/match_iterator_last.h"
 #include "extended/match_iterator_open.h"
+#include "ltr/ltr_cluster_matcher.h"
 #include "ltr/ltr_cluster_stream.h"
 #include "ltr/ltr_cluster_prepare_seq_visitor.h"
 #include "match/sfx-run.h"
@@ -55,6 +56,8 @@ struct GtLTRClusterStream {
       gap_ext_cost, xdrop, ydrop, zdrop, mscoregapped,
       mscoregapless, k;
   char **current_state;
+  bool native_matcher;
+  GtLTRClusterSimCache *simcache;
 };
 
 #define gt_ltr_cluster_stream_cast(CS)\
@@ -385,6 +388,19 @@ static int cluster_annotate_nodes(GtClusteredSet *cs, GtEncseq *encseq,
   return had_err;
 }
 
+/* the native matcher uses the given scores, or its defaults if undefined */
+static void ltr_cluster_stream_native_scores(const GtLTRClusterStream *lcs,
+                                             int *match_score,
+                                             int *mismatch_cost, int *gap_cost)
+{
+  *match_score = lcs->match_score != GT_UNDEF_INT
+                 ? lcs->match_score : GT_LTR_CLUSTER_MATCHER_MATCHSCORE;
+  *mismatch_cost = lcs->mismatch_cost != GT_UNDEF_INT
+                   ? lcs->mismatch_cost : GT_LTR_CLUSTER_MATCHER_MISMATCHCOST;
+  *gap_cost = lcs->gap_ext_cost != GT_UNDEF_INT
+              ? lcs->gap_ext_cost : GT_LTR_CLUSTER_MATCHER_GAPCOST;
+}
+
 static int process_feature(GtLTRClusterStream *lcs,
                            const char *feature,
                            GtError *err)
@@ -406,7 +422,14 @@ static int process_feature(GtLTRClusterStream *lcs,
   matches = gt_array_new(sizeof(GtMatch*));
   encseq = (GtEncseq*) gt_hashmap_get(lcs->feat_to_encseq, feature);
   gt_log_log("found encseq %p for feature %s", encseq, feature);
-  if (!had_err) {
+  if (lcs->native_matcher) {
+    int match_score, mismatch_cost, gap_cost;
+    ltr_cluster_stream_native_scores(lcs, &match_score, &mismatch_cost,
+                                     &gap_cost);
+    had_err = gt_ltr_cluster_matcher_run(matches, encseq, match_score,
+                                         mismatch_cost, gap_cost,
+                                         lcs->simcache, err);
+  } else {
     mi = gt_match_iterator_last_new(encseq, encseq, lcs->match_score,
                                         lcs->mismatch_cost,
                                         lcs->gap_open_cost,
@@ -513,6 +536,8 @@ static int gt_ltr_cluster_stream_next(GtNodeStream *ns,
           break;
       }
     }
+    if (!had_err && lcs->simcache != NULL)
+      had_err = gt_ltr_cluster_sim_cache_write(lcs->simcache, err);
     if (!had_err) {
       *gn = *(GtGenomeNode**) gt_array_get(lcs->nodes, lcs->next_index);
       lcs->next_index++;
@@ -542,6 +567,7 @@ static void gt_ltr_cluster_stream_free(GtNodeStream *ns)
   for (i = 0; i < gt_array_size(lcs->nodes); i++)
     gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(lcs->nodes, i));
   gt_array_delete(lcs->nodes);
+  gt_ltr_cluster_sim_cache_delete(lcs->simcache);
   gt_node_stream_delete(lcs->in_stream);
 }
 
@@ -600,5 +626,31 @@ GtNodeStream* gt_ltr_cluster_stream_new(GtNodeStream *in_stream,
   lcs->plarge = plarge;
   lcs->psmall = psmall;
   lcs->current_state = current_state;
+  lcs->native_matcher = false;
+  lcs->simcache = NULL;
   return ns;
 }
+
+int gt_ltr_cluster_stream_use_native_matcher(GtLTRClusterStream *lcs,
+                                             const char *simcache_file,
+                                             GtError *err)
+{
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(lcs && !lcs->simcache);
+  lcs->native_matcher = true;
+  if (simcache_file != NULL) {
+    int match_score, mismatch_cost, gap_cost;
+    char *params;
+    ltr_cluster_stream_native_scores(lcs, &match_score, &mismatch_cost,
+                                     &gap_cost);
+    params = gt_ltr_cluster_matcher_params(match_score, mismatch_cost,
+                                           gap_cost);
+    if (!(lcs->simcache = gt_ltr_cluster_sim_cache_new(simcache_file, params,
+                                                       err))) {
+      had_err = -1;
+    }
+    gt_free(params);
+  }
+  return had_err;
+}
@@ -22,4 +22,14 @@
 
 const GtNodeStreamClass* gt_ltr_cluster_stream_class(void);
 
+/* Lets <lcs> compare the features with the native matcher (see
+   <gt_ltr_cluster_matcher_run()>) instead of LAST, using the match score,
+   mismatch cost and gap extension cost <lcs> was created with (or the defaults
+   of the native matcher if they are undefined). If <simcache_file> is not
+   NULL, the pairwise results are cached in this file (see
+   <GtLTRClusterSimCache>). Returns 0 on success and -1 on error. */
+int gt_ltr_cluster_stream_use_native_matcher(GtLTRClusterStream *lcs,
+                                             const char *simcache_file,
+                                             GtError *err);
+
 #endif
@@ -26,4 +26,7 @@ enum GtLTRdigestRunScans {
 
 #define GT_LTRDIGEST_TAG "LTRdigest"
 
+/* number of candidates whose protein domains are searched in one HMMER run */
+#define GT_LTRDIGEST_PDOM_BATCHSIZE 256UL
+
 #endif
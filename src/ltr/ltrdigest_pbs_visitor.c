@@ -528,6 +528,7 @@ GtNodeVisitor* gt_ltrdigest_pbs_visitor_new(GtRegionMapping *rmap,
 {
   GtNodeVisitor *nv = NULL;
   GtLTRdigestPBSVisitor *lv;
+  GtUword i;
   gt_assert(rmap && trna_lib);
   nv = gt_node_visitor_create(gt_ltrdigest_pbs_visitor_class());
   lv = gt_ltrdigest_pbs_visitor_cast(nv);
@@ -543,6 +544,10 @@ GtNodeVisitor* gt_ltrdigest_pbs_visitor_new(GtRegionMapping *rmap,
   lv->ali_score_insertion = ali_score_insertion;
   lv->ali_score_deletion = ali_score_deletion;
   lv->trna_lib = trna_lib;
+  /* the descriptions are cached on first access, fetch them now such that
+     visitors running in parallel can share the tRNA library */
+  for (i = 0; i < gt_bioseq_number_of_sequences(trna_lib); i++)
+    (void) gt_bioseq_get_description(trna_lib, i);
   return nv;
 }
 
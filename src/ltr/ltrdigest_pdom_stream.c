@@ -0,0 +1,119 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/class_alloc_lock.h"
+#include "core/queue_api.h"
+#include "extended/feature_node_api.h"
+#include "ltr/ltrdigest_pdom_stream.h"
+#include "ltr/ltrdigest_pdom_visitor.h"
+
+struct GtLTRdigestPdomStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+  GtNodeVisitor *pdom_visitor;
+  GtQueue *batch;
+  GtUword batchsize;
+  bool eof;
+};
+
+#define ltrdigest_pdom_stream_cast(NS)\
+        gt_node_stream_cast(gt_ltrdigest_pdom_stream_class(), NS)
+
+static int ltrdigest_pdom_stream_fill_batch(GtLTRdigestPdomStream *ps,
+                                            GtError *err)
+{
+  GtLTRdigestPdomVisitor *lv = (GtLTRdigestPdomVisitor*) ps->pdom_visitor;
+  GtGenomeNode *gn;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gt_queue_size(ps->batch) == 0);
+
+  while (!had_err &&
+         gt_ltrdigest_pdom_visitor_num_of_candidates(lv) < ps->batchsize) {
+    had_err = gt_node_stream_next(ps->in_stream, &gn, err);
+    if (!had_err) {
+      GtFeatureNode *fn;
+      if (!gn) {
+        ps->eof = true;
+        break;
+      }
+      gt_queue_add(ps->batch, gn);
+      if ((fn = gt_feature_node_try_cast(gn)) != NULL)
+        had_err = gt_ltrdigest_pdom_visitor_add_candidate(lv, fn, err);
+    }
+  }
+  if (!had_err)
+    had_err = gt_ltrdigest_pdom_visitor_process_candidates(lv, err);
+  return had_err;
+}
+
+static int ltrdigest_pdom_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                      GtError *err)
+{
+  GtLTRdigestPdomStream *ps;
+  int had_err = 0;
+  gt_error_check(err);
+  ps = ltrdigest_pdom_stream_cast(ns);
+
+  if (gt_queue_size(ps->batch) == 0 && !ps->eof)
+    had_err = ltrdigest_pdom_stream_fill_batch(ps, err);
+  if (!had_err && gt_queue_size(ps->batch) > 0)
+    *gn = (GtGenomeNode*) gt_queue_get(ps->batch);
+  else
+    *gn = NULL;
+  return had_err;
+}
+
+static void ltrdigest_pdom_stream_free(GtNodeStream *ns)
+{
+  GtLTRdigestPdomStream *ps = ltrdigest_pdom_stream_cast(ns);
+  while (gt_queue_size(ps->batch) > 0)
+    gt_genome_node_delete((GtGenomeNode*) gt_queue_get(ps->batch));
+  gt_queue_delete(ps->batch);
+  gt_node_visitor_delete(ps->pdom_visitor);
+  gt_node_stream_delete(ps->in_stream);
+}
+
+const GtNodeStreamClass* gt_ltrdigest_pdom_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtLTRdigestPdomStream),
+                                   ltrdigest_pdom_stream_free,
+                                   ltrdigest_pdom_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_ltrdigest_pdom_stream_new(GtNodeStream *in_stream,
+                                           GtNodeVisitor *pdom_visitor,
+                                           GtUword batchsize)
+{
+  GtLTRdigestPdomStream *ps;
+  GtNodeStream *ns;
+  gt_assert(in_stream && pdom_visitor && batchsize > 0);
+  ns = gt_node_stream_create(gt_ltrdigest_pdom_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  ps = ltrdigest_pdom_stream_cast(ns);
+  ps->in_stream = gt_node_stream_ref(in_stream);
+  ps->pdom_visitor = pdom_visitor;
+  ps->batch = gt_queue_new();
+  ps->batchsize = batchsize;
+  ps->eof = false;
+  return ns;
+}
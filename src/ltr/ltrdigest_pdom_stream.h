@@ -0,0 +1,38 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef LTRDIGEST_PDOM_STREAM_H
+#define LTRDIGEST_PDOM_STREAM_H
+
+#include "extended/node_stream_api.h"
+#include "extended/node_visitor_api.h"
+
+/* implements the ``node_stream'' interface */
+typedef struct GtLTRdigestPdomStream GtLTRdigestPdomStream;
+
+const GtNodeStreamClass* gt_ltrdigest_pdom_stream_class(void);
+
+/* Returns a stream which annotates the protein domains of the candidates from
+   <in_stream> with the <GtLTRdigestPdomVisitor> <pdom_visitor>, which is
+   taken over by the stream. Instead of running HMMER once for every
+   candidate, the nodes are read ahead until <batchsize> candidates have been
+   collected, and the domains of all of them are searched in one run. The
+   nodes are delivered in the order of <in_stream>. */
+GtNodeStream* gt_ltrdigest_pdom_stream_new(GtNodeStream *in_stream,
+                                           GtNodeVisitor *pdom_visitor,
+                                           GtUword batchsize);
+
+#endif
@@ -31,6 +31,7 @@
 #include "core/codon_iterator_simple_api.h"
 #include "core/cstr_api.h"
 #include "core/cstr_array.h"
+#include "core/fa.h"
 #include "core/grep_api.h"
 #include "core/hashmap.h"
 #include "core/log.h"
@@ -45,6 +46,7 @@
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/warning_api.h"
+#include "core/xansi_api.h"
 #include "extended/node_visitor_api.h"
 #include "extended/extract_feature_sequence.h"
 #include "extended/feature_node.h"
@@ -72,8 +74,17 @@ struct GtLTRdigestPdomVisitor {
   bool output_all_chains;
   char **args;
   const char *root_type;
+  GtArray *candidates;  /* of GtPdomCandidate, in the order of the batch */
+  GtStr *batchfilename;
+  FILE *batchfile;      /* translations of the candidates, or NULL if empty */
 };
 
+typedef struct {
+  GtFeatureNode *ltr_retrotrans;
+  GtUword leftLTR_5, rightLTR_3;
+  bool translated;      /* false if too short to be translated */
+} GtPdomCandidate;
+
 typedef struct {
   GtStrand strand;
   unsigned int frame;
@@ -248,8 +259,9 @@ static inline int pdom_parser_get_next_line(char *buf, FILE *instream,
   char *bufp = buf;
   if (fgets(buf, GT_HMMER_BUF_LEN, instream) == NULL) {
     if (feof(instream)) {
-      memset(buf, (int) '\0', (size_t) GT_HMMER_BUF_LEN);
-      return 0;
+      /* every query of the HMMER output ends with a '//' line */
+      gt_error_set(err, "unexpected end of HMMER output");
+      return -1;
     } else if (ferror(instream)) {
       gt_error_set(err, "error reading from input stream");
       return -1;
@@ -373,7 +385,7 @@ static int gt_ltrdigest_pdom_visitor_parse_alignments(GT_UNUSED
               gt_str_append_cstr(hit->alignment, buf);
               gt_str_append_char(hit->alignment, '\n');
               b = strtok(buf, " ");
-              gt_assert(strspn(b, "012+-") == (size_t) 2);
+              gt_assert(strspn(b, "0123456789_+-") == strlen(b));
               b = strtok(NULL, " ");
               gt_assert(strlen(b) > 0);
               b = strtok(NULL, " ");
@@ -456,23 +468,41 @@ static int gt_ltrdigest_pdom_visitor_parse_domainhits(GtLTRdigestPdomVisitor
 
 #ifndef _WIN32
 static int gt_ltrdigest_pdom_visitor_parse_query(GtLTRdigestPdomVisitor *lv,
-                                                 GtHMMERParseStatus *status,
+                                                 GtHMMERParseStatus **statuses,
+                                                 GtUword nof_statuses,
                                                  bool *end,
                                                  FILE *instream, GtError *err)
 {
   int had_err = 0;
-  char buf[GT_HMMER_BUF_LEN];
-  gt_assert(lv && instream && status);
+  char buf[GT_HMMER_BUF_LEN], strand;
+  int c;
+  GtUword candno;
+  unsigned int frame;
+  GtHMMERParseStatus *status = NULL;
+  gt_assert(lv && instream && statuses);
   gt_error_check(err);
 
+  /* the output may only end between two queries */
+  if ((c = fgetc(instream)) == EOF) {
+    *end = true;
+    return 0;
+  }
+  (void) ungetc(c, instream);
   had_err = pdom_parser_get_next_line(buf, instream, err);
   if (!had_err && strncmp("Query:", buf, (size_t) 6) != 0) {
     *end = true;
   }
   if (!had_err && !(*end)) {
-    status->strand = gt_strand_get(buf[14]);
-    buf[14] = '\0';
-    status->frame = (unsigned) atoi(buf+13);
+    /* queries are named <candidate number>_<frame><strand> */
+    if (sscanf(buf, "Query: "GT_WU"_%u%c", &candno, &frame, &strand) != 3
+          || candno >= nof_statuses || frame > 2U) {
+      gt_error_set(err, "unexpected query in HMMER output: '%s'", buf);
+      had_err = -1;
+    } else {
+      status = statuses[candno];
+      status->strand = gt_strand_get(strand);
+      status->frame = frame;
+    }
   }
   if (!had_err && !(*end)) {
     had_err = gt_ltrdigest_pdom_visitor_parse_scores(lv, buf, instream, err);
@@ -491,16 +521,17 @@ static int gt_ltrdigest_pdom_visitor_parse_query(GtLTRdigestPdomVisitor *lv,
 
 #ifndef _WIN32
 static int gt_ltrdigest_pdom_visitor_parse_output(GtLTRdigestPdomVisitor *lv,
-                                                  GtHMMERParseStatus *status,
+                                                  GtHMMERParseStatus **statuses,
+                                                  GtUword nof_statuses,
                                                   FILE *instream, GtError *err)
 {
   int had_err = 0;
   bool end = false;
-  gt_assert(lv && instream && status);
+  gt_assert(lv && instream && statuses);
   gt_error_check(err);
   while (!had_err && !end) {
-    had_err = gt_ltrdigest_pdom_visitor_parse_query(lv, status, &end,
-                                                    instream, err);
+    had_err = gt_ltrdigest_pdom_visitor_parse_query(lv, statuses, nof_statuses,
+                                                    &end, instream, err);
   }
   /* gt_hmmer_parse_status_show(status); */
   return had_err;
@@ -770,50 +801,47 @@ static int gt_ltrdigest_pdom_visitor_choose_strand(GtLTRdigestPdomVisitor *lv)
   return had_err;
 }
 
-static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
-                                                  GtFeatureNode *fn,
-                                                  GtError *err)
+int gt_ltrdigest_pdom_visitor_add_candidate(GtLTRdigestPdomVisitor *lv,
+                                            GtFeatureNode *fn,
+                                            GtError *err)
 {
-  GtLTRdigestPdomVisitor *lv;
   GtFeatureNodeIterator *fni;
   GtFeatureNode *curnode = NULL;
+  GtPdomCandidate cand;
   int had_err = 0;
   GtRange rng;
   GtUword i;
-  lv = gt_ltrdigest_pdom_visitor_cast(nv);
-  gt_assert(lv);
+  gt_assert(lv && fn);
   gt_error_check(err);
 
   /* traverse annotation subgraph and find LTR element */
+  cand.ltr_retrotrans = NULL;
   fni = gt_feature_node_iterator_new(fn);
   while (!had_err && (curnode = gt_feature_node_iterator_next(fni))) {
     if (strcmp(gt_feature_node_get_type(curnode), lv->root_type) == 0) {
-      lv->ltr_retrotrans = curnode;
+      cand.ltr_retrotrans = curnode;
     }
   }
   gt_feature_node_iterator_delete(fni);
 
-  if (!had_err && lv->ltr_retrotrans != NULL) {
+  if (!had_err && cand.ltr_retrotrans != NULL) {
     GtCodonIterator *ci;
     GtTranslator *tr;
     GtTranslatorStatus status;
     GtUword seqlen;
     char translated, *rev_seq;
-#ifndef _WIN32
-    FILE *instream;
-    GtHMMERParseStatus *pstatus;
-#endif
     unsigned int frame;
     GtStr *seq;
 
     seq = gt_str_new();
-    rng = gt_genome_node_get_range((GtGenomeNode*) lv->ltr_retrotrans);
-    lv->leftLTR_5 = rng.start - 1;
-    lv->rightLTR_3 = rng.end - 1;
+    rng = gt_genome_node_get_range((GtGenomeNode*) cand.ltr_retrotrans);
+    cand.leftLTR_5 = rng.start - 1;
+    cand.rightLTR_3 = rng.end - 1;
+    cand.translated = false;
     seqlen = gt_range_length(&rng);
 
     had_err = gt_extract_feature_sequence(seq,
-                                          (GtGenomeNode*) lv->ltr_retrotrans,
+                                          (GtGenomeNode*) cand.ltr_retrotrans,
                                           lv->root_type,
                                           false, NULL, NULL, lv->rmap, err);
 
@@ -853,80 +881,180 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
         gt_translator_delete(tr);
       }
 
-      /* run HMMER and handle results */
+      /* append the translations to the batch, the queries are named by the
+         number of the candidate, the frame and the strand */
       if (!had_err) {
-  #ifndef _WIN32
-        int pid, pc[2], cp[2];
-        GT_UNUSED int rval;
-
-        (void) signal(SIGCHLD, SIG_IGN); /* XXX: for now, ignore child's
-                                                 exit status */
-        rval = pipe(pc);
-        gt_assert(rval == 0);
-        rval = pipe(cp);
-        gt_assert(rval == 0);
-
-        switch ((pid = (int) fork())) {
-          case -1:
-            perror("Can't fork");
-            exit(1);   /* XXX: error handling */
-          case 0:    /* child */
-            (void) close(1);    /* close current stdout. */
-            rval = dup(cp[1]);  /* make stdout go to write end of pipe. */
-            (void) close(0);    /* close current stdin. */
-            rval = dup(pc[0]);  /* make stdin come from read end of pipe. */
-            (void) close(pc[0]);
-            (void) close(pc[1]);
-            (void) close(cp[0]);
-            (void) close(cp[1]);
-            (void) execvp("hmmscan", lv->args); /* XXX: read path from env */
-            perror("couldn't execute hmmscan!");
-            exit(1);
-          default:    /* parent */
-            for (i = 0UL; i < 3UL; i++) {
-              char buf[5];
-              GT_UNUSED ssize_t written;
-              (void) sprintf(buf, ">"GT_WU"%c\n", i, '+');
-              written = write(pc[1], buf, 4 * sizeof (char));
-              written = write(pc[1], gt_str_get(lv->fwd[i]),
-                            (size_t) gt_str_length(lv->fwd[i]) * sizeof (char));
-              written = write(pc[1], "\n", 1 * sizeof (char));
-              (void) sprintf(buf, ">"GT_WU"%c\n", i, '-');
-              written = write(pc[1], buf, 4 * sizeof (char));
-              written = write(pc[1], gt_str_get(lv->rev[i]),
-                            (size_t) gt_str_length(lv->rev[i]) * sizeof (char));
-              written = write(pc[1], "\n", 1 * sizeof (char));
-            }
-            (void) close(pc[0]);
-            (void) close(pc[1]);
-            (void) close(cp[1]);
-            instream = fdopen(cp[0], "r");
-            pstatus = gt_hmmer_parse_status_new();
-            had_err = gt_ltrdigest_pdom_visitor_parse_output(lv, pstatus,
-                                                             instream, err);
-            (void) fclose(instream);
-            if (!had_err)
-              had_err = gt_ltrdigest_pdom_visitor_process_hits(lv, pstatus,
-                                                               err);
-            gt_hmmer_parse_status_delete(pstatus);
+        GtUword candno = gt_array_size(lv->candidates);
+        if (lv->batchfile == NULL)
+          lv->batchfile = gt_xtmpfp(lv->batchfilename);
+        for (i = 0UL; i < 3UL; i++) {
+          fprintf(lv->batchfile, ">"GT_WU"_"GT_WU"%c\n", candno, i, '+');
+          gt_xfputs(gt_str_get(lv->fwd[i]), lv->batchfile);
+          gt_xfputc('\n', lv->batchfile);
+          fprintf(lv->batchfile, ">"GT_WU"_"GT_WU"%c\n", candno, i, '-');
+          gt_xfputs(gt_str_get(lv->rev[i]), lv->batchfile);
+          gt_xfputc('\n', lv->batchfile);
         }
-  #else
-        /* XXX */
-        gt_error_set(err, "HMMER call not implemented on Windows\n");
-        had_err = -1;
-  #endif
+        cand.translated = true;
       }
-    } else {
+    } else if (!had_err) {
       gt_warning("LTR_retrotransposon (%s, line %u) is too short to be "
                  "translated (" GT_WU " nt), skipped domain search",
-            gt_genome_node_get_filename((GtGenomeNode*) lv->ltr_retrotrans),
-            gt_genome_node_get_line_number((GtGenomeNode*) lv->ltr_retrotrans),
+            gt_genome_node_get_filename((GtGenomeNode*) cand.ltr_retrotrans),
+            gt_genome_node_get_line_number((GtGenomeNode*)
+                                                           cand.ltr_retrotrans),
             gt_str_length(seq));
     }
     gt_str_delete(seq);
+    if (!had_err)
+      gt_array_add(lv->candidates, cand);
   }
-  if (!had_err)
+  return had_err;
+}
+
+GtUword gt_ltrdigest_pdom_visitor_num_of_candidates(
+                                               const GtLTRdigestPdomVisitor *lv)
+{
+  gt_assert(lv);
+  return gt_array_size(lv->candidates);
+}
+
+#ifndef _WIN32
+static int gt_ltrdigest_pdom_visitor_run_hmmer(GtLTRdigestPdomVisitor *lv,
+                                               GtHMMERParseStatus **statuses,
+                                               GtUword nof_statuses,
+                                               GtError *err)
+{
+  int had_err = 0, pid, cp[2], status;
+  GT_UNUSED int rval;
+  GtUword i, nof_args;
+  FILE *instream;
+  char **args;
+  gt_assert(lv && lv->batchfile && statuses);
+  gt_error_check(err);
+
+  gt_fa_xfclose(lv->batchfile);
+  lv->batchfile = NULL;
+
+  /* the batch file replaces the last argument (stdin) of the command line */
+  nof_args = gt_cstr_array_size((const char**) lv->args);
+  gt_assert(nof_args > 0);
+  args = gt_malloc(sizeof (*args) * (nof_args + 1));
+  for (i = 0; i < nof_args - 1; i++)
+    args[i] = lv->args[i];
+  args[nof_args - 1] = gt_str_get(lv->batchfilename);
+  args[nof_args] = NULL;
+
+  rval = pipe(cp);
+  gt_assert(rval == 0);
+
+  switch ((pid = (int) fork())) {
+    case -1:
+      perror("Can't fork");
+      exit(1);   /* XXX: error handling */
+    case 0:    /* child */
+      (void) close(1);    /* close current stdout. */
+      rval = dup(cp[1]);  /* make stdout go to write end of pipe. */
+      (void) close(cp[0]);
+      (void) close(cp[1]);
+      (void) execvp("hmmscan", args); /* XXX: read path from env */
+      perror("couldn't execute hmmscan!");
+      exit(1);
+    default:    /* parent */
+      (void) close(cp[1]);
+      instream = fdopen(cp[0], "r");
+      had_err = gt_ltrdigest_pdom_visitor_parse_output(lv, statuses,
+                                                       nof_statuses,
+                                                       instream, err);
+      (void) fclose(instream);
+      /* a failing hmmscan explains a truncated output, so it is reported
+         in favour of a parse error */
+      if (waitpid((pid_t) pid, &status, 0) != (pid_t) pid) {
+        if (!had_err) {
+          gt_error_set(err, "could not wait for hmmscan");
+          had_err = -1;
+        }
+      } else if (WIFEXITED(status) && WEXITSTATUS(status) != 0) {
+        gt_error_set(err, "hmmscan failed with exit status %d",
+                     WEXITSTATUS(status));
+        had_err = -1;
+      } else if (!had_err && WIFSIGNALED(status)) {
+        gt_error_set(err, "hmmscan was terminated by signal %d",
+                     WTERMSIG(status));
+        had_err = -1;
+      }
+  }
+  gt_free(args);
+  gt_xremove(gt_str_get(lv->batchfilename));
+  return had_err;
+}
+#endif
+
+int gt_ltrdigest_pdom_visitor_process_candidates(GtLTRdigestPdomVisitor *lv,
+                                                 GtError *err)
+{
+  int had_err = 0;
+  GtUword i, nof_candidates;
+  gt_assert(lv);
+  gt_error_check(err);
+
+  nof_candidates = gt_array_size(lv->candidates);
+  if (nof_candidates == 0)
+    return 0;
+
+  /* run HMMER once for all candidates of the batch and handle results */
+  if (lv->batchfile != NULL) {
+#ifndef _WIN32
+    GtHMMERParseStatus **statuses;
+    statuses = gt_malloc(sizeof (*statuses) * nof_candidates);
+    for (i = 0; i < nof_candidates; i++)
+      statuses[i] = gt_hmmer_parse_status_new();
+    had_err = gt_ltrdigest_pdom_visitor_run_hmmer(lv, statuses,
+                                                  nof_candidates, err);
+    for (i = 0; !had_err && i < nof_candidates; i++) {
+      GtPdomCandidate *cand = gt_array_get(lv->candidates, i);
+      if (cand->translated) {
+        lv->ltr_retrotrans = cand->ltr_retrotrans;
+        lv->leftLTR_5 = cand->leftLTR_5;
+        lv->rightLTR_3 = cand->rightLTR_3;
+        had_err = gt_ltrdigest_pdom_visitor_process_hits(lv, statuses[i],
+                                                         err);
+      }
+    }
+    for (i = 0; i < nof_candidates; i++)
+      gt_hmmer_parse_status_delete(statuses[i]);
+    gt_free(statuses);
+#else
+    /* XXX */
+    gt_error_set(err, "HMMER call not implemented on Windows\n");
+    had_err = -1;
+#endif
+  }
+  for (i = 0; !had_err && i < nof_candidates; i++) {
+    lv->ltr_retrotrans =
+                ((GtPdomCandidate*) gt_array_get(lv->candidates, i))
+                                                               ->ltr_retrotrans;
     had_err = gt_ltrdigest_pdom_visitor_choose_strand(lv);
+  }
+  lv->ltr_retrotrans = NULL;
+  gt_array_reset(lv->candidates);
+  return had_err;
+}
+
+static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
+                                                  GtFeatureNode *fn,
+                                                  GtError *err)
+{
+  GtLTRdigestPdomVisitor *lv;
+  int had_err = 0;
+  lv = gt_ltrdigest_pdom_visitor_cast(nv);
+  gt_assert(lv);
+  gt_error_check(err);
+
+  /* search the domains of a single candidate */
+  had_err = gt_ltrdigest_pdom_visitor_add_candidate(lv, fn, err);
+  if (!had_err)
+    had_err = gt_ltrdigest_pdom_visitor_process_candidates(lv, err);
   return had_err;
 }
 
@@ -943,6 +1071,12 @@ void gt_ltrdigest_pdom_visitor_free(GtNodeVisitor *nv)
   gt_str_delete(lv->cmdline);
   gt_str_delete(lv->tag);
   gt_cstr_array_delete(lv->args);
+  if (lv->batchfile != NULL) {
+    gt_fa_xfclose(lv->batchfile);
+    gt_xremove(gt_str_get(lv->batchfilename));
+  }
+  gt_str_delete(lv->batchfilename);
+  gt_array_delete(lv->candidates);
 }
 
 const GtNodeVisitorClass* gt_ltrdigest_pdom_visitor_class(void)
@@ -1019,6 +1153,9 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
   lv->output_all_chains = false;
   lv->tag = gt_str_new_cstr("GenomeTools");
   lv->root_type = gt_symbol(gt_ft_LTR_retrotransposon);
+  lv->candidates = gt_array_new(sizeof (GtPdomCandidate));
+  lv->batchfilename = gt_str_new();
+  lv->batchfile = NULL;
 
   for (i = 0; i < 3; i++) {
     lv->fwd[i] = gt_str_new();
@@ -18,6 +18,7 @@
 #ifndef LTRDIGEST_PDOM_VISITOR_H
 #define LTRDIGEST_PDOM_VISITOR_H
 
+#include "extended/feature_node_api.h"
 #include "extended/node_visitor.h"
 #include "extended/region_mapping_api.h"
 #include "ltr/pdom_model_set.h"
@@ -46,4 +47,23 @@ void           gt_ltrdigest_pdom_visitor_set_root_type(
 void           gt_ltrdigest_pdom_visitor_set_source_tag(
                                                      GtLTRdigestPdomVisitor *lv,
                                                      const char *tag);
+
+/* Collects the <lv->root_type> element in <fn> (if any) as a candidate for the
+   next domain search: its six-frame translation is appended to the batch of
+   queries of <lv>. The domains are not annotated before
+   <gt_ltrdigest_pdom_visitor_process_candidates()> is called, so <fn> must be
+   kept alive until then. Returns 0 on success, -1 otherwise. */
+int            gt_ltrdigest_pdom_visitor_add_candidate(
+                                                     GtLTRdigestPdomVisitor *lv,
+                                                     GtFeatureNode *fn,
+                                                     GtError *err);
+/* Returns the number of candidates collected since the last search. */
+GtUword        gt_ltrdigest_pdom_visitor_num_of_candidates(
+                                              const GtLTRdigestPdomVisitor *lv);
+/* Searches the protein domains of all collected candidates with a single
+   HMMER run and attaches the hits to the respective candidates. Returns 0 on
+   success, -1 otherwise. */
+int            gt_ltrdigest_pdom_visitor_process_candidates(
+                                                     GtLTRdigestPdomVisitor *lv,
+                                                     GtError *err);
 #endif
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include "core/array_api.h"
 #include "core/arraydef.h"
 #include "core/assert_api.h"
@@ -905,10 +906,8 @@ static void adjustboundariesfromXdropextension(GtXdropbest xdropbest_left,
 /* The following function applies the filter algorithms one after another
    to all candidate pairs */
 static int gt_searchforLTRs(GtLTRharvestStream *lo,
+                            const RepeatInfo *repeatinfo,
                             GtArrayLTRboundaries *arrayLTRboundaries,
-                            GT_UNUSED GtMutex *rmutex,
-                            GT_UNUSED GtMutex *wmutex,
-                            GtUword *cur_seed,
                             GtError *err)
 {
   GtUword my_seed;
@@ -932,31 +931,22 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
   gt_error_check(err);
   xdropresources = gt_xdrop_resources_new(&lo->arbitscores);
 
-  /* XXX: do thread-synchronized error checking */
-  while (true) {
+  for (my_seed = 0; my_seed < repeatinfo->repeats.nextfreeRepeat; my_seed++) {
     GtUword ulen,
                   vlen,
                   seqend,
                   seqstart;
-    gt_mutex_lock(rmutex);
-    if (*cur_seed < lo->repeatinfo.repeats.nextfreeRepeat)
-      my_seed = (*cur_seed)++;
-    else {
-      gt_mutex_unlock(rmutex);
-      break;
-    }
-    gt_mutex_unlock(rmutex);
-    repeatptr = &(lo->repeatinfo.repeats.spaceRepeat[my_seed]);
+    repeatptr = &(repeatinfo->repeats.spaceRepeat[my_seed]);
 
     /* check whether max LTR length is exceeded by seed alone */
-    if (lo->repeatinfo.lmax < repeatptr->len)
+    if (repeatinfo->lmax < repeatptr->len)
       continue;
 
     seqstart = gt_encseq_seqstartpos(lo->encseq, repeatptr->contignumber);
     seqend = seqstart + gt_encseq_seqlength(lo->encseq,repeatptr->contignumber)
                - 1;
-    gt_assert(lo->repeatinfo.lmax >= repeatptr->len);
-    alilen = lo->repeatinfo.lmax - repeatptr->len;
+    gt_assert(repeatinfo->lmax >= repeatptr->len);
+    alilen = repeatinfo->lmax - repeatptr->len;
 
     /**** left (reverse) xdrop alignment
           ============================== ****/
@@ -997,7 +987,7 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
     }
 
     /* re-initialize maximal alignment length to the left */
-    alilen = lo->repeatinfo.lmax - repeatptr->len;
+    alilen = repeatinfo->lmax - repeatptr->len;
 
     /**** right (forward) xdrop alignment
           =============================== ****/
@@ -1091,7 +1081,7 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
     }
 
     /* check length and distance constraints again */
-    if (!checklengthanddistanceconstraints(&boundaries, &lo->repeatinfo))
+    if (!checklengthanddistanceconstraints(&boundaries, repeatinfo))
     {
       continue;
     }
@@ -1131,10 +1121,8 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
     if (!gt_double_smaller_double(boundaries.similarity,
                                   lo->similaritythreshold))
     {
-      gt_mutex_lock(wmutex);
       GT_GETNEXTFREEINARRAY(boundaries_ptr,arrayLTRboundaries,LTRboundaries,5);
       *boundaries_ptr = boundaries;
-      gt_mutex_unlock(wmutex);
     }
   }
 #ifdef GT_GREEDY_BUFFER
@@ -1148,25 +1136,145 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
   return haserr ? -1 : 0;
 }
 
+#define GT_LTRHARVEST_PARTSPERJOB 8U
+
 typedef struct {
   GtLTRharvestStream *lo;
-  GtArrayLTRboundaries *arrayLTRboundaries;
-  const GtEncseq *encseq;
+  GtUword *partbounds,
+          numofparts,
+          nextpart;
+  GtArrayLTRboundaries *partboundaries; /* the predictions of each part */
+  GtMutex *mutex;
+  bool haserr;
   GtError *err;
-  GtMutex *rmutex, *wmutex;
-  GtUword cur_seed;
 } GtLTRharvestThreadInfo;
 
+/* The following function enumerates the seeds of one part of the suffix
+   array and extends and filters them. The seeds of a part are only kept
+   until the part is finished and the predictions are stored separately for
+   every part. */
+static int gt_searchforLTRs_part(GtLTRharvestStream *lo,
+                                 const GtUword *partbounds,
+                                 GtUword numofparts,
+                                 GtUword part,
+                                 GtArrayLTRboundaries *arrayLTRboundaries,
+                                 GtError *err)
+{
+  RepeatInfo repeatinfo = lo->repeatinfo;
+  Sequentialsuffixarrayreader partssar, *ssar = lo->ssar;
+  int had_err = 0;
+
+  gt_error_check(err);
+  if (numofparts > 1UL) {
+    gt_Sequentialsuffixarrayreader_initpart(&partssar, lo->ssar,
+                                            partbounds[part],
+                                            partbounds[part+1]);
+    ssar = &partssar;
+  }
+  GT_INITARRAY(&repeatinfo.repeats, Repeat);
+  if (gt_enumeratemaxpairs(ssar,
+                           (unsigned int) lo->minseedlength,
+                           gt_simpleexactselfmatchstore,
+                           &repeatinfo,
+                           err) != 0)
+  {
+    had_err = -1;
+  }
+  if (!had_err)
+    had_err = gt_searchforLTRs(lo, &repeatinfo, arrayLTRboundaries, err);
+  GT_FREEARRAY(&repeatinfo.repeats, Repeat);
+  return had_err;
+}
+
 static void* gt_searchforLTRs_threadfunc(void *data) {
   GtLTRharvestThreadInfo *info = (GtLTRharvestThreadInfo*) data;
-  GT_UNUSED int rval;
+  GtError *err;
   gt_assert(info);
-  rval = gt_searchforLTRs(info->lo, info->arrayLTRboundaries, info->rmutex,
-                          info->wmutex, &info->cur_seed, info->err);
-  gt_assert(rval == 0);
+
+  err = gt_error_new();
+  while (true) {
+    GtUword part;
+    gt_mutex_lock(info->mutex);
+    if (info->haserr || info->nextpart == info->numofparts) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    part = info->nextpart++;
+    gt_mutex_unlock(info->mutex);
+    if (gt_searchforLTRs_part(info->lo, info->partbounds, info->numofparts,
+                              part, info->partboundaries + part, err) != 0) {
+      gt_mutex_lock(info->mutex);
+      if (!info->haserr) {
+        info->haserr = true;
+        gt_error_set(info->err, "%s", gt_error_get(err));
+      }
+      gt_mutex_unlock(info->mutex);
+    }
+  }
+  gt_error_delete(err);
   return NULL;
 }
 
+/* The following function splits the suffix array into parts at positions
+   with an lcp-value smaller than the minimum seed length, such that every
+   seed is enumerated in exactly one part. The parts are processed by
+   <gt_jobs> threads and their predictions are appended to
+   <arrayLTRboundaries> in the order of the parts, which is the order of a
+   sequential run. If the suffix array is scanned from file, it cannot be
+   split and is processed as a single part. */
+static int gt_searchforLTRs_parts(GtLTRharvestStream *lo,
+                                  GtArrayLTRboundaries *arrayLTRboundaries,
+                                  GtError *err)
+{
+  GtLTRharvestThreadInfo info;
+  GtUword part;
+  int had_err = 0;
+
+  gt_error_check(err);
+  info.lo = lo;
+  info.numofparts = 1UL;
+  info.partbounds = NULL;
+  if (!lo->ssar->scanfile && gt_jobs > 1U) {
+    info.numofparts = (GtUword) gt_jobs * GT_LTRHARVEST_PARTSPERJOB;
+    info.partbounds = gt_Sequentialsuffixarrayreader_lcpparts(lo->ssar,
+                                                             lo->minseedlength,
+                                                             &info.numofparts);
+  }
+  info.nextpart = 0;
+  info.partboundaries = gt_malloc(sizeof (*info.partboundaries) *
+                                  info.numofparts);
+  for (part = 0; part < info.numofparts; part++)
+    GT_INITARRAY(info.partboundaries + part, LTRboundaries);
+  info.mutex = gt_mutex_new();
+  info.haserr = false;
+  info.err = err;
+
+  if (gt_multithread(gt_searchforLTRs_threadfunc, &info, err) != 0 ||
+      info.haserr) {
+    had_err = -1;
+  }
+
+  for (part = 0; part < info.numofparts; part++) {
+    GtArrayLTRboundaries *partboundaries = info.partboundaries + part;
+    if (!had_err && partboundaries->nextfreeLTRboundaries > 0) {
+      GT_CHECKARRAYSPACEMULTI(arrayLTRboundaries, LTRboundaries,
+                              partboundaries->nextfreeLTRboundaries);
+      memcpy(arrayLTRboundaries->spaceLTRboundaries +
+             arrayLTRboundaries->nextfreeLTRboundaries,
+             partboundaries->spaceLTRboundaries,
+             sizeof (LTRboundaries) * partboundaries->nextfreeLTRboundaries);
+      arrayLTRboundaries->nextfreeLTRboundaries +=
+        partboundaries->nextfreeLTRboundaries;
+    }
+    GT_FREEARRAY(partboundaries, LTRboundaries);
+  }
+
+  gt_mutex_delete(info.mutex);
+  gt_free(info.partboundaries);
+  gt_free(info.partbounds);
+  return had_err;
+}
+
 /* The following function removes exact duplicates from the (sorted!)
    array of predicted LTR elements. Exact duplicates occur when different seeds
    are extended to same boundary coordinates. */
@@ -1251,46 +1359,22 @@ static int gt_ltrharvest_stream_next(GtNodeStream *ns,
                                      GtError *err)
 {
   GtLTRharvestStream *ltrh_stream;
-  GtLTRharvestThreadInfo threadinfo;
   int had_err = 0;
   gt_error_check(err);
 
   ltrh_stream = gt_ltrharvest_stream_cast(ns);
   if (ltrh_stream->state == GT_LTRHARVEST_STREAM_STATE_START) {
-    GT_INITARRAY(&ltrh_stream->repeatinfo.repeats, Repeat);
     ltrh_stream->prevseqnum = GT_UNDEF_UWORD;
-    if (!had_err && gt_enumeratemaxpairs(ltrh_stream->ssar,
-                      (unsigned int) ltrh_stream->minseedlength,
-                      gt_simpleexactselfmatchstore,
-                      &ltrh_stream->repeatinfo,
-                      err) != 0)
-    {
-      had_err = -1;
-    }
-
-    threadinfo.lo = ltrh_stream;
-    threadinfo.encseq = ltrh_stream->encseq;
-    threadinfo.arrayLTRboundaries = &ltrh_stream->arrayLTRboundaries;
-    threadinfo.err = err;
-    threadinfo.cur_seed = 0;
-    threadinfo.rmutex = gt_mutex_new();
-    threadinfo.wmutex = gt_mutex_new();
-    /* apply the seed extension and filter algorithms */
-    if (!had_err && gt_multithread(gt_searchforLTRs_threadfunc,
-                                   &threadinfo, err) != 0)
-    {
-      had_err = -1;
-    }
-    gt_mutex_delete(threadinfo.rmutex);
-    gt_mutex_delete(threadinfo.wmutex);
 
-    /* not needed any longer */
-    GT_FREEARRAY(&ltrh_stream->repeatinfo.repeats, Repeat);
+    /* enumerate the seeds and apply the seed extension and filter
+       algorithms */
+    had_err = gt_searchforLTRs_parts(ltrh_stream,
+                                     &ltrh_stream->arrayLTRboundaries, err);
 
     /* sort results after seed extension */
-    if (!had_err && threadinfo.arrayLTRboundaries->spaceLTRboundaries) {
-      gt_qsort_r(threadinfo.arrayLTRboundaries->spaceLTRboundaries,
-            (size_t) threadinfo.arrayLTRboundaries->nextfreeLTRboundaries,
+    if (!had_err && ltrh_stream->arrayLTRboundaries.spaceLTRboundaries) {
+      gt_qsort_r(ltrh_stream->arrayLTRboundaries.spaceLTRboundaries,
+            (size_t) ltrh_stream->arrayLTRboundaries.nextfreeLTRboundaries,
              sizeof (LTRboundaries), NULL, bdcompare);
     }
 
@@ -587,6 +587,23 @@ GtUword gt_pck_special_occ_in_nonspecial_intervals(const FMindex *index)
   return count;
 }
 
+FMindex *gt_pck_threadcopy_new(const FMindex *index)
+{
+  BWTSeq *copy = gt_malloc(sizeof (*copy));
+
+  *copy = *(const BWTSeq *) index;
+  copy->hint = newEISHint(copy->seqIdx);
+  return (FMindex *) copy;
+}
+
+void gt_pck_threadcopy_delete(FMindex *copy)
+{
+  BWTSeq *bwtseq = (BWTSeq *) copy;
+
+  deleteEISHint(bwtseq->seqIdx, bwtseq->hint);
+  gt_free(bwtseq);
+}
+
 GtUword gt_pck_exact_pattern_count(const FMindex *index,
                                          const GtUchar *pattern,
                                          GtUword patternlength) {
@@ -168,6 +168,14 @@ GtUword gt_pck_get_nonspecial_count(const FMindex *index);
  * that is the number of rows that would be extended with a special. */
 GtUword gt_pck_special_occ_in_nonspecial_intervals(const FMindex *index);
 
+/* returns a copy of <index> which shares all tables with <index> but has
+ * its own access hint, so that it can be used in a thread running in parallel
+ * to other threads accessing <index> */
+FMindex *gt_pck_threadcopy_new(const FMindex *index);
+
+/* deletes a copy obtained by gt_pck_threadcopy_new */
+void gt_pck_threadcopy_delete(FMindex *copy);
+
 /* counts the exact occurences of pattern in index returns 0 if pattern is not
  found */
 GtUword gt_pck_exact_pattern_count(const FMindex *index,
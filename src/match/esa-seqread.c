@@ -221,3 +221,76 @@ unsigned int gt_Sequentialsuffixarrayreader_prefixlength(
   gt_assert(ssar != NULL && ssar->suffixarray != NULL);
   return ssar->suffixarray->prefixlength;
 }
+
+GtUword *gt_Sequentialsuffixarrayreader_lcpparts(
+              const Sequentialsuffixarrayreader *ssar,
+              GtUword minlcp,
+              GtUword *numofparts)
+{
+  GtUword part, width, nextfreeboundary = 1UL, *boundaries;
+
+  gt_assert(ssar != NULL && !ssar->scanfile && *numofparts > 0);
+  boundaries = gt_malloc(sizeof *boundaries * (*numofparts + 1));
+  boundaries[0] = 0;
+  width = ssar->nonspecials/(*numofparts);
+  for (part = 1UL; part < *numofparts; part++)
+  {
+    GtUword idx = part * width;
+
+    if (idx <= boundaries[nextfreeboundary-1])
+    {
+      idx = boundaries[nextfreeboundary-1] + 1;
+    }
+    while (idx < ssar->nonspecials &&
+           lcptable_get(ssar->suffixarray,idx) >= minlcp)
+    {
+      idx++;
+    }
+    if (idx >= ssar->nonspecials)
+    {
+      break;
+    }
+    boundaries[nextfreeboundary++] = idx;
+  }
+  boundaries[nextfreeboundary] = ssar->nonspecials;
+  *numofparts = nextfreeboundary;
+  return boundaries;
+}
+
+static GtUword numoflargelcpvaluesbefore(const Suffixarray *suffixarray,
+                                         GtUword pos)
+{
+  GtUword left = 0, right;
+
+  gt_assert(suffixarray->numoflargelcpvalues.defined);
+  right = suffixarray->numoflargelcpvalues.valueunsignedlong;
+  while (left < right)
+  {
+    GtUword mid = left + GT_DIV2(right - left);
+
+    if (suffixarray->llvtab[mid].position < pos)
+    {
+      left = mid + 1;
+    } else
+    {
+      right = mid;
+    }
+  }
+  return left;
+}
+
+void gt_Sequentialsuffixarrayreader_initpart(
+              Sequentialsuffixarrayreader *part,
+              const Sequentialsuffixarrayreader *ssar,
+              GtUword leftbound,
+              GtUword rightbound)
+{
+  gt_assert(ssar != NULL && !ssar->scanfile && leftbound <= rightbound &&
+            rightbound <= ssar->nonspecials);
+  *part = *ssar;
+  part->nextsuftabindex = leftbound;
+  part->nextlcptabindex = leftbound + 1;
+  part->largelcpindex = numoflargelcpvaluesbefore(ssar->suffixarray,
+                                                  leftbound + 1);
+  part->nonspecials = rightbound - leftbound;
+}
@@ -247,4 +247,31 @@ GtUword gt_Sequentialsuffixarrayreader_maxbranchdepth(
 unsigned int gt_Sequentialsuffixarrayreader_prefixlength(
               const Sequentialsuffixarrayreader *ssar);
 
+/* The following function splits the range of suffixes of the
+   nonspecial suffixes of <ssar> into at most <*numofparts> consecutive parts
+   and stores their boundaries in the returned array of size
+   <*numofparts>+1: part <i> consists of the suffixes with index
+   <boundaries[i]> up to and excluding <boundaries[i+1]>. All boundaries
+   except for the first and the last are positions in the lcp-table with
+   an lcp-value smaller than <minlcp>. Thus each lcp-interval of depth at least
+   <minlcp> is completely contained in one part. <*numofparts> is set to the
+   number of parts actually delivered, which may be smaller than requested.
+   The suffixarray must be mapped, i.e. not be read from a file. */
+GtUword *gt_Sequentialsuffixarrayreader_lcpparts(
+              const Sequentialsuffixarrayreader *ssar,
+              GtUword minlcp,
+              GtUword *numofparts);
+
+/* Initialize <part> to be a reader delivering only the suffixes with index
+   <leftbound> up to and excluding <rightbound> of the mapped suffixarray
+   of <ssar>. The lcp-value of the first suffix is not delivered, while
+   the lcp-value at index <rightbound> is delivered at the end. <part> shares
+   the tables with <ssar> and must not be freed. As it maintains its own
+   reading position, different parts can be read concurrently. */
+void gt_Sequentialsuffixarrayreader_initpart(
+              Sequentialsuffixarrayreader *part,
+              const Sequentialsuffixarrayreader *ssar,
+              GtUword leftbound,
+              GtUword rightbound);
+
 #endif
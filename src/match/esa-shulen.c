@@ -18,7 +18,10 @@
 
 #include "core/unused_api.h"
 #include "core/array2dim_api.h"
+#include "core/arraydef.h"
+#include "core/divmodmul.h"
 #include "core/logger.h"
+#include "core/multithread_api.h"
 #include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/format64.h"
 #undef SHUDEBUG
@@ -59,6 +62,13 @@ struct GtBUstate_shulen /* global information */
   bool firstedgefromroot;
   GtShuUnitFileInfo *unit_info;
   void *stack;
+  /* the remaining components are used if the suffix array is processed in
+     parts: no contributions are computed for nodes of depth smaller than
+     <mindepth>. Instead the distributions and widths of the maximal subtrees
+     below these nodes are stored, in the order of the suffix array. */
+  GtUword mindepth;
+  GtArrayGtUword *unitdist,
+                 *unitwidth;
 };
 
 static void resetgnumdist_shulen(GtBUinfo_shulen *father,
@@ -193,6 +203,27 @@ static void shu_compute_leaf_edge_contrib(GtBUstate_shulen *state,
 #endif
 }
 
+static void shu_storeunit(GtBUstate_shulen *state,
+                          const GtUword *numdist,
+                          GtUword gnum,
+                          GtUword width)
+{
+  GtUword idx, *unitdist;
+
+  GT_CHECKARRAYSPACEMULTI(state->unitdist,GtUword,state->numofdbfiles);
+  unitdist = state->unitdist->spaceGtUword + state->unitdist->nextfreeGtUword;
+  for (idx = 0; idx < state->numofdbfiles; idx++)
+  {
+    unitdist[idx] = numdist == NULL ? 0 : numdist[idx];
+  }
+  if (numdist == NULL)
+  {
+    unitdist[gnum] = 1UL;
+  }
+  state->unitdist->nextfreeGtUword += state->numofdbfiles;
+  GT_STOREINARRAY(state->unitwidth,GtUword,128,width);
+}
+
 static int processleafedge_shulen(bool firstsucc,
                                   GtUword fatherdepth,
                                   GtBUinfo_shulen *father,
@@ -243,7 +274,14 @@ static int processleafedge_shulen(bool firstsucc,
 #ifdef SHUDEBUG
     shownode(__LINE__,state,"father",father);
 #endif
-    shu_compute_leaf_edge_contrib(state,father->gnumdist,gnum,fatherdepth);
+    if (fatherdepth >= state->mindepth)
+    {
+      shu_compute_leaf_edge_contrib(state,father->gnumdist,gnum,fatherdepth);
+    }
+  }
+  if (fatherdepth < state->mindepth)
+  {
+    shu_storeunit(state,NULL,gnum,1UL);
   }
   father->gnumdist[gnum]++;
 #ifdef SHUDEBUG
@@ -257,8 +295,8 @@ static int processleafedge_shulen(bool firstsucc,
 static int processbranchingedge_shulen(bool firstsucc,
                                        GtUword fatherdepth,
                                        GtBUinfo_shulen *father,
-                                       GT_UNUSED GtUword sondepth,
-                                       GT_UNUSED GtUword sonwidth,
+                                       GtUword sondepth,
+                                       GtUword sonwidth,
                                        GtBUinfo_shulen *son,
                                        GtBUstate_shulen *state,
                                        GT_UNUSED GtError *err)
@@ -278,6 +316,13 @@ static int processbranchingedge_shulen(bool firstsucc,
   }
   printf("\n");
 #endif
+  if (fatherdepth < state->mindepth && sondepth >= state->mindepth)
+  {
+    /* if <son> is undefined, its distribution is already stored in <father>,
+       which occupies the same stack element */
+    shu_storeunit(state,son != NULL ? son->gnumdist : father->gnumdist,0,
+                  sonwidth);
+  }
   if (firstsucc)
   {
     gt_assert(father != NULL);
@@ -298,8 +343,11 @@ static int processbranchingedge_shulen(bool firstsucc,
     gt_assert(son != NULL);
     shownode(__LINE__,state,"son",son);
 #endif
-    cartproduct_shulen(state, fatherdepth, father->gnumdist, son->gnumdist);
-    cartproduct_shulen(state, fatherdepth, son->gnumdist, father->gnumdist);
+    if (fatherdepth >= state->mindepth)
+    {
+      cartproduct_shulen(state, fatherdepth, father->gnumdist, son->gnumdist);
+      cartproduct_shulen(state, fatherdepth, son->gnumdist, father->gnumdist);
+    }
   }
   if (son != NULL)
   {
@@ -389,6 +437,8 @@ int gt_multiesa2shulengthdist_print(Sequentialsuffixarrayreader *ssar,
   state->nextid = 0;
 #endif
   state->shulengthdist = shulengthdist_new(state->numofdbfiles);
+  state->mindepth = 0;
+  state->unitdist = state->unitwidth = NULL;
   if (gt_esa_bottomup_shulen(ssar, state, err) != 0)
   {
     haserr = true;
@@ -528,10 +578,287 @@ int gt_esa2shulengthqueryfiles(GtUword *totalgmatchlength,
   return haserr ? -1 : 0;
 }
 
+#define SHU_PARTSPERJOB 8U
+
+typedef struct
+{
+  const GtBUstate_shulen *bustate;
+  const Sequentialsuffixarrayreader *ssar;
+  GtUword *partbounds,
+          numofparts,
+          nextpart,
+          finishedparts,
+          finishedsuffixes;
+  GtArrayGtUword *unitdist,
+                 *unitwidth;
+  GtMutex *mutex;
+  GtLogger *logger;
+  bool haserr;
+  GtError *err;
+} GtShulenPartsinfo;
+
+/* Each thread computes the contributions of all nodes of depth at least
+   <mindepth> in the parts it processes, using its own matrix. The matrices
+   are added at the end. As the boundaries of the parts have an lcp-value
+   smaller than <mindepth>, each of these nodes is contained in exactly one
+   part. */
+
+static void *shu_processparts_threadfunc(void *data)
+{
+  GtShulenPartsinfo *info = (GtShulenPartsinfo *) data;
+  GtBUstate_shulen partstate;
+  GtUword idx1, idx2;
+  GtError *err = gt_error_new();
+  bool haserr = false;
+
+  partstate = *info->bustate;
+  partstate.shulengthdist = shulengthdist_new(partstate.numofdbfiles);
+#ifdef GENOMEDIFF_PAPER_IMPL
+  partstate.leafdist
+    = gt_malloc(sizeof (*partstate.leafdist) * partstate.numofdbfiles);
+#endif
+  while (!haserr)
+  {
+    GtUword part;
+    Sequentialsuffixarrayreader partssar;
+
+    gt_mutex_lock(info->mutex);
+    if (info->haserr || info->nextpart >= info->numofparts)
+    {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    part = info->nextpart++;
+    gt_mutex_unlock(info->mutex);
+    gt_Sequentialsuffixarrayreader_initpart(&partssar,
+                                            info->ssar,
+                                            info->partbounds[part],
+                                            info->partbounds[part+1]);
+    partstate.unitdist = info->unitdist + part;
+    partstate.unitwidth = info->unitwidth + part;
+    if (gt_esa_bottomup_shulen(&partssar, &partstate, err) != 0)
+    {
+      haserr = true;
+    } else
+    {
+      if (info->partbounds[part+1] < info->ssar->nonspecials &&
+          lcptable_get(info->ssar->suffixarray,info->partbounds[part+1]) > 0)
+      {
+        /* the part ends with an lcp-value larger than 0, so the traversal
+           finishes with an additional leaf edge to the last interval on
+           the stack, which does not belong to the part */
+        gt_assert(partstate.unitwidth->nextfreeGtUword > 0 &&
+                  partstate.unitwidth->spaceGtUword
+                    [partstate.unitwidth->nextfreeGtUword-1] == 1UL);
+        partstate.unitwidth->nextfreeGtUword--;
+        partstate.unitdist->nextfreeGtUword -= partstate.numofdbfiles;
+      }
+    }
+    gt_mutex_lock(info->mutex);
+    info->finishedparts++;
+    info->finishedsuffixes += info->partbounds[part+1] - info->partbounds[part];
+    gt_logger_log(info->logger,"finished part "GT_WU" of "GT_WU", "
+                  GT_WU" of "GT_WU" suffixes processed",
+                  info->finishedparts,info->numofparts,
+                  info->finishedsuffixes,
+                  info->partbounds[info->numofparts]);
+    gt_mutex_unlock(info->mutex);
+  }
+  gt_mutex_lock(info->mutex);
+  if (haserr)
+  {
+    if (!info->haserr)
+    {
+      info->haserr = true;
+      gt_error_set(info->err,"%s",gt_error_get(err));
+    }
+  } else
+  {
+    for (idx1 = 0; idx1 < partstate.numofdbfiles; idx1++)
+    {
+      for (idx2 = 0; idx2 < partstate.numofdbfiles; idx2++)
+      {
+        info->bustate->shulengthdist[idx1][idx2]
+          += partstate.shulengthdist[idx1][idx2];
+      }
+    }
+  }
+  gt_mutex_unlock(info->mutex);
+  gt_array2dim_delete(partstate.shulengthdist);
+#ifdef GENOMEDIFF_PAPER_IMPL
+  gt_free(partstate.leafdist);
+#endif
+  gt_error_delete(err);
+  return NULL;
+}
+
+typedef struct
+{
+  GtUword lcp, *gnumdist;
+  bool haschild;
+} GtShulenUnitnode;
+
+static void shu_addunit(GtBUstate_shulen *state,
+                        GtShulenUnitnode *father,
+                        const GtUword *unitdist)
+{
+  GtUword idx;
+
+  if (father->haschild)
+  {
+    cartproduct_shulen(state, father->lcp, father->gnumdist, unitdist);
+    cartproduct_shulen(state, father->lcp, unitdist, father->gnumdist);
+  } else
+  {
+    father->haschild = true;
+  }
+  for (idx = 0; idx < state->numofdbfiles; idx++)
+  {
+    father->gnumdist[idx] += unitdist[idx];
+  }
+}
+
+/* Compute the contributions of the nodes of depth smaller than <mindepth>
+   by a bottom-up traversal in which the maximal subtrees stored for all
+   parts play the role of the leaves. */
+
+static void shu_processunits(GtBUstate_shulen *state,
+                             const Sequentialsuffixarrayreader *ssar,
+                             const GtArrayGtUword *unitdist,
+                             const GtArrayGtUword *unitwidth,
+                             GtUword numofparts)
+{
+  GtShulenUnitnode *stack;
+  GtUword part, unit, idx, top = 0, leftbound = 0, *sondist;
+
+  stack = gt_malloc(sizeof (*stack) * (state->mindepth + 1));
+  for (idx = 0; idx <= state->mindepth; idx++)
+  {
+    stack[idx].gnumdist = gt_malloc(sizeof (*stack[idx].gnumdist) *
+                                    state->numofdbfiles);
+  }
+  sondist = gt_malloc(sizeof (*sondist) * state->numofdbfiles);
+  stack[0].lcp = 0;
+  stack[0].haschild = false;
+  for (idx = 0; idx < state->numofdbfiles; idx++)
+  {
+    stack[0].gnumdist[idx] = 0;
+  }
+  for (part = 0; part < numofparts; part++)
+  {
+    for (unit = 0; unit < unitwidth[part].nextfreeGtUword; unit++)
+    {
+      const GtUword *currentdist = unitdist[part].spaceGtUword +
+                                   unit * state->numofdbfiles;
+      GtUword lcpvalue;
+
+      leftbound += unitwidth[part].spaceGtUword[unit];
+      lcpvalue = leftbound < ssar->nonspecials
+                   ? lcptable_get(ssar->suffixarray,leftbound)
+                   : 0;
+      gt_assert(lcpvalue < state->mindepth);
+      while (lcpvalue < stack[top].lcp)
+      {
+        GtUword *tmp;
+
+        shu_addunit(state,stack + top,currentdist);
+        tmp = stack[top].gnumdist;
+        stack[top].gnumdist = sondist;
+        sondist = tmp;
+        currentdist = sondist;
+        top--;
+      }
+      if (lcpvalue > stack[top].lcp)
+      {
+        top++;
+        gt_assert(top <= state->mindepth);
+        stack[top].lcp = lcpvalue;
+        stack[top].haschild = false;
+        for (idx = 0; idx < state->numofdbfiles; idx++)
+        {
+          stack[top].gnumdist[idx] = 0;
+        }
+      }
+      shu_addunit(state,stack + top,currentdist);
+    }
+  }
+  gt_assert(top == 0 && leftbound == ssar->nonspecials);
+  for (idx = 0; idx <= state->mindepth; idx++)
+  {
+    gt_free(stack[idx].gnumdist);
+  }
+  gt_free(stack);
+  gt_free(sondist);
+}
+
+static int shu_processparts(const Sequentialsuffixarrayreader *ssar,
+                            GtBUstate_shulen *bustate,
+                            GtLogger *logger,
+                            GtError *err)
+{
+  GtShulenPartsinfo info;
+  GtUword part, numofchars, numofsubtrees;
+  bool haserr = false;
+
+  gt_error_check(err);
+  /* choose the minimum depth such that there are sufficiently many subtrees
+     to split the suffix array into parts of similar size */
+  numofchars = (GtUword) gt_alphabet_num_of_chars(
+                                       gt_encseq_alphabet(bustate->encseq));
+  info.numofparts = (GtUword) gt_jobs * SHU_PARTSPERJOB;
+  for (bustate->mindepth = 1UL, numofsubtrees = numofchars;
+       numofsubtrees < GT_MULT4(info.numofparts);
+       bustate->mindepth++)
+  {
+    numofsubtrees *= numofchars;
+  }
+  info.bustate = bustate;
+  info.ssar = ssar;
+  info.partbounds = gt_Sequentialsuffixarrayreader_lcpparts(ssar,
+                                                            bustate->mindepth,
+                                                            &info.numofparts);
+  gt_logger_log(logger,"process "GT_WU" parts of the suffix array with %u "
+                       "threads, minimum depth of parts is "GT_WU,
+                       info.numofparts,gt_jobs,bustate->mindepth);
+  info.unitdist = gt_malloc(sizeof (*info.unitdist) * info.numofparts);
+  info.unitwidth = gt_malloc(sizeof (*info.unitwidth) * info.numofparts);
+  for (part = 0; part < info.numofparts; part++)
+  {
+    GT_INITARRAY(info.unitdist + part,GtUword);
+    GT_INITARRAY(info.unitwidth + part,GtUword);
+  }
+  info.nextpart = info.finishedparts = info.finishedsuffixes = 0;
+  info.mutex = gt_mutex_new();
+  info.logger = logger;
+  info.haserr = false;
+  info.err = err;
+  if (gt_multithread(shu_processparts_threadfunc,&info,err) != 0 ||
+      info.haserr)
+  {
+    haserr = true;
+  }
+  if (!haserr)
+  {
+    shu_processunits(bustate,ssar,info.unitdist,info.unitwidth,
+                     info.numofparts);
+  }
+  for (part = 0; part < info.numofparts; part++)
+  {
+    GT_FREEARRAY(info.unitdist + part,GtUword);
+    GT_FREEARRAY(info.unitwidth + part,GtUword);
+  }
+  gt_free(info.unitdist);
+  gt_free(info.unitwidth);
+  gt_mutex_delete(info.mutex);
+  gt_free(info.partbounds);
+  return haserr ? -1 : 0;
+}
+
 int gt_multiesa2shulengthdist(Sequentialsuffixarrayreader *ssar,
                               const GtEncseq *encseq,
                               uint64_t **shulen,
                               const GtShuUnitFileInfo *unit_info,
+                              GtLogger *logger,
                               GtError *err)
 {
   GtBUstate_shulen *bustate;
@@ -549,9 +876,20 @@ int gt_multiesa2shulengthdist(Sequentialsuffixarrayreader *ssar,
   bustate->nextid = 0;
 #endif
   bustate->shulengthdist = shulen;
-  if (gt_esa_bottomup_shulen(ssar, bustate, err) != 0)
+  bustate->mindepth = 0;
+  bustate->unitdist = bustate->unitwidth = NULL;
+  if (gt_jobs > 1U)
   {
-    haserr = true;
+    if (shu_processparts(ssar, bustate, logger, err) != 0)
+    {
+      haserr = true;
+    }
+  } else
+  {
+    if (gt_esa_bottomup_shulen(ssar, bustate, err) != 0)
+    {
+      haserr = true;
+    }
   }
 #ifdef GENOMEDIFF_PAPER_IMPL
   gt_free(bustate->leafdist);
@@ -590,6 +928,8 @@ GtBUstate_shulen *gt_sfx_multiesashulengthdist_new(const GtEncseq *encseq,
     bustate->shulengthdist = gd_info->shulensums;
 
   bustate->stack = (void *) gt_GtArrayGtBUItvinfo_new_shulen();
+  bustate->mindepth = 0;
+  bustate->unitdist = bustate->unitwidth = NULL;
   return bustate;
 }
 
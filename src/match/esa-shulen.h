@@ -21,6 +21,7 @@
 
 #include "core/encseq_api.h"
 #include "core/error_api.h"
+#include "core/logger_api.h"
 #include "core/str_array.h"
 #include "match/esa-seqread.h"
 #include "match/shu_unitfile.h"
@@ -41,6 +42,7 @@ int gt_multiesa2shulengthdist(Sequentialsuffixarrayreader *ssar,
                               const GtEncseq *encseq,
                               uint64_t **shulen,
                               const GtShuUnitFileInfo *unit_info,
+                              GtLogger *logger,
                               GtError *err);
 
 GtBUstate_shulen *gt_sfx_multiesashulengthdist_new(const GtEncseq *encseq,
@@ -19,11 +19,13 @@
 #include <stdio.h>
 
 #include "core/array2dim_api.h"
+#include "core/arraydef.h"
 #include "core/chardef.h"
 #include "core/divmodmul.h"
 #include "core/format64.h"
 #include "core/log_api.h"
 #include "core/logger.h"
+#include "core/multithread_api.h"
 #include "core/safearith.h"
 #include "core/stack-inlined.h"
 #include "core/unused_api.h"
@@ -149,9 +151,90 @@ static inline GtUword get_start_idx_binary_search(ShuNode *parent,
   return start_idx;
 }
 
+typedef struct
+{
+  GtUword lower,
+          upper,
+          depth;
+} ShuSubtree;
+
+GT_DECLAREARRAYSTRUCT(ShuSubtree);
+
+/* if the virtual tree is traversed by several threads, the subtrees below
+   nodes of depth <mindepth> are processed separately. The traversal of the
+   nodes above these subtrees is done twice: first to <collect> the subtrees
+   and then, after all subtrees have been processed, to add the leaf counts
+   of the subtrees (stored in <counts>) to the nodes above them and compute
+   the contributions of these nodes. */
+typedef struct
+{
+  GtUword mindepth,
+          nextsubtree,
+          **counts;
+  bool collect;
+  GtArrayShuSubtree subtrees;
+} ShuSubtreeinfo;
+
+static void reset_shu_node(ShuNode *node,
+                           GtUword numofchars,
+                           GtUword num_of_genomes)
+{
+  if (node->countTermSubtree == NULL)
+  {
+    gt_array2dim_calloc(node->countTermSubtree,
+                        numofchars+1UL,
+                        num_of_genomes);
+  }
+  else
+  {
+    GtUword y_idx, file_idx;
+    for (y_idx = 0; y_idx < numofchars+1UL; y_idx++)
+    {
+      for (file_idx = 0;
+           file_idx < num_of_genomes;
+           file_idx++)
+      {
+        node->countTermSubtree[y_idx][file_idx] = 0;
+      }
+    }
+  }
+}
+
+static void add_shu_subtree(ShuSubtreeinfo *subtreeinfo,
+                            ShuNode *parent,
+                            unsigned int offset,
+                            const Mbtab *subtreembtab,
+                            GtUword num_of_genomes)
+{
+  if (subtreeinfo->collect)
+  {
+    ShuSubtree *subtree;
+
+    GT_GETNEXTFREEINARRAY(subtree,&subtreeinfo->subtrees,ShuSubtree,64UL);
+    subtree->lower = subtreembtab->lowerbound;
+    subtree->upper = subtreembtab->upperbound;
+    subtree->depth = parent->depth + 1;
+  }
+  else
+  {
+    GtUword idx;
+    const GtUword *counts;
+
+    gt_assert(subtreeinfo->nextsubtree <
+              subtreeinfo->subtrees.nextfreeShuSubtree);
+    counts = subtreeinfo->counts[subtreeinfo->nextsubtree++];
+    for (idx = 0; idx < num_of_genomes; idx++)
+    {
+      parent->countTermSubtree[0][idx] += counts[idx];
+      parent->countTermSubtree[offset][idx] = counts[idx];
+    }
+  }
+}
+
 static int visit_shu_children(const FMindex *index,
                               ShuNode *parent,
                               GtStackShuNode *stack,
+                              ShuSubtreeinfo *subtreeinfo,
                               const GtEncseq *encseq,
                               Mbtab *tmpmbtab,
                               BwtSeqpositionextractor *pos_extractor,
@@ -208,30 +291,22 @@ static int visit_shu_children(const FMindex *index,
           parent->depth++;
           return 0;
         }
+        else if (subtreeinfo != NULL &&
+                 parent->depth + 1 >= subtreeinfo->mindepth)
+        { /* tmpmbtab[idx] is a branch processed separately */
+          add_shu_subtree(subtreeinfo,
+                          parent,
+                          offset,
+                          tmpmbtab + idx,
+                          unit_info->num_of_genomes);
+          offset++;
+        }
         else
         { /* tmpmbtab[idx] is a branch of parent node */
           ShuNode *child = NULL;
 
           GT_STACK_NEXT_FREE(stack,child);
-          if (child->countTermSubtree == NULL)
-          {
-            gt_array2dim_calloc(child->countTermSubtree,
-                                numofchars+1UL,
-                                unit_info->num_of_genomes);
-          }
-          else
-          {
-            GtUword y_idx, file_idx;
-            for (y_idx = 0; y_idx < numofchars+1UL; y_idx++)
-            {
-              for (file_idx = 0;
-                   file_idx < unit_info->num_of_genomes;
-                   file_idx++)
-              {
-                child->countTermSubtree[y_idx][file_idx] = 0;
-              }
-            }
-          }
+          reset_shu_node(child, numofchars, unit_info->num_of_genomes);
           child->process = false;
           child->lower = tmpmbtab[idx].lowerbound;
           child->upper = tmpmbtab[idx].upperbound;
@@ -393,6 +468,239 @@ static int initialise_node(void *node)
   return had_err;
 }
 
+static void push_shu_root(GtStackShuNode *stack,
+                          GtUword lower,
+                          GtUword upper,
+                          GtUword depth,
+                          GtUword numofchars,
+                          GtUword num_of_genomes)
+{
+  ShuNode *root;
+
+  GT_STACK_NEXT_FREE(stack,root);
+  reset_shu_node(root, numofchars, num_of_genomes);
+  root->process = false;
+  root->parentOffset = 0;
+  root->depth = depth;
+  root->lower = lower;
+  root->upper = upper;
+}
+
+static int traverse_shu_tree(const FMindex *index,
+                             GtStackShuNode *stack,
+                             ShuSubtreeinfo *subtreeinfo,
+                             uint64_t **shulen,
+                             Mbtab *tmpmbtab,
+                             BwtSeqpositionextractor *pos_extractor,
+                             GtUword *rangeOccs,
+                             GtUword **special_pos,
+                             GtUword numofchars,
+                             const GtShuUnitFileInfo *unit_info,
+                             GtUword total_length,
+                             GtUword max_idx,
+                             GtUword *processed_nodes,
+                             GtLogger *logger,
+                             GtError *err)
+{
+  int had_err = 0;
+
+  while (!had_err && !GT_STACK_ISEMPTY(stack))
+  {
+    ShuNode *current;
+
+    gt_assert(stack->nextfree > 0);
+    current = stack->space + stack->nextfree -1;
+    if (current->process)
+    {
+      GT_STACK_DECREMENTTOP(stack);
+      /* while the subtrees are collected, the counts are incomplete */
+      if (subtreeinfo == NULL || !subtreeinfo->collect)
+      {
+        had_err = process_shu_node(current,
+                                   stack,
+                                   shulen,
+                                   unit_info->num_of_genomes,
+                                   numofchars,
+                                   logger,
+                                   err);
+        (*processed_nodes)++;
+      }
+    }
+    else
+    {
+      had_err = visit_shu_children(index,
+                                   current,
+                                   stack,
+                                   subtreeinfo,
+                                   unit_info->encseq,
+                                   tmpmbtab,
+                                   pos_extractor,
+                                   rangeOccs,
+                                   special_pos,
+                                   numofchars,
+                                   unit_info,
+                                   total_length,
+                                   max_idx,
+                                   logger,
+                                   err);
+    }
+  }
+  return had_err;
+}
+
+static void delete_shu_stack(GtStackShuNode *stack)
+{
+  GtUword depth_idx;
+
+  for (depth_idx = 0; depth_idx < GT_STACK_MAXSIZE(stack); depth_idx++)
+  {
+    gt_array2dim_delete(stack->space[depth_idx].countTermSubtree);
+  }
+  GT_STACK_DELETE(stack);
+}
+
+#define SHU_SUBTREESPERJOB 16U
+
+typedef struct
+{
+  const FMindex *index;
+  const GtShuUnitFileInfo *unit_info;
+  ShuSubtreeinfo *subtreeinfo;
+  uint64_t **shulen;
+  GtUword **special_pos,
+          numofchars,
+          total_length,
+          max_idx,
+          nextsubtree,
+          finishedsubtrees,
+          processed_nodes;
+  GtMutex *mutex;
+  GtLogger *logger;
+  bool had_err;
+  GtError *err;
+} ShuThreadinfo;
+
+/* Each thread processes the subtrees it obtains with its own copy of the
+   index and adds the contributions of their nodes to its own matrix. The
+   matrices are added at the end. */
+
+static void *shu_subtrees_threadfunc(void *data)
+{
+  ShuThreadinfo *info = (ShuThreadinfo *) data;
+  GtStackShuNode stack;
+  FMindex *index;
+  BwtSeqpositionextractor *pos_extractor;
+  Mbtab *tmpmbtab;
+  uint64_t **shulen;
+  GtUword *rangeOccs,
+          idx_i, idx_j,
+          processed_nodes = 0,
+          num_of_genomes = info->unit_info->num_of_genomes;
+  GtError *err = gt_error_new();
+  int had_err = 0;
+
+  index = gt_pck_threadcopy_new(info->index);
+  rangeOccs = gt_calloc((size_t) GT_MULT2(info->numofchars),
+                        sizeof (*rangeOccs));
+  tmpmbtab = gt_calloc((size_t) (info->numofchars + 3), sizeof (*tmpmbtab));
+  GT_STACK_INIT_WITH_INITFUNC(&stack, 64UL, initialise_node);
+  pos_extractor = gt_newBwtSeqpositionextractor(index, info->total_length + 1);
+  gt_array2dim_calloc(shulen, num_of_genomes, num_of_genomes);
+  while (!had_err)
+  {
+    GtUword subtreenum;
+    const ShuSubtree *subtree;
+
+    gt_mutex_lock(info->mutex);
+    if (info->had_err ||
+        info->nextsubtree >= info->subtreeinfo->subtrees.nextfreeShuSubtree)
+    {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    subtreenum = info->nextsubtree++;
+    gt_mutex_unlock(info->mutex);
+    subtree = info->subtreeinfo->subtrees.spaceShuSubtree + subtreenum;
+    push_shu_root(&stack,
+                  subtree->lower,
+                  subtree->upper,
+                  subtree->depth,
+                  info->numofchars,
+                  num_of_genomes);
+    had_err = traverse_shu_tree(index,
+                                &stack,
+                                NULL,
+                                shulen,
+                                tmpmbtab,
+                                pos_extractor,
+                                rangeOccs,
+                                info->special_pos,
+                                info->numofchars,
+                                info->unit_info,
+                                info->total_length,
+                                info->max_idx,
+                                &processed_nodes,
+                                NULL,
+                                err);
+    if (!had_err)
+    {
+      /* the root of the subtree is the first element of the stack */
+      for (idx_i = 0; idx_i < num_of_genomes; idx_i++)
+      {
+        info->subtreeinfo->counts[subtreenum][idx_i]
+          = stack.space[0].countTermSubtree[0][idx_i];
+      }
+    }
+    gt_mutex_lock(info->mutex);
+    info->finishedsubtrees++;
+    gt_logger_log(info->logger, "finished subtree "GT_WU" of "GT_WU" with "
+                  GT_WU" suffixes",
+                  info->finishedsubtrees,
+                  info->subtreeinfo->subtrees.nextfreeShuSubtree,
+                  subtree->upper - subtree->lower);
+    gt_mutex_unlock(info->mutex);
+  }
+  gt_mutex_lock(info->mutex);
+  for (idx_i = 0; !had_err && idx_i < num_of_genomes; idx_i++)
+  {
+    for (idx_j = 0; !had_err && idx_j < num_of_genomes; idx_j++)
+    {
+      uint64_t old = info->shulen[idx_i][idx_j];
+
+      info->shulen[idx_i][idx_j] += shulen[idx_i][idx_j];
+      if (info->shulen[idx_i][idx_j] < old)
+      {
+        had_err = -1;
+        gt_error_set(err, "overflow in addition of shuSums! "
+                          Formatuint64_t "+ " Formatuint64_t "\n",
+                     PRINTuint64_tcast(old),
+                     PRINTuint64_tcast(shulen[idx_i][idx_j]));
+      }
+    }
+  }
+  if (had_err)
+  {
+    if (!info->had_err)
+    {
+      info->had_err = true;
+      gt_error_set(info->err, "%s", gt_error_get(err));
+    }
+  }
+  else
+  {
+    info->processed_nodes += processed_nodes;
+  }
+  gt_mutex_unlock(info->mutex);
+  gt_array2dim_delete(shulen);
+  gt_freeBwtSeqpositionextractor(pos_extractor);
+  delete_shu_stack(&stack);
+  gt_free(rangeOccs);
+  gt_free(tmpmbtab);
+  gt_pck_threadcopy_delete(index);
+  gt_error_delete(err);
+  return NULL;
+}
+
 int gt_pck_calculate_shulen(const FMindex *index,
                             const GtShuUnitFileInfo *unit_info,
                             uint64_t **shulen,
@@ -404,16 +712,14 @@ int gt_pck_calculate_shulen(const FMindex *index,
 {
   int had_err = 0;
   GtStackShuNode stack;
-  ShuNode *root;
   Mbtab *tmpmbtab;
   const GtUword resize = 64UL;
   GtUword *rangeOccs,
                 **special_char_rows_and_pos,
-                depth_idx,
                 processed_nodes,
                 max_idx = gt_pck_special_occ_in_nonspecial_intervals(index) - 1;
   BwtSeqpositionextractor *pos_extractor;
-  const GtEncseq *encseq = unit_info->encseq;
+  ShuSubtreeinfo subtreeinfo, *subtreeinfoptr = NULL;
 
   gt_assert(max_idx < total_length);
   rangeOccs = gt_calloc((size_t) GT_MULT2(numofchars), sizeof (*rangeOccs));
@@ -427,64 +733,122 @@ int gt_pck_calculate_shulen(const FMindex *index,
   special_char_rows_and_pos = get_special_pos(index,
                                               pos_extractor,
                                               max_idx + 1);
-  GT_STACK_NEXT_FREE(&stack,root);
-  gt_array2dim_calloc(root->countTermSubtree,
-                      numofchars+1UL,
-                      unit_info->num_of_genomes);
-  root->process = false;
-  root->parentOffset = 0;
-  root->depth = 0;
-  root->lower = 0;
-  root->upper = total_length + 1;
-
-  if (timer != NULL)
-  {
-    gt_timer_show_progress(timer, "traverse virtual tree", stdout);
-  }
   processed_nodes = 0;
-  while (!had_err && !GT_STACK_ISEMPTY(&stack))
+  if (gt_jobs > 1U)
   {
-    ShuNode *current;
+    ShuThreadinfo threadinfo;
+    GtUword numofsubtrees;
 
-    gt_assert(stack.nextfree > 0);
-    current = stack.space + stack.nextfree -1;
-    if (current->process)
+    if (timer != NULL)
     {
-      GT_STACK_DECREMENTTOP(&stack);
-        had_err = process_shu_node(current,
-                                   &stack,
-                                   shulen,
-                                   unit_info->num_of_genomes,
-                                   numofchars,
-                                   logger,
-                                   err);
-      processed_nodes++;
+      gt_timer_show_progress(timer, "collect subtrees", stdout);
     }
-    else
+    /* choose the minimum depth such that there are sufficiently many subtrees
+       to distribute them evenly over the threads */
+    for (subtreeinfo.mindepth = 1UL, numofsubtrees = numofchars;
+         numofsubtrees < (GtUword) gt_jobs * SHU_SUBTREESPERJOB;
+         subtreeinfo.mindepth++)
     {
-      had_err = visit_shu_children(index,
-                                   current,
-                                   &stack,
-                                   encseq,
-                                   tmpmbtab,
-                                   pos_extractor,
-                                   rangeOccs,
-                                   special_char_rows_and_pos,
-                                   numofchars,
-                                   unit_info,
-                                   total_length,
-                                   max_idx,
-                                   logger,
-                                   err);
+      numofsubtrees *= numofchars;
+    }
+    subtreeinfo.collect = true;
+    subtreeinfo.nextsubtree = 0;
+    subtreeinfo.counts = NULL;
+    GT_INITARRAY(&subtreeinfo.subtrees,ShuSubtree);
+    subtreeinfoptr = &subtreeinfo;
+    push_shu_root(&stack, 0, total_length + 1, 0, numofchars,
+                  unit_info->num_of_genomes);
+    had_err = traverse_shu_tree(index,
+                                &stack,
+                                subtreeinfoptr,
+                                shulen,
+                                tmpmbtab,
+                                pos_extractor,
+                                rangeOccs,
+                                special_char_rows_and_pos,
+                                numofchars,
+                                unit_info,
+                                total_length,
+                                max_idx,
+                                &processed_nodes,
+                                logger,
+                                err);
+    numofsubtrees = subtreeinfo.subtrees.nextfreeShuSubtree;
+    if (!had_err && numofsubtrees > 0)
+    {
+      gt_array2dim_calloc(subtreeinfo.counts, numofsubtrees,
+                          unit_info->num_of_genomes);
+      gt_logger_log(logger, "process "GT_WU" subtrees of depth at least "GT_WU
+                    " with %u threads", numofsubtrees, subtreeinfo.mindepth,
+                    gt_jobs);
+      if (timer != NULL)
+      {
+        gt_timer_show_progress_formatted(timer, stdout,
+                                         "traverse "GT_WU" subtrees with %u "
+                                         "threads", numofsubtrees, gt_jobs);
+      }
+      threadinfo.index = index;
+      threadinfo.unit_info = unit_info;
+      threadinfo.subtreeinfo = &subtreeinfo;
+      threadinfo.shulen = shulen;
+      threadinfo.special_pos = special_char_rows_and_pos;
+      threadinfo.numofchars = numofchars;
+      threadinfo.total_length = total_length;
+      threadinfo.max_idx = max_idx;
+      threadinfo.nextsubtree = threadinfo.finishedsubtrees = 0;
+      threadinfo.processed_nodes = 0;
+      threadinfo.mutex = gt_mutex_new();
+      threadinfo.logger = logger;
+      threadinfo.had_err = false;
+      threadinfo.err = err;
+      if (gt_multithread(shu_subtrees_threadfunc, &threadinfo, err) != 0 ||
+          threadinfo.had_err)
+      {
+        had_err = -1;
+      }
+      processed_nodes += threadinfo.processed_nodes;
+      gt_mutex_delete(threadinfo.mutex);
+    }
+    subtreeinfo.collect = false;
+  }
+  if (!had_err)
+  {
+    if (timer != NULL)
+    {
+      gt_timer_show_progress(timer, "traverse virtual tree", stdout);
     }
+    push_shu_root(&stack, 0, total_length + 1, 0, numofchars,
+                  unit_info->num_of_genomes);
+    had_err = traverse_shu_tree(index,
+                                &stack,
+                                subtreeinfoptr,
+                                shulen,
+                                tmpmbtab,
+                                pos_extractor,
+                                rangeOccs,
+                                special_char_rows_and_pos,
+                                numofchars,
+                                unit_info,
+                                total_length,
+                                max_idx,
+                                &processed_nodes,
+                                logger,
+                                err);
   }
   gt_logger_log(logger, "max stack depth = "GT_WU"", GT_STACK_MAXSIZE(&stack));
   gt_log_log("processed nodes= "GT_WU"", processed_nodes);
-  for (depth_idx = 0; depth_idx < GT_STACK_MAXSIZE(&stack); depth_idx++)
+  if (subtreeinfoptr != NULL)
   {
-    gt_array2dim_delete(stack.space[depth_idx].countTermSubtree);
+    gt_assert(had_err ||
+              subtreeinfo.nextsubtree ==
+                subtreeinfo.subtrees.nextfreeShuSubtree);
+    if (subtreeinfo.counts != NULL)
+    {
+      gt_array2dim_delete(subtreeinfo.counts);
+    }
+    GT_FREEARRAY(&subtreeinfo.subtrees,ShuSubtree);
   }
-  GT_STACK_DELETE(&stack);
+  delete_shu_stack(&stack);
   gt_free(rangeOccs);
   gt_free(tmpmbtab);
   gt_freeBwtSeqpositionextractor(pos_extractor);
@@ -25,6 +25,7 @@
 #include "core/ma.h"
 #include "core/mathsupport.h"
 #include "core/safearith.h"
+#include "core/thread_api.h"
 #include "match/eis-voiditf.h"
 #include "match/esa-seqread.h"
 #include "match/esa-shulen.h"
@@ -252,7 +253,7 @@ uint64_t **gt_genomediff_shulen_sum(const GtGenomediffArguments *arguments,
                                     gt_str_array_get(arguments->filenames, 0),
                                     SARR_LCPTAB | SARR_SUFTAB | SARR_ESQTAB |
                                       SARR_SSPTAB,
-                                    arguments->scanfile,
+                                    arguments->scanfile && gt_jobs == 1U,
                                     logger, err);
     if (ssar == NULL)
       had_err = -1;
@@ -289,10 +290,12 @@ uint64_t **gt_genomediff_shulen_sum(const GtGenomediffArguments *arguments,
 
     if (arguments->with_esa) {
       if (timer != NULL)
-        gt_timer_show_progress(timer, "dfs esa index", stdout);
+        gt_timer_show_progress_formatted(timer, stdout,
+                                         "dfs esa index with %u threads",
+                                         gt_jobs);
 
       had_err = gt_multiesa2shulengthdist(ssar, encseq, shulensums,
-                                          unit_info, err);
+                                          unit_info, logger, err);
     }
     else {
       const FMindex *subjectindex = NULL;
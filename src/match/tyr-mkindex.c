@@ -21,6 +21,7 @@
 #include "core/fa.h"
 #include "core/format64.h"
 #include "core/logger.h"
+#include "core/multithread_api.h"
 #include "core/spacecalc.h"
 #include "core/str.h"
 #include "core/unused_api.h"
@@ -80,6 +81,8 @@ typedef struct /* global information */
   GtUword countoutputmers;
   const ESASuffixptr *suftab; /* only necessary for performtest */
   GtUchar *currentmer;    /* only necessary for performtest */
+  GtArrayGtUchar merbuffer,   /* only used when processing a part */
+                 countbuffer;
 } TyrDfsstate;
 
 #include "esa-dfs.h"
@@ -408,6 +411,49 @@ static int outputsortedstring2index(GtUword countocc,
   return 0;
 }
 
+/* The following function is used instead of the previous function when
+   one of several parts of the suffix array is processed: the mers and their
+   counts are stored in buffers which are later written in the order of the
+   parts. The idx-component of the large counts refers to the part. */
+
+static int outputsortedstring2buffer(GtUword countocc,
+                                     GtUword position,
+                                     void *adddistposinfo,
+                                     GT_UNUSED GtError *err)
+{
+  TyrDfsstate *state = (TyrDfsstate *) adddistposinfo;
+
+  if (decideifocc(state,countocc))
+  {
+    GT_CHECKARRAYSPACEMULTI(&state->merbuffer,GtUchar,
+                            state->sizeofbuffer * 1024UL);
+    gt_encseq_sequence2bytecode(state->merbuffer.spaceGtUchar +
+                                state->merbuffer.nextfreeGtUchar,
+                                state->encseq,position,state->mersize);
+    state->merbuffer.nextfreeGtUchar += state->sizeofbuffer;
+    if (state->storecounts)
+    {
+      GtUchar smallcount;
+
+      if (countocc <= MAXSMALLMERCOUNT)
+      {
+        smallcount = (GtUchar) countocc;
+      } else
+      {
+        Largecount *lc;
+
+        GT_GETNEXTFREEINARRAY(lc,&state->largecounts,Largecount,32);
+        lc->idx = state->countoutputmers;
+        lc->value = countocc;
+        smallcount = 0;
+      }
+      GT_STOREINARRAY(&state->countbuffer,GtUchar,1024,smallcount);
+    }
+    state->countoutputmers++;
+  }
+  return 0;
+}
+
 static Dfsinfo* tyr_allocateDfsinfo(GT_UNUSED Dfsstate *state)
 {
   TyrDfsinfo *dfsinfo;
@@ -511,6 +557,257 @@ static void outputbytewiseUlongvalue(FILE *fpout,GtUword value)
   }
 }
 
+#define TYR_PARTSPERJOB 8
+
+typedef struct
+{
+  TyrDfsstate *state; /* collects the results of all parts */
+  const Sequentialsuffixarrayreader *ssar;
+  GtUword *partbounds,
+          numofparts,
+          nextpart,
+          nextparttoflush;
+  TyrDfsstate **finishedparts;
+  GtMutex *rmutex,
+          *wmutex;
+  bool haserr;
+  GtError *err;
+} TyrPartsinfo;
+
+static TyrDfsstate *tyr_partstate_new(const TyrDfsstate *state)
+{
+  TyrDfsstate *partstate;
+
+  partstate = gt_malloc(sizeof (*partstate));
+  *partstate = *state;
+  GT_INITARRAY(&partstate->occdistribution,Countwithpositions);
+  GT_INITARRAY(&partstate->largecounts,Largecount);
+  GT_INITARRAY(&partstate->merbuffer,GtUchar);
+  GT_INITARRAY(&partstate->countbuffer,GtUchar);
+  partstate->countoutputmers = 0;
+  partstate->merindexfpout = NULL;
+  partstate->countsfilefpout = NULL;
+  partstate->bytebuffer = NULL;
+  partstate->esrspace = gt_encseq_create_reader_with_readmode(state->encseq,
+                                                              state->readmode,
+                                                              0);
+  if (state->performtest)
+  {
+    partstate->currentmer = gt_malloc(sizeof *partstate->currentmer
+                                      * partstate->mersize);
+  } else
+  {
+    partstate->currentmer = NULL;
+  }
+  if (state->processoccurrencecount == outputsortedstring2index)
+  {
+    partstate->processoccurrencecount = outputsortedstring2buffer;
+  }
+  return partstate;
+}
+
+static void tyr_partstate_delete(TyrDfsstate *partstate)
+{
+  GtUword idx;
+
+  for (idx = 0;
+       idx < partstate->occdistribution.nextfreeCountwithpositions; idx++)
+  {
+    wrapListUlong(partstate->occdistribution.spaceCountwithpositions[idx].
+                                             positionlist);
+  }
+  GT_FREEARRAY(&partstate->occdistribution,Countwithpositions);
+  GT_FREEARRAY(&partstate->largecounts,Largecount);
+  GT_FREEARRAY(&partstate->merbuffer,GtUchar);
+  GT_FREEARRAY(&partstate->countbuffer,GtUchar);
+  gt_encseq_reader_delete(partstate->esrspace);
+  gt_free(partstate->currentmer);
+  gt_free(partstate);
+}
+
+/* add the results of a part to <state>. The parts must be added in the order
+   of the suffix array, so that the mers are output in sorted order and the
+   position lists are the same as in the sequential computation. */
+
+static void tyr_partstate_flush(TyrDfsstate *state,TyrDfsstate *partstate)
+{
+  GtUword idx;
+
+  if (state->merindexfpout != NULL)
+  {
+    if (partstate->merbuffer.nextfreeGtUchar > 0)
+    {
+      gt_xfwrite(partstate->merbuffer.spaceGtUchar,sizeof (GtUchar),
+                 (size_t) partstate->merbuffer.nextfreeGtUchar,
+                 state->merindexfpout);
+    }
+    if (state->countsfilefpout != NULL &&
+        partstate->countbuffer.nextfreeGtUchar > 0)
+    {
+      gt_xfwrite(partstate->countbuffer.spaceGtUchar,sizeof (GtUchar),
+                 (size_t) partstate->countbuffer.nextfreeGtUchar,
+                 state->countsfilefpout);
+    }
+    for (idx = 0; idx < partstate->largecounts.nextfreeLargecount; idx++)
+    {
+      Largecount *lc;
+
+      GT_GETNEXTFREEINARRAY(lc,&state->largecounts,Largecount,32);
+      lc->idx = state->countoutputmers +
+                partstate->largecounts.spaceLargecount[idx].idx;
+      lc->value = partstate->largecounts.spaceLargecount[idx].value;
+    }
+    state->countoutputmers += partstate->countoutputmers;
+  } else
+  {
+    for (idx = 0;
+         idx < partstate->occdistribution.nextfreeCountwithpositions; idx++)
+    {
+      Countwithpositions *partcount
+        = partstate->occdistribution.spaceCountwithpositions + idx;
+
+      if (partcount->occcount > 0)
+      {
+        incrementdistribcounts(&state->occdistribution,idx,
+                               partcount->occcount);
+        if (partcount->positionlist != NULL)
+        {
+          ListUlong *tail;
+
+          for (tail = partcount->positionlist; tail->nextptr != NULL;
+               tail = tail->nextptr)
+            /* Nothing */ ;
+          tail->nextptr = state->occdistribution.spaceCountwithpositions[idx].
+                                                 positionlist;
+          state->occdistribution.spaceCountwithpositions[idx].positionlist
+            = partcount->positionlist;
+          partcount->positionlist = NULL;
+        }
+      }
+    }
+  }
+}
+
+static void *tyr_processparts_threadfunc(void *data)
+{
+  TyrPartsinfo *info = (TyrPartsinfo *) data;
+  GtError *err = gt_error_new();
+
+  while (true)
+  {
+    GtUword part;
+    TyrDfsstate *partstate;
+    Sequentialsuffixarrayreader partssar;
+    bool parthaserr = false;
+
+    gt_mutex_lock(info->rmutex);
+    if (info->haserr || info->nextpart >= info->numofparts)
+    {
+      gt_mutex_unlock(info->rmutex);
+      break;
+    }
+    part = info->nextpart++;
+    gt_mutex_unlock(info->rmutex);
+    partstate = tyr_partstate_new(info->state);
+    gt_Sequentialsuffixarrayreader_initpart(&partssar,
+                                            info->ssar,
+                                            info->partbounds[part],
+                                            info->partbounds[part+1]);
+    if (gt_depthfirstesa(&partssar,
+                        tyr_allocateDfsinfo,
+                        tyr_freeDfsinfo,
+                        tyr_processleafedge,
+                        NULL,
+                        tyr_processcompletenode,
+                        tyr_assignleftmostleaf,
+                        tyr_assignrightmostleaf,
+                        (Dfsstate*) partstate,
+                        NULL,
+                        err) != 0)
+    {
+      parthaserr = true;
+    }
+    gt_mutex_lock(info->wmutex);
+    if (parthaserr)
+    {
+      tyr_partstate_delete(partstate);
+      gt_mutex_lock(info->rmutex);
+      if (!info->haserr)
+      {
+        info->haserr = true;
+        gt_error_set(info->err,"%s",gt_error_get(err));
+      }
+      gt_mutex_unlock(info->rmutex);
+    } else
+    {
+      info->finishedparts[part] = partstate;
+      while (info->nextparttoflush < info->numofparts &&
+             info->finishedparts[info->nextparttoflush] != NULL)
+      {
+        tyr_partstate_flush(info->state,
+                            info->finishedparts[info->nextparttoflush]);
+        tyr_partstate_delete(info->finishedparts[info->nextparttoflush]);
+        info->finishedparts[info->nextparttoflush++] = NULL;
+      }
+    }
+    gt_mutex_unlock(info->wmutex);
+  }
+  gt_error_delete(err);
+  return NULL;
+}
+
+/* The following function splits the suffix array into parts at positions
+   with an lcp-value smaller than the mersize. So each mer only occurs in one
+   part and the parts can be processed independently by <gt_jobs> threads.
+   The results of the parts are added to <state> in the order of the parts,
+   as soon as all previous parts are finished. */
+
+static int tyr_processparts(const Sequentialsuffixarrayreader *ssar,
+                            TyrDfsstate *state,
+                            GtLogger *logger,
+                            GtError *err)
+{
+  TyrPartsinfo info;
+  GtUword part;
+  bool haserr = false;
+
+  gt_error_check(err);
+  info.state = state;
+  info.ssar = ssar;
+  info.numofparts = (GtUword) gt_jobs * TYR_PARTSPERJOB;
+  info.partbounds = gt_Sequentialsuffixarrayreader_lcpparts(ssar,
+                                                            state->mersize,
+                                                            &info.numofparts);
+  gt_logger_log(logger,"process "GT_WU" parts of the suffix array with %u "
+                       "threads",info.numofparts,gt_jobs);
+  info.nextpart = 0;
+  info.nextparttoflush = 0;
+  info.finishedparts = gt_calloc((size_t) info.numofparts,
+                                 sizeof (*info.finishedparts));
+  info.rmutex = gt_mutex_new();
+  info.wmutex = gt_mutex_new();
+  info.haserr = false;
+  info.err = err;
+  if (gt_multithread(tyr_processparts_threadfunc,&info,err) != 0 ||
+      info.haserr)
+  {
+    haserr = true;
+  }
+  gt_assert(haserr || info.nextparttoflush == info.numofparts);
+  for (part = 0; part < info.numofparts; part++)
+  {
+    if (info.finishedparts[part] != NULL)
+    {
+      tyr_partstate_delete(info.finishedparts[part]);
+    }
+  }
+  gt_mutex_delete(info.rmutex);
+  gt_mutex_delete(info.wmutex);
+  gt_free(info.finishedparts);
+  gt_free(info.partbounds);
+  return haserr ? -1 : 0;
+}
+
 static int enumeratelcpintervals(const char *inputindex,
                                  Sequentialsuffixarrayreader *ssar,
                                  const char *storeindex,
@@ -546,6 +843,8 @@ static int enumeratelcpintervals(const char *inputindex,
   state->merindexfpout = NULL;
   state->countsfilefpout = NULL;
   GT_INITARRAY(&state->largecounts,Largecount);
+  GT_INITARRAY(&state->merbuffer,GtUchar);
+  GT_INITARRAY(&state->countbuffer,GtUchar);
   if (strlen(storeindex) == 0)
   {
     state->sizeofbuffer = 0;
@@ -600,21 +899,30 @@ static int enumeratelcpintervals(const char *inputindex,
     }
     if (!haserr)
     {
-      if (gt_depthfirstesa(ssar,
-                          tyr_allocateDfsinfo,
-                          tyr_freeDfsinfo,
-                          tyr_processleafedge,
-                          NULL,
-                          tyr_processcompletenode,
-                          tyr_assignleftmostleaf,
-                          tyr_assignrightmostleaf,
-                          (Dfsstate*) state,
-                          logger,
-                          err) != 0)
+      if (gt_jobs > 1U)
       {
-        haserr = true;
+        if (tyr_processparts(ssar,state,logger,err) != 0)
+        {
+          haserr = true;
+        }
+      } else
+      {
+        if (gt_depthfirstesa(ssar,
+                            tyr_allocateDfsinfo,
+                            tyr_freeDfsinfo,
+                            tyr_processleafedge,
+                            NULL,
+                            tyr_processcompletenode,
+                            tyr_assignleftmostleaf,
+                            tyr_assignrightmostleaf,
+                            (Dfsstate*) state,
+                            logger,
+                            err) != 0)
+        {
+          haserr = true;
+        }
       }
-      if (strlen(storeindex) == 0)
+      if (!haserr && strlen(storeindex) == 0)
       {
         showfinalstatistics(state,inputindex,logger);
       }
@@ -681,7 +989,8 @@ int gt_merstatistics(const char *inputindex,
                                                 SARR_LCPTAB |
                                                 SARR_SUFTAB |
                                                 SARR_ESQTAB,
-                                                (scanfile && !performtest)
+                                                (scanfile && !performtest &&
+                                                 gt_jobs == 1U)
                                                   ? true : false,
                                                 logger,
                                                 err);
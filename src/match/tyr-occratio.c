@@ -19,6 +19,7 @@
 #include "core/unused_api.h"
 #include "core/logger.h"
 #include "core/ma_api.h"
+#include "core/multithread_api.h"
 #include "esa-seqread.h"
 #include "tyr-occratio.h"
 
@@ -194,6 +195,145 @@ static void occ_assignrightmostleaf(Dfsinfo *adfsinfo,
   dfsinfo->lcptabrightmostleafplus1 = currentlcp;
 }
 
+#define OCC_PARTSPERJOB 8
+
+typedef struct
+{
+  const OccDfsstate *state; /* the distributions of all parts are added */
+  const Sequentialsuffixarrayreader *ssar;
+  GtUword *partbounds,
+          numofparts,
+          nextpart;
+  GtMutex *mutex;
+  bool haserr;
+  GtError *err;
+} OccPartsinfo;
+
+static void addupdistributions(GtArrayuint64_t *distribution,
+                               const GtArrayuint64_t *partdistribution)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < partdistribution->nextfreeuint64_t; idx++)
+  {
+    if (partdistribution->spaceuint64_t[idx] > 0)
+    {
+      adddistributionuint64_t(distribution,idx,
+                              (GtUword) partdistribution->spaceuint64_t[idx]);
+    }
+  }
+}
+
+/* Each thread computes the distributions for the parts it processes in its
+   own arrays and adds them to the global distributions at the end. As
+   each lcp-interval of depth at least <minmersize> is contained in exactly
+   one part, the sum is the same as for the sequential computation. */
+
+static void *occ_processparts_threadfunc(void *data)
+{
+  OccPartsinfo *info = (OccPartsinfo *) data;
+  GtArrayuint64_t uniquedistribution,
+                  nonuniquedistribution,
+                  nonuniquemultidistribution;
+  OccDfsstate partstate;
+  GtError *err = gt_error_new();
+  bool haserr = false;
+
+  GT_INITARRAY(&uniquedistribution,uint64_t);
+  GT_INITARRAY(&nonuniquedistribution,uint64_t);
+  GT_INITARRAY(&nonuniquemultidistribution,uint64_t);
+  partstate = *info->state;
+  partstate.uniquedistribution = &uniquedistribution;
+  partstate.nonuniquedistribution = &nonuniquedistribution;
+  partstate.nonuniquemultidistribution = &nonuniquemultidistribution;
+  while (!haserr)
+  {
+    GtUword part;
+    Sequentialsuffixarrayreader partssar;
+
+    gt_mutex_lock(info->mutex);
+    if (info->haserr || info->nextpart >= info->numofparts)
+    {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    part = info->nextpart++;
+    gt_mutex_unlock(info->mutex);
+    gt_Sequentialsuffixarrayreader_initpart(&partssar,
+                                            info->ssar,
+                                            info->partbounds[part],
+                                            info->partbounds[part+1]);
+    if (gt_depthfirstesa(&partssar,
+                         occ_allocateDfsinfo,
+                         occ_freeDfsinfo,
+                         occ_processleafedge,
+                         NULL,
+                         occ_processcompletenode,
+                         occ_assignleftmostleaf,
+                         occ_assignrightmostleaf,
+                         (Dfsstate*) &partstate,
+                         NULL,
+                         err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  gt_mutex_lock(info->mutex);
+  if (haserr)
+  {
+    if (!info->haserr)
+    {
+      info->haserr = true;
+      gt_error_set(info->err,"%s",gt_error_get(err));
+    }
+  } else
+  {
+    addupdistributions(info->state->uniquedistribution,
+                       &uniquedistribution);
+    addupdistributions(info->state->nonuniquedistribution,
+                       &nonuniquedistribution);
+    addupdistributions(info->state->nonuniquemultidistribution,
+                       &nonuniquemultidistribution);
+  }
+  gt_mutex_unlock(info->mutex);
+  GT_FREEARRAY(&uniquedistribution,uint64_t);
+  GT_FREEARRAY(&nonuniquedistribution,uint64_t);
+  GT_FREEARRAY(&nonuniquemultidistribution,uint64_t);
+  gt_error_delete(err);
+  return NULL;
+}
+
+static int occ_processparts(const Sequentialsuffixarrayreader *ssar,
+                            const OccDfsstate *state,
+                            GtLogger *logger,
+                            GtError *err)
+{
+  OccPartsinfo info;
+  bool haserr = false;
+
+  gt_error_check(err);
+  info.state = state;
+  info.ssar = ssar;
+  info.numofparts = (GtUword) gt_jobs * OCC_PARTSPERJOB;
+  info.partbounds = gt_Sequentialsuffixarrayreader_lcpparts(ssar,
+                                                            state->minmersize,
+                                                            &info.numofparts);
+  gt_logger_log(logger,"process "GT_WU" parts of the suffix array with %u "
+                       "threads",info.numofparts,gt_jobs);
+  info.nextpart = 0;
+  info.mutex = gt_mutex_new();
+  info.haserr = false;
+  info.err = err;
+  if (gt_multithread(occ_processparts_threadfunc,&info,err) != 0 ||
+      info.haserr)
+  {
+    haserr = true;
+  }
+  gt_mutex_delete(info.mutex);
+  gt_free(info.partbounds);
+  return haserr ? -1 : 0;
+}
+
 static int computeoccurrenceratio(Sequentialsuffixarrayreader *ssar,
                                   GtUword minmersize,
                                   GtUword maxmersize,
@@ -216,19 +356,28 @@ static int computeoccurrenceratio(Sequentialsuffixarrayreader *ssar,
   state->uniquedistribution = uniquedistribution;
   state->nonuniquedistribution = nonuniquedistribution;
   state->nonuniquemultidistribution = nonuniquemultidistribution;
-  if (gt_depthfirstesa(ssar,
-                    occ_allocateDfsinfo,
-                    occ_freeDfsinfo,
-                    occ_processleafedge,
-                    NULL,
-                    occ_processcompletenode,
-                    occ_assignleftmostleaf,
-                    occ_assignrightmostleaf,
-                    (Dfsstate*) state,
-                    logger,
-                    err) != 0)
+  if (gt_jobs > 1U)
   {
-    haserr = true;
+    if (occ_processparts(ssar,state,logger,err) != 0)
+    {
+      haserr = true;
+    }
+  } else
+  {
+    if (gt_depthfirstesa(ssar,
+                      occ_allocateDfsinfo,
+                      occ_freeDfsinfo,
+                      occ_processleafedge,
+                      NULL,
+                      occ_processcompletenode,
+                      occ_assignleftmostleaf,
+                      occ_assignrightmostleaf,
+                      (Dfsstate*) state,
+                      logger,
+                      err) != 0)
+    {
+      haserr = true;
+    }
   }
   gt_free(state);
   return haserr ? -1 : 0;
@@ -252,7 +401,8 @@ int gt_tyr_occratio_func(const char *inputindex,
                                                 SARR_LCPTAB |
                                                 SARR_SUFTAB |
                                                 SARR_ESQTAB,
-                                                scanfile,
+                                                (scanfile && gt_jobs == 1U)
+                                                  ? true : false,
                                                 logger,
                                                 err);
   if (ssar == NULL)
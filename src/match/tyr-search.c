@@ -15,6 +15,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/alphabet.h"
 #include "core/fa.h"
 #include "core/unused_api.h"
@@ -23,23 +24,81 @@
 #include "core/format64.h"
 #include "core/encseq.h"
 #include "core/ma_api.h"
+#include "core/intbits.h"
+#include "core/multithread_api.h"
+#include "core/str_api.h"
+#include "core/xansi_api.h"
 #include "revcompl.h"
 #include "tyr-map.h"
 #include "tyr-search.h"
 #include "tyr-show.h"
 #include "tyr-mersplit.h"
 
+/* The following cache is used to avoid repeated searches for the same mer,
+   which frequently occur when searching sets of reads. It is a direct
+   mapped table storing for each of its entries the bytecode of a mer and
+   the result of the search for it. Each thread has its own cache. */
+
+#define TYR_MERCACHE_LOGSIZE 16
+
+typedef struct
+{
+  GtUword mask,
+          merbytes;
+  GtUchar *keys;
+  const GtUchar **results;
+  GtBitsequence *isoccupied;
+} Tyrmercache;
+
+/* output of at least this size is written if it is not buffered for a
+   batch of sequences */
+#define TYR_OUTBUFSIZE (1UL << 16)
+
 typedef struct
 {
   GtUchar *bytecode,  /* buffer for encoded word to be searched */
         *rcbuf;
+  char *decodebuf;
   const GtUchar *mertable, *lastmer;
   GtUword mersize;
   unsigned int showmode,
                searchstrand;
   GtAlphabet *dnaalpha;
+  Tyrmercache mercache;
+  GtStr *outbuf;
+  bool flushoutput;
 } Tyrsearchinfo;
 
+static void gt_tyrmercache_init(Tyrmercache *mercache,GtUword merbytes)
+{
+  GtUword numofentries = 1UL << TYR_MERCACHE_LOGSIZE;
+
+  mercache->mask = numofentries - 1;
+  mercache->merbytes = merbytes;
+  mercache->keys = gt_malloc(sizeof *mercache->keys * numofentries * merbytes);
+  mercache->results = gt_malloc(sizeof *mercache->results * numofentries);
+  GT_INITBITTAB(mercache->isoccupied,numofentries);
+}
+
+static void gt_tyrmercache_delete(Tyrmercache *mercache)
+{
+  gt_free(mercache->keys);
+  gt_free(mercache->results);
+  gt_free(mercache->isoccupied);
+}
+
+static GtUword gt_tyrmercache_hash(const Tyrmercache *mercache,
+                                   const GtUchar *bytecode)
+{
+  GtUword idx, hashvalue = 0;
+
+  for (idx = 0; idx < mercache->merbytes; idx++)
+  {
+    hashvalue = (hashvalue << 5) - hashvalue + (GtUword) bytecode[idx];
+  }
+  return (hashvalue ^ (hashvalue >> TYR_MERCACHE_LOGSIZE)) & mercache->mask;
+}
+
 static void gt_tyrsearchinfo_init(Tyrsearchinfo *tyrsearchinfo,
                                const Tyrindex *tyrindex,
                                unsigned int showmode,
@@ -58,6 +117,11 @@ static void gt_tyrsearchinfo_init(Tyrsearchinfo *tyrsearchinfo,
                                       * merbytes);
   tyrsearchinfo->rcbuf = gt_malloc(sizeof *tyrsearchinfo->rcbuf
                                    * tyrsearchinfo->mersize);
+  tyrsearchinfo->decodebuf = gt_malloc(sizeof *tyrsearchinfo->decodebuf
+                                       * (tyrsearchinfo->mersize + 1));
+  gt_tyrmercache_init(&tyrsearchinfo->mercache,merbytes);
+  tyrsearchinfo->outbuf = NULL;
+  tyrsearchinfo->flushoutput = false;
 }
 
 static void gt_tyrsearchinfo_delete(Tyrsearchinfo *tyrsearchinfo)
@@ -67,18 +131,41 @@ static void gt_tyrsearchinfo_delete(Tyrsearchinfo *tyrsearchinfo)
     gt_alphabet_delete(tyrsearchinfo->dnaalpha);
     gt_free(tyrsearchinfo->bytecode);
     gt_free(tyrsearchinfo->rcbuf);
+    gt_free(tyrsearchinfo->decodebuf);
+    gt_tyrmercache_delete(&tyrsearchinfo->mercache);
+  }
+}
+
+static void gt_tyrsearchinfo_flush(Tyrsearchinfo *tyrsearchinfo)
+{
+  if (gt_str_length(tyrsearchinfo->outbuf) > 0)
+  {
+    gt_xfwrite(gt_str_get(tyrsearchinfo->outbuf),sizeof (char),
+               (size_t) gt_str_length(tyrsearchinfo->outbuf),stdout);
+    gt_str_reset(tyrsearchinfo->outbuf);
   }
 }
 
 /*@null@*/ const GtUchar *gt_searchsinglemer(const GtUchar *qptr,
                                         const Tyrindex *tyrindex,
-                                        const Tyrsearchinfo *tyrsearchinfo,
+                                        Tyrsearchinfo *tyrsearchinfo,
                                         const Tyrbckinfo *tyrbckinfo)
 {
   const GtUchar *result;
+  Tyrmercache *mercache = &tyrsearchinfo->mercache;
+  GtUword cacheidx;
+  GtUchar *cachekey;
 
   gt_encseq_plainseq2bytecode(tyrsearchinfo->bytecode,qptr,
                                        tyrsearchinfo->mersize);
+  cacheidx = gt_tyrmercache_hash(mercache,tyrsearchinfo->bytecode);
+  cachekey = mercache->keys + cacheidx * mercache->merbytes;
+  if (GT_ISIBITSET(mercache->isoccupied,cacheidx) &&
+      memcmp(cachekey,tyrsearchinfo->bytecode,(size_t) mercache->merbytes)
+        == 0)
+  {
+    return mercache->results[cacheidx];
+  }
   if (tyrbckinfo == NULL)
   {
     result = gt_tyrindex_binmersearch(tyrindex,0,tyrsearchinfo->bytecode,
@@ -88,6 +175,9 @@ static void gt_tyrsearchinfo_delete(Tyrsearchinfo *tyrsearchinfo)
   {
     result = gt_searchinbuckets(tyrindex,tyrbckinfo,tyrsearchinfo->bytecode);
   }
+  memcpy(cachekey,tyrsearchinfo->bytecode,(size_t) mercache->merbytes);
+  mercache->results[cacheidx] = result;
+  GT_SETIBIT(mercache->isoccupied,cacheidx);
   return result;
 }
 
@@ -97,12 +187,12 @@ static void gt_tyrsearchinfo_delete(Tyrsearchinfo *tyrsearchinfo)
           firstitem = false;\
         } else\
         {\
-          (void) putchar('\t');\
+          gt_str_append_char(tyrsearchinfo->outbuf,'\t');\
         }
 
 static void mermatchoutput(const Tyrindex *tyrindex,
                            const Tyrcountinfo *tyrcountinfo,
-                           const Tyrsearchinfo *tyrsearchinfo,
+                           Tyrsearchinfo *tyrsearchinfo,
                            const GtUchar *result,
                            const GtUchar *query,
                            const GtUchar *qptr,
@@ -115,37 +205,51 @@ static void mermatchoutput(const Tyrindex *tyrindex,
   queryposition = (GtUword) (qptr-query);
   if (tyrsearchinfo->showmode & SHOWQSEQNUM)
   {
-    printf(Formatuint64_t,PRINTuint64_tcast(unitnum));
+    char numbuf[32];
+
+    (void) snprintf(numbuf,sizeof (numbuf),Formatuint64_t,
+                    PRINTuint64_tcast(unitnum));
+    gt_str_append_cstr(tyrsearchinfo->outbuf,numbuf);
     firstitem = false;
   }
   if (tyrsearchinfo->showmode & SHOWQPOS)
   {
     ADDTABULATOR;
-    printf("%c"GT_WU"",forward ? '+' : '-',queryposition);
+    gt_str_append_char(tyrsearchinfo->outbuf,forward ? '+' : '-');
+    gt_str_append_uword(tyrsearchinfo->outbuf,queryposition);
   }
   if (tyrsearchinfo->showmode & SHOWCOUNTS)
   {
     GtUword mernumber = gt_tyrindex_ptr2number(tyrindex,result);
     ADDTABULATOR;
-    printf(""GT_WU"",gt_tyrcountinfo_get(tyrcountinfo,mernumber));
+    gt_str_append_uword(tyrsearchinfo->outbuf,
+                        gt_tyrcountinfo_get(tyrcountinfo,mernumber));
   }
   if (tyrsearchinfo->showmode & SHOWSEQUENCE)
   {
     ADDTABULATOR;
-    gt_alphabet_decode_seq_to_fp(tyrsearchinfo->dnaalpha,
-                                 stdout,
-                                 qptr,
-                                 tyrsearchinfo->mersize);
+    gt_alphabet_decode_seq_to_cstr(tyrsearchinfo->dnaalpha,
+                                   tyrsearchinfo->decodebuf,
+                                   qptr,
+                                   tyrsearchinfo->mersize);
+    gt_str_append_cstr_nt(tyrsearchinfo->outbuf,
+                          tyrsearchinfo->decodebuf,
+                          tyrsearchinfo->mersize);
   }
   if (tyrsearchinfo->showmode & (SHOWSEQUENCE | SHOWQPOS | SHOWCOUNTS))
   {
-    (void) putchar('\n');
+    gt_str_append_char(tyrsearchinfo->outbuf,'\n');
+  }
+  if (tyrsearchinfo->flushoutput &&
+      gt_str_length(tyrsearchinfo->outbuf) >= TYR_OUTBUFSIZE)
+  {
+    gt_tyrsearchinfo_flush(tyrsearchinfo);
   }
 }
 
 static void singleseqtyrsearch(const Tyrindex *tyrindex,
                                const Tyrcountinfo *tyrcountinfo,
-                               const Tyrsearchinfo *tyrsearchinfo,
+                               Tyrsearchinfo *tyrsearchinfo,
                                const Tyrbckinfo *tyrbckinfo,
                                uint64_t unitnum,
                                const GtUchar *query,
@@ -210,6 +314,223 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
   }
 }
 
+/* When more than one thread is used, the query sequences are read in batches
+   of at most <TYR_BATCHSEQUENCES> sequences and at most <TYR_BATCHLENGTH>
+   symbols per thread. The sequences of a batch are searched concurrently
+   and the output for each sequence is buffered, so that it can be written in
+   the order of the sequences after the batch is complete. */
+
+#define TYR_BATCHSEQUENCES 1024UL
+#define TYR_BATCHLENGTH    (1UL << 20)
+
+typedef struct
+{
+  GtUchar **sequences;
+  GtUword *seqlengths,
+          *allocatedlengths,
+          numofsequences,
+          allocatedsequences,
+          totallength;
+  GtStr **outputs;
+  uint64_t firstunitnum;
+} Tyrsearchbatch;
+
+typedef struct
+{
+  const Tyrindex *tyrindex;
+  const Tyrcountinfo *tyrcountinfo;
+  const Tyrbckinfo *tyrbckinfo;
+  Tyrsearchinfo *threadsearchinfo;
+  unsigned int nextthreadsearchinfo;
+  const Tyrsearchbatch *batch;
+  GtUword nextsequence;
+  GtMutex *mutex;
+} Tyrsearchthreadinfo;
+
+static void gt_tyrsearchbatch_init(Tyrsearchbatch *batch)
+{
+  batch->allocatedsequences = TYR_BATCHSEQUENCES;
+  batch->sequences = gt_calloc((size_t) batch->allocatedsequences,
+                               sizeof (*batch->sequences));
+  batch->seqlengths = gt_calloc((size_t) batch->allocatedsequences,
+                                sizeof (*batch->seqlengths));
+  batch->allocatedlengths = gt_calloc((size_t) batch->allocatedsequences,
+                                      sizeof (*batch->allocatedlengths));
+  batch->outputs = gt_calloc((size_t) batch->allocatedsequences,
+                             sizeof (*batch->outputs));
+  batch->numofsequences = 0;
+  batch->totallength = 0;
+  batch->firstunitnum = 0;
+}
+
+static void gt_tyrsearchbatch_add(Tyrsearchbatch *batch,
+                                  const GtUchar *query,
+                                  GtUword querylen)
+{
+  GtUword idx = batch->numofsequences;
+
+  gt_assert(idx < batch->allocatedsequences);
+  if (batch->allocatedlengths[idx] < querylen)
+  {
+    batch->sequences[idx] = gt_realloc(batch->sequences[idx],
+                                       sizeof (*batch->sequences[idx]) *
+                                       querylen);
+    batch->allocatedlengths[idx] = querylen;
+  }
+  if (querylen > 0)
+  {
+    memcpy(batch->sequences[idx],query,sizeof (*query) * querylen);
+  }
+  batch->seqlengths[idx] = querylen;
+  if (batch->outputs[idx] == NULL)
+  {
+    batch->outputs[idx] = gt_str_new();
+  }
+  batch->totallength += querylen;
+  batch->numofsequences++;
+}
+
+static void gt_tyrsearchbatch_output(Tyrsearchbatch *batch)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < batch->numofsequences; idx++)
+  {
+    if (gt_str_length(batch->outputs[idx]) > 0)
+    {
+      gt_xfwrite(gt_str_get(batch->outputs[idx]),sizeof (char),
+                 (size_t) gt_str_length(batch->outputs[idx]),stdout);
+      gt_str_reset(batch->outputs[idx]);
+    }
+  }
+  batch->firstunitnum += (uint64_t) batch->numofsequences;
+  batch->numofsequences = 0;
+  batch->totallength = 0;
+}
+
+static void gt_tyrsearchbatch_delete(Tyrsearchbatch *batch)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < batch->allocatedsequences; idx++)
+  {
+    gt_free(batch->sequences[idx]);
+    gt_str_delete(batch->outputs[idx]);
+  }
+  gt_free(batch->sequences);
+  gt_free(batch->seqlengths);
+  gt_free(batch->allocatedlengths);
+  gt_free(batch->outputs);
+}
+
+static void *gt_tyrsearch_threadfunc(void *data)
+{
+  Tyrsearchthreadinfo *threadinfo = (Tyrsearchthreadinfo *) data;
+  Tyrsearchinfo *tyrsearchinfo;
+  GtUword seqnum;
+
+  gt_mutex_lock(threadinfo->mutex);
+  gt_assert(threadinfo->nextthreadsearchinfo < gt_jobs);
+  tyrsearchinfo
+    = threadinfo->threadsearchinfo + threadinfo->nextthreadsearchinfo++;
+  gt_mutex_unlock(threadinfo->mutex);
+  while (true)
+  {
+    gt_mutex_lock(threadinfo->mutex);
+    seqnum = threadinfo->nextsequence++;
+    gt_mutex_unlock(threadinfo->mutex);
+    if (seqnum >= threadinfo->batch->numofsequences)
+    {
+      break;
+    }
+    tyrsearchinfo->outbuf = threadinfo->batch->outputs[seqnum];
+    singleseqtyrsearch(threadinfo->tyrindex,
+                       threadinfo->tyrcountinfo,
+                       tyrsearchinfo,
+                       threadinfo->tyrbckinfo,
+                       threadinfo->batch->firstunitnum + (uint64_t) seqnum,
+                       threadinfo->batch->sequences[seqnum],
+                       threadinfo->batch->seqlengths[seqnum],
+                       NULL);
+  }
+  return NULL;
+}
+
+static int gt_tyrsearch_batches(const Tyrindex *tyrindex,
+                                const Tyrcountinfo *tyrcountinfo,
+                                const Tyrbckinfo *tyrbckinfo,
+                                GtSeqIterator *seqit,
+                                unsigned int showmode,
+                                unsigned int searchstrand,
+                                GtError *err)
+{
+  Tyrsearchthreadinfo threadinfo;
+  Tyrsearchbatch batch;
+  unsigned int thread;
+  bool haserr = false, endofinput = false;
+
+  gt_error_check(err);
+  threadinfo.tyrindex = tyrindex;
+  threadinfo.tyrcountinfo = tyrcountinfo;
+  threadinfo.tyrbckinfo = tyrbckinfo;
+  threadinfo.threadsearchinfo = gt_malloc(sizeof (*threadinfo.threadsearchinfo)
+                                          * gt_jobs);
+  for (thread = 0; thread < gt_jobs; thread++)
+  {
+    gt_tyrsearchinfo_init(threadinfo.threadsearchinfo + thread,tyrindex,
+                          showmode,searchstrand);
+  }
+  threadinfo.mutex = gt_mutex_new();
+  threadinfo.batch = &batch;
+  gt_seq_iterator_set_symbolmap(seqit,
+                  gt_alphabet_symbolmap(threadinfo.threadsearchinfo->dnaalpha));
+  gt_tyrsearchbatch_init(&batch);
+  while (!haserr && !endofinput)
+  {
+    while (batch.numofsequences < batch.allocatedsequences &&
+           batch.totallength < TYR_BATCHLENGTH * gt_jobs)
+    {
+      const GtUchar *query;
+      GtUword querylen;
+      char *desc = NULL;
+      int retval;
+
+      retval = gt_seq_iterator_next(seqit,&query,&querylen,&desc,err);
+      if (retval < 0)
+      {
+        haserr = true;
+        break;
+      }
+      if (retval == 0)
+      {
+        endofinput = true;
+        break;
+      }
+      gt_tyrsearchbatch_add(&batch,query,querylen);
+    }
+    if (!haserr && batch.numofsequences > 0)
+    {
+      threadinfo.nextsequence = 0;
+      threadinfo.nextthreadsearchinfo = 0;
+      if (gt_multithread(gt_tyrsearch_threadfunc,&threadinfo,err) != 0)
+      {
+        haserr = true;
+      } else
+      {
+        gt_tyrsearchbatch_output(&batch);
+      }
+    }
+  }
+  gt_tyrsearchbatch_delete(&batch);
+  for (thread = 0; thread < gt_jobs; thread++)
+  {
+    gt_tyrsearchinfo_delete(threadinfo.threadsearchinfo + thread);
+  }
+  gt_free(threadinfo.threadsearchinfo);
+  gt_mutex_delete(threadinfo.mutex);
+  return haserr ? -1 : 0;
+}
+
 int gt_tyrsearch(const char *tyrindexname,
                  const GtStrArray *queryfilenames,
                  unsigned int showmode,
@@ -265,53 +586,83 @@ int gt_tyrsearch(const char *tyrindexname,
       }
     }
   }
-  if (!haserr)
+  if (!haserr && gt_jobs > 1U)
   {
-    const GtUchar *query;
-    GtUword querylen;
-    char *desc = NULL;
-    uint64_t unitnum;
-    int retval;
-    Tyrsearchinfo tyrsearchinfo;
     GtSeqIterator *seqit;
 
     gt_assert(tyrindex != NULL);
-    gt_tyrsearchinfo_init(&tyrsearchinfo,tyrindex,showmode,searchstrand);
     seqit = gt_seq_iterator_sequence_buffer_new(queryfilenames, err);
     if (!seqit)
+    {
       haserr = true;
+    } else
+    {
+      if (gt_tyrsearch_batches(tyrindex,
+                               tyrcountinfo,
+                               tyrbckinfo,
+                               seqit,
+                               showmode,
+                               searchstrand,
+                               err) != 0)
+      {
+        haserr = true;
+      }
+      gt_seq_iterator_delete(seqit);
+    }
+  } else
+  {
     if (!haserr)
     {
-      gt_seq_iterator_set_symbolmap(seqit,
-                                 gt_alphabet_symbolmap(tyrsearchinfo.dnaalpha));
-      for (unitnum = 0; /* Nothing */; unitnum++)
+      const GtUchar *query;
+      GtUword querylen;
+      char *desc = NULL;
+      uint64_t unitnum;
+      int retval;
+      Tyrsearchinfo tyrsearchinfo;
+      GtSeqIterator *seqit;
+
+      gt_assert(tyrindex != NULL);
+      gt_tyrsearchinfo_init(&tyrsearchinfo,tyrindex,showmode,searchstrand);
+      tyrsearchinfo.outbuf = gt_str_new();
+      tyrsearchinfo.flushoutput = true;
+      seqit = gt_seq_iterator_sequence_buffer_new(queryfilenames, err);
+      if (!seqit)
+        haserr = true;
+      if (!haserr)
       {
-        retval = gt_seq_iterator_next(seqit,
-                                     &query,
-                                     &querylen,
-                                     &desc,
-                                     err);
-        if (retval < 0)
-        {
-          haserr = true;
-          break;
-        }
-        if (retval == 0)
+        gt_seq_iterator_set_symbolmap(seqit,
+                                 gt_alphabet_symbolmap(tyrsearchinfo.dnaalpha));
+        for (unitnum = 0; /* Nothing */; unitnum++)
         {
-          break;
+          retval = gt_seq_iterator_next(seqit,
+                                       &query,
+                                       &querylen,
+                                       &desc,
+                                       err);
+          if (retval < 0)
+          {
+            haserr = true;
+            break;
+          }
+          if (retval == 0)
+          {
+            break;
+          }
+          singleseqtyrsearch(tyrindex,
+                             tyrcountinfo,
+                             &tyrsearchinfo,
+                             tyrbckinfo,
+                             unitnum,
+                             query,
+                             querylen,
+                             desc);
         }
-        singleseqtyrsearch(tyrindex,
-                           tyrcountinfo,
-                           &tyrsearchinfo,
-                           tyrbckinfo,
-                           unitnum,
-                           query,
-                           querylen,
-                           desc);
+        gt_tyrsearchinfo_flush(&tyrsearchinfo);
+        gt_seq_iterator_delete(seqit);
       }
-      gt_seq_iterator_delete(seqit);
+      gt_str_delete(tyrsearchinfo.outbuf);
+      gt_tyrsearchinfo_delete(&tyrsearchinfo);
     }
-    gt_tyrsearchinfo_delete(&tyrsearchinfo);
   }
   if (tyrbckinfo != NULL)
   {
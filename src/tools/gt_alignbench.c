@@ -0,0 +1,235 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "core/chardef.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/option_api.h"
+#include "core/str_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "extended/affinealign.h"
+#include "extended/alignment.h"
+#include "extended/striped_align.h"
+#include "tools/gt_alignbench.h"
+
+typedef struct {
+  GtStr *mode;
+  bool baseline;
+  GtUword ulen,
+          vlen,
+          runs;
+} GtAlignbenchArguments;
+
+static void* gt_alignbench_arguments_new(void)
+{
+  GtAlignbenchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  arguments->mode = gt_str_new();
+  return arguments;
+}
+
+static void gt_alignbench_arguments_delete(void *tool_arguments)
+{
+  GtAlignbenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->mode);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_alignbench_option_parser_new(void *tool_arguments)
+{
+  GtAlignbenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  static const char *modes[] = {"local", "global", NULL};
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...]",
+                            "Compare the cell update rates of the alignment "
+                            "kernels on random DNA sequences.");
+
+  option = gt_option_new_choice("mode", "compute local (affine gap scores) "
+                                "or global (affine gap costs) alignments\n"
+                                "choose from local|global", arguments->mode,
+                                modes[0], modes);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_bool("baseline", "in global mode, also compute the "
+                              "alignments with the full DP table of "
+                              "gt_affinealign() (needs memory proportional to "
+                              "ulen * vlen)", &arguments->baseline, true);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("ulen", "length of the first sequence",
+                                   &arguments->ulen, 1000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("vlen", "length of the second sequence",
+                                   &arguments->vlen, 1000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("runs", "number of alignments computed "
+                                   "with every kernel", &arguments->runs, 10UL,
+                                   1UL);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 0);
+  return op;
+}
+
+/* shows the result of <runs> alignments computed by <name> in the time
+   measured by <timer>, the first shown result is the reference for the score
+   and the speedup */
+static int gt_alignbench_show(const char *name, GtWord score, GtTimer *timer,
+                              double cells, bool *first, GtWord *firstscore,
+                              double *firstseconds, GtError *err)
+{
+  const bool reference = *first;
+  double seconds;
+  gt_error_check(err);
+  gt_timer_stop(timer);
+  seconds = (double) gt_timer_elapsed_usec(timer) / 1000000.0;
+  if (reference) {
+    *first = false;
+    *firstscore = score;
+    *firstseconds = seconds;
+  }
+  else if (score != *firstscore) {
+    gt_error_set(err, "%s computed score "GT_WD" instead of "GT_WD, name,
+                 score, *firstscore);
+    return -1;
+  }
+  printf("%-20s score "GT_WD", %.3f s, %.1f MCUPS", name, score, seconds,
+         seconds > 0.0 ? cells / seconds / 1000000.0 : 0.0);
+  if (!reference && seconds > 0.0)
+    printf(", speedup %.2f", *firstseconds / seconds);
+  printf("\n");
+  return 0;
+}
+
+static int gt_alignbench_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
+                                GT_UNUSED int parsed_args,
+                                void *tool_arguments, GtError *err)
+{
+  GtAlignbenchArguments *arguments = tool_arguments;
+  const GtStripedAlignKernel kernels[] = { GT_STRIPED_ALIGN_KERNEL_SCALAR,
+                                           GT_STRIPED_ALIGN_KERNEL_SSE2 };
+  const int scorerow[4][4] = {{ 2, -1, -1, -1},
+                              {-1,  2, -1, -1},
+                              {-1, -1,  2, -1},
+                              {-1, -1, -1,  2}};
+  const int *scores[4];
+  const bool local = strcmp(gt_str_get(arguments->mode), "local") == 0;
+  GtStripedAlignKernel kernel;
+  GtAlignment *alignment;
+  GtTimer *timer;
+  GtUchar *u, *v;
+  GtWord score = 0, firstscore = 0;
+  GtUword i, r, uend, vend;
+  double cells, firstseconds = 0.0;
+  char name[64];
+  bool first = true;
+  size_t k;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  for (i = 0; i < 4UL; i++)
+    scores[i] = scorerow[i];
+  /* the codes of the characters also serve as characters for the global
+     alignments */
+  u = gt_malloc(sizeof (*u) * arguments->ulen);
+  for (i = 0; i < arguments->ulen; i++)
+    u[i] = (GtUchar) gt_rand_max(3UL);
+  v = gt_malloc(sizeof (*v) * arguments->vlen);
+  for (i = 0; i < arguments->vlen; i++)
+    v[i] = (GtUchar) gt_rand_max(3UL);
+  cells = (double) arguments->ulen * (double) arguments->vlen *
+          (double) arguments->runs;
+
+  printf("# %s alignment of "GT_WU" x "GT_WU" cells, "GT_WU" runs\n",
+         gt_str_get(arguments->mode), arguments->ulen, arguments->vlen,
+         arguments->runs);
+  timer = gt_timer_new();
+  if (!local && arguments->baseline) {
+    /* the existing implementation, which fills the whole DP table and traces
+       back an optimal alignment */
+    gt_timer_start(timer);
+    for (r = 0; r < arguments->runs; r++) {
+      alignment = gt_affinealign((const char*) u, arguments->ulen,
+                                 (const char*) v, arguments->vlen, 1, 2, 1);
+      score = -gt_alignment_eval_with_affine_score(alignment, 0, -1, -2, -1);
+      gt_alignment_delete(alignment);
+    }
+    had_err = gt_alignbench_show("affinealign", score, timer, cells, &first,
+                                 &firstscore, &firstseconds, err);
+  }
+  for (k = 0; !had_err && k < sizeof (kernels) / sizeof (kernels[0]); k++) {
+    if (!gt_striped_align_kernel_available(kernels[k]))
+      continue;
+    /* the requested kernel is only a hint, show the one which runs */
+    if (local) {
+      kernel = gt_striped_align_local_kernel(arguments->ulen, 4U,
+                                             arguments->vlen, 4U, scores, -3,
+                                             -1, -1, kernels[k]);
+    }
+    else {
+      kernel = gt_striped_align_global_kernel(arguments->ulen,
+                                              arguments->vlen, 1, 2, 1,
+                                              kernels[k]);
+    }
+    if (kernel == kernels[k])
+      (void) snprintf(name, sizeof name, "%s",
+                      gt_striped_align_kernel_name(kernel));
+    else {
+      (void) snprintf(name, sizeof name, "%s (for %s)",
+                      gt_striped_align_kernel_name(kernel),
+                      gt_striped_align_kernel_name(kernels[k]));
+    }
+    gt_timer_start(timer);
+    for (r = 0; r < arguments->runs; r++) {
+      if (local) {
+        score = gt_striped_align_local(&uend, &vend, u, arguments->ulen, 4U,
+                                       v, arguments->vlen, 4U, scores, -3, -1,
+                                       -1, kernels[k]);
+      }
+      else {
+        score = (GtWord) gt_striped_align_global((const char*) u,
+                                                 arguments->ulen,
+                                                 (const char*) v,
+                                                 arguments->vlen, 1, 2, 1,
+                                                 kernels[k]);
+      }
+    }
+    had_err = gt_alignbench_show(name, score, timer, cells, &first,
+                                 &firstscore, &firstseconds, err);
+  }
+  gt_timer_delete(timer);
+  gt_free(u);
+  gt_free(v);
+  return had_err;
+}
+
+GtTool* gt_alignbench(void)
+{
+  return gt_tool_new(gt_alignbench_arguments_new,
+                     gt_alignbench_arguments_delete,
+                     gt_alignbench_option_parser_new,
+                     NULL,
+                     gt_alignbench_runner);
+}
@@ -18,12 +18,15 @@
 #include "core/ma.h"
 #include "core/option_api.h"
 #include "core/output_file_api.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
-#include "extended/cds_stream_api.h"
+#include "extended/cds_visitor.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gff3_out_stream_api.h"
 #include "extended/gtdatahelp.h"
+#include "extended/parallel_visitor_stream_api.h"
+#include "extended/region_mapping.h"
 #include "extended/seqid2file.h"
 #include "tools/gt_cds.h"
 
@@ -113,9 +116,10 @@ static GtOptionParser* gt_cds_option_parser_new(void *tool_arguments)
 static int gt_cds_runner(GT_UNUSED int argc, const char **argv, int parsed_args,
                          void *tool_arguments, GtError *err)
 {
-  GtNodeStream *gff3_in_stream, *cds_stream = NULL, *gff3_out_stream = NULL;
-  CDSArguments *arguments = tool_arguments;
+  GtNodeStream *gff3_in_stream, *cds_stream, *gff3_out_stream = NULL;
   GtRegionMapping *region_mapping;
+  CDSArguments *arguments = tool_arguments;
+  unsigned int i;
   int had_err = 0;
 
   gt_error_check(err);
@@ -126,19 +130,32 @@ static int gt_cds_runner(GT_UNUSED int argc, const char **argv, int parsed_args,
   if (arguments->verbose && arguments->outfp)
     gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
 
-  /* create region mapping */
+  /* create CDS stream, the exons of different feature trees are processed
+     by <gt_jobs> workers, each with its own CDS visitor. The workers share
+     one locked region mapping, such that the sequence files are indexed
+     only once. */
+  cds_stream = gt_parallel_visitor_stream_new(gff3_in_stream);
   region_mapping = gt_seqid2file_region_mapping_new(arguments->s2fi, err);
   if (!region_mapping)
     had_err = -1;
+  else if (gt_jobs > 1U)
+    gt_region_mapping_enable_locking(region_mapping);
+  for (i = 0; !had_err && i < gt_jobs; i++) {
+    GtStr *source = gt_str_new_cstr(GT_CDS_SOURCE_TAG);
+    GtNodeVisitor *cds_visitor;
+    /* each visitor takes ownership of one reference */
+    if (i > 0)
+      (void) gt_region_mapping_ref(region_mapping);
+    cds_visitor = gt_cds_visitor_new(region_mapping, arguments->minorflen,
+                                     source, arguments->start_codon,
+                                     arguments->final_stop_codon,
+                                     arguments->generic_start_codons);
+    gt_parallel_visitor_stream_add_visitor((GtParallelVisitorStream*)
+                                           cds_stream, i, cds_visitor);
+    gt_str_delete(source);
+  }
 
   if (!had_err) {
-    /* create CDS stream */
-    cds_stream = gt_cds_stream_new(gff3_in_stream, region_mapping,
-                                   arguments->minorflen, GT_CDS_SOURCE_TAG,
-                                   arguments->start_codon,
-                                   arguments->final_stop_codon,
-                                   arguments->generic_start_codons);
-
     /* create gff3 output stream */
     gff3_out_stream = gt_gff3_out_stream_new(cds_stream, arguments->outfp);
 
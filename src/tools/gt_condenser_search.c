@@ -42,6 +42,7 @@
 #include "extended/match_blast_api.h"
 #include "extended/match_iterator_blast.h"
 #include "extended/n_r_encseq.h"
+#include "extended/n_r_encseq_search.h"
 #include "core/output_file_api.h"
 
 #include "tools/gt_condenser_search.h"
@@ -50,13 +51,16 @@ typedef struct {
   GtFile           *outfp;
   GtOutputFileInfo *ofi;
   GtStr            *dbpath,
-                   *querypath;
+                   *querypath,
+                   *seed;
   GtUword bitscore;
+  GtWord  xdrop;
   double  ceval,
           feval;
   int     blthreads;
   bool    blastp,
           blastn,
+          native,
           verbose;
 } GtCondenserSearchArguments;
 
@@ -66,6 +70,7 @@ static void* gt_condenser_search_arguments_new(void)
                                     gt_calloc((size_t) 1, sizeof *arguments);
   arguments->dbpath = gt_str_new();
   arguments->querypath = gt_str_new();
+  arguments->seed = gt_str_new();
   arguments->ofi = gt_output_file_info_new();
   return arguments;
 }
@@ -76,6 +81,7 @@ static void gt_condenser_search_arguments_delete(void *tool_arguments)
   if (arguments != NULL) {
     gt_str_delete(arguments->dbpath);
     gt_str_delete(arguments->querypath);
+    gt_str_delete(arguments->seed);
     gt_file_delete(arguments->outfp);
     gt_output_file_info_delete(arguments->ofi);
     gt_free(arguments);
@@ -88,7 +94,7 @@ static GtOptionParser* gt_condenser_search_option_parser_new
   GtCondenserSearchArguments *arguments = tool_arguments;
   GtOptionParser *op;
   GtOption *option, *score_opt, *ceval_opt, *feval_opt, *blastp_opt,
-           *blastn_opt;
+           *blastn_opt, *native_opt;
   gt_assert(arguments);
 
   /* init */
@@ -102,9 +108,33 @@ static GtOptionParser* gt_condenser_search_option_parser_new
   /* -blastp */
   blastp_opt = gt_option_new_bool("blastp", "perform blastp search",
                                   &arguments->blastp, false);
+  /* -native */
+  native_opt = gt_option_new_bool("native", "perform seed and extend search "
+                                  "without calling external programs",
+                                  &arguments->native, false);
   gt_option_exclude(blastn_opt, blastp_opt);
+  gt_option_exclude(blastn_opt, native_opt);
+  gt_option_exclude(blastp_opt, native_opt);
   gt_option_parser_add_option(op, blastn_opt);
   gt_option_parser_add_option(op, blastp_opt);
+  gt_option_parser_add_option(op, native_opt);
+
+  /* -seed */
+  option = gt_option_new_string("seed", "spaced seed for -native search, "
+                                "positions marked by 1 have to match, "
+                                "defaults to 111010010100110111 for DNA and "
+                                "11011 for protein",
+                                arguments->seed, NULL);
+  gt_option_imply(option, native_opt);
+  gt_option_hide_default(option);
+  gt_option_parser_add_option(op, option);
+
+  /* -xdrop */
+  option = gt_option_new_word("xdrop", "xdrop score for extension of seeds in "
+                              "-native search",
+                              &arguments->xdrop, (GtWord) 10);
+  gt_option_imply(option, native_opt);
+  gt_option_parser_add_option(op, option);
 
   /* -score */
   score_opt = gt_option_new_uword("score", "bitscore threshold for BLAST(p) "
@@ -159,17 +189,17 @@ static GtOptionParser* gt_condenser_search_option_parser_new
 
 static int gt_condenser_search_arguments_check(GT_UNUSED int rest_argc,
                                        void *tool_arguments,
-                                       GT_UNUSED GtError *err)
+                                       GtError *err)
 {
   GtCondenserSearchArguments *arguments = tool_arguments;
   int had_err = 0;
-  if (!(arguments->blastn || arguments->blastp)) {
-    gt_error_set(err, "no other searches then blast implemented yet, please "
-                 "provide either -blastn or -blastp");
-    had_err = -1;
-  }
   gt_error_check(err);
   gt_assert(arguments);
+  if (!(arguments->blastn || arguments->blastp || arguments->native)) {
+    gt_error_set(err, "no search method given, please provide either -blastn, "
+                 "-blastp or -native");
+    had_err = -1;
+  }
 
   return had_err;
 }
@@ -535,6 +565,47 @@ static int gt_condenser_search_runner(GT_UNUSED int argc,
     }
     gt_free(hits);
     gt_str_delete(fastaname);
+  } else if (arguments->native) {
+    /* match and mismatch scores of blastn for DNA, the xdrop alignment has
+       no affine gap costs. Protein is scored with BLOSUM62. */
+    GtXdropArbitraryscores scores = {2, -3, -5, -5};
+    GtNREncseq *nrencseq = NULL;
+    GtNREncseqSearch *nres = NULL;
+    GtUword numofhits = 0;
+
+    if (gt_showtime_enabled()) {
+      timer = gt_timer_new_with_progress_description("initialization");
+      gt_timer_start(timer);
+    }
+    nrencseq = gt_n_r_encseq_new_from_file(gt_str_get(arguments->dbpath),
+                                           logger, err);
+    if (nrencseq == NULL)
+      had_err = -1;
+    if (!had_err) {
+      if (timer != NULL)
+        gt_timer_show_progress(timer, "create seed index", stderr);
+      nres = gt_n_r_encseq_search_new(nrencseq,
+                                      gt_str_length(arguments->seed) > 0 ?
+                                        gt_str_get(arguments->seed) : NULL,
+                                      &scores, arguments->xdrop, logger, err);
+      if (nres == NULL)
+        had_err = -1;
+    }
+    if (!had_err) {
+      if (timer != NULL)
+        gt_timer_show_progress(timer, "seed and extend search", stderr);
+      had_err = gt_n_r_encseq_search_run(nres, querypath, arguments->ceval,
+                                         arguments->feval, arguments->bitscore,
+                                         arguments->outfp, &numofhits, err);
+    }
+    if (!had_err) {
+      gt_log_log(GT_WU " hits found\n", numofhits);
+      if (timer != NULL)
+        gt_timer_show_progress_final(timer, stderr);
+    }
+    gt_timer_delete(timer);
+    gt_n_r_encseq_search_delete(nres);
+    gt_n_r_encseq_delete(nrencseq);
   }
   gt_str_delete(coarse_fname);
   gt_logger_delete(logger);
@@ -20,16 +20,20 @@
 #include "core/tool.h"
 #include "core/toolbox.h"
 #include "core/versionfunc.h"
+#include "gth/gt_gth.h"
 #include "gth/gt_gthbssmbuild.h"
 #include "gth/gt_gthbssmfileinfo.h"
 #include "gth/gt_gthbssmprint.h"
 #include "gth/gt_gthbssmrmsd.h"
 #include "gth/gt_gthbssmtrain.h"
+#include "gth/gt_gthdpbench.h"
 #include "gth/gt_gthmkbssmfiles.h"
+#include "tools/gt_alignbench.h"
 #include "tools/gt_compressedbits.h"
 #include "tools/gt_consensus_sa.h"
 #include "tools/gt_dev.h"
 #include "tools/gt_extracttarget.h"
+#include "tools/gt_featindexbench.h"
 #include "tools/gt_gdiffcalc.h"
 #include "tools/gt_guessprot.h"
 #include "tools/gt_idxlocali.h"
@@ -54,6 +58,7 @@ static void* gt_dev_arguments_new(void)
   GtToolbox *dev_toolbox = gt_toolbox_new();
   /* add development tools here with a function call like this:
      gt_toolbox_add(dev_toolbox, "devtool", gt_devtool); */
+  gt_toolbox_add(dev_toolbox, "gth", gt_gth_encseq);
   gt_toolbox_add(dev_toolbox, "gthbssmbuild", gt_gthbssmbuild);
   gt_toolbox_add(dev_toolbox, "gthbssmfileinfo", gt_gthbssmfileinfo);
   gt_toolbox_add(dev_toolbox, "gthbssmprint", gt_gthbssmprint);
@@ -64,12 +69,15 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add(dev_toolbox, "patternmatch", gt_patternmatch);
   gt_toolbox_add(dev_toolbox, "regioncov", gt_regioncov);
   gt_toolbox_add(dev_toolbox, "trieins", gt_trieins);
+  gt_toolbox_add_tool(dev_toolbox, "alignbench", gt_alignbench());
   gt_toolbox_add_tool(dev_toolbox, "compbits", gt_compressedbits());
   gt_toolbox_add_tool(dev_toolbox, "consensus_sa", gt_consensus_sa_tool());
   gt_toolbox_add_tool(dev_toolbox, "extracttarget", gt_extracttarget());
+  gt_toolbox_add_tool(dev_toolbox, "featindexbench", gt_featindexbench());
   gt_toolbox_add_tool(dev_toolbox, "gdiffcalc", gt_gdiffcalc());
   gt_toolbox_add_tool(dev_toolbox, "gthbssmrmsd", gt_gthbssmrmsd());
   gt_toolbox_add_tool(dev_toolbox, "gthbssmtrain", gt_gthbssmtrain());
+  gt_toolbox_add_tool(dev_toolbox, "gthdpbench", gt_gthdpbench());
   gt_toolbox_add_tool(dev_toolbox, "idxlocali", gt_idxlocali());
   gt_toolbox_add_tool(dev_toolbox, "magicmatch", gt_magicmatch());
   gt_toolbox_add_tool(dev_toolbox, "parsexrf", gt_parsexrf());
@@ -16,9 +16,12 @@
 
 #include "core/ma_api.h"
 #include "core/output_file_api.h"
+#include "core/thread_api.h"
 #include "extended/dup_feature_stream_api.h"
+#include "extended/dup_feature_visitor.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gff3_out_stream_api.h"
+#include "extended/parallel_visitor_stream_api.h"
 #include "tools/gt_interfeat.h"
 
 typedef struct {
@@ -94,10 +97,22 @@ static int gt_interfeat_runner(int argc, const char **argv, int parsed_args,
   gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
                                                   argv + parsed_args);
 
-  /* create intermediary feature stream */
-  dup_feature_stream =
-    gt_dup_feature_stream_new(gff3_in_stream, gt_str_get(arguments->dest_type),
-                              gt_str_get(arguments->source_type));
+  /* create intermediary feature stream, with several jobs the feature trees
+     are processed concurrently by one shared (thread-safe) visitor */
+  if (gt_jobs > 1U) {
+    GtNodeVisitor *nv;
+    nv = gt_dup_feature_visitor_new(gt_str_get(arguments->dest_type),
+                                    gt_str_get(arguments->source_type));
+    dup_feature_stream = gt_parallel_visitor_stream_new(gff3_in_stream);
+    gt_parallel_visitor_stream_add_shared_visitor((GtParallelVisitorStream*)
+                                                  dup_feature_stream, nv);
+  }
+  else {
+    dup_feature_stream =
+      gt_dup_feature_stream_new(gff3_in_stream,
+                                gt_str_get(arguments->dest_type),
+                                gt_str_get(arguments->source_type));
+  }
 
   /* create gff3 output stream */
   gff3_out_stream = gt_gff3_out_stream_new(dup_feature_stream,
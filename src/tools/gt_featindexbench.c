@@ -0,0 +1,234 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/option_api.h"
+#include "core/str_array_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_node_api.h"
+#include "extended/feature_out_stream_api.h"
+#include "extended/genome_node.h"
+#include "extended/gff3_in_stream.h"
+#include "tools/gt_featindexbench.h"
+
+typedef struct {
+  GtUword queries,
+          width;
+} GtFeatindexbenchArguments;
+
+typedef struct {
+  const char *seqid;
+  GtRange range;
+} GtFeatindexbenchQuery;
+
+static void* gt_featindexbench_arguments_new(void)
+{
+  return gt_calloc((size_t) 1, sizeof (GtFeatindexbenchArguments));
+}
+
+static void gt_featindexbench_arguments_delete(void *tool_arguments)
+{
+  GtFeatindexbenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_featindexbench_option_parser_new(void *tool_arguments)
+{
+  GtFeatindexbenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...] GFF3_file",
+                            "Compare the range query times of the interval "
+                            "tree and the implicit interval index of the "
+                            "memory feature index.");
+
+  option = gt_option_new_uword_min("queries", "number of random range queries",
+                                   &arguments->queries, 10000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("width", "maximal width of a query range",
+                                   &arguments->width, 10000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_min_max_args(op, 1U, 1U);
+  return op;
+}
+
+/* returns a random number between 0 and <maximal_value> */
+static GtUword gt_featindexbench_rand(GtUword maximal_value)
+{
+  return maximal_value > 0 ? gt_rand_max(maximal_value) : 0;
+}
+
+static int gt_featindexbench_load(GtFeatureIndex *fi, const char *filename,
+                                  GtError *err)
+{
+  GtNodeStream *gff3_in_stream, *feature_out_stream;
+  int had_err;
+  gt_error_check(err);
+  gff3_in_stream = gt_gff3_in_stream_new_sorted(filename);
+  feature_out_stream = gt_feature_out_stream_new(gff3_in_stream, fi);
+  had_err = gt_node_stream_pull(feature_out_stream, err);
+  gt_node_stream_delete(feature_out_stream);
+  gt_node_stream_delete(gff3_in_stream);
+  return had_err;
+}
+
+static int gt_featindexbench_run(GtFeatureIndex *fi,
+                                 const GtFeatindexbenchQuery *queries,
+                                 GtUword numofqueries, GtArray **results,
+                                 GtError *err)
+{
+  GtUword q;
+  int had_err = 0;
+  gt_error_check(err);
+  for (q = 0; !had_err && q < numofqueries; q++) {
+    gt_array_reset(results[q]);
+    had_err = gt_feature_index_get_features_for_range(fi, results[q],
+                                                      queries[q].seqid,
+                                                      &queries[q].range,
+                                                      err);
+  }
+  return had_err;
+}
+
+static int gt_featindexbench_runner(GT_UNUSED int argc, const char **argv,
+                                    int parsed_args, void *tool_arguments,
+                                    GtError *err)
+{
+  GtFeatindexbenchArguments *arguments = tool_arguments;
+  GtFeatureIndex *fi[2];
+  const char *names[] = { "tree", "implicit" };
+  GtFeatindexbenchQuery *queries = NULL;
+  GtArray **results[2];
+  GtStrArray *seqids = NULL;
+  GtTimer *timer;
+  GtUword i, q, numofresults = 0;
+  double loadtime[2], querytime[2];
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  fi[0] = gt_feature_index_memory_new();
+  fi[1] = gt_feature_index_memory_new_implicit();
+  timer = gt_timer_new();
+  for (i = 0; !had_err && i < 2UL; i++) {
+    gt_timer_start(timer);
+    had_err = gt_featindexbench_load(fi[i], argv[parsed_args], err);
+    gt_timer_stop(timer);
+    loadtime[i] = (double) gt_timer_elapsed_usec(timer) / 1000000.0;
+  }
+  if (!had_err && !(seqids = gt_feature_index_get_seqids(fi[0], err)))
+    had_err = -1;
+  if (!had_err && gt_str_array_size(seqids) == 0) {
+    gt_error_set(err, "file \"%s\" does not contain any features",
+                 argv[parsed_args]);
+    had_err = -1;
+  }
+
+  /* draw the queries uniformly from the ranges of the sequences */
+  if (!had_err) {
+    queries = gt_malloc(sizeof (*queries) * arguments->queries);
+    for (q = 0; !had_err && q < arguments->queries; q++) {
+      GtRange range;
+      queries[q].seqid =
+        gt_str_array_get(seqids,
+                         gt_featindexbench_rand(gt_str_array_size(seqids) - 1));
+      had_err = gt_feature_index_get_range_for_seqid(fi[0], &range,
+                                                     queries[q].seqid, err);
+      queries[q].range.start = range.start +
+                               gt_featindexbench_rand(gt_range_length(&range)
+                                                      - 1);
+      queries[q].range.end = queries[q].range.start +
+                             gt_featindexbench_rand(arguments->width - 1);
+    }
+  }
+
+  for (i = 0; i < 2UL; i++) {
+    results[i] = gt_malloc(sizeof (*results[i]) * arguments->queries);
+    for (q = 0; q < arguments->queries; q++)
+      results[i][q] = gt_array_new(sizeof (GtFeatureNode*));
+  }
+  for (i = 0; !had_err && i < 2UL; i++) {
+    gt_timer_start(timer);
+    had_err = gt_featindexbench_run(fi[i], queries, arguments->queries,
+                                    results[i], err);
+    gt_timer_stop(timer);
+    querytime[i] = (double) gt_timer_elapsed_usec(timer) / 1000000.0;
+  }
+
+  /* both indexes must report the same features in the same order */
+  for (q = 0; !had_err && q < arguments->queries; q++) {
+    GtUword j;
+    if (gt_array_size(results[0][q]) != gt_array_size(results[1][q])) {
+      gt_error_set(err, "the implicit interval index reports "GT_WU" instead "
+                   "of "GT_WU" features for query "GT_WU,
+                   gt_array_size(results[1][q]), gt_array_size(results[0][q]),
+                   q);
+      had_err = -1;
+    }
+    for (j = 0; !had_err && j < gt_array_size(results[0][q]); j++) {
+      GtGenomeNode *gn0 = *(GtGenomeNode**) gt_array_get(results[0][q], j),
+                   *gn1 = *(GtGenomeNode**) gt_array_get(results[1][q], j);
+      if (gt_genome_node_compare(&gn0, &gn1) != 0) {
+        gt_error_set(err, "the implicit interval index reports different "
+                     "features for query "GT_WU, q);
+        had_err = -1;
+      }
+    }
+    numofresults += gt_array_size(results[0][q]);
+  }
+
+  if (!had_err) {
+    printf("# "GT_WU" queries of width at most "GT_WU", "GT_WU" results\n",
+           arguments->queries, arguments->width, numofresults);
+    for (i = 0; i < 2UL; i++) {
+      printf("%-8s load %.3f s, queries %.3f s, %.0f queries/s",
+             names[i], loadtime[i], querytime[i],
+             querytime[i] > 0.0 ? (double) arguments->queries / querytime[i]
+                                : 0.0);
+      if (i > 0 && querytime[i] > 0.0)
+        printf(", speedup %.2f", querytime[0] / querytime[i]);
+      printf("\n");
+    }
+  }
+
+  for (i = 0; i < 2UL; i++) {
+    for (q = 0; q < arguments->queries; q++)
+      gt_array_delete(results[i][q]);
+    gt_free(results[i]);
+    gt_feature_index_delete(fi[i]);
+  }
+  gt_timer_delete(timer);
+  gt_free(queries);
+  gt_str_array_delete(seqids);
+  return had_err;
+}
+
+GtTool* gt_featindexbench(void)
+{
+  return gt_tool_new(gt_featindexbench_arguments_new,
+                     gt_featindexbench_arguments_delete,
+                     gt_featindexbench_option_parser_new,
+                     NULL,
+                     gt_featindexbench_runner);
+}
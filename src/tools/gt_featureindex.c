@@ -24,6 +24,7 @@
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/anno_db_schema_api.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_binary_api.h"
 #include "extended/feature_node.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_visitor.h"
@@ -38,6 +39,7 @@
 
 #define GT_SQLITE_BACKEND_STRING "sqlite"
 #define GT_MYSQL_BACKEND_STRING  "mysql"
+#define GT_BINARY_BACKEND_STRING "binary"
 
 typedef struct {
   GtRange qry_rng;
@@ -95,6 +97,7 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
     GT_MYSQL_BACKEND_STRING,
 #endif
+    GT_BINARY_BACKEND_STRING,
     NULL
   };
   gt_assert(arguments);
@@ -126,7 +129,7 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
                                         "|" GT_MYSQL_BACKEND_STRING
 #endif
-                                        "]",
+                                        "|" GT_BINARY_BACKEND_STRING "]",
                                         arguments->backend, backends[0],
                                         backends);
   gt_option_parser_add_option(op, backend_option);
@@ -134,7 +137,7 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
   /* -filename */
   filenameoption = gt_option_new_string("filename",
                                         "filename for feature database "
-                                        "(sqlite backend only)",
+                                        "(sqlite and binary backend only)",
                                         arguments->filename, NULL);
   gt_option_parser_add_option(op, filenameoption);
 
@@ -209,11 +212,15 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
   GtNodeVisitor *gff3visitor = NULL;
   GtGenomeNode *regn = NULL;
   GtUword i = 0;
+  bool binary;
   int had_err = 0;
 
   gt_error_check(err);
   gt_assert(arguments);
 
+  binary = (strcmp(gt_str_get(arguments->backend),
+                   GT_BINARY_BACKEND_STRING) == 0);
+
 #ifdef HAVE_SQLITE
   if (!had_err) {
     if (strcmp(gt_str_get(arguments->backend),
@@ -247,16 +254,19 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
     }
   }
 #endif
-  if (!had_err)
-    adbs = gt_anno_db_gfflike_new();
-
-  if (!had_err && !adbs)
-    had_err = -1;
-
-  if (!had_err) {
-    fi = gt_anno_db_schema_get_feature_index(adbs, rdb, err);
+  if (!had_err && binary) {
+    fi = gt_feature_index_binary_new(gt_str_get(arguments->filename), err);
     had_err = fi ? 0 : -1;
   }
+  else if (!had_err) {
+    adbs = gt_anno_db_gfflike_new();
+    if (!adbs)
+      had_err = -1;
+    if (!had_err) {
+      fi = gt_anno_db_schema_get_feature_index(adbs, rdb, err);
+      had_err = fi ? 0 : -1;
+    }
+  }
 
   if (!had_err && gt_str_length(arguments->seqid) == 0) {
     char *firstseqid = gt_feature_index_get_first_seqid(fi, err);
@@ -289,6 +299,12 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
                                                    gt_str_get(arguments->seqid),
                                                    err);
   }
+  /* output the original sequence region, if the index has one */
+  if (!had_err) {
+    had_err = gt_feature_index_get_orig_range_for_seqid(fi, &rng,
+                                                   gt_str_get(arguments->seqid),
+                                                        err);
+  }
   if (!had_err) {
     regn = gt_region_node_new(arguments->seqid, rng.start, rng.end);
     gt_genome_node_accept(regn, gff3visitor, err);
@@ -316,7 +332,9 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
         }
       }
       gt_genome_node_accept(gn, gff3visitor, err);
-      gt_genome_node_delete(gn);
+      /* the nodes returned by the binary index are owned by the index */
+      if (!binary)
+        gt_genome_node_delete(gn);
     }
   }
 
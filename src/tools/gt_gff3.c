@@ -22,11 +22,13 @@
 #include "core/undef_api.h"
 #include "core/versionfunc.h"
 #include "extended/add_introns_stream_api.h"
+#include "extended/async_stream.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_defines.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gff3_out_stream_api.h"
 #include "extended/gff3_linesorted_out_stream.h"
+#include "extended/gff3_partition_stream_api.h"
 #include "extended/gff3_parser.h"
 #include "extended/gtdatahelp.h"
 #include "extended/load_stream.h"
@@ -51,7 +53,9 @@ typedef struct {
        strict,
        tidy,
        show,
-       fixboundaries;
+       fixboundaries,
+       async,
+       partition;
   GtWord offset;
   GtStr *offsetfile, *newsource;
   GtUword width;
@@ -91,7 +95,9 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   GtOptionParser *op;
   GtOption *sort_option, *load_option, *strict_option, *tidy_option,
            *mergefeat_option, *addintrons_option, *offset_option,
-           *offsetfile_option, *setsource_option, *sortlines_option, *option;
+           *offsetfile_option, *setsource_option, *sortlines_option,
+           *checkids_option, *fixboundaries_option, *partition_option,
+           *option;
   gt_assert(arguments);
 
   /* init */
@@ -136,14 +142,14 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, option);
 
   /* -checkids */
-  option = gt_option_new_bool("checkids",
-                              "make sure the ID attributes are unique "
-                              "within the scope of each GFF3_file, as required "
-                              "by GFF3 specification\n"
-                              "(memory consumption is proportional to the "
-                              "input file size(s))", &arguments->checkids,
-                              false);
-  gt_option_parser_add_option(op, option);
+  checkids_option = gt_option_new_bool("checkids",
+                                       "make sure the ID attributes are unique "
+                                       "within the scope of each GFF3_file, as "
+                                       "required by GFF3 specification\n"
+                                       "(memory consumption is proportional to "
+                                       "the input file size(s))",
+                                       &arguments->checkids, false);
+  gt_option_parser_add_option(op, checkids_option);
 
   /* -addids */
   option = gt_option_new_bool("addids", "add missing \""
@@ -152,12 +158,15 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, option);
 
   /* -fixregionboundaries */
-  option = gt_option_new_bool("fixregionboundaries", "automatically adjust \""
-                              GT_GFF_SEQUENCE_REGION"\" lines to contain all "
-                              "their features (memory consumption is "
-                              "proportional to the input file size(s))",
-                              &arguments->fixboundaries, false);
-  gt_option_parser_add_option(op, option);
+  fixboundaries_option = gt_option_new_bool("fixregionboundaries",
+                                            "automatically adjust \""
+                                            GT_GFF_SEQUENCE_REGION"\" lines to "
+                                            "contain all their features "
+                                            "(memory consumption is "
+                                            "proportional to the input file "
+                                            "size(s))",
+                                            &arguments->fixboundaries, false);
+  gt_option_parser_add_option(op, fixboundaries_option);
 
   /* -mergefeat */
   mergefeat_option = gt_option_new_bool("mergefeat",
@@ -211,6 +220,30 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
                               true);
   gt_option_parser_add_option(op, option);
 
+  /* -async */
+  option = gt_option_new_bool("async", "parse the input, process the features "
+                              "and show the output in separate threads",
+                              &arguments->async, false);
+  gt_option_parser_add_option(op, option);
+
+  /* -partition */
+  partition_option = gt_option_new_bool("partition", "parse and process the "
+                                        "sequence regions of each GFF3_file "
+                                        "in parallel (with the number of "
+                                        "threads given by 'gt -j'), if the "
+                                        "lines of every sequence region are "
+                                        "contiguous and no feature refers to "
+                                        "the ID of another sequence region; "
+                                        "-sort then sorts within each "
+                                        "sequence region (memory "
+                                        "consumption is proportional to the "
+                                        "size of the regions processed at the "
+                                        "same time)", &arguments->partition,
+                                        false);
+  gt_option_parser_add_option(op, partition_option);
+  gt_option_exclude(partition_option, checkids_option);
+  gt_option_exclude(partition_option, fixboundaries_option);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -228,61 +261,38 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   return op;
 }
 
-static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
-                          void *tool_arguments, GtError *err)
+typedef struct {
+  GFF3Arguments *arguments;
+  GtTypeChecker *type_checker;
+  GtXRFChecker *xrf_checker;
+} GFF3ChainInfo;
+
+static int gt_gff3_setup_in_stream(GtNodeStream *gff3_in_stream,
+                                   GFF3ChainInfo *info, GtError *err)
 {
-  GFF3Arguments *arguments = tool_arguments;
-  GtTypeChecker *type_checker = NULL;
-  GtXRFChecker *xrf_checker = NULL;
-  GtNodeStream *gff3_in_stream,
-               *sort_stream = NULL,
-               *load_stream = NULL,
-               *merge_feature_stream = NULL,
-               *add_introns_stream = NULL,
-               *set_source_stream = NULL,
-               *gff3_out_stream = NULL,
-               *last_stream;
+  GFF3Arguments *arguments = info->arguments;
   int had_err = 0;
-
   gt_error_check(err);
-  gt_assert(arguments);
 
-  /* create a gff3 input stream */
-  gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
-                                                  argv + parsed_args);
-  if (arguments->verbose && arguments->outfp)
-    gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
   if (arguments->checkids)
     gt_gff3_in_stream_check_id_attributes((GtGFF3InStream*) gff3_in_stream);
   if (!arguments->addids)
     gt_gff3_in_stream_disable_add_ids(gff3_in_stream);
 
-  last_stream = gff3_in_stream;
-
   /* set different type checker if necessary */
-  if (gt_typecheck_info_option_used(arguments->tci)) {
-    type_checker = gt_typecheck_info_create_type_checker(arguments->tci, err);
-    if (!type_checker)
-      had_err = -1;
-    if (!had_err)
-      gt_gff3_in_stream_set_type_checker(gff3_in_stream, type_checker);
-  }
+  if (info->type_checker)
+    gt_gff3_in_stream_set_type_checker(gff3_in_stream, info->type_checker);
 
   /* set XRF checker if necessary */
-  if (gt_xrfcheck_info_option_used(arguments->xci)) {
-    xrf_checker = gt_xrfcheck_info_create_xrf_checker(arguments->xci, err);
-    if (!xrf_checker)
-      had_err = -1;
-    if (!had_err)
-      gt_gff3_in_stream_set_xrf_checker(gff3_in_stream, xrf_checker);
-  }
+  if (info->xrf_checker)
+    gt_gff3_in_stream_set_xrf_checker(gff3_in_stream, info->xrf_checker);
 
   /* set offset (if necessary) */
-  if (!had_err && arguments->offset != GT_UNDEF_WORD)
+  if (arguments->offset != GT_UNDEF_WORD)
     gt_gff3_in_stream_set_offset(gff3_in_stream, arguments->offset);
 
   /* set offsetfile (if necessary) */
-  if (!had_err && gt_str_length(arguments->offsetfile)) {
+  if (gt_str_length(arguments->offsetfile)) {
     had_err = gt_gff3_in_stream_set_offsetfile(gff3_in_stream,
                                                arguments->offsetfile, err);
   }
@@ -297,38 +307,150 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   if (!had_err && arguments->fixboundaries)
     gt_gff3_in_stream_fix_region_boundaries((GtGFF3InStream*) gff3_in_stream);
 
+  return had_err;
+}
+
+/* returns a new reference to the last stream which processes the nodes of
+   <in_stream>, the features get the source <newsource> (if not empty) */
+static GtNodeStream* gt_gff3_processing_stream_new(GtNodeStream *in_stream,
+                                                   GFF3Arguments *arguments,
+                                                   GtStr *newsource)
+{
+  GtNodeStream *last_stream = gt_node_stream_ref(in_stream), *ns;
+
   /* create load stream (if necessary) */
-  if (!had_err && arguments->load) {
-    load_stream = gt_load_stream_new(last_stream);
-    last_stream = load_stream;
+  if (arguments->load) {
+    ns = gt_load_stream_new(last_stream);
+    gt_node_stream_delete(last_stream);
+    last_stream = ns;
   }
 
   /* create sort stream (if necessary) */
-  if (!had_err && arguments->sort) {
-    sort_stream = gt_sort_stream_new(last_stream);
-    last_stream = sort_stream;
+  if (arguments->sort) {
+    ns = gt_sort_stream_new(last_stream);
+    gt_node_stream_delete(last_stream);
+    last_stream = ns;
   }
 
   /* create merge feature stream (if necessary) */
-  if (!had_err && arguments->mergefeat) {
-    gt_assert(sort_stream);
-    merge_feature_stream = gt_merge_feature_stream_new(sort_stream);
-    last_stream = merge_feature_stream;
+  if (arguments->mergefeat) {
+    gt_assert(arguments->sort);
+    ns = gt_merge_feature_stream_new(last_stream);
+    gt_node_stream_delete(last_stream);
+    last_stream = ns;
   }
 
   /* create addintrons stream (if necessary) */
-  if (!had_err && arguments->addintrons) {
-    gt_assert(last_stream);
-    add_introns_stream = gt_add_introns_stream_new(last_stream);
-    last_stream = add_introns_stream;
+  if (arguments->addintrons) {
+    ns = gt_add_introns_stream_new(last_stream);
+    gt_node_stream_delete(last_stream);
+    last_stream = ns;
   }
 
   /* create setsource stream (if necessary) */
-  if (!had_err && gt_str_length(arguments->newsource) > 0) {
-    gt_assert(last_stream);
-    GtNodeVisitor *ssv = gt_set_source_visitor_new(arguments->newsource);
-    set_source_stream = gt_visitor_stream_new(last_stream, ssv);
-    last_stream = set_source_stream;
+  if (gt_str_length(newsource) > 0) {
+    GtNodeVisitor *ssv = gt_set_source_visitor_new(newsource);
+    ns = gt_visitor_stream_new(last_stream, ssv);
+    gt_node_stream_delete(last_stream);
+    last_stream = ns;
+  }
+
+  return last_stream;
+}
+
+static GtNodeStream* gt_gff3_partition_chain(GtNodeStream *gff3_in_stream,
+                                             void *data, GtError *err)
+{
+  GFF3ChainInfo *info = data;
+  GtNodeStream *last_stream;
+  GtStr *newsource;
+  gt_error_check(err);
+  gt_assert(info);
+  if (gt_gff3_setup_in_stream(gff3_in_stream, info, err))
+    return NULL;
+  /* every feature references its source, the chains run in different threads
+     and must not share the reference count of a string */
+  newsource = gt_str_clone(info->arguments->newsource);
+  last_stream = gt_gff3_processing_stream_new(gff3_in_stream, info->arguments,
+                                              newsource);
+  gt_str_delete(newsource);
+  return last_stream;
+}
+
+static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
+                          void *tool_arguments, GtError *err)
+{
+  GFF3Arguments *arguments = tool_arguments;
+  GFF3ChainInfo info;
+  GtNodeStream *gff3_in_stream = NULL,
+               *parse_async_stream = NULL,
+               *processing_stream = NULL,
+               *output_async_stream = NULL,
+               *gff3_out_stream = NULL,
+               *last_stream = NULL;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  info.arguments = arguments;
+  info.type_checker = NULL;
+  info.xrf_checker = NULL;
+
+  /* create different type checker if necessary */
+  if (gt_typecheck_info_option_used(arguments->tci)) {
+    info.type_checker = gt_typecheck_info_create_type_checker(arguments->tci,
+                                                              err);
+    if (!info.type_checker)
+      had_err = -1;
+  }
+
+  /* create XRF checker if necessary */
+  if (!had_err && gt_xrfcheck_info_option_used(arguments->xci)) {
+    info.xrf_checker = gt_xrfcheck_info_create_xrf_checker(arguments->xci,
+                                                           err);
+    if (!info.xrf_checker)
+      had_err = -1;
+  }
+
+  if (!had_err && arguments->partition) {
+    /* parse and process the sequence regions in parallel */
+    processing_stream = gt_gff3_partition_stream_new(argc - parsed_args,
+                                                     argv + parsed_args,
+                                                     gt_gff3_partition_chain,
+                                                     &info);
+    last_stream = processing_stream;
+  }
+  else if (!had_err) {
+    /* create a gff3 input stream */
+    gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
+                                                    argv + parsed_args);
+    if (arguments->verbose && arguments->outfp)
+      gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
+    had_err = gt_gff3_setup_in_stream(gff3_in_stream, &info, err);
+    last_stream = gff3_in_stream;
+
+    /* parse in a separate thread (if necessary) */
+    if (!had_err && arguments->async) {
+      parse_async_stream = gt_async_stream_new(last_stream,
+                                               GT_ASYNC_STREAM_QUEUESIZE);
+      last_stream = parse_async_stream;
+    }
+
+    if (!had_err) {
+      processing_stream = gt_gff3_processing_stream_new(last_stream,
+                                                        arguments,
+                                                        arguments->newsource);
+      last_stream = processing_stream;
+    }
+  }
+
+  /* process the features in a separate thread (if necessary) */
+  if (!had_err && arguments->async && arguments->show &&
+      last_stream != parse_async_stream) {
+    output_async_stream = gt_async_stream_new(last_stream,
+                                              GT_ASYNC_STREAM_QUEUESIZE);
+    last_stream = output_async_stream;
   }
 
   /* create gff3 output stream */
@@ -360,14 +482,12 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
 
   /* free */
   gt_node_stream_delete(gff3_out_stream);
-  gt_node_stream_delete(sort_stream);
-  gt_node_stream_delete(load_stream);
-  gt_node_stream_delete(merge_feature_stream);
-  gt_node_stream_delete(add_introns_stream);
-  gt_node_stream_delete(set_source_stream);
+  gt_node_stream_delete(output_async_stream);
+  gt_node_stream_delete(processing_stream);
+  gt_node_stream_delete(parse_async_stream);
   gt_node_stream_delete(gff3_in_stream);
-  gt_type_checker_delete(type_checker);
-  gt_xrf_checker_delete(xrf_checker);
+  gt_type_checker_delete(info.type_checker);
+  gt_xrf_checker_delete(info.xrf_checker);
 
   return had_err;
 }
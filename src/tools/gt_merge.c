@@ -19,6 +19,7 @@
 #include "core/option_api.h"
 #include "core/output_file_api.h"
 #include "core/versionfunc.h"
+#include "extended/async_stream.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gff3_out_stream_api.h"
@@ -29,7 +30,8 @@ typedef struct {
   GtOutputFileInfo *ofi;
   GtFile *outfp;
   bool retainids,
-       tidy;
+       tidy,
+       async;
 } MergeArguments;
 
 static void* gt_merge_arguments_new(void)
@@ -71,6 +73,12 @@ static GtOptionParser* gt_merge_option_parser_new(void *tool_arguments)
                               "during parsing", &arguments->tidy, false);
   gt_option_parser_add_option(op, option);
 
+  /* -async */
+  option = gt_option_new_bool("async", "parse each input file in a separate "
+                              "thread ahead of the merging",
+                              &arguments->async, false);
+  gt_option_parser_add_option(op, option);
+
   gt_output_file_info_register_options(arguments->ofi, op, &arguments->outfp);
   return op;
 }
@@ -110,6 +118,18 @@ static int gt_merge_runner(int argc, const char **argv, int parsed_args,
      gt_array_add(genome_streams, gff3_in_stream);
    }
 
+  /* parse each input file in a separate thread, the merge stream still
+     determines the order of the output nodes */
+  if (arguments->async) {
+    for (i = 0; i < gt_array_size(genome_streams); i++) {
+      GtNodeStream **in_stream = gt_array_get(genome_streams, i);
+      GtNodeStream *async_stream = gt_async_stream_new(*in_stream,
+                                                   GT_ASYNC_STREAM_QUEUESIZE);
+      gt_node_stream_delete(*in_stream);
+      *in_stream = async_stream;
+    }
+  }
+
   /* create a merge stream */
   merge_stream = gt_merge_stream_new(genome_streams);
   gt_assert(merge_stream);
@@ -19,11 +19,14 @@
 #include "core/fileutils_api.h"
 #include "core/ma.h"
 #include "core/str_array_api.h"
+#include "core/timer_api.h"
 #include "core/unused_api.h"
 #include "core/xposix.h"
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/bed_in_stream.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_binary_api.h"
+#include "extended/feature_index_memory_api.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gtf_in_stream.h"
@@ -37,6 +40,8 @@
 
 #define GT_SQLITE_BACKEND_STRING "sqlite"
 #define GT_MYSQL_BACKEND_STRING  "mysql"
+#define GT_BINARY_BACKEND_STRING "binary"
+#define GT_MKFEATUREINDEX_BATCHSIZE  100000UL
 
 typedef struct {
   GtStr *backend,
@@ -47,6 +52,7 @@ typedef struct {
         *database,
         *input;
   int port;
+  GtUword batchsize;
   bool verbose,
        force;
 } GtMkfeatureindexArguments;
@@ -88,6 +94,7 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
     GT_MYSQL_BACKEND_STRING,
 #endif
+    GT_BINARY_BACKEND_STRING,
     NULL
   };
   static const char *inputs[] = {
@@ -116,7 +123,10 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
                                         "|" GT_MYSQL_BACKEND_STRING
 #endif
-                                        "]",
+                                        "|" GT_BINARY_BACKEND_STRING "]\n"
+                                        "the binary backend writes a read-only "
+                                        "index file, which is memory mapped "
+                                        "by its readers",
                                         arguments->backend, backends[0],
                                         backends);
   gt_option_parser_add_option(op, backend_option);
@@ -130,10 +140,19 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
   /* -filename */
   filenameoption = gt_option_new_string("filename",
                                         "filename for feature database "
-                                        "(sqlite backend only)",
+                                        "(sqlite and binary backend only)",
                                         arguments->filename, NULL);
   gt_option_parser_add_option(op, filenameoption);
 
+  /* -batchsize */
+  option = gt_option_new_uword("batchsize", "number of rows inserted per "
+                               "transaction, the indexes are built after "
+                               "loading\n0 inserts every row on its own and "
+                               "maintains the indexes while loading",
+                               &arguments->batchsize,
+                               GT_MKFEATUREINDEX_BATCHSIZE);
+  gt_option_parser_add_option(op, option);
+
 #ifdef HAVE_MYSQL
   /* -host */
   option = gt_option_new_string("host", "hostname for database connection",
@@ -190,33 +209,39 @@ static int gt_mkfeatureindex_runner(int argc,
   GtRDB *rdb = NULL;
   GtAnnoDBSchema *adb = NULL;
   GtFeatureIndex *fis = NULL;
+  GtTimer *timer = NULL;
+  double elapsed;
+  bool binary;
   int had_err = 0;
 
   gt_error_check(err);
   gt_assert(arguments);
 
-#ifdef HAVE_SQLITE
-  if (strcmp(gt_str_get(arguments->backend),
-             GT_SQLITE_BACKEND_STRING) == 0) {
-    if (gt_file_exists(gt_str_get(arguments->filename))) {
-      if (arguments->force) {
-        gt_xunlink(gt_str_get(arguments->filename));
-      } else {
-        gt_error_set(err, "file \"%s\" exists already. use option -force to "
-                     "overwrite", gt_str_get(arguments->filename));
-        had_err = -1;
-      }
-    }
-    if (!had_err) {
-      rdb = gt_rdb_sqlite_new(gt_str_get(arguments->filename), err);
-      if (!rdb)
-        had_err = -1;
+  binary = (strcmp(gt_str_get(arguments->backend),
+                   GT_BINARY_BACKEND_STRING) == 0);
+  if ((binary || strcmp(gt_str_get(arguments->backend),
+                        GT_SQLITE_BACKEND_STRING) == 0) &&
+      gt_file_exists(gt_str_get(arguments->filename))) {
+    if (arguments->force) {
+      gt_xunlink(gt_str_get(arguments->filename));
+    } else {
+      gt_error_set(err, "file \"%s\" exists already. use option -force to "
+                   "overwrite", gt_str_get(arguments->filename));
+      had_err = -1;
     }
   }
+
+#ifdef HAVE_SQLITE
+  if (!had_err && strcmp(gt_str_get(arguments->backend),
+                         GT_SQLITE_BACKEND_STRING) == 0) {
+    rdb = gt_rdb_sqlite_new(gt_str_get(arguments->filename), err);
+    if (!rdb)
+      had_err = -1;
+  }
 #endif
 #ifdef HAVE_MYSQL
-  if (strcmp(gt_str_get(arguments->backend),
-                    GT_MYSQL_BACKEND_STRING) == 0) {
+  if (!had_err && strcmp(gt_str_get(arguments->backend),
+                         GT_MYSQL_BACKEND_STRING) == 0) {
     arguments->pass = gt_get_password("password: ", err);
     rdb = gt_rdb_mysql_new(gt_str_get(arguments->host),
                            arguments->port,
@@ -229,16 +254,26 @@ static int gt_mkfeatureindex_runner(int argc,
   }
 #endif
 
-  adb = gt_anno_db_gfflike_new();
-  if (!had_err && !adb)
-    had_err = -1;
-
-  if (!had_err) {
+  /* the binary index is built in memory and written at the end */
+  if (!had_err && binary)
+    fis = gt_feature_index_memory_new_implicit();
+  else if (!had_err) {
+    adb = gt_anno_db_gfflike_new();
     fis = gt_anno_db_schema_get_feature_index(adb, rdb, err);
     if (!fis)
       had_err = -1;
   }
 
+  if (!had_err) {
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+    if (!binary && arguments->batchsize > 0) {
+      had_err = gt_feature_index_gfflike_bulk_load_begin(fis,
+                                                         arguments->batchsize,
+                                                         err);
+    }
+  }
+
   if (!had_err) {
     if (strcmp(gt_str_get(arguments->input), "gff") == 0)
     {
@@ -263,7 +298,32 @@ static int gt_mkfeatureindex_runner(int argc,
 
     feature_stream = gt_feature_stream_new(in_stream, fis);
     had_err = gt_node_stream_pull(feature_stream, err);
+    if (binary) {
+      if (!had_err)
+        had_err = gt_feature_index_binary_write(fis,
+                                                gt_str_get(arguments->filename),
+                                                err);
+    }
+    /* keep the rows loaded before an error, like the row-wise insertion */
+    else if (arguments->batchsize > 0) {
+      if (had_err)
+        (void) gt_feature_index_gfflike_bulk_load_end(fis, NULL);
+      else
+        had_err = gt_feature_index_gfflike_bulk_load_end(fis, err);
+    }
+  }
+  if (!had_err && !binary && arguments->verbose) {
+    gt_timer_stop(timer);
+    elapsed = (double) gt_timer_elapsed_usec(timer) / 1000000.0;
+    printf("# inserted "GT_WU" rows in %.2fs",
+           gt_feature_index_gfflike_num_of_rows(fis), elapsed);
+    if (elapsed > 0.0) {
+      printf(" (%.0f rows/s)",
+             (double) gt_feature_index_gfflike_num_of_rows(fis) / elapsed);
+    }
+    printf("\n");
   }
+  gt_timer_delete(timer);
   gt_node_stream_delete(feature_stream);
   gt_node_stream_delete(in_stream);
   gt_feature_index_delete(fis);
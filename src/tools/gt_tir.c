@@ -25,8 +25,9 @@
 #include "extended/feature_type.h"
 #include "extended/gff3_out_stream_api.h"
 #include "extended/tir_stream.h"
-#include "extended/visitor_stream.h"
   /* XXX */
+#include "ltr/ltrdigest_def.h"
+#include "ltr/ltrdigest_pdom_stream.h"
 #include "ltr/ltrdigest_pdom_visitor.h"
 #include "ltr/pdom_model_set.h"
 #include "match/xdrop.h"
@@ -401,7 +402,9 @@ static int gt_tir_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
       if (pdom_v == NULL)
         had_err = -1;
       if (!had_err) {
-        last_stream = pdom_stream = gt_visitor_stream_new(last_stream, pdom_v);
+        last_stream = pdom_stream = gt_ltrdigest_pdom_stream_new(last_stream,
+                                                   pdom_v,
+                                                   GT_LTRDIGEST_PDOM_BATCHSIZE);
         gt_ltrdigest_pdom_visitor_set_root_type((GtLTRdigestPdomVisitor*)
                                                                         pdom_v,
                                         gt_ft_terminal_inverted_repeat_element);
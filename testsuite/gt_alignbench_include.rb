@@ -0,0 +1,30 @@
+["local", "global"].each do |mode|
+  Name "gt alignbench #{mode}"
+  Keywords "gt_alignbench"
+  Test do
+    [[1, 1], [7, 100], [61, 80], [1000, 999]].each do |len|
+      run "#{$bin}gt dev alignbench -mode #{mode} -ulen #{len[0]} " +
+          "-vlen #{len[1]} -runs 2"
+    end
+    run "#{$bin}gt dev alignbench -mode #{mode} -ulen 20000 -vlen 300 " +
+        "-runs 2 -baseline no"
+  end
+end
+
+Name "gt alignbench global baseline"
+Keywords "gt_alignbench"
+Test do
+  run "#{$bin}gt dev alignbench -mode global -ulen 300 -vlen 200 -runs 1"
+  grep last_stdout, /^affinealign +score/
+  grep last_stdout, /^sse2 +score/ if File.exist?("/proc/cpuinfo") and
+                                      File.read("/proc/cpuinfo") =~ /\bsse2\b/
+end
+
+Name "gt alignbench saturating scores"
+Keywords "gt_alignbench"
+Test do
+  run "#{$bin}gt dev alignbench -mode global -ulen 40000 -vlen 40 -runs 1 " +
+      "-baseline no"
+  grep last_stdout, /^scalar \(for sse2\) +score/ if
+    File.exist?("/proc/cpuinfo") and File.read("/proc/cpuinfo") =~ /\bsse2\b/
+end
@@ -9,6 +9,17 @@
   end
 end
 
+1.upto(14) do |i|
+  Name "gt cds test #{i} (-j 4)"
+  Keywords "gt_cds threads"
+  Test do
+    run_test "#{$bin}gt -j 4 cds -minorflen 1 -startcodon yes " +
+             "-seqfile #{$testdata}gt_cds_test_#{i}.fas -matchdesc " +
+             "#{$testdata}gt_cds_test_#{i}.in"
+    run "diff #{last_stdout} #{$testdata}gt_cds_test_#{i}.out"
+  end
+end
+
 Name "gt cds error message"
 Keywords "gt_cds"
 Test do
@@ -17,6 +28,14 @@ Test do
   grep last_stderr, "Has the sequence-region to sequence mapping been defined correctly"
 end
 
+Name "gt cds error message (-j 4)"
+Keywords "gt_cds threads"
+Test do
+  run "#{$bin}gt gff3 -offset 1000 #{$testdata}gt_cds_test_1.in | " +
+      "#{$bin}gt -j 4 cds -matchdesc -seqfile #{$testdata}gt_cds_test_1.fas -", :retval => 1
+  grep last_stderr, "Has the sequence-region to sequence mapping been defined correctly"
+end
+
 1.upto(14) do |i|
   Name "gt cds test #{i} (-usedesc)"
   Keywords "gt_cds usedesc"
@@ -109,6 +128,16 @@ Test do
   run      "diff #{last_stdout} #{$testdata}U89959_cds.gff3"
 end
 
+Name "gt cds test (U89959, -j 4, new sequence index)"
+Keywords "gt_cds threads"
+Test do
+  # the index of the sequence file is created while the workers run
+  run "cp #{$testdata}U89959_genomic.fas ."
+  run_test "#{$bin}gt -j 4 cds -seqfile U89959_genomic.fas " +
+           "-matchdesc #{$testdata}U89959_csas.gff3"
+  run      "diff #{last_stdout} #{$testdata}U89959_cds.gff3"
+end
+
 Name "gt cds test (not sorted)"
 Keywords "gt_cds"
 Test do
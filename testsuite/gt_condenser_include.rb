@@ -74,6 +74,28 @@ opt_arr.each do |opt|
   end
 end
 
+opt_arr.each do |opt|
+  Name "gt condenser compress multithreaded #{opt}"
+  Keywords "gt_condenser compress threads"
+  Test do
+    files.each_pair do |file, info|
+      basename = File.basename(file)
+      run_test "#{$bin}gt encseq encode -clipdesc -indexname #{basename} " \
+        "-md5 no " \
+        "#{file}"
+      [1, 3].each do |jobs|
+        run_test "#{$bin}gt -j #{jobs} condenser compress #{opt} " \
+          "-indexname #{basename}_nr_j#{jobs} " \
+          "-alignlength #{info[0]} #{basename}",
+          :maxtime => 600
+      end
+      ["al1", "fas", "nre", "ssp"].each do |suffix|
+        run "cmp #{basename}_nr_j1.#{suffix} #{basename}_nr_j3.#{suffix}"
+      end
+    end
+  end
+end
+
 makeblastdb = system("which makeblastdb")
 if makeblastdb
   makeblastdb = $?
@@ -129,6 +151,75 @@ opt_arr.each do |opt|
   end
 end
 
+Name "gt condenser compress + native search"
+Keywords "gt_condenser compress search native"
+Test do
+  searchfiles.each_pair do |file, info|
+    basename = File.basename(file)
+    queries = File.join(File.dirname(file), File.basename(file,'.fas')) +
+      "_queries_300_2x"
+    run_test "#{$bin}gt encseq encode -clipdesc -indexname #{basename} " \
+      "-md5 no " \
+      "#{file}"
+    run_test "#{$bin}gt condenser compress " \
+      "-indexname #{basename}_nr " \
+      "-alignlength #{info[0]} #{basename}",
+      :maxtime => 600
+    run_test "#{$bin}gt -debug condenser search " \
+      "-native " \
+      "-query #{queries}.fas " \
+      "-db #{basename}_nr > #{basename}_native_hits",
+      :maxtime => 600
+    grep(last_stderr, /debug: [1-9]+[0-9]* hits found/)
+    run_ruby "#$scriptsdir/condenser_statistics.rb " \
+      "#{queries}_blastn_result #{basename}_native_hits"
+    grep(last_stdout, /^## FN: 0$/)
+    grep(last_stdout, /^## TP: [1-9]+[0-9]*$/)
+    run_test "#{$bin}gt -j 3 condenser search " \
+      "-native " \
+      "-query #{queries}.fas " \
+      "-db #{basename}_nr",
+      :maxtime => 600
+    run "diff #{last_stdout} #{basename}_native_hits"
+    run_test "#{$bin}gt condenser search " \
+      "-native -seed 0110 " \
+      "-query #{queries}.fas " \
+      "-db #{basename}_nr",
+      :retval => 1
+    grep(last_stderr, /illegal seed pattern/)
+  end
+end
+
+Name "gt condenser compress + native search (protein)"
+Keywords "gt_condenser compress search native"
+Test do
+  # queries are fragments of the db sequences with every ninth residue
+  # replaced, to be found by the ungapped BLOSUM62 extension
+  rand = Random.new(3)
+  aminoacids = "ARNDCQEGHILKMFPSTWYV"
+  seqs = File.read("#$testdata/trembl.faa").split(/^>.*\n/).reject do |s|
+    s.empty?
+  end
+  File.open("queries.fas", "w") do |f|
+    seqs.map {|s| s.delete("\n")}.each_with_index do |seq, i|
+      frag = seq[10, 120]
+      0.step(frag.length - 1, 9) do |j|
+        frag[j] = aminoacids[rand.rand(aminoacids.length)]
+      end
+      f.puts ">q#{i}", frag
+    end
+  end
+  run_test "#{$bin}gt encseq encode -clipdesc -indexname trembl -md5 no " \
+    "-protein #$testdata/trembl.faa"
+  run_test "#{$bin}gt condenser compress -indexname trembl_nr " \
+    "-alignlength 30 trembl"
+  run_test "#{$bin}gt -debug condenser search -native -query queries.fas " \
+    "-db trembl_nr"
+  grep(last_stderr, /debug: 4 hits found/)
+  grep(last_stdout, /^q0\ttr\|A4GIW6\|A4GIW6_9CREN\t/)
+  grep(last_stdout, /^q1\ttr\|A4GIW7\|A4GIW7_9CREN\t/)
+end
+
 range_ext = Proc.new do |file, info, opt|
   basename = File.basename(file)
   run_test "#{$bin}gt encseq encode -clipdesc -indexname #{basename} " \
@@ -0,0 +1,18 @@
+Name "gt dupfeat test"
+Keywords "gt_dupfeat"
+Test do
+  run_test "#{$bin}gt dupfeat -dest CDS -source exon " +
+           "#{$testdata}U89959_csas.gff3"
+  grep last_stdout, /\tCDS\t1074\t1171\t/
+end
+
+Name "gt dupfeat test (-j 4)"
+Keywords "gt_dupfeat threads"
+Test do
+  run_test "#{$bin}gt -j 1 dupfeat -dest CDS -source exon " +
+           "#{$testdata}U89959_csas.gff3"
+  run "mv #{last_stdout} serial.gff3"
+  run_test "#{$bin}gt -j 4 dupfeat -dest CDS -source exon " +
+           "#{$testdata}U89959_csas.gff3"
+  run "diff #{last_stdout} serial.gff3"
+end
@@ -0,0 +1,17 @@
+["eden.gff3", "standard_gene_as_tree.gff3", "encode_known_genes_Mar07.gff3"].each do |file|
+  Name "gt featindexbench #{file}"
+  Keywords "gt_featindexbench"
+  Test do
+    [1, 100, 100000].each do |width|
+      run "#{$bin}gt dev featindexbench -queries 500 -width #{width} " +
+          "#{$testdata}#{file}"
+    end
+  end
+end
+
+Name "gt featindexbench empty file"
+Keywords "gt_featindexbench"
+Test do
+  run "#{$bin}gt dev featindexbench #{$testdata}header.gff3", :retval => 1
+  grep last_stderr, "does not contain any features"
+end
@@ -65,4 +65,86 @@ if not $arguments["nordb"] then
     end
   end
 
+  FEATUREINDEX_TEST_FILES.each do |file|
+    Name "gt featureindex bulk vs. row-wise load (#{File.basename(file)})"
+    Keywords "gt_featureindex"
+    Test do
+      run "#{$bin}gt seqids #{file}"
+      seqids = File.open(last_stdout).readlines
+      run "#{$bin}gt mkfeatureindex -batchsize 0 -filename rows.db #{file}",
+          :maxtime => 1200
+      run "#{$bin}gt mkfeatureindex -batchsize 10 -v -filename bulk.db #{file}",
+          :maxtime => 1200
+      grep(last_stdout, /inserted \d+ rows/)
+      seqids.each do |seqid|
+        seqid.chomp!
+        ["", "-range 1 1000", "-range 1000 50000000"].each do |rng|
+          run "#{$bin}gt featureindex -seqid #{seqid} #{rng} " +
+              "-filename rows.db > rows.gff3"
+          run "#{$bin}gt featureindex -seqid #{seqid} #{rng} " +
+              "-filename bulk.db > bulk.gff3"
+          run "diff rows.gff3 bulk.gff3"
+        end
+      end
+    end
+  end
+
+end
+
+BINARY_FEATUREINDEX_TEST_FILES = ["#{$testdata}/eden.gff3",
+                                  "#{$testdata}/standard_gene_as_tree.gff3",
+                                  "#{$testdata}/encode_known_genes_Mar07.gff3"]
+
+BINARY_FEATUREINDEX_TEST_FILES.each do |file|
+  Name "gt featureindex binary vs. parser (#{File.basename(file)})"
+  Keywords "gt_featureindex binary"
+  Test do
+    run "#{$bin}gt seqids #{file}"
+    seqids = File.open(last_stdout).readlines
+    run "#{$bin}gt mkfeatureindex -backend binary -filename tmp.idx #{file}"
+    seqids.each do |seqid|
+      seqid.chomp!
+      run "#{$bin}gt featureindex -backend binary -seqid #{seqid} " +
+          "-retain no -filename tmp.idx > out.gff3"
+      run "#{$bin}gt gff3 -retainids no #{file} | " +
+          "#{$bin}gt select -seqid #{seqid}"
+      run "diff out.gff3 #{last_stdout}"
+    end
+  end
+end
+
+Name "gt featureindex binary (existing file)"
+Keywords "gt_featureindex binary"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend binary -filename tmp.idx " +
+      "#{$testdata}/eden.gff3"
+  run "#{$bin}gt mkfeatureindex -backend binary -filename tmp.idx " +
+      "#{$testdata}/eden.gff3", :retval => 1
+  grep(last_stderr, /exists already/)
+  run "#{$bin}gt mkfeatureindex -force -backend binary -filename tmp.idx " +
+      "#{$testdata}/eden.gff3"
+end
+
+Name "gt featureindex binary (invalid sequence ID)"
+Keywords "gt_featureindex binary"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend binary -filename tmp.idx " +
+      "#{$testdata}/eden.gff3"
+  run "#{$bin}gt featureindex -backend binary -seqid foo -filename tmp.idx " +
+      "-range 1 1000", :retval => 1
+  grep(last_stderr, /does not contain the given sequence id/)
+  run "#{$bin}gt featureindex -backend binary -seqid foo -filename tmp.idx",
+      :retval => 1
+  grep(last_stderr, /sequence region 'foo' does not exist/)
+end
+
+Name "gt featureindex binary (corrupt file)"
+Keywords "gt_featureindex binary"
+Test do
+  File.open("corrupt.idx", "w") do |file|
+    file.write("sdfnhsnl")
+  end
+  run "#{$bin}gt featureindex -backend binary -filename corrupt.idx",
+      :retval => 1
+  grep(last_stderr, /not a binary feature index/)
 end
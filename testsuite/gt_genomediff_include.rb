@@ -379,3 +379,29 @@ Test do
     failtest("different results pck-esa #{result[0]},#{result[1]}")
   end
 end
+
+def check_genomediff_threads(files)
+  ["esa", "pck"].each do |indextype|
+    if indextype == "esa"
+      test_esa(files, "", "")
+    else
+      test_pck(files, "", "")
+    end
+    run "mv #{last_stdout} genomediff.seq"
+    run_test "#{$bin}gt -j 3 genomediff -indextype #{indextype} #{indextype}"
+    run "cmp -s genomediff.seq #{last_stdout}"
+  end
+end
+
+Name "gt genomediff multithreaded"
+Keywords "gt_genomediff esa pck threads"
+Test do
+  realfiles = ""
+  (allfiles + bigfiles).each do |file|
+    realfiles += "#{$testdata}"+ file + " "
+  end
+  check_genomediff_threads(realfiles)
+  smallfilecodes.each do |code|
+    check_genomediff_threads("#{code}*.fas")
+  end
+end
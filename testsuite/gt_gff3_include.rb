@@ -316,6 +316,84 @@ Test do
   run "diff #{last_stdout} #{$testdata}addintrons.out"
 end
 
+Name "gt gff3 test option -async"
+Keywords "gt_gff3 async"
+Test do
+  run_test "#{$bin}gt gff3 -async -addintrons #{$testdata}addintrons.gff3"
+  run "diff #{last_stdout} #{$testdata}addintrons.out"
+  run "env LC_ALL=C #{$bin}gt gff3 -async -sort #{$testdata}gt_gff3_prob_2.in"
+  run "diff #{last_stdout} #{$testdata}gt_gff3_prob_2.out"
+  run_test "#{$bin}gt gff3 -retainids -sort " +
+           "#{$testdata}encode_known_genes_Mar07.gff3 > sync.gff3"
+  run_test "#{$bin}gt gff3 -async -retainids -sort " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} sync.gff3"
+end
+
+Name "gt gff3 test option -async (parse error)"
+Keywords "gt_gff3 async"
+Test do
+  run_test("#{$bin}gt gff3 #{$testdata}gt_gff3_prob_1.gff3 2> sync.err",
+           :retval => 1)
+  run_test("#{$bin}gt gff3 -async -sort #{$testdata}gt_gff3_prob_1.gff3",
+           :retval => 1)
+  run "diff #{last_stderr} sync.err"
+end
+
+Name "gt gff3 test option -partition"
+Keywords "gt_gff3 partition"
+Test do
+  ["encode_known_genes_Mar07.gff3", "gt_extractfeat_phase.gff3",
+   "merge_with_seq.gff3"].each do |file|
+    ["", "-sort", "-tidy -retainids", "-addintrons"].each do |opts|
+      run_test "#{$bin}gt gff3 #{opts} #{$testdata}#{file} > sync.gff3"
+      run_test "#{$bin}gt -j 3 gff3 -partition #{opts} #{$testdata}#{file}"
+      run "diff #{last_stdout} sync.gff3"
+    end
+  end
+  run_test "#{$bin}gt gff3 #{$testdata}encode_known_genes_Mar07.gff3 " +
+           "#{$testdata}gt_extractfeat_phase.gff3 > sync.gff3"
+  run_test "#{$bin}gt -j 2 gff3 -partition -async " +
+           "#{$testdata}encode_known_genes_Mar07.gff3 " +
+           "#{$testdata}gt_extractfeat_phase.gff3"
+  run "diff #{last_stdout} sync.gff3"
+end
+
+Name "gt gff3 test option -partition (parse error)"
+Keywords "gt_gff3 partition"
+Test do
+  run_test("#{$bin}gt gff3 #{$testdata}corrupt.gff3 2> sync.err",
+           :retval => 1)
+  run_test("#{$bin}gt -j 3 gff3 -partition #{$testdata}corrupt.gff3",
+           :retval => 1)
+  run "diff #{last_stderr} sync.err"
+  run_test("#{$bin}gt gff3 -partition -checkids " +
+           "#{$testdata}encode_known_genes_Mar07.gff3", :retval => 1)
+  grep last_stderr, "exclude each other"
+end
+
+Name "gt gff3 test option -partition (ID of another region)"
+Keywords "gt_gff3 partition"
+Test do
+  ["multi_feature_different_sequence_id.gff3",
+   "gt_gff3_partition_parent.gff3"].each do |file|
+    run_test("#{$bin}gt gff3 #{$testdata}#{file} 2> sync.err", :retval => 1)
+    run_test("#{$bin}gt -j 2 gff3 -partition #{$testdata}#{file}",
+             :retval => 1)
+    run "diff #{last_stderr} sync.err"
+  end
+end
+
+Name "gt gff3 test option -partition -setsource"
+Keywords "gt_gff3 partition"
+Test do
+  run_test "#{$bin}gt gff3 -setsource GFF3spec -mergefeat -sort " +
+           "#{$testdata}encode_known_genes_Mar07.gff3 > sync.gff3"
+  run_test "#{$bin}gt -j 4 gff3 -partition -setsource GFF3spec -mergefeat " +
+           "-sort #{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} sync.gff3"
+end
+
 Name "gt gff3 test option -setsource"
 Keywords "gt_gff3"
 Test do
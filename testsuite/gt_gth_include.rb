@@ -0,0 +1,95 @@
+Name "gt dev gth (-j 1 and -j 4 produce the same output)"
+Keywords "gt_gth"
+Test do
+  run "cp #{$testdata}/U89959_genomic.fas #{$testdata}/U89959_ests.fas ."
+  run "#{$bin}gt -j 1 dev gth -genomic U89959_genomic.fas " +
+      "-cdna U89959_ests.fas -gff3out -skipalignmentout"
+  run "cp #{last_stdout} j1.gff3"
+  run "#{$bin}gt -j 4 dev gth -genomic U89959_genomic.fas " +
+      "-cdna U89959_ests.fas -gff3out -skipalignmentout"
+  run "cp #{last_stdout} j4.gff3"
+  run "diff j1.gff3 j4.gff3"
+  grep "j1.gff3", /five_prime_cis_splice_site/
+end
+
+Name "gt dev gth (-j 1 and -j 3 produce the same output with -first)"
+Keywords "gt_gth"
+Test do
+  run "cp #{$testdata}/U89959_genomic.fas #{$testdata}/U89959_ests.fas ."
+  run "#{$bin}gt -j 1 dev gth -genomic U89959_genomic.fas " +
+      "-cdna U89959_ests.fas -gff3out -skipalignmentout -first 5"
+  run "cp #{last_stdout} j1.gff3"
+  run "#{$bin}gt -j 3 dev gth -genomic U89959_genomic.fas " +
+      "-cdna U89959_ests.fas -gff3out -skipalignmentout -first 5"
+  run "cp #{last_stdout} j3.gff3"
+  run "diff j1.gff3 j3.gff3"
+end
+
+Name "gt dev gth (protein file)"
+Keywords "gt_gth"
+Test do
+  run "cp #{$testdata}/U89959_genomic.fas #{$testdata}/U89959_ests.fas ."
+  run "#{$bin}gt dev gth -genomic U89959_genomic.fas " +
+      "-protein U89959_ests.fas", :retval => 1
+  grep last_stderr, /protein reference files are not supported/
+end
+
+Name "gt dev gth (unusable sequence index)"
+Keywords "gt_gth"
+Test do
+  run "cp #{$testdata}/U89959_genomic.fas #{$testdata}/U89959_ests.fas ."
+  run "#{$bin}gt dev gth -genomic U89959_genomic.fas " +
+      "-cdna U89959_ests.fas -gff3out -skipalignmentout"
+  run "echo invalid > U89959_ests.fas.dna.esq"
+  run "#{$bin}gt dev gth -genomic U89959_genomic.fas " +
+      "-cdna U89959_ests.fas -gff3out -skipalignmentout", :retval => 1
+  grep last_stderr, /U89959_ests.fas.dna.esq/
+end
+
+Name "gt dev gth (cached seed index)"
+Keywords "gt_gth"
+Test do
+  run "cp #{$testdata}/U89959_genomic.fas #{$testdata}/U89959_ests.fas ."
+  run "#{$bin}gt dev gth -genomic U89959_genomic.fas " +
+      "-cdna U89959_ests.fas -gff3out -skipalignmentout"
+  run "cp #{last_stdout} computed.gff3"
+  run "test -s U89959_genomic.fas.dna.sdx"
+  run "#{$bin}gt dev gth -genomic U89959_genomic.fas " +
+      "-cdna U89959_ests.fas -gff3out -skipalignmentout"
+  run "diff #{last_stdout} computed.gff3"
+end
+
+# writes a random genomic sequence of 30000 bp and a cDNA which consists of
+# two of its exons, separated by an intron of almost 20000 bp
+def gth_write_long_intron_files
+  rng = Random.new(7)
+  gen = (0...30000).map { "acgt"[rng.rand(4)] }.join
+  gen[5300, 2] = "gt"
+  gen[24998, 2] = "ag"
+  [["gen.fas", ">gen", gen],
+   ["cdna.fas", ">cdna", gen[5000, 300] + gen[25000, 300]]].each do |f|
+    File.open(f[0], "w") do |fp|
+      fp.puts f[1]
+      fp.puts f[2].scan(/.{1,60}/)
+    end
+  end
+end
+
+Name "gt dev gth (DP resumed from checkpoints equals complete DP)"
+Keywords "gt_gth"
+Test do
+  gth_write_long_intron_files
+  run "#{$bin}gt dev gth -genomic gen.fas -cdna cdna.fas -gff3out " +
+      "-skipalignmentout"
+  run "cp #{last_stdout} complete.gff3"
+  grep "complete.gff3", /three_prime_cis_splice_site\t24999\t25000/
+  # the backtrace table of about 6 MB does not fit into 1 MB, so only the
+  # checkpoints are kept and the DP is resumed from them during the backtrace
+  run "#{$bin}gt dev gth -genomic gen.fas -cdna cdna.fas -gff3out " +
+      "-skipalignmentout -dpmaxmatrixsize 1"
+  run "diff #{last_stdout} complete.gff3"
+  run "#{$bin}gt dev gth -genomic gen.fas -cdna cdna.fas -dpmaxmatrixsize 1"
+  grep last_stdout, /have been computed with checkpoints/
+  run "#{$bin}gt dev gth -genomic gen.fas -cdna cdna.fas"
+  grep last_stdout, /computed with checkpoints/, true
+end
@@ -0,0 +1,59 @@
+# writes <n> two-exon genes with distinct GT-AG introns on the sequence of
+# <seqfile> (with ID <seqid>) to <gff3file>
+def gthbssmtrain_write_genes(n, seqfile, seqid, gff3file)
+  seq = File.readlines(seqfile).drop(1).map(&:strip).join.downcase
+  rand = Random.new(5)
+  genes = []
+  n.times do
+    donor = seq.index("gt", 300 + rand.rand(seq.length - 2000))
+    acceptor = seq.index("ag", donor + 60 + rand.rand(400)) + 1
+    genes.push([donor - 50 - rand.rand(150), donor - 1, acceptor + 1,
+                acceptor + 50 + rand.rand(150)])
+  end
+  File.open(gff3file, "w") do |f|
+    f.puts "##gff-version 3"
+    f.puts "##sequence-region #{seqid} 1 #{seq.length}"
+    genes.sort.each_with_index do |(s, d, a, e), i|
+      phase = (3 - (d - s + 1) % 3) % 3
+      f.puts "#{seqid}\t.\tgene\t#{s + 1}\t#{e + 1}\t.\t+\t.\tID=gene#{i}"
+      f.puts "#{seqid}\t.\tmRNA\t#{s + 1}\t#{e + 1}\t.\t+\t.\t" +
+             "ID=mRNA#{i};Parent=gene#{i}"
+      [[s, d, 0], [a, e, phase]].each do |from, to, p|
+        f.puts "#{seqid}\t.\texon\t#{from + 1}\t#{to + 1}\t.\t+\t.\t" +
+               "Parent=mRNA#{i}"
+        f.puts "#{seqid}\t.\tCDS\t#{from + 1}\t#{to + 1}\t.\t+\t#{p}\t" +
+               "Parent=mRNA#{i}"
+      end
+    end
+  end
+end
+
+Name "gt dev gthbssmtrain -j 1 and -j 4 (U89959)"
+Keywords "gt_gthbssmtrain threads"
+Test do
+  run "cp #{$testdata}U89959_genomic.fas ."
+  [1, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} dev gthbssmtrain -seqfile " +
+             "U89959_genomic.fas -matchdesc -seed 4711 -outdir j#{jobs} " +
+             "#{$testdata}U89959_cds.gff3"
+  end
+  grep "j1/GT_donor/T1", /^>/
+  run "diff -r -x gthbssmtrain.run j1 j4"
+end
+
+Name "gt dev gthbssmtrain -j 1 and -j 4 (1500 introns)"
+Keywords "gt_gthbssmtrain threads"
+Test do
+  run "cp #{$testdata}U89959_genomic.fas ."
+  # more introns and exons per phase than fit into one block of the threads
+  gthbssmtrain_write_genes(1500, "U89959_genomic.fas", "U89959", "genes.gff3")
+  run_test "#{$bin}gt gff3 -sort -retainids genes.gff3"
+  run "mv #{last_stdout} sorted.gff3"
+  [1, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} dev gthbssmtrain -seqfile " +
+             "U89959_genomic.fas -matchdesc -seed 4711 -outdir j#{jobs} " +
+             "sorted.gff3"
+  end
+  grep last_stdout, /gt-ag: 100.00% \(n=1500\)/
+  run "diff -r -x gthbssmtrain.run j1 j4"
+end
@@ -0,0 +1,19 @@
+Name "gt dev gthdpbench"
+Keywords "gt_gthdpbench"
+Test do
+  [[3, 1, 1], [7, 100, 2], [600, 250, 80]].each do |len|
+    run "#{$bin}gt dev gthdpbench -genlen #{len[0]} -cdnalen #{len[1]} " +
+        "-proteinlen #{len[2]} -runs 2"
+    grep last_stdout, /^DNA +#{len[0]} x #{len[1]} cells, 2 runs, .* MCUPS$/
+    grep last_stdout, /^protein +#{len[0]} x #{len[2]} cells, 2 runs, .* MCUPS$/
+  end
+  run "#{$bin}gt dev gthdpbench -model protein -runs 1"
+  grep last_stdout, /^DNA/, true
+end
+
+Name "gt dev gthdpbench (too short genomic sequence)"
+Keywords "gt_gthdpbench"
+Test do
+  run "#{$bin}gt dev gthdpbench -genlen 2", :retval => 1
+  grep last_stderr, /-genlen/
+end
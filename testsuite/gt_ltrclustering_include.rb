@@ -0,0 +1,75 @@
+Name "gt ltrclustering -simcache without native matcher"
+Keywords "gt_ltrclustering"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname lc #{$testdata}ltrclustering.fas"
+  run_test "#{$bin}gt ltrclustering -simcache sim.txt -psmall 80 -plarge 80 " +
+           "lc #{$testdata}ltrclustering.gff3", :retval => 1
+  grep last_stderr, /requires option -matcher native/
+end
+
+Name "gt ltrclustering native matcher"
+Keywords "gt_ltrclustering"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname lc #{$testdata}ltrclustering.fas"
+  run_test "#{$bin}gt ltrclustering -matcher native -psmall 80 -plarge 80 " +
+           "lc #{$testdata}ltrclustering.gff3"
+  run "diff #{last_stdout} #{$testdata}ltrclustering_native.gff3"
+end
+
+Name "gt ltrclustering native matcher (multithreaded)"
+Keywords "gt_ltrclustering"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname lc #{$testdata}ltrclustering.fas"
+  run_test "#{$bin}gt -j 4 ltrclustering -matcher native -psmall 80 " +
+           "-plarge 80 lc #{$testdata}ltrclustering.gff3"
+  run "diff #{last_stdout} #{$testdata}ltrclustering_native.gff3"
+end
+
+Name "gt ltrclustering native matcher (similarity cache)"
+Keywords "gt_ltrclustering"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname lc #{$testdata}ltrclustering.fas"
+  run_test "#{$bin}gt ltrclustering -matcher native -simcache sim.txt " +
+           "-psmall 80 -plarge 80 lc #{$testdata}ltrclustering.gff3"
+  run "diff #{last_stdout} #{$testdata}ltrclustering_native.gff3"
+  run "cp sim.txt sim.orig"
+  # the cached results are reused and the cache is not rewritten
+  run_test "#{$bin}gt -j 2 ltrclustering -matcher native -simcache sim.txt " +
+           "-psmall 80 -plarge 80 lc #{$testdata}ltrclustering.gff3"
+  run "diff #{last_stdout} #{$testdata}ltrclustering_native.gff3"
+  run "diff sim.txt sim.orig"
+  # the clustering is based on the cached results only
+  File.open("sim.txt", "w") do |file|
+    File.open("sim.orig").each_line do |line|
+      if line.start_with?("#") then
+        file.write(line)
+      else
+        fields = line.split(" ")
+        fields[2] = "0"
+        file.puts fields.join(" ")
+      end
+    end
+  end
+  run_test "#{$bin}gt ltrclustering -matcher native -simcache sim.txt " +
+           "-psmall 80 -plarge 80 lc #{$testdata}ltrclustering.gff3"
+  run "grep -c clid= #{last_stdout}", :retval => 1
+  # results computed with other scores are discarded
+  run "sed 's/match 2/match 1/' sim.orig > sim.txt"
+  run_test "#{$bin}gt ltrclustering -matcher native -simcache sim.txt " +
+           "-psmall 80 -plarge 80 lc #{$testdata}ltrclustering.gff3"
+  run "diff #{last_stdout} #{$testdata}ltrclustering_native.gff3"
+  run "diff sim.txt sim.orig"
+end
+
+Name "gt ltrclustering corrupt similarity cache"
+Keywords "gt_ltrclustering"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname lc #{$testdata}ltrclustering.fas"
+  File.open("sim.txt", "w") do |file|
+    file.write("sdfnhsnl")
+  end
+  run_test "#{$bin}gt ltrclustering -matcher native -simcache sim.txt " +
+           "-psmall 80 -plarge 80 lc #{$testdata}ltrclustering.gff3",
+           :retval => 1
+  grep last_stderr, /is not a similarity cache file/
+end
@@ -185,6 +185,197 @@ def check_amino_acid_output(gff3file, chr, pdoms)
   end
 end
 
+# writes a sequence with <n> synthetic LTR retrotransposons to <seqfile>, their
+# annotation to <gff3file> and a tRNA library matching their PBS to <trnafile>,
+# the annotation of the last element <outside> is moved behind the end of the
+# sequence
+def ltrdigest_write_candidates(n, seqfile, gff3file, trnafile, outside = nil)
+  rand = Random.new(11)
+  randseq = lambda { |len| (1..len).map { "acgt"[rand.rand(4)] }.join }
+  trna = randseq.call(60) + "cca"
+  seq = randseq.call(500)
+  elements = []
+  n.times do
+    ltr = "tg" + randseq.call(296) + "ca"
+    start = seq.length + 1
+    seq += ltr + "tgg" + revcomp(trna[-18..-1]) + randseq.call(3000) +
+           "aaagaaggaaaggagaagaa" + randseq.call(10) + ltr
+    elements.push([start, seq.length, ltr.length])
+    seq += randseq.call(500)
+  end
+  File.open(seqfile, "w") do |f|
+    f.puts ">seq1"
+    f.puts seq.scan(/.{1,60}/)
+  end
+  File.open(trnafile, "w") do |f|
+    f.puts ">trna1"
+    f.puts trna
+  end
+  File.open(gff3file, "w") do |f|
+    f.puts "##gff-version 3"
+    f.puts "##sequence-region seq1 1 #{2 * seq.length}"
+    elements.each_with_index do |(s, e, l), i|
+      if i == outside
+        s += seq.length
+        e += seq.length
+      end
+      f.puts "seq1\t.\trepeat_region\t#{s}\t#{e}\t.\t?\t.\tID=rr#{i}"
+      f.puts "seq1\t.\tLTR_retrotransposon\t#{s}\t#{e}\t.\t?\t.\t" +
+             "ID=ltr#{i};Parent=rr#{i}"
+      f.puts "seq1\t.\tlong_terminal_repeat\t#{s}\t#{s + l - 1}\t.\t?\t" +
+             ".\tParent=ltr#{i}"
+      f.puts "seq1\t.\tlong_terminal_repeat\t#{e - l + 1}\t#{e}\t.\t?\t" +
+             ".\tParent=ltr#{i}"
+      f.puts "###"
+    end
+  end
+end
+
+Name "gt ltrdigest -j 1 and -j 4 (new sequence index)"
+Keywords "gt_ltrdigest threads"
+Test do
+  ltrdigest_write_candidates(40, "ltrs.fas", "ltrs.gff3", "trnas.fas")
+  # the index of the sequence file is created while the workers run
+  run_test "#{$bin}gt -j 4 ltrdigest -seqfile ltrs.fas -matchdesc " +
+           "-trnas trnas.fas -outfileprefix par ltrs.gff3"
+  run "mv #{last_stdout} parallel.gff3"
+  grep "parallel.gff3", /\tprimer_binding_site\t/
+  run_test "#{$bin}gt -j 1 ltrdigest -seqfile ltrs.fas -matchdesc " +
+           "-trnas trnas.fas -outfileprefix ser ltrs.gff3"
+  run "diff #{last_stdout} parallel.gff3"
+  run "diff par_tabout.csv ser_tabout.csv"
+end
+
+Name "gt ltrdigest -j 1 and -j 4 (error)"
+Keywords "gt_ltrdigest threads"
+Test do
+  ltrdigest_write_candidates(40, "ltrs.fas", "broken.gff3", "trnas.fas", 39)
+  run_test "#{$bin}gt -j 1 ltrdigest -seqfile ltrs.fas -matchdesc " +
+           "-trnas trnas.fas broken.gff3", :retval => 1
+  run "mv #{last_stderr} serial.err"
+  run_test "#{$bin}gt -j 4 ltrdigest -seqfile ltrs.fas -matchdesc " +
+           "-trnas trnas.fas broken.gff3", :retval => 1
+  run "diff #{last_stderr} serial.err"
+end
+
+# writes stand-in HMMER tools to <dir>: hmmscan reports one domain of the model
+# RT for every third query of its query file and appends the number of queries
+# to hmmscan.log, FAKE_HMMSCAN_FAIL makes its second run fail in the given way
+def ltrdigest_write_fake_hmmer(dir)
+  Dir.mkdir(dir)
+  File.open("#{dir}/hmmconvert", "w") do |f|
+    f.puts "#!/bin/sh"
+    f.puts "[ \"$1\" = \"-h\" ] && exit 0"
+    f.puts "cat \"$1\""
+  end
+  File.open("#{dir}/hmmpress", "w") do |f|
+    f.puts "#!/bin/sh"
+    f.puts "[ \"$1\" = \"-h\" ] && exit 0"
+    f.puts "touch \"$2.h3f\" \"$2.h3i\" \"$2.h3m\" \"$2.h3p\""
+  end
+  File.open("#{dir}/hmmscan", "w") do |f|
+    f.puts <<'SCRIPT'
+#!/usr/bin/env ruby
+exit 0 if ARGV.include?("-h")
+queries = []
+File.read(ARGV.last).each_line do |line|
+  if line.start_with?(">")
+    queries.push([line[1..-1].strip, ""])
+  else
+    queries.last[1] += line.strip
+  end
+end
+File.open("hmmscan.log", "a") { |log| log.puts queries.length }
+calls = File.readlines("hmmscan.log").length
+fail = (calls == 2 ? ENV["FAKE_HMMSCAN_FAIL"] : nil)
+puts "# hmmscan :: stand-in"
+queries.each_with_index do |(name, seq), i|
+  name = "999999_0+" if fail == "query"
+  puts "Query:       #{name}  [L=#{seq.length}]"
+  puts "Scores for complete sequence (score includes all domains):"
+  puts "    E-value  score  bias    E-value  score  bias    exp  N  Model"
+  puts ""
+  puts "Domain annotation for each model (and alignments):"
+  if i % 3 == 0 && seq.length >= 60
+    from = 1 + seq[0, 20].sum % 20
+    to = from + 29
+    ali = seq[from - 1..to - 1]
+    puts ">> RT  stand-in model"
+    puts "   #    score  bias  c-Evalue  i-Evalue hmmfrom  hmm to    " +
+         "alifrom  ali to    envfrom  env to     acc"
+    puts " ---   ------ ----- --------- --------- ------- -------    " +
+         "------- -------    ------- -------    ----"
+    puts "   1 !   40.0   0.0   1.0e-12   2.0e-12       1      30 ..    " +
+         "#{from}    #{to} ..    #{from}    #{to} .. 0.90"
+    puts ""
+    puts "  Alignments for each domain:"
+    puts "  == domain 1  score: 40.0 bits;  conditional E-value: 1.0e-12"
+    puts "             RT    1 #{ali.downcase} 30"
+    puts "                   #{"+" * ali.length}"
+    puts "  #{name} #{from} #{ali} #{to}"
+    puts "                   #{"9" * ali.length} PP"
+    puts ""
+  else
+    puts ""
+    puts "   [No targets detected that satisfy reporting thresholds]"
+  end
+  puts ""
+  puts "Internal pipeline statistics summary:"
+  puts "Query sequence(s):                         1  (#{seq.length} residues)"
+  if fail == "exit"
+    $stdout.flush
+    exit 1
+  end
+  puts "//"
+end
+puts "[ok]"
+SCRIPT
+  end
+  ["hmmconvert", "hmmpress", "hmmscan"].each do |tool|
+    File.chmod(0755, "#{dir}/#{tool}")
+  end
+  File.open("stand-in.hmm", "w") { |f| f.puts "HMMER3/f stand-in" }
+  { "PATH" => "#{Dir.pwd}/#{dir}:#{ENV["PATH"]}", "TMPDIR" => Dir.pwd }
+end
+
+Name "gt ltrdigest -pdombatchsize (stand-in HMMER)"
+Keywords "gt_ltrdigest pdombatchsize"
+Test do
+  ltrdigest_write_candidates(40, "ltrs.fas", "ltrs.gff3", "trnas.fas")
+  env = ltrdigest_write_fake_hmmer("hmmer")
+  [1, 7, 256].each do |batchsize|
+    run_test "#{$bin}gt -j 2 ltrdigest -seqfile ltrs.fas -matchdesc " +
+             "-pdombatchsize #{batchsize} -hmms stand-in.hmm -- ltrs.gff3",
+             :env => env
+    run "mv #{last_stdout} batch#{batchsize}.gff3"
+    # every candidate contributes its six translations to a batch
+    expected = (0...40).each_slice(batchsize).map { |b| 6 * b.length }
+    if File.readlines("hmmscan.log").map(&:to_i) != expected then
+      raise "unexpected hmmscan runs for batch size #{batchsize}"
+    end
+    File.unlink("hmmscan.log")
+  end
+  grep "batch1.gff3", /\tprotein_match\t.*name=RT/
+  run "diff batch1.gff3 batch7.gff3"
+  run "diff batch1.gff3 batch256.gff3"
+end
+
+Name "gt ltrdigest -pdombatchsize (failing HMMER run)"
+Keywords "gt_ltrdigest pdombatchsize"
+Test do
+  ltrdigest_write_candidates(40, "ltrs.fas", "ltrs.gff3", "trnas.fas")
+  env = ltrdigest_write_fake_hmmer("hmmer")
+  run_test "#{$bin}gt ltrdigest -seqfile ltrs.fas -matchdesc " +
+           "-pdombatchsize 7 -hmms stand-in.hmm -- ltrs.gff3",
+           :env => env.merge("FAKE_HMMSCAN_FAIL" => "exit"), :retval => 1
+  grep last_stderr, /hmmscan failed with exit status 1/
+  File.unlink("hmmscan.log")
+  run_test "#{$bin}gt ltrdigest -seqfile ltrs.fas -matchdesc " +
+           "-pdombatchsize 7 -hmms stand-in.hmm -- ltrs.gff3",
+           :env => env.merge("FAKE_HMMSCAN_FAIL" => "query"), :retval => 1
+  grep last_stderr, /unexpected query in HMMER output: 'Query: +999999_0\+/
+end
+
 if $gttestdata then
   Name "gt ltrdigest missing input GFF"
   Keywords "gt_ltrdigest"
@@ -369,6 +560,10 @@ if $gttestdata then
        :retval => 0, :maxtime => 700
         check_ppt_pbs(last_stdout, chr)
         #run "diff #{last_stdout} #{$gttestdata}ltrdigest/#{chr}_ref_noHMM.gff3"
+        run "mv #{last_stdout} parallel.gff3"
+        run_test "#{$bin}gt -j 1 ltrdigest -encseq #{chr}_genomic_dmel_RELEASE3-1.FASTA.gz -outfileprefix result#{chr} -trnas #{$gttestdata}ltrdigest/Dm-tRNAs-uniq.fa #{$gttestdata}ltrdigest/dmel_md5_#{chr}.gff3",\
+       :retval => 0, :maxtime => 700
+        run "diff #{last_stdout} parallel.gff3"
       end
     end
   end
@@ -442,6 +637,26 @@ if $gttestdata then
         raise TestFailed, "file \"result4_pdom_RVT_1_aa.fas\" does not exist"
       end
     end
+
+    Name "gt ltrdigest -pdombatchsize"
+    Keywords "gt_ltrdigest pdombatchsize"
+    Test do
+      run_test "#{$bin}gt suffixerator -lossless -dna -des -ssp -tis -v " + \
+               "-db #{$gttestdata}ltrharvest/d_mel/4_genomic_dmel_RELEASE3-1.FASTA.gz", \
+               :maxtime => 600
+      run_test "#{$bin}gt -j 2 ltrdigest -pdombatchsize 1 " + \
+               "-encseq 4_genomic_dmel_RELEASE3-1.FASTA.gz " + \
+               "-hmms #{$gttestdata}ltrdigest/hmms/RVT_1.hmm -- " + \
+               "#{$gttestdata}ltrdigest/dmel_md5_4.gff3 ",
+               :retval => 0, :maxtime => 12000
+      run "mv #{last_stdout} single.gff3"
+      run_test "#{$bin}gt -j 2 ltrdigest -pdombatchsize 5 " + \
+               "-encseq 4_genomic_dmel_RELEASE3-1.FASTA.gz " + \
+               "-hmms #{$gttestdata}ltrdigest/hmms/RVT_1.hmm -- " + \
+               "#{$gttestdata}ltrdigest/dmel_md5_4.gff3 ",
+               :retval => 0, :maxtime => 12000
+      run "diff #{last_stdout} single.gff3"
+    end
   end
 
   # LEGACY INTERFACE TESTS
@@ -131,6 +131,8 @@ if $gttestdata then
       run "#{$bin}gt  eval -ltr out.gff3 ref.gff3"
       grep(last_stdout, "LTR_retrotransposon sensitivity: 100.00%")
       grep(last_stdout, "LTR_retrotransposon specificity: 100.00%")
+      run_test "#{$bin}gt -j 4 ltrharvest -index #{v} -seed 76 -minlenltr 116 -maxlenltr 800 -mindistltr 2280 -maxdistltr 8773 -similar 91 -mintsd 4 -maxtsd 20 -vic 60 -overlaps best -xdrop 7 -mat 2 -mis -2 -ins -3 -del -3 -v", :maxtime => 3600
+      run "diff #{last_stdout} #{$gttestdata}ltrharvest/d_mel/#{k}.out"
     end
   end
 end
@@ -284,6 +286,52 @@ Test do
   grep(last_stderr, "cannot open file 'Random159.fna.suf'")
 end
 
+# writes two sequences with <n> synthetic LTR retrotransposons each to
+# <seqfile>, the LTRs of an element differ in about 2% of their positions
+def ltrharvest_write_elements(n, seqfile)
+  rand = Random.new(17)
+  randseq = lambda { |len| (1..len).map { "acgt"[rand.rand(4)] }.join }
+  File.open(seqfile, "w") do |f|
+    2.times do |s|
+      seq = randseq.call(1000)
+      n.times do
+        tsd = randseq.call(5)
+        ltr = "tg" + randseq.call(200 + rand.rand(300)) + "ca"
+        copy = ltr.chars.map do |c|
+          rand.rand(50) == 0 ? "acgt"[rand.rand(4)] : c
+        end
+        seq += tsd + ltr + randseq.call(3000 + rand.rand(3000)) + copy.join +
+               tsd + randseq.call(500 + rand.rand(2000))
+      end
+      f.puts ">seq#{s}"
+      f.puts seq.scan(/.{1,60}/)
+    end
+  end
+end
+
+Name "gt ltrharvest -j 1, -j 2 and -j 4 (synthetic elements)"
+Keywords "gt_ltrharvest threads"
+Test do
+  ltrharvest_write_elements(30, "elements.fas")
+  run_test "#{$bin}gt suffixerator -db elements.fas -dna -suf -sds -lcp " +
+           "-tis -des -ssp"
+  ["", "-mintsd 4 -maxtsd 20 -overlaps all"].each_with_index do |opts, i|
+    [1, 2, 4].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} ltrharvest -index elements.fas #{opts} " +
+               "-gff3 out.gff3"
+      run "mv #{last_stdout} out#{i}_#{jobs}.txt"
+      run "mv out.gff3 out#{i}_#{jobs}.gff3"
+    end
+    # the elements of both sequences are found
+    grep "out#{i}_1.gff3", /^seq0\t.*\tLTR_retrotransposon\t/
+    grep "out#{i}_1.gff3", /^seq1\t.*\tLTR_retrotransposon\t/
+    [2, 4].each do |jobs|
+      run "diff out#{i}_1.txt out#{i}_#{jobs}.txt"
+      run "diff out#{i}_1.gff3 out#{i}_#{jobs}.gff3"
+    end
+  end
+end
+
 # test all combinations of options, test only some of them
 outlist = (["-seed 100",
             "-minlenltr 100",# "-maxlenltr 1000",
@@ -37,3 +37,22 @@ Test do
   run_test "#{$bin}gt merge #{$testdata}minimal_fasta.gff3 #{$testdata}two_fasta_seqs.gff3"
   run "diff #{last_stdout} #{$testdata}merge_with_seq.gff3"
 end
+
+Name "gt merge -async"
+Keywords "gt_merge async"
+Test do
+  run_test "#{$bin}gt merge -async #{$testdata}gt_merge_prob_1.in1 #{$testdata}gt_merge_prob_1.in2"
+  run "diff #{last_stdout} #{$testdata}gt_merge_prob_1.out"
+  run_test "#{$bin}gt merge -async #{$testdata}gt_merge_prob_2.in1 #{$testdata}gt_merge_prob_2.in2"
+  run "diff #{last_stdout} #{$testdata}gt_merge_prob_2.out"
+  run_test "#{$bin}gt merge -async #{$testdata}minimal_fasta.gff3 #{$testdata}two_fasta_seqs.gff3"
+  run "diff #{last_stdout} #{$testdata}merge_with_seq.gff3"
+end
+
+Name "gt merge -async unsorted file"
+Keywords "gt_merge async"
+Test do
+  run_test("#{$bin}gt merge -async #{$testdata}gt_merge_prob_1.in1 " +
+           "#{$testdata}unsorted_gff3_file.txt", :retval => 1)
+  grep(last_stderr, "is not sorted")
+end
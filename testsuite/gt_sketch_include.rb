@@ -168,6 +168,55 @@ Test do
   end
 end
 
+Name "gt sketch from binary feature index"
+Keywords "gt_sketch annotationsketch binary"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend binary -filename eden.idx " + \
+      "#{$testdata}eden.gff3"
+  run_test "#{$bin}gt sketch -input featureindex out.png eden.idx", \
+           :maxtime => 600
+  run "test -e out.png"
+end
+
+Name "gt sketch_tiles"
+Keywords "gt_sketch gt_sketch_tiles annotationsketch"
+Test do
+  run_test "#{$bin}gt -j 2 sketch_tiles -range 1000 9000 " + \
+           "#{$testdata}standard_gene_as_tree.gff3", :maxtime => 600
+  run "test -e ctg123_0_0.png"
+  run "test -e ctg123_0_31.png"
+  run "test ! -e ctg123_0_32.png"
+  run "test -e ctg123_5_0.png"
+  run "test ! -e ctg123_6_0.png"
+end
+
+Name "gt sketch_tiles -benchmark"
+Keywords "gt_sketch gt_sketch_tiles annotationsketch"
+Test do
+  run_test "#{$bin}gt sketch_tiles -benchmark -tilewidth 128 " + \
+           "-minzoom 2 -prefix bench #{$testdata}eden.gff3", :maxtime => 600
+  grep(last_stdout, /rendered \d+ tiles of zoom levels 2-\d+ in .* tiles\/s/)
+  run "test ! -e bench_2_0.png"
+end
+
+Name "gt sketch_tiles from binary feature index"
+Keywords "gt_sketch gt_sketch_tiles annotationsketch binary"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend binary -filename eden.idx " + \
+      "#{$testdata}eden.gff3"
+  run_test "#{$bin}gt sketch_tiles -input featureindex -minzoom 4 " + \
+           "-prefix tile eden.idx", :maxtime => 600
+  run "test -e tile_4_0.png"
+end
+
+Name "gt sketch_tiles (invalid zoom level)"
+Keywords "gt_sketch gt_sketch_tiles annotationsketch"
+Test do
+  run_test "#{$bin}gt sketch_tiles -range 1000 9000 -maxzoom 6 " + \
+           "#{$testdata}standard_gene_as_tree.gff3", :retval => 1
+  grep(last_stderr, /must not be larger than 5/)
+end
+
 Name "sketch_constructed (C)"
 Keywords "gt_sketch annotationsketch"
 Test do
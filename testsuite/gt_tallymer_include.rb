@@ -45,6 +45,67 @@ tyrfiles = {"Atinsert.fna" => 19,
             "trna_glutamine.fna" => 10,
             "at1MB" => 20}
 
+def checktallymerthreads(reffile,mersize)
+  run_test "#{$bin}gt suffixerator -pl -dna -tis -suf -lcp " +
+           "-indexname sfxidx -db #{$testdata}#{reffile}"
+  ["-minocc 2 -maxocc 30",
+   "-counts -pl -minocc 1 -indexname tyr-index"].each do |opts|
+    run_test "#{$bin}gt tallymer mkindex -mersize #{mersize} #{opts} " +
+             "-esa sfxidx"
+    run "mv #{last_stdout} tyrmkiout.seq"
+    if opts.match(/indexname/) then
+      run "mv tyr-index.mer tyr-index-seq.mer"
+      run "mv tyr-index.mct tyr-index-seq.mct"
+    end
+    run_test "#{$bin}gt -j 3 tallymer mkindex -mersize #{mersize} #{opts} " +
+             "-esa sfxidx"
+    run "cmp -s tyrmkiout.seq #{last_stdout}"
+    if opts.match(/indexname/) then
+      run "cmp -s tyr-index.mer tyr-index-seq.mer"
+      run "cmp -s tyr-index.mct tyr-index-seq.mct"
+    end
+  end
+  searchopts = "-strand fp -output qseqnum qpos counts sequence " +
+               "-tyr tyr-index -q #{$testdata}U89959_genomic.fas"
+  run_test "#{$bin}gt tallymer search #{searchopts}"
+  run "mv #{last_stdout} tyrseaout.seq"
+  run_test "#{$bin}gt -j 3 tallymer search #{searchopts}"
+  run "cmp -s tyrseaout.seq #{last_stdout}"
+  occopts = "-minmersize 2 -maxmersize #{mersize} -output unique nonunique " +
+            "nonuniquemulti total relative -esa sfxidx"
+  run_test "#{$bin}gt tallymer occratio #{occopts}"
+  run "mv #{last_stdout} tyroccout.seq"
+  run_test "#{$bin}gt -j 3 tallymer occratio #{occopts}"
+  run "cmp -s tyroccout.seq #{last_stdout}"
+end
+
+["Atinsert.fna","Duplicate.fna","RandomN.fna","at1MB"].each do |reffile|
+  Name "gt tallymer multithreaded #{reffile}"
+  Keywords "gt_tallymer threads"
+  Test do
+    checktallymerthreads(reffile,12)
+  end
+end
+
+Name "gt tallymer search multithreaded (more sequences than a batch)"
+Keywords "gt_tallymer threads"
+Test do
+  # the 1952 sequences of at1MB are searched in two batches of at most 1024
+  run_test "#{$bin}gt suffixerator -pl -dna -tis -suf -lcp " +
+           "-indexname sfxidx -db #{$testdata}at1MB"
+  run_test "#{$bin}gt tallymer mkindex -mersize 12 -counts -pl -minocc 2 " +
+           "-indexname tyr-index -esa sfxidx"
+  searchopts = "-strand fp -output qseqnum qpos counts sequence " +
+               "-tyr tyr-index -q #{$testdata}at1MB"
+  run_test "#{$bin}gt -j 1 tallymer search #{searchopts}"
+  run "mv #{last_stdout} tyrseaout.seq"
+  grep "tyrseaout.seq", /^1951\t/
+  [2, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} tallymer search #{searchopts}"
+    run "cmp -s tyrseaout.seq #{last_stdout}"
+  end
+end
+
 runtyrmkifail("-mersize 21 -pl")
 runtyrmkifail("-mersize 21 -pl -minocc")
 runtyrmkifail("-pl -minocc 30 -maxocc 40")
@@ -158,6 +158,7 @@ def ruby_tests_runnable?
 end
 
 # include the actual test modules
+require 'gt_alignbench_include'
 require 'gt_bed_to_gff3_include'
 require 'gt_cds_include'
 require 'gt_chseqids_include'
@@ -165,22 +166,28 @@ require 'gt_condenser_include'
 require 'gt_consensus_sa_include'
 require 'gt_csa_include'
 require 'gt_csr_include.rb'
+require 'gt_dupfeat_include'
 require 'gt_encseq_include'
 require 'gt_eval_include'
 require 'gt_extractfeat_include'
 require 'gt_fastq_sample_include'
+require 'gt_featindexbench_include'
 require 'gt_featureindex_include'
 require 'gt_fingerprint_include'
 require 'gt_genomediff_include'
 require 'gt_gff3_include'
 require 'gt_gff3validator_include'
 require 'gt_gtf_to_gff3_include'
+require 'gt_gth_include'
+require 'gt_gthbssmtrain_include'
+require 'gt_gthdpbench_include'
 require 'gt_hop_include'
 require 'gt_id_to_md5_include'
 require 'gt_include'
 require 'gt_inlineseq_include'
 require 'gt_interfeat_include'
 require 'gt_loccheck_include'
+require 'gt_ltrclustering_include'
 require 'gt_ltrdigest_include'
 require 'gt_ltrharvest_include'
 require 'gt_magicmatch_include'